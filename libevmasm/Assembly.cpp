@@ -34,7 +34,9 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <fmt/format.h>
 
@@ -44,6 +46,7 @@
 #include <range/v3/view/map.hpp>
 
 #include <fstream>
+#include <future>
 #include <limits>
 #include <iterator>
 
@@ -186,9 +189,9 @@ AssemblyItem Assembly::createAssemblyItemFromJSON(Json const& _json, std::vector
 
 	AssemblyItem result(0);
 
-	if (c_instructions.count(name))
+	if (instructionsByName().count(name))
 	{
-		AssemblyItem item{c_instructions.at(name), langutil::DebugData::create(location)};
+		AssemblyItem item{instructionsByName().at(name), langutil::DebugData::create(location)};
 		if (!jumpType.empty())
 		{
 			if (item.instruction() == Instruction::JUMP || item.instruction() == Instruction::JUMPI)
@@ -719,6 +722,7 @@ AssemblyItem Assembly::newImmutableAssignment(std::string const& _identifier)
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	util::Profiler::Scope profilerScope("EVM assembly optimisation", "evmasm");
 	optimiseInternal(_settings, {});
 	return *this;
 }
@@ -733,21 +737,51 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 
 	// Run optimisation for sub-assemblies.
 	// TODO: verify and double-check this for EOF.
+	// Replacing the tags of one sub-assembly does not affect the tags referenced from the others,
+	// so the references can be determined upfront.
+	std::vector<std::set<size_t>> referencedTags(m_subs.size());
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		std::set<size_t> referencedTags;
-		for (auto& codeSection: m_codeSections)
-			referencedTags += JumpdestRemover::referencedTags(codeSection.items, subId);
-		std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			referencedTags
-		);
-		// Apply the replacements (can be empty).
 		for (auto& codeSection: m_codeSections)
-			BlockDeduplicator::applyTagReplacement(codeSection.items, subTagReplacements, subId);
+			referencedTags[subId] += JumpdestRemover::referencedTags(codeSection.items, subId);
+
+	// Sub-assemblies can only be optimised concurrently, if they do not share any assembly that still
+	// has to be optimised. Otherwise the optimisation of that assembly would depend on which of the
+	// sub-assemblies reaches it first.
+	bool const optimiseSubsConcurrently = _settings.numThreads > 1 && m_subs.size() > 1 && [&]() {
+		std::set<Assembly const*> unoptimisedAssemblies;
+		for (auto const& sub: m_subs)
+			if (!sub->collectUnoptimisedAssemblies(unoptimisedAssemblies))
+				return false;
+		return true;
+	}();
+
+	std::vector<std::map<u256, u256> const*> subTagReplacements(m_subs.size());
+	if (optimiseSubsConcurrently)
+	{
+		// Threads not needed for the sub-assemblies themselves are shared out among their subs.
+		OptimiserSettings subSettings = _settings;
+		subSettings.numThreads = std::max<size_t>(1, _settings.numThreads / m_subs.size());
+		std::vector<std::future<std::map<u256, u256> const*>> results;
+		{
+			util::ThreadPool threadPool(std::min(_settings.numThreads, m_subs.size()));
+			for (size_t subId = 0; subId < m_subs.size(); ++subId)
+				results.emplace_back(threadPool.submit([&, subId, profiler = util::Profiler::active()]() {
+					util::Profiler::Activation profilerActivation(profiler);
+					return &m_subs[subId]->optimiseInternal(subSettings, referencedTags[subId]);
+				}));
+		}
+		// Rethrow the exception of the first failed sub-assembly, as the sequential order would.
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			subTagReplacements[subId] = results[subId].get();
 	}
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			subTagReplacements[subId] = &m_subs[subId]->optimiseInternal(_settings, referencedTags[subId]);
+
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		for (auto& codeSection: m_codeSections)
+			BlockDeduplicator::applyTagReplacement(codeSection.items, *subTagReplacements[subId], subId);
 
 	std::map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -764,7 +798,8 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 				_tagsReferencedFromOutside,
 				_settings.expectedExecutionsPerDeployment,
 				isCreation(),
-				_settings.evmVersion}
+				_settings.evmVersion,
+				_settings.inlinerCodeSizeLimit}
 				.optimise();
 		}
 		// TODO: verify this for EOF.
@@ -834,10 +869,14 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
+			// Blocks do not share any knowledge, but the tables of the expression classes are reused
+			// so that they do not have to be reallocated for every block.
+			auto expressionClasses = std::make_shared<ExpressionClasses>();
 			auto iter = items.begin();
 			while (iter != items.end())
 			{
-				KnownState emptyState;
+				expressionClasses->clear();
+				KnownState emptyState{expressionClasses};
 				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, items.end(), usesMSize);
@@ -987,63 +1026,63 @@ LinkerObject const& Assembly::assemble() const
 		return assembleEOF();
 }
 
-[[nodiscard]] bytes Assembly::assembleOperation(AssemblyItem const& _item) const
+void Assembly::assembleOperation(AssemblyItem const& _item, bytes& _out) const
 {
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	return {static_cast<uint8_t>(_item.instruction())};
+	_out.push_back(static_cast<uint8_t>(_item.instruction()));
 }
 
-[[nodiscard]] bytes Assembly::assemblePush(AssemblyItem const& _item) const
+void Assembly::assemblePush(AssemblyItem const& _item, bytes& _out) const
 {
-	bytes ret;
 	unsigned pushValueSize = numberEncodingSize(_item.data());
 	if (pushValueSize == 0 && !m_evmVersion.hasPush0())
 		pushValueSize = 1;
 
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	ret.push_back(static_cast<uint8_t>(pushInstruction(pushValueSize)));
+	_out.push_back(static_cast<uint8_t>(pushInstruction(pushValueSize)));
 	if (pushValueSize > 0)
-		appendBigEndian(ret, pushValueSize, _item.data());
-
-	return ret;
+		appendBigEndian(_out, pushValueSize, _item.data());
 }
 
-[[nodiscard]] std::pair<bytes, Assembly::LinkRef> Assembly::assemblePushLibraryAddress(AssemblyItem const& _item, size_t _pos) const
+[[nodiscard]] Assembly::LinkRef Assembly::assemblePushLibraryAddress(AssemblyItem const& _item, bytes& _out) const
 {
-	return {
-		// solidity::evmasm::Instructions underlying type is uint8_t
-		// TODO: Change to std::to_underlying since C++23
-		bytes(1, static_cast<uint8_t>(Instruction::PUSH20)) + bytes(20),
-		{_pos + 1, m_libraries.at(_item.data())}
-	};
+	LinkRef linkRef{_out.size() + 1, m_libraries.at(_item.data())};
+	// solidity::evmasm::Instructions underlying type is uint8_t
+	// TODO: Change to std::to_underlying since C++23
+	_out.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+	_out.resize(_out.size() + 20);
+	return linkRef;
 }
 
-[[nodiscard]] bytes Assembly::assembleVerbatimBytecode(AssemblyItem const& item) const
+void Assembly::assembleVerbatimBytecode(AssemblyItem const& item, bytes& _out) const
 {
-	return item.verbatimData();
+	_out += item.verbatimData();
 }
 
-[[nodiscard]] bytes Assembly::assemblePushDeployTimeAddress() const
+void Assembly::assemblePushDeployTimeAddress(bytes& _out) const
 {
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	return bytes(1, static_cast<uint8_t>(Instruction::PUSH20)) + bytes(20);
+	_out.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+	_out.resize(_out.size() + 20);
 }
 
-[[nodiscard]] bytes Assembly::assembleTag(AssemblyItem const& _item, size_t _pos, bool _addJumpDest) const
+void Assembly::assembleTag(AssemblyItem const& _item, bool _addJumpDest, bytes& _out) const
 {
+	size_t const pos = _out.size();
 	solRequire(_item.data() != 0, AssemblyException, "Invalid tag position.");
 	solRequire(_item.splitForeignPushTag().first == std::numeric_limits<size_t>::max(), AssemblyException, "Foreign tag.");
-	solRequire(_pos < 0xffffffffL, AssemblyException, "Tag too large.");
+	solRequire(pos < 0xffffffffL, AssemblyException, "Tag too large.");
 	size_t tagId = static_cast<size_t>(_item.data());
 	solRequire(m_tagPositionsInBytecode[tagId] == std::numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
-	m_tagPositionsInBytecode[tagId] = _pos;
+	m_tagPositionsInBytecode[tagId] = pos;
 
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	return _addJumpDest ? bytes(1, static_cast<uint8_t>(Instruction::JUMPDEST)) : bytes();
+	if (_addJumpDest)
+		_out.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
 }
 
 LinkerObject const& Assembly::assembleLegacy() const
@@ -1137,10 +1176,10 @@ LinkerObject const& Assembly::assembleLegacy() const
 		switch (item.type())
 		{
 		case Operation:
-			ret.bytecode += assembleOperation(item);
+			assembleOperation(item, ret.bytecode);
 			break;
 		case Push:
-			ret.bytecode += assemblePush(item);
+			assemblePush(item, ret.bytecode);
 			break;
 		case PushTag:
 		{
@@ -1181,9 +1220,7 @@ LinkerObject const& Assembly::assembleLegacy() const
 		}
 		case PushLibraryAddress:
 		{
-			auto const [bytecode, linkRef] = assemblePushLibraryAddress(item, ret.bytecode.size());
-			ret.bytecode += bytecode;
-			ret.linkReferences.insert(linkRef);
+			ret.linkReferences.insert(assemblePushLibraryAddress(item, ret.bytecode));
 			break;
 		}
 		case PushImmutable:
@@ -1196,7 +1233,7 @@ LinkerObject const& Assembly::assembleLegacy() const
 			ret.bytecode.resize(ret.bytecode.size() + 32);
 			break;
 		case VerbatimBytecode:
-			ret.bytecode += assembleVerbatimBytecode(item);
+			assembleVerbatimBytecode(item, ret.bytecode);
 			break;
 		case AssignImmutable:
 		{
@@ -1210,9 +1247,9 @@ LinkerObject const& Assembly::assembleLegacy() const
 					ret.bytecode.push_back(uint8_t(Instruction::DUP2));
 				}
 				// TODO: should we make use of the constant optimizer methods for pushing the offsets?
-				bytes offsetBytes = toCompactBigEndian(u256(offsets[i]));
-				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(offsetBytes.size()))));
-				ret.bytecode += offsetBytes;
+				unsigned offsetSize = numberEncodingSize(offsets[i]);
+				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(offsetSize)));
+				appendBigEndian(ret.bytecode, offsetSize, offsets[i]);
 				ret.bytecode.push_back(uint8_t(Instruction::ADD));
 				ret.bytecode.push_back(uint8_t(Instruction::MSTORE));
 			}
@@ -1225,10 +1262,10 @@ LinkerObject const& Assembly::assembleLegacy() const
 			break;
 		}
 		case PushDeployTimeAddress:
-			ret.bytecode += assemblePushDeployTimeAddress();
+			assemblePushDeployTimeAddress(ret.bytecode);
 			break;
 		case Tag:
-			ret.bytecode += assembleTag(item, ret.bytecode.size(), true);
+			assembleTag(item, true, ret.bytecode);
 			break;
 		default:
 			assertThrow(false, InvalidOpcode, "Unexpected opcode while assembling.");
@@ -1247,24 +1284,22 @@ LinkerObject const& Assembly::assembleLegacy() const
 		// Append an INVALID here to help tests find miscompilation.
 		ret.bytecode.push_back(static_cast<uint8_t>(Instruction::INVALID));
 
-	std::map<LinkerObject, size_t> subAssemblyOffsets;
+	// Sub assemblies keep their assembled objects, so they are referenced here instead of copied.
+	auto compareLinkerObjects = [](LinkerObject const* _a, LinkerObject const* _b) { return *_a < *_b; };
+	std::map<LinkerObject const*, size_t, decltype(compareLinkerObjects)> subAssemblyOffsets(compareLinkerObjects);
 	for (auto const& [subIdPath, bytecodeOffset]: subRefs)
 	{
-		LinkerObject subObject = subAssemblyById(subIdPath)->assemble();
+		LinkerObject const& subObject = subAssemblyById(subIdPath)->assemble();
 		bytesRef r(ret.bytecode.data() + bytecodeOffset, bytesPerDataRef);
 
 		// In order for de-duplication to kick in, not only must the bytecode be identical, but
 		// link and immutables references as well.
-		if (size_t* subAssemblyOffset = util::valueOrNullptr(subAssemblyOffsets, subObject))
-			toBigEndian(*subAssemblyOffset, r);
-		else
-		{
-			toBigEndian(ret.bytecode.size(), r);
-			subAssemblyOffsets[subObject] = ret.bytecode.size();
+		auto [subAssemblyOffset, inserted] = subAssemblyOffsets.try_emplace(&subObject, ret.bytecode.size());
+		toBigEndian(subAssemblyOffset->second, r);
+		if (inserted)
 			ret.bytecode += subObject.bytecode;
-		}
 		for (auto const& ref: subObject.linkReferences)
-			ret.linkReferences[ref.first + subAssemblyOffsets[subObject]] = ref.second;
+			ret.linkReferences[ref.first + subAssemblyOffset->second] = ref.second;
 	}
 	for (auto const& i: tagRefs)
 	{
@@ -1364,7 +1399,7 @@ LinkerObject const& Assembly::assembleEOF() const
 
 	// Insert EOF1 header.
 	auto [headerBytecode, codeSectionSizeOffsets, dataSectionSizeOffset] = createEOFHeader(referencedSubIds);
-	ret.bytecode = headerBytecode;
+	ret.bytecode = std::move(headerBytecode);
 
 	m_tagPositionsInBytecode = std::vector<size_t>(m_usedTags, std::numeric_limits<size_t>::max());
 
@@ -1380,26 +1415,24 @@ LinkerObject const& Assembly::assembleEOF() const
 			switch (item.type())
 			{
 			case Operation:
-				ret.bytecode += assembleOperation(item);
+				assembleOperation(item, ret.bytecode);
 				break;
 			case Push:
-				ret.bytecode += assemblePush(item);
+				assemblePush(item, ret.bytecode);
 				break;
 			case PushLibraryAddress:
 			{
-				auto const [pushLibraryAddressBytecode, linkRef] = assemblePushLibraryAddress(item, ret.bytecode.size());
-				ret.bytecode += pushLibraryAddressBytecode;
-				ret.linkReferences.insert(linkRef);
+				ret.linkReferences.insert(assemblePushLibraryAddress(item, ret.bytecode));
 				break;
 			}
 			case VerbatimBytecode:
-				ret.bytecode += assembleVerbatimBytecode(item);
+				assembleVerbatimBytecode(item, ret.bytecode);
 				break;
 			case PushDeployTimeAddress:
-				ret.bytecode += assemblePushDeployTimeAddress();
+				assemblePushDeployTimeAddress(ret.bytecode);
 				break;
 			case Tag:
-				ret.bytecode += assembleTag(item, ret.bytecode.size(), false);
+				assembleTag(item, false, ret.bytecode);
 				break;
 			default:
 				solThrow(InvalidOpcode, "Unexpected opcode while assembling.");
@@ -1476,11 +1509,24 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 	return currentAssembly;
 }
 
+bool Assembly::collectUnoptimisedAssemblies(std::set<Assembly const*>& o_assemblies) const
+{
+	if (m_tagReplacements)
+		return true;
+	if (!o_assemblies.insert(this).second)
+		return false;
+	for (auto const& sub: m_subs)
+		if (!sub->collectUnoptimisedAssemblies(o_assemblies))
+			return false;
+	return true;
+}
+
 Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
 {
 	// Constructing it this way so that we notice changes in the fields.
 	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
 	asmSettings.runInliner = _settings.runInliner;
+	asmSettings.inlinerCodeSizeLimit = _settings.inlinerCodeSizeLimit;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
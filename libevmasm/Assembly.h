@@ -38,6 +38,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <optional>
 #include <utility>
 
 namespace solidity::evmasm
@@ -137,6 +138,12 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Number of threads used for optimising independent sub-assemblies concurrently.
+		/// Does not influence the result of the optimisation.
+		size_t numThreads = 1;
+		/// If set, the inliner ranks all functions by estimated gas saved per byte added and inlines them
+		/// only as long as the code of each assembly stays below this size in bytes.
+		std::optional<size_t> inlinerCodeSizeLimit;
 
 		static OptimiserSettings translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion);
 	};
@@ -207,6 +214,10 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// Adds this assembly and all assemblies reachable from it via sub-assemblies, that have not been
+	/// optimised yet, to @a o_assemblies.
+	/// @returns false if any of them was already contained in @a o_assemblies.
+	bool collectUnoptimisedAssemblies(std::set<Assembly const*>& o_assemblies) const;
 
 	/// For EOF and legacy it calculates approximate size of "pure" code without data.
 	unsigned codeSize(unsigned subTagSize) const;
@@ -241,13 +252,14 @@ private:
 	/// Returns map from m_subs to an index of subcontainer in the final EOF bytecode
 	std::map<uint16_t, uint16_t> findReferencedContainers() const;
 
-	/// Assemble bytecode for AssemblyItem type.
-	[[nodiscard]] bytes assembleOperation(AssemblyItem const& _item) const;
-	[[nodiscard]] bytes assemblePush(AssemblyItem const& _item) const;
-	[[nodiscard]] std::pair<bytes, Assembly::LinkRef> assemblePushLibraryAddress(AssemblyItem const& _item, size_t _pos) const;
-	[[nodiscard]] bytes assembleVerbatimBytecode(AssemblyItem const& item) const;
-	[[nodiscard]] bytes assemblePushDeployTimeAddress() const;
-	[[nodiscard]] bytes assembleTag(AssemblyItem const& _item, size_t _pos, bool _addJumpDest) const;
+	/// Append the bytecode for AssemblyItem type to @a _out.
+	void assembleOperation(AssemblyItem const& _item, bytes& _out) const;
+	void assemblePush(AssemblyItem const& _item, bytes& _out) const;
+	/// @returns the reference to the library address, which starts right after the current end of @a _out.
+	[[nodiscard]] Assembly::LinkRef assemblePushLibraryAddress(AssemblyItem const& _item, bytes& _out) const;
+	void assembleVerbatimBytecode(AssemblyItem const& item, bytes& _out) const;
+	void assemblePushDeployTimeAddress(bytes& _out) const;
+	void assembleTag(AssemblyItem const& _item, bool _addJumpDest, bytes& _out) const;
 
 protected:
 	/// 0 is reserved for exception
@@ -27,6 +27,7 @@
 #include <libsolutil/FixedHash.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <charconv>
 #include <fstream>
 #include <limits>
 
@@ -40,6 +41,14 @@ static_assert(sizeof(size_t) <= 8, "size_t must be at most 64-bits wide");
 namespace
 {
 
+/// Appends the decimal representation of @a _value without creating a temporary string.
+void appendNumber(std::string& _output, int _value)
+{
+	char buffer[std::numeric_limits<int>::digits10 + 2];
+	auto result = std::to_chars(std::begin(buffer), std::end(buffer), _value);
+	_output.append(buffer, result.ptr);
+}
+
 std::string toStringInHex(u256 _value)
 {
 	std::stringstream hexStr;
@@ -74,7 +83,7 @@ std::pair<std::string, std::string> AssemblyItem::nameAndData(langutil::EVMVersi
 	switch (type())
 	{
 	case Operation:
-		return {instructionInfo(instruction(), _evmVersion).name, m_data != nullptr ? toStringInHex(*m_data) : ""};
+		return {instructionInfo(instruction(), _evmVersion).name, ""};
 	case Push:
 		return {"PUSH", toStringInHex(data())};
 	case PushTag:
@@ -148,8 +157,11 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength, langutil::EVMVersion _
 			immutableOccurrences = 1; // Assume one immut. ref.
 		else
 		{
-			solAssert(m_immutableOccurrences, "No immutable references. `bytesRequired()` called before assembly()?");
-			immutableOccurrences = m_immutableOccurrences.value();
+			solAssert(
+				m_extraData && m_extraData->immutableOccurrences,
+				"No immutable references. `bytesRequired()` called before assembly()?"
+			);
+			immutableOccurrences = m_extraData->immutableOccurrences.value();
 		}
 
 		if (immutableOccurrences != 0)
@@ -160,7 +172,7 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength, langutil::EVMVersion _
 			return 2;
 	}
 	case VerbatimBytecode:
-		return std::get<2>(*m_verbatimBytecode).size();
+		return std::get<2>(verbatimBytecode()).size();
 	default:
 		break;
 	}
@@ -174,7 +186,7 @@ size_t AssemblyItem::arguments() const
 		// the same across all EVM versions except for the instruction name.
 		return static_cast<size_t>(instructionInfo(instruction(), EVMVersion()).args);
 	else if (type() == VerbatimBytecode)
-		return std::get<0>(*m_verbatimBytecode);
+		return std::get<0>(verbatimBytecode());
 	else if (type() == AssignImmutable)
 		return 2;
 	else
@@ -202,7 +214,7 @@ size_t AssemblyItem::returnValues() const
 	case Tag:
 		return 0;
 	case VerbatimBytecode:
-		return std::get<1>(*m_verbatimBytecode);
+		return std::get<1>(verbatimBytecode());
 	default:
 		break;
 	}
@@ -325,7 +337,7 @@ std::string AssemblyItem::toAssemblyText(Assembly const& _assembly) const
 		assertThrow(false, AssemblyException, "Invalid assembly item.");
 		break;
 	case VerbatimBytecode:
-		text = std::string("verbatimbytecode_") + util::toHex(std::get<2>(*m_verbatimBytecode));
+		text = std::string("verbatimbytecode_") + util::toHex(std::get<2>(verbatimBytecode()));
 		break;
 	default:
 		assertThrow(false, InvalidOpcode, "");
@@ -414,10 +426,10 @@ size_t AssemblyItem::opcodeCount() const noexcept
 			// For n immutable occurrences the first (n - 1) occurrences will
 			// generate 5 opcodes and the last will generate 3 opcodes,
 			// because it is reusing the 2 top-most elements on the stack.
-			solAssert(m_immutableOccurrences, "");
+			solAssert(m_extraData && m_extraData->immutableOccurrences, "");
 
-			if (m_immutableOccurrences.value() != 0)
-				return (*m_immutableOccurrences - 1) * 5 + 3;
+			if (m_extraData->immutableOccurrences.value() != 0)
+				return (*m_extraData->immutableOccurrences - 1) * 5 + 3;
 			else
 				return 2; // two POP's
 		default:
@@ -431,12 +443,17 @@ std::string AssemblyItem::computeSourceMapping(
 )
 {
 	std::string ret;
+	// Most items are only separated by a semicolon, since their location does not change.
+	ret.reserve(_items.size() * 2);
 
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Consecutive items usually share the same source name object, so its index is only
+	// looked up again if the object changes.
+	std::string const* prevSourceName = nullptr;
 
 	for (auto const& item: _items)
 	{
@@ -445,10 +462,13 @@ std::string AssemblyItem::computeSourceMapping(
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			(location.sourceName && _sourceIndicesMap.count(*location.sourceName)) ?
-			static_cast<int>(_sourceIndicesMap.at(*location.sourceName)) :
-			-1;
+		int sourceIndex = prevSourceIndex;
+		if (location.sourceName.get() != prevSourceName)
+		{
+			prevSourceName = location.sourceName.get();
+			auto index = location.sourceName ? _sourceIndicesMap.find(*location.sourceName) : _sourceIndicesMap.end();
+			sourceIndex = index != _sourceIndicesMap.end() ? static_cast<int>(index->second) : -1;
+		}
 		char jump = '-';
 		// TODO: Uncomment when EOF functions introduced.
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction /*|| item.type() == CallF || item.type() == JumpF*/)
@@ -480,17 +500,17 @@ std::string AssemblyItem::computeSourceMapping(
 		if (components-- > 0)
 		{
 			if (location.start != prevStart)
-				ret += std::to_string(location.start);
+				appendNumber(ret, location.start);
 			if (components-- > 0)
 			{
 				ret += ':';
 				if (length != prevLength)
-					ret += std::to_string(length);
+					appendNumber(ret, length);
 				if (components-- > 0)
 				{
 					ret += ':';
 					if (sourceIndex != prevSourceIndex)
-						ret += std::to_string(sourceIndex);
+						appendNumber(ret, sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
@@ -500,7 +520,7 @@ std::string AssemblyItem::computeSourceMapping(
 						{
 							ret += ':';
 							if (modifierDepth != prevModifierDepth)
-								ret += std::to_string(modifierDepth);
+								appendNumber(ret, modifierDepth);
 						}
 					}
 				}
@@ -508,7 +528,7 @@ std::string AssemblyItem::computeSourceMapping(
 		}
 
 		if (item.opcodeCount() > 1)
-			ret += std::string(item.opcodeCount() - 1, ';');
+			ret.append(item.opcodeCount() - 1, ';');
 
 		prevStart = location.start;
 		prevLength = length;
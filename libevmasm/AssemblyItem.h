@@ -63,7 +63,7 @@ using AssemblyItems = std::vector<AssemblyItem>;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::DebugData::ConstPtr _debugData = langutil::DebugData::create()):
 		AssemblyItem(Push, std::move(_push), std::move(_debugData)) { }
@@ -79,14 +79,16 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			m_data = std::move(_data);
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}},
-		m_debugData{langutil::DebugData::create()}
-	{}
+		m_debugData{langutil::DebugData::create()},
+		m_extraData{std::make_shared<ExtraData>()}
+	{
+		m_extraData->verbatimBytecode = {_arguments, _returnVariables, std::move(_verbatimData)};
+	}
 
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -105,8 +107,8 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return m_data; }
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = _data; }
 
 	/// This function is used in `Assembly::assemblyJSON`.
 	/// It returns the name & data of the current assembly item.
@@ -116,7 +118,7 @@ public:
 	/// of it's data.
 	std::pair<std::string, std::string> nameAndData(langutil::EVMVersion _evmVersion) const;
 
-	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(*m_verbatimBytecode); }
+	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(verbatimBytecode()); }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
@@ -129,7 +131,7 @@ public:
 		if (type() == Operation)
 			return instruction() == _other.instruction();
 		else if (type() == VerbatimBytecode)
-			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
+			return verbatimBytecode() == _other.verbatimBytecode();
 		else
 			return data() == _other.data();
 	}
@@ -142,7 +144,7 @@ public:
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
 		else if (type() == VerbatimBytecode)
-			return *m_verbatimBytecode < *_other.m_verbatimBytecode;
+			return verbatimBytecode() < _other.verbatimBytecode();
 		else
 			return data() < _other.data();
 	}
@@ -202,31 +204,54 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(u256 const& _value) const { modifyExtraData().pushedValue = _value; }
+	u256 const* pushedValue() const { return m_extraData && m_extraData->pushedValue ? &*m_extraData->pushedValue : nullptr; }
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
 	size_t m_modifierDepth = 0;
 
-	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
+	void setImmutableOccurrences(size_t _n) const { modifyExtraData().immutableOccurrences = _n; }
 
 private:
+	/// Fields that only few items use. They are kept out of line, so that copying an item
+	/// does not copy them and items without them stay small.
+	struct ExtraData
+	{
+		/// If m_type == VerbatimBytecode, this holds number of arguments, number of
+		/// return variables and verbatim bytecode.
+		std::tuple<size_t, size_t, bytes> verbatimBytecode;
+		/// Pushed value for operations with data to be determined during assembly stage,
+		/// e.g. PushSubSize, PushTag, PushSub, etc.
+		std::optional<u256> pushedValue;
+		/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
+		std::optional<size_t> immutableOccurrences;
+	};
+
 	size_t opcodeCount() const noexcept;
 
+	std::tuple<size_t, size_t, bytes> const& verbatimBytecode() const
+	{
+		solAssert(m_extraData);
+		return m_extraData->verbatimBytecode;
+	}
+	/// @returns the extra data of this item for modification. The extra data is shared between
+	/// copies of an item, so it is copied first unless this item is its only owner.
+	ExtraData& modifyExtraData() const
+	{
+		if (!m_extraData)
+			m_extraData = std::make_shared<ExtraData>();
+		else if (m_extraData.use_count() > 1)
+			m_extraData = std::make_shared<ExtraData>(*m_extraData);
+		return *m_extraData;
+	}
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
-	langutil::DebugData::ConstPtr m_debugData;
 	JumpType m_jumpType = JumpType::Ordinary;
-	/// Pushed value for operations with data to be determined during assembly stage,
-	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
-	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
-	mutable std::optional<size_t> m_immutableOccurrences;
+	u256 m_data; ///< Only valid if m_type != Operation
+	langutil::DebugData::ConstPtr m_debugData;
+	mutable std::shared_ptr<ExtraData> m_extraData;
 };
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength, langutil::EVMVersion _evmVersion, Precision _precision = Precision::Precise)
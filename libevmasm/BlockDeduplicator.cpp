@@ -27,8 +27,10 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <boost/container_hash/hash.hpp>
+
+#include <algorithm>
+#include <unordered_map>
 
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -48,48 +50,86 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	std::function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	auto blocksEqual = [&](size_t _i, size_t _j)
 	{
-		if (_i == _j)
-			return false;
-
 		// To compare recursive loops, we have to already unify PushTag opcodes of the
 		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
+		AssemblyItem pushFirstTag = m_items.at(_i).pushTag();
+		AssemblyItem pushSecondTag = m_items.at(_j).pushTag();
 
 		using diff_type = BlockIterator::difference_type;
 		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
 		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
 		BlockIterator end{m_items.end(), m_items.end()};
 
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
+		// Skip the tags themselves.
+		++first;
+		++second;
 
-		return std::lexicographical_compare(first, end, second, end);
+		return std::equal(first, end, second, end, [](AssemblyItem const& _a, AssemblyItem const& _b) {
+			return !(_a < _b) && !(_b < _a);
+		});
 	};
 
+	// Hash the suffix starting at each index in the same way as it is compared above, except that the
+	// data of PushTag items is ignored. Thus, the hashes are independent of the block's own tag and do not
+	// change when tags are replaced below. Additionally determine whether the suffix contains any PushTag.
+	std::vector<size_t> suffixHashes(m_items.size() + 1, 0);
+	std::vector<bool> suffixPushesTags(m_items.size() + 1, false);
+	for (size_t i = m_items.size(); i-- > 0;)
+	{
+		AssemblyItem const& item = m_items[i];
+		if (item.type() == Tag)
+		{
+			suffixHashes[i] = suffixHashes[i + 1];
+			suffixPushesTags[i] = suffixPushesTags[i + 1];
+			continue;
+		}
+		bool continues = !SemanticInformation::altersControlFlow(item) || item == Instruction::JUMPI;
+		size_t seed = continues ? suffixHashes[i + 1] : 0;
+		boost::hash_combine(seed, item.type());
+		if (item.type() == Operation)
+			boost::hash_combine(seed, item.instruction());
+		else if (item.type() != PushTag && item.type() != VerbatimBytecode)
+			boost::hash_combine(seed, item.data());
+		suffixHashes[i] = seed;
+		suffixPushesTags[i] = item.type() == PushTag || (continues && suffixPushesTags[i + 1]);
+	}
+
+	// Group the tags by the hashes of their blocks. Only tags in the same group can ever be unified.
+	std::vector<std::vector<size_t>> groups;
+	{
+		std::unordered_map<size_t, size_t> groupByHash;
+		for (size_t i = 0; i < m_items.size(); ++i)
+			if (m_items[i].type() == Tag)
+			{
+				auto [it, inserted] = groupByHash.emplace(suffixHashes[i + 1], groups.size());
+				if (inserted)
+					groups.emplace_back();
+				groups[it->second].push_back(i);
+			}
+	}
+
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		std::set<size_t, std::function<bool(size_t, size_t)>> blocksSeen(comparator);
-		for (size_t i = 0; i < m_items.size(); ++i)
+		for (std::vector<size_t> const& group: groups)
 		{
-			if (m_items.at(i).type() != Tag)
+			if (group.size() < 2)
+				continue;
+			// Replacing tags can only affect the comparison of blocks that push tags.
+			if (iterations > 0 && std::none_of(group.begin(), group.end(), [&](size_t _i) { return suffixPushesTags[_i + 1]; }))
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
-			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+			// Replace each tag by the first earlier tag with an equal block.
+			std::vector<size_t> distinctBlocks;
+			for (size_t i: group)
+			{
+				auto it = std::find_if(distinctBlocks.begin(), distinctBlocks.end(), [&](size_t _j) { return blocksEqual(_j, i); });
+				if (it == distinctBlocks.end())
+					distinctBlocks.push_back(i);
+				else
+					m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+			}
 		}
 
 		if (!applyTagReplacement(m_items, m_replacedTags))
@@ -24,9 +24,38 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// The cheapest representation of a constant. It only depends on the value of the constant and the parameters
+/// of the optimisation, so it is cached across assemblies.
+struct Representation
+{
+	enum class Method { Literal, CodeCopy, Compute };
+	Method method = Method::Literal;
+	/// The routine computing the constant, if @a method is Compute.
+	AssemblyItems routine;
+};
+
+/// Value, EVM version, runs, creation flag and multiplicity of a constant.
+using RepresentationKey = std::tuple<u256, langutil::EVMVersion, size_t, bool, size_t>;
+
+/// Upper bound for the number of cached representations, the cache is cleared when it is reached.
+size_t constexpr maxCachedRepresentations = 0x10000;
+
+std::mutex representationCacheMutex;
+std::map<RepresentationKey, Representation> representationCache;
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -55,22 +84,47 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 			params.isCreation = _isCreation;
 			params.runs = _runs;
 			params.evmVersion = _evmVersion;
-			LiteralMethod lit(params, item.data());
-			bigint literalGas = lit.gasNeeded();
-			CodeCopyMethod copy(params, item.data());
-			bigint copyGas = copy.gasNeeded();
-			ComputeMethod compute(params, item.data());
-			bigint computeGas = compute.gasNeeded();
-			AssemblyItems replacement;
-			if (copyGas < literalGas && copyGas < computeGas)
+			RepresentationKey key{item.data(), _evmVersion, _runs, _isCreation, params.multiplicity};
+			std::optional<Representation> representation;
 			{
-				replacement = copy.execute(_assembly);
-				optimisations++;
+				std::lock_guard<std::mutex> lock(representationCacheMutex);
+				if (auto cached = representationCache.find(key); cached != representationCache.end())
+					representation = cached->second;
 			}
-			else if (computeGas < literalGas && computeGas <= copyGas)
+			if (!representation)
 			{
-				replacement = compute.execute(_assembly);
+				representation.emplace();
+				LiteralMethod lit(params, item.data());
+				bigint literalGas = lit.gasNeeded();
+				CodeCopyMethod copy(params, item.data());
+				bigint copyGas = copy.gasNeeded();
+				ComputeMethod compute(params, item.data());
+				bigint computeGas = compute.gasNeeded();
+				if (copyGas < literalGas && copyGas < computeGas)
+					representation->method = Representation::Method::CodeCopy;
+				else if (computeGas < literalGas && computeGas <= copyGas)
+				{
+					representation->method = Representation::Method::Compute;
+					representation->routine = compute.execute(_assembly);
+				}
+				std::lock_guard<std::mutex> lock(representationCacheMutex);
+				if (representationCache.size() >= maxCachedRepresentations)
+					representationCache.clear();
+				representationCache.emplace(key, *representation);
+			}
+			AssemblyItems replacement;
+			switch (representation->method)
+			{
+			case Representation::Method::Literal:
+				break;
+			case Representation::Method::CodeCopy:
+				replacement = CodeCopyMethod(params, item.data()).execute(_assembly);
+				optimisations++;
+				break;
+			case Representation::Method::Compute:
+				replacement = representation->routine;
 				optimisations++;
+				break;
 			}
 			if (!replacement.empty())
 				pendingReplacements[item.data()] = replacement;
@@ -97,7 +151,7 @@ bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items, lan
 	return gas;
 }
 
-bigint ConstantOptimisationMethod::dataGas(bytes const& _data) const
+bigint ConstantOptimisationMethod::dataGas(bytesConstRef _data) const
 {
 	assertThrow(_data.size() > 0, OptimizerException, "Empty bytecode generated.");
 	return bigint(GasMeter::dataGas(_data, m_params.isCreation, m_params.evmVersion));
@@ -135,7 +189,7 @@ bigint LiteralMethod::gasNeeded() const
 	return combineGas(
 		simpleRunGas({Instruction::PUSH1}, m_params.evmVersion),
 		// PUSHX plus data
-		(m_params.isCreation ? GasCosts::txDataNonZeroGas(m_params.evmVersion) : GasCosts::createDataGas) + dataGas(toCompactBigEndian(m_value, 1)),
+		(m_params.isCreation ? GasCosts::txDataNonZeroGas(m_params.evmVersion) : GasCosts::createDataGas) + dataGas(toCompactBigEndianInline(m_value, 1).ref()),
 		0
 	);
 }
@@ -148,7 +202,7 @@ bigint CodeCopyMethod::gasNeeded() const
 		// Data gas for copy routines: Some bytes are zero, but we ignore them.
 		bytesRequired(copyRoutine(), m_params.evmVersion) * (m_params.isCreation ? GasCosts::txDataNonZeroGas(m_params.evmVersion) : GasCosts::createDataGas),
 		// Data gas for data itself
-		dataGas(toBigEndian(m_value))
+		dataGas(util::h256(m_value).ref())
 	);
 }
 
@@ -259,24 +313,38 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 			if (abs(lowerPart) >= (powerOfTwo >> 8))
 				continue;
 
-			AssemblyItems newRoutine;
-			if (lowerPart != 0)
-				newRoutine += findRepresentation(u256(abs(lowerPart)));
-			if (m_params.evmVersion.hasBitwiseShifting())
-			{
-				newRoutine += findRepresentation(upperPart);
-				newRoutine += AssemblyItems{u256(bits), Instruction::SHL};
-			}
-			else
+			auto composeRoutine = [&](auto&& _representation) {
+				AssemblyItems newRoutine;
+				if (lowerPart != 0)
+					newRoutine += _representation(u256(abs(lowerPart)));
+				if (m_params.evmVersion.hasBitwiseShifting())
+				{
+					newRoutine += _representation(upperPart);
+					newRoutine += AssemblyItems{u256(bits), Instruction::SHL};
+				}
+				else
+				{
+					newRoutine += AssemblyItems{u256(bits), u256(2), Instruction::EXP};
+					if (upperPart != 1)
+						newRoutine += _representation(upperPart) + AssemblyItems{Instruction::MUL};
+				}
+				if (lowerPart > 0)
+					newRoutine += AssemblyItems{Instruction::ADD};
+				else if (lowerPart < 0)
+					newRoutine.push_back(Instruction::SUB);
+				return newRoutine;
+			};
+
+			// Every representation contains at least one push, which is never cheaper than pushing zero.
+			// Since the gas of a routine is the sum of the gas of its items, this bounds the gas of the
+			// decomposition from below without searching representations of its parts.
+			if (gasNeeded(composeRoutine([](u256 const&) { return AssemblyItems{u256(0)}; })) >= bestGas)
 			{
-				newRoutine += AssemblyItems{u256(bits), u256(2), Instruction::EXP};
-				if (upperPart != 1)
-					newRoutine += findRepresentation(upperPart) + AssemblyItems{Instruction::MUL};
+				if (m_maxSteps > 0)
+					m_maxSteps--;
+				continue;
 			}
-			if (lowerPart > 0)
-				newRoutine += AssemblyItems{Instruction::ADD};
-			else if (lowerPart < 0)
-				newRoutine.push_back(Instruction::SUB);
+			AssemblyItems newRoutine = composeRoutine([&](u256 const& _part) { return findRepresentation(_part); });
 
 			if (m_maxSteps > 0)
 				m_maxSteps--;
@@ -179,10 +179,16 @@ u256 const* ExpressionClasses::knownConstant(Id _c)
 	return &constant.d();
 }
 
+void ExpressionClasses::clear()
+{
+	m_representatives.clear();
+	m_expressions.clear();
+	m_spareAssemblyItems.clear();
+}
+
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
 {
-	m_spareAssemblyItems.push_back(std::make_shared<AssemblyItem>(_item));
-	return m_spareAssemblyItems.back().get();
+	return &m_spareAssemblyItems.emplace_back(_item);
 }
 
 std::string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
@@ -204,7 +210,8 @@ std::string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// Rules store their match groups internally, so each thread needs its own instance.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
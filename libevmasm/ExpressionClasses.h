@@ -28,6 +28,7 @@
 
 #include <libsolutil/Common.h>
 
+#include <deque>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -53,6 +54,11 @@ public:
 	using Id = unsigned;
 	using Ids = std::vector<Id>;
 
+	ExpressionClasses() = default;
+	/// Expressions point into the item storage of their container, so copies would dangle.
+	ExpressionClasses(ExpressionClasses const&) = delete;
+	ExpressionClasses& operator=(ExpressionClasses const&) = delete;
+
 	struct Expression
 	{
 		Id id;
@@ -85,6 +91,10 @@ public:
 	Expression const& representative(Id _id) const { return m_representatives.at(_id); }
 	/// @returns the number of classes.
 	size_t size() const { return m_representatives.size(); }
+	/// Removes all classes and stored items, but keeps the memory allocated for them, so that the
+	/// same object can be used for the next block without rebuilding its tables from scratch.
+	/// Invalidates all ids and all pointers returned by @a storeItem.
+	void clear();
 
 	/// Forces the given @a _item with @a _arguments to the class @a _id. This can be used to
 	/// add prior knowledge e.g. about CALLDATA, but has to be used with caution. Will not work as
@@ -129,7 +139,8 @@ private:
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
 	std::unordered_set<Expression, Expression::ExpressionHash> m_expressions;
-	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
+	/// Items referenced by the expressions, the container keeps their addresses stable.
+	std::deque<AssemblyItem> m_spareAssemblyItems;
 };
 
 }
@@ -38,7 +38,11 @@ GasMeter::GasConsumption& GasMeter::GasConsumption::operator+=(GasConsumption co
 	return *this;
 }
 
-GasMeter::GasConsumption GasMeter::estimateMax(AssemblyItem const& _item, bool _includeExternalCosts)
+GasMeter::GasConsumption GasMeter::estimateMax(
+	AssemblyItem const& _item,
+	bool _includeExternalCosts,
+	bool _includeForwardedGas
+)
 {
 	GasConsumption gas;
 	switch (_item.type())
@@ -157,10 +161,13 @@ GasMeter::GasConsumption GasMeter::estimateMax(AssemblyItem const& _item, bool _
 			else
 			{
 				gas = GasCosts::callGas(m_evmVersion);
-				if (u256 const* value = classes.knownConstant(m_state->relativeStackElement(0)))
-					gas += (*value);
-				else
-					gas = GasConsumption::infinite();
+				if (_includeForwardedGas)
+				{
+					if (u256 const* value = classes.knownConstant(m_state->relativeStackElement(0)))
+						gas += (*value);
+					else
+						gas = GasConsumption::infinite();
+				}
 				if (_item.instruction() == Instruction::CALL)
 					gas += GasCosts::callNewAccountGas; // We very rarely know whether the address exists.
 				int valueSize = 1;
@@ -294,7 +301,7 @@ unsigned GasMeter::pushGas(u256 _value, langutil::EVMVersion _evmVersion)
 	);
 }
 
-u256 GasMeter::dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion)
+u256 GasMeter::dataGas(bytesConstRef _data, bool _inCreation, langutil::EVMVersion _evmVersion)
 {
 	bigint gas = 0;
 	if (_inCreation)
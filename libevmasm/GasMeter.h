@@ -217,7 +217,13 @@ public:
 	/// @returns an upper bound on the gas consumed by the given instruction and updates
 	/// the state.
 	/// @param _includeExternalCosts if true, include costs caused by other contracts in calls.
-	GasConsumption estimateMax(AssemblyItem const& _item, bool _includeExternalCosts = true);
+	/// @param _includeForwardedGas if false and external costs are not included, do not include
+	/// the gas forwarded to other contracts in calls either.
+	GasConsumption estimateMax(
+		AssemblyItem const& _item,
+		bool _includeExternalCosts = true,
+		bool _includeForwardedGas = true
+	);
 
 	u256 const& largestMemoryAccess() const { return m_largestMemoryAccess; }
 
@@ -231,7 +237,11 @@ public:
 	/// @returns the gas cost of the supplied data, depending whether it is in creation code, or not.
 	/// In case of @a _inCreation, the data is only sent as a transaction and is not stored, whereas
 	/// otherwise code will be stored and have to pay "createDataGas" cost.
-	static u256 dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion);
+	static u256 dataGas(bytesConstRef _data, bool _inCreation, langutil::EVMVersion _evmVersion);
+	static u256 dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion)
+	{
+		return dataGas(bytesConstRef(&_data), _inCreation, _evmVersion);
+	}
 
 	/// @returns the gas cost of non-zero data of the supplied length, depending whether it is in creation code, or not.
 	/// In case of @a _inCreation, the data is only sent as a transaction and is not stored, whereas
@@ -35,6 +35,7 @@
 #include <range/v3/view/slice.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
 #include <optional>
 #include <limits>
 
@@ -137,6 +138,17 @@ std::map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(Asse
 }
 
 bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const
+{
+	// If the estimated runtime cost over the lifetime of the contract plus the deposit cost in the uninlined case
+	// exceed the inlined deposit costs, it is beneficial to inline.
+	return estimateFullInlining(_tag, _block, _pushTagCount).gasSaved > 0;
+}
+
+Inliner::FullInliningEstimate Inliner::estimateFullInlining(
+	size_t _tag,
+	ranges::span<AssemblyItem const> _block,
+	uint64_t _pushTagCount
+) const
 {
 	// Accumulate size of the inline candidate block in bytes (without the return jump).
 	uint64_t functionBodySize = codeSize(ranges::views::drop_last(_block, 1), m_evmVersion);
@@ -166,36 +178,65 @@ bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyIte
 		executionCost(uninlinedFunctionPattern, m_evmVersion)
 	);
 	// Each call site deposits the call site pattern, whereas the jump site pattern and the function itself are deposited once.
-	bigint uninlinedDepositCost = GasMeter::dataGas(
+	bigint uninlinedSize =
 		numberOfCallSites * codeSize(uninlinedCallSitePattern, m_evmVersion) +
 		codeSize(uninlinedFunctionPattern, m_evmVersion) +
-		functionBodySize,
-		m_isCreation,
-		m_evmVersion
-	);
+		functionBodySize;
 	// When inlining the execution cost beyond the actual function execution is zero,
 	// but for each call site a copy of the function is deposited.
-	bigint inlinedDepositCost = GasMeter::dataGas(
-		numberOfCallSites * functionBodySize,
-		m_isCreation,
-		m_evmVersion
-	);
+	bigint inlinedSize = numberOfCallSites * functionBodySize;
 	// If the block is referenced from outside the current subassembly, the original function cannot be removed.
 	// Note that the function also cannot always be removed, if it is not referenced from outside, but in that case
 	// the heuristics is optimistic.
 	if (m_tagsReferencedFromOutside.count(_tag))
-		inlinedDepositCost += GasMeter::dataGas(
-			codeSize(uninlinedFunctionPattern, m_evmVersion) + functionBodySize,
-			m_isCreation,
-			m_evmVersion
-		);
+		inlinedSize += codeSize(uninlinedFunctionPattern, m_evmVersion) + functionBodySize;
 
-	// If the estimated runtime cost over the lifetime of the contract plus the deposit cost in the uninlined case
-	// exceed the inlined deposit costs, it is beneficial to inline.
-	if (bigint(m_runs) * uninlinedExecutionCost + uninlinedDepositCost > inlinedDepositCost)
-		return true;
+	bigint uninlinedDepositCost = GasMeter::dataGas(static_cast<uint64_t>(uninlinedSize), m_isCreation, m_evmVersion);
+	bigint inlinedDepositCost = GasMeter::dataGas(static_cast<uint64_t>(inlinedSize), m_isCreation, m_evmVersion);
+	return {
+		bigint(m_runs) * uninlinedExecutionCost + uninlinedDepositCost - inlinedDepositCost,
+		inlinedSize - uninlinedSize
+	};
+}
+
+std::set<size_t> Inliner::selectFullFunctionBodies(std::map<size_t, InlinableBlock> const& _blocks) const
+{
+	assertThrow(m_codeSizeLimit, OptimizerException, "");
+
+	std::vector<std::pair<size_t, FullInliningEstimate>> candidates;
+	for (auto&& [tag, block]: _blocks)
+	{
+		AssemblyItem const& blockExit = block.items.back();
+		if (blockExit != Instruction::JUMP || blockExit.getJumpType() != AssemblyItem::JumpType::OutOfFunction)
+			continue;
+		FullInliningEstimate estimate = estimateFullInlining(tag, block.items, block.pushTagCount);
+		if (estimate.gasSaved > 0)
+			candidates.emplace_back(tag, std::move(estimate));
+	}
 
-	return false;
+	// Candidates that do not grow the code come first, ordered by the gas they save,
+	// followed by all others ordered by the gas they save per byte they add.
+	std::stable_sort(candidates.begin(), candidates.end(), [](auto const& _a, auto const& _b) {
+		FullInliningEstimate const& a = _a.second;
+		FullInliningEstimate const& b = _b.second;
+		bool aGrows = a.bytesAdded > 0;
+		bool bGrows = b.bytesAdded > 0;
+		if (aGrows != bGrows)
+			return bGrows;
+		if (!aGrows)
+			return a.gasSaved > b.gasSaved;
+		return a.gasSaved * b.bytesAdded > b.gasSaved * a.bytesAdded;
+	});
+
+	bigint size = codeSize(m_items, m_evmVersion);
+	std::set<size_t> selected;
+	for (auto const& [tag, estimate]: candidates)
+		if (estimate.bytesAdded <= 0 || size + estimate.bytesAdded <= *m_codeSizeLimit)
+		{
+			selected.insert(tag);
+			size += estimate.bytesAdded;
+		}
+	return selected;
 }
 
 std::optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block) const
@@ -207,7 +248,11 @@ std::optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem cons
 		_jump.getJumpType() == AssemblyItem::JumpType::IntoFunction &&
 		blockExit == Instruction::JUMP &&
 		blockExit.getJumpType() == AssemblyItem::JumpType::OutOfFunction &&
-		shouldInlineFullFunctionBody(_tag, _block.items, _block.pushTagCount)
+		(
+			m_codeSizeLimit ?
+			m_selectedFullFunctionBodies.count(_tag) > 0 :
+			shouldInlineFullFunctionBody(_tag, _block.items, _block.pushTagCount)
+		)
 	)
 	{
 		blockExit.setJumpType(AssemblyItem::JumpType::Ordinary);
@@ -242,6 +287,9 @@ void Inliner::optimise()
 	if (inlinableBlocks.empty())
 		return;
 
+	if (m_codeSizeLimit)
+		m_selectedFullFunctionBodies = selectFullFunctionBodies(inlinableBlocks);
+
 	AssemblyItems newItems;
 	for (auto it = m_items.begin(); it != m_items.end(); ++it)
 	{
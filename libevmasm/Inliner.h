@@ -28,6 +28,7 @@
 
 #include <range/v3/view/span.hpp>
 #include <map>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -42,13 +43,15 @@ public:
 		std::set<size_t> const& _tagsReferencedFromOutside,
 		size_t _runs,
 		bool _isCreation,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		std::optional<size_t> _codeSizeLimit = std::nullopt
 	):
 	m_items(_items),
 	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
 	m_runs(_runs),
 	m_isCreation(_isCreation),
-	m_evmVersion(_evmVersion)
+	m_evmVersion(_evmVersion),
+	m_codeSizeLimit(_codeSizeLimit)
 	{
 	}
 	virtual ~Inliner() = default;
@@ -62,12 +65,28 @@ private:
 		uint64_t pushTagCount = 0;
 	};
 
+	/// Estimated effect of inlining a full function body at all of its call sites.
+	struct FullInliningEstimate
+	{
+		/// Gas saved over the lifetime of the contract including deposit costs, negative if inlining is more expensive.
+		bigint gasSaved;
+		/// Number of bytes by which the code grows, negative if it shrinks.
+		bigint bytesAdded;
+	};
+
 	/// @returns the exit item for the block to be inlined, if a particular jump to it should be inlined, otherwise nullopt.
 	std::optional<AssemblyItem> shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block) const;
 	/// @returns true, if the full function at tag @a _tag with body @a _block that is referenced @a _pushTagCount times
 	/// should be inlined, false otherwise. @a _block should start at the first instruction after the function entry tag
 	/// up to and including the return jump.
 	bool shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const;
+	/// @returns the estimated gas saved and code size added by inlining the full function at tag @a _tag
+	/// with body @a _block that is referenced @a _pushTagCount times.
+	FullInliningEstimate estimateFullInlining(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const;
+	/// @returns the tags of the functions among @a _blocks whose full bodies are inlined if a code size limit is given.
+	/// Candidates are ranked by estimated gas saved per byte added and selected as long as the estimated
+	/// code size stays below the limit.
+	std::set<size_t> selectFullFunctionBodies(std::map<size_t, InlinableBlock> const& _blocks) const;
 	/// @returns true, if the @a _items at @a _tag are a potential candidate for inlining.
 	bool isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _items) const;
 	/// @returns a map from tags that can potentially be inlined to the inlinable item range behind that tag and the
@@ -79,6 +98,10 @@ private:
 	size_t const m_runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
 	bool const m_isCreation = false;
 	langutil::EVMVersion const m_evmVersion;
+	/// If set, full function bodies are only inlined as long as the code stays below this size in bytes.
+	std::optional<size_t> const m_codeSizeLimit;
+	/// The functions selected by @a selectFullFunctionBodies, only used if @a m_codeSizeLimit is set.
+	std::set<size_t> m_selectedFullFunctionBodies;
 };
 
 }
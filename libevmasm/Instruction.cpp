@@ -22,11 +22,20 @@
 
 #include <libevmasm/Instruction.h>
 
+#include <array>
+#include <optional>
+#include <string_view>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::evmasm;
 
-std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
+namespace
+{
+
+/// Mnemonics of all instructions. Kept as a constant table, so that it does not need to be
+/// initialized at startup.
+constexpr std::pair<std::string_view, Instruction> c_instructionNames[] =
 {
 	{ "STOP", Instruction::STOP },
 	{ "ADD", Instruction::ADD },
@@ -180,8 +189,23 @@ std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
 	{ "SELFDESTRUCT", Instruction::SELFDESTRUCT }
 };
 
+/// Constant counterpart of InstructionInfo.
+struct InstructionInfoEntry
+{
+	Instruction instruction;
+	struct
+	{
+		std::string_view name;
+		int additional;
+		int args;
+		int ret;
+		bool sideEffects;
+		Tier gasPriceTier;
+	} info;
+};
+
 /// @note InstructionInfo is assumed to be the same across all EVM versions except for the instruction name.
-static std::map<Instruction, InstructionInfo> const c_instructionInfo =
+constexpr InstructionInfoEntry c_instructionInfo[] =
 {   //                                                Add Args Ret SideEffects GasPriceTier
 	{Instruction::STOP,           {"STOP",            0,  0,   0,  true,       Tier::Zero}},
 	{Instruction::ADD,            {"ADD",             0,  2,   1,  false,      Tier::VeryLow}},
@@ -334,21 +358,48 @@ static std::map<Instruction, InstructionInfo> const c_instructionInfo =
 	{Instruction::SELFDESTRUCT,   {"SELFDESTRUCT",    0,  1,   0,  true,       Tier::Special}}
 };
 
+/// @returns the information on all instructions, indexed by opcode, created on first use.
+std::array<std::optional<InstructionInfo>, 256> const& instructionInfoByOpcode()
+{
+	static std::array<std::optional<InstructionInfo>, 256> const infos = [] {
+		std::array<std::optional<InstructionInfo>, 256> result;
+		for (auto const& [instruction, info]: c_instructionInfo)
+			result[static_cast<uint8_t>(instruction)] = InstructionInfo{
+				std::string(info.name),
+				info.additional,
+				info.args,
+				info.ret,
+				info.sideEffects,
+				info.gasPriceTier
+			};
+		return result;
+	}();
+	return infos;
+}
+
+}
+
+std::map<std::string, Instruction> const& solidity::evmasm::instructionsByName()
+{
+	static std::map<std::string, Instruction> const instructions = [] {
+		std::map<std::string, Instruction> result;
+		for (auto const& [name, instruction]: c_instructionNames)
+			result.emplace(name, instruction);
+		return result;
+	}();
+	return instructions;
+}
+
 InstructionInfo solidity::evmasm::instructionInfo(Instruction _inst, langutil::EVMVersion _evmVersion)
 {
-	try
-	{
-		if (_inst == Instruction::PREVRANDAO && _evmVersion < langutil::EVMVersion::paris())
-			return InstructionInfo({ "DIFFICULTY", 0, 0, 1, false, Tier::Base });
-		return c_instructionInfo.at(_inst);
-	}
-	catch (...)
-	{
-		return InstructionInfo({"<INVALID_INSTRUCTION: " + std::to_string(static_cast<unsigned>(_inst)) + ">", 0, 0, 0, false, Tier::Invalid});
-	}
+	if (_inst == Instruction::PREVRANDAO && _evmVersion < langutil::EVMVersion::paris())
+		return InstructionInfo({ "DIFFICULTY", 0, 0, 1, false, Tier::Base });
+	if (std::optional<InstructionInfo> const& info = instructionInfoByOpcode()[static_cast<uint8_t>(_inst)])
+		return *info;
+	return InstructionInfo({"<INVALID_INSTRUCTION: " + std::to_string(static_cast<unsigned>(_inst)) + ">", 0, 0, 0, false, Tier::Invalid});
 }
 
 bool solidity::evmasm::isValidInstruction(Instruction _inst)
 {
-	return !!c_instructionInfo.count(_inst);
+	return instructionInfoByOpcode()[static_cast<uint8_t>(_inst)].has_value();
 }
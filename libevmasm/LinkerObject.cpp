@@ -46,6 +46,21 @@ void LinkerObject::link(std::map<std::string, h160> const& _libraryAddresses)
 	linkReferences.swap(remainingRefs);
 }
 
+void LinkerObject::setImmutables(std::map<std::string, u256> const& _immutableValues)
+{
+	std::map<u256, ImmutableRefs> remainingRefs;
+	for (auto const& [hash, immutableRefs]: immutableReferences)
+		if (auto value = _immutableValues.find(immutableRefs.first); value != _immutableValues.end())
+		{
+			h256 const valueBytes(value->second);
+			for (size_t offset: immutableRefs.second)
+				copy(valueBytes.data(), valueBytes.data() + 32, bytecode.begin() + std::vector<uint8_t>::difference_type(offset));
+		}
+		else
+			remainingRefs.emplace(hash, immutableRefs);
+	immutableReferences.swap(remainingRefs);
+}
+
 std::string LinkerObject::toHex() const
 {
 	std::string hex = solidity::util::toHex(bytecode);
@@ -64,6 +64,10 @@ struct LinkerObject
 	/// Links the given libraries by replacing their uses in the code and removes them from the references.
 	void link(std::map<std::string, util::h160> const& _libraryAddresses);
 
+	/// Fills in the values of the given immutables, identified like in @a immutableReferences,
+	/// at all places they are referenced in the code and removes them from the references.
+	void setImmutables(std::map<std::string, u256> const& _immutableValues);
+
 	/// @returns a hex representation of the bytecode of the given object, replacing unlinked
 	/// addresses by placeholders. This output is lowercase.
 	std::string toHex() const;
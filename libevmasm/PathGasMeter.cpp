@@ -27,8 +27,33 @@
 using namespace solidity;
 using namespace solidity::evmasm;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+namespace
+{
+/// Maximum number of times a path may visit the same jumpdest in different contexts in the
+/// parametric estimation, which bounds the exploration of recursive functions.
+size_t constexpr maxVisitsPerJumpdest = 32;
+
+bool isExternalCallOrCreation(AssemblyItem const& _item)
+{
+	if (_item.type() != Operation)
+		return false;
+	switch (_item.instruction())
+	{
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return true;
+	default:
+		return false;
+	}
+}
+}
+
+PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion, size_t _maxSteps):
+	m_items(_items), m_evmVersion(_evmVersion), m_maxSteps(_maxSteps)
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -51,6 +76,18 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	return gas;
 }
 
+ParametricGasConsumption PathGasMeter::estimateParametric(
+	size_t _startIndex,
+	std::shared_ptr<KnownState> const& _state
+)
+{
+	m_parametric = ParametricGasConsumption{};
+	m_parametric->base = estimateMax(_startIndex, _state);
+	ParametricGasConsumption result = std::move(*m_parametric);
+	m_parametric.reset();
+	return result;
+}
+
 void PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
 {
 	if (
@@ -84,10 +121,19 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 	std::set<u256> jumpTags;
 	for (; index < m_items.size() && !gas.isInfinite; ++index)
 	{
+		// Give up on contracts with too many paths to explore in reasonable time.
+		if (++m_steps > m_maxSteps)
+			return GasMeter::GasConsumption::infinite();
+
 		bool branchStops = false;
 		jumpTags.clear();
 		AssemblyItem const& item = m_items.at(index);
-		if (item.type() == Tag || item == AssemblyItem(Instruction::JUMPDEST))
+		if (m_parametric && (item.type() == Tag || item == Instruction::JUMPDEST))
+		{
+			if (std::optional<GasMeter::GasConsumption> endOfPath = visitJumpdest(*path, index, *state, gas, meter.largestMemoryAccess()))
+				return *endOfPath;
+		}
+		else if (item.type() == Tag || item == Instruction::JUMPDEST)
 		{
 			// Do not allow any backwards jump. This is quite restrictive but should work for
 			// the simplest things.
@@ -95,14 +141,14 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 				return GasMeter::GasConsumption::infinite();
 			path->visitedJumpdests.insert(index);
 		}
-		else if (item == AssemblyItem(Instruction::JUMP))
+		else if (item == Instruction::JUMP)
 		{
 			branchStops = true;
 			jumpTags = state->tagsInExpression(state->relativeStackElement(0));
 			if (jumpTags.empty()) // unknown jump destination
 				return GasMeter::GasConsumption::infinite();
 		}
-		else if (item == AssemblyItem(Instruction::JUMPI))
+		else if (item == Instruction::JUMPI)
 		{
 			ExpressionClasses::Id condition = state->relativeStackElement(-1);
 			if (classes.knownNonZero(condition) || !classes.knownZero(condition))
@@ -116,7 +162,13 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		else if (SemanticInformation::altersControlFlow(item))
 			branchStops = true;
 
-		gas += meter.estimateMax(item);
+		if (m_parametric && isExternalCallOrCreation(item))
+		{
+			m_parametric->externalCalls.insert(index);
+			gas += meter.estimateMax(item, false, false);
+		}
+		else
+			gas += meter.estimateMax(item);
 
 		for (u256 const& tag: jumpTags)
 		{
@@ -128,6 +180,8 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
 			newPath->state = state->copy();
 			newPath->visitedJumpdests = path->visitedJumpdests;
+			newPath->jumpdestVisits = path->jumpdestVisits;
+			newPath->jumpdestVisitCount = path->jumpdestVisitCount;
 			queue(std::move(newPath));
 		}
 
@@ -137,3 +191,65 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 
 	return gas;
 }
+
+std::optional<GasMeter::GasConsumption> PathGasMeter::visitJumpdest(
+	GasPath& _path,
+	size_t _index,
+	KnownState& _state,
+	GasMeter::GasConsumption const& _gas,
+	u256 const& _largestMemoryAccess
+)
+{
+	if (_path.resumesLoop && _index == _path.index)
+	{
+		_path.resumesLoop = false;
+		return std::nullopt;
+	}
+
+	GasPath::JumpdestVisit visit{{_state.stackHeight(), {}}, _gas, _state.copy(), _path.jumpdestVisitCount++};
+	for (auto const& [height, element]: _state.stackElements())
+		if (height <= _state.stackHeight())
+			for (u256 const& tag: _state.tagsInExpression(element))
+				visit.context.second.emplace_back(height, tag);
+
+	std::vector<GasPath::JumpdestVisit>& visits = _path.jumpdestVisits[_index];
+	for (GasPath::JumpdestVisit const& previousVisit: visits)
+		if (previousVisit.context == visit.context)
+		{
+			// Back edge of a loop.
+			GasMeter::GasConsumption iteration = GasMeter::GasConsumption::infinite();
+			if (!_gas.isInfinite && !previousVisit.gas.isInfinite)
+				iteration = GasMeter::GasConsumption(_gas.value - previousVisit.gas.value);
+			GasMeter::GasConsumption& loop = m_parametric->loops[_index];
+			loop = std::max(loop, iteration);
+
+			if (!previousVisit.generalized)
+			{
+				// Follow the loop again from the state before its first iteration, but only with the
+				// knowledge that is still valid after it, forgetting the visits inside of the loop.
+				auto newPath = std::make_unique<GasPath>();
+				newPath->index = _index;
+				newPath->gas = previousVisit.gas;
+				newPath->largestMemoryAccess = _largestMemoryAccess;
+				newPath->state = previousVisit.state->copy();
+				newPath->state->reduceToCommonKnowledge(_state, true);
+				newPath->jumpdestVisitCount = previousVisit.sequenceNumber + 1;
+				for (auto const& [jumpdest, jumpdestVisits]: _path.jumpdestVisits)
+					for (GasPath::JumpdestVisit const& jumpdestVisit: jumpdestVisits)
+						if (jumpdestVisit.sequenceNumber <= previousVisit.sequenceNumber)
+							newPath->jumpdestVisits[jumpdest].emplace_back(jumpdestVisit);
+				for (GasPath::JumpdestVisit& loopVisit: newPath->jumpdestVisits[_index])
+					if (loopVisit.sequenceNumber == previousVisit.sequenceNumber)
+						loopVisit.generalized = true;
+				newPath->resumesLoop = true;
+				queue(std::move(newPath));
+			}
+			// The costs of the loop are accounted for per iteration.
+			return previousVisit.gas;
+		}
+
+	if (visits.size() >= maxVisitsPerJumpdest)
+		return GasMeter::GasConsumption::infinite();
+	visits.emplace_back(std::move(visit));
+	return std::nullopt;
+}
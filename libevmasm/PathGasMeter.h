@@ -26,9 +26,12 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <limits>
+#include <map>
 #include <set>
 #include <vector>
 #include <memory>
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -37,11 +40,45 @@ class KnownState;
 
 struct GasPath
 {
+	/// A visit of a jumpdest in the parametric estimation.
+	struct JumpdestVisit
+	{
+		/// Stack height and the tags on the stack, which tell loop iterations apart from repeated
+		/// calls to the same internal function.
+		std::pair<int, std::vector<std::pair<int, u256>>> context;
+		GasMeter::GasConsumption gas;
+		std::shared_ptr<KnownState> state;
+		/// Number of jumpdest visits of the path before this one.
+		size_t sequenceNumber = 0;
+		/// True if the loop starting at the jumpdest is already followed with the knowledge
+		/// common to all iterations.
+		bool generalized = false;
+	};
+
 	size_t index = 0;
 	std::shared_ptr<KnownState> state;
 	u256 largestMemoryAccess;
 	GasMeter::GasConsumption gas;
 	std::set<size_t> visitedJumpdests;
+	std::map<size_t, std::vector<JumpdestVisit>> jumpdestVisits;
+	size_t jumpdestVisitCount = 0;
+	/// True if the path starts at the head of a loop that is already recorded in jumpdestVisits.
+	bool resumesLoop = false;
+};
+
+/**
+ * Upper bound on the gas usage of a computation that depends on the number of loop iterations
+ * and on the gas forwarded to external calls.
+ */
+struct ParametricGasConsumption
+{
+	/// Gas used if no loop body is executed, excluding the gas forwarded to external calls.
+	GasMeter::GasConsumption base;
+	/// Gas used by every iteration of a loop, excluding the iterations of inner loops,
+	/// indexed by the position of the loop head.
+	std::map<size_t, GasMeter::GasConsumption> loops;
+	/// Positions of the external calls and contract creations that can be reached.
+	std::set<size_t> externalCalls;
 };
 
 /**
@@ -52,18 +89,45 @@ struct GasPath
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// @param _maxSteps upper bound on the number of assembly items evaluated across all paths. If it is
+	/// exceeded, the estimation gives up and returns an infinite gas consumption.
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _maxSteps = std::numeric_limits<size_t>::max()
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
+	/// Estimates the gas usage as a bound that grows linearly with the number of iterations of
+	/// each loop. Jumping back to a jumpdest with the same stack height and the same tags on
+	/// the stack is assumed to be the back edge of a loop, while repeated calls to an internal
+	/// function are followed. At the back edge, the loop is followed once more from its head
+	/// with only the knowledge common to both iterations, which determines the costs of an
+	/// iteration and reaches the code after the loop. Calls to other contracts only count their
+	/// own costs.
+	ParametricGasConsumption estimateParametric(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
+
 	static GasMeter::GasConsumption estimateMax(
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
 		size_t _startIndex,
-		std::shared_ptr<KnownState> const& _state
+		std::shared_ptr<KnownState> const& _state,
+		size_t _maxSteps = std::numeric_limits<size_t>::max()
+	)
+	{
+		return PathGasMeter(_items, _evmVersion, _maxSteps).estimateMax(_startIndex, _state);
+	}
+
+	static ParametricGasConsumption estimateParametric(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _startIndex,
+		std::shared_ptr<KnownState> const& _state,
+		size_t _maxSteps = std::numeric_limits<size_t>::max()
 	)
 	{
-		return PathGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
+		return PathGasMeter(_items, _evmVersion, _maxSteps).estimateParametric(_startIndex, _state);
 	}
 
 private:
@@ -73,6 +137,16 @@ private:
 	/// point in time, but it greatly reduces computational overhead.
 	void queue(std::unique_ptr<GasPath>&& _newPath);
 	GasMeter::GasConsumption handleQueueItem();
+	/// Records the visit of the jumpdest at @a _index by @a _path in the parametric estimation.
+	/// @returns the gas consumption the path ends with if it does not continue from there,
+	/// because it is the back edge of a loop, and nullopt otherwise.
+	std::optional<GasMeter::GasConsumption> visitJumpdest(
+		GasPath& _path,
+		size_t _index,
+		KnownState& _state,
+		GasMeter::GasConsumption const& _gas,
+		u256 const& _largestMemoryAccess
+	);
 
 	/// Map of jumpdest -> gas path, so not really a queue. We only have one queued up
 	/// item per jumpdest, because of the behaviour of `queue` above.
@@ -81,6 +155,11 @@ private:
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	size_t const m_maxSteps = std::numeric_limits<size_t>::max();
+	/// Number of assembly items evaluated so far.
+	size_t m_steps = 0;
+	/// If set, loops and external calls are summarized in it instead of making the estimation infinite.
+	std::optional<ParametricGasConsumption> m_parametric;
 };
 
 }
@@ -25,6 +25,11 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <libsolutil/Profiler.h>
+
+#include <array>
+#include <utility>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
@@ -41,6 +46,21 @@ struct OptimiserState
 	langutil::EVMVersion evmVersion = langutil::EVMVersion();
 };
 
+/// The kind of an assembly item as far as the first item of an optimisation window is concerned.
+/// Each method declares the kinds its window can start with using a static ``canStartWith`` function,
+/// which is used to only try those methods at each position that can possibly match.
+struct ItemKind
+{
+	AssemblyItemType type;
+	/// Only meaningful if ``type`` is ``Operation``.
+	Instruction instruction;
+
+	bool operator==(Instruction _instruction) const { return type == Operation && instruction == _instruction; }
+	bool operator!=(Instruction _instruction) const { return !(*this == _instruction); }
+	bool isDup() const { return type == Operation && isDupInstruction(instruction); }
+	bool isSwap() const { return type == Operation && isSwapInstruction(instruction); }
+};
+
 template<typename FunctionType>
 struct FunctionParameterCount;
 template<typename R, typename... Args>
@@ -75,6 +95,7 @@ struct SimplePeepholeOptimizerMethod
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind) { return true; }
 };
 
 struct Identity: SimplePeepholeOptimizerMethod<Identity>
@@ -104,6 +125,13 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress
 		);
 	}
+	static bool canStartWith(ItemKind _kind)
+	{
+		auto t = _kind.type;
+		return _kind.isDup() ||
+			t == Push || t == PushTag || t == PushSub ||
+			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
+	}
 };
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
@@ -126,6 +154,7 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 		}
 		return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == Operation; }
 };
 
 struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
@@ -155,6 +184,7 @@ struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 		}
 		return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == Operation || _kind.type == Push; }
 };
 
 struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
@@ -184,6 +214,7 @@ struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 			}
 		return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == Operation || _kind.type == Push; }
 };
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
@@ -196,6 +227,7 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 	{
 		return _s1 == _s2 && SemanticInformation::isSwapInstruction(_s1);
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.isSwap(); }
 };
 
 struct DoublePush
@@ -225,6 +257,7 @@ struct DoublePush
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == Push; }
 };
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
@@ -247,6 +280,7 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind == Instruction::SWAP1; }
 };
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
@@ -276,6 +310,7 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind == Instruction::SWAP1; }
 };
 
 /// Remove swapN after dupN
@@ -299,6 +334,7 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.isDup(); }
 };
 
 
@@ -326,6 +362,7 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind == Instruction::ISZERO; }
 };
 
 struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
@@ -353,6 +390,7 @@ struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind == Instruction::EQ; }
 };
 
 // push_tag_1 jumpi push_tag_2 jump tag_1: -> iszero push_tag_2 jumpi tag_1:
@@ -385,6 +423,7 @@ struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == PushTag; }
 };
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
@@ -411,6 +450,7 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == PushTag; }
 };
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
@@ -446,6 +486,7 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == PushTag || _kind.type == Push; }
 };
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
@@ -463,6 +504,7 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 			_and == Instruction::AND
 		);
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type == Push; }
 };
 
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
@@ -496,6 +538,16 @@ struct UnreachableCode
 		else
 			return false;
 	}
+	static bool canStartWith(ItemKind _kind)
+	{
+		return
+			_kind == Instruction::JUMP ||
+			_kind == Instruction::RETURN ||
+			_kind == Instruction::STOP ||
+			_kind == Instruction::INVALID ||
+			_kind == Instruction::SELFDESTRUCT ||
+			_kind == Instruction::REVERT;
+	}
 };
 
 struct DeduplicateNextTagSize3 : SimplePeepholeOptimizerMethod<DeduplicateNextTagSize3>
@@ -531,6 +583,7 @@ struct DeduplicateNextTagSize3 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 
 		return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type != Tag; }
 };
 
 struct DeduplicateNextTagSize2 : SimplePeepholeOptimizerMethod<DeduplicateNextTagSize2>
@@ -562,6 +615,7 @@ struct DeduplicateNextTagSize2 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 
 		return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type != Tag; }
 };
 
 struct DeduplicateNextTagSize1 : SimplePeepholeOptimizerMethod<DeduplicateNextTagSize1>
@@ -589,19 +643,56 @@ struct DeduplicateNextTagSize1 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 
 		return false;
 	}
+	static bool canStartWith(ItemKind _kind) { return _kind.type != Tag; }
 };
 
-void applyMethods(OptimiserState&)
+/// Applies the first of @a Methods that matches at the current position, trying only the methods that can
+/// start with the kind of the current item. The candidates for each kind are computed once from the
+/// ``canStartWith`` declarations of the methods, so that all methods are checked in a single scan.
+template <typename... Methods>
+class MethodDispatcher
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
-}
+public:
+	static_assert(sizeof...(Methods) <= 32, "Too many peephole optimisation methods.");
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
-{
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
-}
+	MethodDispatcher()
+	{
+		for (size_t index = 0; index < m_candidates.size(); ++index)
+		{
+			ItemKind kind = index < 256 ?
+				ItemKind{Operation, static_cast<Instruction>(index)} :
+				ItemKind{static_cast<AssemblyItemType>(index - 256), Instruction::STOP};
+			m_candidates[index] = candidates(kind, std::index_sequence_for<Methods...>{});
+		}
+	}
+
+	/// @returns true if any of the methods matched and advanced @a _state.
+	bool apply(OptimiserState& _state) const
+	{
+		return apply(_state, m_candidates.at(kindIndex(_state.items[_state.i])), std::index_sequence_for<Methods...>{});
+	}
+
+private:
+	static size_t kindIndex(AssemblyItem const& _item)
+	{
+		if (_item.type() == Operation)
+			return static_cast<size_t>(_item.instruction());
+		return 256 + static_cast<size_t>(_item.type());
+	}
+	template <size_t... Indices>
+	static uint32_t candidates(ItemKind _kind, std::index_sequence<Indices...>)
+	{
+		return ((Methods::canStartWith(_kind) ? (uint32_t(1) << Indices) : uint32_t(0)) | ...);
+	}
+	template <size_t... Indices>
+	static bool apply(OptimiserState& _state, uint32_t _candidates, std::index_sequence<Indices...>)
+	{
+		return (((_candidates & (uint32_t(1) << Indices)) && Methods::apply(_state)) || ...);
+	}
+
+	/// Bit mask of candidate methods for each operation (by opcode) followed by each other item type.
+	std::array<uint32_t, 256 + VerbatimBytecode + 1> m_candidates{};
+};
 
 size_t numberOfPops(AssemblyItems const& _items)
 {
@@ -614,14 +705,25 @@ bool PeepholeOptimiser::optimise()
 {
 	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
 	auto const approx = evmasm::Precision::Approximate;
+	static MethodDispatcher<
+		PushPop, OpPop, OpStop, OpReturnRevert, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+		DupSwap, IsZeroIsZeroJumpI, EqIsZeroJumpI, DoubleJump, JumpToNext, UnreachableCode, DeduplicateNextTagSize3,
+		DeduplicateNextTagSize2, DeduplicateNextTagSize1, TagConjunctions, TruthyAnd
+	> const dispatcher;
+
+	// Reuse the buffer of the previous run.
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
 	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems), m_evmVersion};
+	uint64_t rewrites = 0;
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(), DeduplicateNextTagSize3(),
-			DeduplicateNextTagSize2(), DeduplicateNextTagSize1(), TagConjunctions(), TruthyAnd(), Identity()
-		);
+		if (dispatcher.apply(state))
+			++rewrites;
+		else
+			Identity::apply(state);
+	// If no method matched, the output is an exact copy of the input.
+	if (rewrites == 0)
+		return false;
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3, m_evmVersion, approx) < evmasm::bytesRequired(m_items, 3, m_evmVersion, approx) ||
@@ -629,7 +731,8 @@ bool PeepholeOptimiser::optimise()
 		)
 	))
 	{
-		m_items = std::move(m_optimisedItems);
+		m_items.swap(m_optimisedItems);
+		util::Profiler::count("Peephole rewrites", rewrites);
 		return true;
 	}
 	else
@@ -27,6 +27,7 @@
 #include <libevmasm/SimplificationRule.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/FixedU256.h>
 
 #include <boost/multiprecision/detail/min_max.hpp>
 
@@ -40,21 +41,20 @@
 namespace solidity::evmasm
 {
 
-template <class S> S divWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) / bigint(_b));
-}
+// The operations below are evaluated on util::FixedU256, which does not allocate, instead of
+// going through bigint. They also avoid a bug in left shifts that was fixed in Boost 1.64.
+// https://www.boost.org/doc/libs/release/libs/multiprecision/doc/html/boost_multiprecision/map/hist.html#boost_multiprecision.map.hist.multiprecision_2_3_1_boost_1_64
 
-template <class S> S modWorkaround(S const& _a, S const& _b)
+inline u256 shiftLeft256(u256 const& _x, unsigned _amount)
 {
-	return (S)(bigint(_a) % bigint(_b));
+	return (util::FixedU256(_x) << _amount).toU256();
 }
 
-// This works around a bug fixed with Boost 1.64.
-// https://www.boost.org/doc/libs/release/libs/multiprecision/doc/html/boost_multiprecision/map/hist.html#boost_multiprecision.map.hist.multiprecision_2_3_1_boost_1_64
-template <class S> S shlWorkaround(S const& _x, unsigned _amount)
+/// Evaluates @a _operation on the FixedU256 values of all @a _arguments.
+template <class Operation, class... Arguments>
+u256 evaluateFixed(Operation _operation, Arguments const&... _arguments)
 {
-	return u256((bigint(_x) << _amount) & u256(-1));
+	return _operation(util::FixedU256(_arguments)...).toU256();
 }
 
 /// @returns k if _x == 2**k, nullopt otherwise
@@ -85,11 +85,11 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }},
 		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }},
 		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }},
-		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
-		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : evaluateFixed(std::divides<>{}, A.d(), B.d()); }},
+		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : evaluateFixed(&util::FixedU256::signedDiv, A.d(), B.d()); }},
+		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : evaluateFixed(std::modulus<>{}, A.d(), B.d()); }},
+		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : evaluateFixed(&util::FixedU256::signedMod, A.d(), B.d()); }},
+		{Builtins::EXP(A, B), [=]{ return evaluateFixed(&util::FixedU256::exp, A.d(), B.d()); }},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
@@ -106,8 +106,8 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 				0 :
 				(B.d() >> unsigned(8 * (Pattern::WordSize / 8 - 1 - A.d()))) & 0xff;
 		}},
-		{Builtins::ADDMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) + bigint(B.d())) % C.d()); }},
-		{Builtins::MULMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) * bigint(B.d())) % C.d()); }},
+		{Builtins::ADDMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : evaluateFixed(&util::FixedU256::addMod, A.d(), B.d(), C.d()); }},
+		{Builtins::MULMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : evaluateFixed(&util::FixedU256::mulMod, A.d(), B.d(), C.d()); }},
 		{Builtins::SIGNEXTEND(A, B), [=]() -> Word {
 			if (A.d() >= Pattern::WordSize / 8 - 1)
 				return B.d();
@@ -118,7 +118,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 		{Builtins::SHL(A, B), [=]{
 			if (A.d() >= Pattern::WordSize)
 				return Word(0);
-			return shlWorkaround(B.d(), unsigned(A.d()));
+			return shiftLeft256(B.d(), unsigned(A.d()));
 		}},
 		{Builtins::SHR(A, B), [=]{
 			if (A.d() >= Pattern::WordSize)
@@ -515,7 +515,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		// SHR(B, SHL(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHR(B, Builtins::SHL(A, X)),
 		[=]() -> Pattern {
-			Word mask = shlWorkaround(~Word(0), unsigned(A.d())) >> unsigned(B.d());
+			Word mask = shiftLeft256(~Word(0), unsigned(A.d())) >> unsigned(B.d());
 
 			if (A.d() > B.d())
 				return Builtins::AND(Builtins::SHL(A.d() - B.d(), X), mask);
@@ -532,7 +532,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		// SHL(B, SHR(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHL(B, Builtins::SHR(A, X)),
 		[=]() -> Pattern {
-			Word mask = shlWorkaround((~Word(0)) >> unsigned(A.d()), unsigned(B.d()));
+			Word mask = shiftLeft256((~Word(0)) >> unsigned(A.d()), unsigned(B.d()));
 
 			if (A.d() > B.d())
 				return Builtins::AND(Builtins::SHR(A.d() - B.d(), X), mask);
@@ -551,7 +551,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		auto replacement = [=]() -> Pattern {
 			Word mask =
 				instr == Instruction::SHL ?
-				shlWorkaround(A.d(), unsigned(B.d())) :
+				shiftLeft256(A.d(), unsigned(B.d())) :
 				A.d() >> unsigned(B.d());
 			return Builtins::AND(shiftOp(B.d(), X), std::move(mask));
 		};
@@ -81,39 +81,48 @@ char CharStream::setPosition(size_t _location)
 std::string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = std::string::size_type;
-	size_type searchStart = std::min<size_type>(m_source.size(), size_type(_position));
+	size_t searchStart = std::min(m_source.size(), static_cast<size_t>(_position));
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == std::string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	std::string line = m_source.substr(
-		lineStart,
-		std::min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
-	if (!line.empty() && line.back() == '\r')
-		line.pop_back();
-	return line;
+	// The line after searchStart if it is a line break, otherwise the line containing it.
+	size_t line = lineIndex(searchStart + 1);
+	std::vector<size_t> const& starts = lineStarts();
+	size_t lineStart = starts[line];
+	size_t lineEnd = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	if (lineEnd > lineStart && m_source[lineEnd - 1] == '\r')
+		lineEnd--;
+	return m_source.substr(lineStart, lineEnd - lineStart);
 }
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = std::string::size_type;
-	using diff_type = std::string::difference_type;
-	size_type searchPosition = std::min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	size_t searchPosition = std::min(m_source.size(), static_cast<size_t>(_position));
+	size_t line = lineIndex(searchPosition);
+	return LineColumn{static_cast<int>(line), static_cast<int>(searchPosition - lineStarts()[line])};
+}
+
+std::vector<size_t> const& CharStream::lineStarts() const
+{
+	if (auto lineStarts = std::atomic_load(&m_lineStarts))
+		return *lineStarts;
+
+	auto lineStarts = std::make_shared<std::vector<size_t>>();
+	lineStarts->emplace_back(0);
+	for (size_t position = m_source.find('\n'); position != std::string::npos; position = m_source.find('\n', position + 1))
+		lineStarts->emplace_back(position + 1);
+
+	// Another thread may have built the index in the meantime, in which case its index is kept,
+	// since references to it may have been returned already.
+	std::shared_ptr<std::vector<size_t> const> expected;
+	if (std::atomic_compare_exchange_strong(&m_lineStarts, &expected, std::shared_ptr<std::vector<size_t> const>(std::move(lineStarts))))
+		return *std::atomic_load(&m_lineStarts);
+	return *expected;
+}
+
+size_t CharStream::lineIndex(size_t _position) const
+{
+	std::vector<size_t> const& starts = lineStarts();
+	return static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), _position) - starts.begin()) - 1;
 }
 
 std::string_view CharStream::text(SourceLocation const& _location) const
@@ -146,7 +155,15 @@ std::string CharStream::singleLineSnippet(std::string const& _sourceCode, Source
 
 std::optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	std::vector<size_t> const& starts = lineStarts();
+	if (_lineColumn.line < 0 || static_cast<size_t>(_lineColumn.line) >= starts.size())
+		return std::nullopt;
+
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	size_t const endOfLine = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	if (starts[line] + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return std::nullopt;
+	return static_cast<int>(starts[line] + static_cast<size_t>(_lineColumn.column));
 }
 
 std::optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
@@ -50,11 +50,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -100,10 +104,17 @@ public:
 
 	size_t size() const { return m_source.size(); }
 
+	/// @returns the part of the source from the current position up to the end of input.
+	/// Allows scanning runs of characters in one step instead of advancing character by character.
+	std::string_view remainingSource() const noexcept
+	{
+		return std::string_view(m_source).substr(std::min(m_position, m_source.size()));
+	}
+
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds an index of the line starts, which makes later calls cheap.
 	std::string lineAtPosition(int _position) const;
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
@@ -142,10 +153,18 @@ public:
 	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
 
 private:
+	/// @returns the positions at which the lines of the source start, in ascending order.
+	/// The index is built on first use and may be requested from several threads at once.
+	std::vector<size_t> const& lineStarts() const;
+	/// @returns the index of the line containing @a _position.
+	size_t lineIndex(size_t _position) const;
+
 	std::string m_source;
 	std::string m_name;
 	bool m_importedFromAST{false};
 	size_t m_position{0};
+	/// The source does not change, so copies of the stream can share the same index.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
@@ -245,11 +245,44 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 		return _else;
 }
 
+namespace
+{
+
+/// @returns the length of the longest prefix of @a _text of which all characters satisfy @a _predicate.
+/// Used to skip or copy runs of uninteresting characters in one step instead of calling
+/// Scanner::advance() for each of them.
+template <typename Predicate>
+size_t prefixLength(std::string_view _text, Predicate const& _predicate)
+{
+	size_t length = 0;
+	while (length < _text.size() && _predicate(_text[length]))
+		++length;
+	return length;
+}
+
+/// @returns false for the characters that are line terminators or can start a multi-byte
+/// unicode line terminator (see Scanner::isUnicodeLinebreak()).
+bool isPlainLineCharacter(char _c)
+{
+	auto const c = static_cast<uint8_t>(_c);
+	if (c <= 0x0d)
+		return c < 0x0a;
+	return c != 0xc2 && c != 0xe2;
+}
+
+}
+
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
+	// Checking m_char first is required since it is set to a blank after a
+	// multi-line comment without moving past the closing slash.
 	while (isWhiteSpace(m_char))
+	{
 		advance();
+		if (size_t const length = prefixLength(m_source.remainingSource(), isWhiteSpace))
+			m_char = m_source.advanceAndGet(length);
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -282,25 +315,32 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 		std::pair<std::string_view, int>{"\xE2\x80\xAC", -1} // U+202C (PDF - Pop Directional Formatting
 	};
 
-	size_t endPosition = _stream.position();
-	_stream.setPosition(_startPosition);
+	// All sequences start with the same byte, which is rare in source code, so we only
+	// compare the sequences at its occurrences.
+	std::string_view const source = _stream.source();
+	std::string_view const scannedSource = source.substr(0, _stream.position());
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	for (
+		size_t currentPos = scannedSource.find('\xE2', _startPosition);
+		currentPos != std::string_view::npos;
+		currentPos = scannedSource.find('\xE2', currentPos + 1)
+	)
 	{
-		_stream.setPosition(currentPos);
-
+		// Same as CharStream::prefixMatch(), which does not match sequences ending at the end of input.
 		for (auto const& [sequence, depthChange]: directionalSequences)
-			if (_stream.prefixMatch(sequence))
+			if (currentPos + sequence.size() < source.size() && source.substr(currentPos, sequence.size()) == sequence)
 				directionOverrideDepth += depthChange;
 
 		if (directionOverrideDepth < 0)
+		{
+			// Scanning resumes at the offending character.
+			_stream.setPosition(currentPos);
 			return ScannerError::DirectionalOverrideUnderflow;
+		}
 	}
 
-	_stream.setPosition(endPosition);
-
 	return directionOverrideDepth > 0 ? ScannerError::DirectionalOverrideMismatch : ScannerError::NoError;
 }
 
@@ -311,9 +351,13 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
+	while (true)
+	{
+		if (size_t const length = prefixLength(m_source.remainingSource(), isPlainLineCharacter))
+			m_char = m_source.advanceAndGet(length);
+		if (isUnicodeLinebreak() || !advance())
 			break;
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -381,8 +425,18 @@ size_t Scanner::scanSingleLineDocComment()
 			// Any line terminator that is not '\n' is considered to end the
 			// comment.
 			break;
-		addCommentLiteralChar(m_char);
-		advance();
+		std::string_view const text = m_source.remainingSource();
+		if (size_t const length = prefixLength(text, isPlainLineCharacter))
+		{
+			addCommentLiteral(text.substr(0, length));
+			endPosition = m_source.position() + length - 1;
+			m_char = m_source.advanceAndGet(length);
+		}
+		else
+		{
+			addCommentLiteralChar(m_char);
+			advance();
+		}
 	}
 	literal.complete();
 	return endPosition;
@@ -391,26 +445,24 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source.position();
-	while (!isSourcePastEndOfInput())
+	size_t const terminatorOffset = m_source.remainingSource().find("*/");
+	if (terminatorOffset == std::string_view::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		// Unterminated multi-line comment.
+		m_char = m_source.setPosition(m_source.size());
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// We have reached the end of the multi-line comment, we consume
+	// the '/' and insert a whitespace. This way all multi-line comments
+	// are treated as whitespace.
+	m_char = m_source.setPosition(startPosition + terminatorOffset + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -457,9 +509,18 @@ Token Scanner::scanMultiLineDocComment()
 			endFound = true;
 			break;
 		}
-		addCommentLiteralChar(m_char);
+		std::string_view const text = m_source.remainingSource();
+		if (size_t const length = prefixLength(text, [](char _c) { return _c != '\n' && _c != '\r' && _c != '*'; }))
+		{
+			addCommentLiteral(text.substr(0, length));
+			m_char = m_source.advanceAndGet(length);
+		}
+		else
+		{
+			addCommentLiteralChar(m_char);
+			advance();
+		}
 		charsAdded = true;
-		advance();
 	}
 	literal.complete();
 	if (!endFound)
@@ -829,6 +890,21 @@ Token Scanner::scanString(bool const _isUnicode)
 	// for source location comments we allow multiline string literals
 	while (m_char != quote && !isSourcePastEndOfInput() && (!isUnicodeLinebreak() || m_kind == ScannerKind::SpecialComment))
 	{
+		if (m_kind != ScannerKind::SpecialComment)
+		{
+			// Copy runs of printable ASCII characters that need no further checks.
+			std::string_view const text = m_source.remainingSource();
+			size_t const length = prefixLength(text, [&](char _c) {
+				return 0x20 <= _c && _c < 0x7f && _c != quote && _c != '\\';
+			});
+			if (length > 0)
+			{
+				addLiteral(text.substr(0, length));
+				m_char = m_source.advanceAndGet(length);
+				continue;
+			}
+		}
+
 		char c = m_char;
 		advance();
 
@@ -1033,8 +1109,15 @@ std::tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	std::string_view const text = m_source.remainingSource();
+	size_t const length = prefixLength(text, [&](char _c) {
+		return isIdentifierPart(_c) || (_c == '.' && m_kind == ScannerKind::Yul);
+	});
+	if (length > 0)
+	{
+		addLiteral(text.substr(0, length));
+		m_char = m_source.advanceAndGet(length);
+	}
 	literal.complete();
 
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
@@ -58,6 +58,7 @@
 
 #include <optional>
 #include <iosfwd>
+#include <string_view>
 
 namespace solidity::langutil
 {
@@ -198,6 +199,8 @@ private:
 	///@name Literal buffer support
 	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_skippedComments[NextNext].literal.push_back(c); }
+	inline void addLiteral(std::string_view _text) { m_tokens[NextNext].literal.append(_text); }
+	inline void addCommentLiteral(std::string_view _text) { m_skippedComments[NextNext].literal.append(_text); }
 	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
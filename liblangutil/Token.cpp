@@ -44,7 +44,8 @@
 #include <liblangutil/Token.h>
 #include <libsolutil/StringUtils.h>
 
-#include <map>
+#include <cstdint>
+#include <string_view>
 
 namespace solidity::langutil
 {
@@ -134,17 +135,73 @@ std::string friendlyName(Token tok)
 }
 
 
-static Token keywordByName(std::string const& _name)
+namespace
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
-#define KEYWORD(name, string, precedence) {string, Token::name},
+
+/// Hash table of all keywords, built at compile time. Uses open addressing with linear probing
+/// and is sparse enough that most lookups are a single hash computation and string comparison.
+class KeywordTable
+{
+public:
+	constexpr KeywordTable()
+	{
+		// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+		// and keywords to be inserted into the table.
+#define KEYWORD(name, string, precedence) insert(string, Token::name);
 #define TOKEN(name, string, precedence)
-	static std::map<std::string, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+		TOKEN_LIST(TOKEN, KEYWORD)
 #undef KEYWORD
 #undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+	}
+
+	/// @returns the keyword token named @a _name or Token::Identifier if there is none.
+	constexpr Token find(std::string_view _name) const
+	{
+		for (size_t index = hash(_name) % c_size; !m_slots[index].name.empty(); index = (index + 1) % c_size)
+			if (m_slots[index].name == _name)
+				return m_slots[index].token;
+		return Token::Identifier;
+	}
+
+private:
+	/// More than twice the number of keywords, which keeps probe sequences short.
+	static size_t constexpr c_size = 256;
+
+	struct Slot
+	{
+		std::string_view name;
+		Token token = Token::Identifier;
+	};
+
+	/// FNV-1a
+	static constexpr uint32_t hash(std::string_view _name)
+	{
+		uint32_t result = 2166136261u;
+		for (char c: _name)
+			result = (result ^ static_cast<uint8_t>(c)) * 16777619u;
+		return result;
+	}
+
+	constexpr void insert(std::string_view _name, Token _token)
+	{
+		size_t index = hash(_name) % c_size;
+		while (!m_slots[index].name.empty())
+			index = (index + 1) % c_size;
+		m_slots[index] = Slot{_name, _token};
+	}
+
+	Slot m_slots[c_size] = {};
+};
+
+KeywordTable constexpr keywordTable;
+static_assert(keywordTable.find("contract") == Token::Contract);
+static_assert(keywordTable.find("contracts") == Token::Identifier);
+
+Token keywordByName(std::string_view _name)
+{
+	return keywordTable.find(_name);
+}
+
 }
 
 bool isYulKeyword(std::string const& _literal)
@@ -183,7 +240,7 @@ std::tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(std::strin
 	auto positionM = find_if(_literal.begin(), _literal.end(), util::isDigit);
 	if (positionM != _literal.end())
 	{
-		std::string baseType(_literal.begin(), positionM);
+		std::string_view baseType(_literal.data(), static_cast<size_t>(positionM - _literal.begin()));
 		auto positionX = find_if_not(positionM, _literal.end(), util::isDigit);
 		int m = parseSize(positionM, positionX);
 		Token keyword = keywordByName(baseType);
@@ -44,6 +44,10 @@ public:
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
+	/// Asks a running call to @a check() to give up and return as soon as possible.
+	/// Can be called from another thread. Solvers that cannot be interrupted just finish their query.
+	virtual void interrupt() {}
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
@@ -22,6 +22,7 @@
 
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
 #include <libsolutil/Visitor.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -33,6 +34,7 @@
 
 #include <array>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -92,21 +94,44 @@ void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*
 
 CHCSolverInterface::QueryResult CHCSmtLib2Interface::query(Expression const& _block)
 {
-	std::string query = dumpQuery(_block);
-	std::string response = querySolver(query);
+	return resultFromSolverResponse(querySolver(dumpQuery(_block)));
+}
 
+std::vector<CHCSolverInterface::QueryResult> CHCSmtLib2Interface::queryAll(
+	std::vector<std::string> const& _queries,
+	size_t _numThreads
+)
+{
+	smtAssert(_numThreads > 0);
+	std::vector<std::string> responses(_queries.size());
+	{
+		ThreadPool threadPool(std::min(_numThreads, _queries.size()));
+		std::vector<std::future<void>> tasks;
+		for (size_t i = 0; i < _queries.size(); ++i)
+			tasks.emplace_back(threadPool.submit([&, i]() {
+				CancellationToken::check();
+				responses[i] = querySolver(_queries[i]);
+			}));
+		for (auto& task: tasks)
+			task.get();
+	}
+	return applyMap(responses, [this](std::string const& _response) { return resultFromSolverResponse(_response); });
+}
+
+CHCSolverInterface::QueryResult CHCSmtLib2Interface::resultFromSolverResponse(std::string const& _response) const
+{
 	CheckResult result;
 	// NOTE: Our internal semantics is UNSAT -> SAFE and SAT -> UNSAFE, which corresponds to usual SMT-based model checking
 	// However, with CHC solvers, the meaning is flipped, UNSAT -> UNSAFE and SAT -> SAFE.
 	// So we have to flip the answer.
-	if (boost::starts_with(response, "sat"))
+	if (boost::starts_with(_response, "sat"))
 	{
-		auto maybeInvariants = invariantsFromSolverResponse(response);
+		auto maybeInvariants = invariantsFromSolverResponse(_response);
 		return {CheckResult::UNSATISFIABLE, maybeInvariants.value_or(Expression(true)), {}};
 	}
-	else if (boost::starts_with(response, "unsat"))
+	else if (boost::starts_with(_response, "unsat"))
 		result = CheckResult::SATISFIABLE;
-	else if (boost::starts_with(response, "unknown"))
+	else if (boost::starts_with(_response, "unknown"))
 		result = CheckResult::UNKNOWN;
 	else
 		result = CheckResult::ERROR;
@@ -176,6 +201,7 @@ std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
 			return result.responseOrErrorMessage;
 	}
 
+	std::lock_guard lock(m_unhandledQueriesMutex);
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
@@ -27,6 +27,8 @@
 #include <libsmtutil/SMTLib2Interface.h>
 #include <libsmtutil/SMTLib2Parser.h>
 
+#include <mutex>
+
 namespace solidity::smtutil
 {
 
@@ -49,6 +51,11 @@ public:
 	/// @returns solving result, an invariant, and counterexample graph, if possible.
 	QueryResult query(Expression const& _expr) override;
 
+	/// Sends queries created by @a dumpQuery() to the solver, with at most @a _numThreads
+	/// of them running at the same time.
+	/// @returns the results in the order of the queries.
+	std::vector<QueryResult> queryAll(std::vector<std::string> const& _queries, size_t _numThreads);
+
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	std::string dumpQuery(Expression const& _expr);
@@ -92,8 +99,12 @@ protected:
 	void createHeader();
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
+	/// Can be called from several threads at the same time.
 	virtual std::string querySolver(std::string const& _input);
 
+	/// Translates the response of the solver to a query into our representation.
+	QueryResult resultFromSolverResponse(std::string const& _response) const;
+
 	/// Translates CHC solver response with a model to our representation of invariants. Returns None on error.
 	std::optional<smtutil::Expression> invariantsFromSolverResponse(std::string const& _response) const;
 
@@ -104,6 +115,8 @@ protected:
 
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
+	/// Protects m_unhandledQueries when queries are sent from several threads.
+	std::mutex m_unhandledQueriesMutex;
 
 	frontend::ReadCallback::Callback m_smtCallback;
 };
@@ -88,6 +88,10 @@ public:
 
 	void setTupleDeclarationCallback(TupleDeclarationCallback _callback);
 private:
+	/// Appends the s-expression of @a _expr to @a _out, which avoids copying the strings
+	/// of all subexpressions on every level of the expression.
+	void appendSExpr(Expression const& _expr, std::string& _out);
+
 	SortId resolveBitVectorSort(BitVectorSort const& _sort);
 	SortId resolveArraySort(ArraySort const& _sort);
 	SortId resolveTupleSort(TupleSort const& _sort);
@@ -23,6 +23,8 @@
 #include <libsolutil/Visitor.h>
 #include <libsolutil/StringUtils.h>
 
+#include <algorithm>
+#include <iterator>
 
 using namespace solidity::langutil;
 using namespace solidity::smtutil;
@@ -45,16 +47,24 @@ SMTLib2Expression SMTLib2Parser::parseExpression() {
 	{
 		advance();
 		skipWhitespace();
-		std::vector<SMTLib2Expression> subExpressions;
+		// The subexpressions are collected on a stack shared by all levels and only moved
+		// into a vector of the right size at the end, which avoids reallocating it while it grows.
+		size_t const start = m_subExpressions.size();
 		while (token() != 0 && token() != ')')
 		{
-			subExpressions.emplace_back(parseExpression());
+			SMTLib2Expression subExpression = parseExpression();
+			m_subExpressions.emplace_back(std::move(subExpression));
 			skipWhitespace();
 		}
 		if (token() != ')')
 			throw ParsingException{};
 		// Simulate whitespace because we do not want to read the next token since it might block.
 		m_token = ' ';
+		std::vector<SMTLib2Expression> subExpressions(
+			std::make_move_iterator(m_subExpressions.begin() + static_cast<std::ptrdiff_t>(start)),
+			std::make_move_iterator(m_subExpressions.end())
+		);
+		m_subExpressions.resize(start);
 		return {std::move(subExpressions)};
 	} else
 		return {parseToken()};
@@ -85,10 +95,32 @@ std::string SMTLib2Parser::parseToken() {
 void SMTLib2Parser::advance() {
 	if (!m_input.good())
 		throw ParsingException{};
-	m_token = static_cast<char>(m_input.get());
+	m_token = nextCharacter();
 	if (token() == ';')
-		while (token() != '\n' && token() != 0)
-			m_token = static_cast<char>(m_input.get());
+		while (token() != '\n' && token() != 0 && !m_input.eof())
+			m_token = nextCharacter();
+}
+
+char SMTLib2Parser::refillBuffer()
+{
+	static std::streamsize constexpr maxBufferSize = 1 << 16;
+
+	std::streambuf& buffer = *m_input.rdbuf();
+	// The input might be a pipe, so only take what can be read without blocking.
+	std::streamsize available = std::min(buffer.in_avail(), maxBufferSize);
+	if (available > 0)
+	{
+		m_buffer.resize(static_cast<size_t>(available));
+		m_buffer.resize(static_cast<size_t>(buffer.sgetn(m_buffer.data(), available)));
+		m_bufferPosition = 0;
+		if (!m_buffer.empty())
+			return m_buffer[m_bufferPosition++];
+	}
+
+	auto character = buffer.sbumpc();
+	if (std::char_traits<char>::eq_int_type(character, std::char_traits<char>::eof()))
+		m_input.setstate(std::ios::eofbit | std::ios::failbit);
+	return static_cast<char>(character);
 }
 
 void SMTLib2Parser::skipWhitespace() {
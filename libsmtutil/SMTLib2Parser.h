@@ -68,7 +68,7 @@ public:
 
 	explicit SMTLib2Parser(std::istream& _input) :
 			m_input(_input),
-			m_token(static_cast<char>(m_input.get())) {}
+			m_token(nextCharacter()) {}
 
 	SMTLib2Expression parseExpression();
 
@@ -90,7 +90,26 @@ private:
 
 	void advance();
 
+	/// @returns the next character of the input. Sets the same state on the stream
+	/// as std::istream::get() at the end of the input.
+	char nextCharacter()
+	{
+		if (m_bufferPosition < m_buffer.size())
+			return m_buffer[m_bufferPosition++];
+		return refillBuffer();
+	}
+	/// Reads the characters that are available without blocking into the buffer,
+	/// or waits for a single one if there are none.
+	/// @returns the first of them.
+	char refillBuffer();
+
 	std::istream& m_input;
+	/// Characters read from the input ahead of the parser, since reading them from the
+	/// stream one by one dominates the parsing time of large solver responses.
+	std::string m_buffer;
+	size_t m_bufferPosition = 0;
+	/// The subexpressions of all lists that are currently being parsed.
+	std::vector<SMTLib2Expression> m_subExpressions;
 	char m_token = 0;
 };
 }
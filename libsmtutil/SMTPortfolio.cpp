@@ -20,6 +20,11 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
@@ -27,10 +32,14 @@ using namespace solidity::smtutil;
 
 SMTPortfolio::SMTPortfolio(
 	std::vector<std::unique_ptr<BMCSolverInterface>> _solvers,
-	std::optional<unsigned> _queryTimeout
+	std::optional<unsigned> _queryTimeout,
+	bool _raceSolvers
 ):
 	BMCSolverInterface(_queryTimeout), m_solvers(std::move(_solvers))
-{}
+{
+	if (_raceSolvers && m_solvers.size() > 1)
+		m_threadPool = std::make_unique<ThreadPool>(m_solvers.size());
+}
 
 
 void SMTPortfolio::reset()
@@ -93,9 +102,15 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If the solvers are raced, 1) and 2) are replaced by taking the answer of the first solver
+ * that answers the query. 3) still applies if none of them does.
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	if (m_threadPool)
+		return race(_expressionsToEvaluate);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	std::vector<std::string> finalValues;
 	for (auto const& s: m_solvers)
@@ -122,6 +137,65 @@ std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector
 	return std::make_pair(lastResult, finalValues);
 }
 
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::race(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	std::mutex mutex;
+	std::condition_variable condition;
+	size_t finished = 0;
+	std::optional<size_t> winner;
+
+	auto reportFinished = [&](size_t _index, CheckResult const* _result) {
+		std::lock_guard lock(mutex);
+		++finished;
+		if (_result && solverAnswered(*_result) && !winner)
+			winner = _index;
+		condition.notify_all();
+	};
+
+	std::vector<std::future<std::pair<CheckResult, std::vector<std::string>>>> tasks;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		tasks.emplace_back(m_threadPool->submit([&, i]() {
+			std::pair<CheckResult, std::vector<std::string>> result;
+			try
+			{
+				result = m_solvers[i]->check(_expressionsToEvaluate);
+			}
+			catch (...)
+			{
+				reportFinished(i, nullptr);
+				throw;
+			}
+			reportFinished(i, &result.first);
+			return result;
+		}));
+
+	{
+		std::unique_lock lock(mutex);
+		condition.wait(lock, [&]() { return winner.has_value() || finished == m_solvers.size(); });
+	}
+
+	// Interrupting a solver that has not started its query yet has no effect,
+	// so keep interrupting until every task is done.
+	for (size_t i = 0; i < tasks.size(); ++i)
+		while (tasks[i].wait_for(std::chrono::milliseconds(10)) != std::future_status::ready)
+			m_solvers[i]->interrupt();
+
+	if (winner)
+		return tasks[*winner].get();
+
+	CheckResult result = CheckResult::ERROR;
+	for (auto& task: tasks)
+		if (task.get().first == CheckResult::UNKNOWN)
+			result = CheckResult::UNKNOWN;
+	return std::make_pair(result, std::vector<std::string>{});
+}
+
+void SMTPortfolio::interrupt()
+{
+	for (auto const& s: m_solvers)
+		s->interrupt();
+}
+
 std::vector<std::string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -22,8 +22,10 @@
 #include <libsmtutil/BMCSolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
@@ -34,6 +36,10 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ *
+ * If racing is enabled, the solvers are instead queried in parallel and the first
+ * solver that answers decides the result, while the others are interrupted.
+ * This gives up the detection of conflicting answers in exchange for wall-clock time.
  */
 class SMTPortfolio: public BMCSolverInterface
 {
@@ -42,7 +48,11 @@ public:
 	SMTPortfolio(SMTPortfolio const&) = delete;
 	SMTPortfolio& operator=(SMTPortfolio const&) = delete;
 
-	SMTPortfolio(std::vector<std::unique_ptr<BMCSolverInterface>> solvers, std::optional<unsigned> _queryTimeout);
+	SMTPortfolio(
+		std::vector<std::unique_ptr<BMCSolverInterface>> solvers,
+		std::optional<unsigned> _queryTimeout,
+		bool _raceSolvers = false
+	);
 
 	void reset() override;
 
@@ -55,6 +65,8 @@ public:
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void interrupt() override;
+
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
 
@@ -63,7 +75,12 @@ public:
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Runs the query on all solvers in parallel and returns the first answer.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<BMCSolverInterface>> m_solvers;
+	/// Only present if the solvers are raced.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
 
 	std::vector<Expression> m_assertions;
 };
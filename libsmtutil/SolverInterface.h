@@ -114,6 +114,19 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+inline std::string toString(CheckResult _result)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE: return "sat";
+	case CheckResult::UNSATISFIABLE: return "unsat";
+	case CheckResult::UNKNOWN: return "unknown";
+	case CheckResult::CONFLICTING: return "conflicting";
+	case CheckResult::ERROR: return "error";
+	}
+	util::unreachable();
+}
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
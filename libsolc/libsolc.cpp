@@ -22,13 +22,16 @@
  */
 
 #include <libsolc/libsolc.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/YulName.h>
 
 #include <cstdlib>
 #include <list>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "license.h"
 
@@ -37,6 +40,15 @@ using namespace solidity::util;
 
 using solidity::frontend::ReadCallback;
 using solidity::frontend::StandardCompiler;
+using solidity::frontend::TypeProvider;
+
+struct SolidityInstance
+{
+	/// Holds the types of the compilations of this instance, independently of other instances.
+	TypeProvider typeProvider;
+	/// Serializes the compilations of this instance.
+	std::mutex mutex;
+};
 
 namespace
 {
@@ -44,6 +56,15 @@ namespace
 // The std::strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static std::list<std::string> solidityAllocations;
+/// Guards solidityAllocations, which is shared by all compiler instances.
+static std::mutex solidityAllocationsMutex;
+
+/// Adds @p _data to the list of allocations and returns a pointer to its contents.
+char* storeAllocation(std::string _data)
+{
+	std::lock_guard lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(std::move(_data)).data();
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -52,6 +73,7 @@ static std::list<std::string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 std::string takeOverAllocation(char const* _data)
 {
+	std::lock_guard lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -71,6 +93,31 @@ void truncateCString(std::string& _data)
 		_data.resize(pos);
 }
 
+/// Converts the contents and error returned by a C-style callback into a callback result,
+/// taking over their allocations.
+ReadCallback::Result takeOverCallbackResult(char* _contents, char* _error)
+{
+	ReadCallback::Result result;
+	result.success = true;
+	if (!_contents && !_error)
+	{
+		result.success = false;
+		result.responseOrErrorMessage = "Callback not supported.";
+	}
+	if (_contents)
+	{
+		result.success = true;
+		result.responseOrErrorMessage = takeOverAllocation(_contents);
+	}
+	if (_error)
+	{
+		result.success = false;
+		result.responseOrErrorMessage = takeOverAllocation(_error);
+	}
+	truncateCString(result.responseOrErrorMessage);
+	return result;
+}
+
 ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, void* _readContext)
 {
 	ReadCallback::Callback readCallback;
@@ -81,33 +128,47 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 			char* contents_c = nullptr;
 			char* error_c = nullptr;
 			_readCallback(_readContext, _kind.data(), _data.data(), &contents_c, &error_c);
-			ReadCallback::Result result;
-			result.success = true;
-			if (!contents_c && !error_c)
-			{
-				result.success = false;
-				result.responseOrErrorMessage = "Callback not supported.";
-			}
-			if (contents_c)
-			{
-				result.success = true;
-				result.responseOrErrorMessage = takeOverAllocation(contents_c);
-			}
-			if (error_c)
-			{
-				result.success = false;
-				result.responseOrErrorMessage = takeOverAllocation(error_c);
-			}
-			truncateCString(result.responseOrErrorMessage);
-			return result;
+			return takeOverCallbackResult(contents_c, error_c);
 		};
 	}
 	return readCallback;
 }
 
-std::string compile(std::string _input, CStyleReadFileCallback _readCallback, void* _readContext)
+ReadCallback::BatchCallback wrapBatchReadCallback(CStyleBatchReadFileCallback _batchReadCallback, void* _readContext)
+{
+	ReadCallback::BatchCallback batchReadCallback;
+	if (_batchReadCallback)
+	{
+		batchReadCallback = [=](std::string const& _kind, std::vector<std::string> const& _data)
+		{
+			std::vector<char const*> data_c;
+			for (std::string const& data: _data)
+				data_c.push_back(data.data());
+			std::vector<char*> contents_c(_data.size(), nullptr);
+			std::vector<char*> errors_c(_data.size(), nullptr);
+			_batchReadCallback(_readContext, _kind.data(), _data.size(), data_c.data(), contents_c.data(), errors_c.data());
+
+			std::vector<ReadCallback::Result> results;
+			for (size_t i = 0; i < _data.size(); ++i)
+				results.emplace_back(takeOverCallbackResult(contents_c[i], errors_c[i]));
+			return results;
+		};
+	}
+	return batchReadCallback;
+}
+
+std::string compile(
+	std::string _input,
+	CStyleReadFileCallback _readCallback,
+	CStyleBatchReadFileCallback _batchReadCallback,
+	void* _readContext,
+	bool _concurrent = false
+)
 {
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	compiler.setBatchReadCallback(wrapBatchReadCallback(_batchReadCallback, _readContext));
+	if (_concurrent)
+		compiler.keepYulStringRepository();
 	return compiler.compile(std::move(_input));
 }
 
@@ -128,14 +189,55 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return storeAllocation(compile(_input, _readCallback, nullptr, _readContext));
+}
+
+extern char* solidity_compile_with_batch_callback(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	CStyleBatchReadFileCallback _batchReadCallback,
+	void* _readContext
+) noexcept
+{
+	return storeAllocation(compile(_input, _readCallback, _batchReadCallback, _readContext));
+}
+
+extern SolidityInstance* solidity_create_instance() noexcept
+{
+	try
+	{
+		return new SolidityInstance();
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+extern void solidity_destroy_instance(SolidityInstance* _instance) noexcept
+{
+	delete _instance;
+}
+
+extern char* solidity_compile_with(
+	SolidityInstance* _instance,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	if (!_instance)
+		abort();
+	std::lock_guard lock(_instance->mutex);
+	TypeProvider::Activation typeProviderActivation(&_instance->typeProvider);
+	return storeAllocation(compile(_input, _readCallback, nullptr, _readContext, true));
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return storeAllocation(std::string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -154,6 +256,7 @@ extern void solidity_reset() noexcept
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
 	yul::YulStringRepository::reset();
+	std::lock_guard lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
 }
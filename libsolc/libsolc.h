@@ -52,6 +52,31 @@ extern "C" {
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
+/// Callback used to retrieve several source files or data items at once, e.g. concurrently.
+///
+/// @param _context The readContext passed to solidity_compile_with_batch_callback. Can be NULL.
+/// @param _kind The kind of callback (a string), the same for all items.
+/// @param _count The number of items requested.
+/// @param _data An array of @p _count strings with the data for each item.
+/// @param o_contents An array of @p _count pointers, each to be set to the contents of the
+///                   respective item, if found. Allocated via solidity_alloc().
+/// @param o_errors An array of @p _count pointers, each to be set to an error message for the
+///                 respective item, if there is one.
+///
+/// All pointers in @p o_contents and @p o_errors are NULL on entry. Items for which both are
+/// left NULL are requested again via the regular read callback.
+typedef void (*CStyleBatchReadFileCallback)(
+	void* _context,
+	char const* _kind,
+	size_t _count,
+	char const* const* _data,
+	char** o_contents,
+	char** o_errors
+);
+
+/// Compiler instance, see solidity_create_instance().
+typedef struct SolidityInstance SolidityInstance;
+
 /// Returns the complete license document.
 ///
 /// The pointer returned must NOT be freed by the caller.
@@ -90,6 +115,48 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Same as solidity_compile(), but the compiler first requests all imports of the sources
+/// known at a time with a single call of @p _batchReadCallback, so that they can be loaded
+/// concurrently. @p _readCallback is still used for the items not provided by it.
+///
+/// @param _batchReadCallback The optional batch callback pointer. Can be NULL.
+/// @param _readContext An optional context pointer passed to both callbacks. Can be NULL.
+char* solidity_compile_with_batch_callback(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	CStyleBatchReadFileCallback _batchReadCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Creates a compiler instance for use with solidity_compile_with().
+///
+/// Compilations of different instances are independent of each other and can run concurrently
+/// on different threads. Compilations of the same instance are serialized.
+///
+/// @returns A pointer to the instance, which must be freed using solidity_destroy_instance(),
+///          or NULL if it could not be allocated.
+SolidityInstance* solidity_create_instance() SOLC_NOEXCEPT;
+
+/// Frees a compiler instance created with solidity_create_instance(). Can be NULL.
+/// Must not be called while the instance is compiling.
+void solidity_destroy_instance(SolidityInstance* _instance) SOLC_NOEXCEPT;
+
+/// Same as solidity_compile(), but compiles using the given instance, so that other instances can
+/// compile at the same time. The functions solidity_alloc() and solidity_free() can also be used
+/// concurrently, the other functions must not be called while any instance is compiling.
+/// Unlike solidity_compile(), it does not free the memory used for identifiers of previous
+/// compilations. Call solidity_reset() while no instance is compiling to free it.
+///
+/// @param _instance The instance to use. Must not be NULL.
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_compile_with(
+	SolidityInstance* _instance,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
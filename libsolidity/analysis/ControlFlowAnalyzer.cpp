@@ -20,10 +20,12 @@
 
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <range/v3/algorithm/sort.hpp>
 
 #include <functional>
+#include <future>
 
 using namespace std::placeholders;
 using namespace solidity::langutil;
@@ -32,8 +34,47 @@ using namespace solidity::frontend;
 
 bool ControlFlowAnalyzer::run()
 {
+	if (m_numThreads <= 1)
+	{
+		for (auto& [pair, flow]: m_cfg.allFunctionFlows())
+			analyze(*pair.function, pair.contract, *flow);
+		return !Error::containsErrors(m_errorReporter.errors());
+	}
+
+	// The functions are analysed concurrently, each reporting to an error list of its own.
+	// Only functions with diagnostics are analysed again on this thread, so that the diagnostics
+	// are reported in the same order, deduplicated and subject to the same limits as in a sequential run.
+	std::vector<std::future<bool>> hasDiagnostics;
+	{
+		util::ThreadPool threadPool(m_numThreads);
+		for (auto const& functionFlow: m_cfg.allFunctionFlows())
+			hasDiagnostics.emplace_back(threadPool.submit([this, &functionFlow]() {
+				ErrorList errors;
+				ErrorReporter errorReporter(errors);
+				ControlFlowAnalyzer{m_cfg, errorReporter}.analyze(
+					*functionFlow.first.function,
+					functionFlow.first.contract,
+					*functionFlow.second
+				);
+				return !errors.empty();
+			}));
+	}
+
+	size_t index = 0;
 	for (auto& [pair, flow]: m_cfg.allFunctionFlows())
-		analyze(*pair.function, pair.contract, *flow);
+	{
+		bool analyzeAgain = true;
+		try
+		{
+			analyzeAgain = hasDiagnostics[index++].get();
+		}
+		catch (...)
+		{
+			// The exception is thrown again when analysing the function below.
+		}
+		if (analyzeAgain)
+			analyze(*pair.function, pair.contract, *flow);
+	}
 
 	return !Error::containsErrors(m_errorReporter.errors());
 }
@@ -28,8 +28,9 @@ namespace solidity::frontend
 class ControlFlowAnalyzer
 {
 public:
-	explicit ControlFlowAnalyzer(CFG const& _cfg, langutil::ErrorReporter& _errorReporter):
-		m_cfg(_cfg), m_errorReporter(_errorReporter) {}
+	/// @param _numThreads number of threads on which the functions are analysed concurrently.
+	explicit ControlFlowAnalyzer(CFG const& _cfg, langutil::ErrorReporter& _errorReporter, size_t _numThreads = 1):
+		m_cfg(_cfg), m_errorReporter(_errorReporter), m_numThreads(_numThreads) {}
 
 	bool run();
 
@@ -48,6 +49,7 @@ private:
 
 	CFG const& m_cfg;
 	langutil::ErrorReporter& m_errorReporter;
+	size_t m_numThreads = 1;
 
 	std::set<langutil::SourceLocation> m_unreachableLocationsAlreadyWarnedFor;
 	std::set<VariableDeclaration const*> m_unassignedReturnVarsAlreadyWarnedFor;
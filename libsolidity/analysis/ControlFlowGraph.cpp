@@ -59,6 +59,5 @@ FunctionFlow const& CFG::functionFlow(FunctionDefinition const& _function, Contr
 
 CFGNode* CFG::NodeContainer::newNode()
 {
-	m_nodes.emplace_back(std::make_unique<CFGNode>());
-	return m_nodes.back().get();
+	return &m_nodes.emplace_back();
 }
@@ -24,6 +24,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <stack>
@@ -168,7 +169,8 @@ public:
 	public:
 		CFGNode* newNode();
 	private:
-		std::vector<std::unique_ptr<CFGNode>> m_nodes;
+		/// Allocates the nodes in blocks, which keeps them in place as more nodes are added.
+		std::deque<CFGNode> m_nodes;
 	};
 private:
 	langutil::ErrorReporter& m_errorReporter;
@@ -26,12 +26,35 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolutil/StringUtils.h>
 
-#include <range/v3/view/filter.hpp>
-#include <range/v3/range/conversion.hpp>
-
 using namespace solidity;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Appends the declarations registered under @a _name in @a _declarations to @a _result.
+void appendDeclarations(
+	std::vector<Declaration const*>& _result,
+	std::map<ASTString, std::vector<Declaration const*>> const& _declarations,
+	ASTString const& _name,
+	bool _onlyVisibleAsUnqualifiedNames
+)
+{
+	auto it = _declarations.find(_name);
+	if (it == _declarations.end())
+		return;
+	if (_onlyVisibleAsUnqualifiedNames)
+	{
+		for (Declaration const* declaration: it->second)
+			if (declaration->isVisibleAsUnqualifiedName())
+				_result.push_back(declaration);
+	}
+	else
+		_result += it->second;
+}
+
+}
+
 Declaration const* DeclarationContainer::conflictingDeclaration(
 	Declaration const& _declaration,
 	ASTString const* _name
@@ -41,10 +64,8 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	std::vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	appendDeclarations(declarations, m_declarations, *_name, false);
+	appendDeclarations(declarations, m_invisibleDeclarations, *_name, false);
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -91,11 +112,12 @@ void DeclarationContainer::activateVariable(ASTString const& _name)
 	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
 	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
 	m_invisibleDeclarations.erase(_name);
+	m_namesByLength.reset();
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
 {
-	return m_invisibleDeclarations.count(_name);
+	return m_invisibleDeclarations.find(_name) != m_invisibleDeclarations.end();
 }
 
 bool DeclarationContainer::registerDeclaration(
@@ -126,6 +148,7 @@ bool DeclarationContainer::registerDeclaration(
 			m_homonymCandidates.emplace_back(*_name, _location ? _location : &_declaration.location());
 	}
 
+	m_namesByLength.reset();
 	std::vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
 	if (!util::contains(decls, &_declaration))
 		decls.push_back(&_declaration);
@@ -149,25 +172,18 @@ std::vector<Declaration const*> DeclarationContainer::resolveName(
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	std::vector<Declaration const*> result;
 
-	if (m_declarations.count(_name))
-	{
-		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_declarations.at(_name);
-	}
-
-	if (_settings.alsoInvisible && m_invisibleDeclarations.count(_name))
+	// Walks the enclosing containers iteratively, until one of them declares the name.
+	for (
+		DeclarationContainer const* container = this;
+		container && result.empty();
+		container = _settings.recursive ? container->m_enclosingContainer : nullptr
+	)
 	{
-		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_invisibleDeclarations.at(_name);
+		appendDeclarations(result, container->m_declarations, _name, _settings.onlyVisibleAsUnqualifiedNames);
+		if (_settings.alsoInvisible)
+			appendDeclarations(result, container->m_invisibleDeclarations, _name, _settings.onlyVisibleAsUnqualifiedNames);
 	}
 
-	if (result.empty() && _settings.recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, _settings);
-
 	return result;
 }
 
@@ -178,20 +194,36 @@ std::vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name
 	// since 80 is the suggested line length limit, we use 80^2 as length threshold
 	static size_t const MAXIMUM_LENGTH_THRESHOLD = 80 * 80;
 
-	std::vector<ASTString> similar;
-	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
+	if (!m_namesByLength)
 	{
-		std::string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		m_namesByLength.emplace();
+		for (auto const& declaration: m_declarations)
+			(*m_namesByLength)[declaration.first.size()].visible.push_back(&declaration.first);
+		for (auto const& declaration: m_invisibleDeclarations)
+			(*m_namesByLength)[declaration.first.size()].invisible.push_back(&declaration.first);
 	}
-	for (auto const& declaration: m_invisibleDeclarations)
+
+	std::vector<ASTString> similar;
+	std::vector<ASTString> similarInvisible;
+	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
+	// Names whose length differs by more than the maximum edit distance cannot be similar.
+	for (
+		auto it = m_namesByLength->lower_bound(_name.size() - std::min(_name.size(), maximumEditDistance));
+		it != m_namesByLength->end() && it->first <= _name.size() + maximumEditDistance;
+		++it
+	)
 	{
-		std::string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		for (ASTString const* declarationName: it->second.visible)
+			if (util::stringWithinDistance(_name, *declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				similar.push_back(*declarationName);
+		for (ASTString const* declarationName: it->second.invisible)
+			if (util::stringWithinDistance(_name, *declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				similarInvisible.push_back(*declarationName);
 	}
+	// Keep the order of a scan over the declarations: visible names first, each group sorted by name.
+	std::sort(similar.begin(), similar.end());
+	std::sort(similarInvisible.begin(), similarInvisible.end());
+	similar += similarInvisible;
 
 	if (m_enclosingContainer)
 		similar += m_enclosingContainer->similarNames(_name);
@@ -27,7 +27,9 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <map>
 #include <memory>
+#include <optional>
 
 namespace solidity::frontend
 {
@@ -100,6 +102,13 @@ public:
 	void populateHomonyms(std::back_insert_iterator<Homonyms> _it) const;
 
 private:
+	/// Names declared in this container that have the same length, used by similarNames.
+	struct NamesOfLength
+	{
+		std::vector<ASTString const*> visible;
+		std::vector<ASTString const*> invisible;
+	};
+
 	ASTNode const* m_enclosingNode = nullptr;
 	DeclarationContainer const* m_enclosingContainer = nullptr;
 	std::vector<DeclarationContainer const*> m_innerContainers;
@@ -107,6 +116,9 @@ private:
 	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
 	/// List of declarations (name and location) to check later for homonymity.
 	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
+	/// Declared names by length, built on the first call to similarNames and reset whenever
+	/// a declaration is added. Points into the keys of m_declarations and m_invisibleDeclarations.
+	mutable std::optional<std::map<size_t, NamesOfLength>> m_namesByLength;
 };
 
 }
@@ -53,7 +53,9 @@ bool DocStringTagParser::validateDocStringsUsingTypes(SourceUnit const& _sourceU
 	ErrorReporter::ErrorWatcher errorWatcher = m_errorReporter.errorWatcher();
 
 	SimpleASTVisitor visitReturns(
-		[](ASTNode const&) { return true; },
+		// Only functions and public state variables have return parameters. The bodies and
+		// parameters of callables cannot contain any of them, so there is no need to visit them.
+		[](ASTNode const& _node) { return !dynamic_cast<CallableDeclaration const*>(&_node); },
 		[&](ASTNode const& _node)
 		{
 			if (auto const* annotation = dynamic_cast<StructurallyDocumentedAnnotation const*>(&_node.annotation()))
@@ -160,20 +160,22 @@ bool ContractDefinition::derivesFrom(ContractDefinition const& _base) const
 	return util::contains(annotation().linearizedBaseContracts, &_base);
 }
 
-std::map<util::FixedHash<4>, FunctionTypePointer> ContractDefinition::interfaceFunctions(bool _includeInheritedFunctions) const
+std::map<util::FixedHash<4>, FunctionTypePointer> const& ContractDefinition::interfaceFunctions(bool _includeInheritedFunctions) const
 {
-	auto exportedFunctionList = interfaceFunctionList(_includeInheritedFunctions);
+	return m_interfaceFunctions[_includeInheritedFunctions].init([&]{
+		auto const& exportedFunctionList = interfaceFunctionList(_includeInheritedFunctions);
 
-	std::map<util::FixedHash<4>, FunctionTypePointer> exportedFunctions;
-	for (auto const& it: exportedFunctionList)
-		exportedFunctions.insert(it);
+		std::map<util::FixedHash<4>, FunctionTypePointer> exportedFunctions;
+		for (auto const& it: exportedFunctionList)
+			exportedFunctions.insert(it);
 
-	solAssert(
-		exportedFunctionList.size() == exportedFunctions.size(),
-		"Hash collision at Function Definition Hash calculation"
-	);
+		solAssert(
+			exportedFunctionList.size() == exportedFunctions.size(),
+			"Hash collision at Function Definition Hash calculation"
+		);
 
-	return exportedFunctions;
+		return exportedFunctions;
+	});
 }
 
 FunctionDefinition const* ContractDefinition::constructor() const
@@ -276,7 +278,8 @@ std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractD
 {
 	return m_interfaceFunctionList[_includeInheritedFunctions].init([&]{
 		std::set<std::string> signaturesSeen;
-		std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		std::vector<std::string> signatures;
+		std::vector<FunctionTypePointer> interfaceFunctions;
 
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
@@ -298,11 +301,16 @@ std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractD
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
 					signaturesSeen.insert(functionSignature);
-					interfaceFunctionList.emplace_back(util::selectorFromSignatureH32(functionSignature), fun);
+					signatures.emplace_back(std::move(functionSignature));
+					interfaceFunctions.emplace_back(fun);
 				}
 			}
 		}
 
+		std::vector<util::FixedHash<4>> selectors = util::selectorsFromSignaturesH32(signatures);
+		std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		for (size_t i = 0; i < selectors.size(); ++i)
+			interfaceFunctionList.emplace_back(selectors[i], interfaceFunctions[i]);
 		return interfaceFunctionList;
 	});
 }
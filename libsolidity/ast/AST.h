@@ -31,6 +31,7 @@
 
 #include <liblangutil/SourceLocation.h>
 #include <libevmasm/Instruction.h>
+#include <libsolutil/Arena.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/Visitor.h>
@@ -127,7 +128,8 @@ public:
 	virtual bool experimentalSolidityOnly() const { return false; }
 
 protected:
-	size_t const m_id = 0;
+	/// Only modified by the parser, see Parser::shiftNodeIDs().
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -138,6 +140,8 @@ protected:
 	}
 
 private:
+	friend class Parser;
+
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable std::unique_ptr<ASTAnnotation> m_annotation;
 	SourceLocation m_location;
@@ -173,9 +177,11 @@ public:
 		SourceLocation const& _location,
 		std::optional<std::string> _licenseString,
 		std::vector<ASTPointer<ASTNode>> _nodes,
-		bool _experimentalSolidity
+		bool _experimentalSolidity,
+		std::shared_ptr<util::Arena> _nodeArena = nullptr
 	):
 		ASTNode(_id, _location),
+		m_nodeArena(std::move(_nodeArena)),
 		m_licenseString(std::move(_licenseString)),
 		m_nodes(std::move(_nodes)),
 		m_experimentalSolidity(_experimentalSolidity)
@@ -193,6 +199,9 @@ public:
 	bool experimentalSolidity() const { return m_experimentalSolidity; }
 
 private:
+	/// Memory of the nodes created by the parser, if any. Declared first, so that it is released
+	/// only after the nodes. Nodes taken out of the source unit must not outlive it.
+	std::shared_ptr<util::Arena> m_nodeArena;
 	std::optional<std::string> m_licenseString;
 	std::vector<ASTPointer<ASTNode>> m_nodes;
 	bool m_experimentalSolidity = false;
@@ -550,7 +559,7 @@ public:
 
 	/// @returns a map of canonical function signatures to FunctionDefinitions
 	/// as intended for use by the ABI.
-	std::map<util::FixedHash<4>, FunctionTypePointer> interfaceFunctions(bool _includeInheritedFunctions = true) const;
+	std::map<util::FixedHash<4>, FunctionTypePointer> const& interfaceFunctions(bool _includeInheritedFunctions = true) const;
 	std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> const& interfaceFunctionList(bool _includeInheritedFunctions = true) const;
 	/// @returns the EIP-165 compatible interface identifier. This will exclude inherited functions.
 	uint32_t interfaceId() const;
@@ -593,6 +602,7 @@ private:
 	bool m_abstract{false};
 
 	util::LazyInit<std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList[2];
+	util::LazyInit<std::map<util::FixedHash<4>, FunctionTypePointer>> m_interfaceFunctions[2];
 	util::LazyInit<std::vector<EventDefinition const*>> m_interfaceEvents;
 	util::LazyInit<std::multimap<std::string, FunctionDefinition const*>> m_definedFunctionsByName;
 };
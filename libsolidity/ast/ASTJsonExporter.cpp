@@ -201,12 +201,18 @@ Json ASTJsonExporter::inlineAssemblyIdentifierToJson(std::pair<yul::Identifier c
 
 void ASTJsonExporter::print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format)
 {
-	_stream << util::jsonPrint(toJson(_node), _format);
+	util::jsonPrint(_stream, toJson(_node), _format);
 }
 
 Json ASTJsonExporter::toJson(ASTNode const& _node)
 {
+	// Null members are only removed once the outermost node is complete. Doing it for every
+	// nested node as well would traverse each subtree once per level of nesting above it.
+	++m_nestingDepth;
+	ScopeGuard decreaseNestingDepth([&]() { --m_nestingDepth; });
 	_node.accept(*this);
+	if (m_nestingDepth > 1)
+		return std::move(m_currentValue);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
 
@@ -198,6 +198,8 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json m_currentValue;
+	/// Number of nodes currently being converted by toJson(), including the current one.
+	size_t m_nestingDepth = 0;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
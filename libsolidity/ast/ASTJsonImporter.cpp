@@ -1089,11 +1089,14 @@ ASTPointer<StructuredDocumentation> ASTJsonImporter::createDocumentation(Json co
 
 // ===== helper functions ==========
 
-Json ASTJsonImporter::member(Json const& _node, std::string const& _name)
+Json const& ASTJsonImporter::member(Json const& _node, std::string const& _name)
 {
-	if (!_node.contains(_name))
-		return Json();
-	return _node[_name];
+	// Returning a reference avoids copying the whole subtree of every member on each level.
+	static Json const null;
+	auto it = _node.find(_name);
+	if (it == _node.end())
+		return null;
+	return *it;
 }
 
 Token ASTJsonImporter::scanSingleToken(Json const& _node)
@@ -1111,14 +1114,14 @@ ASTPointer<ASTString> ASTJsonImporter::nullOrASTString(Json const& _json, std::s
 
 ASTPointer<ASTString> ASTJsonImporter::memberAsASTString(Json const& _node, std::string const& _name)
 {
-	Json value = member(_node, _name);
+	Json const& value = member(_node, _name);
 	astAssert(value.is_string(), "field " + _name + " must be of type string.");
 	return std::make_shared<ASTString>(_node[_name].get<std::string>());
 }
 
 bool ASTJsonImporter::memberAsBool(Json const& _node, std::string const& _name)
 {
-	Json value = member(_node, _name);
+	Json const& value = member(_node, _name);
 	astAssert(value.is_boolean(), "field " + _name + " must be of type boolean.");
 	return _node[_name].get<bool>();
 }
@@ -1162,7 +1165,7 @@ Token ASTJsonImporter::literalTokenKind(Json const& _node)
 
 Visibility ASTJsonImporter::visibility(Json const& _node)
 {
-	Json visibility = member(_node, "visibility");
+	Json const& visibility = member(_node, "visibility");
 	astAssert(visibility.is_string(), "'visibility' expected to be a string.");
 
 	std::string const visibilityStr = visibility.get<std::string>();
@@ -1186,7 +1189,7 @@ Visibility ASTJsonImporter::visibility(Json const& _node)
 
 VariableDeclaration::Location ASTJsonImporter::location(Json const& _node)
 {
-	Json storageLoc = member(_node, "storageLocation");
+	Json const& storageLoc = member(_node, "storageLocation");
 	astAssert(storageLoc.is_string(), "'storageLocation' expected to be a string.");
 
 	std::string const storageLocStr = storageLoc.get<std::string>();
@@ -1210,7 +1213,7 @@ VariableDeclaration::Location ASTJsonImporter::location(Json const& _node)
 
 Literal::SubDenomination ASTJsonImporter::subdenomination(Json const& _node)
 {
-	Json subDen = member(_node, "subdenomination");
+	Json const& subDen = member(_node, "subdenomination");
 
 	if (subDen.is_null())
 		return Literal::SubDenomination::None;
@@ -134,8 +134,8 @@ private:
 	///@}
 
 	// =============== general helper functions ===================
-	/// @returns the member of a given JSON object, throws if member does not exist
-	Json member(Json const& _node, std::string const& _name);
+	/// @returns the member of a given JSON object or a null value if the member does not exist
+	static Json const& member(Json const& _node, std::string const& _name);
 	/// @returns the appropriate TokenObject used in parsed Strings (pragma directive or operator)
 	Token scanSingleToken(Json const& _node);
 	template<class T>
@@ -36,14 +36,14 @@ enum class ExperimentalFeature
 	Solidity
 };
 
-static std::set<ExperimentalFeature> const ExperimentalFeatureWithoutWarning =
+inline std::set<ExperimentalFeature> const ExperimentalFeatureWithoutWarning =
 {
 	ExperimentalFeature::ABIEncoderV2,
 	ExperimentalFeature::SMTChecker,
 	ExperimentalFeature::TestOnlyAnalysis,
 };
 
-static std::map<std::string, ExperimentalFeature> const ExperimentalFeatureNames =
+inline std::map<std::string, ExperimentalFeature> const ExperimentalFeatureNames =
 {
 	{ "ABIEncoderV2", ExperimentalFeature::ABIEncoderV2 },
 	{ "SMTChecker", ExperimentalFeature::SMTChecker },
@@ -23,8 +23,11 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -37,19 +40,50 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Types that are fully determined by the arguments of their factory function are interned,
+ * i.e. requesting such a type again returns the previously created instance. Function and
+ * modifier types are not interned because they capture parameter names and annotations.
+ * All factory functions can be called concurrently.
+ *
+ * The factory functions use the TypeProvider activated on the calling thread (see Activation)
+ * or a global one if there is none, so that independent compilations can run concurrently
+ * on different threads, each with an instance of its own.
  */
 class TypeProvider
 {
 public:
-	TypeProvider() = default;
-	TypeProvider(TypeProvider&&) = default;
+	/// Makes a TypeProvider the one used by the factory functions on the current thread for
+	/// the lifetime of this object. Activations can be nested, the innermost one takes precedence.
+	/// A null pointer activates the global instance.
+	class Activation
+	{
+	public:
+		explicit Activation(TypeProvider* _typeProvider): m_previous(s_active) { s_active = _typeProvider; }
+		~Activation() { s_active = m_previous; }
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		TypeProvider* m_previous;
+	};
+
+	TypeProvider();
+	TypeProvider(TypeProvider&&) = delete;
 	TypeProvider(TypeProvider const&) = delete;
-	TypeProvider& operator=(TypeProvider&&) = default;
+	TypeProvider& operator=(TypeProvider&&) = delete;
 	TypeProvider& operator=(TypeProvider const&) = delete;
 	~TypeProvider() = default;
 
-	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
+	/// @returns the TypeProvider activated on the current thread or a null pointer if the
+	/// global one is used. Can be passed to an Activation on another thread.
+	static TypeProvider* active() noexcept { return s_active; }
+
+	/// Resets state of the current TypeProvider to initial state, wiping all mutable types.
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
+	/// Has to be called before the AST nodes types were requested for are destroyed, since
+	/// interned types are looked up by the addresses of these nodes.
 	static void reset();
 
 	/// @name Factory functions
@@ -61,10 +95,10 @@ public:
 	static Type const* fromElementaryTypeName(std::string const& _name);
 
 	/// @returns boolean type.
-	static BoolType const* boolean() noexcept { return &m_boolean; }
+	static BoolType const* boolean() noexcept { return &instance().m_boolean; }
 
 	static FixedBytesType const* byte() { return fixedBytes(1); }
-	static FixedBytesType const* fixedBytes(unsigned m) { return m_bytesM.at(m - 1).get(); }
+	static FixedBytesType const* fixedBytes(unsigned m) { return instance().m_bytesM.at(m - 1).get(); }
 
 	static ArrayType const* bytesStorage();
 	static ArrayType const* bytesMemory();
@@ -83,16 +117,16 @@ public:
 
 	static ArraySliceType const* arraySlice(ArrayType const& _arrayType);
 
-	static AddressType const* payableAddress() noexcept { return &m_payableAddress; }
-	static AddressType const* address() noexcept { return &m_address; }
+	static AddressType const* payableAddress() noexcept { return &instance().m_payableAddress; }
+	static AddressType const* address() noexcept { return &instance().m_address; }
 
 	static IntegerType const* integer(unsigned _bits, IntegerType::Modifier _modifier)
 	{
 		solAssert((_bits % 8) == 0, "");
 		if (_modifier == IntegerType::Modifier::Unsigned)
-			return m_uintM.at(_bits / 8 - 1).get();
+			return instance().m_uintM.at(_bits / 8 - 1).get();
 		else
-			return m_intM.at(_bits / 8 - 1).get();
+			return instance().m_intM.at(_bits / 8 - 1).get();
 	}
 	static IntegerType const* uint(unsigned _bits) { return integer(_bits, IntegerType::Modifier::Unsigned); }
 
@@ -107,7 +141,7 @@ public:
 	/// @returns a tuple type with the given members.
 	static TupleType const* tuple(std::vector<Type const*> members);
 
-	static TupleType const* emptyTuple() noexcept { return &m_emptyTuple; }
+	static TupleType const* emptyTuple() noexcept { return &instance().m_emptyTuple; }
 
 	static ReferenceType const* withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer);
 
@@ -177,7 +211,7 @@ public:
 
 	static ContractType const* contract(ContractDefinition const& _contract, bool _isSuper = false);
 
-	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &m_inaccessibleDynamic; }
+	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &instance().m_inaccessibleDynamic; }
 
 	/// @returns the type of an enum instance for given definition, there is one distinct type per enum definition.
 	static EnumType const* enumType(EnumDefinition const& _enum);
@@ -200,9 +234,11 @@ public:
 	static UserDefinedValueType const* userDefinedValueType(UserDefinedValueTypeDefinition const& _definition);
 
 private:
-	/// Global TypeProvider instance.
-	static TypeProvider& instance()
+	/// TypeProvider activated on the current thread or the global instance.
+	static TypeProvider& instance() noexcept
 	{
+		if (s_active)
+			return *s_active;
 		static TypeProvider _provider;
 		return _provider;
 	}
@@ -210,28 +246,52 @@ private:
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
-	static BoolType const m_boolean;
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
+	/// @returns the type stored under @a _key in @a _types, creating it from @a _args if not present.
+	template <typename T, typename Key, typename... Args>
+	static inline T const* internAndGet(std::map<Key, T const*>& _types, Key _key, Args&& ... _args);
+
+	static thread_local TypeProvider* s_active;
+
+	BoolType const m_boolean{};
+	InaccessibleDynamicType const m_inaccessibleDynamic{};
 
 	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_payableAddress;
-	static AddressType const m_address;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 5> const m_magics;        ///< MagicType's except MetaType
+	std::unique_ptr<ArrayType> m_bytesStorage;
+	std::unique_ptr<ArrayType> m_bytesMemory;
+	std::unique_ptr<ArrayType> m_bytesCalldata;
+	std::unique_ptr<ArrayType> m_stringStorage;
+	std::unique_ptr<ArrayType> m_stringMemory;
+
+	TupleType const m_emptyTuple{};
+	AddressType const m_payableAddress{StateMutability::Payable};
+	AddressType const m_address{StateMutability::NonPayable};
+	std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
+	std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
+	std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
+	std::array<std::unique_ptr<MagicType>, 5> const m_magics;        ///< MagicType's except MetaType
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	/// Interned types, owned by m_generalTypes.
+	std::map<std::tuple<ReferenceType const*, DataLocation, bool>, ReferenceType const*> m_typesWithLocation{};
+	std::map<std::tuple<DataLocation, Type const*, std::optional<u256>>, ArrayType const*> m_arrayTypes{};
+	std::map<ArrayType const*, ArraySliceType const*> m_arraySliceTypes{};
+	std::map<std::vector<Type const*>, TupleType const*> m_tupleTypes{};
+	std::map<std::pair<rational, Type const*>, RationalNumberType const*> m_rationalNumberTypes{};
+	std::map<std::pair<ContractDefinition const*, bool>, ContractType const*> m_contractTypes{};
+	std::map<EnumDefinition const*, EnumType const*> m_enumTypes{};
+	std::map<SourceUnit const*, ModuleType const*> m_moduleTypes{};
+	std::map<Type const*, TypeType const*> m_typeTypes{};
+	std::map<std::pair<StructDefinition const*, DataLocation>, StructType const*> m_structTypes{};
+	std::map<Type const*, MagicType const*> m_metaTypes{};
+	std::map<std::tuple<Type const*, ASTString, Type const*, ASTString>, MappingType const*> m_mappingTypes{};
+	std::map<UserDefinedValueTypeDefinition const*, UserDefinedValueType const*> m_userDefinedValueTypes{};
+
+	/// Guards all lazily created types. Recursive because creating a type can request other types.
+	std::recursive_mutex m_mutex{};
 };
 
 }
@@ -44,7 +44,6 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
 
-#include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 #include <range/v3/view/transform.hpp>
@@ -183,16 +182,29 @@ std::pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	m_storageOffsets.reset();
+	m_memberIndicesByName.reset();
 }
 
 std::pair<u256, unsigned> const* MemberList::memberStorageOffset(std::string const& _name) const
 {
 	StorageOffsets const& offsets = storageOffsets();
 
-	for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
-		if (member.name == _name)
-			return offsets.offset(index);
-	return nullptr;
+	auto it = memberIndicesByName().lower_bound(_name);
+	if (it == memberIndicesByName().end() || it->first != _name)
+		return nullptr;
+	return offsets.offset(it->second);
+}
+
+std::multimap<std::string, size_t> const& MemberList::memberIndicesByName() const
+{
+	return m_memberIndicesByName.init([&]{
+		std::multimap<std::string, size_t> indices;
+		// Members of the same name are inserted at the end of their range, i.e. keep their order.
+		for (size_t index = 0; index < m_memberTypes.size(); ++index)
+			indices.emplace(m_memberTypes[index].name, index);
+		return indices;
+	});
 }
 
 u256 const& MemberList::storageSize() const
@@ -124,21 +124,18 @@ public:
 	void combine(MemberList const& _other);
 	Type const* memberType(std::string const& _name) const
 	{
-		Type const* type = nullptr;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
-		return type;
+		auto [begin, end] = memberIndicesByName().equal_range(_name);
+		if (begin == end)
+			return nullptr;
+		solAssert(std::next(begin) == end, "Requested member type by non-unique name.");
+		return m_memberTypes[begin->second].type;
 	}
 	MemberMap membersByName(std::string const& _name) const
 	{
 		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
+		auto [begin, end] = memberIndicesByName().equal_range(_name);
+		for (auto it = begin; it != end; ++it)
+			members.push_back(m_memberTypes[it->second]);
 		return members;
 	}
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
@@ -152,9 +149,12 @@ public:
 
 private:
 	StorageOffsets const& storageOffsets() const;
+	/// @returns the indices of the members in m_memberTypes by name, in the order of m_memberTypes.
+	std::multimap<std::string, size_t> const& memberIndicesByName() const;
 
 	MemberMap m_memberTypes;
 	util::LazyInit<StorageOffsets> m_storageOffsets;
+	util::LazyInit<std::multimap<std::string, size_t>> m_memberIndicesByName;
 };
 
 static_assert(std::is_nothrow_move_constructible<MemberList>::value, "MemberList should be noexcept move constructible");
@@ -2,12 +2,12 @@
 
 #include <liblangutil/Token.h>
 
-#include <vector>
+#include <array>
 
 namespace solidity::frontend
 {
 
-std::vector<langutil::Token> const userDefinableOperators = {
+inline constexpr std::array userDefinableOperators = {
 	// Bitwise
 	langutil::Token::BitOr,
 	langutil::Token::BitAnd,
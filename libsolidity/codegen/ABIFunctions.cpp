@@ -34,6 +34,25 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// @returns true if the elements of @a _type have the same representation in the ABI encoding
+/// and in memory and decoding them does not revert for any value.
+bool elementsDecodedUnchanged(ArrayType const& _type)
+{
+	Type const* baseType = _type.baseType();
+	if (auto userDefinedValueType = dynamic_cast<UserDefinedValueType const*>(baseType))
+		baseType = &userDefinedValueType->underlyingType();
+	if (auto integerType = dynamic_cast<IntegerType const*>(baseType))
+		return integerType->numBits() == 256;
+	if (auto fixedBytesType = dynamic_cast<FixedBytesType const*>(baseType))
+		return fixedBytesType->numBytes() == 32;
+	return false;
+}
+
+}
+
 std::string ABIFunctions::tupleEncoder(
 	TypePointers const& _givenTypes,
 	TypePointers _targetTypes,
@@ -1170,6 +1189,8 @@ std::string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType cons
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 	if (_type.isByteArrayOrString())
 		return abiDecodingFunctionByteArrayAvailableLength(_type, _fromMemory);
+	if (m_copyDecodedArrays && elementsDecodedUnchanged(_type))
+		return abiDecodingFunctionCopiedArrayAvailableLength(_type, _fromMemory);
 	solAssert(_type.calldataStride() > 0, "");
 
 	std::string functionName =
@@ -1301,6 +1322,48 @@ std::string ABIFunctions::abiDecodingFunctionByteArrayAvailableLength(ArrayType
 	});
 }
 
+std::string ABIFunctions::abiDecodingFunctionCopiedArrayAvailableLength(ArrayType const& _type, bool _fromMemory)
+{
+	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
+	solAssert(elementsDecodedUnchanged(_type), "");
+	solAssert(_type.calldataStride() == 32, "");
+
+	std::string functionName =
+		"abi_decode_available_length_copied_" +
+		_type.identifier() +
+		(_fromMemory ? "_fromMemory" : "");
+
+	return createFunction(functionName, [&]() {
+		Whiskers templ(R"(
+			// <readableTypeName>
+			function <functionName>(offset, length, end) -> array {
+				array := <allocate>(<allocationSize>(length))
+				let dst := array
+				<?dynamic>
+					mstore(array, length)
+					dst := add(array, 0x20)
+				</dynamic>
+				let size := mul(length, 0x20)
+				if gt(add(offset, size), end) {
+					<revertInvalidStride>()
+				}
+				<copyToMemFun>(offset, dst, size)
+			}
+		)");
+		templ("functionName", functionName);
+		templ("readableTypeName", _type.toString(true));
+		templ("allocate", m_utils.allocationFunction());
+		templ("allocationSize", m_utils.arrayAllocationSizeFunction(_type));
+		templ("dynamic", _type.isDynamicallySized());
+		templ(
+			"revertInvalidStride",
+			revertReasonIfDebugFunction("ABI decoding: invalid calldata array stride")
+		);
+		templ("copyToMemFun", m_utils.copyToMemoryFunction(!_fromMemory, /*cleanup*/false));
+		return templ.render();
+	});
+}
+
 std::string ABIFunctions::abiDecodingFunctionCalldataStruct(StructType const& _type)
 {
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
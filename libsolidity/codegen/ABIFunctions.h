@@ -57,12 +57,14 @@ public:
 	explicit ABIFunctions(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		MultiUseYulFunctionCollector& _functionCollector
+		MultiUseYulFunctionCollector& _functionCollector,
+		bool _copyDecodedArrays = false
 	):
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_functionCollector(_functionCollector),
-		m_utils(_evmVersion, m_revertStrings, m_functionCollector)
+		m_utils(_evmVersion, m_revertStrings, m_functionCollector),
+		m_copyDecodedArrays(_copyDecodedArrays)
 	{}
 
 	/// @returns name of an assembly function to ABI-encode values of @a _givenTypes
@@ -245,6 +247,9 @@ private:
 	std::string abiDecodingFunctionCalldataArray(ArrayType const& _type);
 	/// Part of @a abiDecodingFunctionArrayAvailableLength
 	std::string abiDecodingFunctionByteArrayAvailableLength(ArrayType const& _type, bool _fromMemory);
+	/// Part of @a abiDecodingFunctionArrayAvailableLength for arrays whose elements are copied
+	/// unchanged (see @a m_copyDecodedArrays).
+	std::string abiDecodingFunctionCopiedArrayAvailableLength(ArrayType const& _type, bool _fromMemory);
 	/// Part of @a abiDecodingFunction for calldata struct types.
 	std::string abiDecodingFunctionCalldataStruct(StructType const& _type);
 	/// Part of @a abiDecodingFunction for array types.
@@ -281,6 +286,9 @@ private:
 	RevertStrings const m_revertStrings;
 	MultiUseYulFunctionCollector& m_functionCollector;
 	YulUtilFunctions m_utils;
+	/// If true, arrays of 32 byte value types that need no validation are decoded with a single
+	/// copy instead of a loop over their elements.
+	bool m_copyDecodedArrays = false;
 };
 
 }
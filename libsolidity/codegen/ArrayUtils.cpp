@@ -355,7 +355,7 @@ void ArrayUtils::copyArrayToMemory(ArrayType const& _sourceType, bool _padToWord
 			return;
 		}
 
-		// memcpy using the built-in contract
+		// memcpy, using mcopy if available
 		if (_sourceType.isDynamicallySized())
 		{
 			// change pointer to data part
@@ -924,6 +924,9 @@ void ArrayUtils::popStorageArrayElement(ArrayType const& _type) const
 void ArrayUtils::clearStorageLoop(Type const* _type) const
 {
 	solAssert(_type->storageBytes() >= 32, "");
+	// All value types occupying a full slot are cleared the same way, so they share one loop.
+	if (_type->isValueType())
+		_type = TypeProvider::uint256();
 	m_context.callLowLevelFunction(
 		"$clearStorageLoop_" + _type->identifier(),
 		2,
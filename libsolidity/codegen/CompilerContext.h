@@ -282,8 +282,13 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendToAuxiliaryData(bytes const& _data) { m_asm->appendToAuxiliaryData(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion)); }
+	/// Run optimisation step. Independent sub-assemblies are optimised on up to @a _numThreads threads.
+	void optimise(OptimiserSettings const& _settings, size_t _numThreads = 1)
+	{
+		evmasm::Assembly::OptimiserSettings settings = evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion);
+		settings.numThreads = _numThreads;
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
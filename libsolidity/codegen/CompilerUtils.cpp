@@ -605,6 +605,17 @@ void CompilerUtils::encodeToMemory(
 	popStackSlots(argSize + dynPointers + 1);
 }
 
+bool CompilerUtils::abiEncodingFitsIntoScratchSpace(TypePointers const& _types)
+{
+	// Every value type occupies a single word in the ABI encoding.
+	if (_types.size() * 32 > freeMemoryPointer)
+		return false;
+	for (Type const* type: _types)
+		if (!type->isValueType())
+			return false;
+	return true;
+}
+
 void CompilerUtils::abiEncodeV2(
 	TypePointers const& _givenTypes,
 	TypePointers const& _targetTypes,
@@ -666,6 +677,12 @@ void CompilerUtils::memoryCopy32()
 {
 	// Stack here: size target source
 
+	if (m_context.evmVersion().hasMcopy())
+	{
+		memoryCopy();
+		return;
+	}
+
 	m_context.appendInlineAssembly(R"(
 		{
 			for { let i := 0 } lt(i, len) { i := add(i, 32) } {
@@ -682,6 +699,12 @@ void CompilerUtils::memoryCopy()
 {
 	// Stack here: size target source
 
+	if (m_context.evmVersion().hasMcopy())
+	{
+		m_context << Instruction::SWAP1 << Instruction::MCOPY;
+		return;
+	}
+
 	m_context.appendInlineAssembly(R"(
 		{
 			// copy 32 bytes at once
@@ -1051,57 +1074,70 @@ void CompilerUtils::convertType(
 				}
 				else
 				{
-					// stack: <source ref> (variably sized)
-					unsigned stackSize = typeOnStack.sizeOnStack();
-					ArrayUtils(m_context).retrieveLength(typeOnStack);
-
-					// allocate memory
-					// stack: <source ref> (variably sized) <length>
-					m_context << Instruction::DUP1;
-					ArrayUtils(m_context).convertLengthToSize(targetType, true);
-					// stack: <source ref> (variably sized) <length> <size>
-					if (targetType.isDynamicallySized())
-						m_context << u256(0x20) << Instruction::ADD;
-					allocateMemory();
-					// stack: <source ref> (variably sized) <length> <mem start>
-					m_context << Instruction::DUP1;
-					moveIntoStack(2 + stackSize);
-					if (targetType.isDynamicallySized())
-					{
-						m_context << Instruction::DUP2;
-						storeInMemoryDynamic(*TypeProvider::uint256());
-					}
-					// stack: <mem start> <source ref> (variably sized) <length> <mem data pos>
-					if (targetType.baseType()->isValueType())
+					// The copy is emitted once per pair of types and shared by all conversions.
+					auto conversionImpl =
+						[typeOnStack = &typeOnStack, targetType = &targetType, _cleanupNeeded](CompilerContext& _context)
 					{
-						copyToStackTop(2 + stackSize, stackSize);
-						ArrayUtils(m_context).copyArrayToMemory(typeOnStack);
-					}
-					else
-					{
-						m_context << u256(0) << Instruction::SWAP1;
-						// stack: <mem start> <source ref> (variably sized) <length> <counter> <mem data pos>
-						auto repeat = m_context.newTag();
-						m_context << repeat;
-						m_context << Instruction::DUP3 << Instruction::DUP3;
-						m_context << Instruction::LT << Instruction::ISZERO;
-						auto loopEnd = m_context.appendConditionalJump();
-						copyToStackTop(3 + stackSize, stackSize);
-						copyToStackTop(2 + stackSize, 1);
-						ArrayUtils(m_context).accessIndex(typeOnStack, false);
-						if (typeOnStack.location() == DataLocation::Storage)
-							StorageItem(m_context, *typeOnStack.baseType()).retrieveValue(SourceLocation(), true);
-						convertType(*typeOnStack.baseType(), *targetType.baseType(), _cleanupNeeded);
-						storeInMemoryDynamic(*targetType.baseType(), true);
-						m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
-						m_context << Instruction::SWAP1;
-						m_context.appendJumpTo(repeat);
-						m_context << loopEnd;
-						m_context << Instruction::POP;
-					}
-					// stack: <mem start> <source ref> (variably sized) <length> <mem data pos updated>
-					popStackSlots(2 + stackSize);
-					// Stack: <mem start>
+						CompilerUtils utils(_context);
+						// stack: <source ref> (variably sized)
+						unsigned stackSize = typeOnStack->sizeOnStack();
+						ArrayUtils(_context).retrieveLength(*typeOnStack);
+
+						// allocate memory
+						// stack: <source ref> (variably sized) <length>
+						_context << Instruction::DUP1;
+						ArrayUtils(_context).convertLengthToSize(*targetType, true);
+						// stack: <source ref> (variably sized) <length> <size>
+						if (targetType->isDynamicallySized())
+							_context << u256(0x20) << Instruction::ADD;
+						utils.allocateMemory();
+						// stack: <source ref> (variably sized) <length> <mem start>
+						_context << Instruction::DUP1;
+						utils.moveIntoStack(2 + stackSize);
+						if (targetType->isDynamicallySized())
+						{
+							_context << Instruction::DUP2;
+							utils.storeInMemoryDynamic(*TypeProvider::uint256());
+						}
+						// stack: <mem start> <source ref> (variably sized) <length> <mem data pos>
+						if (targetType->baseType()->isValueType())
+						{
+							utils.copyToStackTop(2 + stackSize, stackSize);
+							ArrayUtils(_context).copyArrayToMemory(*typeOnStack);
+						}
+						else
+						{
+							_context << u256(0) << Instruction::SWAP1;
+							// stack: <mem start> <source ref> (variably sized) <length> <counter> <mem data pos>
+							auto repeat = _context.newTag();
+							_context << repeat;
+							_context << Instruction::DUP3 << Instruction::DUP3;
+							_context << Instruction::LT << Instruction::ISZERO;
+							auto loopEnd = _context.appendConditionalJump();
+							utils.copyToStackTop(3 + stackSize, stackSize);
+							utils.copyToStackTop(2 + stackSize, 1);
+							ArrayUtils(_context).accessIndex(*typeOnStack, false);
+							if (typeOnStack->location() == DataLocation::Storage)
+								StorageItem(_context, *typeOnStack->baseType()).retrieveValue(SourceLocation(), true);
+							utils.convertType(*typeOnStack->baseType(), *targetType->baseType(), _cleanupNeeded);
+							utils.storeInMemoryDynamic(*targetType->baseType(), true);
+							_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
+							_context << Instruction::SWAP1;
+							_context.appendJumpTo(repeat);
+							_context << loopEnd;
+							_context << Instruction::POP;
+						}
+						// stack: <mem start> <source ref> (variably sized) <length> <mem data pos updated>
+						utils.popStackSlots(2 + stackSize);
+						// Stack: <mem start>
+					};
+					m_context.callLowLevelFunction(
+						"$convertArrayToMemory_" + typeOnStack.identifier() + "_to_" + targetType.identifier() +
+							(_cleanupNeeded ? "_cleanup" : ""),
+						typeOnStack.sizeOnStack(),
+						1,
+						conversionImpl
+					);
 				}
 			}
 			break;
@@ -1202,15 +1238,13 @@ void CompilerUtils::convertType(
 					}
 					_context << Instruction::POP << Instruction::POP;
 				};
-				if (typeOnStack.recursive())
-					m_context.callLowLevelFunction(
-						"$convertRecursiveArrayStorageToMemory_" + typeOnStack.identifier() + "_to_" + targetType.identifier(),
-						1,
-						1,
-						conversionImpl
-					);
-				else
-					conversionImpl(m_context);
+				// Also needed for recursive structs. The copy is shared by all conversions between these types.
+				m_context.callLowLevelFunction(
+					"$convertStructStorageToMemory_" + typeOnStack.identifier() + "_to_" + targetType.identifier(),
+					1,
+					1,
+					conversionImpl
+				);
 				break;
 			}
 			case DataLocation::Transient:
@@ -190,6 +190,10 @@ public:
 		bool _padToWordBoundaries = true
 	);
 
+	/// @returns true if the ABI encoding of values of the given types always fits into the scratch
+	/// space at offset zero, i.e. if they are at most two value types.
+	static bool abiEncodingFitsIntoScratchSpace(TypePointers const& _types);
+
 	/// Decodes data from ABI encoding into internal encoding. If @a _fromMemory is set to true,
 	/// the data is taken from memory instead of from calldata.
 	/// Can allocate memory.
@@ -204,6 +208,7 @@ public:
 	void zeroInitialiseMemoryArray(ArrayType const& _type);
 
 	/// Copies full 32 byte words in memory (regions cannot overlap), i.e. may copy more than length.
+	/// Uses ``mcopy`` and copies exactly length bytes if the EVM version supports it.
 	/// Length can be zero, in this case, it copies nothing.
 	/// Stack pre: <size> <target> <source>
 	/// Stack post:
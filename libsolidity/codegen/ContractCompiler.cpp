@@ -325,10 +325,36 @@ void ContractCompiler::appendDelegatecallCheck()
 void ContractCompiler::appendInternalSelector(
 	std::map<FixedHash<4>, evmasm::AssemblyItem const> const& _entryPoints,
 	std::vector<FixedHash<4>> const& _ids,
+	std::map<FixedHash<4>, size_t> const& _callCounts,
 	evmasm::AssemblyItem const& _notFoundTag,
 	size_t _runs
 )
 {
+	auto callCount = [&](FixedHash<4> const& _id) { return util::valueOrDefault(_callCounts, _id, size_t(0)); };
+
+	// If a single function receives at least half of the calls, checking it first saves more gas
+	// for its calls than the one additional comparison costs all the others.
+	if (_ids.size() > 1)
+	{
+		size_t totalCalls = 0;
+		for (auto const& id: _ids)
+			totalCalls += callCount(id);
+		auto hottest = std::max_element(_ids.begin(), _ids.end(), [&](auto const& _a, auto const& _b) {
+			return callCount(_a) < callCount(_b);
+		});
+		if (totalCalls > 0 && callCount(*hottest) >= totalCalls - callCount(*hottest))
+		{
+			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(*hottest)) << Instruction::EQ;
+			m_context.appendConditionalJumpTo(_entryPoints.at(*hottest));
+			std::vector<FixedHash<4>> others;
+			for (auto const& id: _ids)
+				if (id != *hottest)
+					others.emplace_back(id);
+			appendInternalSelector(_entryPoints, others, _callCounts, _notFoundTag, _runs);
+			return;
+		}
+	}
+
 	// Code for selecting from n functions without split:
 	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
 	//   push2/3 <notfound> jump
@@ -369,15 +395,20 @@ void ContractCompiler::appendInternalSelector(
 		evmasm::AssemblyItem lessTag{m_context.appendConditionalJump()};
 		// Here, we have funid >= pivot
 		std::vector<FixedHash<4>> larger{_ids.begin() + static_cast<ptrdiff_t>(pivotIndex), _ids.end()};
-		appendInternalSelector(_entryPoints, larger, _notFoundTag, _runs);
+		appendInternalSelector(_entryPoints, larger, _callCounts, _notFoundTag, _runs);
 		m_context << lessTag;
 		// Here, we have funid < pivot
 		std::vector<FixedHash<4>> smaller{_ids.begin(), _ids.begin() + static_cast<ptrdiff_t>(pivotIndex)};
-		appendInternalSelector(_entryPoints, smaller, _notFoundTag, _runs);
+		appendInternalSelector(_entryPoints, smaller, _callCounts, _notFoundTag, _runs);
 	}
 	else
 	{
-		for (auto const& id: _ids)
+		// Functions that are called more often are checked first.
+		std::vector<FixedHash<4>> ids = _ids;
+		std::stable_sort(ids.begin(), ids.end(), [&](auto const& _a, auto const& _b) {
+			return callCount(_a) > callCount(_b);
+		});
+		for (auto const& id: ids)
 		{
 			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
 			m_context.appendConditionalJumpTo(_entryPoints.at(id));
@@ -448,13 +479,22 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 
 		// stack now is: <can-call-non-view-functions>? <funhash>
 		std::vector<FixedHash<4>> sortedIDs;
+		std::map<FixedHash<4>, size_t> callCounts;
 		for (auto const& it: interfaceFunctions)
 		{
 			callDataUnpackerEntryPoints.emplace(it.first, m_context.newTag());
 			sortedIDs.emplace_back(it.first);
+			if (size_t const* count = util::valueOrNullptr(m_optimiserSettings.executionProfile, it.second->externalSignature()))
+				callCounts[it.first] = *count;
 		}
 		std::sort(sortedIDs.begin(), sortedIDs.end());
-		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		appendInternalSelector(
+			callDataUnpackerEntryPoints,
+			sortedIDs,
+			callCounts,
+			notFound,
+			m_optimiserSettings.expectedExecutionsPerDeployment
+		);
 	}
 
 	m_context << notFoundOrReceiveEther;
@@ -1536,7 +1576,11 @@ void ContractCompiler::appendStackVariableInitialisation(
 
 void ContractCompiler::compileExpression(Expression const& _expression, Type const* _targetType)
 {
-	ExpressionCompiler expressionCompiler(m_context, m_optimiserSettings.runOrderLiterals);
+	ExpressionCompiler expressionCompiler(
+		m_context,
+		m_optimiserSettings.runOrderLiterals,
+		m_optimiserSettings.encodeEventDataInScratchSpace
+	);
 	expressionCompiler.compile(_expression);
 	if (_targetType)
 		CompilerUtils(m_context).convertType(*_expression.annotation().type, *_targetType);
@@ -89,9 +89,13 @@ private:
 	void appendDelegatecallCheck();
 	/// Appends the function selector. Is called recursively to create a binary search tree.
 	/// @a _runs the number of intended executions of the contract to tune the split point.
+	/// Appends the code that jumps to the entry point of the function with the selector on the stack.
+	/// @param _callCounts the number of calls of each function according to the execution profile.
+	///                    A function that receives most of the calls is checked first.
 	void appendInternalSelector(
 		std::map<util::FixedHash<4>, evmasm::AssemblyItem const> const& _entryPoints,
 		std::vector<util::FixedHash<4>> const& _ids,
+		std::map<util::FixedHash<4>, size_t> const& _callCounts,
 		evmasm::AssemblyItem const& _notFoundTag,
 		size_t _runs
 	);
@@ -990,10 +990,22 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 					nonIndexedArgTypes.push_back(arguments[arg]->annotation().type);
 					nonIndexedParamTypes.push_back(paramTypes[arg]);
 				}
-			utils().fetchFreeMemoryPointer();
+			// The indexed arguments are already on the stack, so small static data can be
+			// encoded into the scratch space.
+			bool useScratchSpace =
+				m_encodeEventDataInScratchSpace &&
+				CompilerUtils::abiEncodingFitsIntoScratchSpace(nonIndexedParamTypes);
+			if (useScratchSpace)
+				m_context << u256(0);
+			else
+				utils().fetchFreeMemoryPointer();
 			utils().abiEncode(nonIndexedArgTypes, nonIndexedParamTypes);
 			// need: topic1 ... topicn memsize memstart
-			utils().toSizeAfterFreeMemoryPointer();
+			if (useScratchSpace)
+				// The data starts at zero, so its end is its size.
+				m_context << u256(0);
+			else
+				utils().toSizeAfterFreeMemoryPointer();
 			m_context << logInstruction(numIndexed);
 			break;
 		}
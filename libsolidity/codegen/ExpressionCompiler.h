@@ -59,9 +59,11 @@ class ExpressionCompiler: private ASTConstVisitor
 public:
 	ExpressionCompiler(
 		CompilerContext& _compilerContext,
-		bool _optimiseOrderLiterals
+		bool _optimiseOrderLiterals,
+		bool _encodeEventDataInScratchSpace = false
 	):
 		m_optimiseOrderLiterals(_optimiseOrderLiterals),
+		m_encodeEventDataInScratchSpace(_encodeEventDataInScratchSpace),
 		m_context(_compilerContext)
 	{}
 
@@ -140,6 +142,8 @@ private:
 	CompilerUtils utils();
 
 	bool m_optimiseOrderLiterals;
+	/// See OptimiserSettings::encodeEventDataInScratchSpace.
+	bool m_encodeEventDataInScratchSpace;
 	CompilerContext& m_context;
 	std::unique_ptr<LValue> m_currentLValue;
 
@@ -464,9 +464,10 @@ void GenericStorageItem<IsTransient>::setToZero(langutil::SourceLocation const&,
 	{
 		solUnimplementedAssert(!IsTransient, "Transient storage reference types are not supported yet.");
 		// stack layout: storage_key storage_offset
-		// @todo this can be improved: use StorageItem for non-value types, and just store 0 in
-		// all slots that contain value types later.
 		auto const& structType = dynamic_cast<StructType const&>(*m_dataType);
+		// Slots of packed members only contain members of this struct, so they are cleared
+		// as a whole, once for all the members they contain.
+		std::set<u256> packedSlots;
 		for (auto const& member: structType.members(nullptr))
 		{
 			// zero each member that is not a mapping
@@ -474,11 +475,20 @@ void GenericStorageItem<IsTransient>::setToZero(langutil::SourceLocation const&,
 			if (memberType->category() == Type::Category::Mapping)
 				continue;
 			std::pair<u256, unsigned> const& offsets = structType.storageOffsetsOfMember(member.name);
+			if (memberType->storageBytes() < 32)
+			{
+				packedSlots.insert(offsets.first);
+				continue;
+			}
 			m_context
 				<< offsets.first << Instruction::DUP3 << Instruction::ADD
 				<< u256(offsets.second);
 			StorageItem(m_context, *memberType).setToZero();
 		}
+		for (u256 const& slot: packedSlots)
+			m_context
+				<< u256(0) << slot << Instruction::DUP4 << Instruction::ADD
+				<< s_storeInstruction;
 		if (_removeReference)
 			m_context << Instruction::POP << Instruction::POP;
 	}
@@ -30,6 +30,12 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
+YulFunctionCache::Function const* YulFunctionCache::find(std::string const& _name) const
+{
+	auto it = m_functions.find(_name);
+	return it == m_functions.end() ? nullptr : &it->second;
+}
+
 std::string MultiUseYulFunctionCollector::requestedFunctions()
 {
 	std::string result = std::move(m_code);
@@ -40,41 +46,103 @@ std::string MultiUseYulFunctionCollector::requestedFunctions()
 
 std::string MultiUseYulFunctionCollector::createFunction(std::string const& _name, std::function<std::string()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions.insert(_name);
+	return create(_name, true, [&]() {
 		std::string fun = _creator();
 		solAssert(!fun.empty(), "");
 		solAssert(fun.find("function " + _name + "(") != std::string::npos, "Function not properly named.");
-		m_code += std::move(fun);
-	}
-	return _name;
+		return fun;
+	});
 }
 
 std::string MultiUseYulFunctionCollector::createFunction(
 	std::string const& _name,
 	std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 )
+{
+	return create(_name, true, [&]() { return wrapFunction(_name, _creator); });
+}
+
+std::string MultiUseYulFunctionCollector::createContractFunction(std::string const& _name, std::function<std::string()> const& _creator)
+{
+	return create(_name, false, [&]() {
+		std::string fun = _creator();
+		solAssert(!fun.empty(), "");
+		solAssert(fun.find("function " + _name + "(") != std::string::npos, "Function not properly named.");
+		return fun;
+	});
+}
+
+std::string MultiUseYulFunctionCollector::createContractFunction(
+	std::string const& _name,
+	std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+)
+{
+	return create(_name, false, [&]() { return wrapFunction(_name, _creator); });
+}
+
+std::string MultiUseYulFunctionCollector::create(
+	std::string const& _name,
+	bool _cacheable,
+	std::function<std::string()> const& _generate
+)
 {
 	solAssert(!_name.empty(), "");
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions.insert(_name);
-		std::vector<std::string> arguments;
-		std::vector<std::string> returnParameters;
-		std::string body = _creator(arguments, returnParameters);
-		solAssert(!body.empty(), "");
-
-		m_code += Whiskers(R"(
+	if (!m_dependencyStack.empty())
+		m_dependencyStack.back().push_back(_name);
+	if (m_requestedFunctions.count(_name) || (_cacheable && addFromCache(_name)))
+		return _name;
+
+	m_requestedFunctions.insert(_name);
+	m_dependencyStack.emplace_back();
+	std::string code = _generate();
+	std::vector<std::string> dependencies = std::move(m_dependencyStack.back());
+	m_dependencyStack.pop_back();
+
+	if (_cacheable && m_cache)
+		m_cache->add(_name, {code, std::move(dependencies)});
+	m_code += std::move(code);
+	return _name;
+}
+
+bool MultiUseYulFunctionCollector::addFromCache(std::string const& _name)
+{
+	if (!m_cache)
+		return false;
+	YulFunctionCache::Function const* function = m_cache->find(_name);
+	if (!function)
+		return false;
+
+	// Mark the function as requested first, like create() does, so that recursive
+	// dependencies terminate and the resulting order matches a fresh generation.
+	m_requestedFunctions.insert(_name);
+	for (std::string const& dependency: function->dependencies)
+		if (!m_requestedFunctions.count(dependency) && !addFromCache(dependency))
+		{
+			m_requestedFunctions.erase(_name);
+			return false;
+		}
+	m_code += function->code;
+	return true;
+}
+
+std::string MultiUseYulFunctionCollector::wrapFunction(
+	std::string const& _name,
+	std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+)
+{
+	std::vector<std::string> arguments;
+	std::vector<std::string> returnParameters;
+	std::string body = _creator(arguments, returnParameters);
+	solAssert(!body.empty(), "");
+
+	return Whiskers(R"(
 			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
 				<body>
 			}
 		)")
-		("functionName", _name)
-		("args", joinHumanReadable(arguments))
-		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
-		.render();
-	}
-	return _name;
+	("functionName", _name)
+	("args", joinHumanReadable(arguments))
+	("retParams", joinHumanReadable(returnParameters))
+	("body", body)
+	.render();
 }
@@ -26,10 +26,34 @@
 #include <map>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Code of Yul functions shared between the function collectors of all contracts of a compilation.
+ * It may only be shared between collectors that use the same EVM version and revert strings
+ * setting, since those are the only settings the cached functions may depend on.
+ */
+class YulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the functions requested while generating the function, in request order.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the cached function called @a _name or nullptr if there is none.
+	Function const* find(std::string const& _name) const;
+	void add(std::string const& _name, Function _function) { m_functions.emplace(_name, std::move(_function)); }
+
+private:
+	std::map<std::string, Function> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -37,9 +61,15 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	/// Takes functions created by createFunction from @a _cache instead of generating them
+	/// again and adds newly generated ones to it.
+	explicit MultiUseYulFunctionCollector(YulFunctionCache* _cache = nullptr): m_cache(_cache) {}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
+	/// The generated code may only depend on @a _name and the EVM version and revert strings
+	/// setting, since it is shared with other contracts through the cache.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
 	std::string createFunction(
@@ -47,6 +77,15 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Variants of createFunction for functions whose code depends on the contract being compiled.
+	/// They are never taken from or added to the cache.
+	std::string createContractFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	std::string createContractFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions in the order in which they were
 	/// generated.
 	/// Clears the internal list, i.e. calling it again will result in an
@@ -57,8 +96,21 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	std::string create(std::string const& _name, bool _cacheable, std::function<std::string()> const& _generate);
+	/// Adds the function called @a _name and all functions it depends on from the cache.
+	/// @returns false if the function or one of its dependencies is not cached.
+	bool addFromCache(std::string const& _name);
+
+	static std::string wrapFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
+	YulFunctionCache* m_cache = nullptr;
 	std::set<std::string> m_requestedFunctions;
 	std::string m_code;
+	/// Names requested while generating each of the functions that are currently being generated.
+	std::vector<std::vector<std::string>> m_dependencyStack;
 };
 
 }
@@ -25,6 +25,7 @@
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
 
 #include <libsolutil/Whiskers.h>
@@ -37,6 +38,62 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// @returns true if @a _type is a memory struct whose members are all value types that are
+/// read from calldata in the same way as from memory.
+bool readableFromCalldata(Type const& _type)
+{
+	auto const* structType = dynamic_cast<StructType const*>(&_type);
+	if (!structType || structType->location() != DataLocation::Memory)
+		return false;
+	for (auto const& member: structType->members(nullptr))
+		if (!member.type->isValueType() || dynamic_cast<FunctionType const*>(member.type))
+			return false;
+	return true;
+}
+
+/// Removes the parameters from the candidates that are used in any other way
+/// than by reading one of their members.
+class ParameterUseChecker: public ASTConstVisitor
+{
+public:
+	explicit ParameterUseChecker(std::set<VariableDeclaration const*>& _candidates): m_candidates(_candidates) {}
+
+	bool visit(MemberAccess const& _memberAccess) override
+	{
+		auto const* identifier = dynamic_cast<Identifier const*>(&_memberAccess.expression());
+		auto const* parameter = identifier ?
+			dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration) :
+			nullptr;
+		if (!parameter || !m_candidates.count(parameter))
+			return true;
+		// Functions attached to the struct type receive the whole struct.
+		if (
+			_memberAccess.annotation().willBeWrittenTo ||
+			!dynamic_cast<VariableDeclaration const*>(_memberAccess.annotation().referencedDeclaration)
+		)
+			m_candidates.erase(parameter);
+		return false;
+	}
+	void endVisit(Identifier const& _identifier) override
+	{
+		m_candidates.erase(dynamic_cast<VariableDeclaration const*>(_identifier.annotation().referencedDeclaration));
+	}
+	bool visit(InlineAssembly const& _inlineAssembly) override
+	{
+		for (auto const& reference: _inlineAssembly.annotation().externalReferences | ranges::views::values)
+			m_candidates.erase(dynamic_cast<VariableDeclaration const*>(reference.declaration));
+		return false;
+	}
+
+private:
+	std::set<VariableDeclaration const*>& m_candidates;
+};
+
+}
+
 std::string IRGenerationContext::enqueueFunctionForCodeGeneration(FunctionDefinition const& _function)
 {
 	std::string name = IRNames::function(_function);
@@ -85,6 +142,26 @@ void IRGenerationContext::resetLocalVariables()
 	m_localVariables.clear();
 }
 
+bool IRGenerationContext::decodedFromCalldata(VariableDeclaration const& _parameter)
+{
+	if (!m_decodeReadOnlyStructsFromCalldata)
+		return false;
+	auto const* function = dynamic_cast<FunctionDefinition const*>(_parameter.scope());
+	if (!function)
+		return false;
+
+	auto [parameters, inserted] = m_parametersDecodedFromCalldata.try_emplace(function);
+	if (inserted && function->visibility() == Visibility::External && function->isImplemented())
+	{
+		for (ASTPointer<VariableDeclaration> const& parameter: function->parameters())
+			if (readableFromCalldata(*parameter->annotation().type))
+				parameters->second.insert(parameter.get());
+		ParameterUseChecker checker{parameters->second};
+		function->accept(checker);
+	}
+	return parameters->second.count(&_parameter);
+}
+
 void IRGenerationContext::registerImmutableVariable(VariableDeclaration const& _variable)
 {
 	solAssert(_variable.immutable(), "Attempted to register a non-immutable variable as immutable.");
@@ -174,5 +251,5 @@ YulUtilFunctions IRGenerationContext::utils()
 
 ABIFunctions IRGenerationContext::abiFunctions()
 {
-	return ABIFunctions(m_evmVersion, m_revertStrings, m_functions);
+	return ABIFunctions(m_evmVersion, m_revertStrings, m_functions, m_copyABIDecodedArrays);
 }
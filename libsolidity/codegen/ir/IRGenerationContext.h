@@ -62,17 +62,26 @@ public:
 		RevertStrings _revertStrings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
-		langutil::CharStreamProvider const* _soliditySourceProvider
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		YulFunctionCache* _functionCache = nullptr,
+		bool _copyABIDecodedArrays = false,
+		bool _decodeReadOnlyStructsFromCalldata = false
 	):
 		m_evmVersion(_evmVersion),
 		m_executionContext(_executionContext),
 		m_revertStrings(_revertStrings),
 		m_sourceIndices(std::move(_sourceIndices)),
+		m_functions(_functionCache),
 		m_debugInfoSelection(_debugInfoSelection),
-		m_soliditySourceProvider(_soliditySourceProvider)
+		m_soliditySourceProvider(_soliditySourceProvider),
+		m_functionCache(_functionCache),
+		m_copyABIDecodedArrays(_copyABIDecodedArrays),
+		m_decodeReadOnlyStructsFromCalldata(_decodeReadOnlyStructsFromCalldata)
 	{}
 
 	MultiUseYulFunctionCollector& functionCollector() { return m_functions; }
+	/// @returns the cache of utility functions shared with other contracts, if any.
+	YulFunctionCache* functionCache() const { return m_functionCache; }
 
 	/// Adds a Solidity function to the function generation queue and returns the name of the
 	/// corresponding Yul function.
@@ -95,6 +104,10 @@ public:
 	bool isLocalVariable(VariableDeclaration const& _varDecl) const { return m_localVariables.count(&_varDecl); }
 	IRVariable const& localVariable(VariableDeclaration const& _varDecl);
 	void resetLocalVariables();
+	/// @returns true if @a _parameter is a memory struct parameter of an external function that is
+	/// left in calldata instead of being decoded into memory, because it is only read member by member,
+	/// see OptimiserSettings::decodeReadOnlyStructsFromCalldata.
+	bool decodedFromCalldata(VariableDeclaration const& _parameter);
 
 	/// Registers an immutable variable of the contract.
 	/// Should only be called at construction time.
@@ -200,6 +213,13 @@ private:
 
 	langutil::DebugInfoSelection m_debugInfoSelection = {};
 	langutil::CharStreamProvider const* m_soliditySourceProvider = nullptr;
+	YulFunctionCache* m_functionCache = nullptr;
+	/// Passed on to the ABI functions, see OptimiserSettings::copyABIDecodedArrays.
+	bool m_copyABIDecodedArrays = false;
+	/// See OptimiserSettings::decodeReadOnlyStructsFromCalldata.
+	bool m_decodeReadOnlyStructsFromCalldata = false;
+	/// Parameters of the already analysed external functions that are decoded from calldata.
+	std::map<FunctionDefinition const*, std::set<VariableDeclaration const*>> m_parametersDecodedFromCalldata;
 };
 
 }
@@ -30,6 +30,8 @@
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <libyul/Object.h>
 #include <libyul/Utilities.h>
 
@@ -41,6 +43,7 @@
 
 #include <range/v3/algorithm/all_of.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <variant>
 
@@ -258,7 +261,7 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 	for (YulArity const& arity: internalDispatchMap | ranges::views::keys)
 	{
 		std::string funName = IRNames::internalDispatch(arity);
-		m_context.functionCollector().createFunction(funName, [&]() {
+		m_context.functionCollector().createContractFunction(funName, [&]() {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>(fun<?+in>, <in></+in>) <?+out>-> <out></+out> {
@@ -318,7 +321,7 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 std::string IRGenerator::generateFunction(FunctionDefinition const& _function)
 {
 	std::string functionName = IRNames::function(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -389,7 +392,7 @@ std::string IRGenerator::generateModifier(
 )
 {
 	std::string functionName = IRNames::modifierInvocation(_modifierInvocation);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -481,7 +484,7 @@ std::string IRGenerator::generateModifier(
 std::string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const& _function)
 {
 	std::string functionName = IRNames::functionWithModifierInner(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<sourceLocationComment>
@@ -521,7 +524,7 @@ std::string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition co
 std::string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 {
 	std::string functionName = IRNames::function(_varDecl);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		Type const* type = _varDecl.annotation().type;
 
 		solAssert(_varDecl.isStateVariable(), "");
@@ -714,10 +717,11 @@ std::string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 std::string IRGenerator::generateExternalFunction(ContractDefinition const& _contract, FunctionType const& _functionType)
 {
 	std::string functionName = IRNames::externalFunctionABIWrapper(_functionType.declaration());
-	return m_context.functionCollector().createFunction(functionName, [&](std::vector<std::string>&, std::vector<std::string>&) -> std::string {
+	return m_context.functionCollector().createContractFunction(functionName, [&](std::vector<std::string>&, std::vector<std::string>&) -> std::string {
 		Whiskers t(R"X(
 			<callValueCheck>
 			<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
+			<validateParameters>
 			<?+retParams>let <retParams> := </+retParams> <function>(<params>)
 			let memPos := <allocateUnbounded>()
 			let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
@@ -728,12 +732,45 @@ std::string IRGenerator::generateExternalFunction(ContractDefinition const& _con
 		unsigned paramVars = std::make_shared<TupleType>(_functionType.parameterTypes())->sizeOnStack();
 		unsigned retVars = std::make_shared<TupleType>(_functionType.returnParameterTypes())->sizeOnStack();
 
-		ABIFunctions abiFunctions(m_evmVersion, m_context.revertStrings(), m_context.functionCollector());
-		t("abiDecode", abiFunctions.tupleDecoder(_functionType.parameterTypes()));
+		// Struct parameters that are only read member by member are left in calldata. All their members
+		// are validated nevertheless, so that invalid input reverts in the same way as if they were decoded.
+		TypePointers parameterTypes = _functionType.parameterTypes();
+		std::string validateParameters;
+		FunctionDefinition const* funDef = dynamic_cast<FunctionDefinition const*>(&_functionType.declaration());
+		if (funDef)
+		{
+			solAssert(funDef->parameters().size() == parameterTypes.size());
+			size_t stackOffset = 0;
+			for (size_t i = 0; i < parameterTypes.size(); ++i)
+			{
+				if (m_context.decodedFromCalldata(*funDef->parameters()[i]))
+				{
+					auto const* structType = TypeProvider::withLocation(
+						dynamic_cast<StructType const*>(parameterTypes[i]),
+						DataLocation::CallData,
+						true
+					);
+					solAssert(structType && structType->sizeOnStack() == 1);
+					std::string parameter = "param_" + std::to_string(stackOffset);
+					for (auto const& member: dynamic_cast<StructType const&>(*structType).members(nullptr))
+						validateParameters +=
+							m_utils.validatorFunction(*member.type, true) +
+							"(calldataload(add(" + parameter + ", " +
+							std::to_string(dynamic_cast<StructType const&>(*structType).calldataOffsetOfMember(member.name)) +
+							")))\n";
+					parameterTypes[i] = structType;
+				}
+				stackOffset += parameterTypes[i]->sizeOnStack();
+			}
+		}
+		t("validateParameters", validateParameters);
+
+		ABIFunctions abiFunctions = m_context.abiFunctions();
+		t("abiDecode", abiFunctions.tupleDecoder(parameterTypes));
 		t("params",  suffixedVariableNameList("param_", 0, paramVars));
 		t("retParams",  suffixedVariableNameList("ret_", 0, retVars));
 
-		if (FunctionDefinition const* funDef = dynamic_cast<FunctionDefinition const*>(&_functionType.declaration()))
+		if (funDef)
 		{
 			solAssert(!funDef->isConstructor());
 			t("function", m_context.enqueueFunctionForCodeGeneration(*funDef));
@@ -851,7 +888,7 @@ void IRGenerator::generateConstructors(ContractDefinition const& _contract)
 		baseConstructorParams.erase(contract);
 
 		m_context.resetLocalVariables();
-		m_context.functionCollector().createFunction(IRNames::constructor(*contract), [&]() {
+		m_context.functionCollector().createContractFunction(IRNames::constructor(*contract), [&]() {
 			Whiskers t(R"(
 				<astIDComment><sourceLocationComment>
 				function <functionName>(<params><comma><baseParams>) {
@@ -980,13 +1017,67 @@ std::string IRGenerator::callValueCheck()
 	return "if callvalue() { " + m_utils.revertReasonIfDebugFunction("Ether sent to non-payable function") + "() }";
 }
 
-std::string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
+std::string IRGenerator::selectorSwitch(std::vector<std::map<std::string, std::string>> const& _cases)
 {
-	Whiskers t(R"X(
-		<?+cases>if iszero(lt(calldatasize(), 4))
+	auto callCount = [&](std::map<std::string, std::string> const& _case) {
+		return util::valueOrDefault(m_optimiserSettings.executionProfile, _case.at("functionName"), size_t(0));
+	};
+
+	// Like ContractCompiler::appendInternalSelector, checks a function that receives at least
+	// half of the calls according to the execution profile first.
+	if (_cases.size() > 1)
+	{
+		size_t totalCalls = 0;
+		for (auto const& functionCase: _cases)
+			totalCalls += callCount(functionCase);
+		auto hottest = std::max_element(_cases.begin(), _cases.end(), [&](auto const& _a, auto const& _b) {
+			return callCount(_a) < callCount(_b);
+		});
+		if (totalCalls > 0 && callCount(*hottest) >= totalCalls - callCount(*hottest))
 		{
-			let selector := <shr224>(calldataload(0))
-			switch selector
+			std::vector<std::map<std::string, std::string>> others;
+			for (auto it = _cases.begin(); it != _cases.end(); ++it)
+				if (it != hottest)
+					others.emplace_back(*it);
+			return Whiskers(R"X(switch selector
+				case <functionSelector>
+				{
+					// <functionName>
+					<delegatecallCheck>
+					<externalFunction>()
+				}
+				default
+				{
+					<others>
+				})X")
+				("functionSelector", hottest->at("functionSelector"))
+				("functionName", hottest->at("functionName"))
+				("delegatecallCheck", hottest->at("delegatecallCheck"))
+				("externalFunction", hottest->at("externalFunction"))
+				("others", selectorSwitch(others))
+				.render();
+		}
+	}
+
+	// Uses the same cost model as ContractCompiler::appendInternalSelector: splitting the
+	// cases at a pivot costs about 17 bytes of code and saves 6 gas per case and call.
+	size_t const runs = m_optimiserSettings.expectedExecutionsPerDeployment;
+	bool split = false;
+	if (!m_optimiserSettings.splitSelectorSwitch || _cases.size() <= 4)
+		split = false;
+	else if (runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		split = true;
+	else
+		split = (runs * 6 * (_cases.size() - 4) > 17 * evmasm::GasCosts::createDataGas);
+
+	if (!split)
+	{
+		// Functions that are called more often are checked first.
+		std::vector<std::map<std::string, std::string>> cases = _cases;
+		std::stable_sort(cases.begin(), cases.end(), [&](auto const& _a, auto const& _b) {
+			return callCount(_a) > callCount(_b);
+		});
+		return Whiskers(R"X(switch selector
 			<#cases>
 			case <functionSelector>
 			{
@@ -995,8 +1086,36 @@ std::string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 				<externalFunction>()
 			}
 			</cases>
-			default {}
-		}</+cases>
+			default {})X")
+			("cases", cases)
+			.render();
+	}
+
+	// The cases are sorted by selector, so the pivot splits them into two halves.
+	auto const pivot = _cases.begin() + static_cast<ptrdiff_t>(_cases.size() / 2);
+	return Whiskers(R"X(switch lt(selector, <pivot>)
+			case 0
+			{
+				<larger>
+			}
+			default
+			{
+				<smaller>
+			})X")
+		("pivot", pivot->at("functionSelector"))
+		("larger", selectorSwitch({pivot, _cases.end()}))
+		("smaller", selectorSwitch({_cases.begin(), pivot}))
+		.render();
+}
+
+std::string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
+{
+	Whiskers t(R"X(
+		<?+selectorSwitch>if iszero(lt(calldatasize(), 4))
+		{
+			let selector := <shr224>(calldataload(0))
+			<selectorSwitch>
+		}</+selectorSwitch>
 		<?+receiveEther>if iszero(calldatasize()) { <receiveEther> }</+receiveEther>
 		<fallback>
 	)X");
@@ -1025,7 +1144,7 @@ std::string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 
 		templ["externalFunction"] = generateExternalFunction(_contract, *type);
 	}
-	t("cases", functions);
+	t("selectorSwitch", functions.empty() ? "" : selectorSwitch(functions));
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
 	{
@@ -1099,7 +1218,10 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 		m_context.revertStrings(),
 		m_context.sourceIndices(),
 		m_context.debugInfoSelection(),
-		m_context.soliditySourceProvider()
+		m_context.soliditySourceProvider(),
+		m_context.functionCache(),
+		m_optimiserSettings.copyABIDecodedArrays,
+		m_optimiserSettings.decodeReadOnlyStructsFromCalldata
 	);
 	m_context = std::move(newContext);
 
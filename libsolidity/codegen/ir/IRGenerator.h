@@ -53,7 +53,8 @@ public:
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider,
-		OptimiserSettings& _optimiserSettings
+		OptimiserSettings& _optimiserSettings,
+		YulFunctionCache* _functionCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_eofVersion(_eofVersion),
@@ -63,7 +64,10 @@ public:
 			_revertStrings,
 			std::move(_sourceIndices),
 			_debugInfoSelection,
-			_soliditySourceProvider
+			_soliditySourceProvider,
+			_functionCache,
+			_optimiserSettings.copyABIDecodedArrays,
+			_optimiserSettings.decodeReadOnlyStructsFromCalldata
 		),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector()),
 		m_optimiserSettings(_optimiserSettings)
@@ -130,6 +134,10 @@ private:
 	std::string callValueCheck();
 
 	std::string dispatchRoutine(ContractDefinition const& _contract);
+	/// @returns a switch over the variable `selector` that runs the code of the matching entry
+	/// of @a _cases, which have to be sorted by selector, and does nothing if none matches.
+	/// Large switches are split into a binary search if OptimiserSettings::splitSelectorSwitch is set.
+	std::string selectorSwitch(std::vector<std::map<std::string, std::string>> const& _cases);
 
 	/// @a _useMemoryGuard If true, use a memory guard, allowing the optimiser
 	/// to perform memory optimizations.
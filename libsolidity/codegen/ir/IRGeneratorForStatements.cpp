@@ -345,7 +345,7 @@ std::string IRGeneratorForStatements::constantValueFunction(VariableDeclaration
 	try
 	{
 		std::string functionName = IRNames::constantValueFunction(_constant);
-		return m_context.functionCollector().createFunction(functionName, [&] {
+		return m_context.functionCollector().createContractFunction(functionName, [&] {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>() -> <ret> {
@@ -1121,14 +1121,28 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 			}
 		}
 		solAssert(indexedArgs.size() <= 4, "Too many indexed arguments.");
+		// The indexed arguments are already evaluated, so small static data can be
+		// encoded into the scratch space.
+		bool useScratchSpace =
+			m_optimiserSettings.encodeEventDataInScratchSpace &&
+			CompilerUtils::abiEncodingFitsIntoScratchSpace(nonIndexedParamTypes);
 		Whiskers templ(R"({
-			let <pos> := <allocateUnbounded>()
-			let <end> := <encode>(<pos> <nonIndexedArgs>)
-			<log>(<pos>, sub(<end>, <pos>) <indexedArgs>)
+			<?useScratchSpace>
+				let <end> := <encode>(0 <nonIndexedArgs>)
+				<log>(0, <end> <indexedArgs>)
+			<!useScratchSpace>
+				let <pos> := <allocateUnbounded>()
+				let <end> := <encode>(<pos> <nonIndexedArgs>)
+				<log>(<pos>, sub(<end>, <pos>) <indexedArgs>)
+			</useScratchSpace>
 		})");
-		templ("pos", m_context.newYulVariable());
+		templ("useScratchSpace", useScratchSpace);
+		if (!useScratchSpace)
+		{
+			templ("pos", m_context.newYulVariable());
+			templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
+		}
 		templ("end", m_context.newYulVariable());
-		templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
 		templ("encode", abi.tupleEncoder(nonIndexedArgTypes, nonIndexedParamTypes));
 		templ("nonIndexedArgs", joinHumanReadablePrefixed(nonIndexedArgs));
 		templ("log", "log" + std::to_string(indexedArgs.size()));
@@ -2027,6 +2041,22 @@ void IRGeneratorForStatements::endVisit(MemberAccess const& _memberAccess)
 		}
 		case DataLocation::Memory:
 		{
+			if (auto const* identifier = dynamic_cast<Identifier const*>(&_memberAccess.expression()))
+				if (auto const* parameter = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration))
+					if (m_context.decodedFromCalldata(*parameter))
+					{
+						// The parameter holds the calldata offset of the struct and the member is only read.
+						solAssert(!_memberAccess.annotation().willBeWrittenTo);
+						auto const* calldataType = TypeProvider::withLocation(&structType, DataLocation::CallData, true);
+						define(_memberAccess) <<
+							m_utils.readFromCalldata(*_memberAccess.annotation().type) <<
+							"(add(" <<
+							expression.part("mpos").name() <<
+							", " <<
+							std::to_string(dynamic_cast<StructType const&>(*calldataType).calldataOffsetOfMember(member)) <<
+							"))\n";
+						break;
+					}
 			std::string pos = m_context.newYulVariable();
 			appendCode() << "let " << pos << " := " <<
 				("add(" + expression.part("mpos").name() + ", " + structType.memoryOffsetOfMember(member).str() + ")\n");
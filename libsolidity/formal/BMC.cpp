@@ -30,6 +30,9 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
 
+#include <libsolutil/Cancellation.h>
+#include <libsolutil/Profiler.h>
+
 #include <utility>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -65,7 +68,7 @@ BMC::BMC(
 	if (_settings.solvers.z3 && Z3Interface::available())
 		solvers.emplace_back(std::make_unique<Z3Interface>(_settings.timeout));
 #endif
-	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout);
+	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout, _settings.raceSolvers);
 #if defined (HAVE_Z3)
 	if (m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -1133,9 +1136,18 @@ void BMC::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
+	util::Profiler::Scope profilerScope(
+		"BMC query",
+		"smtchecker",
+		{
+			{"target", ModelCheckerTargets::targetTypeToString.at(_target.type)},
+			{"location", (_location.sourceName ? *_location.sourceName : "") + ":" + std::to_string(_location.start)}
+		}
+	);
 	smtutil::CheckResult result;
 	std::vector<std::string> values;
 	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	profilerScope.setArgument("result", smtutil::toString(result));
 
 	std::string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -1269,6 +1281,7 @@ void BMC::checkBooleanNotConstant(
 std::pair<smtutil::CheckResult, std::vector<std::string>>
 BMC::checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate)
 {
+	util::CancellationToken::check();
 	smtutil::CheckResult result;
 	std::vector<std::string> values;
 	try
@@ -1282,6 +1295,7 @@ BMC::checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _e
 				"BMC: Requested query:\n" + smtlibCode
 			);
 		}
+		util::Profiler::count("BMC queries");
 		tie(result, values) = m_interface->check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
@@ -36,6 +36,8 @@
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Cancellation.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/StringUtils.h>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -109,10 +111,13 @@ void CHC::analyze(SourceUnit const& _source)
 	createFreeConstants(sources);
 	state().prepareForSourceUnit(_source, encodeExternalCallsAsTrusted());
 
-	for (auto const* source: sources)
-		defineInterfacesAndSummaries(*source);
-	for (auto const* source: sources)
-		source->accept(*this);
+	{
+		util::Profiler::Scope profilerScope("CHC encoding", "smtchecker");
+		for (auto const* source: sources)
+			defineInterfacesAndSummaries(*source);
+		for (auto const* source: sources)
+			source->accept(*this);
+	}
 
 	checkVerificationTargets();
 
@@ -1918,6 +1923,7 @@ void CHC::addRule(smtutil::Expression const& _rule, std::string const& _ruleName
 
 CHCSolverInterface::QueryResult CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
 {
+	util::CancellationToken::check();
 	if (m_settings.printQuery)
 	{
 		auto smtLibInterface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
@@ -1928,6 +1934,7 @@ CHCSolverInterface::QueryResult CHC::query(smtutil::Expression const& _query, la
 			"CHC: Requested query:\n" + smtLibCode
 		);
 	}
+	util::Profiler::count("CHC queries");
 	auto result = m_interface->query(_query);
 	switch (result.answer)
 	{
@@ -1959,15 +1966,21 @@ CHCSolverInterface::QueryResult CHC::query(smtutil::Expression const& _query, la
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
-		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
 	case CheckResult::ERROR:
-		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
+		reportFailedQuery(result.answer, _location);
 		break;
 	}
 	return result;
 }
 
+void CHC::reportFailedQuery(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	if (_result == CheckResult::CONFLICTING)
+		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+	else if (_result == CheckResult::ERROR)
+		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
+}
+
 void CHC::verificationTargetEncountered(
 	ASTNode const* const _errorNode,
 	VerificationTargetType _type,
@@ -2068,12 +2081,19 @@ void CHC::checkVerificationTargets()
 	}
 
 	std::set<unsigned> checkedErrorIds;
+	// Only solvers called via SMT-LIB2 can answer several queries at the same time.
+	auto* smtlib2Interface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
+	bool const parallel = m_settings.chcThreads > 1 && smtlib2Interface;
+	if (parallel)
+		checkVerificationTargetsInParallel(targetEntryPoints, *smtlib2Interface);
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
 		auto const& target = m_verificationTargets.at(targetId);
-		auto [errorType, errorReporterId] = targetDescription(target);
-
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		if (!parallel)
+		{
+			auto [errorType, errorReporterId] = targetDescription(target);
+			checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		}
 		checkedErrorIds.insert(target.errorId);
 	}
 
@@ -2196,9 +2216,88 @@ void CHC::checkAndReportTarget(
 	std::string _unknownMsg
 )
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
+	if (isUnsafe(_target))
 		return;
 
+	util::Profiler::Scope profilerScope("CHC query", "smtchecker", targetProfilerArguments(_target));
+	encodeTargetQuery(_target, _placeholders);
+	auto result = query(error(), _target.errorNode->location());
+	profilerScope.setArgument("result", smtutil::toString(result.answer));
+	reportTarget(
+		_target,
+		result,
+		error().name,
+		_errorReporterId,
+		std::move(_satMsg),
+		std::move(_unknownMsg)
+	);
+}
+
+void CHC::checkVerificationTargetsInParallel(
+	std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints,
+	CHCSmtLib2Interface& _solver
+)
+{
+	// The queries of the targets only differ in their error predicate, so the solver can
+	// answer them independently. Encode them in order, solve them in any order and report
+	// them in order again, so that the output is the same as if they were checked one by one.
+	std::vector<std::string> queries;
+	std::vector<std::string> errorNames;
+	for (auto const& [targetId, placeholders]: _targetEntryPoints)
+	{
+		encodeTargetQuery(m_verificationTargets.at(targetId), placeholders);
+		queries.emplace_back(_solver.dumpQuery(error()));
+		errorNames.emplace_back(error().name);
+		if (m_settings.printQuery)
+			m_errorReporter.info(
+				2339_error,
+				"CHC: Requested query:\n" + queries.back()
+			);
+	}
+
+	std::vector<CHCSolverInterface::QueryResult> results;
+	{
+		util::Profiler::Scope profilerScope(
+			"CHC queries",
+			"smtchecker",
+			{{"targets", std::to_string(queries.size())}, {"threads", std::to_string(m_settings.chcThreads)}}
+		);
+		results = _solver.queryAll(queries, m_settings.chcThreads);
+	}
+
+	size_t index = 0;
+	for (auto const& [targetId, placeholders]: _targetEntryPoints)
+	{
+		auto const& target = m_verificationTargets.at(targetId);
+		auto const& result = results.at(index);
+		auto const& errorName = errorNames.at(index);
+		++index;
+		// A previous target for the same node and type may have been found unsafe in the meantime.
+		if (isUnsafe(target))
+			continue;
+
+		reportFailedQuery(result.answer, target.errorNode->location());
+		auto [errorType, errorReporterId] = targetDescription(target);
+		reportTarget(target, result, errorName, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+	}
+}
+
+std::map<std::string, std::string> CHC::targetProfilerArguments(CHCVerificationTarget const& _target) const
+{
+	auto const& location = _target.errorNode->location();
+	return {
+		{"target", ModelCheckerTargets::targetTypeToString.at(_target.type)},
+		{"location", (location.sourceName ? *location.sourceName : "") + ":" + std::to_string(location.start)}
+	};
+}
+
+bool CHC::isUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
+void CHC::encodeTargetQuery(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -2206,8 +2305,19 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	CHCSolverInterface::QueryResult const& _result,
+	std::string const& _errorName,
+	ErrorId _errorReporterId,
+	std::string _satMsg,
+	std::string _unknownMsg
+)
+{
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+	auto const& [result, invariant, model] = _result;
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target);
@@ -2223,7 +2333,7 @@ void CHC::checkAndReportTarget(
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(model, _errorName);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
@@ -37,6 +37,7 @@
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/CHCSmtLib2Interface.h>
 #include <libsmtutil/CHCSolverInterface.h>
 
 #include <liblangutil/SourceLocation.h>
@@ -297,6 +298,8 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	smtutil::CHCSolverInterface::QueryResult query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Warns if the solvers failed to answer a query or gave conflicting answers.
+	void reportFailedQuery(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -310,6 +313,26 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Checks all targets at once, sending up to m_settings.chcThreads queries to the solver at the same time.
+	void checkVerificationTargetsInParallel(
+		std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints,
+		smtutil::CHCSmtLib2Interface& _solver
+	);
+	/// @returns the arguments describing @a _target in the profiler trace.
+	std::map<std::string, std::string> targetProfilerArguments(CHCVerificationTarget const& _target) const;
+	/// @returns true if a target for the same node and of the same type was already found unsafe.
+	bool isUnsafe(CHCVerificationTarget const& _target) const;
+	/// Creates a new error block that is reachable if and only if @a _target can fail.
+	void encodeTargetQuery(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders);
+	/// Records the outcome of the query for @a _target, whose error block is called @a _errorName.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		smtutil::CHCSolverInterface::QueryResult const& _result,
+		std::string const& _errorName,
+		langutil::ErrorId _errorReporterId,
+		std::string _satMsg,
+		std::string _unknownMsg
+	);
 
 	std::pair<std::string, langutil::ErrorId> targetDescription(CHCVerificationTarget const& _target);
 
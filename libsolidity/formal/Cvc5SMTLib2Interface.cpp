@@ -29,6 +29,12 @@ Cvc5SMTLib2Interface::Cvc5SMTLib2Interface(
 {
 }
 
+void Cvc5SMTLib2Interface::interrupt()
+{
+	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+		universalCallback->smtCommand().interrupt();
+}
+
 void Cvc5SMTLib2Interface::setupSmtCallback() {
 	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
 		universalCallback->smtCommand().setCvc5(m_queryTimeout);
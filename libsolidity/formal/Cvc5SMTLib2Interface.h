@@ -30,6 +30,8 @@ public:
 		frontend::ReadCallback::Callback _smtCallback = {},
 		std::optional<unsigned> _queryTimeout = {}
 	);
+
+	void interrupt() override;
 private:
 	void setupSmtCallback() override;
 };
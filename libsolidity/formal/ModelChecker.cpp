@@ -24,6 +24,8 @@
 #include <z3_version.h>
 #endif
 
+#include <libsolutil/Profiler.h>
+
 #include <boost/process.hpp>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -121,7 +123,10 @@ void ModelChecker::analyze(SourceUnit const& _source)
 		return;
 
 	if (m_settings.engine.chc)
+	{
+		util::Profiler::Scope profilerScope("CHC", "smtchecker", {{"source", *_source.annotation().path}});
 		m_chc.analyze(_source);
+	}
 
 	std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> solvedTargets;
 
@@ -133,7 +138,10 @@ void ModelChecker::analyze(SourceUnit const& _source)
 		solvedTargets[node] += targets | ranges::views::keys;
 
 	if (m_settings.engine.bmc)
+	{
+		util::Profiler::Scope profilerScope("BMC", "smtchecker", {{"source", *_source.annotation().path}});
 		m_bmc.analyze(_source, solvedTargets);
+	}
 
 	if (m_settings.showUnsupported)
 	{
@@ -158,6 +158,8 @@ struct ModelCheckerExtCalls
 struct ModelCheckerSettings
 {
 	std::optional<unsigned> bmcLoopIterations;
+	/// Maximum number of CHC queries sent to solvers called via SMT-LIB2 at the same time.
+	unsigned chcThreads = 1;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
@@ -170,6 +172,9 @@ struct ModelCheckerSettings
 	ModelCheckerExtCalls externalCalls = {};
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
 	bool printQuery = false;
+	/// Run the BMC solvers in parallel and take the first conclusive answer
+	/// instead of querying them one after the other.
+	bool raceSolvers = false;
 	bool showProvedSafe = false;
 	bool showUnproved = false;
 	bool showUnsupported = false;
@@ -182,12 +187,14 @@ struct ModelCheckerSettings
 	{
 		return
 			bmcLoopIterations == _other.bmcLoopIterations &&
+			chcThreads == _other.chcThreads &&
 			contracts == _other.contracts &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
 			invariants == _other.invariants &&
 			printQuery == _other.printQuery &&
+			raceSolvers == _other.raceSolvers &&
 			showProvedSafe == _other.showProvedSafe &&
 			showUnproved == _other.showUnproved &&
 			showUnsupported == _other.showUnsupported &&
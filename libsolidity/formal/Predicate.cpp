@@ -38,7 +38,7 @@ using namespace solidity::smtutil;
 using namespace solidity::frontend;
 using namespace solidity::frontend::smt;
 
-std::map<std::string, Predicate> Predicate::m_predicates;
+thread_local std::map<std::string, Predicate> Predicate::m_predicates;
 
 Predicate const* Predicate::create(
 	SortPointer _sort,
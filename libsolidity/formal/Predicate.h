@@ -216,7 +216,8 @@ private:
 
 	/// Maps the name of the predicate to the actual Predicate.
 	/// Used in counterexample generation.
-	static std::map<std::string, Predicate> m_predicates;
+	/// Per thread, so that compilations on different threads do not share predicates.
+	static thread_local std::map<std::string, Predicate> m_predicates;
 
 	/// The scope stack when the predicate was created.
 	/// Used to identify the subset of variables in scope.
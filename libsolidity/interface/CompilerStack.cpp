@@ -52,7 +52,9 @@
 #include <libsolidity/interface/ABI.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
+#include <libsolidity/interface/StorageAccess.h>
 #include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/interface/StorageLayoutSuggestion.h>
 #include <libsolidity/interface/UniversalCallback.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
@@ -73,6 +75,7 @@
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
 #include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -84,6 +87,8 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -93,8 +98,15 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <future>
 #include <utility>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <limits>
 #include <string>
 
@@ -107,22 +119,83 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
+namespace
+{
+/// TypeProviders used by existing CompilerStacks, nullptr standing for the global one.
+std::set<TypeProvider const*> g_typeProvidersInUse;
+std::mutex g_typeProvidersInUseMutex;
+
+/// Maximum number of compilations of a contract while searching for the number of runs that meets
+/// the code size target, not counting the compilations with the original number of runs and with one run.
+size_t constexpr c_maxCodeSizeTargetAttempts = 8;
+
+/// Calls @a _compile, which compiles a contract with the given settings and returns the size of its
+/// runtime code. If the code size target of @a _settings is not met, searches for the largest number
+/// of runs that meets it, assuming that the code does not get smaller for more runs. If even a single
+/// run does not meet it, the code for a single run is kept. The last call always uses the chosen settings.
+void compileForCodeSizeTarget(
+	OptimiserSettings const& _settings,
+	std::function<size_t(OptimiserSettings const&)> const& _compile
+)
+{
+	if (!_settings.codeSizeTarget)
+	{
+		_compile(_settings);
+		return;
+	}
+
+	OptimiserSettings settings = _settings;
+	if (!settings.inlinerCodeSizeLimit)
+		settings.inlinerCodeSizeLimit = settings.codeSizeTarget;
+	auto fits = [&](size_t _runs) {
+		settings.expectedExecutionsPerDeployment = _runs;
+		return _compile(settings) <= *_settings.codeSizeTarget;
+	};
+
+	size_t const maxRuns = _settings.expectedExecutionsPerDeployment;
+	if (fits(maxRuns) || maxRuns <= 1 || !fits(1))
+		return;
+
+	// The code fits for `low` runs, but not for `high` runs. Decisions based on the number of runs
+	// roughly depend on its order of magnitude, so the interval is split at its geometric mean.
+	size_t low = 1;
+	size_t high = maxRuns;
+	size_t lastCompiled = low;
+	for (size_t attempt = 0; attempt < c_maxCodeSizeTargetAttempts && high - low > 1; ++attempt)
+	{
+		size_t middle = static_cast<size_t>(std::sqrt(static_cast<double>(low) * static_cast<double>(high)));
+		middle = std::clamp(middle, low + 1, high - 1);
+		lastCompiled = middle;
+		if (fits(middle))
+			low = middle;
+		else
+			high = middle;
+	}
+	if (lastCompiled != low)
+		fits(low);
+}
+}
 
-CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+CompilerStack::CompilerStack(ReadCallback::Callback _readFile, std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer):
 	m_readFile{std::move(_readFile)},
-	m_objectOptimizer(std::make_shared<yul::ObjectOptimizer>()),
+	m_objectOptimizer(_objectOptimizer ? std::move(_objectOptimizer) : std::make_shared<yul::ObjectOptimizer>()),
+	m_typeProvider(TypeProvider::active()),
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
+	// Because the TypeProvider API is static, we must ensure that no more than one entity is
+	// actually using a TypeProvider at a time. CompilerStacks on different threads can run
+	// concurrently if each of them has its own TypeProvider activated.
+	std::lock_guard lock(g_typeProvidersInUseMutex);
+	solAssert(g_typeProvidersInUse.insert(m_typeProvider).second, "You shall not have another CompilerStack aside me.");
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
+	{
+		std::lock_guard lock(g_typeProvidersInUseMutex);
+		g_typeProvidersInUse.erase(m_typeProvider);
+	}
+	TypeProvider::Activation typeProviderActivation(m_typeProvider);
 	TypeProvider::reset();
 }
 
@@ -222,12 +295,39 @@ void CompilerStack::setRemappings(std::vector<ImportRemapper::Remapping> _remapp
 	m_importRemapper.setRemappings(std::move(_remappings));
 }
 
+void CompilerStack::setBatchReadCallback(ReadCallback::BatchCallback _batchReadFile)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must set the batch read callback before parsing.");
+	m_batchReadFile = std::move(_batchReadFile);
+}
+
 void CompilerStack::setViaIR(bool _viaIR)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set viaIR before parsing.");
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setNumThreads(size_t _numThreads)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the number of threads before compiling.");
+	solAssert(_numThreads > 0);
+	m_numThreads = _numThreads;
+}
+
+void CompilerStack::setCacheDirectory(std::optional<boost::filesystem::path> _cacheDirectory)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the cache directory before compiling.");
+	m_cacheDirectory = std::move(_cacheDirectory);
+	m_objectOptimizer->setPersistentCacheDirectory(m_cacheDirectory, VersionString);
+}
+
+void CompilerStack::setIncrementalAnalysis(bool _incrementalAnalysis)
+{
+	m_incrementalAnalysis = _incrementalAnalysis;
+	if (!m_incrementalAnalysis)
+		discardAnalysisSnapshot();
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set EVM version before parsing.");
@@ -250,6 +350,12 @@ void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 	m_modelCheckerSettings = _settings;
 }
 
+void CompilerStack::setModelCheckerAllowed(bool _allowed)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must allow or prevent model checking before parsing.");
+	m_modelCheckerAllowed = _allowed;
+}
+
 void CompilerStack::selectContracts(ContractSelection const& _selectedContracts)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must request outputs before parsing.");
@@ -308,8 +414,15 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, std::string const& _re
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	if (_keepSettings && m_incrementalAnalysis)
+		storeAnalysisSnapshot();
+	else
+		m_analysisSnapshot.reset();
+
 	m_stackState = Empty;
+	m_analysisReused = false;
 	m_sources.clear();
+	m_yulFunctionCache.reset();
 	m_maxAstId.reset();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
@@ -318,9 +431,14 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_numThreads = 1;
+		m_cacheDirectory.reset();
+		m_objectOptimizer->setPersistentCacheDirectory(std::nullopt);
+		m_incrementalAnalysis = false;
 		m_evmVersion = langutil::EVMVersion();
 		m_eofVersion.reset();
 		m_modelCheckerSettings = ModelCheckerSettings{};
+		m_modelCheckerAllowed = true;
 		m_selectedContracts.clear();
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
@@ -333,23 +451,51 @@ void CompilerStack::reset(bool _keepSettings)
 	m_experimentalAnalysis.reset();
 	m_globalContext.reset();
 	m_sourceOrder.clear();
+	m_analysisErrors.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	// Types refer to the declarations they were created for, so they must stay valid as long
+	// as the snapshot of the analysis does.
+	if (!m_analysisSnapshot)
+		TypeProvider::reset();
 }
 
 void CompilerStack::setSources(StringMap _sources)
 {
 	solAssert(m_stackState != SourcesSet, "Cannot change sources once set.");
 	solAssert(m_stackState == Empty, "Must set sources before parsing.");
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].charStream = std::make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
 	m_stackState = SourcesSet;
 }
 
+namespace
+{
+
+/// A source unit parsed by a parser of its own, which assigns node IDs starting from one.
+struct SeparatelyParsedSource
+{
+	/// Reports diagnostics to an error list of its own, which allows parsing on another thread.
+	SeparatelyParsedSource(EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion):
+		parser(ownErrorReporter, _evmVersion, _eofVersion)
+	{}
+	SeparatelyParsedSource(EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion, ErrorReporter& _errorReporter):
+		parser(_errorReporter, _evmVersion, _eofVersion)
+	{}
+
+	ErrorList errors;
+	ErrorReporter ownErrorReporter{errors};
+	solidity::frontend::Parser parser;
+	ASTPointer<SourceUnit> ast;
+};
+
+}
+
 bool CompilerStack::parse()
 {
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
+	discardAnalysisSnapshot();
+	util::Profiler::Scope profilerScope("Parsing", "compiler");
 	m_errorReporter.clear();
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
@@ -363,11 +509,74 @@ bool CompilerStack::parse()
 		for (auto const& s: m_sources)
 			sourcesToParse.push_back(s.first);
 
+		// With multiple threads, all sources known at a time form a wavefront that is parsed
+		// concurrently, while imports are still resolved on this thread in the original order.
+		std::optional<util::ThreadPool> threadPool;
+		if (m_numThreads > 1)
+			threadPool.emplace(m_numThreads);
+		std::map<size_t, std::future<std::unique_ptr<SeparatelyParsedSource>>> concurrentlyParsedSources;
+		size_t wavefrontEnd = 0;
+		// Imports of the current wavefront, loaded in advance by the batch read callback.
+		std::map<std::string, ReadCallback::Result> prefetchedSources;
+		// Sources parsed by separate parsers get their node IDs shifted to follow this one.
+		int64_t maxAstId = 0;
+
 		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			std::string const& path = sourcesToParse[i];
+			if (i == wavefrontEnd)
+			{
+				wavefrontEnd = sourcesToParse.size();
+				if (m_batchReadFile && m_stopAfter >= ParsedAndImported)
+					prefetchMissingSources(
+						std::vector<std::string>(sourcesToParse.begin() + static_cast<std::ptrdiff_t>(i), sourcesToParse.end()),
+						prefetchedSources
+					);
+
+				std::set<std::string> scheduledPaths;
+				if (threadPool)
+					for (size_t j = i; j < wavefrontEnd; ++j)
+						// A path can occur repeatedly. Its later occurrences are parsed on this
+						// thread, from whatever source is stored under the path by then.
+						if (wavefrontEnd - i > 1 && scheduledPaths.insert(sourcesToParse[j]).second)
+							concurrentlyParsedSources[j] = threadPool->submit(
+								[evmVersion = m_evmVersion, eofVersion = m_eofVersion, charStream = m_sources.at(sourcesToParse[j]).charStream]() {
+									auto parsed = std::make_unique<SeparatelyParsedSource>(evmVersion, eofVersion);
+									parsed->parser.enableNodeIDShifting();
+									parsed->ast = parsed->parser.parse(*charStream);
+									return parsed;
+								}
+							);
+			}
+
+			std::string const path = sourcesToParse[i];
 			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
+			if (!threadPool)
+				source.ast = parser.parse(*source.charStream);
+			else
+			{
+				std::unique_ptr<SeparatelyParsedSource> parsed;
+				if (auto scheduled = concurrentlyParsedSources.extract(i))
+					try
+					{
+						parsed = scheduled.mapped().get();
+					}
+					catch (...)
+					{
+						// The exception is thrown again when parsing the source below.
+					}
+
+				// Sources with diagnostics are parsed again on this thread, so that the diagnostics
+				// are reported in the same order and subject to the same limits as in a sequential run.
+				if (!parsed || !parsed->errors.empty())
+				{
+					parsed = std::make_unique<SeparatelyParsedSource>(m_evmVersion, m_eofVersion, m_errorReporter);
+					parsed->parser.enableNodeIDShifting();
+					parsed->ast = parsed->parser.parse(*source.charStream);
+				}
+				parsed->parser.shiftNodeIDs(maxAstId);
+				maxAstId = parsed->parser.maxID();
+				source.ast = std::move(parsed->ast);
+			}
 			if (!source.ast)
 				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 			else
@@ -397,11 +606,10 @@ bool CompilerStack::parse()
 				}
 
 				if (m_stopAfter >= ParsedAndImported)
-					for (auto const& newSource: loadMissingSources(*source.ast))
+					for (auto& newSource: loadMissingSources(*source.ast, prefetchedSources))
 					{
 						std::string const& newPath = newSource.first;
-						std::string const& newContents = newSource.second;
-						m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
+						m_sources[newPath].charStream = std::make_shared<CharStream>(std::move(newSource.second), newPath);
 						sourcesToParse.push_back(newPath);
 					}
 			}
@@ -414,7 +622,8 @@ bool CompilerStack::parse()
 		storeContractDefinitions();
 
 		solAssert(!m_maxAstId.has_value());
-		m_maxAstId = parser.maxID();
+		m_maxAstId = threadPool ? maxAstId : parser.maxID();
+		util::Profiler::count("AST nodes", static_cast<uint64_t>(*m_maxAstId));
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
@@ -427,6 +636,7 @@ bool CompilerStack::parse()
 void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 {
 	solAssert(m_stackState == Empty, "Must call importASTs only before the SourcesSet state.");
+	discardAnalysisSnapshot();
 	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources =
 		ASTJsonImporter(m_evmVersion, m_eofVersion).jsonToSourceUnit(_sources);
 	for (auto& src: reconstructedSources)
@@ -451,6 +661,7 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
+	util::Profiler::Scope profilerScope("Analysis", "compiler");
 
 	if (!resolveImports())
 		return false;
@@ -521,6 +732,7 @@ bool CompilerStack::analyze()
 		return false;
 
 	m_stackState = AnalysisSuccessful;
+	m_analysisErrors = m_errorReporter.errors();
 	return true;
 }
 
@@ -618,7 +830,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 			ControlFlowRevertPruner pruner(cfg);
 			pruner.run();
 
-			ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
+			ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter, m_numThreads);
 			if (!controlFlowAnalyzer.run())
 				noErrors = false;
 		}
@@ -645,7 +857,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 			noErrors = false;
 	}
 
-	if (noErrors)
+	if (noErrors && m_modelCheckerAllowed)
 	{
 		// Run SMTChecker
 
@@ -685,6 +897,10 @@ bool CompilerStack::parseAndAnalyze(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
 
+	m_analysisReused = m_stopAfter >= AnalysisSuccessful && restoreAnalysisSnapshot();
+	if (m_analysisReused)
+		return true;
+
 	bool success = parse();
 	if (m_stackState >= m_stopAfter)
 		return success;
@@ -750,6 +966,22 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_stackState >= m_stopAfter)
 		return true;
 
+	size_t const yulStringsBefore = yul::YulStringRepository::instance().size();
+	ScopeGuard countYulStrings([&]() {
+		size_t yulStrings = yul::YulStringRepository::instance().size();
+		if (yulStrings > yulStringsBefore)
+			util::Profiler::count("Interned Yul strings", yulStrings - yulStringsBefore);
+	});
+
+	if (m_viaIR && m_numThreads > 1 && !m_experimentalAnalysis)
+	{
+		if (!compileViaIRInParallel())
+			return false;
+		m_stackState = CompilationSuccessful;
+		this->link();
+		return true;
+	}
+
 	// Only compile contracts individually which have been requested.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
 
@@ -807,12 +1039,17 @@ void CompilerStack::link()
 }
 
 YulStack CompilerStack::loadGeneratedIR(std::string const& _ir) const
+{
+	return loadGeneratedIR(_ir, m_optimiserSettings);
+}
+
+YulStack CompilerStack::loadGeneratedIR(std::string const& _ir, OptimiserSettings const& _optimiserSettings) const
 {
 	YulStack stack(
 		m_evmVersion,
 		m_eofVersion,
 		YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
+		_optimiserSettings,
 		m_debugInfoSelection,
 		this, // _soliditySourceProvider
 		m_objectOptimizer
@@ -1011,6 +1248,31 @@ Json CompilerStack::yulIROptimizedAst(std::string const& _contractName) const
 	return loadGeneratedIR(contract(_contractName).yulIROptimized).astJson();
 }
 
+Json CompilerStack::storageAccess(std::string const& _contractName) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
+	solUnimplementedAssert(!isExperimentalSolidity());
+
+	Contract const& currentContract = contract(_contractName);
+	solAssert(currentContract.contract);
+	if (currentContract.yulIROptimized.empty())
+		return Json::object();
+
+	// NOTE: Intentionally not using LazyInit, the optimized IR has to be parsed again.
+	YulStack stack = loadGeneratedIR(currentContract.yulIROptimized);
+	std::shared_ptr<yul::Object> creationObject = stack.parserResult();
+	solAssert(creationObject);
+	for (auto const& subNode: creationObject->subObjects)
+		if (auto const* deployedObject = dynamic_cast<yul::Object const*>(subNode.get()))
+			if (deployedObject->name == IRNames::deployedObject(*currentContract.contract))
+				return StorageAccess().generate(
+					*currentContract.contract,
+					*deployedObject,
+					yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion, m_eofVersion)
+				);
+	return Json::object();
+}
+
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
@@ -1108,6 +1370,16 @@ Json const& CompilerStack::transientStorageLayout(Contract const& _contract) con
 	return _contract.transientStorageLayout.init([&]{ return StorageLayout().generate(*_contract.contract, DataLocation::Transient); });
 }
 
+Json const& CompilerStack::storageLayoutSuggestion(std::string const& _contractName) const
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
+	solUnimplementedAssert(!isExperimentalSolidity());
+
+	Contract const& currentContract = contract(_contractName);
+	solAssert(currentContract.contract);
+	return currentContract.storageLayoutSuggestion.init([&]{ return StorageLayoutSuggestion().generate(*currentContract.contract); });
+}
+
 Json const& CompilerStack::natspecUser(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
@@ -1195,6 +1467,13 @@ SourceUnit const& CompilerStack::ast(std::string const& _sourceName) const
 	return *source(_sourceName).ast;
 }
 
+h256 const& CompilerStack::sourceKeccak256(std::string const& _sourceName) const
+{
+	solAssert(m_stackState >= SourcesSet, "No sources set.");
+	solAssert(source(_sourceName).charStream);
+	return source(_sourceName).keccak256();
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
@@ -1218,26 +1497,29 @@ size_t CompilerStack::functionEntryPoint(
 
 h256 const& CompilerStack::Source::keccak256() const
 {
-	if (keccak256HashCached == h256{})
+	if (!keccak256HashCached)
 		keccak256HashCached = util::keccak256(charStream->source());
-	return keccak256HashCached;
+	return *keccak256HashCached;
 }
 
-h256 const& CompilerStack::Source::swarmHash() const
+std::string const& CompilerStack::Source::swarmUrl() const
 {
-	if (swarmHashCached == h256{})
-		swarmHashCached = util::bzzr1Hash(charStream->source());
-	return swarmHashCached;
+	if (!swarmUrlCached)
+		swarmUrlCached = "bzz-raw://" + util::toHex(util::bzzr1Hash(charStream->source()).asBytes());
+	return *swarmUrlCached;
 }
 
 std::string const& CompilerStack::Source::ipfsUrl() const
 {
-	if (ipfsUrlCached.empty())
+	if (!ipfsUrlCached)
 		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(charStream->source());
-	return ipfsUrlCached;
+	return *ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
+StringMap CompilerStack::loadMissingSources(
+	SourceUnit const& _ast,
+	std::map<std::string, ReadCallback::Result>& _prefetchedSources
+)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
 	StringMap newSources;
@@ -1252,11 +1534,15 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 					continue;
 
 				ReadCallback::Result result{false, std::string("File not supplied initially.")};
-				if (m_readFile)
+				if (auto prefetched = _prefetchedSources.extract(importPath); prefetched && prefetched.mapped().success)
+					result = std::move(prefetched.mapped());
+				else if (m_readFile)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
+				else if (prefetched)
+					result = std::move(prefetched.mapped());
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources[importPath] = std::move(result.responseOrErrorMessage);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1275,6 +1561,52 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 	return newSources;
 }
 
+void CompilerStack::prefetchMissingSources(
+	std::vector<std::string> const& _paths,
+	std::map<std::string, ReadCallback::Result>& _prefetchedSources
+)
+{
+	solAssert(m_batchReadFile);
+
+	std::vector<std::string> missingPaths;
+	for (std::string const& path: std::set<std::string>(_paths.begin(), _paths.end()))
+	{
+		// The sources are parsed again later, only their imports are needed here.
+		SeparatelyParsedSource parsed(m_evmVersion, m_eofVersion);
+		try
+		{
+			parsed.ast = parsed.parser.parse(*m_sources.at(path).charStream);
+		}
+		catch (...)
+		{
+			// Reported when the source is parsed again.
+		}
+		if (!parsed.ast)
+			continue;
+
+		for (auto const& import: ASTNode::filteredNodes<ImportDirective>(parsed.ast->nodes()))
+		{
+			if (import->path().empty() || stdlib::sources.count(import->path()))
+				continue;
+			std::string importPath = applyRemapping(util::absolutePath(import->path(), path), path);
+			if (!m_sources.count(importPath) && !_prefetchedSources.count(importPath) && !util::contains(missingPaths, importPath))
+				missingPaths.push_back(std::move(importPath));
+		}
+	}
+	if (missingPaths.empty())
+		return;
+
+	std::vector<ReadCallback::Result> results = m_batchReadFile(
+		ReadCallback::kindString(ReadCallback::Kind::ReadFile),
+		missingPaths
+	);
+	// Results that do not match the queries are ignored and the sources are loaded one by one.
+	if (results.size() != missingPaths.size())
+		return;
+	for (size_t i = 0; i < missingPaths.size(); ++i)
+		_prefetchedSources.emplace(std::move(missingPaths[i]), std::move(results[i]));
+}
+
 std::string CompilerStack::applyRemapping(std::string const& _path, std::string const& _context)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1354,6 +1686,104 @@ void CompilerStack::storeContractDefinitions()
 			}
 }
 
+void CompilerStack::storeAnalysisSnapshot()
+{
+	// A snapshot that was neither used nor superseded by parsing is still valid.
+	if (m_stackState < AnalysisSuccessful)
+		return;
+
+	solAssert(!m_analysisSnapshot);
+	// The model checker and the experimental analysis depend on more than the sources and
+	// the settings captured by the snapshot.
+	if (
+		m_compilationSourceType != CompilationSourceType::Solidity ||
+		m_experimentalAnalysis ||
+		m_modelCheckerSettings.engine.any()
+	)
+		return;
+
+	// Note that moving the map keeps its nodes and therefore the pointers in m_sourceOrder valid.
+	m_analysisSnapshot = std::make_unique<AnalysisSnapshot>(AnalysisSnapshot{
+		std::move(m_sources),
+		std::move(m_sourceOrder),
+		std::move(m_globalContext),
+		m_maxAstId,
+		std::move(m_analysisErrors),
+		m_evmVersion,
+		m_eofVersion,
+		m_importRemapper.remappings(),
+		m_optimiserSettings.runYulOptimiser,
+	});
+}
+
+bool CompilerStack::restoreAnalysisSnapshot()
+{
+	if (!m_analysisSnapshot || m_stackState != SourcesSet)
+		return false;
+
+	if (
+		m_analysisSnapshot->evmVersion != m_evmVersion ||
+		m_analysisSnapshot->eofVersion != m_eofVersion ||
+		m_analysisSnapshot->remappings != m_importRemapper.remappings() ||
+		m_analysisSnapshot->runYulOptimiser != m_optimiserSettings.runYulOptimiser ||
+		m_modelCheckerSettings.engine.any() ||
+		!analysisSnapshotSourcesMatch()
+	)
+		return false;
+
+	std::unique_ptr<AnalysisSnapshot> snapshot = std::move(m_analysisSnapshot);
+	m_sources = std::move(snapshot->sources);
+	m_sourceOrder = std::move(snapshot->sourceOrder);
+	m_globalContext = std::move(snapshot->globalContext);
+	m_maxAstId = snapshot->maxAstId;
+	m_analysisErrors = std::move(snapshot->errors);
+
+	m_errorReporter.clear();
+	m_errorReporter.append(m_analysisErrors);
+	storeContractDefinitions();
+	m_stackState = AnalysisSuccessful;
+	return true;
+}
+
+bool CompilerStack::analysisSnapshotSourcesMatch() const
+{
+	solAssert(m_analysisSnapshot);
+
+	for (auto const& [path, source]: m_sources)
+		if (!m_analysisSnapshot->sources.count(path))
+			return false;
+
+	for (auto const& [path, snapshotSource]: m_analysisSnapshot->sources)
+	{
+		solAssert(snapshotSource.charStream);
+		std::string const& snapshotContent = snapshotSource.charStream->source();
+		if (m_sources.count(path))
+		{
+			if (m_sources.at(path).charStream->source() != snapshotContent)
+				return false;
+		}
+		else
+		{
+			// The source was loaded via the import callback, whose answer may have changed.
+			if (!m_readFile)
+				return false;
+			ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), path);
+			if (!result.success || result.responseOrErrorMessage != snapshotContent)
+				return false;
+		}
+	}
+	return true;
+}
+
+void CompilerStack::discardAnalysisSnapshot()
+{
+	if (!m_analysisSnapshot)
+		return;
+
+	m_analysisSnapshot.reset();
+	TypeProvider::reset();
+}
+
 void CompilerStack::annotateInternalFunctionIDs()
 {
 	for (Source const* source: m_sourceOrder)
@@ -1404,6 +1834,7 @@ void CompilerStack::assembleYul(
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::Profiler::Scope profilerScope("Assembly", "compiler", {{"contract", _contract.fullyQualifiedName()}});
 
 	compiledContract.evmAssembly = _assembly;
 	solAssert(compiledContract.evmAssembly, "");
@@ -1448,6 +1879,20 @@ void CompilerStack::assembleYul(
 			"turning off revert strings, or using libraries."
 		);
 
+	if (
+		m_optimiserSettings.codeSizeTarget &&
+		compiledContract.runtimeObject.bytecode.size() > *m_optimiserSettings.codeSizeTarget
+	)
+		m_errorReporter.warning(
+			2165_error,
+			_contract.location(),
+			"Contract code size is "s +
+			std::to_string(compiledContract.runtimeObject.bytecode.size()) +
+			" bytes and exceeds the code size target of " +
+			std::to_string(*m_optimiserSettings.codeSizeTarget) +
+			" bytes even if it is optimized for a single run."
+		);
+
 	// Throw a warning if EIP-3860 limits are exceeded:
 	//   If initcode is larger than 0xC000 bytes (twice the runtime code limit),
 	//   then contract creation fails with an out of gas error.
@@ -1487,13 +1932,24 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
-
 	solAssert(!m_viaIR, "");
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
 
-	// Run optimiser and compile the contract.
-	compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+	std::shared_ptr<Compiler> compiler;
+	{
+		util::Profiler::Scope profilerScope("Code generation", "compiler", {{"contract", _contract.fullyQualifiedName()}});
+		compileForCodeSizeTarget(m_optimiserSettings, [&](OptimiserSettings const& _settings) {
+			compiler = std::make_shared<Compiler>(
+				m_evmVersion,
+				m_revertStrings,
+				_settings,
+				m_numThreads
+			);
+			// Run optimiser and compile the contract.
+			compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+			return compiler->runtimeAssembly().assemble().bytecode.size();
+		});
+	}
 	compiledContract.generatedYulUtilityCode = compiler->generatedYulUtilityCode();
 	compiledContract.runtimeGeneratedYulUtilityCode = compiler->runtimeGeneratedYulUtilityCode();
 
@@ -1525,6 +1981,9 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	if (!_contract.canBeDeployed())
 		return;
 
+	std::optional<util::Profiler::Scope> generationScope;
+	generationScope.emplace("IR generation", "compiler", std::map<std::string, std::string>{{"contract", _contract.fullyQualifiedName()}});
+
 	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
@@ -1548,6 +2007,8 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	}
 	else
 	{
+		if (!m_yulFunctionCache)
+			m_yulFunctionCache = std::make_unique<YulFunctionCache>();
 		IRGenerator generator(
 			m_evmVersion,
 			m_eofVersion,
@@ -1555,7 +2016,8 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 			sourceIndices(),
 			m_debugInfoSelection,
 			this,
-			m_optimiserSettings
+			m_optimiserSettings,
+			m_yulFunctionCache.get()
 		);
 		compiledContract.yulIR = generator.run(
 			_contract,
@@ -1565,13 +2027,35 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	}
 
 	YulStack stack = loadGeneratedIR(compiledContract.yulIR);
+	generationScope.reset();
 	if (!_unoptimizedOnly)
 	{
+		util::Profiler::Scope optimisationScope("IR optimisation", "compiler", {{"contract", _contract.fullyQualifiedName()}});
+		stack.setNumThreads(m_numThreads);
 		stack.optimize();
 		compiledContract.yulIROptimized = stack.print();
 	}
 }
 
+void CompilerStack::optimizeIR(ContractDefinition const& _contract, size_t _numThreads)
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "");
+
+	if (!_contract.canBeDeployed())
+		return;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(!compiledContract.yulIR.empty(), "");
+	if (!compiledContract.yulIROptimized.empty())
+		return;
+
+	util::Profiler::Scope profilerScope("IR optimisation", "compiler", {{"contract", _contract.fullyQualifiedName()}});
+	YulStack stack = loadGeneratedIR(compiledContract.yulIR);
+	stack.setNumThreads(_numThreads);
+	stack.optimize();
+	compiledContract.yulIROptimized = stack.print();
+}
+
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -1580,19 +2064,141 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	YulStack stack = loadGeneratedIR(compiledContract.yulIROptimized);
+	generateEVMAssemblyFromIR(_contract, m_numThreads);
+	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+}
+
+void CompilerStack::generateEVMAssemblyFromIR(ContractDefinition const& _contract, size_t _numThreads)
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "");
+	solAssert(_contract.canBeDeployed());
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	util::Profiler::Scope profilerScope("EVM code generation", "compiler", {{"contract", _contract.fullyQualifiedName()}});
 
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+
+	size_t optimizedRuns = m_optimiserSettings.expectedExecutionsPerDeployment;
+	compileForCodeSizeTarget(m_optimiserSettings, [&](OptimiserSettings const& _settings) {
+		if (_settings.expectedExecutionsPerDeployment != optimizedRuns)
+		{
+			YulStack stack = loadGeneratedIR(compiledContract.yulIR, _settings);
+			stack.setNumThreads(_numThreads);
+			stack.optimize();
+			compiledContract.yulIROptimized = stack.print();
+			optimizedRuns = _settings.expectedExecutionsPerDeployment;
+		}
+
+		// Re-parse the Yul IR in EVM dialect
+		YulStack stack = loadGeneratedIR(compiledContract.yulIROptimized, _settings);
+		tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+		return compiledContract.evmRuntimeAssembly->assemble().bytecode.size();
+	});
+}
+
+bool CompilerStack::compileViaIRInParallel()
+{
+	solAssert(m_viaIR);
+	solAssert(!m_experimentalAnalysis);
+	solAssert(m_numThreads > 1);
+
+	struct ScheduledContract
+	{
+		ContractDefinition const* contract = nullptr;
+		bool needsBytecode = false;
+		/// Number of entries in the error list after the IR of the contract was generated.
+		size_t numErrorsAfterIRGeneration = 0;
+		std::future<void> result;
+	};
+	std::vector<ScheduledContract> scheduledContracts;
+
+	try
+	{
+		// The contracts share the threads, so that the optimizer does not start further
+		// threads for every one of them.
+		size_t numScheduledContracts = 0;
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
+					{
+						PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+						if (pipelineConfig.needIR(m_viaIR) && !pipelineConfig.needIRCodegenOnly(m_viaIR))
+							++numScheduledContracts;
+					}
+		numScheduledContracts = std::max<size_t>(1, numScheduledContracts);
+		size_t const threadsPerContract = std::max<size_t>(1, m_numThreads / numScheduledContracts);
+		util::ThreadPool threadPool(std::min(m_numThreads, numScheduledContracts));
+
+		// IR generation uses the analysis results and the error reporter, so it runs on this thread.
+		// The generated IR includes the full code of all dependencies, so once it exists,
+		// contracts can be optimized and compiled independently of each other.
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
+					{
+						PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+						if (!pipelineConfig.needIR(m_viaIR))
+							continue;
+
+						generateIR(*contract, true /* _unoptimizedOnly */);
+
+						ScheduledContract& scheduledContract = scheduledContracts.emplace_back();
+						scheduledContract.contract = contract;
+						scheduledContract.needsBytecode = pipelineConfig.needBytecode() && contract->canBeDeployed();
+						scheduledContract.numErrorsAfterIRGeneration = m_errorList.size();
+						if (!pipelineConfig.needIRCodegenOnly(m_viaIR))
+							scheduledContract.result = threadPool.submit([this, contract, needsBytecode = scheduledContract.needsBytecode, threadsPerContract, profiler = util::Profiler::active()]() {
+								util::Profiler::Activation profilerActivation(profiler);
+								TypeProvider::Activation typeProviderActivation(m_typeProvider);
+								optimizeIR(*contract, threadsPerContract);
+								if (needsBytecode)
+									generateEVMAssemblyFromIR(*contract, threadsPerContract);
+							});
+					}
+
+		// Assemble in the original order. Warnings reported here are moved right after the
+		// errors of the IR generation of the same contract, just like in a sequential run.
+		size_t numInsertedErrors = 0;
+		for (ScheduledContract& scheduledContract: scheduledContracts)
+		{
+			if (!scheduledContract.result.valid())
+				continue;
+			scheduledContract.result.get();
+			if (!scheduledContract.needsBytecode)
+				continue;
+
+			Contract& compiledContract = m_contracts.at(scheduledContract.contract->fullyQualifiedName());
+			size_t numErrorsBeforeAssembly = m_errorList.size();
+			assembleYul(*scheduledContract.contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+			size_t insertionPoint = scheduledContract.numErrorsAfterIRGeneration + numInsertedErrors;
+			std::rotate(
+				m_errorList.begin() + static_cast<ptrdiff_t>(insertionPoint),
+				m_errorList.begin() + static_cast<ptrdiff_t>(numErrorsBeforeAssembly),
+				m_errorList.end()
+			);
+			numInsertedErrors += m_errorList.size() - numErrorsBeforeAssembly;
+		}
+	}
+	catch (Error const& _error)
+	{
+		solAssert(_error.type() == Error::Type::CodeGenerationError);
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _error)
+	{
+		reportUnimplementedFeatureError(_error);
+		return false;
+	}
+
+	return true;
 }
 
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
@@ -1672,7 +2278,7 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 		else
 		{
 			meta["sources"][s.first]["urls"] = Json::array();
-			meta["sources"][s.first]["urls"].emplace_back("bzz-raw://" + util::toHex(s.second.swarmHash().asBytes()));
+			meta["sources"][s.first]["urls"].emplace_back(s.second.swarmUrl());
 			meta["sources"][s.first]["urls"].emplace_back(s.second.ipfsUrl());
 		}
 	}
@@ -1680,11 +2286,21 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::number_integer_t), "Invalid word size.");
 	solAssert(static_cast<Json::number_integer_t>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::number_integer_t>::max(), "");
 	meta["settings"]["optimizer"]["runs"] = Json::number_integer_t(m_optimiserSettings.expectedExecutionsPerDeployment);
+	if (m_optimiserSettings.codeSizeTarget)
+		meta["settings"]["optimizer"]["codeSizeTarget"] = Json::number_integer_t(*m_optimiserSettings.codeSizeTarget);
+	if (!m_optimiserSettings.executionProfile.empty())
+	{
+		meta["settings"]["optimizer"]["executionProfile"] = Json::object();
+		for (auto const& [signature, calls]: m_optimiserSettings.executionProfile)
+			meta["settings"]["optimizer"]["executionProfile"][signature] = Json::number_unsigned_t(calls);
+	}
 
 	/// Backwards compatibility: If set to one of the default settings, do not provide details.
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.codeSizeTarget = std::nullopt;
+	settingsWithoutRuns.executionProfile.clear();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1702,6 +2318,22 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["simpleCounterForLoopUncheckedIncrement"] = m_optimiserSettings.simpleCounterForLoopUncheckedIncrement;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
+		// Code generator optimizations are only listed if enabled, which keeps the metadata
+		// of inputs from before they were introduced unchanged.
+		if (m_optimiserSettings.copyABIDecodedArrays)
+			details["copyABIDecodedArrays"] = true;
+		if (m_optimiserSettings.decodeReadOnlyStructsFromCalldata)
+			details["decodeReadOnlyStructsFromCalldata"] = true;
+		if (m_optimiserSettings.encodeEventDataInScratchSpace)
+			details["encodeEventDataInScratchSpace"] = true;
+		if (m_optimiserSettings.splitSelectorSwitch)
+			details["splitSelectorSwitch"] = true;
+		if (m_optimiserSettings.useSSACodeTransform)
+			details["useSSACodeTransform"] = true;
+		if (m_optimiserSettings.optimizeCallingConvention)
+			details["optimizeCallingConvention"] = true;
+		if (m_optimiserSettings.optimizeFunctionExits)
+			details["optimizeFunctionExits"] = true;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::object();
@@ -1854,7 +2486,11 @@ bytes CompilerStack::createCBORMetadata(Contract const& _contract, bool _forIR)
 		_contract.contract->sourceUnit().annotation().experimentalFeatures
 	);
 
-	std::string meta = (_forIR == m_viaIR ? metadata(_contract) : createMetadata(_contract, _forIR));
+	// The cached metadata is hashed in place, only metadata for the other pipeline is created here.
+	std::string otherPipelineMetadata;
+	if (_forIR != m_viaIR)
+		otherPipelineMetadata = createMetadata(_contract, _forIR);
+	std::string const& meta = (_forIR == m_viaIR ? metadata(_contract) : otherPipelineMetadata);
 
 	MetadataCBOREncoder encoder;
 
@@ -1891,9 +2527,31 @@ Json gasToJson(GasEstimator::GasConsumption const& _gas)
 		return Json(util::toString(_gas.value));
 }
 
+Json parametricGasToJson(GasEstimator::ParametricGasConsumption const& _gas, evmasm::AssemblyItems const& _items)
+{
+	Json loops = Json::array();
+	for (auto const& [index, gas]: _gas.loops)
+	{
+		Json loop = Json::object();
+		langutil::SourceLocation const& location = _items.at(index).location();
+		if (location.sourceName)
+			loop["source"] = *location.sourceName;
+		loop["begin"] = location.start;
+		loop["end"] = location.end;
+		loop["perIteration"] = gasToJson(gas);
+		loops.emplace_back(std::move(loop));
+	}
+
+	Json result = Json::object();
+	result["base"] = gasToJson(_gas.base);
+	result["loops"] = std::move(loops);
+	result["externalCalls"] = _gas.externalCalls.size();
+	return result;
 }
 
-Json CompilerStack::gasEstimates(std::string const& _contractName) const
+}
+
+Json CompilerStack::gasEstimates(std::string const& _contractName, bool _parametric) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
@@ -1904,6 +2562,7 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 	using Gas = GasEstimator::GasConsumption;
 	GasEstimator gasEstimator(m_evmVersion);
 	Json output = Json::object();
+	Json parametric = Json::object();
 
 	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
 	{
@@ -1917,6 +2576,9 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 		executionGas += codeDepositGas;
 		creation["totalCost"] = gasToJson(executionGas);
 		output["creation"] = creation;
+
+		if (_parametric)
+			parametric["creation"] = parametricGasToJson(gasEstimator.parametricEstimation(*items), *items);
 	}
 
 	if (evmasm::AssemblyItems const* items = runtimeAssemblyItems(_contractName))
@@ -1924,23 +2586,33 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
 		Json externalFunctions = Json::object();
+		Json parametricExternalFunctions = Json::object();
 		for (auto it: contract.interfaceFunctions())
 		{
 			std::string sig = it.second->externalSignature();
 			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			if (_parametric)
+				parametricExternalFunctions[sig] = parametricGasToJson(gasEstimator.parametricEstimation(*items, sig), *items);
 		}
 
 		if (contract.fallbackFunction())
+		{
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
 			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
+			if (_parametric)
+				parametricExternalFunctions[""] = parametricGasToJson(gasEstimator.parametricEstimation(*items, "INVALID"), *items);
+		}
 
 		if (!externalFunctions.empty())
 			output["external"] = externalFunctions;
+		if (!parametricExternalFunctions.empty())
+			parametric["external"] = parametricExternalFunctions;
 
 		/// Internal functions
 		Json internalFunctions = Json::object();
+		Json parametricInternalFunctions = Json::object();
 		for (auto const& it: contract.definedFunctions())
 		{
 			/// Exclude externally visible functions, constructor, fallback and receive ether function
@@ -1961,12 +2633,23 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 			sig += ")";
 
 			internalFunctions[sig] = gasToJson(gas);
+			if (_parametric)
+			{
+				GasEstimator::ParametricGasConsumption parametricGas{GasEstimator::GasConsumption::infinite(), {}, {}};
+				if (entry > 0)
+					parametricGas = gasEstimator.parametricEstimation(*items, entry, *it);
+				parametricInternalFunctions[sig] = parametricGasToJson(parametricGas, *items);
+			}
 		}
 
 		if (!internalFunctions.empty())
 			output["internal"] = internalFunctions;
+		if (!parametricInternalFunctions.empty())
+			parametric["internal"] = parametricInternalFunctions;
 	}
 
+	if (_parametric)
+		output["parametric"] = std::move(parametric);
 	return output;
 }
 
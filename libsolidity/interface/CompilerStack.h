@@ -51,6 +51,8 @@
 
 #include <libyul/ObjectOptimizer.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -86,8 +88,10 @@ class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class TypeProvider;
 class Natspec;
 class DeclarationContainer;
+class YulFunctionCache;
 namespace experimental
 {
 class Analysis;
@@ -184,7 +188,12 @@ public:
 	/// Creates a new compiler stack.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit CompilerStack(ReadCallback::Callback _readFile = ReadCallback::Callback());
+	/// @param _objectOptimizer cache of optimized Yul objects, which may be shared with other
+	/// compilations. A new one is created if not given.
+	explicit CompilerStack(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer = nullptr
+	);
 
 	~CompilerStack() override;
 
@@ -204,6 +213,11 @@ public:
 	/// Must be set before parsing.
 	void setRemappings(std::vector<ImportRemapper::Remapping> _remappings);
 
+	/// Sets a callback used to load the imports of all sources known at a time in a single call,
+	/// before they are loaded one by one. Imports it cannot load are requested from the read
+	/// callback as usual. Must be set before parsing.
+	void setBatchReadCallback(ReadCallback::BatchCallback _batchReadFile);
+
 	/// Sets library addresses. Addresses are cleared iff @a _libraries is missing.
 	/// Must be set before parsing.
 	void setLibraries(std::map<std::string, util::h160> const& _libraries = {});
@@ -223,6 +237,31 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the number of threads used for parsing, analysis and code generation.
+	/// With more than one thread, independent source units are parsed concurrently, the control
+	/// flow of functions is analysed concurrently and per-contract optimization and EVM code
+	/// generation of the via-IR pipeline are executed concurrently. The output is identical to
+	/// a sequential run.
+	/// Must be set before compiling.
+	void setNumThreads(size_t _numThreads);
+
+	/// Sets a directory used to persist intermediate results, such as optimized Yul code,
+	/// across compiler runs. Only results produced by the same compiler version are reused.
+	/// Does not affect the output. If set to std::nullopt (the default), nothing is persisted.
+	/// Must be set before compiling.
+	void setCacheDirectory(std::optional<boost::filesystem::path> _cacheDirectory);
+
+	/// Enables the reuse of parsed and analyzed sources across compilations.
+	/// In this mode, reset(true) retains the results of the last successful analysis and the next
+	/// parseAndAnalyze() reuses them instead of starting over, provided that neither the sources
+	/// (including ones loaded via the import callback) nor the settings affecting the analysis
+	/// have changed in the meantime. The output is identical to that of a full compilation.
+	void setIncrementalAnalysis(bool _incrementalAnalysis);
+
+	/// @returns true if the last call to parseAndAnalyze() reused the previous analysis,
+	/// in which case the ASTs are the very same objects as before.
+	bool analysisReused() const noexcept { return m_analysisReused; }
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -235,6 +274,11 @@ public:
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 
+	/// Allows or prevents running the model checker during analysis. If prevented, it does not
+	/// run even if it is enabled by the settings or by ``pragma experimental SMTChecker``.
+	/// Must be set before parsing.
+	void setModelCheckerAllowed(bool _allowed);
+
 	/// Sets names of the contracts from each source that should be compiled.
 	/// If empty, no filtering is performed and every contract found in the supplied sources goes
 	/// through the default pipeline stages (bytecode-only, no IR).
@@ -303,6 +347,11 @@ public:
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// @returns the keccak256 hash of the content of the source with the supplied name.
+	/// It is computed at most once per loaded source, so it can be used to key caches
+	/// of results that only depend on the source content.
+	util::h256 const& sourceKeccak256(std::string const& _sourceName) const;
+
 	/// @returns the parsed contract with the supplied name. Throws an exception if the contract
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
@@ -334,6 +383,10 @@ public:
 
 	Json yulCFGJson(std::string const& _contractName) const;
 
+	/// @returns the storage slots accessed by the external functions of a contract,
+	/// determined from its optimized IR.
+	Json storageAccess(std::string const& _contractName) const;
+
 	/// @returns the assembled object for a contract.
 	virtual evmasm::LinkerObject const& object(std::string const& _contractName) const override;
 
@@ -380,6 +433,11 @@ public:
 	/// Prerequisite: Successful call to parse or compile.
 	Json const& transientStorageLayout(std::string const& _contractName) const;
 
+	/// @returns a JSON representing a suggested order of the storage variables of the contract
+	/// that packs variables accessed together into the same slots.
+	/// Prerequisite: Successful call to parse or compile.
+	Json const& storageLayoutSuggestion(std::string const& _contractName) const;
+
 	/// @returns a JSON representing the contract's user documentation.
 	/// Prerequisite: Successful call to parse or compile.
 	Json const& natspecUser(std::string const& _contractName) const;
@@ -403,7 +461,9 @@ public:
 	bytes cborMetadata(std::string const& _contractName, bool _forIR) const;
 
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
-	Json gasEstimates(std::string const& _contractName) const;
+	/// @param _parametric If true, the estimates are also given as base costs plus the costs per further
+	///                    iteration of each loop under the key "parametric".
+	Json gasEstimates(std::string const& _contractName, bool _parametric = false) const;
 
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	void setMetadataFormat(MetadataFormat _metadataFormat) { m_metadataFormat = _metadataFormat; }
@@ -425,12 +485,13 @@ private:
 	{
 		std::shared_ptr<langutil::CharStream> charStream;
 		std::shared_ptr<SourceUnit> ast;
-		util::h256 mutable keccak256HashCached;
-		util::h256 mutable swarmHashCached;
-		std::string mutable ipfsUrlCached;
+		/// Content hashes, computed on first use and shared by the metadata of all contracts.
+		std::optional<util::h256> mutable keccak256HashCached;
+		std::optional<std::string> mutable swarmUrlCached;
+		std::optional<std::string> mutable ipfsUrlCached;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
-		util::h256 const& swarmHash() const;
+		std::string const& swarmUrl() const;
 		std::string const& ipfsUrl() const;
 	};
 
@@ -451,19 +512,54 @@ private:
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
 		util::LazyInit<Json const> transientStorageLayout;
+		util::LazyInit<Json const> storageLayoutSuggestion;
 		util::LazyInit<Json const> userDocumentation;
 		util::LazyInit<Json const> devDocumentation;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
 	};
 
+	/// The results of a successful analysis, retained across reset() in incremental mode,
+	/// together with the inputs that determine them.
+	struct AnalysisSnapshot
+	{
+		std::map<std::string const, Source> sources;
+		std::vector<Source const*> sourceOrder;
+		std::shared_ptr<GlobalContext> globalContext;
+		std::optional<int64_t> maxAstId;
+		langutil::ErrorList errors;
+		langutil::EVMVersion evmVersion;
+		std::optional<uint8_t> eofVersion;
+		std::vector<ImportRemapper::Remapping> remappings;
+		bool runYulOptimiser = false;
+	};
+
+	/// Moves the analyzed sources into m_analysisSnapshot, if they are eligible for reuse.
+	void storeAnalysisSnapshot();
+	/// Restores the analyzed sources from m_analysisSnapshot if the sources and settings match.
+	/// @returns true if the analysis was restored.
+	bool restoreAnalysisSnapshot();
+	/// @returns true if the content of all sources of the snapshot is still the same.
+	bool analysisSnapshotSourcesMatch() const;
+	/// Drops m_analysisSnapshot along with the types that refer to its AST.
+	void discardAnalysisSnapshot();
+
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
-	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile
+	/// Loads the missing sources from @a _ast (named @a _path), taking them from @a _prefetchedSources
+	/// if present there and using the callback @a m_readFile otherwise.
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast);
+	StringMap loadMissingSources(
+		SourceUnit const& _ast,
+		std::map<std::string, ReadCallback::Result>& _prefetchedSources
+	);
+	/// Loads the imports of the sources @a _paths that are not known yet with a single call of
+	/// @a m_batchReadFile and adds the results to @a _prefetchedSources.
+	void prefetchMissingSources(
+		std::vector<std::string> const& _paths,
+		std::map<std::string, ReadCallback::Result>& _prefetchedSources
+	);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	bool resolveImports();
 
@@ -518,10 +614,28 @@ private:
 	///     optimized IR, its AST or compilation via IR must not be requested.
 	void generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly);
 
+	/// Runs the Yul optimizer on the IR stored by generateIR and stores the optimized IR.
+	/// Does not report any errors and only modifies the entry of @a _contract, which makes it safe
+	/// to call for different contracts concurrently. The optimizer uses up to @a _numThreads threads.
+	void optimizeIR(ContractDefinition const& _contract, size_t _numThreads);
+
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
+	/// Generates EVM assemblies from the optimized IR without assembling them into bytecode.
+	/// If a code size target is set, the IR may be optimized again with a different number of runs.
+	/// Like optimizeIR, it is safe to call for different contracts concurrently and uses up to
+	/// @a _numThreads threads for the optimizer.
+	void generateEVMAssemblyFromIR(ContractDefinition const& _contract, size_t _numThreads);
+
+	/// Compiles the requested contracts via IR, distributing the optimization and EVM code
+	/// generation of individual contracts over m_numThreads threads, which they also share for
+	/// optimizing their objects and functions. Everything that can report
+	/// errors or touches shared state of the analysis stays on the calling thread.
+	/// @returns false on error.
+	bool compileViaIRInParallel();
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -530,6 +644,8 @@ private:
 	/// Assumes that the IR was generated from sources loaded currently into CompilerStack, which
 	/// means that it is error-free and uses the same settings.
 	yul::YulStack loadGeneratedIR(std::string const& _ir) const;
+	/// Like loadGeneratedIR above, but uses @a _optimiserSettings instead of the settings of the stack.
+	yul::YulStack loadGeneratedIR(std::string const& _ir, OptimiserSettings const& _optimiserSettings) const;
 
 	/// @returns the contract object for the given @a _contractName.
 	/// Can only be called after state is CompilationSuccessful.
@@ -581,13 +697,19 @@ private:
 	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
 
 	ReadCallback::Callback m_readFile;
+	ReadCallback::BatchCallback m_batchReadFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_numThreads = 1;
+	std::optional<boost::filesystem::path> m_cacheDirectory;
+	bool m_incrementalAnalysis = false;
+	bool m_analysisReused = false;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
+	bool m_modelCheckerAllowed = true;
 	ContractSelection m_selectedContracts;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
@@ -597,8 +719,15 @@ private:
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
+	/// Errors and warnings reported up to the end of the last successful analysis.
+	langutil::ErrorList m_analysisErrors;
+	std::unique_ptr<AnalysisSnapshot> m_analysisSnapshot;
 	std::map<std::string const, Contract> m_contracts;
 	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	/// TypeProvider active while this CompilerStack was created, nullptr for the global one.
+	TypeProvider* m_typeProvider = nullptr;
+	/// Yul utility functions generated for one contract and reused in the IR of the others.
+	std::unique_ptr<YulFunctionCache> m_yulFunctionCache;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
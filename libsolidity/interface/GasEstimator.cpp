@@ -42,10 +42,54 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+/// Upper bound on the number of assembly items evaluated for a single functional estimation,
+/// such that the estimation of contracts with very many branches terminates predictably.
+size_t constexpr maxFunctionalEstimationSteps = 1000000;
+}
+
+GasEstimator::GasConsumption GasEstimator::functionalEstimation(
+	AssemblyItems const& _items,
+	std::string const& _signature
+) const
+{
+	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, initialState(_signature), maxFunctionalEstimationSteps);
+}
+
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
+	AssemblyItems const& _items,
+	size_t const& _offset,
+	FunctionDefinition const& _function
+) const
+{
+	std::shared_ptr<KnownState> state = initialState(_function);
+	if (!state)
+		return GasConsumption::infinite();
+	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state, maxFunctionalEstimationSteps);
+}
+
+GasEstimator::ParametricGasConsumption GasEstimator::parametricEstimation(
 	AssemblyItems const& _items,
 	std::string const& _signature
 ) const
+{
+	return PathGasMeter::estimateParametric(_items, m_evmVersion, 0, initialState(_signature), maxFunctionalEstimationSteps);
+}
+
+GasEstimator::ParametricGasConsumption GasEstimator::parametricEstimation(
+	AssemblyItems const& _items,
+	size_t const& _offset,
+	FunctionDefinition const& _function
+) const
+{
+	std::shared_ptr<KnownState> state = initialState(_function);
+	if (!state)
+		return ParametricGasConsumption{GasConsumption::infinite(), {}, {}};
+	return PathGasMeter::estimateParametric(_items, m_evmVersion, _offset, state, maxFunctionalEstimationSteps);
+}
+
+std::shared_ptr<KnownState> GasEstimator::initialState(std::string const& _signature) const
 {
 	auto state = std::make_shared<KnownState>();
 
@@ -78,20 +122,16 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return state;
 }
 
-GasEstimator::GasConsumption GasEstimator::functionalEstimation(
-	AssemblyItems const& _items,
-	size_t const& _offset,
-	FunctionDefinition const& _function
-) const
+std::shared_ptr<KnownState> GasEstimator::initialState(FunctionDefinition const& _function)
 {
 	auto state = std::make_shared<KnownState>();
 
 	unsigned parametersSize = CompilerUtils::sizeOnStack(_function.parameters());
 	if (parametersSize > 16)
-		return GasConsumption::infinite();
+		return nullptr;
 
 	// Store an invalid return value on the stack, so that the path estimator breaks upon reaching
 	// the return jump.
@@ -99,8 +139,7 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	state->feedItem(invalidTag, true);
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
-
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return state;
 }
 
 std::set<ASTNode const*> GasEstimator::finestNodesAtLocation(
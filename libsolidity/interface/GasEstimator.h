@@ -27,6 +27,7 @@
 
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/PathGasMeter.h>
 
 #include <array>
 #include <map>
@@ -42,6 +43,7 @@ struct GasEstimator
 {
 public:
 	using GasConsumption = evmasm::GasMeter::GasConsumption;
+	using ParametricGasConsumption = evmasm::ParametricGasConsumption;
 	using ASTGasConsumption = std::map<ASTNode const*, GasConsumption>;
 	using ASTGasConsumptionSelfAccumulated =
 		std::map<ASTNode const*, std::array<GasConsumption, 2>>;
@@ -64,7 +66,29 @@ public:
 		FunctionDefinition const& _function
 	) const;
 
+	/// @returns the estimated gas consumption by the (public or external) function with the
+	/// given signature as a base cost plus the costs of every further iteration of its loops.
+	/// If no signature is given, estimates the maximum gas usage.
+	ParametricGasConsumption parametricEstimation(
+		evmasm::AssemblyItems const& _items,
+		std::string const& _signature = ""
+	) const;
+
+	/// @returns the estimated gas consumption by the given function which starts at the given
+	/// offset into the list of assembly items as a base cost plus the costs of every further
+	/// iteration of its loops.
+	ParametricGasConsumption parametricEstimation(
+		evmasm::AssemblyItems const& _items,
+		size_t const& _offset,
+		FunctionDefinition const& _function
+	) const;
+
 private:
+	/// @returns the state at the start of the code when calling the function with the given signature.
+	std::shared_ptr<evmasm::KnownState> initialState(std::string const& _signature) const;
+	/// @returns the state at the start of @a _function or nullptr if its parameters cannot be tracked.
+	static std::shared_ptr<evmasm::KnownState> initialState(FunctionDefinition const& _function);
+
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
@@ -19,55 +19,70 @@
 #include <libsolutil/CommonIO.h>
 #include <liblangutil/Exceptions.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 namespace solidity::frontend
 {
 
 void ImportRemapper::setRemappings(std::vector<Remapping> _remappings)
 {
+	m_indexedRemappings.clear();
+	m_prefixTrie.assign(1, {});
 	for (auto const& remapping: _remappings)
+	{
 		solAssert(!remapping.prefix.empty(), "");
+		std::string prefix = util::sanitizePath(remapping.prefix);
+
+		size_t node = 0;
+		for (char c: prefix)
+		{
+			auto [child, inserted] = m_prefixTrie[node].children.try_emplace(c, m_prefixTrie.size());
+			if (inserted)
+				m_prefixTrie.emplace_back();
+			node = child->second;
+		}
+		m_prefixTrie[node].remappings.push_back(m_indexedRemappings.size());
+		m_indexedRemappings.push_back({
+			util::sanitizePath(remapping.context),
+			prefix.size(),
+			util::sanitizePath(remapping.target)
+		});
+	}
 	m_remappings = std::move(_remappings);
 }
 
 SourceUnitName ImportRemapper::apply(ImportPath const& _path, std::string const& _context) const
 {
 	// Try to find the longest prefix match in all remappings that are active in the current context.
-	auto isPrefixOf = [](std::string const& _a, std::string const& _b)
-	{
-		if (_a.length() > _b.length())
-			return false;
-		return equal(_a.begin(), _a.end(), _b.begin());
-	};
-
-	size_t longestPrefix = 0;
-	size_t longestContext = 0;
-	std::string bestMatchTarget;
-
-	for (auto const& redir: m_remappings)
+	// Walking the trie along the path visits exactly the remappings whose prefix matches, by
+	// increasing prefix length.
+	IndexedRemapping const* bestMatch = nullptr;
+	size_t node = 0;
+	for (size_t length = 0;; ++length)
 	{
-		std::string context = util::sanitizePath(redir.context);
-		std::string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+		for (size_t index: m_prefixTrie[node].remappings)
+		{
+			IndexedRemapping const& remapping = m_indexedRemappings[index];
+			// Skip if the context of the remapping is not a prefix of _context.
+			if (!boost::starts_with(_context, remapping.context))
+				continue;
+			// Skip if the current match has a closer context.
+			if (bestMatch && remapping.context.length() < bestMatch->context.length())
+				continue;
+			bestMatch = &remapping;
+		}
+
+		if (length == _path.size())
+			break;
+		auto child = m_prefixTrie[node].children.find(_path[length]);
+		if (child == m_prefixTrie[node].children.end())
+			break;
+		node = child->second;
 	}
-	std::string path = bestMatchTarget;
-	path.append(_path.begin() + static_cast<std::string::difference_type>(longestPrefix), _path.end());
-	return path;
+
+	if (!bestMatch)
+		return _path;
+	return bestMatch->target + _path.substr(bestMatch->prefixLength);
 }
 
 bool ImportRemapper::isRemapping(std::string_view _input)
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -49,11 +50,14 @@ public:
 		std::string target;
 	};
 
-	void clear() { m_remappings.clear(); }
+	void clear() { setRemappings({}); }
 
 	void setRemappings(std::vector<Remapping> _remappings);
 	std::vector<Remapping> const& remappings() const noexcept { return m_remappings; }
 
+	/// @returns @a _path with the prefix of the remapping that is active in @a _context replaced
+	/// by its target. Remappings with a longer context take precedence over those with a longer
+	/// prefix and, among equally long ones, the last remapping wins.
 	SourceUnitName apply(ImportPath const& _path, std::string const& _context) const;
 
 	/// @returns true if the string can be parsed as a remapping
@@ -63,9 +67,26 @@ public:
 	static std::optional<Remapping> parseRemapping(std::string_view _input);
 
 private:
+	/// Remapping with sanitized paths.
+	struct IndexedRemapping
+	{
+		std::string context;
+		size_t prefixLength = 0;
+		std::string target;
+	};
+	struct PrefixTrieNode
+	{
+		std::map<char, size_t> children;
+		/// Indices of the remappings whose prefix ends at this node, in the order they were given.
+		std::vector<size_t> remappings;
+	};
+
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings = {};
+	std::vector<IndexedRemapping> m_indexedRemappings;
+	/// Trie of the sanitized prefixes of all remappings, the first node is the root.
+	std::vector<PrefixTrieNode> m_prefixTrie{1};
 };
 
 }
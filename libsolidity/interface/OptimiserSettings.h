@@ -26,6 +26,8 @@
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <map>
+#include <optional>
 #include <string>
 
 namespace solidity::frontend
@@ -115,7 +117,12 @@ struct OptimiserSettings
 	{
 		return
 			runOrderLiterals == _other.runOrderLiterals &&
+			copyABIDecodedArrays == _other.copyABIDecodedArrays &&
+			decodeReadOnlyStructsFromCalldata == _other.decodeReadOnlyStructsFromCalldata &&
+			encodeEventDataInScratchSpace == _other.encodeEventDataInScratchSpace &&
+			splitSelectorSwitch == _other.splitSelectorSwitch &&
 			runInliner == _other.runInliner &&
+			inlinerCodeSizeLimit == _other.inlinerCodeSizeLimit &&
 			runJumpdestRemover == _other.runJumpdestRemover &&
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
@@ -123,9 +130,14 @@ struct OptimiserSettings
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			simpleCounterForLoopUncheckedIncrement == _other.simpleCounterForLoopUncheckedIncrement &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			useSSACodeTransform == _other.useSSACodeTransform &&
+			optimizeCallingConvention == _other.optimizeCallingConvention &&
+			optimizeFunctionExits == _other.optimizeFunctionExits &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			codeSizeTarget == _other.codeSizeTarget &&
+			executionProfile == _other.executionProfile;
 	}
 
 	bool operator!=(OptimiserSettings const& _other) const
@@ -136,8 +148,23 @@ struct OptimiserSettings
 	/// Move literals to the right of commutative binary operators during code generation.
 	/// This helps exploiting associativity.
 	bool runOrderLiterals = false;
+	/// Decode memory arrays of 256 bit integers and 32 byte fixed bytes with a single copy instead of
+	/// a loop over their elements during IR code generation.
+	bool copyABIDecodedArrays = false;
+	/// Leave statically encoded memory struct parameters of external functions that are only read member
+	/// by member in calldata during IR code generation. They are still fully validated on entry.
+	bool decodeReadOnlyStructsFromCalldata = false;
+	/// Encode the non-indexed data of events that consists of at most two value types into the scratch
+	/// space instead of at the free memory pointer, which saves loading the pointer and expanding memory.
+	bool encodeEventDataInScratchSpace = false;
+	/// Split the function selector switch of IR code into a binary search over the selectors where
+	/// this pays off for @a expectedExecutionsPerDeployment, like the legacy code generator does.
+	bool splitSelectorSwitch = false;
 	/// Inliner
 	bool runInliner = false;
+	/// If set, the inliner ranks all functions by estimated gas saved per byte added and inlines them
+	/// only as long as the code of each assembly stays below this size in bytes (e.g. 24576 for EIP-170).
+	std::optional<size_t> inlinerCodeSizeLimit;
 	/// Non-referenced jump destination remover.
 	bool runJumpdestRemover = false;
 	/// Peephole optimizer
@@ -153,6 +180,16 @@ struct OptimiserSettings
 	bool simpleCounterForLoopUncheckedIncrement = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool optimizeStackAllocation = false;
+	/// Generate bytecode from the SSA control flow graph of each Yul object, falling back to the default
+	/// optimized code transform for objects that run into stack errors. Requires @a optimizeStackAllocation.
+	bool useSSACodeTransform = false;
+	/// Choose for each internal Yul function whether its return label is pushed before or after its arguments,
+	/// s.t. less stack shuffling is required at its call sites and entry. Requires @a optimizeStackAllocation.
+	bool optimizeCallingConvention = false;
+	/// Lower calls to internal Yul functions whose results are directly returned to jumps that reuse the return
+	/// label of the caller and share the stack shuffling of identical function exits.
+	/// Requires @a optimizeStackAllocation.
+	bool optimizeFunctionExits = false;
 	/// Allow unchecked arithmetic when incrementing the counter of certain kinds of 'for' loop
 	bool runYulOptimiser = false;
 	/// Sequence of optimisation steps to be performed by Yul optimiser.
@@ -167,6 +204,13 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// If set, the runtime code of each contract is compiled with the largest number of expected executions
+	/// up to @a expectedExecutionsPerDeployment for which its size in bytes does not exceed this target.
+	/// Also limits the inliner to this size unless @a inlinerCodeSizeLimit is set.
+	std::optional<size_t> codeSizeTarget;
+	/// Number of calls of external functions, identified by their signature, taken from the execution of the
+	/// contracts, e.g. on a test network. The function selector checks the most frequently called functions first.
+	std::map<std::string, size_t> executionProfile;
 };
 
 }
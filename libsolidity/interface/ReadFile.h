@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -61,6 +62,11 @@ public:
 
 	/// File reading or generic query callback.
 	using Callback = std::function<Result(std::string const&, std::string const&)>;
+
+	/// Callback answering several queries of the same kind at once, e.g. all imports found in a set
+	/// of sources, which allows them to be fetched concurrently.
+	/// Must return one result per query, in the same order as the queries.
+	using BatchCallback = std::function<std::vector<Result>(std::string const&, std::vector<std::string> const&)>;
 };
 
 }
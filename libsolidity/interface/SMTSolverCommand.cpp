@@ -19,14 +19,71 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
+
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/process.hpp>
 
+#include <fstream>
+
 namespace solidity::frontend
 {
 
+namespace
+{
+/// Printed by a persistent solver process after it answered a query.
+std::string const c_queryDoneMarker = "solc-query-done";
+}
+
+struct SMTSolverCommand::PersistentProcess
+{
+	PersistentProcess(boost::filesystem::path const& _solverBin, std::string _command, std::vector<std::string> _arguments):
+		command(std::move(_command)),
+		arguments(std::move(_arguments)),
+		process(
+			_solverBin,
+			arguments,
+			boost::process::std_out > out,
+			boost::process::std_in < in,
+			boost::process::std_err > boost::process::null
+		)
+	{}
+
+	~PersistentProcess()
+	{
+		// The solver exits once its input is closed.
+		std::error_code error;
+		in.pipe().close();
+		if (!process.wait_for(std::chrono::seconds(1), error))
+			process.terminate(error);
+	}
+
+	std::string command;
+	std::vector<std::string> arguments;
+	boost::process::opstream in;
+	boost::process::ipstream out;
+	boost::process::child process;
+};
+
+SMTSolverCommand::SMTSolverCommand() = default;
+
+SMTSolverCommand::~SMTSolverCommand() = default;
+
+void SMTSolverCommand::setPersistentProcesses(bool _enabled)
+{
+	std::lock_guard lock(m_mutex);
+	m_persistentProcesses = _enabled;
+	if (!_enabled)
+		m_idleProcesses.clear();
+}
+
 void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants)
 {
+	std::lock_guard lock(m_mutex);
 	m_arguments.clear();
 	m_solverCmd = "eld";
 	m_arguments.emplace_back("-hsmt"); // Tell Eldarica to expect input in SMT2 format
@@ -43,6 +100,7 @@ void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMillisec
 
 void SMTSolverCommand::setCvc5(std::optional<unsigned int> timeoutInMilliseconds)
 {
+	std::lock_guard lock(m_mutex);
 	m_arguments.clear();
 	m_solverCmd = "cvc5";
 	if (timeoutInMilliseconds)
@@ -60,6 +118,7 @@ void SMTSolverCommand::setCvc5(std::optional<unsigned int> timeoutInMilliseconds
 void SMTSolverCommand::setZ3(std::optional<unsigned int> timeoutInMilliseconds, bool _preprocessing, bool _computeInvariants)
 {
 	constexpr int Z3ResourceLimit = 2000000;
+	std::lock_guard lock(m_mutex);
 	m_arguments.clear();
 	m_solverCmd = "z3";
 	m_arguments.emplace_back("-in"); // Read from standard input
@@ -93,39 +152,49 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
 			solAssert(false, "SMTQuery callback used as callback kind " + _kind);
 
-		if (m_solverCmd.empty())
-			return ReadCallback::Result{false, "No solver set."};
+		std::string solverCmd;
+		std::vector<std::string> args;
+		bool persistent = false;
+		std::optional<boost::filesystem::path> cachePath;
+		{
+			std::lock_guard lock(m_mutex);
+			solverCmd = m_solverCmd;
+			args = m_arguments;
+			persistent = m_persistentProcesses && m_solverCmd == "z3";
+			if (m_persistentCacheDirectory)
+				cachePath = persistentCachePath(*m_persistentCacheDirectory, solverCmd, args, _query);
+		}
 
-		auto solverBin = boost::process::search_path(m_solverCmd);
+		if (solverCmd.empty())
+			return ReadCallback::Result{false, "No solver set."};
 
-		if (solverBin.empty())
-			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
+		util::Profiler::Scope profilerScope(
+			"SMT solver",
+			"smtchecker",
+			{{"solver", solverCmd}, {"query size", std::to_string(_query.size())}}
+		);
 
-		auto args = m_arguments;
+		if (cachePath)
+			if (std::optional<std::string> response = loadCachedResponse(*cachePath))
+			{
+				profilerScope.setArgument("cached", "true");
+				return ReadCallback::Result{true, std::move(*response)};
+			}
 
-		boost::process::opstream in;  // input to subprocess written to by the main process
-		boost::process::ipstream out; // output from subprocess read by the main process
-		boost::process::child solverProcess(
-			solverBin,
-			args,
-			boost::process::std_out > out,
-			boost::process::std_in < in,
-			boost::process::std_err > boost::process::null
-		);
+		auto solverBin = boost::process::search_path(solverCmd);
 
-		in << _query << std::flush;
-		in.pipe().close();
-		in.close();
+		if (solverBin.empty())
+			return ReadCallback::Result{false, solverCmd + " binary not found."};
 
-		std::vector<std::string> data;
-		std::string line;
-		while (!(out.fail() || out.eof()) && std::getline(out, line))
-			if (!line.empty())
-				data.push_back(line);
+		auto [response, complete] = persistent ?
+			runPersistentSolver(solverBin, solverCmd, args, _query) :
+			runSolver(solverBin, args, _query);
 
-		solverProcess.wait();
+		// Only definite answers are cached, since the others can depend on the time the solver had.
+		if (cachePath && complete && (boost::starts_with(response, "sat") || boost::starts_with(response, "unsat")))
+			storeCachedResponse(*cachePath, response);
 
-		return ReadCallback::Result{true, boost::join(data, "\n")};
+		return ReadCallback::Result{true, std::move(response)};
 	}
 	catch (...)
 	{
@@ -133,4 +202,202 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 	}
 }
 
+std::pair<std::string, bool> SMTSolverCommand::runSolver(
+	boost::filesystem::path const& _solverBin,
+	std::vector<std::string> const& _arguments,
+	std::string const& _query
+) const
+{
+	boost::process::opstream in;  // input to subprocess written to by the main process
+	boost::process::ipstream out; // output from subprocess read by the main process
+	boost::process::child solverProcess(
+		_solverBin,
+		_arguments,
+		boost::process::std_out > out,
+		boost::process::std_in < in,
+		boost::process::std_err > boost::process::null
+	);
+
+	in << _query << std::flush;
+	in.pipe().close();
+	in.close();
+
+	// The process can only be interrupted once the query was written,
+	// since writing to a terminated process would raise SIGPIPE.
+	size_t query;
+	bool interrupted = false;
+	{
+		std::lock_guard lock(m_mutex);
+		query = m_nextQuery++;
+		m_runningProcesses[query] = [&solverProcess, &interrupted]() {
+			interrupted = true;
+			std::error_code error;
+			solverProcess.terminate(error);
+		};
+	}
+	// Unregister before waiting, so that the process is not terminated concurrently.
+	auto unregister = [&]() {
+		std::lock_guard lock(m_mutex);
+		m_runningProcesses.erase(query);
+	};
+	ScopeGuard unregisterGuard(unregister);
+
+	std::vector<std::string> data;
+	std::string line;
+	while (!(out.fail() || out.eof()) && std::getline(out, line))
+		if (!line.empty())
+			data.push_back(line);
+
+	unregister();
+	solverProcess.wait();
+
+	std::lock_guard lock(m_mutex);
+	return {boost::join(data, "\n"), !interrupted};
+}
+
+std::pair<std::string, bool> SMTSolverCommand::runPersistentSolver(
+	boost::filesystem::path const& _solverBin,
+	std::string const& _solverCmd,
+	std::vector<std::string> const& _arguments,
+	std::string const& _query
+) const
+{
+	std::unique_ptr<PersistentProcess> solver;
+	size_t query;
+	{
+		std::lock_guard lock(m_mutex);
+		for (auto it = m_idleProcesses.begin(); it != m_idleProcesses.end(); ++it)
+			if ((*it)->command == _solverCmd && (*it)->arguments == _arguments && (*it)->process.running())
+			{
+				solver = std::move(*it);
+				m_idleProcesses.erase(it);
+				break;
+			}
+		query = m_nextQuery++;
+	}
+	if (!solver)
+		solver = std::make_unique<PersistentProcess>(_solverBin, _solverCmd, _arguments);
+
+	// Every query is self-contained, so the declarations of the previous one are dropped first.
+	// The echo command tells where the answer ends.
+	solver->in << "(reset)\n" << _query << "\n(echo \"" << c_queryDoneMarker << "\")\n" << std::flush;
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_runningProcesses[query] = [process = solver.get()]() {
+			std::error_code error;
+			process->process.terminate(error);
+		};
+	}
+	auto unregister = [&]() {
+		std::lock_guard lock(m_mutex);
+		m_runningProcesses.erase(query);
+	};
+	ScopeGuard unregisterGuard(unregister);
+
+	bool done = false;
+	std::vector<std::string> data;
+	std::string line;
+	while (!(solver->out.fail() || solver->out.eof()) && std::getline(solver->out, line))
+	{
+		if (line == c_queryDoneMarker || line == "\"" + c_queryDoneMarker + "\"")
+		{
+			done = true;
+			break;
+		}
+		if (!line.empty())
+			data.push_back(line);
+	}
+
+	unregister();
+	// A process that did not finish the answer crashed or was interrupted and is not reused.
+	if (done)
+	{
+		std::lock_guard lock(m_mutex);
+		if (m_persistentProcesses)
+			m_idleProcesses.emplace_back(std::move(solver));
+	}
+
+	return {boost::join(data, "\n"), done};
+}
+
+void SMTSolverCommand::setPersistentCacheDirectory(std::optional<boost::filesystem::path> _directory)
+{
+	std::lock_guard lock(m_mutex);
+	m_persistentCacheDirectory = std::move(_directory);
+}
+
+boost::filesystem::path SMTSolverCommand::persistentCachePath(
+	boost::filesystem::path const& _directory,
+	std::string const& _solverCmd,
+	std::vector<std::string> const& _arguments,
+	std::string const& _query
+)
+{
+	// The command line is a part of the key, since it contains the options and limits of the solver.
+	std::string key = _solverCmd + '\0';
+	for (auto const& argument: _arguments)
+		key += argument + '\0';
+	key += _query;
+	return _directory / "smt-solver" / (util::keccak256(key).hex() + ".txt");
+}
+
+std::optional<std::string> SMTSolverCommand::loadCachedResponse(boost::filesystem::path const& _path)
+{
+	boost::system::error_code errorCode;
+	if (!boost::filesystem::is_regular_file(_path, errorCode))
+		return std::nullopt;
+
+	try
+	{
+		std::string response = util::readFileAsString(_path);
+		// Do not trust the file blindly. It could have been truncated or tampered with.
+		if (boost::starts_with(response, "sat") || boost::starts_with(response, "unsat"))
+			return response;
+	}
+	catch (util::Exception const&)
+	{
+	}
+	return std::nullopt;
+}
+
+void SMTSolverCommand::storeCachedResponse(boost::filesystem::path const& _path, std::string const& _response)
+{
+	boost::system::error_code errorCode;
+	boost::filesystem::create_directories(_path.parent_path(), errorCode);
+	if (errorCode)
+		return;
+
+	// Write to a unique temporary file first and move it into place afterwards so that
+	// concurrent compiler runs never observe a partially written entry.
+	boost::filesystem::path const temporaryPath = boost::filesystem::unique_path(
+		_path.string() + ".%%%%-%%%%-%%%%-%%%%.tmp",
+		errorCode
+	);
+	if (errorCode)
+		return;
+
+	{
+		std::ofstream output(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+		output << _response;
+		if (!output)
+		{
+			output.close();
+			boost::filesystem::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+
+	boost::filesystem::rename(temporaryPath, _path, errorCode);
+	if (errorCode)
+		boost::filesystem::remove(temporaryPath, errorCode);
+}
+
+void SMTSolverCommand::interrupt()
+{
+	std::lock_guard lock(m_mutex);
+	for (auto const& process: m_runningProcesses)
+		process.second();
+}
+
 }
@@ -21,6 +21,13 @@
 
 #include <boost/filesystem.hpp>
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
 namespace solidity::frontend
 {
 
@@ -28,6 +35,9 @@ namespace solidity::frontend
 class SMTSolverCommand
 {
 public:
+	SMTSolverCommand();
+	~SMTSolverCommand();
+
 	/// Calls an SMT solver with the given query.
 	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query) const;
 
@@ -40,10 +50,64 @@ public:
 	void setCvc5(std::optional<unsigned int> timeoutInMilliseconds);
 	void setZ3(std::optional<unsigned int> timeoutInMilliseconds, bool _preprocessing, bool _computeInvariants);
 
+	/// Terminates the solver processes that are currently computing an answer in @a solve(),
+	/// which then returns the output produced so far. Can be called from another thread.
+	void interrupt();
+
+	/// Keeps solver processes alive between queries and resets them instead of starting a new
+	/// process for every query. Only supported for z3, which answers queries interactively.
+	void setPersistentProcesses(bool _enabled);
+
+	/// Stores the definite answers of the solvers as files in the given directory and answers
+	/// repeated queries from there, without calling the solver. The cache is best-effort:
+	/// invalid entries are ignored and failures to write to the directory are not reported.
+	/// Passing std::nullopt disables the cache.
+	void setPersistentCacheDirectory(std::optional<boost::filesystem::path> _directory);
+
 private:
+	/// A solver process that is kept alive between queries.
+	struct PersistentProcess;
+
+	/// Runs a new solver process for the query.
+	/// @returns the output of the solver and false if it was interrupted.
+	std::pair<std::string, bool> runSolver(
+		boost::filesystem::path const& _solverBin,
+		std::vector<std::string> const& _arguments,
+		std::string const& _query
+	) const;
+	/// Sends the query to an idle solver process started with the given command line,
+	/// starting a new one if there is none.
+	/// @returns the output of the solver and false if it did not finish its answer.
+	std::pair<std::string, bool> runPersistentSolver(
+		boost::filesystem::path const& _solverBin,
+		std::string const& _solverCmd,
+		std::vector<std::string> const& _arguments,
+		std::string const& _query
+	) const;
+
+	static boost::filesystem::path persistentCachePath(
+		boost::filesystem::path const& _directory,
+		std::string const& _solverCmd,
+		std::vector<std::string> const& _arguments,
+		std::string const& _query
+	);
+	static std::optional<std::string> loadCachedResponse(boost::filesystem::path const& _path);
+	static void storeCachedResponse(boost::filesystem::path const& _path, std::string const& _response);
+
 	/// The name of the solver's binary.
 	std::string m_solverCmd;
 	std::vector<std::string> m_arguments;
+
+	/// Protects all members, since solve() and interrupt() can be called from different threads.
+	mutable std::mutex m_mutex;
+	/// Functions terminating the running solver processes, by the number of their query.
+	mutable std::map<size_t, std::function<void()>> m_runningProcesses;
+	mutable size_t m_nextQuery = 0;
+
+	bool m_persistentProcesses = false;
+	/// Persistent solver processes that are not answering a query right now.
+	mutable std::vector<std::unique_ptr<PersistentProcess>> m_idleProcesses;
+	std::optional<boost::filesystem::path> m_persistentCacheDirectory;
 };
 
 }
@@ -36,8 +36,11 @@
 
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libsolutil/Cancellation.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 #include <libsolutil/CommonData.h>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -55,6 +58,11 @@ using namespace std::string_literals;
 namespace
 {
 
+/// Maximum number of optimized Yul objects kept by a StandardCompiler that is used repeatedly.
+size_t constexpr c_maxCachedObjects = 1024;
+/// Number of interned Yul strings below which compactCaches() never resets the repository.
+size_t constexpr c_minYulStringsToCompact = 1 << 16;
+
 Json formatError(
 	Error::Type _type,
 	std::string const& _component,
@@ -166,19 +174,24 @@ bool hashMatchesContent(std::string const& _hash, std::string const& _content)
 bool isArtifactRequested(Json const& _outputSelection, std::string const& _artifact, bool _wildcardMatchesExperimental)
 {
 	static std::set<std::string> experimental{"ir", "irAst", "irOptimized", "irOptimizedAst", "yulCFGJson"};
+	// TODO: These outputs are only experimental now, so they are neither matched by "*" nor by a prefix.
+	static std::set<std::string> explicitOnly{
+		"yulCFGJson",
+		"storageAccess",
+		"storageLayoutSuggestion",
+		"evm.gasEstimates.parametric"
+	};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		std::string const& selectedArtifact = selectedArtifactJson.get<std::string>();
-		if (
-			_artifact == selectedArtifact ||
-			boost::algorithm::starts_with(_artifact, selectedArtifact + ".")
-		)
+		if (_artifact == selectedArtifact)
+			return true;
+		else if (explicitOnly.count(_artifact))
+			continue;
+		else if (boost::algorithm::starts_with(_artifact, selectedArtifact + "."))
 			return true;
 		else if (selectedArtifact == "*")
 		{
-			// TODO: yulCFGJson is only experimental now, so it should not be matched by "*".
-			if (_artifact == "yulCFGJson")
-				return false;
 			// "ir", "irOptimized" can only be matched by "*" if activated.
 			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
 				return true;
@@ -252,8 +265,8 @@ bool isBinaryRequested(Json const& _outputSelection)
 	// This does not include "evm.methodIdentifiers" on purpose!
 	static std::vector<std::string> const outputsThatRequireBinaries = std::vector<std::string>{
 		"*",
-		"ir", "irAst", "irOptimized", "irOptimizedAst", "yulCFGJson",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"ir", "irAst", "irOptimized", "irOptimizedAst", "yulCFGJson", "storageAccess",
+		"evm.gasEstimates", "evm.gasEstimates.parametric", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
 	for (auto const& fileRequests: _outputSelection)
@@ -264,22 +277,18 @@ bool isBinaryRequested(Json const& _outputSelection)
 	return false;
 }
 
-/// @returns true if EVM bytecode was requested, i.e. we have to run the old code generator.
-bool isEvmBytecodeRequested(Json const& _outputSelection)
+/// @returns true if EVM bytecode was requested in @a _contractOutputSelection, the array of outputs
+/// selected for a contract, i.e. we have to run the EVM code generator for that contract.
+bool isEvmBytecodeRequested(Json const& _contractOutputSelection)
 {
-	if (!_outputSelection.is_object())
-		return false;
-
 	static std::vector<std::string> const outputsThatRequireEvmBinaries = std::vector<std::string>{
 		"*",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"evm.gasEstimates", "evm.gasEstimates.parametric", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
-	for (auto const& fileRequests: _outputSelection)
-		for (auto const& requests: fileRequests)
-			for (auto const& output: outputsThatRequireEvmBinaries)
-				if (isArtifactRequested(requests, output, false))
-					return true;
+	for (auto const& output: outputsThatRequireEvmBinaries)
+		if (isArtifactRequested(_contractOutputSelection, output, false))
+			return true;
 	return false;
 }
 
@@ -308,14 +317,17 @@ CompilerStack::ContractSelection pipelineConfig(
 					pipelineForContract.irOptimization ||
 					request == "irOptimized" ||
 					request == "irOptimizedAst" ||
-					request == "yulCFGJson";
+					request == "yulCFGJson" ||
+					request == "storageAccess";
 				pipelineForContract.irCodegen =
 					pipelineForContract.irCodegen ||
 					pipelineForContract.irOptimization ||
 					request == "ir" ||
 					request == "irAst";
-				pipelineForContract.bytecode = isEvmBytecodeRequested(_jsonOutputSelection);
 			}
+			// Contracts whose bytecode is only needed by the requested ones, e.g. for ``new``,
+			// are compiled by CompilerStack anyway.
+			pipelineForContract.bytecode = isEvmBytecodeRequested(jsonOutputSelectionForContract);
 			std::string key = (sourceUnitName == "*") ? "" : sourceUnitName;
 			std::string value = (contractName == "*") ? "" : contractName;
 			contractSelection[key][value] = pipelineForContract;
@@ -324,56 +336,6 @@ CompilerStack::ContractSelection pipelineConfig(
 	return contractSelection;
 }
 
-Json formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
-{
-	Json ret = Json::object();
-
-	for (auto const& ref: linkReferences)
-	{
-		std::string const& fullname = ref.second;
-
-		// If the link reference does not contain a colon, assume that the file name is missing and
-		// the whole string represents the library name.
-		size_t colon = fullname.rfind(':');
-		std::string file = (colon != std::string::npos ? fullname.substr(0, colon) : "");
-		std::string name = (colon != std::string::npos ? fullname.substr(colon + 1) : fullname);
-
-		Json fileObject = ret.value(file, Json::object());
-		Json libraryArray = fileObject.value(name, Json::array());
-
-		Json entry;
-		entry["start"] = Json(ref.first);
-		entry["length"] = 20;
-
-		libraryArray.emplace_back(entry);
-		fileObject[name] = libraryArray;
-		ret[file] = fileObject;
-	}
-
-	return ret;
-}
-
-Json formatImmutableReferences(std::map<u256, evmasm::LinkerObject::ImmutableRefs> const& _immutableReferences)
-{
-	Json ret = Json::object();
-
-	for (auto const& immutableReference: _immutableReferences)
-	{
-		auto const& [identifier, byteOffsets] = immutableReference.second;
-		Json array = Json::array();
-		for (size_t byteOffset: byteOffsets)
-		{
-			Json byteRange;
-			byteRange["start"] = Json::number_unsigned_t(byteOffset);
-			byteRange["length"] = Json::number_unsigned_t(32); // immutable references are currently always 32 bytes wide
-			array.emplace_back(byteRange);
-		}
-		ret[identifier] = array;
-	}
-
-	return ret;
-}
-
 Json collectEVMObject(
 	langutil::EVMVersion _evmVersion,
 	evmasm::LinkerObject const& _object,
@@ -393,9 +355,9 @@ Json collectEVMObject(
 	if (_artifactRequested("functionDebugData"))
 		output["functionDebugData"] = StandardCompiler::formatFunctionDebugData(_object.functionDebugData);
 	if (_artifactRequested("linkReferences"))
-		output["linkReferences"] = formatLinkReferences(_object.linkReferences);
+		output["linkReferences"] = StandardCompiler::formatLinkReferences(_object.linkReferences);
 	if (_runtimeObject && _artifactRequested("immutableReferences"))
-		output["immutableReferences"] = formatImmutableReferences(_object.immutableReferences);
+		output["immutableReferences"] = StandardCompiler::formatImmutableReferences(_object.immutableReferences);
 	if (_artifactRequested("generatedSources"))
 		output["generatedSources"] = std::move(_generatedSources);
 	return output;
@@ -433,25 +395,29 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "profiling", "remappings", "stopAfter", "threads", "timeLimit", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json> checkModelCheckerSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"bmcLoopIterations", "chcThreads", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "raceSolvers", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
 std::optional<Json> checkOptimizerKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"details", "enabled", "runs"};
+	static std::set<std::string> keys{"codeSizeTarget", "details", "enabled", "executionProfile", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
 std::optional<Json> checkOptimizerDetailsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement"};
+	static std::set<std::string> keys{
+		"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement",
+		"copyABIDecodedArrays", "decodeReadOnlyStructsFromCalldata", "encodeEventDataInScratchSpace", "splitSelectorSwitch",
+		"useSSACodeTransform", "optimizeCallingConvention", "optimizeFunctionExits"
+	};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -591,6 +557,29 @@ std::variant<OptimiserSettings, Json> parseOptimizerSettings(Json const& _jsonIn
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].get<size_t>();
 	}
 
+	if (_jsonInput.contains("codeSizeTarget"))
+	{
+		if (!_jsonInput["codeSizeTarget"].is_number_unsigned())
+			return formatFatalError(Error::Type::JSONError, "The \"codeSizeTarget\" setting must be an unsigned number.");
+		settings.codeSizeTarget = _jsonInput["codeSizeTarget"].get<size_t>();
+	}
+
+	if (_jsonInput.contains("executionProfile"))
+	{
+		Json const& profile = _jsonInput["executionProfile"];
+		if (!profile.is_object())
+			return formatFatalError(Error::Type::JSONError, "The \"executionProfile\" setting must be an object.");
+		for (auto const& [signature, calls]: profile.items())
+		{
+			if (!calls.is_number_unsigned())
+				return formatFatalError(
+					Error::Type::JSONError,
+					"The number of calls of \"" + signature + "\" in \"executionProfile\" must be an unsigned number."
+				);
+			settings.executionProfile[signature] = calls.get<size_t>();
+		}
+	}
+
 	if (_jsonInput.contains("details"))
 	{
 		Json const& details = _jsonInput["details"];
@@ -615,6 +604,20 @@ std::variant<OptimiserSettings, Json> parseOptimizerSettings(Json const& _jsonIn
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "simpleCounterForLoopUncheckedIncrement", settings.simpleCounterForLoopUncheckedIncrement))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "copyABIDecodedArrays", settings.copyABIDecodedArrays))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "decodeReadOnlyStructsFromCalldata", settings.decodeReadOnlyStructsFromCalldata))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "encodeEventDataInScratchSpace", settings.encodeEventDataInScratchSpace))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "splitSelectorSwitch", settings.splitSelectorSwitch))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "useSSACodeTransform", settings.useSSACodeTransform))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "optimizeCallingConvention", settings.optimizeCallingConvention))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "optimizeFunctionExits", settings.optimizeFunctionExits))
+			return *error;
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
 		if (details.contains("yulDetails"))
 		{
@@ -824,6 +827,34 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("threads"))
+	{
+		if (!settings["threads"].is_number_unsigned() || settings["threads"].get<size_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.threads\" must be a positive integer.");
+		// More threads than the machine can run at the same time do not speed up the compilation.
+		size_t const maxThreads = util::ThreadPool::hardwareConcurrency();
+		if (settings["threads"].get<size_t>() > maxThreads)
+			return formatFatalError(
+				Error::Type::JSONError,
+				"\"settings.threads\" must not exceed the number of hardware threads (" + std::to_string(maxThreads) + ")."
+			);
+		ret.numThreads = settings["threads"].get<size_t>();
+	}
+
+	if (settings.contains("profiling"))
+	{
+		if (!settings["profiling"].is_boolean())
+			return formatFatalError(Error::Type::JSONError, "\"settings.profiling\" must be a Boolean.");
+		ret.profiling = settings["profiling"].get<bool>();
+	}
+
+	if (settings.contains("timeLimit"))
+	{
+		if (!settings["timeLimit"].is_number_unsigned() || settings["timeLimit"].get<uint64_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.timeLimit\" must be a positive integer.");
+		ret.timeLimit = std::chrono::milliseconds(settings["timeLimit"].get<uint64_t>());
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -1066,6 +1097,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.bmcLoopIterations must be an unsigned integer.");
 	}
 
+	if (modelCheckerSettings.contains("chcThreads"))
+	{
+		if (!modelCheckerSettings["chcThreads"].is_number_unsigned() || modelCheckerSettings["chcThreads"].get<unsigned>() == 0)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.chcThreads must be a positive integer.");
+		ret.modelCheckerSettings.chcThreads = modelCheckerSettings["chcThreads"].get<unsigned>();
+	}
+
 	if (modelCheckerSettings.contains("extCalls"))
 	{
 		if (!modelCheckerSettings["extCalls"].is_string())
@@ -1097,6 +1135,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.contains("raceSolvers"))
+	{
+		auto const& raceSolvers = modelCheckerSettings["raceSolvers"];
+		if (!raceSolvers.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.raceSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.raceSolvers = raceSolvers.get<bool>();
+	}
+
 	if (modelCheckerSettings.contains("showProvedSafe"))
 	{
 		auto const& showProvedSafe = modelCheckerSettings["showProvedSafe"];
@@ -1306,7 +1352,14 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
-	CompilerStack compilerStack(m_readFile);
+	std::optional<util::Profiler> profiler;
+	if (_inputsAndSettings.profiling)
+		profiler.emplace();
+	util::Profiler::Activation profilerActivation(profiler.has_value() ? &profiler.value() : nullptr);
+
+	CompilerStack compilerStack(m_readFile, m_objectOptimizer);
+	if (m_batchReadFile)
+		compilerStack.setBatchReadCallback(m_batchReadFile);
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Solidity")
@@ -1314,6 +1367,8 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setNumThreads(_inputsAndSettings.numThreads);
+	compilerStack.setCacheDirectory(m_cacheDirectory);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setEOFVersion(_inputsAndSettings.eofVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
@@ -1344,6 +1399,10 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 				if (binariesRequested)
 					compilerStack.compile();
 			}
+			catch (util::CompilationCancelled const&)
+			{
+				throw;
+			}
 			catch (util::Exception const& _exc)
 			{
 				solThrow(util::Exception, "Failed to import AST: "s + _exc.what());
@@ -1392,6 +1451,11 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		// let StandardCompiler::compile handle this
 		throw _exception;
 	}
+	catch (util::CompilationCancelled const&)
+	{
+		// let StandardCompiler::compile handle this
+		throw;
+	}
 	catch (yul::YulException const& _exception)
 	{
 		errors.emplace_back(formatErrorWithException(
@@ -1454,7 +1518,10 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
 				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
+			if (m_outputChunkCallback)
+				m_outputChunkCallback({{"sources", {{sourceName, std::move(sourceResult)}}}});
+			else
+				output["sources"][sourceName] = sourceResult;
 		}
 
 	Json contractsOutput;
@@ -1473,6 +1540,8 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "transientStorageLayout", false))
 			contractData["transientStorageLayout"] = compilerStack.transientStorageLayout(contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayoutSuggestion", false))
+			contractData["storageLayoutSuggestion"] = compilerStack.storageLayoutSuggestion(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
 			contractData["metadata"] = compilerStack.metadata(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
@@ -1491,6 +1560,8 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "yulCFGJson", wildcardMatchesExperimental))
 			contractData["yulCFGJson"] = compilerStack.yulCFGJson(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageAccess", wildcardMatchesExperimental))
+			contractData["storageAccess"] = compilerStack.storageAccess(contractName);
 
 		// EVM
 		Json evmData;
@@ -1500,8 +1571,12 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
 			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+		bool parametricGasEstimatesRequested = isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates.parametric", false);
+		if (
+			compilationSuccess &&
+			(isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental) || parametricGasEstimatesRequested)
+		)
+			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName, parametricGasEstimatesRequested);
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
@@ -1550,7 +1625,9 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
-		if (!contractData.empty())
+		if (!contractData.empty() && m_outputChunkCallback)
+			m_outputChunkCallback({{"contracts", {{file, {{name, std::move(contractData)}}}}}});
+		else if (!contractData.empty())
 		{
 			if (!contractsOutput.contains(file))
 				contractsOutput[file] = Json::object();
@@ -1560,6 +1637,9 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (profiler.has_value())
+		output["profiling"] = profiler->chromeTrace();
+
 	return output;
 }
 
@@ -1608,6 +1688,12 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		return output;
 	}
 
+	std::optional<util::Profiler> profiler;
+	if (_inputsAndSettings.profiling)
+		profiler.emplace();
+	util::Profiler::Activation profilerActivation(profiler.has_value() ? &profiler.value() : nullptr);
+
+	m_objectOptimizer->setPersistentCacheDirectory(m_cacheDirectory, VersionString);
 	YulStack stack(
 		_inputsAndSettings.evmVersion,
 		_inputsAndSettings.eofVersion,
@@ -1615,7 +1701,9 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		_inputsAndSettings.optimiserSettings,
 		_inputsAndSettings.debugInfoSelection.has_value() ?
 			_inputsAndSettings.debugInfoSelection.value() :
-			DebugInfoSelection::Default()
+			DebugInfoSelection::Default(),
+		nullptr, // _soliditySourceProvider
+		m_objectOptimizer
 	);
 	std::string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	std::string const& sourceContents = _inputsAndSettings.sources.begin()->second;
@@ -1698,12 +1786,41 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "yulCFGJson", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["yulCFGJson"] = stack.cfgJson();
 
+	if (profiler.has_value())
+		output["profiling"] = profiler->chromeTrace();
+
 	return output;
 }
 
-Json StandardCompiler::compile(Json const& _input) noexcept
+void StandardCompiler::compactCaches()
 {
+	size_t const yulStrings = YulStringRepository::instance().size();
+	if (!m_yulStringsAfterCompaction.has_value())
+	{
+		// The names needed by the first compilation after a compaction are the baseline.
+		m_yulStringsAfterCompaction = yulStrings;
+		return;
+	}
+	if (
+		m_objectOptimizer->size() <= c_maxCachedObjects &&
+		yulStrings <= std::max(c_minYulStringsToCompact, 2 * *m_yulStringsAfterCompaction)
+	)
+		return;
+
+	// The cached objects refer to the names in the repository.
+	m_objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
 	YulStringRepository::reset();
+	m_yulStringsAfterCompaction.reset();
+}
+
+Json StandardCompiler::compile(Json const& _input) noexcept
+{
+	if (m_resetYulStringRepository)
+	{
+		// The cached objects refer to the names in the repository.
+		m_objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+		YulStringRepository::reset();
+	}
 
 	try
 	{
@@ -1711,6 +1828,13 @@ Json StandardCompiler::compile(Json const& _input) noexcept
 		if (std::holds_alternative<Json>(parsed))
 			return std::get<Json>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+		// Without a time limit, a token activated by the caller stays active.
+		std::optional<util::CancellationToken> cancellationToken;
+		if (settings.timeLimit)
+			cancellationToken.emplace(*settings.timeLimit, util::CancellationToken::active());
+		util::CancellationToken::Activation cancellationActivation(
+			cancellationToken.has_value() ? &cancellationToken.value() : util::CancellationToken::active()
+		);
 		if (settings.language == "Solidity")
 			return compileSolidity(std::move(settings));
 		else if (settings.language == "Yul")
@@ -1727,6 +1851,10 @@ Json StandardCompiler::compile(Json const& _input) noexcept
 		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
 		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
 	}
+	catch (util::CompilationCancelled const& _exception)
+	{
+		return formatFatalError(Error::Type::FatalError, stringOrDefault(_exception.comment()));
+	}
 	catch (...)
 	{
 		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
@@ -1788,3 +1916,53 @@ Json StandardCompiler::formatFunctionDebugData(
 
 	return ret;
 }
+
+Json StandardCompiler::formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
+{
+	Json ret = Json::object();
+
+	for (auto const& ref: linkReferences)
+	{
+		std::string const& fullname = ref.second;
+
+		// If the link reference does not contain a colon, assume that the file name is missing and
+		// the whole string represents the library name.
+		size_t colon = fullname.rfind(':');
+		std::string file = (colon != std::string::npos ? fullname.substr(0, colon) : "");
+		std::string name = (colon != std::string::npos ? fullname.substr(colon + 1) : fullname);
+
+		Json fileObject = ret.value(file, Json::object());
+		Json libraryArray = fileObject.value(name, Json::array());
+
+		Json entry;
+		entry["start"] = Json(ref.first);
+		entry["length"] = 20;
+
+		libraryArray.emplace_back(entry);
+		fileObject[name] = libraryArray;
+		ret[file] = fileObject;
+	}
+
+	return ret;
+}
+
+Json StandardCompiler::formatImmutableReferences(std::map<u256, evmasm::LinkerObject::ImmutableRefs> const& _immutableReferences)
+{
+	Json ret = Json::object();
+
+	for (auto const& immutableReference: _immutableReferences)
+	{
+		auto const& [identifier, byteOffsets] = immutableReference.second;
+		Json array = Json::array();
+		for (size_t byteOffset: byteOffsets)
+		{
+			Json byteRange;
+			byteRange["start"] = Json::number_unsigned_t(byteOffset);
+			byteRange["length"] = Json::number_unsigned_t(32); // immutable references are currently always 32 bytes wide
+			array.emplace_back(byteRange);
+		}
+		ret[identifier] = array;
+	}
+
+	return ret;
+}
@@ -28,6 +28,8 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <chrono>
+#include <functional>
 #include <optional>
 #include <utility>
 #include <variant>
@@ -49,6 +51,8 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
+	/// Every call to compile() resets the YulString repository and drops the optimized Yul
+	/// objects cached by the previous call, unless keepYulStringRepository() was called.
 	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback(),
 		util::JsonFormat const& _format = {}):
 		m_readFile(std::move(_readFile)),
@@ -63,9 +67,40 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Makes compile() pass the output of every Solidity source and contract to @a _callback as
+	/// soon as it has been produced, instead of including it in the returned output.
+	/// The chunks have the form {"sources": {<source>: ...}} or {"contracts": {<source>: {<contract>: ...}}},
+	/// so that merging them into the returned output yields the usual output.
+	void setOutputChunkCallback(std::function<void(Json)> _callback) { m_outputChunkCallback = std::move(_callback); }
+
+	/// Sets a callback that reads all imports of a group of sources at once, so that the
+	/// caller can load them concurrently. The read callback is still used for the imports it
+	/// did not load successfully.
+	void setBatchReadCallback(ReadCallback::BatchCallback _batchReadFile) { m_batchReadFile = std::move(_batchReadFile); }
+
+	/// Makes compile() leave the YulString repository untouched. The optimized Yul objects are
+	/// then cached for the lifetime of the StandardCompiler, so that later calls to compile()
+	/// can reuse them. Required when other compilations may run concurrently, since resetting
+	/// the repository is not thread-safe. The caller is responsible for resetting it instead,
+	/// e.g. through compactCaches().
+	void keepYulStringRepository() { m_resetYulStringRepository = false; }
+
+	/// Bounds the memory kept across calls to compile() after keepYulStringRepository(): drops the
+	/// cached Yul objects and resets the YulString repository once there are too many cached objects
+	/// or the repository has grown to more than twice its size after the first compilation following
+	/// the last compaction. Must only be called while no other compilation uses the repository.
+	void compactCaches();
+
+	/// Sets the directory in which optimized Yul code is stored for reuse by later compiler runs
+	/// (see CompilerStack::setCacheDirectory()). There is no corresponding setting in the input,
+	/// so that the input cannot make the compiler read or write files outside of the allowed paths.
+	void setCacheDirectory(std::optional<boost::filesystem::path> _cacheDirectory) { m_cacheDirectory = std::move(_cacheDirectory); }
+
 	static Json formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 	);
+	static Json formatLinkReferences(std::map<size_t, std::string> const& linkReferences);
+	static Json formatImmutableReferences(std::map<u256, evmasm::LinkerObject::ImmutableRefs> const& _immutableReferences);
 
 private:
 	struct InputsAndSettings
@@ -89,6 +124,9 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t numThreads = 1;
+		bool profiling = false;
+		std::optional<std::chrono::milliseconds> timeLimit;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
@@ -101,8 +139,19 @@ private:
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	ReadCallback::BatchCallback m_batchReadFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::function<void(Json)> m_outputChunkCallback;
+
+	bool m_resetYulStringRepository = true;
+	/// Number of interned Yul strings after the first compilation following the last compaction,
+	/// not set until compactCaches() is called after that compilation.
+	std::optional<size_t> m_yulStringsAfterCompaction;
+	std::optional<boost::filesystem::path> m_cacheDirectory;
+
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
 };
 
 }
@@ -0,0 +1,218 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/StorageAccess.h>
+
+#include <libsolidity/ast/Types.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Object.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <set>
+
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// Finds the switch of the function dispatcher, i.e. the first switch outside of functions
+/// with a case for one of the given selectors.
+class DispatcherFinder: public yul::ASTWalker
+{
+public:
+	explicit DispatcherFinder(std::set<u256> const& _selectors): m_selectors(_selectors) {}
+
+	using yul::ASTWalker::operator();
+	void operator()(yul::FunctionDefinition const&) override {}
+	void operator()(yul::Switch const& _switch) override
+	{
+		if (!dispatcher)
+			for (yul::Case const& switchCase: _switch.cases)
+				if (switchCase.value && m_selectors.count(switchCase.value->value.value()))
+				{
+					dispatcher = &_switch;
+					return;
+				}
+		yul::ASTWalker::operator()(_switch);
+	}
+
+	yul::Switch const* dispatcher = nullptr;
+
+private:
+	std::set<u256> const& m_selectors;
+};
+
+/// Collects the storage accesses of code, including the ones of the functions it calls.
+class AccessCollector: public yul::ASTWalker
+{
+public:
+	AccessCollector(
+		yul::Dialect const& _dialect,
+		std::map<yul::YulName, yul::FunctionDefinition const*> const& _functions,
+		yul::KnowledgeBase& _knowledgeBase
+	):
+		m_dialect(_dialect),
+		m_functions(_functions),
+		m_knowledgeBase(_knowledgeBase)
+	{}
+
+	using yul::ASTWalker::operator();
+	void operator()(yul::FunctionDefinition const&) override {}
+	void operator()(yul::FunctionCall const& _functionCall) override
+	{
+		yul::ASTWalker::operator()(_functionCall);
+
+		yul::YulName functionName = _functionCall.functionName.name;
+		if (m_dialect.builtin(functionName))
+		{
+			switch (yul::toEVMInstruction(m_dialect, functionName).value_or(evmasm::Instruction::STOP))
+			{
+			case evmasm::Instruction::SLOAD:
+				addAccess(_functionCall.arguments.at(0), reads, dynamicReads);
+				break;
+			case evmasm::Instruction::SSTORE:
+				addAccess(_functionCall.arguments.at(0), writes, dynamicWrites);
+				break;
+			case evmasm::Instruction::DELEGATECALL:
+			case evmasm::Instruction::CALLCODE:
+				// The called code runs on the storage of this contract.
+				dynamicReads = true;
+				dynamicWrites = true;
+				break;
+			default:
+				break;
+			}
+		}
+		else if (yul::FunctionDefinition const* const* function = util::valueOrNullptr(m_functions, functionName))
+			// Every function is only visited once, so accesses in functions called multiple
+			// times are only counted once.
+			if (m_visitedFunctions.insert(functionName).second)
+				(*this)((*function)->body);
+	}
+
+	std::set<u256> reads;
+	std::set<u256> writes;
+	bool dynamicReads = false;
+	bool dynamicWrites = false;
+	/// Number of accesses to constant slots in the code, not taking loops and branches into account.
+	size_t accesses = 0;
+
+private:
+	void addAccess(yul::Expression const& _slot, std::set<u256>& _slots, bool& _dynamic)
+	{
+		if (std::optional<u256> slot = m_knowledgeBase.valueIfKnownConstant(_slot))
+		{
+			_slots.insert(*slot);
+			++accesses;
+		}
+		else
+			_dynamic = true;
+	}
+
+	yul::Dialect const& m_dialect;
+	std::map<yul::YulName, yul::FunctionDefinition const*> const& m_functions;
+	yul::KnowledgeBase& m_knowledgeBase;
+	std::set<yul::YulName> m_visitedFunctions;
+};
+
+Json slotsToJson(std::set<u256> const& _slots)
+{
+	Json result = Json::array();
+	for (u256 const& slot: _slots)
+		result.emplace_back(slot.str());
+	return result;
+}
+
+}
+
+Json StorageAccess::generate(
+	ContractDefinition const& _contract,
+	yul::Object const& _deployedObject,
+	yul::Dialect const& _dialect
+)
+{
+	solAssert(_deployedObject.hasCode());
+	solAssert(_deployedObject.analysisInfo);
+
+	// Names are not unique in printed IR, but have to be for the SSA values to be valid.
+	yul::Block const code = std::get<yul::Block>(yul::Disambiguator(
+		_dialect,
+		*_deployedObject.analysisInfo
+	)(_deployedObject.code()->root()));
+
+	yul::SSAValueTracker ssaValues;
+	ssaValues(code);
+	std::map<yul::YulName, yul::AssignedValue> values;
+	for (auto const& [name, expression]: ssaValues.values())
+		values[name] = yul::AssignedValue{expression, {}};
+	yul::KnowledgeBase knowledgeBase{values};
+	std::map<yul::YulName, yul::FunctionDefinition const*> const functions = yul::allFunctionDefinitions(code);
+
+	std::map<u256, FunctionTypePointer> externalFunctions;
+	std::set<u256> selectors;
+	for (auto const& [selector, functionType]: _contract.interfaceFunctions())
+	{
+		u256 selectorValue = u256(util::FixedHash<4>::Arith(selector));
+		externalFunctions[selectorValue] = functionType;
+		selectors.insert(selectorValue);
+	}
+
+	Json result = Json::object();
+	DispatcherFinder dispatcherFinder{selectors};
+	dispatcherFinder(code);
+	if (!dispatcherFinder.dispatcher)
+		return result;
+
+	for (yul::Case const& switchCase: dispatcherFinder.dispatcher->cases)
+	{
+		if (!switchCase.value)
+			continue;
+		auto externalFunction = externalFunctions.find(switchCase.value->value.value());
+		if (externalFunction == externalFunctions.end())
+			continue;
+
+		AccessCollector collector{_dialect, functions, knowledgeBase};
+		collector(switchCase.body);
+
+		std::set<u256> accessedSlots = collector.reads;
+		accessedSlots += collector.writes;
+		Json access;
+		access["reads"] = slotsToJson(collector.reads);
+		access["writes"] = slotsToJson(collector.writes);
+		access["dynamicReads"] = collector.dynamicReads;
+		access["dynamicWrites"] = collector.dynamicWrites;
+		// The first access to each slot is cold, all further ones are warm.
+		access["coldAccesses"] = accessedSlots.size();
+		access["warmAccesses"] = collector.accesses - accessedSlots.size();
+		result[externalFunction->second->externalSignature()] = std::move(access);
+	}
+	return result;
+}
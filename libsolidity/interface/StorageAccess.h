@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Generates a summary of the storage slots accessed by the external functions of a contract.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+#include <libsolidity/ast/AST.h>
+
+namespace solidity::yul
+{
+struct Dialect;
+struct Object;
+}
+
+namespace solidity::frontend
+{
+
+class StorageAccess
+{
+public:
+	/// Generates the storage slots read and written by each external function of the contract,
+	/// determined statically from the (optimized) IR of its deployed object.
+	/// Only slots that are constant after optimization are listed. Accesses to other slots
+	/// (e.g. of mappings and dynamic arrays) are only reported as being present.
+	/// @param _contract The contract definition
+	/// @param _deployedObject The Yul object of the deployed code of the contract
+	/// @param _dialect The dialect of @a _deployedObject
+	/// @return A JSON object mapping the signatures of the external functions to their accesses.
+	Json generate(
+		ContractDefinition const& _contract,
+		yul::Object const& _deployedObject,
+		yul::Dialect const& _dialect
+	);
+};
+
+}
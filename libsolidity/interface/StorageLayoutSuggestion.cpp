@@ -0,0 +1,296 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/StorageLayoutSuggestion.h>
+
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/CallGraph.h>
+#include <libsolidity/ast/Types.h>
+
+#include <range/v3/view/reverse.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+bool isStorageVariable(VariableDeclaration const& _variable)
+{
+	return
+		_variable.isStateVariable() &&
+		!_variable.isConstant() &&
+		!_variable.immutable() &&
+		_variable.referenceLocation() == VariableDeclaration::Location::Unspecified;
+}
+
+/// Collects the storage variables referenced in a function or modifier, without following calls.
+class StorageVariableCollector: public ASTConstVisitor
+{
+public:
+	void endVisit(Identifier const& _identifier) override
+	{
+		add(_identifier.annotation().referencedDeclaration);
+	}
+	void endVisit(MemberAccess const& _memberAccess) override
+	{
+		add(_memberAccess.annotation().referencedDeclaration);
+	}
+
+	std::set<VariableDeclaration const*, ASTNode::CompareByID> variables;
+
+private:
+	void add(Declaration const* _declaration)
+	{
+		if (auto const* variable = dynamic_cast<VariableDeclaration const*>(_declaration))
+			if (isStorageVariable(*variable))
+				variables.insert(variable);
+	}
+};
+
+}
+
+Json StorageLayoutSuggestion::generate(ContractDefinition const& _contract)
+{
+	solAssert(m_accesses.empty());
+	solAssert(_contract.annotation().deployedCallGraph.set());
+	CallGraph const& callGraph = **_contract.annotation().deployedCallGraph;
+
+	std::map<CallableDeclaration const*, std::set<VariableDeclaration const*, ASTNode::CompareByID>> directAccesses;
+	for (auto const& [node, callees]: callGraph.edges)
+		if (auto const* callable = std::get_if<CallableDeclaration const*>(&node))
+		{
+			StorageVariableCollector collector;
+			(*callable)->accept(collector);
+			directAccesses[*callable] = std::move(collector.variables);
+		}
+
+	auto addEntryPoint = [&](Declaration const* _declaration) {
+		std::set<VariableDeclaration const*, ASTNode::CompareByID> accesses;
+		// Getters of public state variables only access the variable itself.
+		if (auto const* variable = dynamic_cast<VariableDeclaration const*>(_declaration))
+			accesses.insert(variable);
+		else if (auto const* callable = dynamic_cast<CallableDeclaration const*>(_declaration))
+		{
+			std::set<CallGraph::Node, CallGraph::CompareByID> visited;
+			std::vector<CallGraph::Node> toVisit{callable};
+			while (!toVisit.empty())
+			{
+				CallGraph::Node node = toVisit.back();
+				toVisit.pop_back();
+				if (!visited.insert(node).second)
+					continue;
+				if (auto const* visitedCallable = std::get_if<CallableDeclaration const*>(&node))
+					if (auto const* variables = util::valueOrNullptr(directAccesses, *visitedCallable))
+						accesses += *variables;
+				if (auto const* callees = util::valueOrNullptr(callGraph.edges, node))
+					toVisit.insert(toVisit.end(), callees->begin(), callees->end());
+			}
+		}
+		m_accesses.emplace_back(std::move(accesses));
+	};
+	for (auto const& [selector, function]: _contract.interfaceFunctionList())
+		addEntryPoint(&function->declaration());
+	if (FunctionDefinition const* fallback = _contract.fallbackFunction())
+		addEntryPoint(fallback);
+	if (FunctionDefinition const* receive = _contract.receiveFunction())
+		addEntryPoint(receive);
+
+	std::vector<VariableDeclaration const*> inheritedVariables;
+	std::vector<VariableDeclaration const*> ownVariables;
+	for (ContractDefinition const* contract: _contract.annotation().linearizedBaseContracts | ranges::views::reverse)
+		for (VariableDeclaration const* variable: contract->stateVariables())
+			if (isStorageVariable(*variable))
+				(contract == &_contract ? ownVariables : inheritedVariables).push_back(variable);
+
+	auto [currentOffsets, currentSlots] = offsets(inheritedVariables + ownVariables);
+	size_t currentAccesses = slotAccesses(currentOffsets);
+
+	std::vector<VariableDeclaration const*> suggestedVariables = inheritedVariables + reorder(ownVariables);
+	auto [suggestedOffsets, suggestedSlots] = offsets(suggestedVariables);
+	size_t suggestedAccesses = slotAccesses(suggestedOffsets);
+	// Packing groups is only an approximation of the actual layout, so keep the order of the
+	// declarations if the suggestion turns out not to be better.
+	if (std::make_pair(suggestedAccesses, suggestedSlots) >= std::make_pair(currentAccesses, currentSlots))
+	{
+		suggestedVariables = inheritedVariables + ownVariables;
+		suggestedOffsets = currentOffsets;
+		suggestedSlots = currentSlots;
+		suggestedAccesses = currentAccesses;
+	}
+
+	Json storage = Json::array();
+	for (VariableDeclaration const* variable: suggestedVariables)
+	{
+		auto const& [slot, offset] = suggestedOffsets.at(variable);
+		Json entry;
+		entry["label"] = variable->name();
+		entry["astId"] = static_cast<int>(variable->id());
+		if (auto const* contract = dynamic_cast<ContractDefinition const*>(variable->scope()))
+			entry["contract"] = contract->fullyQualifiedName();
+		entry["slot"] = slot.str();
+		entry["offset"] = offset;
+		entry["type"] = variable->type()->toString(true);
+		entry["moved"] = slot != currentOffsets.at(variable).first || offset != currentOffsets.at(variable).second;
+		storage.emplace_back(std::move(entry));
+	}
+
+	Json result;
+	result["storage"] = std::move(storage);
+	result["current"]["slots"] = currentSlots.str();
+	result["current"]["slotAccesses"] = currentAccesses;
+	result["suggested"]["slots"] = suggestedSlots.str();
+	result["suggested"]["slotAccesses"] = suggestedAccesses;
+	return result;
+}
+
+std::pair<StorageLayoutSuggestion::Offsets, u256> StorageLayoutSuggestion::offsets(
+	std::vector<VariableDeclaration const*> const& _variables
+)
+{
+	TypePointers types;
+	for (VariableDeclaration const* variable: _variables)
+		types.push_back(variable->annotation().type);
+	StorageOffsets storageOffsets;
+	storageOffsets.computeOffsets(types);
+
+	Offsets result;
+	for (size_t index = 0; index < _variables.size(); ++index)
+		if (auto const* offset = storageOffsets.offset(index))
+			result[_variables[index]] = *offset;
+	return {std::move(result), storageOffsets.storageSize()};
+}
+
+size_t StorageLayoutSuggestion::slotAccesses(Offsets const& _offsets) const
+{
+	size_t accesses = 0;
+	for (auto const& variables: m_accesses)
+	{
+		std::set<u256> slots;
+		for (VariableDeclaration const* variable: variables)
+			if (auto const* offset = util::valueOrNullptr(_offsets, variable))
+				slots.insert(offset->first);
+		accesses += slots.size();
+	}
+	return accesses;
+}
+
+std::vector<VariableDeclaration const*> StorageLayoutSuggestion::reorder(
+	std::vector<VariableDeclaration const*> const& _variables
+) const
+{
+	auto bytes = [&](size_t _index) { return _variables[_index]->type()->storageBytes(); };
+	auto packable = [&](size_t _index) {
+		Type const* type = _variables[_index]->type();
+		return type->storageSize() == 1 && type->storageBytes() < 32;
+	};
+
+	std::map<VariableDeclaration const*, size_t> indices;
+	for (size_t index = 0; index < _variables.size(); ++index)
+		indices[_variables[index]] = index;
+
+	// Number of entry points accessing both variables of a pair.
+	std::map<std::pair<size_t, size_t>, size_t> weights;
+	for (auto const& variables: m_accesses)
+	{
+		std::vector<size_t> accessed;
+		for (VariableDeclaration const* variable: variables)
+			if (auto const* index = util::valueOrNullptr(indices, variable))
+				if (packable(*index))
+					accessed.push_back(*index);
+		std::sort(accessed.begin(), accessed.end());
+		for (size_t i = 0; i < accessed.size(); ++i)
+			for (size_t j = i + 1; j < accessed.size(); ++j)
+				++weights[{accessed[i], accessed[j]}];
+	}
+	std::vector<std::pair<std::pair<size_t, size_t>, size_t>> pairs(weights.begin(), weights.end());
+	std::stable_sort(pairs.begin(), pairs.end(), [](auto const& _a, auto const& _b) { return _a.second > _b.second; });
+
+	// Greedily merge the groups of the pairs accessed together most often, as long as they fit into a slot.
+	std::vector<size_t> group(_variables.size());
+	std::iota(group.begin(), group.end(), 0);
+	std::vector<std::vector<size_t>> members(_variables.size());
+	std::vector<unsigned> groupBytes(_variables.size(), 0);
+	for (size_t index = 0; index < _variables.size(); ++index)
+	{
+		members[index] = {index};
+		groupBytes[index] = bytes(index);
+	}
+	for (auto const& [pair, weight]: pairs)
+	{
+		size_t first = group[pair.first];
+		size_t second = group[pair.second];
+		if (first == second || groupBytes[first] + groupBytes[second] > 32)
+			continue;
+		for (size_t index: members[second])
+			group[index] = first;
+		members[first] += members[second];
+		members[second].clear();
+		groupBytes[first] += groupBytes[second];
+		groupBytes[second] = 0;
+	}
+
+	// Pack the groups that are not accessed together into as few slots as possible (first fit decreasing).
+	std::vector<size_t> packableGroups;
+	std::vector<std::vector<size_t>> slots;
+	for (size_t index = 0; index < _variables.size(); ++index)
+		if (!members[index].empty())
+		{
+			if (packable(index))
+				packableGroups.push_back(index);
+			else
+				slots.push_back(members[index]);
+		}
+	std::stable_sort(packableGroups.begin(), packableGroups.end(), [&](size_t _a, size_t _b) {
+		return groupBytes[_a] > groupBytes[_b];
+	});
+	std::vector<unsigned> slotBytes(slots.size(), 32);
+	for (size_t packableGroup: packableGroups)
+	{
+		size_t slot = 0;
+		while (slot < slots.size() && slotBytes[slot] + groupBytes[packableGroup] > 32)
+			++slot;
+		if (slot == slots.size())
+		{
+			slots.emplace_back();
+			slotBytes.push_back(0);
+		}
+		slots[slot] += members[packableGroup];
+		slotBytes[slot] += groupBytes[packableGroup];
+	}
+
+	// Keep the slots in the order of their first declared variable and put larger variables first,
+	// which makes it less likely that a variable is moved into the remaining space of the previous slot.
+	for (std::vector<size_t>& slot: slots)
+		std::stable_sort(slot.begin(), slot.end(), [&](size_t _a, size_t _b) {
+			return std::make_pair(-int(bytes(_a)), _a) < std::make_pair(-int(bytes(_b)), _b);
+		});
+	std::stable_sort(slots.begin(), slots.end(), [](auto const& _a, auto const& _b) {
+		return *std::min_element(_a.begin(), _a.end()) < *std::min_element(_b.begin(), _b.end());
+	});
+
+	std::vector<VariableDeclaration const*> result;
+	for (std::vector<size_t> const& slot: slots)
+		for (size_t index: slot)
+			result.push_back(_variables[index]);
+	solAssert(result.size() == _variables.size());
+	return result;
+}
@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Suggests an order of the state variables of a contract that packs variables which are
+ * accessed together into the same storage slots.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+#include <libsolidity/ast/AST.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+class StorageLayoutSuggestion
+{
+public:
+	/// Generates a suggested order of the storage variables declared in the contract.
+	///
+	/// The variables accessed by every external function (including the functions and modifiers
+	/// it calls internally) are determined from the deployed call graph. Variables smaller than a
+	/// slot that are accessed by the same functions are greedily grouped into one slot, so that
+	/// the number of distinct slots touched by each function is reduced. Groups that are not
+	/// accessed together are then packed into as few slots as possible.
+	///
+	/// Variables inherited from base contracts are never moved, since their layout may be shared
+	/// with other derived contracts or with already deployed code behind a proxy. Only the
+	/// variables declared in the contract itself are reordered.
+	/// @param _contract The contract definition
+	/// @return A JSON object with the suggested layout and the current and suggested number of
+	/// slots and of slot accesses summed over all external functions.
+	Json generate(ContractDefinition const& _contract);
+
+private:
+	using Offsets = std::map<VariableDeclaration const*, std::pair<u256, unsigned>>;
+
+	/// @returns the slot and offset of every variable and the number of slots if the storage
+	/// variables are declared in the order @a _variables.
+	static std::pair<Offsets, u256> offsets(std::vector<VariableDeclaration const*> const& _variables);
+	/// @returns the number of distinct slots touched summed over all entry points.
+	size_t slotAccesses(Offsets const& _offsets) const;
+	/// @returns the suggested order of @a _variables, which are the variables declared in the
+	/// contract itself.
+	std::vector<VariableDeclaration const*> reorder(std::vector<VariableDeclaration const*> const& _variables) const;
+
+	/// The storage variables accessed by each external function, fallback or receive function.
+	std::vector<std::set<VariableDeclaration const*, ASTNode::CompareByID>> m_accesses;
+};
+
+}
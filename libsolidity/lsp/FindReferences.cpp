@@ -0,0 +1,50 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/FindReferences.h>
+#include <libsolidity/lsp/SymbolIndex.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+
+void FindReferences::operator()(MessageID _id, Json const& _args)
+{
+	auto const [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
+	bool const includeDeclaration =
+		_args.contains("context") &&
+		_args["context"].contains("includeDeclaration") &&
+		_args["context"]["includeDeclaration"].get<bool>();
+
+	auto const [sourceNode, sourceOffset] = m_server.astNodeAndOffsetAtSourceLocation(sourceUnitName, lineColumn);
+
+	std::vector<SourceLocation> locations;
+	if (sourceNode)
+		if (std::optional<SymbolIndex::Symbol> symbol = SymbolIndex::symbolAt(*sourceNode, sourceOffset))
+			for (SymbolIndex::Reference const& reference: m_server.symbolIndex().references(*symbol->declaration))
+				if (includeDeclaration || reference.location != symbol->declaration->nameLocation())
+					locations.emplace_back(reference.location);
+	std::sort(locations.begin(), locations.end());
+
+	Json reply = Json::array();
+	for (SourceLocation const& location: locations)
+		reply.emplace_back(toJson(location));
+	client().reply(_id, reply);
+}
@@ -26,10 +26,13 @@
 
 // LSP feature implementations
 #include <libsolidity/lsp/DocumentHoverHandler.h>
+#include <libsolidity/lsp/FindReferences.h>
 #include <libsolidity/lsp/GotoDefinition.h>
 #include <libsolidity/lsp/RenameSymbol.h>
 #include <libsolidity/lsp/SemanticTokensBuilder.h>
 
+#include <libyul/YulString.h>
+
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
 
@@ -39,8 +42,10 @@
 
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <string>
 
@@ -59,6 +64,9 @@ namespace fs = boost::filesystem;
 namespace
 {
 
+/// Number of interned Yul strings below which they are never compacted.
+size_t constexpr c_minYulStringsToCompact = 1 << 16;
+
 bool resolvesToRegularFile(boost::filesystem::path _path, int maxRecursionDepth = 10)
 {
 	fs::file_status fileStatus = fs::status(_path);
@@ -129,6 +137,32 @@ Json semanticTokensLegend()
 	return legend;
 }
 
+/// @returns the LSP SymbolKind of @a _declaration.
+int toSymbolKind(Declaration const& _declaration)
+{
+	// 5=Class, 6=Method, 8=Field, 10=Enum, 11=Interface, 12=Function,
+	// 14=Constant, 22=EnumMember, 23=Struct, 24=Event, 26=TypeParameter
+	if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_declaration))
+		return contract->isInterface() ? 11 : 5;
+	else if (auto const* function = dynamic_cast<FunctionDefinition const*>(&_declaration))
+		return function->isFree() ? 12 : 6;
+	else if (auto const* variable = dynamic_cast<VariableDeclaration const*>(&_declaration))
+		return variable->isConstant() ? 14 : 8;
+	else if (dynamic_cast<ModifierDefinition const*>(&_declaration))
+		return 6;
+	else if (dynamic_cast<StructDefinition const*>(&_declaration))
+		return 23;
+	else if (dynamic_cast<EnumDefinition const*>(&_declaration))
+		return 10;
+	else if (dynamic_cast<EnumValue const*>(&_declaration))
+		return 22;
+	else if (dynamic_cast<UserDefinedValueTypeDefinition const*>(&_declaration))
+		return 26;
+	else
+		// Events and errors
+		return 24;
+}
+
 }
 
 LanguageServer::LanguageServer(Transport& _transport):
@@ -146,14 +180,22 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/didChange", std::bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", std::bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
 		{"textDocument/hover", DocumentHoverHandler(*this) },
+		{"textDocument/references", FindReferences(*this) },
 		{"textDocument/rename", RenameSymbol(*this) },
 		{"textDocument/implementation", GotoDefinition(*this) },
 		{"textDocument/semanticTokens/full", std::bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
+		{"textDocument/semanticTokens/full/delta", std::bind(&LanguageServer::semanticTokensFullDelta, this, _1, _2)},
+		{"textDocument/semanticTokens/range", std::bind(&LanguageServer::semanticTokensRange, this, _1, _2)},
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
+		{"workspace/symbol", std::bind(&LanguageServer::handleWorkspaceSymbol, this, _1, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
 	m_compilerStack{m_fileRepository.reader()}
 {
+	m_compilerStack.setIncrementalAnalysis(true);
+	// Diagnostics are requested after every change, so they must not wait for the model checker.
+	// This also keeps ``pragma experimental SMTChecker`` from preventing the reuse of the analysis.
+	m_compilerStack.setModelCheckerAllowed(false);
 }
 
 Json LanguageServer::toRange(SourceLocation const& _location)
@@ -262,15 +304,41 @@ void LanguageServer::compile()
 			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
-
-	m_compilerStack.reset(false);
+	// Keeping the settings retains the last analysis, which is reused as is if no source changed.
+	m_compilerStack.reset(true /* _keepSettings */);
 	m_compilerStack.setSources(m_fileRepository.sourceUnits());
 	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	if (m_compilerStack.analysisReused())
+		return;
+
+	m_symbolIndex.reset();
+
+	// Names in inline assembly are interned for the lifetime of the process, including every
+	// intermediate state of an identifier while it is typed. Once they by far outnumber the names
+	// needed after the last compaction, drop them, which means analysing the sources once more.
+	if (yul::YulStringRepository::instance().size() > std::max(c_minYulStringsToCompact, 2 * m_yulStringsAfterCompaction))
+	{
+		lspDebug(fmt::format("compacting {} interned Yul strings", yul::YulStringRepository::instance().size()));
+		m_compilerStack.setIncrementalAnalysis(false);
+		m_compilerStack.reset(true /* _keepSettings */);
+		yul::YulStringRepository::reset();
+		m_compilerStack.setIncrementalAnalysis(true);
+		m_compilerStack.setSources(m_fileRepository.sourceUnits());
+		m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+		m_yulStringsAfterCompaction = yul::YulStringRepository::instance().size();
+	}
+}
+
+SymbolIndex const& LanguageServer::symbolIndex()
+{
+	if (!m_symbolIndex)
+		m_symbolIndex.emplace(m_compilerStack);
+	return *m_symbolIndex;
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
+	m_diagnosticsOutdated = false;
 	compile();
 
 	// These are the source units we will sent diagnostics to the client for sure,
@@ -331,15 +399,27 @@ void LanguageServer::compileAndUpdateDiagnostics()
 
 bool LanguageServer::run()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
+	while (
+		m_state != State::ExitRequested &&
+		m_state != State::ExitWithoutShutdown &&
+		(!m_client.closed() || !m_pendingMessages.empty())
+	)
 	{
 		MessageID id;
 		try
 		{
-			std::optional<Json> const jsonMessage = m_client.receive();
-			if (!jsonMessage)
+			// Read ahead as far as possible without blocking, so that cancellations can overtake
+			// the requests they refer to.
+			if (m_pendingMessages.empty())
+				receiveMessage();
+			while (!m_client.closed() && m_client.hasPendingInput())
+				receiveMessage();
+			if (m_pendingMessages.empty())
 				continue;
 
+			std::optional<Json> const jsonMessage = std::move(m_pendingMessages.front());
+			m_pendingMessages.pop_front();
+
 			if ((*jsonMessage).contains("method") && (*jsonMessage)["method"].is_string())
 			{
 				std::string const methodName = (*jsonMessage)["method"].get<std::string>();
@@ -347,6 +427,10 @@ bool LanguageServer::run()
 					id = (*jsonMessage)["id"];
 				lspDebug(fmt::format("received method call: {}", methodName));
 
+				// Anything but further changes may depend on the analysis being up to date.
+				if (m_diagnosticsOutdated && methodName != "textDocument/didChange")
+					compileAndUpdateDiagnostics();
+
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
 					handler(id, (*jsonMessage)["params"]);
 				else
@@ -354,6 +438,10 @@ bool LanguageServer::run()
 			}
 			else
 				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+
+			// Changes often arrive in bursts, e.g. while typing. Only recompile once the burst is over.
+			if (m_diagnosticsOutdated && m_pendingMessages.empty() && !m_client.hasPendingInput())
+				compileAndUpdateDiagnostics();
 		}
 		catch (Json::exception const&)
 		{
@@ -371,6 +459,35 @@ bool LanguageServer::run()
 	return m_state == State::ExitRequested;
 }
 
+void LanguageServer::receiveMessage()
+{
+	std::optional<Json> message = m_client.receive();
+	if (!message)
+		return;
+
+	if (!message->is_object() || message->value("method", Json{}) != "$/cancelRequest")
+	{
+		m_pendingMessages.emplace_back(std::move(*message));
+		return;
+	}
+
+	// Requests that were already handled, or never received, cannot be cancelled anymore.
+	Json const& params = message->value("params", Json::object());
+	if (!params.is_object() || !params.contains("id"))
+		return;
+	MessageID const cancelledID = params["id"];
+	auto cancelledRequest = std::find_if(
+		m_pendingMessages.begin(),
+		m_pendingMessages.end(),
+		[&](Json const& _message) { return _message.is_object() && _message.contains("method") && _message.value("id", Json{}) == cancelledID; }
+	);
+	if (cancelledRequest != m_pendingMessages.end())
+	{
+		m_pendingMessages.erase(cancelledRequest);
+		m_client.error(cancelledID, ErrorCode::RequestCancelled, "Request cancelled.");
+	}
+}
+
 void LanguageServer::requireServerInitialized()
 {
 	lspRequire(
@@ -421,9 +538,11 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 	replyArgs["capabilities"]["semanticTokensProvider"]["legend"] = semanticTokensLegend();
-	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = false;
-	replyArgs["capabilities"]["semanticTokensProvider"]["full"] = true; // XOR requests.full.delta = true
+	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = true;
+	replyArgs["capabilities"]["semanticTokensProvider"]["full"]["delta"] = true;
 	replyArgs["capabilities"]["renameProvider"] = true;
+	replyArgs["capabilities"]["referencesProvider"] = true;
+	replyArgs["capabilities"]["workspaceSymbolProvider"] = true;
 	replyArgs["capabilities"]["hoverProvider"] = true;
 
 	m_client.reply(_id, std::move(replyArgs));
@@ -435,26 +554,112 @@ void LanguageServer::handleInitialized(MessageID, Json const&)
 		compileAndUpdateDiagnostics();
 }
 
-void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
+std::optional<std::string> LanguageServer::semanticTokensSourceUnit(MessageID _id, Json const& _args)
 {
-	if (_args.contains("textDocument") && _args["textDocument"].contains("uri"))
+	if (!_args.contains("textDocument") || !_args["textDocument"].contains("uri"))
 	{
-		auto uri = _args["textDocument"]["uri"];
+		m_client.error(_id, ErrorCode::InvalidParams, "Invalid parameter: textDocument.uri expected.");
+		return std::nullopt;
+	}
+
+	compile();
+	return m_fileRepository.uriToSourceUnitName(_args["textDocument"]["uri"].get<std::string>());
+}
 
-		compile();
+Json LanguageServer::fullSemanticTokens(std::string const& _sourceUnitName)
+{
+	SemanticTokensResult& result = m_semanticTokens[_sourceUnitName];
+	result.resultId = std::to_string(++m_semanticTokensResultCount);
+	result.data = SemanticTokensBuilder().build(
+		m_compilerStack.ast(_sourceUnitName),
+		m_compilerStack.charStream(_sourceUnitName)
+	);
 
-		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
-		SourceUnit const& ast = m_compilerStack.ast(sourceName);
-		m_compilerStack.charStream(sourceName);
-		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+	Json reply;
+	reply["resultId"] = result.resultId;
+	reply["data"] = result.data;
+	return reply;
+}
+
+void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
+{
+	if (std::optional<std::string> sourceName = semanticTokensSourceUnit(_id, _args))
+		m_client.reply(_id, fullSemanticTokens(*sourceName));
+}
 
-		Json reply;
-		reply["data"] = data;
+void LanguageServer::semanticTokensFullDelta(MessageID _id, Json const& _args)
+{
+	std::optional<std::string> sourceName = semanticTokensSourceUnit(_id, _args);
+	if (!sourceName)
+		return;
 
-		m_client.reply(_id, std::move(reply));
+	auto previous = m_semanticTokens.find(*sourceName);
+	if (
+		previous == m_semanticTokens.end() ||
+		!_args.contains("previousResultId") ||
+		_args["previousResultId"] != previous->second.resultId
+	)
+	{
+		// The client refers to a result we do not know (anymore), so send all tokens.
+		m_client.reply(_id, fullSemanticTokens(*sourceName));
+		return;
 	}
-	else
-		m_client.error(_id, ErrorCode::InvalidParams, "Invalid parameter: textDocument.uri expected.");
+
+	Json oldData = std::move(previous->second.data);
+	Json reply = fullSemanticTokens(*sourceName);
+	Json const& newData = m_semanticTokens.at(*sourceName).data;
+	reply.erase("data");
+
+	// Send a single edit that replaces everything between the longest common prefix and suffix.
+	size_t prefix = 0;
+	while (prefix < oldData.size() && prefix < newData.size() && oldData[prefix] == newData[prefix])
+		++prefix;
+	size_t suffix = 0;
+	while (
+		suffix < oldData.size() - prefix &&
+		suffix < newData.size() - prefix &&
+		oldData[oldData.size() - 1 - suffix] == newData[newData.size() - 1 - suffix]
+	)
+		++suffix;
+
+	reply["edits"] = Json::array();
+	if (prefix + suffix < oldData.size() || prefix + suffix < newData.size())
+	{
+		Json edit;
+		edit["start"] = prefix;
+		edit["deleteCount"] = oldData.size() - prefix - suffix;
+		edit["data"] = Json::array();
+		for (size_t i = prefix; i < newData.size() - suffix; ++i)
+			edit["data"].emplace_back(newData[i]);
+		reply["edits"].emplace_back(std::move(edit));
+	}
+	m_client.reply(_id, std::move(reply));
+}
+
+void LanguageServer::semanticTokensRange(MessageID _id, Json const& _args)
+{
+	std::optional<std::string> sourceName = semanticTokensSourceUnit(_id, _args);
+	if (!sourceName)
+		return;
+
+	std::optional<SourceLocation> range = parseRange(
+		m_fileRepository,
+		*sourceName,
+		_args.contains("range") ? _args["range"] : Json()
+	);
+	if (!range)
+	{
+		m_client.error(_id, ErrorCode::InvalidParams, "Invalid parameter: range expected.");
+		return;
+	}
+
+	Json reply;
+	reply["data"] = SemanticTokensBuilder().build(
+		m_compilerStack.ast(*sourceName),
+		m_compilerStack.charStream(*sourceName),
+		range
+	);
+	m_client.reply(_id, std::move(reply));
 }
 
 void LanguageServer::handleWorkspaceDidChangeConfiguration(Json const& _args)
@@ -465,6 +670,32 @@ void LanguageServer::handleWorkspaceDidChangeConfiguration(Json const& _args)
 		changeConfiguration(_args["settings"]);
 }
 
+void LanguageServer::handleWorkspaceSymbol(MessageID _id, Json const& _args)
+{
+	requireServerInitialized();
+
+	std::string query;
+	if (_args.contains("query") && _args["query"].is_string())
+		query = boost::to_lower_copy(_args["query"].get<std::string>());
+
+	Json reply = Json::array();
+	for (Declaration const* declaration: symbolIndex().globalDeclarations())
+	{
+		if (!boost::contains(boost::to_lower_copy(declaration->name()), query))
+			continue;
+
+		Json symbol;
+		symbol["name"] = declaration->name();
+		symbol["kind"] = toSymbolKind(*declaration);
+		symbol["location"] = toJson(declaration->nameLocation());
+		if (auto const* container = dynamic_cast<Declaration const*>(declaration->scope()))
+			if (!container->name().empty())
+				symbol["containerName"] = container->name();
+		reply.emplace_back(std::move(symbol));
+	}
+	m_client.reply(_id, reply);
+}
+
 void LanguageServer::setTrace(Json const& _args)
 {
 	if (!_args.is_string())
@@ -543,7 +774,8 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 				}
 			}
 
-		compileAndUpdateDiagnostics();
+		// Diagnostics are updated by run(), once no further changes are pending.
+		m_diagnosticsOutdated = true;
 	}
 }
 
@@ -561,6 +793,7 @@ void LanguageServer::handleTextDocumentDidClose(Json const& _args)
 	{
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.erase(uri);
+		m_semanticTokens.erase(m_fileRepository.uriToSourceUnitName(uri));
 
 		compileAndUpdateDiagnostics();
 	}
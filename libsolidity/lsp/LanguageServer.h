@@ -19,11 +19,13 @@
 
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/lsp/SymbolIndex.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
 #include <libsolutil/JSON.h>
 
+#include <deque>
 #include <functional>
 #include <map>
 #include <optional>
@@ -69,6 +71,11 @@ public:
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
 	///
+	/// Diagnostics for changed documents are deferred until no further input is pending or
+	/// a message other than a change notification arrives.
+	/// Messages are read ahead while input is available so that requests can be cancelled
+	/// via $/cancelRequest before they are handled.
+	///
 	/// The standard shutdown condition is when the maximum number of consecutive failures
 	/// has been exceeded.
 	///
@@ -80,14 +87,20 @@ public:
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the index of the references in the last compilation, which is built on first use
+	/// and retained until the sources are analysed anew.
+	SymbolIndex const& symbolIndex();
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
 	void requireServerInitialized();
+	/// Receives a single message and appends it to m_pendingMessages, unless it cancels one of them.
+	void receiveMessage();
 	void handleInitialize(MessageID _id, Json const& _args);
 	void handleInitialized(MessageID _id, Json const& _args);
 	void handleWorkspaceDidChangeConfiguration(Json const& _args);
+	void handleWorkspaceSymbol(MessageID _id, Json const& _args);
 	void setTrace(Json const& _args);
 	void handleTextDocumentDidOpen(Json const& _args);
 	void handleTextDocumentDidChange(Json const& _args);
@@ -95,6 +108,13 @@ private:
 	void handleRename(Json const& _args);
 	void handleGotoDefinition(MessageID _id, Json const& _args);
 	void semanticTokensFull(MessageID _id, Json const& _args);
+	void semanticTokensFullDelta(MessageID _id, Json const& _args);
+	void semanticTokensRange(MessageID _id, Json const& _args);
+
+	/// Compiles the document given in @a _args and @returns its source unit name, if the document is valid.
+	std::optional<std::string> semanticTokensSourceUnit(MessageID _id, Json const& _args);
+	/// @returns the semantic tokens of the given source unit and remembers them with a new result ID.
+	Json fullSemanticTokens(std::string const& _sourceUnitName);
 
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
@@ -116,6 +136,8 @@ private:
 
 	Transport& m_client;
 	std::map<std::string, MessageHandler> m_handlers;
+	/// Messages that were received but not handled yet.
+	std::deque<Json> m_pendingMessages;
 
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
@@ -125,9 +147,23 @@ private:
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
 	frontend::CompilerStack m_compilerStack;
+	std::optional<SymbolIndex> m_symbolIndex;
+	/// Number of interned Yul strings right after they were last compacted by compile().
+	size_t m_yulStringsAfterCompaction = 0;
+	/// Set if documents changed since the diagnostics were last published.
+	bool m_diagnosticsOutdated = false;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
+
+	/// The last semantic tokens sent for a source unit, used to answer delta requests.
+	struct SemanticTokensResult
+	{
+		std::string resultId;
+		Json data;
+	};
+	std::map<std::string, SemanticTokensResult> m_semanticTokens;
+	size_t m_semanticTokensResultCount = 0;
 };
 
 }
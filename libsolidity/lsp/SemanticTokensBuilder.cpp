@@ -70,17 +70,22 @@ SemanticTokenType semanticTokenTypeForExpression(frontend::Type const* _type)
 
 } // end namespace
 
-Json SemanticTokensBuilder::build(SourceUnit const& _sourceUnit, CharStream const& _charStream)
+Json SemanticTokensBuilder::build(
+	SourceUnit const& _sourceUnit,
+	CharStream const& _charStream,
+	std::optional<SourceLocation> const& _range
+)
 {
-	reset(&_charStream);
+	reset(&_charStream, _range);
 	_sourceUnit.accept(*this);
-	return m_encodedTokens;
+	return std::move(m_encodedTokens);
 }
 
-void SemanticTokensBuilder::reset(CharStream const* _charStream)
+void SemanticTokensBuilder::reset(CharStream const* _charStream, std::optional<SourceLocation> const& _range)
 {
 	m_encodedTokens = Json::array();
 	m_charStream = _charStream;
+	m_range = _range;
 	m_lastLine = 0;
 	m_lastStartChar = 0;
 }
@@ -114,6 +119,10 @@ void SemanticTokensBuilder::encode(
 	// solAssert(_sourceLocation.isValid());
 	if (!_sourceLocation.isValid())
 		return;
+	// Tokens are encoded relative to the previous one, so skipping tokens outside of the
+	// requested range still results in a valid encoding.
+	if (m_range && (_sourceLocation.start < m_range->start || _sourceLocation.start >= m_range->end))
+		return;
 
 	auto const [line, startChar] = m_charStream->translatePositionToLineColumn(_sourceLocation.start);
 	auto const length = _sourceLocation.end - _sourceLocation.start;
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTVisitor.h>
+#include <liblangutil/SourceLocation.h>
 #include <libsolutil/JSON.h>
 
 #include <fmt/format.h>
@@ -24,7 +25,6 @@
 namespace solidity::langutil
 {
 class CharStream;
-struct SourceLocation;
 }
 
 namespace solidity::lsp
@@ -87,9 +87,15 @@ constexpr SemanticTokenModifiers operator|(SemanticTokenModifiers a, SemanticTok
 class SemanticTokensBuilder: public frontend::ASTConstVisitor
 {
 public:
-	Json build(frontend::SourceUnit const& _sourceUnit, langutil::CharStream const& _charStream);
+	/// @returns the encoded semantic tokens of @a _sourceUnit. If @a _range is given, only
+	/// the tokens starting inside of it are included.
+	Json build(
+		frontend::SourceUnit const& _sourceUnit,
+		langutil::CharStream const& _charStream,
+		std::optional<langutil::SourceLocation> const& _range = std::nullopt
+	);
 
-	void reset(langutil::CharStream const* _charStream);
+	void reset(langutil::CharStream const* _charStream, std::optional<langutil::SourceLocation> const& _range = std::nullopt);
 	void encode(
 		langutil::SourceLocation const& _sourceLocation,
 		SemanticTokenType _tokenType,
@@ -116,6 +122,7 @@ public:
 private:
 	Json m_encodedTokens;
 	langutil::CharStream const* m_charStream;
+	std::optional<langutil::SourceLocation> m_range;
 	int m_lastLine;
 	int m_lastStartChar;
 };
@@ -0,0 +1,229 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/SymbolIndex.h>
+
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libyul/AST.h>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+
+namespace
+{
+
+FunctionDefinition const* calledFunctionDefinition(FunctionCall const& _functionCall)
+{
+	if (
+		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+		functionType && functionType->hasDeclaration()
+	)
+		return dynamic_cast<FunctionDefinition const*>(&functionType->declaration());
+	return nullptr;
+}
+
+/// @returns the location of an identifier in inline assembly referring to @a _externalReference
+/// and the name it uses, both without the suffix (e.g. ``.slot``).
+std::pair<SourceLocation, std::string> externalReferenceName(
+	solidity::yul::Identifier const& _identifier,
+	InlineAssemblyAnnotation::ExternalIdentifierInfo const& _externalReference
+)
+{
+	SourceLocation location = solidity::yul::nativeLocationOf(_identifier);
+	std::string name = _identifier.name.str();
+	if (!_externalReference.suffix.empty())
+	{
+		location.end -= static_cast<int>(_externalReference.suffix.size() + 1);
+		name = name.substr(0, name.length() - _externalReference.suffix.size() - 1);
+	}
+	return {location, name};
+}
+
+}
+
+class SymbolIndex::Collector: public ASTConstVisitor
+{
+public:
+	explicit Collector(SymbolIndex& _index): m_index(_index) {}
+
+	void endVisit(ImportDirective const& _node) override
+	{
+		// Handles SourceUnit aliases
+		addDeclaration(_node);
+		for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
+			if (symbolAlias.alias)
+				addReference(
+					symbolAlias.symbol->annotation().referencedDeclaration,
+					*symbolAlias.alias,
+					symbolAlias.location
+				);
+	}
+	void endVisit(ContractDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(StructDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(EnumDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(EnumValue const& _node) override { addDeclaration(_node); }
+	void endVisit(UserDefinedValueTypeDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(VariableDeclaration const& _node) override { addDeclaration(_node); }
+	void endVisit(FunctionDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(ModifierDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(EventDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(ErrorDefinition const& _node) override { addDeclaration(_node); }
+
+	void endVisit(Identifier const& _node) override
+	{
+		addReference(_node.annotation().referencedDeclaration, _node.name(), _node.location());
+	}
+	void endVisit(MemberAccess const& _node) override
+	{
+		addReference(_node.annotation().referencedDeclaration, _node.memberName(), _node.memberLocation());
+	}
+	void endVisit(IdentifierPath const& _node) override
+	{
+		std::vector<Declaration const*> const& declarations = _node.annotation().pathDeclarations;
+		if (declarations.size() != _node.path().size())
+			return;
+		for (size_t i = 0; i < declarations.size(); i++)
+			addReference(declarations[i], _node.path()[i], _node.pathLocations()[i]);
+	}
+	void endVisit(FunctionCall const& _node) override
+	{
+		// Named arguments refer to the parameters of the called function.
+		FunctionDefinition const* function = calledFunctionDefinition(_node);
+		if (!function)
+			return;
+		for (size_t i = 0; i < _node.names().size(); i++)
+			if (_node.names()[i])
+				for (auto const& parameter: function->parameters())
+					if (parameter && parameter->name() == *_node.names()[i])
+						addReference(parameter.get(), *_node.names()[i], _node.nameLocations()[i]);
+	}
+	void endVisit(InlineAssembly const& _node) override
+	{
+		for (auto&& [identifier, externalReference]: _node.annotation().externalReferences)
+		{
+			auto [location, name] = externalReferenceName(*identifier, externalReference);
+			addReference(externalReference.declaration, name, location);
+		}
+	}
+
+private:
+	void addDeclaration(Declaration const& _declaration)
+	{
+		if (_declaration.name().empty())
+			return;
+		addReference(&_declaration, _declaration.name(), _declaration.nameLocation());
+
+		auto const* variable = dynamic_cast<VariableDeclaration const*>(&_declaration);
+		if (
+			!dynamic_cast<ImportDirective const*>(&_declaration) &&
+			(!variable || variable->isStateVariable() || variable->isFileLevelVariable())
+		)
+			m_index.m_globalDeclarations.emplace_back(&_declaration);
+	}
+
+	void addReference(Declaration const* _declaration, ASTString const& _name, SourceLocation const& _location)
+	{
+		if (_declaration && _location.isValid())
+			m_index.m_references[_declaration->id()].emplace_back(Reference{_location, _name});
+	}
+
+	SymbolIndex& m_index;
+};
+
+SymbolIndex::SymbolIndex(CompilerStack const& _compilerStack)
+{
+	if (_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+		return;
+
+	Collector collector(*this);
+	for (std::string const& sourceName: _compilerStack.sourceNames())
+		_compilerStack.ast(sourceName).accept(collector);
+}
+
+std::optional<SymbolIndex::Symbol> SymbolIndex::symbolAt(ASTNode const& _node, int _offset)
+{
+	Symbol symbol;
+	if (auto const* importDirective = dynamic_cast<ImportDirective const*>(&_node))
+	{
+		if (importDirective->nameLocation().containsOffset(_offset))
+			symbol = {importDirective, importDirective->name()};
+		else
+			for (ImportDirective::SymbolAlias const& symbolAlias: importDirective->symbolAliases())
+				if (symbolAlias.location.containsOffset(_offset))
+				{
+					solAssert(symbolAlias.alias);
+					symbol = {symbolAlias.symbol->annotation().referencedDeclaration, *symbolAlias.alias};
+					break;
+				}
+	}
+	else if (auto const* declaration = dynamic_cast<Declaration const*>(&_node))
+	{
+		if (declaration->nameLocation().containsOffset(_offset))
+			symbol = {declaration, declaration->name()};
+	}
+	else if (auto const* identifier = dynamic_cast<Identifier const*>(&_node))
+		symbol = {identifier->annotation().referencedDeclaration, identifier->name()};
+	else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(&_node))
+	{
+		// Find the element of the path the offset is in.
+		std::vector<Declaration const*> const& declarations = identifierPath->annotation().pathDeclarations;
+		for (size_t i = 0; i < identifierPath->pathLocations().size(); i++)
+			if (identifierPath->pathLocations()[i].containsOffset(_offset))
+			{
+				solAssert(declarations.size() == identifierPath->path().size());
+				symbol = {declarations[i], identifierPath->path()[i]};
+			}
+	}
+	else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+		symbol = {memberAccess->annotation().referencedDeclaration, memberAccess->memberName()};
+	else if (auto const* functionCall = dynamic_cast<FunctionCall const*>(&_node))
+	{
+		if (FunctionDefinition const* function = calledFunctionDefinition(*functionCall))
+			for (size_t i = 0; i < functionCall->names().size(); i++)
+				if (functionCall->nameLocations()[i].containsOffset(_offset))
+				{
+					for (auto const& parameter: function->parameters())
+						if (parameter && parameter->name() == *functionCall->names()[i])
+							symbol = {parameter.get(), *functionCall->names()[i]};
+					break;
+				}
+	}
+	else if (auto const* inlineAssembly = dynamic_cast<InlineAssembly const*>(&_node))
+		for (auto&& [identifier, externalReference]: inlineAssembly->annotation().externalReferences)
+		{
+			auto [location, name] = externalReferenceName(*identifier, externalReference);
+			if (location.containsOffset(_offset))
+			{
+				symbol = {externalReference.declaration, name};
+				break;
+			}
+		}
+
+	if (!symbol.declaration)
+		return std::nullopt;
+	return symbol;
+}
+
+std::vector<SymbolIndex::Reference> const& SymbolIndex::references(Declaration const& _declaration) const
+{
+	static std::vector<Reference> const noReferences;
+	auto it = m_references.find(_declaration.id());
+	return it == m_references.end() ? noReferences : it->second;
+}
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/ast/AST.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::frontend
+{
+class CompilerStack;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Index of all references to the declarations of the sources of an analysed CompilerStack.
+ *
+ * It is built in a single pass over all ASTs, so that finding the references of a declaration
+ * (e.g. for renaming it) does not require another traversal of the whole workspace.
+ * The index refers to the ASTs of the CompilerStack and has to be discarded as soon as they change.
+ */
+class SymbolIndex
+{
+public:
+	/// A location at which a declaration is referred to by a name, including the
+	/// name of the declaration itself.
+	struct Reference
+	{
+		langutil::SourceLocation location;
+		frontend::ASTString name;
+	};
+
+	/// A declaration together with the name it is referred to by, which may differ from
+	/// its own name if it is an import alias.
+	struct Symbol
+	{
+		frontend::Declaration const* declaration = nullptr;
+		frontend::ASTString name;
+	};
+
+	/// Indexes all sources of @a _compilerStack. If the analysis did not succeed, the index is empty.
+	explicit SymbolIndex(frontend::CompilerStack const& _compilerStack);
+
+	/// @returns the symbol whose name covers @a _offset in the source of @a _node,
+	/// which is the innermost node at that offset, or nullopt if there is none.
+	static std::optional<Symbol> symbolAt(frontend::ASTNode const& _node, int _offset);
+
+	/// @returns the references to @a _declaration in all sources, in no particular order.
+	std::vector<Reference> const& references(frontend::Declaration const& _declaration) const;
+
+	/// @returns all named declarations that are not local to a function, in the order of the sources.
+	std::vector<frontend::Declaration const*> const& globalDeclarations() const { return m_globalDeclarations; }
+
+private:
+	class Collector;
+
+	/// References by the ID of the declaration they refer to.
+	std::unordered_map<int64_t, std::vector<Reference>> m_references;
+	std::vector<frontend::Declaration const*> m_globalDeclarations;
+};
+
+}
@@ -35,6 +35,8 @@
 #if defined(_WIN32)
 #include <io.h>
 #include <fcntl.h>
+#else
+#include <poll.h>
 #endif
 
 using namespace solidity::lsp;
@@ -155,6 +157,11 @@ bool IOStreamTransport::closed() const noexcept
 	return m_input.eof();
 }
 
+bool IOStreamTransport::hasPendingInput() const
+{
+	return m_input.rdbuf() && m_input.rdbuf()->in_avail() > 0;
+}
+
 std::string IOStreamTransport::readBytes(size_t _length)
 {
 	return util::readBytes(m_input, _length);
@@ -185,6 +192,9 @@ StdioTransport::StdioTransport()
 	// Attempt to change the modes of stdout from text to binary.
 	setmode(fileno(stdout), O_BINARY);
 	#endif
+	// Input buffered by the C library is invisible to hasPendingInput(), which would then miss
+	// messages that arrived together with the one just read. Message bodies are still read in one go.
+	setvbuf(stdin, nullptr, _IONBF, 0);
 }
 
 bool StdioTransport::closed() const noexcept
@@ -192,6 +202,17 @@ bool StdioTransport::closed() const noexcept
 	return feof(stdin);
 }
 
+bool StdioTransport::hasPendingInput() const
+{
+#if defined(_WIN32)
+	return false;
+#else
+	// stdin is unbuffered, so all input that was not read yet is still visible to poll().
+	pollfd input{fileno(stdin), POLLIN, 0};
+	return poll(&input, 1, 0 /* timeout */) > 0 && (input.revents & POLLIN);
+#endif
+}
+
 std::string StdioTransport::readBytes(size_t _byteCount)
 {
 	std::string buffer;
@@ -50,6 +50,7 @@ enum class ErrorCode
 
 	// Defined by the protocol.
 	ServerNotInitialized = -32002,
+	RequestCancelled = -32800,
 	RequestFailed = -32803
 };
 
@@ -104,6 +105,10 @@ public:
 
 	virtual bool closed() const noexcept = 0;
 
+	/// @returns true if more input is known to be available right away, i.e. without blocking.
+	/// Transports that cannot tell always return false.
+	virtual bool hasPendingInput() const { return false; }
+
 	void trace(std::string _message, Json _extra = Json{});
 
 	TraceValue traceValue() const noexcept { return m_logTrace; }
@@ -150,6 +155,7 @@ public:
 	IOStreamTransport(std::istream& _in, std::ostream& _out);
 
 	bool closed() const noexcept override;
+	bool hasPendingInput() const override;
 
 protected:
 	std::string readBytes(size_t _byteCount) override;
@@ -171,6 +177,7 @@ public:
 	StdioTransport();
 
 	bool closed() const noexcept override;
+	bool hasPendingInput() const override;
 
 protected:
 	std::string readBytes(size_t _byteCount) override;
@@ -85,10 +85,15 @@ std::multimap<std::string, DocTag> DocStringParser::parse()
 	solAssert(m_node.text(), "");
 	iter currPos = m_node.text()->begin();
 	iter end = m_node.text()->end();
+	// Position of the next '@' at or after the current position. Only searched for again once it
+	// has been passed, since searching from every line would scan the rest of a long docstring
+	// without tags once per line.
+	iter tagPos = find(currPos, end, '@');
 
 	while (currPos != end)
 	{
-		iter tagPos = find(currPos, end, '@');
+		if (tagPos < currPos)
+			tagPos = find(currPos, end, '@');
 		iter nlPos = find(currPos, end, '\n');
 
 		if (tagPos != end && tagPos < nlPos)
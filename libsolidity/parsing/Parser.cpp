@@ -76,7 +76,7 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.allocateNode<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -93,6 +93,8 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	{
 		m_recursionDepth = 0;
 		m_scanner = std::make_shared<Scanner>(_charStream);
+		m_nodesOfCurrentSourceUnit.clear();
+		m_nodeArena = std::make_shared<util::Arena>();
 		ASTNodeFactory nodeFactory(*this);
 		m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 
@@ -183,6 +185,18 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	solAssert(_offset >= 0);
+	solAssert(m_trackNodes);
+	if (_offset == 0)
+		return;
+	for (std::weak_ptr<ASTNode> const& weakNode: m_nodesOfCurrentSourceUnit)
+		if (std::shared_ptr<ASTNode> node = weakNode.lock())
+			node->m_id += static_cast<size_t>(_offset);
+	m_currentNodeID += _offset;
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, std::vector<Token> const& _tokens, std::vector<std::string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -1478,7 +1492,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(ast->root()).end;
-	return std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), ast);
+	return allocateNode<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), ast);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -2359,7 +2373,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		// Inside expressions "type" is the name of a special, globally-available function.
 		nodeFactory.markEndPosition();
 		advance();
-		expression = nodeFactory.createNode<Identifier>(std::make_shared<ASTString>("type"));
+		expression = nodeFactory.createNode<Identifier>(internName("type"));
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -2743,7 +2757,7 @@ ASTPointer<ASTString> Parser::expectIdentifierTokenOrAddress()
 	ASTPointer<ASTString> result;
 	if (m_scanner->currentToken() == Token::Address)
 	{
-		result = std::make_shared<ASTString>("address");
+		result = internName("address");
 		advance();
 	}
 	else
@@ -2756,11 +2770,21 @@ ASTPointer<ASTString> Parser::expectIdentifierTokenOrAddress()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = std::make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = internName(m_scanner->currentLiteral());
 	advance();
 	return identifier;
 }
 
+ASTPointer<ASTString> Parser::internName(std::string_view _name)
+{
+	auto it = m_internedNames.find(_name);
+	if (it != m_internedNames.end())
+		return it->second;
+	auto name = std::make_shared<ASTString>(_name);
+	m_internedNames.emplace(*name, name);
+	return name;
+}
+
 bool Parser::isQuotedPath() const
 {
 	return m_scanner->currentToken() == Token::StringLiteral;
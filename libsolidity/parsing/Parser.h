@@ -27,6 +27,13 @@
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Arena.h>
+
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
 namespace solidity::langutil
 {
 class CharStream;
@@ -52,6 +59,13 @@ public:
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+
+	/// Makes parse() keep track of the nodes it creates, which is required by shiftNodeIDs().
+	void enableNodeIDShifting() { m_trackNodes = true; }
+	/// Adds @a _offset to the IDs of all nodes created by the last call to parse() and to maxID().
+	/// Allows source units parsed by separate parsers to receive the IDs a single parser
+	/// would have assigned to them when parsing one after another.
+	void shiftNodeIDs(int64_t _offset);
 private:
 	class ASTNodeFactory;
 
@@ -216,6 +230,21 @@ private:
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
 
+	/// Creates an AST node in the arena of the current source unit.
+	/// The source unit itself owns the arena and is therefore allocated outside of it.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> allocateNode(Args&&... _args)
+	{
+		ASTPointer<NodeType> node;
+		if constexpr (std::is_same_v<NodeType, SourceUnit>)
+			node = std::make_shared<SourceUnit>(std::forward<Args>(_args)..., m_nodeArena);
+		else
+			node = std::allocate_shared<NodeType>(util::ArenaAllocator<NodeType>(*m_nodeArena), std::forward<Args>(_args)...);
+		if (m_trackNodes)
+			m_nodesOfCurrentSourceUnit.emplace_back(node);
+		return node;
+	}
+
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
 	/// For source code of the form "a[][8]" ("IndexAccessStructure"), this is not possible to
@@ -236,6 +265,10 @@ private:
 	ASTPointer<ASTString> getLiteralAndAdvance();
 	///@}
 
+	/// @returns the shared string for @a _name, creating it on first use, so that all occurrences
+	/// of the same identifier refer to a single copy.
+	ASTPointer<ASTString> internName(std::string_view _name);
+
 	bool isQuotedPath() const;
 	bool isStdlibPath() const;
 
@@ -252,6 +285,16 @@ private:
 	std::optional<uint8_t> m_eofVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Memory for the nodes of the source unit being parsed, shared with the resulting SourceUnit.
+	/// Declared before m_nodesOfCurrentSourceUnit, whose weak pointers refer to control blocks in it.
+	std::shared_ptr<util::Arena> m_nodeArena;
+	/// Whether m_nodesOfCurrentSourceUnit is filled, see enableNodeIDShifting().
+	bool m_trackNodes = false;
+	/// All nodes created while parsing the current source unit, including discarded ones.
+	std::vector<std::weak_ptr<ASTNode>> m_nodesOfCurrentSourceUnit;
+	/// Identifier names seen by this parser, over all source units it parsed. The keys refer
+	/// to the mapped strings, which are never modified.
+	std::unordered_map<std::string_view, ASTPointer<ASTString>> m_internedNames;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 };
@@ -18,9 +18,12 @@
 #pragma once
 
 
+#include <algorithm>
 #include <functional>
 #include <list>
+#include <map>
 #include <set>
+#include <vector>
 
 namespace solidity::util
 {
@@ -125,4 +128,89 @@ struct BreadthFirstSearch
 	std::set<V> visited{};
 };
 
+/**
+ * Computes the strongly connected components of a directed graph using Tarjan's algorithm.
+ *
+ * Note that V needs to be a comparable value type or a pointer.
+ *
+ * The components are appended in reverse topological order, i.e. all children of the vertices
+ * of a component (outside of the component itself) are part of earlier components. This allows
+ * propagating properties from children to parents in a single pass over the components.
+ * The traversal does not use recursion, so it can handle deep graphs.
+ */
+template<typename V>
+struct StronglyConnectedComponents
+{
+	/// Computes the components of all vertices reachable from @a _root that have not been visited by
+	/// a previous call.
+	/// @param _forEachChild is a callable of the form [...](V const& _node, auto&& _addChild) { ... }
+	/// that is called once for each visited node and is supposed to call _addChild(childNode)
+	/// for every child node of _node.
+	template<typename ForEachChild>
+	StronglyConnectedComponents& run(V const& _root, ForEachChild&& _forEachChild)
+	{
+		struct Frame
+		{
+			V vertex;
+			std::vector<V> children;
+			size_t nextChild = 0;
+		};
+		std::vector<Frame> frames;
+		auto enter = [&](V const& _vertex) {
+			size_t index = m_index.size();
+			m_index[_vertex] = index;
+			m_lowLink[_vertex] = index;
+			m_stack.emplace_back(_vertex);
+			m_onStack.insert(_vertex);
+			Frame frame{_vertex, {}, 0};
+			_forEachChild(_vertex, [&](V _child) {
+				frame.children.emplace_back(std::move(_child));
+			});
+			frames.emplace_back(std::move(frame));
+		};
+
+		if (m_index.count(_root))
+			return *this;
+		enter(_root);
+		while (!frames.empty())
+		{
+			Frame& frame = frames.back();
+			if (frame.nextChild < frame.children.size())
+			{
+				V child = frame.children[frame.nextChild++];
+				if (!m_index.count(child))
+					enter(child);
+				else if (m_onStack.count(child))
+					m_lowLink[frame.vertex] = std::min(m_lowLink[frame.vertex], m_index.at(child));
+				continue;
+			}
+
+			V vertex = std::move(frame.vertex);
+			frames.pop_back();
+			if (!frames.empty())
+				m_lowLink[frames.back().vertex] = std::min(m_lowLink[frames.back().vertex], m_lowLink[vertex]);
+			if (m_lowLink[vertex] == m_index[vertex])
+			{
+				std::vector<V>& component = components.emplace_back();
+				do
+				{
+					component.emplace_back(std::move(m_stack.back()));
+					m_stack.pop_back();
+					m_onStack.erase(component.back());
+				}
+				while (!(component.back() == vertex));
+			}
+		}
+		return *this;
+	}
+
+	std::vector<std::vector<V>> components;
+
+private:
+	std::map<V, size_t> m_index;
+	std::map<V, size_t> m_lowLink;
+	std::vector<V> m_stack;
+	std::set<V> m_onStack;
+};
+
 }
@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace solidity::util;
+
+Arena::Arena(size_t _maxBlockSize):
+	m_maxBlockSize(_maxBlockSize),
+	m_nextBlockSize(std::min(InitialBlockSize, _maxBlockSize))
+{
+	solAssert(m_maxBlockSize > 0);
+}
+
+void* Arena::allocate(size_t _size, size_t _alignment)
+{
+	solAssert(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, "Alignment must be a power of two.");
+	m_allocatedBytes += _size;
+
+	// Large allocations would waste most of the current block, so they get their own.
+	if (_size > m_maxBlockSize / 4)
+	{
+		std::byte* block = allocateBlock(_size + _alignment - 1);
+		auto address = reinterpret_cast<std::uintptr_t>(block);
+		return block + ((_alignment - address % _alignment) % _alignment);
+	}
+
+	auto next = reinterpret_cast<std::uintptr_t>(m_next);
+	size_t padding = (_alignment - next % _alignment) % _alignment;
+	if (!m_next || static_cast<size_t>(m_end - m_next) < padding + _size)
+	{
+		size_t blockSize = std::max(m_nextBlockSize, _size + _alignment - 1);
+		m_next = allocateBlock(blockSize);
+		m_end = m_next + blockSize;
+		m_nextBlockSize = std::min(2 * m_nextBlockSize, m_maxBlockSize);
+		next = reinterpret_cast<std::uintptr_t>(m_next);
+		padding = (_alignment - next % _alignment) % _alignment;
+	}
+
+	std::byte* result = m_next + padding;
+	m_next = result + _size;
+	return result;
+}
+
+std::byte* Arena::allocateBlock(size_t _size)
+{
+	// Not using std::make_unique() because there is no need to zero-initialize the memory.
+	m_blocks.emplace_back(new std::byte[_size]);
+	return m_blocks.back().get();
+}
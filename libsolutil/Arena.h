@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Bump allocator for objects that share a common lifetime.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Hands out memory from large contiguous blocks. Individual allocations are never released,
+ * all blocks are freed at once when the arena is destroyed.
+ *
+ * Intended for large numbers of small objects that are created together and die together,
+ * like the nodes of a syntax tree. Not thread-safe: all allocations from a single arena must
+ * be performed by one thread at a time.
+ */
+class Arena
+{
+public:
+	static constexpr size_t InitialBlockSize = 4 * 1024;
+	static constexpr size_t DefaultMaxBlockSize = 64 * 1024;
+
+	/// Blocks start small and grow geometrically up to @a _maxBlockSize, so that arenas holding
+	/// only a few objects stay cheap.
+	explicit Arena(size_t _maxBlockSize = DefaultMaxBlockSize);
+
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns memory of the given size aligned to @a _alignment, which must be a power of two.
+	/// Allocations larger than a fraction of the maximum block size get a dedicated block.
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the total number of bytes requested so far, not taking padding into account.
+	size_t allocatedBytes() const { return m_allocatedBytes; }
+	size_t numBlocks() const { return m_blocks.size(); }
+
+private:
+	std::byte* allocateBlock(size_t _size);
+
+	size_t m_maxBlockSize;
+	size_t m_nextBlockSize;
+	std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	std::byte* m_next = nullptr;
+	std::byte* m_end = nullptr;
+	size_t m_allocatedBytes = 0;
+};
+
+/**
+ * Standard allocator serving memory from an Arena.
+ *
+ * Does not own the arena: whoever owns it has to keep it alive as long as any object
+ * allocated through it, including the control blocks of std::allocate_shared().
+ * Deallocation is a no-op.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(Arena& _arena): m_arena(&_arena) {}
+	template <typename U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _n) { return static_cast<T*>(m_arena->allocate(_n * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	Arena* arena() const { return m_arena; }
+
+	template <typename U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <typename U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return !(*this == _other); }
+
+private:
+	Arena* m_arena;
+};
+
+}
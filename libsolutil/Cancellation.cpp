@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Cancellation.h>
+
+#include <libsolutil/Assertions.h>
+
+using namespace solidity;
+using namespace solidity::util;
+
+thread_local CancellationToken const* CancellationToken::s_active = nullptr;
+
+CancellationToken::CancellationToken(
+	std::optional<std::chrono::steady_clock::duration> _timeBudget,
+	CancellationToken const* _parent
+):
+	m_parent(_parent)
+{
+	if (_timeBudget)
+		m_deadline = std::chrono::steady_clock::now() + *_timeBudget;
+}
+
+bool CancellationToken::cancelled() const noexcept
+{
+	return
+		m_cancelled.load(std::memory_order_relaxed) ||
+		(m_deadline && std::chrono::steady_clock::now() >= *m_deadline) ||
+		(m_parent && m_parent->cancelled());
+}
+
+bool CancellationToken::expired() const noexcept
+{
+	return (m_deadline && std::chrono::steady_clock::now() >= *m_deadline) || (m_parent && m_parent->expired());
+}
+
+void CancellationToken::throwCancelled() const
+{
+	solThrow(CompilationCancelled, expired() ? "Compilation exceeded its time limit." : "Compilation was cancelled.");
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cooperative cancellation of compilations.
+ */
+
+#pragma once
+
+#include <libsolutil/Exceptions.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace solidity::util
+{
+
+/// Thrown by @a CancellationToken::check() if the compilation was cancelled or ran out of time.
+struct CompilationCancelled: virtual Exception {};
+
+/**
+ * Allows cancelling the compilation running while the token is active, either explicitly
+ * from any thread or once a time budget is used up.
+ *
+ * Long-running loops call @a CancellationToken::check() at points where the compilation can be
+ * abandoned. If no token is active on the current thread, this only costs a check of a
+ * thread-local pointer. Tasks submitted to a @a ThreadPool run with the token that was active
+ * when they were submitted.
+ *
+ * Cancellation is cooperative: a single step between two checks, e.g. a solver query, is not
+ * interrupted.
+ */
+class CancellationToken
+{
+public:
+	/// Creates a token that is cancelled once @a _timeBudget has passed, if given, or if
+	/// @a _parent is cancelled.
+	explicit CancellationToken(
+		std::optional<std::chrono::steady_clock::duration> _timeBudget = std::nullopt,
+		CancellationToken const* _parent = nullptr
+	);
+
+	/// Makes a token active on the current thread for the lifetime of the object.
+	/// Activations can be nested, the innermost one takes precedence.
+	class Activation
+	{
+	public:
+		explicit Activation(CancellationToken const* _token): m_previous(s_active) { s_active = _token; }
+		~Activation() { s_active = m_previous; }
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		CancellationToken const* m_previous;
+	};
+
+	/// @returns the token active on the current thread, if any.
+	static CancellationToken const* active() { return s_active; }
+
+	/// Throws CompilationCancelled if the token active on the current thread is cancelled.
+	static void check()
+	{
+		if (s_active && s_active->cancelled())
+			s_active->throwCancelled();
+	}
+
+	/// Cancels the token. Can be called from any thread.
+	void cancel() noexcept { m_cancelled.store(true, std::memory_order_relaxed); }
+	/// @returns true if the token or its parent was cancelled or the time budget is used up.
+	bool cancelled() const noexcept;
+	/// @returns true if the time budget of the token or its parent is used up.
+	bool expired() const noexcept;
+
+private:
+	[[noreturn]] void throwCancelled() const;
+
+	std::atomic<bool> m_cancelled = false;
+	std::optional<std::chrono::steady_clock::time_point> m_deadline;
+	CancellationToken const* m_parent = nullptr;
+
+	static thread_local CancellationToken const* s_active;
+};
+
+}
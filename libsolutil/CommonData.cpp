@@ -29,6 +29,11 @@
 
 #include <boost/algorithm/string.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOL_HEX_SSE2 1
+#endif
+
 using namespace solidity;
 using namespace solidity::util;
 
@@ -38,6 +43,79 @@ namespace
 static char const* upperHexChars = "0123456789ABCDEF";
 static char const* lowerHexChars = "0123456789abcdef";
 
+#if SOL_HEX_SSE2
+/// @returns the hex characters of the nibbles in @a _nibbles.
+__m128i nibblesToHex(__m128i _nibbles, HexCase _case)
+{
+	__m128i letters = _mm_cmpgt_epi8(_nibbles, _mm_set1_epi8(9));
+	__m128i letterOffset = _mm_set1_epi8(_case == HexCase::Upper ? 'A' - '0' - 10 : 'a' - '0' - 10);
+	return _mm_add_epi8(_mm_add_epi8(_nibbles, _mm_set1_epi8('0')), _mm_and_si128(letters, letterOffset));
+}
+
+/// Encodes 16 bytes at a time into @a o_out, which has room for twice the input size.
+/// @returns the number of bytes encoded.
+size_t toHexSSE2(bytesConstRef _data, HexCase _case, char* o_out)
+{
+	size_t i = 0;
+	for (; i + 16 <= _data.size(); i += 16)
+	{
+		__m128i input = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_data.data() + i));
+		__m128i high = nibblesToHex(_mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0xf)), _case);
+		__m128i low = nibblesToHex(_mm_and_si128(input, _mm_set1_epi8(0xf)), _case);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(o_out + 2 * i), _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(o_out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+	}
+	return i;
+}
+
+/// @returns the values of the 16 hex characters in @a _chars and sets @a o_valid to false
+/// if any of them is not a hex character.
+__m128i hexToNibbles(__m128i _chars, bool& o_valid)
+{
+	auto inRange = [](__m128i _value, char _first, char _last) {
+		return _mm_and_si128(
+			_mm_cmpgt_epi8(_value, _mm_set1_epi8(static_cast<char>(_first - 1))),
+			_mm_cmplt_epi8(_value, _mm_set1_epi8(static_cast<char>(_last + 1)))
+		);
+	};
+	// Setting bit 5 maps upper case letters to lower case ones and no other character into a-f.
+	__m128i lowerCase = _mm_or_si128(_chars, _mm_set1_epi8(0x20));
+	__m128i digits = inRange(_chars, '0', '9');
+	__m128i letters = inRange(lowerCase, 'a', 'f');
+	o_valid = _mm_movemask_epi8(_mm_or_si128(digits, letters)) == 0xffff;
+	return _mm_or_si128(
+		_mm_and_si128(digits, _mm_sub_epi8(_chars, _mm_set1_epi8('0'))),
+		_mm_and_si128(letters, _mm_sub_epi8(lowerCase, _mm_set1_epi8('a' - 10)))
+	);
+}
+
+/// Decodes pairs of hex characters 32 at a time into @a o_out until the end of the input or
+/// an invalid character is reached.
+/// @returns the number of characters decoded.
+size_t fromHexSSE2(char const* _chars, size_t _size, uint8_t* o_out)
+{
+	size_t i = 0;
+	for (; i + 32 <= _size; i += 32)
+	{
+		bool firstValid = false;
+		bool secondValid = false;
+		__m128i first = hexToNibbles(_mm_loadu_si128(reinterpret_cast<__m128i const*>(_chars + i)), firstValid);
+		__m128i second = hexToNibbles(_mm_loadu_si128(reinterpret_cast<__m128i const*>(_chars + i + 16)), secondValid);
+		if (!firstValid || !secondValid)
+			break;
+		// Each 16 bit lane holds the high nibble in its low byte and the low nibble in its high byte.
+		auto combine = [](__m128i _nibbles) {
+			return _mm_or_si128(
+				_mm_slli_epi16(_mm_and_si128(_nibbles, _mm_set1_epi16(0xff)), 4),
+				_mm_srli_epi16(_nibbles, 8)
+			);
+		};
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(o_out + i / 2), _mm_packus_epi16(combine(first), combine(second)));
+	}
+	return i;
+}
+#endif
+
 }
 
 std::string solidity::util::toHex(uint8_t _data, HexCase _case)
@@ -52,7 +130,7 @@ std::string solidity::util::toHex(uint8_t _data, HexCase _case)
 	};
 }
 
-std::string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase _case)
+std::string solidity::util::toHex(bytesConstRef _data, HexPrefix _prefix, HexCase _case)
 {
 	std::string ret(_data.size() * 2 + (_prefix == HexPrefix::Add ? 2 : 0), 0);
 
@@ -63,10 +141,19 @@ std::string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase
 		ret[i++] = 'x';
 	}
 
+	size_t encoded = 0;
+#if SOL_HEX_SSE2
+	if (_case != HexCase::Mixed)
+	{
+		encoded = toHexSSE2(_data, _case, ret.data() + i);
+		i += 2 * encoded;
+	}
+#endif
+
 	// Mixed case will be handled inside the loop.
 	char const* chars = _case == HexCase::Upper ? upperHexChars : lowerHexChars;
-	size_t rix = _data.size() - 1;
-	for (uint8_t c: _data)
+	size_t rix = _data.size() - 1 - encoded;
+	for (uint8_t c: _data.cropped(encoded))
 	{
 		// switch hex case every four hexchars
 		if (_case == HexCase::Mixed)
@@ -111,7 +198,16 @@ bytes solidity::util::fromHex(std::string const& _s, WhenError _throw)
 		else
 			return bytes();
 	}
-	for (unsigned i = s; i < _s.size(); i += 2)
+	size_t i = s;
+#if SOL_HEX_SSE2
+	// Invalid characters stop the vectorized loop, the loop below then handles the error.
+	size_t const decodedOffset = ret.size();
+	ret.resize(decodedOffset + (_s.size() - i) / 2);
+	size_t decodedChars = fromHexSSE2(_s.data() + i, _s.size() - i, ret.data() + decodedOffset);
+	ret.resize(decodedOffset + decodedChars / 2);
+	i += decodedChars;
+#endif
+	for (; i < _s.size(); i += 2)
 	{
 		int h = fromHex(_s[i], _throw);
 		int l = fromHex(_s[i + 1], _throw);
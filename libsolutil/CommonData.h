@@ -445,7 +445,11 @@ std::string toHex(uint8_t _data, HexCase _case = HexCase::Lower);
 
 /// Convert a series of bytes to the corresponding string of hex duplets,
 /// optionally with "0x" prefix and with uppercase hex letters.
-std::string toHex(bytes const& _data, HexPrefix _prefix = HexPrefix::DontAdd, HexCase _case = HexCase::Lower);
+std::string toHex(bytesConstRef _data, HexPrefix _prefix = HexPrefix::DontAdd, HexCase _case = HexCase::Lower);
+inline std::string toHex(bytes const& _data, HexPrefix _prefix = HexPrefix::DontAdd, HexCase _case = HexCase::Lower)
+{
+	return toHex(bytesConstRef(&_data), _prefix, _case);
+}
 
 /// Converts a (printable) ASCII hex character into the corresponding integer value.
 /// @example fromHex('A') == 10 && fromHex('f') == 15 && fromHex('5') == 5
@@ -17,7 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 /**
  * Dominator analysis of a control flow graph.
- * The implementation is based on the following paper:
+ * The computation of semidominators is based on the following paper:
  * https://www.cs.princeton.edu/courses/archive/spr03/cs423/download/dominators.pdf
  * See appendix B pg. 139.
  */
@@ -27,14 +27,14 @@
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/drop.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/transform.hpp>
 
-#include <deque>
+#include <limits>
+#include <map>
+#include <optional>
 #include <vector>
-#include <set>
 
 namespace
 {
@@ -53,7 +53,14 @@ namespace solidity::util
 /// ForEachSuccessor is a visitor that visits the successors of a vertex.
 ///
 /// The graph must contain at least one vertex (the entry point) and is assumed to not be disconnected.
-/// Only vertices reachable from the entry vertex are visited.
+/// Only vertices reachable from the entry vertex are visited. The vertices passed to the visitor
+/// must stay alive while the dominators are computed.
+///
+/// The immediate dominators are computed with the Semi-NCA algorithm, that finds semidominators like
+/// Lengauer-Tarjan and then derives the immediate dominators from nearest common ancestors in the
+/// partially built dominator tree. All per-vertex data is kept in arrays indexed by DFS index and
+/// no step recurses, so that graphs with many thousands of vertices cannot exhaust the stack.
+/// See: Loukas Georgiadis, "Linear-Time Algorithms for Dominators and Related Problems", 2005.
 template<typename V, typename ForEachSuccessor>
 class DominatorFinder
 {
@@ -62,9 +69,9 @@ public:
 	using VId = typename V::Id;
 	using DfsIndex = size_t;
 
-	DominatorFinder(V const& _entry):
-		m_immediateDominators(findDominators(_entry))
+	DominatorFinder(V const& _entry)
 	{
+		findDominators(_entry);
 		buildDominatorTree();
 	}
 
@@ -99,6 +106,8 @@ public:
 		return m_dominatorTree;
 	}
 
+	/// Checks whether vertex ``_dominatorId`` dominates ``_dominatedId`` in constant time, by testing
+	/// whether ``_dominatedId`` lies in the subtree of ``_dominatorId`` in the dominator tree.
 	bool dominates(VId const& _dominatorId, VId const& _dominatedId) const
 	{
 		solAssert(!m_dfsIndexByVertexId.empty());
@@ -108,29 +117,12 @@ public:
 		DfsIndex dominatorIdx = m_dfsIndexByVertexId.at(_dominatorId);
 		DfsIndex dominatedIdx = m_dfsIndexByVertexId.at(_dominatedId);
 
-		if (dominatorIdx == dominatedIdx)
-			return true;
-
-		DfsIndex idomIdx = m_immediateDominators.at(dominatedIdx).value_or(0);
-		while (idomIdx != 0)
-		{
-			solAssert(idomIdx < m_immediateDominators.size());
-			if (idomIdx == dominatorIdx)
-				return true;
-			// The index of the immediate dominator of a vertex is always less than the index of the vertex itself.
-			solAssert(m_immediateDominators.at(idomIdx).has_value() && m_immediateDominators.at(idomIdx).value() < idomIdx);
-			idomIdx = m_immediateDominators[idomIdx].value();
-		}
-		// Now that we reached the entry node (i.e. idomIdx = 0),
-		// either ``dominatorIdx == 0`` or it does not dominate the other node.
-		solAssert(idomIdx == 0);
-		return dominatorIdx == 0;
+		return
+			m_treePreorderIndex[dominatorIdx] <= m_treePreorderIndex[dominatedIdx] &&
+			m_treePreorderIndex[dominatedIdx] < m_treeSubtreeEnd[dominatorIdx];
 	}
 
-	/// Checks whether vertex ``_dominator`` dominates ``_dominated`` by going
-	/// through the path from ``_dominated`` to the entry node.
-	/// If ``_dominator`` is found, then it dominates ``_dominated``
-	/// otherwise it doesn't.
+	/// Checks whether vertex ``_dominator`` dominates ``_dominated``.
 	bool dominates(V const& _dominator, V const& _dominated) const
 	{
 		return dominates(_dominator.id, _dominated.id);
@@ -176,8 +168,48 @@ public:
 		return dominatorsOf(_v.id);
 	}
 
+	/// Computes the dominance frontier of every vertex, i.e. the set of vertices ``w`` such that the
+	/// vertex dominates a predecessor of ``w``, but does not strictly dominate ``w`` itself.
+	/// These are the blocks that need phi functions for variables assigned in the vertex.
+	/// Uses the algorithm of Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm".
+	/// @returns the frontiers by DFS index, each sorted by DFS index.
+	std::vector<std::vector<DfsIndex>> dominanceFrontiersByDfsIndex() const
+	{
+		std::vector<std::vector<DfsIndex>> frontiers(m_verticesInDFSOrder.size());
+		for (DfsIndex wIdx = 0; wIdx < m_verticesInDFSOrder.size(); ++wIdx)
+			for (DfsIndex runnerIdx: m_predecessors[wIdx])
+				// Every vertex on the path from the predecessor up to the immediate dominator of ``w``
+				// has ``w`` in its frontier. The entry vertex has no immediate dominator, so for it
+				// the path continues up to the root of the dominator tree.
+				while (!m_immediateDominators[wIdx] || runnerIdx != *m_immediateDominators[wIdx])
+				{
+					if (frontiers[runnerIdx].empty() || frontiers[runnerIdx].back() != wIdx)
+						frontiers[runnerIdx].push_back(wIdx);
+					if (runnerIdx == 0)
+						break;
+					runnerIdx = *m_immediateDominators[runnerIdx];
+				}
+		return frontiers;
+	}
+
+	/// @returns the dominance frontiers as computed by dominanceFrontiersByDfsIndex() by vertex ID.
+	/// Vertices with an empty dominance frontier have no entry in the map.
+	std::map<VId, std::vector<VId>> dominanceFrontiers() const
+	{
+		std::vector<std::vector<DfsIndex>> frontiersByDfsIndex = dominanceFrontiersByDfsIndex();
+		std::map<VId, std::vector<VId>> frontiers;
+		for (DfsIndex vIdx = 0; vIdx < frontiersByDfsIndex.size(); ++vIdx)
+			if (!frontiersByDfsIndex[vIdx].empty())
+				frontiers[m_verticesInDFSOrder[vIdx]] = frontiersByDfsIndex[vIdx]
+					| ranges::views::transform([&](DfsIndex _wIdx) { return m_verticesInDFSOrder[_wIdx]; })
+					| ranges::to<std::vector<VId>>;
+		return frontiers;
+	}
+
 private:
-	std::vector<std::optional<DfsIndex>> findDominators(V const& _entry)
+	static DfsIndex constexpr c_noIndex = std::numeric_limits<DfsIndex>::max();
+
+	void findDominators(V const& _entry)
 	{
 		solAssert(m_verticesInDFSOrder.empty());
 		solAssert(m_dfsIndexByVertexId.empty());
@@ -187,42 +219,50 @@ private:
 		std::vector<DfsIndex> parent;
 
 		// step 1
-		// The vertices are assigned indices in DFS order.
-		std::set<VId> visited;
-		DfsIndex nextUnusedDFSIndex = 0;
-
-		auto dfs = [&](V const& _v, auto _dfs) -> void {
-			auto [_, inserted] = visited.insert(_v.id);
-			if (!inserted)
-				return;
-
+		// The vertices are assigned indices in DFS order. The search keeps an explicit stack of the
+		// successors still to be visited. A successor is only checked for having been visited when
+		// the search gets to it, which results in the same order as a recursive search.
+		struct DfsStackEntry
+		{
+			DfsIndex index;
+			std::vector<V const*> successors;
+			size_t nextSuccessor;
+		};
+		std::vector<DfsStackEntry> stack;
+		auto discover = [&](V const& _v, DfsIndex _parentIdx) {
+			DfsIndex index = m_verticesInDFSOrder.size();
 			m_verticesInDFSOrder.emplace_back(_v.id);
-			m_dfsIndexByVertexId[_v.id] = nextUnusedDFSIndex;
-			nextUnusedDFSIndex++;
+			m_dfsIndexByVertexId.emplace(_v.id, index);
+			parent.emplace_back(_parentIdx);
+			m_predecessors.emplace_back();
+			if (_parentIdx != c_noIndex)
+				m_predecessors.back().emplace_back(_parentIdx);
 
+			DfsStackEntry& entry = stack.emplace_back(DfsStackEntry{index, {}, 0});
 			ForEachSuccessor{}(_v, [&](V const& _successor) {
-				if (visited.count(_successor.id) == 0)
-				{
-					parent.push_back(m_dfsIndexByVertexId[_v.id]);
-					m_predecessors.push_back({m_dfsIndexByVertexId[_v.id]});
-					_dfs(_successor, _dfs);
-				}
-				else
-				{
-					solAssert(m_dfsIndexByVertexId[_successor.id] < m_predecessors.size());
-					m_predecessors[m_dfsIndexByVertexId[_successor.id]].insert(m_dfsIndexByVertexId[_v.id]);
-				}
+				entry.successors.emplace_back(&_successor);
 			});
 		};
 
-		parent.emplace_back(std::numeric_limits<DfsIndex>::max());
-		m_predecessors.emplace_back();
-		dfs(_entry, dfs);
+		discover(_entry, c_noIndex);
+		while (!stack.empty())
+		{
+			DfsStackEntry& top = stack.back();
+			if (top.nextSuccessor == top.successors.size())
+			{
+				stack.pop_back();
+				continue;
+			}
+			DfsIndex vIdx = top.index;
+			V const& successor = *top.successors[top.nextSuccessor++];
+			if (auto it = m_dfsIndexByVertexId.find(successor.id); it != m_dfsIndexByVertexId.end())
+				m_predecessors[it->second].emplace_back(vIdx);
+			else
+				discover(successor, vIdx);
+		}
 
-		size_t numVertices = visited.size();
-		solAssert(nextUnusedDFSIndex == numVertices);
-		solAssert(m_verticesInDFSOrder.size() == numVertices);
-		solAssert(visited.size() == numVertices);
+		size_t numVertices = m_verticesInDFSOrder.size();
+		solAssert(m_dfsIndexByVertexId.size() == numVertices);
 		solAssert(m_predecessors.size() == numVertices);
 		solAssert(parent.size() == numVertices);
 
@@ -230,32 +270,19 @@ private:
 		// The forest consists of disjoint subtrees of the spanning tree and the parent of ``w`` is
 		// always one of its ancestors in that spanning tree.
 		// Initially each subtree consists of a single vertex. As the algorithm iterates over the
-		// graph, each processed vertex gets connected to its parent from the spanning tree using
-		// link(). Later on, the path compression performed by eval() may move it up in the subtree.
-		std::vector<DfsIndex> ancestor(numVertices, std::numeric_limits<DfsIndex>::max());
+		// graph, each processed vertex gets connected to its parent from the spanning tree.
+		// Later on, the path compression performed by eval() may move it up in the subtree.
+		std::vector<DfsIndex> ancestor(numVertices, c_noIndex);
 		// label(w): The index of a vertex with the smallest semidominator, on the path between ``w``
-		// and the root of its subtree. The value is not updated immediately by link(), but
+		// and the root of its subtree. The value is not updated immediately when linking, but
 		// only during path compression performed by eval().
-		std::vector<DfsIndex> label;
-		// bucket(w): The set of all vertices having ``w`` as their semidominator.
-		// The index of the array represents the vertex' DFS index.
-		std::vector<std::deque<DfsIndex>> bucket(numVertices);
-
+		std::vector<DfsIndex> label(numVertices);
 		// semi(w): The DFS index of the semidominator of ``w``.
-		std::vector<DfsIndex> semi;
-		// idom(w): The DFS index of the immediate dominator of ``w``.
-		std::vector<std::optional<DfsIndex>> idom(numVertices, std::nullopt);
-
-		// ``link(v, w)`` adds an edge from ``w`` to ``v`` in the virtual forest.
-		// It is meant to initially attach vertex ``w`` to its parent from the spanning tree,
-		// but path compression can later limit the search path upwards.
-		// TODO: implement sophisticated link-eval algorithm as shown in pg 132
-		// See: https://www.cs.princeton.edu/courses/archive/spr03/cs423/download/dominators.pdf
-		auto link = [&](DfsIndex _parentIdx, DfsIndex _wIdx)
-		{
-			solAssert(ancestor[_wIdx] == std::numeric_limits<DfsIndex>::max());
-			ancestor[_wIdx] = _parentIdx;
-		};
+		std::vector<DfsIndex> semi(numVertices);
+		for (DfsIndex wIdx = 0; wIdx < numVertices; ++wIdx)
+			semi[wIdx] = label[wIdx] = wIdx;
+		// Vertices on the path that is being compressed by eval().
+		std::vector<DfsIndex> path;
 
 		// ``eval(v)`` returns a vertex with the smallest semidominator index on the path between
 		// vertex ``v`` and the root of its subtree in the virtual forest, i.e. the label of ``v``.
@@ -263,92 +290,60 @@ private:
 		// the subtree root.
 		auto eval = [&](DfsIndex _vIdx) -> DfsIndex
 		{
-			if (ancestor[_vIdx] == std::numeric_limits<DfsIndex>::max())
+			if (ancestor[_vIdx] == c_noIndex)
 				return _vIdx;
 
-			compressPath(ancestor, label, semi, _vIdx);
+			path.clear();
+			for (DfsIndex uIdx = _vIdx; ancestor[ancestor[uIdx]] != c_noIndex; uIdx = ancestor[uIdx])
+			{
+				solAssert(ancestor[uIdx] < uIdx);
+				path.emplace_back(uIdx);
+			}
+			// Compress from the top, so that the ancestor of each vertex is already compressed.
+			for (DfsIndex uIdx: path | ranges::views::reverse)
+			{
+				DfsIndex ancestorIdx = ancestor[uIdx];
+				if (semi[label[ancestorIdx]] < semi[label[uIdx]])
+					label[uIdx] = label[ancestorIdx];
+				ancestor[uIdx] = ancestor[ancestorIdx];
+			}
 			return label[_vIdx];
 		};
 
-		auto toDfsIndex = [&](VId const& _vId) { return m_dfsIndexByVertexId[_vId]; };
-
-		for (DfsIndex wIdx = 0; wIdx < m_verticesInDFSOrder.size(); ++wIdx)
+		// step 2
+		// Compute the semidominators in decreasing order of the DFS number.
+		for (DfsIndex wIdx = numVertices - 1; wIdx > 0; --wIdx)
 		{
-			semi.push_back(wIdx);
-			label.push_back(wIdx);
-		}
-
-		// Process the vertices in decreasing order of the DFS number
-		for (DfsIndex wIdx: m_verticesInDFSOrder | ranges::views::reverse | ranges::views::transform(toDfsIndex))
-		{
-			// step 3
-			// NOTE: this is an optimization, i.e. performing the step 3 before step 2.
-			// The goal is to process the bucket at the beginning of the loop for the vertex ``w``
-			// instead of ``parent[w]`` at the end of the loop as described in the original paper.
-			// Inverting those steps ensures that a bucket is only processed once and
-			// it does not need to be erased.
-			// The optimization proposal is available here: https://jgaa.info/index.php/jgaa/article/view/paper119/2847 pg.77
-			for (DfsIndex vIdx: bucket[wIdx])
-			{
-				DfsIndex uIdx = eval(vIdx);
-				solAssert(uIdx <= vIdx);
-				idom[vIdx] = (semi[uIdx] < semi[vIdx]) ? uIdx : wIdx;
-			}
-
-			// step 2
 			for (DfsIndex vIdx: m_predecessors[wIdx])
 			{
 				DfsIndex uIdx = eval(vIdx);
-				solAssert(uIdx <= vIdx);
 				if (semi[uIdx] < semi[wIdx])
 					semi[wIdx] = semi[uIdx];
 			}
-			solAssert(semi[wIdx] < wIdx || wIdx == 0);
-			bucket[semi[wIdx]].emplace_back(wIdx);
-			link(parent[wIdx], wIdx);
-			solAssert(ancestor[wIdx] == parent[wIdx]);
-		}
-
-		// step 4
-		// Compute idom in DFS order
-		// The entry vertex does not have an immediate dominator.
-		solAssert(idom[0] == std::nullopt);
-		for (DfsIndex wIdx: m_verticesInDFSOrder | ranges::views::drop(1) | ranges::views::transform(toDfsIndex))
-		{
-			// All the other vertices must have an immediate dominator.
-			solAssert(idom[wIdx].has_value());
-			if (idom[wIdx].value() != semi[wIdx])
-				idom[wIdx] = idom[idom[wIdx].value()];
+			solAssert(semi[wIdx] < wIdx);
+			ancestor[wIdx] = parent[wIdx];
 		}
 
-		return idom;
-	}
-
-	/// Path compression updates the ancestors of vertices along
-	/// the path to the ancestor with the minimum label value.
-	static void compressPath(
-		std::vector<DfsIndex>& _ancestor,
-		std::vector<DfsIndex>& _label,
-		std::vector<DfsIndex> const& _semi,
-		DfsIndex _vIdx
-	)
-	{
-		solAssert(_vIdx < _ancestor.size() && _vIdx < _semi.size() && _vIdx < _label.size());
-		solAssert(_ancestor[_vIdx] != std::numeric_limits<size_t>::max());
-		solAssert(_ancestor[_vIdx] < _vIdx);
-		if (_ancestor[_ancestor[_vIdx]] != std::numeric_limits<DfsIndex>::max())
+		// step 3
+		// The immediate dominator of ``w`` is the nearest common ancestor of ``semi(w)`` and
+		// ``parent(w)`` in the dominator tree. Since the tree is built in DFS order, the dominators
+		// of all vertices on the path are already known and the ancestor is the first vertex
+		// on the path from ``parent(w)`` upwards whose index is not greater than ``semi(w)``.
+		std::vector<DfsIndex> idom(numVertices, 0);
+		m_immediateDominators.assign(numVertices, std::nullopt);
+		for (DfsIndex wIdx = 1; wIdx < numVertices; ++wIdx)
 		{
-			solAssert(_ancestor[_ancestor[_vIdx]] < _ancestor[_vIdx]);
-			compressPath(_ancestor, _label, _semi, _ancestor[_vIdx]);
-			if (_semi[_label[_ancestor[_vIdx]]] < _semi[_label[_vIdx]])
-				_label[_vIdx] = _label[_ancestor[_vIdx]];
-			_ancestor[_vIdx] = _ancestor[_ancestor[_vIdx]];
+			DfsIndex dominatorIdx = parent[wIdx];
+			while (dominatorIdx > semi[wIdx])
+				dominatorIdx = idom[dominatorIdx];
+			idom[wIdx] = dominatorIdx;
+			m_immediateDominators[wIdx] = dominatorIdx;
 		}
-		solAssert(_label[_ancestor[_vIdx]] <= _label[_vIdx]);
 	}
 
 	/// Build dominator tree from the immediate dominators set.
-	/// The function groups all the vertex IDs that are immediately dominated by a vertex.
+	/// The function groups all the vertex IDs that are immediately dominated by a vertex
+	/// and numbers the vertices in preorder of the tree for dominates().
 	void buildDominatorTree()
 	{
 		// m_immediateDominators is guaranteed to have at least one element after findingDominators() is executed.
@@ -356,26 +351,47 @@ private:
 		solAssert(m_immediateDominators.size() == m_verticesInDFSOrder.size());
 		solAssert(m_immediateDominators[0] == std::nullopt);
 
+		std::vector<std::vector<DfsIndex>> children(m_verticesInDFSOrder.size());
 		// Ignoring the entry node since no one dominates it.
 		for (DfsIndex dominatedIdx = 1; dominatedIdx < m_verticesInDFSOrder.size(); ++dominatedIdx)
 		{
-			VId dominatedId = m_verticesInDFSOrder[dominatedIdx];
-			solAssert(m_dfsIndexByVertexId.count(dominatedId));
-			solAssert(dominatedIdx == m_dfsIndexByVertexId.at(dominatedId));
-
 			// If the vertex does not have an immediate dominator, it is the entry vertex (i.e. index 0).
 			// NOTE: `dominatedIdx` will never be 0 since the loop starts from 1.
 			solAssert(m_immediateDominators[dominatedIdx].has_value());
 			DfsIndex dominatorIdx = m_immediateDominators[dominatedIdx].value();
 
 			solAssert(dominatorIdx < dominatedIdx);
-			VId dominatorId = m_verticesInDFSOrder[dominatorIdx];
-			m_dominatorTree[dominatorId].emplace_back(dominatedId);
+			children[dominatorIdx].emplace_back(dominatedIdx);
+			m_dominatorTree[m_verticesInDFSOrder[dominatorIdx]].emplace_back(m_verticesInDFSOrder[dominatedIdx]);
 		}
+
+		m_treePreorderIndex.assign(m_verticesInDFSOrder.size(), 0);
+		m_treeSubtreeEnd.assign(m_verticesInDFSOrder.size(), 0);
+		size_t nextPreorderIndex = 0;
+		// Pairs of a vertex and the index of its next child to visit.
+		std::vector<std::pair<DfsIndex, size_t>> stack{{0, 0}};
+		m_treePreorderIndex[0] = nextPreorderIndex++;
+		while (!stack.empty())
+		{
+			auto& [vIdx, nextChild] = stack.back();
+			if (nextChild < children[vIdx].size())
+			{
+				DfsIndex childIdx = children[vIdx][nextChild++];
+				m_treePreorderIndex[childIdx] = nextPreorderIndex++;
+				stack.emplace_back(childIdx, 0);
+			}
+			else
+			{
+				m_treeSubtreeEnd[vIdx] = nextPreorderIndex;
+				stack.pop_back();
+			}
+		}
+		solAssert(nextPreorderIndex == m_verticesInDFSOrder.size());
 	}
 
-	// predecessors(w): The set of vertices ``v`` such that (``v``, ``w``) is an edge of the graph.
-	std::vector<std::set<DfsIndex>> m_predecessors;
+	// predecessors(w): The vertices ``v`` such that (``v``, ``w``) is an edge of the graph.
+	// May contain duplicates if there are multiple edges between two vertices.
+	std::vector<std::vector<DfsIndex>> m_predecessors;
 
 	/// Keeps the list of vertex IDs in the DFS order.
 	/// The entry vertex is the first element of the vector.
@@ -397,6 +413,13 @@ private:
 	/// Vertex id -> dominates set {vertex ID}
 	std::map<VId, std::vector<VId>> m_dominatorTree;
 
+	/// Index of each vertex in a preorder traversal of the dominator tree and the end of the range of
+	/// preorder indices of its subtree. A vertex dominates exactly the vertices in that range.
+	///
+	/// DFS index -> preorder index
+	std::vector<size_t> m_treePreorderIndex;
+	std::vector<size_t> m_treeSubtreeEnd;
+
 	/// Immediate dominators by DFS index.
 	/// Maps a vertex' DFS index (i.e. array index) to its immediate dominator DFS index.
 	/// As the entry vertex does not have immediate dominator, its idom is always set to `std::nullopt`.
@@ -0,0 +1,493 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-width 256-bit unsigned integer with wrapping arithmetic.
+ */
+
+#pragma once
+
+#include <libsolutil/Numeric.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace solidity::util
+{
+
+/**
+ * Unsigned 256-bit integer stored in four 64-bit limbs, least significant limb first.
+ *
+ * All arithmetic wraps modulo 2**256, like the EVM and unlike bigint. The type never allocates
+ * and is meant for the hot paths that compute with u256 values, which convert at the boundary
+ * using the explicit constructor and toU256().
+ *
+ * Division and modulo by zero are not allowed, callers have to handle that case the way the
+ * EVM does. The static member functions provide the remaining EVM operations.
+ */
+class FixedU256
+{
+public:
+	static constexpr size_t numLimbs = 4;
+
+	constexpr FixedU256() = default;
+	constexpr FixedU256(uint64_t _value): m_limbs{_value, 0, 0, 0} {}
+	explicit FixedU256(u256 const& _value)
+	{
+		using boost::multiprecision::limb_type;
+		constexpr size_t limbBits = sizeof(limb_type) * 8;
+		static_assert(limbBits == 32 || limbBits == 64);
+
+		auto const& backend = _value.backend();
+		for (size_t i = 0; i < backend.size(); ++i)
+			m_limbs[i * limbBits / 64] |= uint64_t(backend.limbs()[i]) << (i * limbBits % 64);
+	}
+
+	u256 toU256() const
+	{
+		using boost::multiprecision::limb_type;
+		constexpr size_t limbBits = sizeof(limb_type) * 8;
+		constexpr size_t boostLimbs = 256 / limbBits;
+
+		u256 result;
+		auto& backend = result.backend();
+		backend.resize(boostLimbs, boostLimbs);
+		for (size_t i = 0; i < boostLimbs; ++i)
+			backend.limbs()[i] = limb_type(m_limbs[i * limbBits / 64] >> (i * limbBits % 64));
+		backend.normalize();
+		return result;
+	}
+
+	constexpr uint64_t limb(size_t _index) const { return m_limbs[_index]; }
+
+	constexpr bool isZero() const { return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	constexpr explicit operator bool() const { return !isZero(); }
+	constexpr bool bitTest(size_t _bit) const { return _bit < 256 && ((m_limbs[_bit / 64] >> (_bit % 64)) & 1); }
+	/// @returns true if the most significant bit is set, i.e. if the value is negative in two's complement.
+	constexpr bool isNegative() const { return bitTest(255); }
+	/// @returns the number of significant bits, zero for zero.
+	size_t bitLength() const
+	{
+		for (size_t i = numLimbs; i > 0; --i)
+			if (m_limbs[i - 1])
+				return (i - 1) * 64 + 64 - countLeadingZeros(m_limbs[i - 1]);
+		return 0;
+	}
+
+	friend constexpr bool operator==(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		for (size_t i = 0; i < numLimbs; ++i)
+			if (_a.m_limbs[i] != _b.m_limbs[i])
+				return false;
+		return true;
+	}
+	friend constexpr bool operator!=(FixedU256 const& _a, FixedU256 const& _b) { return !(_a == _b); }
+	friend constexpr bool operator<(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		for (size_t i = numLimbs; i > 0; --i)
+			if (_a.m_limbs[i - 1] != _b.m_limbs[i - 1])
+				return _a.m_limbs[i - 1] < _b.m_limbs[i - 1];
+		return false;
+	}
+	friend constexpr bool operator>(FixedU256 const& _a, FixedU256 const& _b) { return _b < _a; }
+	friend constexpr bool operator<=(FixedU256 const& _a, FixedU256 const& _b) { return !(_b < _a); }
+	friend constexpr bool operator>=(FixedU256 const& _a, FixedU256 const& _b) { return !(_a < _b); }
+
+	friend constexpr FixedU256 operator~(FixedU256 _a)
+	{
+		for (uint64_t& limb: _a.m_limbs)
+			limb = ~limb;
+		return _a;
+	}
+	friend constexpr FixedU256 operator&(FixedU256 _a, FixedU256 const& _b)
+	{
+		for (size_t i = 0; i < numLimbs; ++i)
+			_a.m_limbs[i] &= _b.m_limbs[i];
+		return _a;
+	}
+	friend constexpr FixedU256 operator|(FixedU256 _a, FixedU256 const& _b)
+	{
+		for (size_t i = 0; i < numLimbs; ++i)
+			_a.m_limbs[i] |= _b.m_limbs[i];
+		return _a;
+	}
+	friend constexpr FixedU256 operator^(FixedU256 _a, FixedU256 const& _b)
+	{
+		for (size_t i = 0; i < numLimbs; ++i)
+			_a.m_limbs[i] ^= _b.m_limbs[i];
+		return _a;
+	}
+
+	friend constexpr FixedU256 operator+(FixedU256 _a, FixedU256 const& _b)
+	{
+		uint64_t carry = 0;
+		for (size_t i = 0; i < numLimbs; ++i)
+			_a.m_limbs[i] = addWithCarry(_a.m_limbs[i], _b.m_limbs[i], carry);
+		return _a;
+	}
+	friend constexpr FixedU256 operator-(FixedU256 _a, FixedU256 const& _b)
+	{
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < numLimbs; ++i)
+		{
+			uint64_t difference = _a.m_limbs[i] - _b.m_limbs[i];
+			uint64_t nextBorrow = (_a.m_limbs[i] < _b.m_limbs[i]) | (difference < borrow);
+			_a.m_limbs[i] = difference - borrow;
+			borrow = nextBorrow;
+		}
+		return _a;
+	}
+	friend constexpr FixedU256 operator-(FixedU256 const& _a) { return FixedU256{} - _a; }
+	friend FixedU256 operator*(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < numLimbs; ++i)
+		{
+			uint64_t carry = 0;
+			for (size_t j = 0; i + j < numLimbs; ++j)
+			{
+				auto [high, low] = multiply(_a.m_limbs[i], _b.m_limbs[j]);
+				uint64_t lowCarry = 0;
+				result.m_limbs[i + j] = addWithCarry(result.m_limbs[i + j], low, lowCarry);
+				uint64_t sumCarry = 0;
+				result.m_limbs[i + j] = addWithCarry(result.m_limbs[i + j], carry, sumCarry);
+				carry = high + lowCarry + sumCarry;
+			}
+		}
+		return result;
+	}
+	friend FixedU256 operator/(FixedU256 const& _a, FixedU256 const& _b) { return divMod(_a, _b).first; }
+	friend FixedU256 operator%(FixedU256 const& _a, FixedU256 const& _b) { return divMod(_a, _b).second; }
+
+	friend constexpr FixedU256 operator<<(FixedU256 const& _a, size_t _shift)
+	{
+		FixedU256 result;
+		if (_shift >= 256)
+			return result;
+		size_t limbShift = _shift / 64;
+		size_t bitShift = _shift % 64;
+		for (size_t i = numLimbs; i > limbShift; --i)
+		{
+			size_t source = i - 1 - limbShift;
+			result.m_limbs[i - 1] = _a.m_limbs[source] << bitShift;
+			if (bitShift != 0 && source > 0)
+				result.m_limbs[i - 1] |= _a.m_limbs[source - 1] >> (64 - bitShift);
+		}
+		return result;
+	}
+	friend constexpr FixedU256 operator>>(FixedU256 const& _a, size_t _shift)
+	{
+		FixedU256 result;
+		if (_shift >= 256)
+			return result;
+		size_t limbShift = _shift / 64;
+		size_t bitShift = _shift % 64;
+		for (size_t i = 0; i + limbShift < numLimbs; ++i)
+		{
+			size_t source = i + limbShift;
+			result.m_limbs[i] = _a.m_limbs[source] >> bitShift;
+			if (bitShift != 0 && source + 1 < numLimbs)
+				result.m_limbs[i] |= _a.m_limbs[source + 1] << (64 - bitShift);
+		}
+		return result;
+	}
+
+	FixedU256& operator+=(FixedU256 const& _b) { return *this = *this + _b; }
+	FixedU256& operator-=(FixedU256 const& _b) { return *this = *this - _b; }
+	FixedU256& operator*=(FixedU256 const& _b) { return *this = *this * _b; }
+	FixedU256& operator/=(FixedU256 const& _b) { return *this = *this / _b; }
+	FixedU256& operator%=(FixedU256 const& _b) { return *this = *this % _b; }
+	FixedU256& operator&=(FixedU256 const& _b) { return *this = *this & _b; }
+	FixedU256& operator|=(FixedU256 const& _b) { return *this = *this | _b; }
+	FixedU256& operator^=(FixedU256 const& _b) { return *this = *this ^ _b; }
+	FixedU256& operator<<=(size_t _shift) { return *this = *this << _shift; }
+	FixedU256& operator>>=(size_t _shift) { return *this = *this >> _shift; }
+
+	/// @returns the quotient and the remainder of @a _a divided by the non-zero @a _b.
+	static std::pair<FixedU256, FixedU256> divMod(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		solAssert(!_b.isZero(), "Division by zero.");
+		if (_a < _b)
+			return {FixedU256{}, _a};
+		if ((_a.m_limbs[1] | _a.m_limbs[2] | _a.m_limbs[3]) == 0)
+			return {FixedU256(_a.m_limbs[0] / _b.m_limbs[0]), FixedU256(_a.m_limbs[0] % _b.m_limbs[0])};
+
+		std::array<uint32_t, 2 * numLimbs> quotient{};
+		std::array<uint32_t, 2 * numLimbs> remainder{};
+		divideDigits(toDigits(_a).data(), 2 * numLimbs, toDigits(_b).data(), 2 * numLimbs, quotient.data(), remainder.data());
+		return {fromDigits(quotient.data()), fromDigits(remainder.data())};
+	}
+
+	/// @returns (_a + _b) % _modulus computed without overflow. @a _modulus must not be zero.
+	static FixedU256 addMod(FixedU256 const& _a, FixedU256 const& _b, FixedU256 const& _modulus)
+	{
+		solAssert(!_modulus.isZero(), "Division by zero.");
+		FixedU256 sum = _a + _b;
+		if (sum >= _a)
+			return sum % _modulus;
+
+		// The sum overflowed, divide the full 257-bit value.
+		std::array<uint32_t, 2 * numLimbs + 1> dividend{};
+		std::array<uint32_t, 2 * numLimbs> sumDigits = toDigits(sum);
+		std::copy(sumDigits.begin(), sumDigits.end(), dividend.begin());
+		dividend.back() = 1;
+		return modDigits(dividend.data(), dividend.size(), _modulus);
+	}
+
+	/// @returns (_a * _b) % _modulus computed without overflow. @a _modulus must not be zero.
+	static FixedU256 mulMod(FixedU256 const& _a, FixedU256 const& _b, FixedU256 const& _modulus)
+	{
+		solAssert(!_modulus.isZero(), "Division by zero.");
+		std::array<uint64_t, 2 * numLimbs> product{};
+		for (size_t i = 0; i < numLimbs; ++i)
+		{
+			uint64_t carry = 0;
+			for (size_t j = 0; j < numLimbs; ++j)
+			{
+				auto [high, low] = multiply(_a.m_limbs[i], _b.m_limbs[j]);
+				uint64_t lowCarry = 0;
+				product[i + j] = addWithCarry(product[i + j], low, lowCarry);
+				uint64_t sumCarry = 0;
+				product[i + j] = addWithCarry(product[i + j], carry, sumCarry);
+				carry = high + lowCarry + sumCarry;
+			}
+			product[i + numLimbs] = carry;
+		}
+
+		std::array<uint32_t, 4 * numLimbs> dividend{};
+		for (size_t i = 0; i < product.size(); ++i)
+		{
+			dividend[2 * i] = uint32_t(product[i]);
+			dividend[2 * i + 1] = uint32_t(product[i] >> 32);
+		}
+		return modDigits(dividend.data(), dividend.size(), _modulus);
+	}
+
+	/// @returns _base ** _exponent modulo 2**256.
+	static FixedU256 exp(FixedU256 _base, FixedU256 _exponent)
+	{
+		FixedU256 result = 1;
+		for (size_t bits = _exponent.bitLength(); bits > 0; --bits)
+		{
+			if (_exponent.m_limbs[0] & 1)
+				result *= _base;
+			_base *= _base;
+			_exponent >>= 1;
+		}
+		return result;
+	}
+
+	/// @returns @a _a divided by the non-zero @a _b, both interpreted as two's complement signed
+	/// numbers, rounding towards zero.
+	static FixedU256 signedDiv(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 quotient = divMod(_a.isNegative() ? -_a : _a, _b.isNegative() ? -_b : _b).first;
+		return _a.isNegative() != _b.isNegative() ? -quotient : quotient;
+	}
+
+	/// @returns @a _a modulo the non-zero @a _b, both interpreted as two's complement signed numbers.
+	/// The result has the sign of @a _a.
+	static FixedU256 signedMod(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 remainder = divMod(_a.isNegative() ? -_a : _a, _b.isNegative() ? -_b : _b).second;
+		return _a.isNegative() ? -remainder : remainder;
+	}
+
+private:
+	static constexpr uint64_t addWithCarry(uint64_t _a, uint64_t _b, uint64_t& _carry)
+	{
+		uint64_t sum = _a + _b;
+		uint64_t carry = sum < _a;
+		sum += _carry;
+		carry |= sum < _carry;
+		_carry = carry;
+		return sum;
+	}
+
+	/// @returns the high and the low half of the 128-bit product of @a _a and @a _b.
+	static std::pair<uint64_t, uint64_t> multiply(uint64_t _a, uint64_t _b)
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 product = static_cast<unsigned __int128>(_a) * _b;
+		return {uint64_t(product >> 64), uint64_t(product)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+		uint64_t high = 0;
+		uint64_t low = _umul128(_a, _b, &high);
+		return {high, low};
+#else
+		uint64_t aLow = uint32_t(_a);
+		uint64_t aHigh = _a >> 32;
+		uint64_t bLow = uint32_t(_b);
+		uint64_t bHigh = _b >> 32;
+		uint64_t lowLow = aLow * bLow;
+		uint64_t highLow = aHigh * bLow;
+		uint64_t lowHigh = aLow * bHigh;
+		uint64_t middle = (lowLow >> 32) + uint32_t(highLow) + uint32_t(lowHigh);
+		return {aHigh * bHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32), (middle << 32) | uint32_t(lowLow)};
+#endif
+	}
+
+	static size_t countLeadingZeros(uint64_t _value)
+	{
+		solAssert(_value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_t>(__builtin_clzll(_value));
+#else
+		size_t count = 0;
+		for (uint64_t mask = uint64_t(1) << 63; !(_value & mask); mask >>= 1)
+			++count;
+		return count;
+#endif
+	}
+
+	static std::array<uint32_t, 2 * numLimbs> toDigits(FixedU256 const& _value)
+	{
+		std::array<uint32_t, 2 * numLimbs> digits{};
+		for (size_t i = 0; i < numLimbs; ++i)
+		{
+			digits[2 * i] = uint32_t(_value.m_limbs[i]);
+			digits[2 * i + 1] = uint32_t(_value.m_limbs[i] >> 32);
+		}
+		return digits;
+	}
+
+	static FixedU256 fromDigits(uint32_t const* _digits)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < numLimbs; ++i)
+			result.m_limbs[i] = uint64_t(_digits[2 * i]) | (uint64_t(_digits[2 * i + 1]) << 32);
+		return result;
+	}
+
+	/// @returns the remainder of dividing the @a _numDigits digits at @a _dividend by @a _modulus.
+	static FixedU256 modDigits(uint32_t const* _dividend, size_t _numDigits, FixedU256 const& _modulus)
+	{
+		std::array<uint32_t, 4 * numLimbs> quotient{};
+		std::array<uint32_t, 2 * numLimbs> remainder{};
+		divideDigits(_dividend, _numDigits, toDigits(_modulus).data(), 2 * numLimbs, quotient.data(), remainder.data());
+		return fromDigits(remainder.data());
+	}
+
+	/// Divides the @a _m digits of @a _u by the @a _n digits of the non-zero @a _v (both base 2**32,
+	/// least significant first) using Knuth's algorithm D. Writes the quotient to @a _q, which has
+	/// room for @a _m digits, and the remainder to @a _r, which has room for @a _n digits.
+	/// Only 64-bit arithmetic on 32-bit digits is used, which keeps this portable.
+	static void divideDigits(uint32_t const* _u, size_t _m, uint32_t const* _v, size_t _n, uint32_t* _q, uint32_t* _r)
+	{
+		constexpr uint64_t base = uint64_t(1) << 32;
+		constexpr size_t maxDigits = 4 * numLimbs;
+
+		while (_m > 0 && _u[_m - 1] == 0)
+			--_m;
+		while (_n > 0 && _v[_n - 1] == 0)
+			--_n;
+		solAssert(_n > 0 && _m <= maxDigits);
+		if (_m < _n)
+		{
+			std::copy(_u, _u + _m, _r);
+			return;
+		}
+
+		if (_n == 1)
+		{
+			uint64_t remainder = 0;
+			for (size_t j = _m; j > 0; --j)
+			{
+				uint64_t current = remainder * base + _u[j - 1];
+				_q[j - 1] = uint32_t(current / _v[0]);
+				remainder = current - _q[j - 1] * uint64_t(_v[0]);
+			}
+			_r[0] = uint32_t(remainder);
+			return;
+		}
+
+		// Normalize so that the most significant digit of the divisor has its top bit set.
+		size_t shift = countLeadingZeros(_v[_n - 1]) - 32;
+		std::array<uint32_t, maxDigits> vn{};
+		std::array<uint32_t, maxDigits + 1> un{};
+		for (size_t i = _n - 1; i > 0; --i)
+			vn[i] = uint32_t((uint64_t(_v[i]) << shift) | (uint64_t(_v[i - 1]) >> (32 - shift)));
+		vn[0] = uint32_t(uint64_t(_v[0]) << shift);
+		un[_m] = uint32_t(uint64_t(_u[_m - 1]) >> (32 - shift));
+		for (size_t i = _m - 1; i > 0; --i)
+			un[i] = uint32_t((uint64_t(_u[i]) << shift) | (uint64_t(_u[i - 1]) >> (32 - shift)));
+		un[0] = uint32_t(uint64_t(_u[0]) << shift);
+
+		for (size_t j = _m - _n + 1; j > 0; --j)
+		{
+			size_t position = j - 1;
+			uint64_t numerator = uint64_t(un[position + _n]) * base + un[position + _n - 1];
+			uint64_t quotientDigit = numerator / vn[_n - 1];
+			uint64_t remainderDigit = numerator - quotientDigit * vn[_n - 1];
+			while (
+				quotientDigit >= base ||
+				quotientDigit * vn[_n - 2] > remainderDigit * base + un[position + _n - 2]
+			)
+			{
+				--quotientDigit;
+				remainderDigit += vn[_n - 1];
+				if (remainderDigit >= base)
+					break;
+			}
+
+			// Multiply and subtract.
+			int64_t borrow = 0;
+			int64_t difference = 0;
+			for (size_t i = 0; i < _n; ++i)
+			{
+				uint64_t product = quotientDigit * vn[i];
+				difference = int64_t(un[i + position]) - borrow - int64_t(product & 0xffffffff);
+				un[i + position] = uint32_t(difference);
+				borrow = int64_t(product >> 32) - (difference >> 32);
+			}
+			difference = int64_t(un[position + _n]) - borrow;
+			un[position + _n] = uint32_t(difference);
+
+			_q[position] = uint32_t(quotientDigit);
+			if (difference < 0)
+			{
+				// The estimate was one too large, add the divisor back.
+				--_q[position];
+				uint64_t carry = 0;
+				for (size_t i = 0; i < _n; ++i)
+				{
+					uint64_t sum = uint64_t(un[i + position]) + vn[i] + carry;
+					un[i + position] = uint32_t(sum);
+					carry = sum >> 32;
+				}
+				un[position + _n] = uint32_t(un[position + _n] + carry);
+			}
+		}
+
+		for (size_t i = 0; i + 1 < _n; ++i)
+			_r[i] = uint32_t((uint64_t(un[i]) >> shift) | (uint64_t(un[i + 1]) << (32 - shift)));
+		_r[_n - 1] = uint32_t(uint64_t(un[_n - 1]) >> shift);
+	}
+
+	std::array<uint64_t, numLimbs> m_limbs{};
+};
+
+}
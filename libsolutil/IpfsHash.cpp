@@ -69,31 +69,26 @@ std::string base58Encode(bytes const& _data)
 	return output;
 }
 
-struct Chunk
-{
-	Chunk() = default;
-	Chunk(bytes _hash, size_t _size, size_t _blockSize):
-		hash(std::move(_hash)),
-		size(_size),
-		blockSize(_blockSize)
-	{}
-
-	bytes hash = {};
-	size_t size = 0;
-	size_t blockSize = 0;
-};
+size_t const c_maxChunkSize = 1024 * 256;
+size_t const c_maxChildNum = 174;
 
-using Chunks = std::vector<Chunk>;
+bytes encodeHash(picosha2::hash256_one_by_one& _hasher)
+{
+	_hasher.finish();
+	bytes hash(picosha2::k_digest_size);
+	_hasher.get_hash_bytes(hash.begin(), hash.end());
+	return bytes{0x12, 0x20} + hash;
+}
 
-Chunk combineLinks(Chunks& _links)
+IpfsHasher::Node combineLinks(std::vector<IpfsHasher::Node>& _links)
 {
 	bytes data = {};
 	bytes lengths = {};
-	Chunk chunk = {};
-	for (Chunk& link: _links)
+	IpfsHasher::Node node = {};
+	for (IpfsHasher::Node& link: _links)
 	{
-		chunk.size += link.size;
-		chunk.blockSize += link.blockSize;
+		node.size += link.size;
+		node.blockSize += link.blockSize;
 
 		data += encodeLinkData(
 			bytes {0x0a} +
@@ -106,97 +101,117 @@ Chunk combineLinks(Chunks& _links)
 		lengths += bytes{0x20} + varintEncoding(link.size);
 	}
 
-	bytes blockData = data + encodeByteArray(bytes{0x08, 0x02, 0x18} + varintEncoding(chunk.size) + lengths);
+	bytes blockData = data + encodeByteArray(bytes{0x08, 0x02, 0x18} + varintEncoding(node.size) + lengths);
 
-	chunk.blockSize += blockData.size();
-	chunk.hash = encodeHash(blockData);
+	node.blockSize += blockData.size();
+	node.hash = encodeHash(blockData);
 
-	return chunk;
+	return node;
+}
 }
 
-Chunks buildNextLevel(Chunks& _currentLevel)
+void IpfsHasher::append(bytesConstRef _data)
 {
-	size_t const maxChildNum = 174;
-
-	Chunks nextLevel;
-	Chunks links;
-
-	for (Chunk& chunk: _currentLevel)
+	while (!_data.empty())
 	{
-		links.emplace_back(std::move(chunk.hash), chunk.size, chunk.blockSize);
-		if (links.size() == maxChildNum)
+		if (m_buffer.empty() && _data.size() > c_maxChunkSize)
 		{
-			nextLevel.emplace_back(combineLinks(links));
-			links = {};
+			// Complete chunks are hashed directly from the input. The last one is kept back
+			// until it is known whether more data follows.
+			addLeaf(_data.cropped(0, c_maxChunkSize));
+			_data = _data.cropped(c_maxChunkSize);
+			continue;
 		}
-	}
-	if (!links.empty())
-		nextLevel.emplace_back(combineLinks(links));
 
-	return nextLevel;
+		if (m_buffer.size() == c_maxChunkSize)
+		{
+			addLeaf(bytesConstRef(&m_buffer));
+			m_buffer.clear();
+		}
+		size_t size = std::min(_data.size(), c_maxChunkSize - m_buffer.size());
+		m_buffer.insert(m_buffer.end(), _data.begin(), _data.begin() + static_cast<std::ptrdiff_t>(size));
+		_data = _data.cropped(size);
+	}
 }
 
-/// Builds a tree starting from the bottom level where nodes are data nodes.
-/// Data nodes should be calculated and passed as the only level in chunk levels
-/// Each next level is calculated as following:
-///   - Pick up to maxChildNum (174) nodes until a whole level is added, group them and pass to the node in the next level
-///   - Do this until the current level has only one node, return the hash in that node
-bytes groupChunksBottomUp(Chunks _currentLevel)
+bytes IpfsHasher::finish()
 {
-	// when we reach root it will be the only node in that level
-	while (_currentLevel.size() != 1)
-		_currentLevel = buildNextLevel(_currentLevel);
+	// Empty data is represented by a single empty chunk.
+	if (!m_buffer.empty() || m_nodeCounts.empty())
+		addLeaf(bytesConstRef(&m_buffer));
+	m_buffer.clear();
+
+	// Link the remaining nodes of each level from a parent until a level has a single node,
+	// which is the root. This groups nodes exactly like building the DAG level by level.
+	bytes root;
+	for (size_t level = 0; root.empty(); ++level)
+	{
+		std::vector<Node> nodes = std::move(m_pendingNodes[level]);
+		if (m_nodeCounts[level] == 1)
+			root = std::move(nodes.front().hash);
+		else if (!nodes.empty())
+			addNode(level + 1, combineLinks(nodes));
+	}
 
-	// top level's only node stores the hash for file
-	return _currentLevel.front().hash;
-}
+	m_pendingNodes.clear();
+	m_nodeCounts.clear();
+	return root;
 }
 
-bytes solidity::util::ipfsHash(std::string _data)
+void IpfsHasher::addLeaf(bytesConstRef _chunk)
 {
-	size_t const maxChunkSize = 1024 * 256;
-	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
-	chunkCount = chunkCount == 0 ? 1 : chunkCount;
-
-	Chunks allChunks;
+	bytes lengthAsVarint = varintEncoding(_chunk.size());
+
+	// Type: File
+	bytes protobufPrefix{0x08, 0x02};
+	if (!_chunk.empty())
+		// Data (length delimited bytes)
+		protobufPrefix += bytes{0x12} + lengthAsVarint;
+	// filesize: length as varint
+	bytes protobufSuffix = bytes{0x18} + lengthAsVarint;
+
+	// PBDag:
+	// Data: (length delimited bytes)
+	size_t protobufSize = protobufPrefix.size() + _chunk.size() + protobufSuffix.size();
+	bytes blockPrefix = bytes{0x0a} + varintEncoding(protobufSize) + protobufPrefix;
+
+	// Multihash: sha2-256, 256 bits
+	picosha2::hash256_one_by_one hasher;
+	hasher.process(blockPrefix.begin(), blockPrefix.end());
+	hasher.process(_chunk.begin(), _chunk.end());
+	hasher.process(protobufSuffix.begin(), protobufSuffix.end());
+	addNode(0, Node{
+		encodeHash(hasher),
+		_chunk.size(),
+		blockPrefix.size() + _chunk.size() + protobufSuffix.size()
+	});
+}
 
-	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+void IpfsHasher::addNode(size_t _level, Node _node)
+{
+	if (m_pendingNodes.size() <= _level)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, std::min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
-		);
-
-		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
-
-		bytes protobufEncodedData;
-		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
-		if (!chunkBytes.empty())
-		{
-			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
-		}
-		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
-
-		// PBDag:
-		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
-
-		// Multihash: sha2-256, 256 bits
-		allChunks.emplace_back(
-			encodeHash(blockData),
-			chunkBytes.size(),
-			blockData.size()
-		);
+		m_pendingNodes.resize(_level + 1);
+		m_nodeCounts.resize(_level + 1, 0);
+	}
+	m_pendingNodes[_level].emplace_back(std::move(_node));
+	++m_nodeCounts[_level];
+	if (m_pendingNodes[_level].size() == c_maxChildNum)
+	{
+		Node parent = combineLinks(m_pendingNodes[_level]);
+		m_pendingNodes[_level].clear();
+		addNode(_level + 1, std::move(parent));
 	}
+}
 
-	return groupChunksBottomUp(std::move(allChunks));
+bytes solidity::util::ipfsHash(std::string const& _data)
+{
+	IpfsHasher hasher;
+	hasher.append(_data);
+	return hasher.finish();
 }
 
-std::string solidity::util::ipfsHashBase58(std::string _data)
+std::string solidity::util::ipfsHashBase58(std::string const& _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
@@ -19,8 +19,10 @@
 #pragma once
 
 #include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
 
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -30,9 +32,44 @@ namespace solidity::util
 /// As hash function it will use sha2-256.
 /// The effect is that the hash should be identical to the one produced by
 /// the command `ipfs add <filename>`.
-bytes ipfsHash(std::string _data);
+bytes ipfsHash(std::string const& _data);
 
 /// Compute the "ipfs hash" as above, but encoded in base58 as used by ipfs / bitcoin.
-std::string ipfsHashBase58(std::string _data);
+std::string ipfsHashBase58(std::string const& _data);
+
+/**
+ * Computes the same hash as ipfsHash() for data that is passed in pieces.
+ *
+ * Every chunk of the UnixFS DAG is hashed as soon as it is complete and only the hashes of the
+ * nodes that are not yet linked from a parent are kept, so at most one chunk of the data is
+ * held in memory.
+ */
+class IpfsHasher
+{
+public:
+	void append(bytesConstRef _data);
+	void append(std::string const& _data) { append(bytesConstRef(_data)); }
+
+	/// @returns the multihash of all data appended so far. Resets the hasher.
+	bytes finish();
+
+	struct Node
+	{
+		bytes hash;
+		size_t size = 0;
+		size_t blockSize = 0;
+	};
+
+private:
+	void addLeaf(bytesConstRef _chunk);
+	void addNode(size_t _level, Node _node);
+
+	/// Data of the chunk that is not complete yet.
+	bytes m_buffer;
+	/// Nodes of each level of the DAG that are waiting to be linked from the level above.
+	std::vector<std::vector<Node>> m_pendingNodes;
+	/// Number of nodes created on each level.
+	std::vector<size_t> m_nodeCounts;
+};
 
 }
@@ -102,6 +102,22 @@ std::string escapeNewlinesAndTabsWithinStringLiterals(std::string const& _json)
 	return fixed.str();
 }
 
+/// Formats the message of a parse error, escaping non-printable characters.
+std::string formatParseError(Json::parse_error const& _error)
+{
+	std::stringstream escaped;
+	for (char c: removeNlohmannInternalErrorIdentifier(_error.what()))
+		if (std::isprint(c))
+			escaped << c;
+		else
+			escaped << "\\x" + toHex(static_cast<uint8_t>(c));
+	return escaped.str();
+}
+
+/// Header of the binary representation: a byte that cannot start JSON text or a CBOR data item,
+/// a tag and the version of the format.
+std::string_view constexpr binaryHeader{"\xff" "SJB" "\x01", 5};
+
 } // end anonymous namespace
 
 Json removeNullMembers(Json _json)
@@ -138,6 +154,18 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format)
 	return dumped;
 }
 
+void jsonPrint(std::ostream& _stream, Json const& _input, JsonFormat const& _format)
+{
+	// Same as Json::dump(), but with the stream as the output adapter.
+	nlohmann::detail::serializer<Json> serializer(nlohmann::detail::output_adapter<char>(_stream), ' ');
+	serializer.dump(
+		_input,
+		/* pretty_print */ _format.format == JsonFormat::Pretty,
+		/* ensure_ascii */ true,
+		/* indent_step */ _format.indent
+	);
+}
+
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
 {
 	try
@@ -155,15 +183,47 @@ bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs
 	catch (Json::parse_error const& e)
 	{
 		if (_errs)
-		{
-			std::stringstream escaped;
-			for (char c: removeNlohmannInternalErrorIdentifier(e.what()))
-				if (std::isprint(c))
-					escaped << c;
-				else
-					escaped << "\\x" + toHex(static_cast<uint8_t>(c));
-			*_errs = escaped.str();
-		}
+			*_errs = formatParseError(e);
+		return false;
+	}
+}
+
+std::string jsonBinaryPrint(Json const& _input)
+{
+	std::string result{binaryHeader};
+	Json::to_cbor(_input, nlohmann::detail::output_adapter<char>(result));
+	return result;
+}
+
+bool isJsonBinary(std::string_view _input)
+{
+	return _input.substr(0, binaryHeader.size() - 1) == binaryHeader.substr(0, binaryHeader.size() - 1);
+}
+
+bool jsonParseBinary(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
+{
+	if (!isJsonBinary(_input))
+	{
+		if (_errs)
+			*_errs = "Input is not in the binary JSON format.";
+		return false;
+	}
+	if (_input.size() < binaryHeader.size() || _input[binaryHeader.size() - 1] != binaryHeader.back())
+	{
+		if (_errs)
+			*_errs = "Unsupported version of the binary JSON format.";
+		return false;
+	}
+
+	try
+	{
+		_json = Json::from_cbor(_input.begin() + static_cast<std::ptrdiff_t>(binaryHeader.size()), _input.end());
+		return true;
+	}
+	catch (Json::parse_error const& e)
+	{
+		if (_errs)
+			*_errs = formatParseError(e);
 		return false;
 	}
 }
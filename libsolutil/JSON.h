@@ -26,6 +26,7 @@
 #include <libsolutil/Assertions.h>
 #include <nlohmann/json.hpp>
 
+#include <iosfwd>
 #include <string>
 #include <string_view>
 #include <optional>
@@ -71,6 +72,10 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+/// Serialise the JSON object (@a _input) using specified format (@a _format) directly into @a _stream,
+/// without creating the whole output as a string first.
+void jsonPrint(std::ostream& _stream, Json const& _input, JsonFormat const& _format);
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -78,6 +83,22 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs = nullptr);
 
+/// Serialise the JSON object (@a _input) to a binary representation, which is a versioned header
+/// followed by the CBOR encoding of the object. It represents exactly the same values as the compact
+/// JSON text, but is smaller and considerably faster to parse.
+std::string jsonBinaryPrint(Json const& _input);
+
+/// @returns true if @a _input starts with the header of the binary representation produced by jsonBinaryPrint.
+bool isJsonBinary(std::string_view _input);
+
+/// Parse the binary representation (@a _input) produced by jsonBinaryPrint and writes resulting
+/// JSON object to (@a _json)
+/// \param _input binary input
+/// \param _json [out] resulting JSON object
+/// \param _errs [out] Formatted error messages
+/// \return \c true if the document was successfully parsed, \c false if an error occurred.
+bool jsonParseBinary(std::string const& _input, Json& _json, std::string* _errs = nullptr);
+
 /// Retrieves the value specified by @p _jsonPath by from a series of nested JSON dictionaries.
 /// @param _jsonPath A dot-separated series of dictionary keys.
 /// @param _node The node representing the start of the path.
@@ -22,6 +22,7 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <array>
 #include <cstdint>
 #include <cstring>
 
@@ -31,153 +32,276 @@ namespace solidity::util
 namespace
 {
 
-/** libkeccak-tiny
- *
- * A single-file implementation of SHA-3 and SHAKE.
- *
- * implementer: David Leon Gil
- * License: CC0, attribution kindly requested. Blame taken too,
- * but not liability.
- */
+// Keccak-f[1600] with the 25 lanes held in 64-bit words and every round fully unrolled.
+// The permutation is written against a generic lane type so that the same code runs on
+// single states and, where supported, on several states at once in vector registers.
+
+/// Round constants of the iota step.
+constexpr std::array<uint64_t, 24> c_roundConstants{
+	0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+	0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+	0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+	0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+	0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+	0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/// Number of bytes absorbed per permutation for a 256-bit output: 200 - 2 * (256 / 8).
+constexpr size_t c_rate = 136;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SOL_KECCAK_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define SOL_KECCAK_ALWAYS_INLINE inline
+#endif
+
+template <class Lane>
+SOL_KECCAK_ALWAYS_INLINE void keccakRound(Lane const* _a, Lane* _e, uint64_t _roundConstant)
+{
+	// Theta
+	Lane const c0 = _a[0] ^ _a[5] ^ _a[10] ^ _a[15] ^ _a[20];
+	Lane const c1 = _a[1] ^ _a[6] ^ _a[11] ^ _a[16] ^ _a[21];
+	Lane const c2 = _a[2] ^ _a[7] ^ _a[12] ^ _a[17] ^ _a[22];
+	Lane const c3 = _a[3] ^ _a[8] ^ _a[13] ^ _a[18] ^ _a[23];
+	Lane const c4 = _a[4] ^ _a[9] ^ _a[14] ^ _a[19] ^ _a[24];
+	Lane const d0 = c4 ^ ((c1 << 1) | (c1 >> 63));
+	Lane const d1 = c0 ^ ((c2 << 1) | (c2 >> 63));
+	Lane const d2 = c1 ^ ((c3 << 1) | (c3 >> 63));
+	Lane const d3 = c2 ^ ((c4 << 1) | (c4 >> 63));
+	Lane const d4 = c3 ^ ((c0 << 1) | (c0 >> 63));
+
+	// Rho and pi into one row of five lanes at a time, followed by chi (and iota for the first lane).
+	Lane b0, b1, b2, b3, b4;
+	b0 = _a[0] ^ d0;
+	b1 = _a[6] ^ d1;
+	b1 = (b1 << 44) | (b1 >> 20);
+	b2 = _a[12] ^ d2;
+	b2 = (b2 << 43) | (b2 >> 21);
+	b3 = _a[18] ^ d3;
+	b3 = (b3 << 21) | (b3 >> 43);
+	b4 = _a[24] ^ d4;
+	b4 = (b4 << 14) | (b4 >> 50);
+	_e[0] = b0 ^ (~b1 & b2) ^ _roundConstant;
+	_e[1] = b1 ^ (~b2 & b3);
+	_e[2] = b2 ^ (~b3 & b4);
+	_e[3] = b3 ^ (~b4 & b0);
+	_e[4] = b4 ^ (~b0 & b1);
+
+	b0 = _a[3] ^ d3;
+	b0 = (b0 << 28) | (b0 >> 36);
+	b1 = _a[9] ^ d4;
+	b1 = (b1 << 20) | (b1 >> 44);
+	b2 = _a[10] ^ d0;
+	b2 = (b2 << 3) | (b2 >> 61);
+	b3 = _a[16] ^ d1;
+	b3 = (b3 << 45) | (b3 >> 19);
+	b4 = _a[22] ^ d2;
+	b4 = (b4 << 61) | (b4 >> 3);
+	_e[5] = b0 ^ (~b1 & b2);
+	_e[6] = b1 ^ (~b2 & b3);
+	_e[7] = b2 ^ (~b3 & b4);
+	_e[8] = b3 ^ (~b4 & b0);
+	_e[9] = b4 ^ (~b0 & b1);
+
+	b0 = _a[1] ^ d1;
+	b0 = (b0 << 1) | (b0 >> 63);
+	b1 = _a[7] ^ d2;
+	b1 = (b1 << 6) | (b1 >> 58);
+	b2 = _a[13] ^ d3;
+	b2 = (b2 << 25) | (b2 >> 39);
+	b3 = _a[19] ^ d4;
+	b3 = (b3 << 8) | (b3 >> 56);
+	b4 = _a[20] ^ d0;
+	b4 = (b4 << 18) | (b4 >> 46);
+	_e[10] = b0 ^ (~b1 & b2);
+	_e[11] = b1 ^ (~b2 & b3);
+	_e[12] = b2 ^ (~b3 & b4);
+	_e[13] = b3 ^ (~b4 & b0);
+	_e[14] = b4 ^ (~b0 & b1);
+
+	b0 = _a[4] ^ d4;
+	b0 = (b0 << 27) | (b0 >> 37);
+	b1 = _a[5] ^ d0;
+	b1 = (b1 << 36) | (b1 >> 28);
+	b2 = _a[11] ^ d1;
+	b2 = (b2 << 10) | (b2 >> 54);
+	b3 = _a[17] ^ d2;
+	b3 = (b3 << 15) | (b3 >> 49);
+	b4 = _a[23] ^ d3;
+	b4 = (b4 << 56) | (b4 >> 8);
+	_e[15] = b0 ^ (~b1 & b2);
+	_e[16] = b1 ^ (~b2 & b3);
+	_e[17] = b2 ^ (~b3 & b4);
+	_e[18] = b3 ^ (~b4 & b0);
+	_e[19] = b4 ^ (~b0 & b1);
+
+	b0 = _a[2] ^ d2;
+	b0 = (b0 << 62) | (b0 >> 2);
+	b1 = _a[8] ^ d3;
+	b1 = (b1 << 55) | (b1 >> 9);
+	b2 = _a[14] ^ d4;
+	b2 = (b2 << 39) | (b2 >> 25);
+	b3 = _a[15] ^ d0;
+	b3 = (b3 << 41) | (b3 >> 23);
+	b4 = _a[21] ^ d1;
+	b4 = (b4 << 2) | (b4 >> 62);
+	_e[20] = b0 ^ (~b1 & b2);
+	_e[21] = b1 ^ (~b2 & b3);
+	_e[22] = b2 ^ (~b3 & b4);
+	_e[23] = b3 ^ (~b4 & b0);
+	_e[24] = b4 ^ (~b0 & b1);
+}
 
-/******** The Keccak-f[1600] permutation ********/
-
-/*** Constants. ***/
-static uint8_t const rho[24] = \
-	{ 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static uint8_t const pi[24] = \
-	{10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-	15, 23, 19, 13, 12, 2,
-	20, 14, 22,  9, 6,  1};
-static uint64_t const RC[24] = \
-	{1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
-	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
-	0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
-	0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
-	0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
-	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
-
-/*** Helper macros to unroll the permutation. ***/
-#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(type, v, s, e) \
-	v = 0;            \
-	REPEAT5(e; v = static_cast<type>(v + s);)
-
-/*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-	auto* a = static_cast<uint64_t*>(state);
-	uint64_t b[5] = {0};
-
-	for (int i = 0; i < 24; i++)
+template <class Lane>
+SOL_KECCAK_ALWAYS_INLINE void keccakf(Lane* _state)
+{
+	// Alternate between two copies of the state so that no round overwrites lanes it still reads.
+	Lane a[25];
+	Lane e[25];
+	for (size_t i = 0; i < 25; ++i)
+		a[i] = _state[i];
+	for (size_t round = 0; round < c_roundConstants.size(); round += 2)
 	{
-		uint8_t x, y;
-		// Theta
-		FOR5(uint8_t, x, 1,
-			b[x] = 0;
-			FOR5(uint8_t, y, 5,
-				b[x] ^= a[x + y]; ))
-		FOR5(uint8_t, x, 1,
-			FOR5(uint8_t, y, 5,
-				a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-		// Rho and pi
-		uint64_t t = a[1];
-		x = 0;
-		REPEAT24(b[0] = a[pi[x]];
-				a[pi[x]] = rol(t, rho[x]);
-				t = b[0];
-				x++; )
-		// Chi
-		FOR5(uint8_t,
-			y,
-			5,
-			FOR5(uint8_t, x, 1,
-				b[x] = a[y + x];)
-			FOR5(uint8_t, x, 1,
-				a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-		// Iota
-		a[0] ^= RC[i];
+		keccakRound(a, e, c_roundConstants[round]);
+		keccakRound(e, a, c_roundConstants[round + 1]);
 	}
+	for (size_t i = 0; i < 25; ++i)
+		_state[i] = a[i];
 }
 
-/******** The FIPS202-defined functions. ********/
+/// @returns the little-endian 64-bit word at @a _data.
+inline uint64_t loadLane(uint8_t const* _data)
+{
+	uint64_t lane = 0;
+	for (size_t i = 0; i < 8; ++i)
+		lane |= uint64_t(_data[i]) << (8 * i);
+	return lane;
+}
 
-/*** Some helper macros. ***/
+inline void storeLane(uint64_t _lane, uint8_t* _data)
+{
+	for (size_t i = 0; i < 8; ++i)
+		_data[i] = uint8_t(_lane >> (8 * i));
+}
 
-#define _(S) do { S } while (0)
-#define FOR(i, ST, L, S) \
-	_(for (size_t i = 0; i < L; i += ST) { S; })
-#define mkapply_ds(NAME, S)                                          \
-	static inline void NAME(uint8_t* dst,                              \
-							uint8_t const* src,                        \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
-	}
-#define mkapply_sd(NAME, S)                                          \
-	static inline void NAME(uint8_t const* src,                        \
-							uint8_t* dst,                              \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
+/// Writes @a _input padded to a full block into @a _block. Requires _input.size() < c_rate.
+inline void padFinalBlock(bytesConstRef _input, uint8_t* _block)
+{
+	std::memset(_block, 0, c_rate);
+	if (!_input.empty())
+		std::memcpy(_block, _input.data(), _input.size());
+	// The 0x01 is the specific padding for keccak (sha3 uses 0x06).
+	_block[_input.size()] ^= 0x01;
+	_block[c_rate - 1] ^= 0x80;
+}
+
+inline void squeeze(uint64_t const* _state, h256& _output)
+{
+	for (size_t i = 0; i < 4; ++i)
+		storeLane(_state[i], _output.data() + 8 * i);
+}
+
+h256 keccak256Single(bytesConstRef _input)
+{
+	uint64_t state[25] = {};
+	uint8_t const* data = _input.data();
+	size_t remaining = _input.size();
+	for (; remaining >= c_rate; data += c_rate, remaining -= c_rate)
+	{
+		for (size_t i = 0; i < c_rate / 8; ++i)
+			state[i] ^= loadLane(data + 8 * i);
+		keccakf(state);
 	}
 
-mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
-mkapply_sd(setout, dst[i] = src[i])  // setout
+	uint8_t block[c_rate];
+	padFinalBlock(bytesConstRef(data, remaining), block);
+	for (size_t i = 0; i < c_rate / 8; ++i)
+		state[i] ^= loadLane(block + 8 * i);
+	keccakf(state);
 
-#define P keccakf
-#define Plen 200
+	h256 output;
+	squeeze(state, output);
+	return output;
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define SOL_KECCAK_MULTI_BUFFER 1
+
+/// Four lanes of four independent states, one per 64-bit element of an AVX2 register.
+using Lane4 = uint64_t __attribute__((vector_size(32)));
+
+/// Hashes four inputs that are shorter than a block at once.
+__attribute__((target("avx2"))) void keccak256FourBlocks(bytesConstRef const* _inputs, h256* _outputs)
+{
+	uint8_t blocks[4][c_rate];
+	for (size_t j = 0; j < 4; ++j)
+		padFinalBlock(_inputs[j], blocks[j]);
 
-// Fold P*F over the full blocks of an input.
-#define foldP(I, L, F) \
-	while (L >= rate) {  \
-		F(a, I, rate);     \
-		P(a);              \
-		I += rate;         \
-		L -= rate;         \
+	Lane4 state[25] = {};
+	for (size_t i = 0; i < c_rate / 8; ++i)
+		state[i] = Lane4{
+			loadLane(blocks[0] + 8 * i),
+			loadLane(blocks[1] + 8 * i),
+			loadLane(blocks[2] + 8 * i),
+			loadLane(blocks[3] + 8 * i)
+		};
+	keccakf(state);
+
+	for (size_t j = 0; j < 4; ++j)
+	{
+		uint64_t lanes[4] = {state[0][j], state[1][j], state[2][j], state[3][j]};
+		squeeze(lanes, _outputs[j]);
 	}
+}
 
-/** The sponge-based hash construction. **/
-inline void hash(
-	uint8_t* out,
-	size_t outlen,
-	uint8_t const* in,
-	size_t inlen,
-	size_t rate,
-	uint8_t delim
-)
+bool hasAVX2()
 {
-	uint8_t a[Plen] = {0};
-	// Absorb input.
-	foldP(in, inlen, xorin);
-	// Xor in the DS and pad frame.
-	a[inlen] ^= delim;
-	a[rate - 1] ^= 0x80;
-	// Xor in the last block.
-	xorin(a, in, inlen);
-	// Apply P
-	P(a);
-	// Squeeze output.
-	foldP(out, outlen, setout);
-	setout(a, out, outlen);
-	memset(a, 0, 200);
+	static bool const result = __builtin_cpu_supports("avx2");
+	return result;
 }
+#endif
 
 }
 
 h256 keccak256(bytesConstRef _input)
 {
-	h256 output;
-	// Parameters used:
-	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
-	// the way the round size (or window or whatever it was) is calculated.
-	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
-	return output;
+	return keccak256Single(_input);
+}
+
+std::vector<h256> keccak256Batch(std::vector<bytesConstRef> const& _inputs)
+{
+	std::vector<h256> outputs(_inputs.size());
+	size_t next = 0;
+#ifdef SOL_KECCAK_MULTI_BUFFER
+	if (hasAVX2())
+	{
+		std::array<bytesConstRef, 4> group;
+		std::array<size_t, 4> indices{};
+		size_t groupSize = 0;
+		for (size_t i = 0; i < _inputs.size(); ++i)
+			if (_inputs[i].size() < c_rate)
+			{
+				group[groupSize] = _inputs[i];
+				indices[groupSize] = i;
+				if (++groupSize == group.size())
+				{
+					std::array<h256, 4> hashes;
+					keccak256FourBlocks(group.data(), hashes.data());
+					for (size_t j = 0; j < group.size(); ++j)
+						outputs[indices[j]] = hashes[j];
+					groupSize = 0;
+				}
+			}
+			else
+				outputs[i] = keccak256Single(_inputs[i]);
+		for (size_t j = 0; j < groupSize; ++j)
+			outputs[indices[j]] = keccak256Single(group[j]);
+		next = _inputs.size();
+	}
+#endif
+	for (; next < _inputs.size(); ++next)
+		outputs[next] = keccak256Single(_inputs[next]);
+	return outputs;
 }
 
 }
@@ -63,6 +63,7 @@ public:
 	{
 		this->m_value.swap(_other.m_value);
 		_other.m_value.reset();
+		return *this;
 	}
 
 	template<typename F>
@@ -79,6 +80,10 @@ public:
 		return m_value.value();
 	}
 
+	/// Discards the stored value, so that the next call to "init" computes it again.
+	/// To be used when the data the value was computed from has changed.
+	void reset() { m_value.reset(); }
+
 private:
 	/// Although not quite logically const, this is marked const for pragmatic reasons. It doesn't change the platonic
 	/// value of the object (which is something that is initialized to some computed value on first use).
@@ -23,6 +23,7 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/SmallBytes.h>
 
 #include <boost/version.hpp>
 
@@ -132,6 +133,19 @@ inline bytes toCompactBigEndian(T _val, unsigned _min = 0)
 	return ret;
 }
 
+/// Same as toCompactBigEndian, but the result is kept inline for values of up to 256 bits,
+/// so that no memory is allocated.
+template <class T>
+inline util::SmallBytes<32> toCompactBigEndianInline(T _val, unsigned _min = 0)
+{
+	static_assert(std::is_same<bigint, T>::value || !std::numeric_limits<T>::is_signed, "only unsigned types or bigint supported"); //bigint does not carry sign bit on shift
+	unsigned i = 0;
+	for (T v = _val; v; ++i, v >>= 8) {}
+	util::SmallBytes<32> ret(std::max<unsigned>(_min, i), 0);
+	toBigEndian(_val, ret);
+	return ret;
+}
+
 /// Convenience function for conversion of a u256 to hex
 inline std::string toHex(u256 val)
 {
@@ -0,0 +1,165 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
+
+using namespace solidity;
+using namespace solidity::util;
+
+thread_local Profiler* Profiler::s_active = nullptr;
+
+Profiler::Scope::Scope(
+	std::string_view _name,
+	std::string_view _category,
+	std::map<std::string, std::string> _arguments
+):
+	m_profiler(s_active)
+{
+	if (!m_profiler)
+		return;
+
+	m_event.name = std::string(_name);
+	m_event.category = std::string(_category);
+	m_event.arguments = std::move(_arguments);
+	m_peakMemoryAtStart = peakResidentSetSize();
+	m_startTime = std::chrono::steady_clock::now();
+}
+
+void Profiler::Scope::setArgument(std::string const& _name, std::string _value)
+{
+	if (m_profiler)
+		m_event.arguments[_name] = std::move(_value);
+}
+
+Profiler::Scope::~Scope()
+{
+	if (!m_profiler)
+		return;
+
+	auto endTime = std::chrono::steady_clock::now();
+	size_t peakMemoryAtEnd = peakResidentSetSize();
+
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+	m_event.start = duration_cast<microseconds>(m_startTime - m_profiler->m_creationTime).count();
+	m_event.duration = duration_cast<microseconds>(endTime - m_startTime).count();
+	m_event.peakMemoryIncrease = peakMemoryAtEnd > m_peakMemoryAtStart ? peakMemoryAtEnd - m_peakMemoryAtStart : 0;
+	m_profiler->record(std::move(m_event));
+}
+
+void Profiler::count(std::string_view _name, uint64_t _amount)
+{
+	Profiler* profiler = s_active;
+	if (!profiler)
+		return;
+
+	std::lock_guard lock(profiler->m_mutex);
+	auto it = profiler->m_counters.find(_name);
+	if (it == profiler->m_counters.end())
+		it = profiler->m_counters.emplace(std::string(_name), 0).first;
+	it->second += _amount;
+}
+
+std::vector<Profiler::Event> Profiler::events() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_events;
+}
+
+std::map<std::string, uint64_t> Profiler::counters() const
+{
+	std::lock_guard lock(m_mutex);
+	return {m_counters.begin(), m_counters.end()};
+}
+
+Json Profiler::chromeTrace() const
+{
+	Json traceEvents = Json::array();
+	for (Event const& event: events())
+	{
+		Json arguments = Json::object();
+		for (auto const& [key, value]: event.arguments)
+			arguments[key] = value;
+		arguments["peakMemoryIncrease"] = event.peakMemoryIncrease;
+
+		Json traceEvent;
+		traceEvent["name"] = event.name;
+		traceEvent["cat"] = event.category;
+		// Complete event, i.e. one with a start and a duration.
+		traceEvent["ph"] = "X";
+		traceEvent["ts"] = event.start;
+		traceEvent["dur"] = event.duration;
+		traceEvent["pid"] = 0;
+		traceEvent["tid"] = event.thread;
+		traceEvent["args"] = std::move(arguments);
+		traceEvents.emplace_back(std::move(traceEvent));
+	}
+
+	int64_t const now = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - m_creationTime
+	).count();
+	Json counterValues = Json::object();
+	for (auto const& [name, value]: counters())
+	{
+		Json traceEvent;
+		traceEvent["name"] = name;
+		traceEvent["cat"] = "counter";
+		// Counter event, its arguments are the values at the given time.
+		traceEvent["ph"] = "C";
+		traceEvent["ts"] = now;
+		traceEvent["pid"] = 0;
+		traceEvent["args"]["value"] = value;
+		traceEvents.emplace_back(std::move(traceEvent));
+		counterValues[name] = value;
+	}
+
+	Json trace;
+	trace["traceEvents"] = std::move(traceEvents);
+	trace["counters"] = std::move(counterValues);
+	trace["displayTimeUnit"] = "ms";
+	return trace;
+}
+
+size_t Profiler::peakResidentSetSize()
+{
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS...
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	// ...and in kilobytes everywhere else.
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+void Profiler::record(Event _event)
+{
+	std::lock_guard lock(m_mutex);
+	_event.thread = m_threadIndices.emplace(std::this_thread::get_id(), m_threadIndices.size()).first->second;
+	m_events.emplace_back(std::move(_event));
+}
@@ -0,0 +1,151 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of wall time and memory usage of the compiler phases and of event counters.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Records the duration of the scopes entered while it is active, on any thread it has been
+ * activated on.
+ *
+ * Instrumented code creates a @a Profiler::Scope. If no profiler is active on the current thread,
+ * creating a scope only costs a check of a thread-local pointer, so scopes can be placed on hot
+ * paths like the individual optimiser steps.
+ *
+ * Memory usage is measured as the growth of the peak resident set size of the whole process
+ * while the scope was entered. It is a lower bound of the memory allocated in the scope, which
+ * is only available on platforms supporting getrusage() and becomes imprecise when multiple
+ * threads are compiling at the same time.
+ *
+ * Instrumented code can also increment named counters via @a Profiler::count(), e.g. for the
+ * number of cache hits, at the same cost if no profiler is active.
+ */
+class Profiler
+{
+public:
+	struct Event
+	{
+		std::string name;
+		std::string category;
+		/// Additional information, e.g. the name of the contract being compiled.
+		std::map<std::string, std::string> arguments;
+		/// Index of the thread, in the order in which threads first recorded an event.
+		size_t thread = 0;
+		/// Start relative to the creation of the profiler, in microseconds.
+		int64_t start = 0;
+		/// In microseconds.
+		int64_t duration = 0;
+		/// In bytes.
+		size_t peakMemoryIncrease = 0;
+	};
+
+	/// Makes a profiler active on the current thread for the lifetime of the object.
+	/// Activations can be nested, the innermost one takes precedence.
+	class Activation
+	{
+	public:
+		explicit Activation(Profiler* _profiler): m_previous(s_active) { s_active = _profiler; }
+		~Activation() { s_active = m_previous; }
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		Profiler* m_previous;
+	};
+
+	/// Records an event spanning the lifetime of the object in the profiler active on construction.
+	class Scope
+	{
+	public:
+		Scope(
+			std::string_view _name,
+			std::string_view _category,
+			std::map<std::string, std::string> _arguments = {}
+		);
+		~Scope();
+
+		/// Adds an argument that is only known at the end of the scope, e.g. its result.
+		/// Does nothing if no profiler was active on construction.
+		void setArgument(std::string const& _name, std::string _value);
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		Profiler* m_profiler = nullptr;
+		Event m_event;
+		std::chrono::steady_clock::time_point m_startTime;
+		size_t m_peakMemoryAtStart = 0;
+	};
+
+	Profiler(): m_creationTime(std::chrono::steady_clock::now()) {}
+
+	/// @returns the profiler active on the current thread, if any.
+	static Profiler* active() { return s_active; }
+
+	/// Adds @a _amount to the counter @a _name of the profiler active on the current thread, if any.
+	/// Takes a lock if a profiler is active, so counts on hot paths should be accumulated locally
+	/// and added at once.
+	static void count(std::string_view _name, uint64_t _amount = 1);
+
+	/// @returns the recorded events, ordered by the time they were finished.
+	std::vector<Event> events() const;
+	/// @returns the values of all counters that were incremented at least once.
+	std::map<std::string, uint64_t> counters() const;
+
+	/// @returns the recorded events in the Chrome trace event format, which can be read
+	/// by chrome://tracing, Perfetto and most other trace viewers. The final values of the
+	/// counters are given as counter events and in the additional field "counters".
+	Json chromeTrace() const;
+
+	/// @returns the peak resident set size of the process so far, in bytes, or zero if
+	/// it cannot be determined on the current platform.
+	static size_t peakResidentSetSize();
+
+private:
+	void record(Event _event);
+
+	static thread_local Profiler* s_active;
+
+	std::chrono::steady_clock::time_point const m_creationTime;
+	mutable std::mutex m_mutex;
+	std::vector<Event> m_events;
+	std::map<std::string, uint64_t, std::less<>> m_counters;
+	std::map<std::thread::id, size_t> m_threadIndices;
+};
+
+}
@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Byte container with inline storage for short contents.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace solidity::util
+{
+
+/**
+ * Sequence of bytes that keeps up to @a N bytes inside the object and only allocates memory
+ * on the heap once it grows beyond that. Meant for short-lived values like the big endian
+ * encoding of a number, which almost always fit into a single word.
+ *
+ * Once the contents have moved to the heap, they stay there even if the container shrinks.
+ */
+template <size_t N>
+class SmallBytes
+{
+public:
+	using value_type = uint8_t;
+
+	SmallBytes() = default;
+	explicit SmallBytes(size_t _size, uint8_t _value = 0) { resize(_size, _value); }
+	explicit SmallBytes(bytesConstRef _data) { append(_data); }
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	/// @returns true if the contents do not fit into the inline storage.
+	bool onHeap() const { return m_onHeap; }
+
+	uint8_t* data() { return m_onHeap ? m_heap.data() : m_inline.data(); }
+	uint8_t const* data() const { return m_onHeap ? m_heap.data() : m_inline.data(); }
+	uint8_t* begin() { return data(); }
+	uint8_t* end() { return data() + m_size; }
+	uint8_t const* begin() const { return data(); }
+	uint8_t const* end() const { return data() + m_size; }
+	uint8_t& operator[](size_t _index) { return data()[_index]; }
+	uint8_t operator[](size_t _index) const { return data()[_index]; }
+
+	bytesConstRef ref() const { return bytesConstRef(data(), m_size); }
+	bytes toBytes() const { return bytes(begin(), end()); }
+
+	void resize(size_t _size, uint8_t _value = 0)
+	{
+		if (!m_onHeap && _size <= N)
+		{
+			if (_size > m_size)
+				std::fill(m_inline.begin() + m_size, m_inline.begin() + _size, _value);
+		}
+		else
+		{
+			if (!m_onHeap)
+			{
+				m_heap.assign(m_inline.begin(), m_inline.begin() + m_size);
+				m_onHeap = true;
+			}
+			m_heap.resize(_size, _value);
+		}
+		m_size = _size;
+	}
+	void push_back(uint8_t _value) { resize(m_size + 1, _value); }
+	/// Appends @a _data, which must not point into this container.
+	void append(bytesConstRef _data)
+	{
+		size_t oldSize = m_size;
+		resize(oldSize + _data.size());
+		if (!_data.empty())
+			std::memcpy(data() + oldSize, _data.data(), _data.size());
+	}
+	void clear() { resize(0); }
+
+	bool operator==(SmallBytes const& _other) const { return std::equal(begin(), end(), _other.begin(), _other.end()); }
+	bool operator!=(SmallBytes const& _other) const { return !(*this == _other); }
+
+private:
+	std::array<uint8_t, N> m_inline{};
+	bytes m_heap;
+	size_t m_size = 0;
+	bool m_onHeap = false;
+};
+
+}
@@ -43,11 +43,12 @@ bool solidity::util::stringWithinDistance(std::string const& _str1, std::string
 	if (_lenThreshold > 0 && n1 * n2 > _lenThreshold)
 		return false;
 
-	size_t distance = stringDistance(_str1, _str2);
-
 	// if distance is not greater than _maxDistance, and distance is strictly less than length of both names, they can be considered similar
 	// this is to avoid irrelevant suggestions
-	return distance <= _maxDistance && distance < n1 && distance < n2;
+	if (n1 == 0 || n2 == 0)
+		return false;
+	size_t bound = std::min({_maxDistance, n1 - 1, n2 - 1});
+	return boundedStringDistance(_str1, _str2, bound) <= bound;
 }
 
 size_t solidity::util::stringDistance(std::string const& _str1, std::string const& _str2)
@@ -90,6 +91,54 @@ size_t solidity::util::stringDistance(std::string const& _str1, std::string cons
 	return dp[(n1 % 3) + n2 * 3];
 }
 
+size_t solidity::util::boundedStringDistance(std::string const& _str1, std::string const& _str2, size_t _maxDistance)
+{
+	size_t n1 = _str1.size();
+	size_t n2 = _str2.size();
+	size_t const tooFar = _maxDistance + 1;
+	if (std::max(n1, n2) - std::min(n1, n2) > _maxDistance)
+		return tooFar;
+
+	// Same recurrence as in stringDistance, but only the cells with |i1 - i2| <= _maxDistance are computed.
+	// Every path through the matrix that leaves this band costs more than _maxDistance, so cells outside
+	// of it are treated as tooFar. Values are capped at tooFar, which is returned as soon as a whole row
+	// of the band exceeds the bound.
+	std::vector<size_t> dp(3 * (n2 + 1), tooFar);
+	auto cell = [&](size_t _i1, size_t _i2) -> size_t& { return dp[(_i1 % 3) * (n2 + 1) + _i2]; };
+	for (size_t i2 = 0; i2 <= std::min(n2, _maxDistance); ++i2)
+		cell(0, i2) = i2;
+
+	for (size_t i1 = 1; i1 <= n1; ++i1)
+	{
+		size_t first = i1 > _maxDistance ? i1 - _maxDistance : 0;
+		size_t last = std::min(n2, i1 + _maxDistance);
+		size_t rowMinimum = tooFar;
+		if (first == 0)
+		{
+			cell(i1, 0) = i1;
+			rowMinimum = i1;
+			first = 1;
+		}
+		else
+			// This row still holds values from three rows above, but only the cell left of the band is read.
+			cell(i1, first - 1) = tooFar;
+
+		for (size_t i2 = first; i2 <= last; ++i2)
+		{
+			size_t x = std::min(cell(i1 - 1, i2), cell(i1, i2 - 1)) + 1;
+			x = std::min(x, cell(i1 - 1, i2 - 1) + (_str1[i1 - 1] == _str2[i2 - 1] ? 0 : 1));
+			if (i1 > 1 && i2 > 1 && _str1[i1 - 1] == _str2[i2 - 2] && _str1[i1 - 2] == _str2[i2 - 1])
+				x = std::min(x, cell(i1 - 2, i2 - 2) + 1);
+			cell(i1, i2) = std::min(x, tooFar);
+			rowMinimum = std::min(rowMinimum, cell(i1, i2));
+		}
+		if (rowMinimum > _maxDistance)
+			return tooFar;
+	}
+
+	return cell(n1, n2);
+}
+
 std::string solidity::util::quotedAlternativesList(std::vector<std::string> const& suggestions)
 {
 	std::vector<std::string> quotedSuggestions;
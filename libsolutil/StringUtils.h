@@ -43,6 +43,9 @@ namespace solidity::util
 bool stringWithinDistance(std::string const& _str1, std::string const& _str2, size_t _maxDistance, size_t _lenThreshold = 0);
 // Calculates the Damerau–Levenshtein distance between _str1 and _str2
 size_t stringDistance(std::string const& _str1, std::string const& _str2);
+// Calculates the Damerau–Levenshtein distance between _str1 and _str2 if it is at most _maxDistance
+// and returns _maxDistance + 1 otherwise. Runs in O(min(n1, n2) * _maxDistance) time.
+size_t boundedStringDistance(std::string const& _str1, std::string const& _str2, size_t _maxDistance);
 // Return a string having elements of suggestions as quoted, alternative suggestions. e.g. "a", "b" or "c"
 std::string quotedAlternativesList(std::vector<std::string> const& suggestions);
 
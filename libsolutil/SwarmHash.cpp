@@ -21,6 +21,7 @@
 #include <libsolutil/SwarmHash.h>
 
 #include <libsolutil/Keccak256.h>
+#include <liblangutil/Exceptions.h>
 
 using namespace solidity;
 using namespace solidity::util;
@@ -62,42 +63,34 @@ h256 swarmHashIntermediate(std::string const& _input, size_t _offset, size_t _le
 	return swarmHashSimple(ref, _length);
 }
 
-h256 bmtHash(bytesConstRef _data)
-{
-	if (_data.size() <= 64)
-		return keccak256(_data);
-
-	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
-}
+size_t constexpr c_chunkSize = 0x1000;
+size_t constexpr c_segmentSize = 64;
 
-h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
+/// @returns the binary merkle tree hash of a chunk of exactly c_chunkSize bytes.
+/// All nodes of one level are hashed in a single batch.
+h256 bmtHash(bytes const& _chunk)
 {
-	bytes dataToHash;
-	if (_data.size() < 0x1000)
-		dataToHash = _data.toBytes();
-	else if (_data.size() == 0x1000 && !_forceHigherLevel)
-		dataToHash = _data.toBytes();
-	else
+	solAssert(_chunk.size() == c_chunkSize);
+	bytes level = _chunk;
+	// Leaves are 64 byte segments and every inner node hashes the 64 bytes of its two children.
+	while (level.size() > h256::size)
 	{
-		size_t maxRepresentedSize = 0x1000;
-		while (maxRepresentedSize * (0x1000 / 32) < _data.size())
-			maxRepresentedSize *= (0x1000 / 32);
-		// If remaining size is 0x1000, but maxRepresentedSize is not,
-		// we have to still do one level of the chunk hashes.
-		bool forceHigher = maxRepresentedSize > 0x1000;
-		for (size_t i = 0; i < _data.size(); i += maxRepresentedSize)
-		{
-			size_t size = std::min(maxRepresentedSize, _data.size() - i);
-			dataToHash += chunkHash(_data.cropped(i, size), forceHigher).asBytes();
-		}
+		std::vector<bytesConstRef> nodes;
+		for (size_t i = 0; i < level.size(); i += c_segmentSize)
+			nodes.emplace_back(level.data() + i, c_segmentSize);
+		bytes nextLevel;
+		nextLevel.reserve(nodes.size() * h256::size);
+		for (h256 const& hash: keccak256Batch(nodes))
+			nextLevel += hash.asBytes();
+		level = std::move(nextLevel);
 	}
+	return h256(level);
+}
 
-	dataToHash.resize(0x1000, 0);
-	return keccak256(toLittleEndian(_data.size()) + bmtHash(&dataToHash).asBytes());
+h256 nodeHash(bytes _data, size_t _size)
+{
+	_data.resize(c_chunkSize, 0);
+	return keccak256(toLittleEndian(_size) + bmtHash(_data).asBytes());
 }
 
 
@@ -109,9 +102,65 @@ h256 solidity::util::bzzr0Hash(std::string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input)
 {
-	if (_input.empty())
-		return h256{};
-	return chunkHash(&_input);
+	Bzzr1Hasher hasher;
+	hasher.append(_input);
+	return hasher.finish();
+}
+
+void Bzzr1Hasher::append(bytesConstRef _data)
+{
+	m_size += _data.size();
+	if (!m_buffer.empty())
+	{
+		size_t missing = std::min(c_chunkSize - m_buffer.size(), _data.size());
+		m_buffer += _data.cropped(0, missing).toBytes();
+		_data = _data.cropped(missing);
+		if (m_buffer.size() < c_chunkSize)
+			return;
+		addChunk(&m_buffer);
+		m_buffer.clear();
+	}
+	for (; _data.size() >= c_chunkSize; _data = _data.cropped(c_chunkSize))
+		addChunk(_data.cropped(0, c_chunkSize));
+	m_buffer = _data.toBytes();
+}
+
+h256 Bzzr1Hasher::finish()
+{
+	h256 hash;
+	if (m_size > 0)
+	{
+		if (!m_buffer.empty())
+			addChunk(&m_buffer);
+		hash = segmentHash(0, m_size, false);
+	}
+	*this = Bzzr1Hasher{};
+	return hash;
+}
+
+void Bzzr1Hasher::addChunk(bytesConstRef _chunk)
+{
+	m_chunkHashes.emplace_back(nodeHash(_chunk.toBytes(), _chunk.size()));
+}
+
+h256 Bzzr1Hasher::segmentHash(size_t _firstChunk, size_t _size, bool _forceHigherLevel) const
+{
+	if (_size < c_chunkSize || (_size == c_chunkSize && !_forceHigherLevel))
+		return m_chunkHashes.at(_firstChunk);
+
+	size_t maxRepresentedSize = c_chunkSize;
+	while (maxRepresentedSize * (c_chunkSize / 32) < _size)
+		maxRepresentedSize *= (c_chunkSize / 32);
+	// If remaining size is 0x1000, but maxRepresentedSize is not,
+	// we have to still do one level of the chunk hashes.
+	bool forceHigher = maxRepresentedSize > c_chunkSize;
+	bytes childHashes;
+	for (size_t i = 0; i < _size; i += maxRepresentedSize)
+	{
+		size_t size = std::min(maxRepresentedSize, _size - i);
+		childHashes += segmentHash(_firstChunk + i / c_chunkSize, size, forceHigher).asBytes();
+	}
+	return nodeHash(std::move(childHashes), _size);
 }
@@ -23,6 +23,7 @@
 #include <libsolutil/FixedHash.h>
 
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -31,11 +32,42 @@ namespace solidity::util
 h256 bzzr0Hash(std::string const& _input);
 
 /// Compute the "bzz hash" of @a _input (the NEW binary / BMT version)
-h256 bzzr1Hash(bytes const& _input);
+h256 bzzr1Hash(bytesConstRef _input);
+
+inline h256 bzzr1Hash(bytes const& _input)
+{
+	return bzzr1Hash(bytesConstRef(&_input));
+}
 
 inline h256 bzzr1Hash(std::string const& _input)
 {
-	return bzzr1Hash(asBytes(_input));
+	return bzzr1Hash(bytesConstRef(_input));
 }
 
+/**
+ * Computes the same hash as bzzr1Hash() for data that is passed in pieces.
+ *
+ * Every complete 0x1000 byte chunk is hashed as soon as it has been appended, so only the
+ * chunk hashes and the last partial chunk are kept in memory.
+ */
+class Bzzr1Hasher
+{
+public:
+	void append(bytesConstRef _data);
+	void append(std::string const& _data) { append(bytesConstRef(_data)); }
+	/// @returns the hash of all data appended so far. Resets the hasher.
+	h256 finish();
+
+private:
+	void addChunk(bytesConstRef _chunk);
+	h256 segmentHash(size_t _firstChunk, size_t _size, bool _forceHigherLevel) const;
+
+	/// Data of the chunk that is not complete yet.
+	bytes m_buffer;
+	/// Hashes of all chunks of the data in order.
+	std::vector<h256> m_chunkHashes;
+	/// Total number of bytes appended.
+	size_t m_size = 0;
+};
+
 }
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _numThreads)
+{
+	m_workers.reserve(_numThreads);
+	for (size_t i = 0; i < _numThreads; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (std::thread& worker: m_workers)
+		worker.join();
+}
+
+size_t ThreadPool::hardwareConcurrency()
+{
+	return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::enqueue(std::function<void()> _task)
+{
+	{
+		std::lock_guard lock(m_mutex);
+		solAssert(!m_stopping);
+		m_tasks.emplace_back(std::move(_task));
+	}
+	m_condition.notify_one();
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+			// Drain the queue before stopping so that no future is left without a result.
+			if (m_tasks.empty())
+				return;
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		// Exceptions are captured by the packaged task and rethrown from the future.
+		task();
+	}
+}
@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-size pool of worker threads.
+ */
+
+#pragma once
+
+#include <libsolutil/Cancellation.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Executes submitted tasks on a fixed number of worker threads, in submission order.
+ *
+ * Results and exceptions of the tasks are delivered through the futures returned by @a submit().
+ * The destructor waits for all pending tasks to finish before joining the workers.
+ *
+ * A pool created with zero threads is valid and executes every task synchronously inside
+ * @a submit(), which makes it possible to use the same code path for sequential execution.
+ *
+ * Tasks run with the @a CancellationToken that was active on the submitting thread.
+ */
+class ThreadPool
+{
+public:
+	explicit ThreadPool(size_t _numThreads);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	template<typename Callable>
+	std::future<std::invoke_result_t<Callable>> submit(Callable&& _task)
+	{
+		using Result = std::invoke_result_t<Callable>;
+		auto packagedTask = std::make_shared<std::packaged_task<Result()>>(
+			[task = std::forward<Callable>(_task), token = CancellationToken::active()]() mutable {
+				CancellationToken::Activation activation(token);
+				return task();
+			}
+		);
+		std::future<Result> result = packagedTask->get_future();
+		if (m_workers.empty())
+			(*packagedTask)();
+		else
+			enqueue([packagedTask]() { (*packagedTask)(); });
+		return result;
+	}
+
+	size_t numThreads() const { return m_workers.size(); }
+
+	/// @returns the number of threads that can run concurrently on this machine, at least 1.
+	static size_t hardwareConcurrency();
+
+private:
+	void enqueue(std::function<void()> _task);
+	void work();
+
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping = false;
+};
+
+}
@@ -26,14 +26,60 @@
 
 #include <libsolutil/Assertions.h>
 
+#include <algorithm>
+#include <mutex>
 #include <regex>
+#include <unordered_map>
 
 using namespace solidity::util;
 
+struct Whiskers::ParsedTemplate
+{
+	enum class Kind { Text, Value, List, Condition, ValueCondition };
+	struct Node
+	{
+		Kind kind = Kind::Text;
+		/// The literal text for Kind::Text, the parameter name otherwise.
+		std::string text;
+		std::unique_ptr<ParsedTemplate const> body;
+		std::unique_ptr<ParsedTemplate const> elseBody;
+	};
+
+	/// The template text, used in error messages.
+	std::string source;
+	std::vector<Node> nodes;
+};
+
+namespace
+{
+
+bool isParameterChar(char _c)
+{
+	return
+		(_c >= 'a' && _c <= 'z') ||
+		(_c >= 'A' && _c <= 'Z') ||
+		(_c >= '0' && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos followed by '>'
+/// or std::string_view::npos if there is no such name.
+size_t parameterEnd(std::string_view _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && isParameterChar(_text[end]))
+		++end;
+	if (end == _pos || end == _text.size() || _text[end] != '>')
+		return std::string_view::npos;
+	return end;
+}
+
+}
+
 Whiskers::Whiskers(std::string _template):
-	m_template(std::move(_template))
+	m_template(std::move(_template)),
+	m_parsedTemplate(parse(m_template))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(std::string _parameter, std::string _value)
@@ -71,25 +117,27 @@ Whiskers& Whiskers::operator()(
 
 std::string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	std::string result;
+	result.reserve(m_template.size());
+	render(*m_parsedTemplate, nullptr, m_parameters, m_conditions, m_listParameters, result);
+	return result;
 }
 
-void Whiskers::checkTemplateValid() const
+void Whiskers::checkTemplateValid(std::string const& _template)
 {
 	std::regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
 	std::smatch match;
 	assertThrow(
-		!regex_search(m_template, match, validTemplate),
+		!regex_search(_template, match, validTemplate),
 		WhiskersError,
 		"Template contains an invalid/unclosed tag " + match.str()
 	);
 }
 
-void Whiskers::checkParameterValid(std::string const& _parameter) const
+void Whiskers::checkParameterValid(std::string const& _parameter)
 {
-	static std::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && std::all_of(_parameter.begin(), _parameter.end(), isParameterChar),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -127,117 +175,212 @@ void Whiskers::checkTemplateContainsTags(std::string const& _parameter, std::vec
 	}
 }
 
-namespace
+std::shared_ptr<Whiskers::ParsedTemplate const> Whiskers::parse(std::string const& _template)
 {
-template<class ReplaceCallback>
-std::string regex_replace(
-	std::string const& _source,
-	std::regex const& _pattern,
-	ReplaceCallback _replace,
-	std::regex_constants::match_flag_type _flags = std::regex_constants::match_default
-)
+	// Most templates are string literals in the code generator, so the number of distinct
+	// templates is small. The limit only guards against templates built at runtime.
+	static size_t constexpr maxCacheSize = 4096;
+	static std::mutex mutex;
+	static std::unordered_map<std::string, std::shared_ptr<ParsedTemplate const>> cache;
+
+	{
+		std::lock_guard lock(mutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
+	}
+
+	checkTemplateValid(_template);
+	std::shared_ptr<ParsedTemplate const> parsed = parseTemplate(_template);
+
+	std::lock_guard lock(mutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	cache.emplace(_template, parsed);
+	return parsed;
+}
+
+std::unique_ptr<Whiskers::ParsedTemplate const> Whiskers::parseTemplate(std::string_view _text)
 {
-	std::sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	std::sregex_iterator matchEnd;
-	std::string::const_iterator lastMatchedPos(_source.cbegin());
-	std::string result;
-	while (curMatch != matchEnd)
+	using Kind = ParsedTemplate::Kind;
+	using Node = ParsedTemplate::Node;
+
+	auto result = std::make_unique<ParsedTemplate>();
+	result->source = std::string(_text);
+
+	std::string text;
+	auto addNode = [&](Kind _kind, std::string_view _name) -> Node& {
+		if (!text.empty())
+			result->nodes.push_back(Node{Kind::Text, std::move(text), nullptr, nullptr});
+		text.clear();
+		return result->nodes.emplace_back(Node{_kind, std::string(_name), nullptr, nullptr});
+	};
+
+	size_t pos = 0;
+	while (pos < _text.size())
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		size_t tagStart = _text.find('<', pos);
+		if (tagStart == std::string_view::npos)
+		{
+			text += _text.substr(pos);
+			break;
+		}
+		text += _text.substr(pos, tagStart - pos);
+		pos = tagStart + 1;
+
+		char const marker = pos < _text.size() ? _text[pos] : '\0';
+		if (size_t nameEnd = parameterEnd(_text, pos); nameEnd != std::string_view::npos)
+		{
+			// <name>
+			addNode(Kind::Value, _text.substr(pos, nameEnd - pos));
+			pos = nameEnd + 1;
+		}
+		else if (marker == '#' || marker == '?')
+		{
+			size_t nameStart = pos + 1;
+			bool valueCondition = marker == '?' && nameStart < _text.size() && _text[nameStart] == '+';
+			size_t nameEnd = parameterEnd(_text, valueCondition ? nameStart + 1 : nameStart);
+			if (nameEnd == std::string_view::npos)
+			{
+				text += '<';
+				continue;
+			}
+			std::string_view name = _text.substr(nameStart, nameEnd - nameStart);
+			size_t bodyStart = nameEnd + 1;
+			std::string closingTag = "</" + std::string(name) + ">";
+			size_t bodyEnd = _text.find(closingTag, bodyStart);
+			if (bodyEnd == std::string_view::npos)
+			{
+				text += '<';
+				continue;
+			}
+
+			if (marker == '#')
+			{
+				// <#name>...</name>
+				addNode(Kind::List, name).body = parseTemplate(_text.substr(bodyStart, bodyEnd - bodyStart));
+			}
+			else
+			{
+				// <?name>...<!name>...</name> or <?+name>...<!+name>...</+name>
+				Node& node = addNode(valueCondition ? Kind::ValueCondition : Kind::Condition, name);
+				std::string elseTag = "<!" + std::string(name) + ">";
+				size_t elseStart = _text.find(elseTag, bodyStart);
+				if (elseStart != std::string_view::npos && elseStart < bodyEnd)
+				{
+					node.body = parseTemplate(_text.substr(bodyStart, elseStart - bodyStart));
+					elseStart += elseTag.size();
+					node.elseBody = parseTemplate(_text.substr(elseStart, bodyEnd - elseStart));
+				}
+				else
+				{
+					node.body = parseTemplate(_text.substr(bodyStart, bodyEnd - bodyStart));
+					node.elseBody = parseTemplate({});
+				}
+			}
+			pos = bodyEnd + closingTag.size();
+		}
+		else
+			text += '<';
 	}
-	result.append(lastMatchedPos, _source.cend());
+	if (!text.empty())
+		result->nodes.push_back(Node{Kind::Text, std::move(text), nullptr, nullptr});
 	return result;
 }
-}
 
-std::string Whiskers::replace(
-	std::string const& _template,
+void Whiskers::render(
+	ParsedTemplate const& _template,
+	StringMap const* _listElement,
 	StringMap const& _parameters,
 	std::map<std::string, bool> const& _conditions,
-	std::map<std::string, std::vector<StringMap>> const& _listParameters
+	StringListMap const& _listParameters,
+	std::string& _output
 )
 {
-	static std::regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](std::match_results<std::string::const_iterator> _match) -> std::string
-	{
-		std::string tagName(_match[1]);
-		std::string listName(_match[2]);
-		std::string conditionName(_match[4]);
-		if (!tagName.empty())
+	auto findValue = [&](std::string const& _name) -> std::string const* {
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = _parameters.find(_name); it != _parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (ParsedTemplate::Node const& node: _template.nodes)
+		switch (node.kind)
 		{
+		case ParsedTemplate::Kind::Text:
+			_output += node.text;
+			break;
+		case ParsedTemplate::Kind::Value:
+		{
+			std::string const* value = findValue(node.text);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + node.text + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.source
 			);
-			return _parameters.at(tagName);
+			_output += *value;
+			break;
 		}
-		else if (!listName.empty())
+		case ParsedTemplate::Kind::List:
 		{
-			std::string templ(_match[3]);
+			auto list = _listParameters.find(node.text);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				list != _listParameters.end(),
+				WhiskersError, "List parameter " + node.text + " not set."
 			);
-			std::string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			// Lists cannot be nested, so list elements are only ever added to the top-level parameters.
+			assertThrow(!_listElement, WhiskersError, "Nested list parameter " + node.text + ".");
+			for (StringMap const& element: list->second)
+			{
+				for (auto const& value: element)
+					assertThrow(
+						!_parameters.count(value.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(*node.body, &element, _parameters, _conditions, {}, _output);
+			}
+			break;
 		}
-		else
+		case ParsedTemplate::Kind::Condition:
+		{
+			auto condition = _conditions.find(node.text);
+			assertThrow(
+				condition != _conditions.end(),
+				WhiskersError, "Condition parameter " + node.text + " not set."
+			);
+			render(
+				condition->second ? *node.body : *node.elseBody,
+				_listElement,
+				_parameters,
+				_conditions,
+				_listParameters,
+				_output
+			);
+			break;
+		}
+		case ParsedTemplate::Kind::ValueCondition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				std::string tag = conditionName.substr(1);
-
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
-				else
-					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
-			}
+			std::string tag = node.text.substr(1);
+			if (std::string const* value = findValue(tag))
+				conditionValue = !value->empty();
+			else if (auto list = _listParameters.find(tag); list != _listParameters.end())
+				conditionValue = !list->second.empty();
 			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
+				assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
+			render(
+				conditionValue ? *node.body : *node.elseBody,
+				_listElement,
 				_parameters,
 				_conditions,
-				_listParameters
+				_listParameters,
+				_output
 			);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
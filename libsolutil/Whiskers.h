@@ -27,7 +27,9 @@
 #include <libsolutil/Exceptions.h>
 
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::util
@@ -67,6 +69,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *    Works similar to a conditional parameter where the checked condition is
  *    that the string or list parameter called "name" is non-empty or contains
  *    no elements respectively.
+ *
+ * Templates are parsed once per distinct template string and the parsed form is shared
+ * between all instances, so rendering only fills in the values.
  */
 class Whiskers
 {
@@ -90,10 +95,12 @@ public:
 	std::string render() const;
 
 private:
+	struct ParsedTemplate;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
-	void checkTemplateValid() const;
-	void checkParameterValid(std::string const& _parameter) const;
+	static void checkTemplateValid(std::string const& _template);
+	static void checkParameterValid(std::string const& _parameter);
 	void checkParameterUnknown(std::string const& _parameter) const;
 
 	/// Checks whether the string stored in `m_template` contains all the tags specified.
@@ -102,19 +109,25 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// @returns the parsed form of @a _template, from the cache if it was parsed before.
+	static std::shared_ptr<ParsedTemplate const> parse(std::string const& _template);
+	/// Parses @a _text without consulting the cache. Tags which are not properly closed
+	/// are kept as literal text.
+	static std::unique_ptr<ParsedTemplate const> parseTemplate(std::string_view _text);
+
+	/// Appends the rendered @a _template to @a _output. Values are looked up in
+	/// @a _listElement first (if given) and then in @a _parameters.
+	static void render(
+		ParsedTemplate const& _template,
+		StringMap const* _listElement,
 		StringMap const& _parameters,
 		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
+		StringListMap const& _listParameters,
+		std::string& _output
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
+	std::shared_ptr<ParsedTemplate const> m_parsedTemplate;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
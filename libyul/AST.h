@@ -111,40 +111,52 @@ private:
 };
 
 
+namespace detail
+{
+inline langutil::SourceLocation const& emptySourceLocation()
+{
+	static langutil::SourceLocation const emptyLocation;
+	return emptyLocation;
+}
+}
+
 /// Extracts the IR source location from a Yul node.
-template <class T> inline langutil::SourceLocation nativeLocationOf(T const& _node)
+/// The returned reference is valid as long as the node keeps its debug data.
+template <class T> inline langutil::SourceLocation const& nativeLocationOf(T const& _node)
 {
-	return _node.debugData ? _node.debugData->nativeLocation : langutil::SourceLocation{};
+	return _node.debugData ? _node.debugData->nativeLocation : detail::emptySourceLocation();
 }
 
 /// Extracts the IR source location from a Yul node.
-template <class... Args> inline langutil::SourceLocation nativeLocationOf(std::variant<Args...> const& _node)
+template <class... Args> inline langutil::SourceLocation const& nativeLocationOf(std::variant<Args...> const& _node)
 {
-	return std::visit([](auto const& _arg) { return nativeLocationOf(_arg); }, _node);
+	return std::visit([](auto const& _arg) -> langutil::SourceLocation const& { return nativeLocationOf(_arg); }, _node);
 }
 
 /// Extracts the original source location from a Yul node.
-template <class T> inline langutil::SourceLocation originLocationOf(T const& _node)
+/// The returned reference is valid as long as the node keeps its debug data.
+template <class T> inline langutil::SourceLocation const& originLocationOf(T const& _node)
 {
-	return _node.debugData ? _node.debugData->originLocation : langutil::SourceLocation{};
+	return _node.debugData ? _node.debugData->originLocation : detail::emptySourceLocation();
 }
 
 /// Extracts the original source location from a Yul node.
-template <class... Args> inline langutil::SourceLocation originLocationOf(std::variant<Args...> const& _node)
+template <class... Args> inline langutil::SourceLocation const& originLocationOf(std::variant<Args...> const& _node)
 {
-	return std::visit([](auto const& _arg) { return originLocationOf(_arg); }, _node);
+	return std::visit([](auto const& _arg) -> langutil::SourceLocation const& { return originLocationOf(_arg); }, _node);
 }
 
 /// Extracts the debug data from a Yul node.
-template <class T> inline langutil::DebugData::ConstPtr debugDataOf(T const& _node)
+/// Returns a reference to avoid updating the reference count, copy it to keep the data.
+template <class T> inline langutil::DebugData::ConstPtr const& debugDataOf(T const& _node)
 {
 	return _node.debugData;
 }
 
 /// Extracts the debug data from a Yul node.
-template <class... Args> inline langutil::DebugData::ConstPtr debugDataOf(std::variant<Args...> const& _node)
+template <class... Args> inline langutil::DebugData::ConstPtr const& debugDataOf(std::variant<Args...> const& _node)
 {
-	return std::visit([](auto const& _arg) { return debugDataOf(_arg); }, _node);
+	return std::visit([](auto const& _arg) -> langutil::DebugData::ConstPtr const& { return debugDataOf(_arg); }, _node);
 }
 
 inline bool hasDefaultCase(Switch const& _switch)
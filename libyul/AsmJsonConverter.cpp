@@ -53,6 +53,7 @@ Json AsmJsonConverter::operator()(Literal const& _node) const
 {
 	yulAssert(validLiteral(_node));
 	Json ret = createAstNode(originLocationOf(_node), nativeLocationOf(_node), "YulLiteral");
+	std::string const formattedLiteral = formatLiteral(_node);
 	switch (_node.kind)
 	{
 	case LiteralKind::Number:
@@ -63,15 +64,12 @@ Json AsmJsonConverter::operator()(Literal const& _node) const
 		break;
 	case LiteralKind::String:
 		ret["kind"] = "string";
-		ret["hexValue"] = util::toHex(util::asBytes(formatLiteral(_node)));
+		ret["hexValue"] = util::toHex(util::asBytes(formattedLiteral));
 		break;
 	}
 	ret["type"] = "";
-	{
-		auto const formattedLiteral = formatLiteral(_node);
-		if (util::validateUTF8(formattedLiteral))
-			ret["value"] = formattedLiteral;
-	}
+	if (util::validateUTF8(formattedLiteral))
+		ret["value"] = formattedLiteral;
 	return ret;
 }
 
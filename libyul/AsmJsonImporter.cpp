@@ -67,11 +67,14 @@ T AsmJsonImporter::createAsmNode(Json const& _node)
 	return r;
 }
 
-Json AsmJsonImporter::member(Json const& _node, std::string const& _name)
+Json const& AsmJsonImporter::member(Json const& _node, std::string const& _name)
 {
-	if (!_node.contains(_name))
-		return Json();
-	return _node[_name];
+	// Returning a reference avoids copying the whole subtree of every member on each level.
+	static Json const null;
+	auto it = _node.find(_name);
+	if (it == _node.end())
+		return null;
+	return *it;
 }
 
 NameWithDebugData AsmJsonImporter::createNameWithDebugData(Json const& _node)
@@ -83,7 +86,7 @@ NameWithDebugData AsmJsonImporter::createNameWithDebugData(Json const& _node)
 
 Statement AsmJsonImporter::createStatement(Json const& _node)
 {
-	Json jsonNodeType = member(_node, "nodeType");
+	Json const& jsonNodeType = member(_node, "nodeType");
 	yulAssert(jsonNodeType.is_string(), "Expected \"nodeType\" to be of type string!");
 	std::string nodeType = jsonNodeType.get<std::string>();
 
@@ -121,7 +124,7 @@ Statement AsmJsonImporter::createStatement(Json const& _node)
 
 Expression AsmJsonImporter::createExpression(Json const& _node)
 {
-	Json jsonNodeType = member(_node, "nodeType");
+	Json const& jsonNodeType = member(_node, "nodeType");
 	yulAssert(jsonNodeType.is_string(), "Expected \"nodeType\" to be of type string!");
 	std::string nodeType = jsonNodeType.get<std::string>();
 
@@ -176,7 +179,7 @@ Literal AsmJsonImporter::createLiteral(Json const& _node)
 	else
 		value = member(_node, "value").get<std::string>();
 	{
-		auto const typeNode = member(_node, "type");
+		auto const& typeNode = member(_node, "type");
 		yulAssert(
 			typeNode.empty() || typeNode.get<std::string>().empty(),
 			fmt::format(
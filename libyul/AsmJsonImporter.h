@@ -48,8 +48,8 @@ private:
 	template <class T>
 	T createAsmNode(Json const& _node);
 	/// helper function to access member functions of the JSON
-	/// and throw an error if it does not exist
-	Json member(Json const& _node, std::string const& _name);
+	/// @returns a reference to the member or to a null value if it does not exist
+	static Json const& member(Json const& _node, std::string const& _name);
 
 	yul::Block createBlock(Json const& _node);
 	yul::Statement createStatement(Json const& _node);
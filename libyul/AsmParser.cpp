@@ -67,7 +67,9 @@ langutil::DebugData::ConstPtr Parser::createDebugData() const
 		case UseSourceLocationFrom::Scanner:
 			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			// All nodes get the same, immutable debug data. No need for separate copies.
+			yulAssert(m_locationOverrideDebugData);
+			return m_locationOverrideDebugData;
 		case UseSourceLocationFrom::Comments:
 			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
 	}
@@ -81,27 +83,29 @@ void Parser::updateLocationEndFrom(
 {
 	solAssert(_debugData, "");
 
-	switch (m_useSourceLocationFrom)
+	if (m_useSourceLocationFrom == UseSourceLocationFrom::LocationOverride)
+		// Ignore the update. The location we're overriding with is not supposed to change
+		return;
+
+	// Debug data created by createDebugData() is not shared with any other node until the node is
+	// complete, so in the common case it can be updated in place instead of being copied.
+	// It is never allocated as const, which makes modifying it through const_cast well-defined.
+	DebugData* updatedDebugData = nullptr;
+	std::shared_ptr<DebugData> copy;
+	if (_debugData.use_count() == 1)
+		updatedDebugData = const_cast<DebugData*>(_debugData.get());
+	else
 	{
-		case UseSourceLocationFrom::Scanner:
-		{
-			DebugData updatedDebugData = *_debugData;
-			updatedDebugData.nativeLocation.end = _location.end;
-			updatedDebugData.originLocation.end = _location.end;
-			_debugData = std::make_shared<DebugData const>(std::move(updatedDebugData));
-			break;
-		}
-		case UseSourceLocationFrom::LocationOverride:
-			// Ignore the update. The location we're overriding with is not supposed to change
-			break;
-		case UseSourceLocationFrom::Comments:
-		{
-			DebugData updatedDebugData = *_debugData;
-			updatedDebugData.nativeLocation.end = _location.end;
-			_debugData = std::make_shared<DebugData const>(std::move(updatedDebugData));
-			break;
-		}
+		copy = std::make_shared<DebugData>(*_debugData);
+		updatedDebugData = copy.get();
 	}
+
+	updatedDebugData->nativeLocation.end = _location.end;
+	if (m_useSourceLocationFrom == UseSourceLocationFrom::Scanner)
+		updatedDebugData->originLocation.end = _location.end;
+
+	if (copy)
+		_debugData = std::move(copy);
 }
 
 std::unique_ptr<AST> Parser::parse(CharStream& _charStream)
@@ -123,6 +127,8 @@ std::unique_ptr<AST> Parser::parseInline(std::shared_ptr<Scanner> const& _scanne
 	try
 	{
 		m_scanner = _scanner;
+		if (m_useSourceLocationFrom == UseSourceLocationFrom::LocationOverride && !m_locationOverrideDebugData)
+			m_locationOverrideDebugData = DebugData::create(m_locationOverride, m_locationOverride);
 		if (m_useSourceLocationFrom == UseSourceLocationFrom::Comments)
 			fetchDebugDataFromComment();
 		return std::make_unique<AST>(parseBlock());
@@ -32,7 +32,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
-#include <range/v3/view/transform.hpp>
+#include <range/v3/view/enumerate.hpp>
 
 #include <functional>
 #include <memory>
@@ -42,203 +42,267 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
 
-std::string AsmPrinter::operator()(Literal const& _literal)
+void AsmPrinter::print(std::string& _output, Block const& _block, size_t _indentation)
+{
+	m_output = &_output;
+	m_indentation = _indentation;
+	write(_block);
+	m_output = nullptr;
+}
+
+void AsmPrinter::write(Literal const& _literal)
 {
 	yulAssert(validLiteral(_literal));
 
-	std::string const locationComment = formatDebugData(_literal);
+	writeDebugData(_literal);
 	std::string const formattedValue = formatLiteral(_literal);
 
 	switch (_literal.kind)
 	{
 	case LiteralKind::Number:
 	case LiteralKind::Boolean:
-		return locationComment + formattedValue;
+		*m_output += formattedValue;
+		return;
 	case LiteralKind::String:
 		break;
 	}
 
-	return locationComment + escapeAndQuoteString(formattedValue);
+	*m_output += escapeAndQuoteString(formattedValue);
 }
 
-std::string AsmPrinter::operator()(Identifier const& _identifier)
+void AsmPrinter::write(Identifier const& _identifier)
 {
 	yulAssert(!_identifier.name.empty(), "Invalid identifier.");
-	return formatDebugData(_identifier) + _identifier.name.str();
+	writeDebugData(_identifier);
+	*m_output += _identifier.name.str();
 }
 
-std::string AsmPrinter::operator()(ExpressionStatement const& _statement)
+void AsmPrinter::write(ExpressionStatement const& _statement)
 {
-	std::string const locationComment = formatDebugData(_statement);
-
-	return locationComment + std::visit(*this, _statement.expression);
+	writeDebugData(_statement);
+	write(_statement.expression);
 }
 
-std::string AsmPrinter::operator()(Assignment const& _assignment)
+void AsmPrinter::write(Assignment const& _assignment)
 {
-	std::string const locationComment = formatDebugData(_assignment);
+	writeDebugData(_assignment);
 
 	yulAssert(_assignment.variableNames.size() >= 1, "");
-	std::string variables = (*this)(_assignment.variableNames.front());
+	write(_assignment.variableNames.front());
 	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
-		variables += ", " + (*this)(_assignment.variableNames[i]);
+	{
+		*m_output += ", ";
+		write(_assignment.variableNames[i]);
+	}
 
-	return locationComment + variables + " := " + std::visit(*this, *_assignment.value);
+	*m_output += " := ";
+	write(*_assignment.value);
 }
 
-std::string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration)
+void AsmPrinter::write(VariableDeclaration const& _variableDeclaration)
 {
-	std::string out = formatDebugData(_variableDeclaration);
-
-	out += "let ";
-	out += boost::algorithm::join(
-		_variableDeclaration.variables | ranges::views::transform(
-			[this](NameWithDebugData argument) { return formatNameWithDebugData(argument); }
-		),
-		", "
-	);
+	writeDebugData(_variableDeclaration);
+
+	*m_output += "let ";
+	for (auto&& [i, variable]: _variableDeclaration.variables | ranges::views::enumerate)
+	{
+		if (i > 0)
+			*m_output += ", ";
+		writeNameWithDebugData(variable);
+	}
 	if (_variableDeclaration.value)
 	{
-		out += " := ";
-		out += std::visit(*this, *_variableDeclaration.value);
+		*m_output += " := ";
+		write(*_variableDeclaration.value);
 	}
-	return out;
 }
 
-std::string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition)
+void AsmPrinter::write(FunctionDefinition const& _functionDefinition)
 {
 	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
 
-	std::string out = formatDebugData(_functionDefinition);
-	out += "function " + _functionDefinition.name.str() + "(";
-	out += boost::algorithm::join(
-		_functionDefinition.parameters | ranges::views::transform(
-			[this](NameWithDebugData argument) { return formatNameWithDebugData(argument); }
-		),
-		", "
-	);
-	out += ")";
+	writeDebugData(_functionDefinition);
+	*m_output += "function ";
+	*m_output += _functionDefinition.name.str();
+	*m_output += "(";
+	for (auto&& [i, parameter]: _functionDefinition.parameters | ranges::views::enumerate)
+	{
+		if (i > 0)
+			*m_output += ", ";
+		writeNameWithDebugData(parameter);
+	}
+	*m_output += ")";
 	if (!_functionDefinition.returnVariables.empty())
 	{
-		out += " -> ";
-		out += boost::algorithm::join(
-			_functionDefinition.returnVariables | ranges::views::transform(
-				[this](NameWithDebugData argument) { return formatNameWithDebugData(argument); }
-			),
-			", "
-		);
+		*m_output += " -> ";
+		for (auto&& [i, returnVariable]: _functionDefinition.returnVariables | ranges::views::enumerate)
+		{
+			if (i > 0)
+				*m_output += ", ";
+			writeNameWithDebugData(returnVariable);
+		}
 	}
 
-	return out + "\n" + (*this)(_functionDefinition.body);
+	newLine();
+	write(_functionDefinition.body);
 }
 
-std::string AsmPrinter::operator()(FunctionCall const& _functionCall)
+void AsmPrinter::write(FunctionCall const& _functionCall)
 {
-	std::string const locationComment = formatDebugData(_functionCall);
-	std::string const functionName = (*this)(_functionCall.functionName);
-	return
-		locationComment +
-		functionName + "(" +
-		boost::algorithm::join(
-			_functionCall.arguments | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-			", " ) +
-		")";
+	writeDebugData(_functionCall);
+	write(_functionCall.functionName);
+	*m_output += "(";
+	for (auto&& [i, argument]: _functionCall.arguments | ranges::views::enumerate)
+	{
+		if (i > 0)
+			*m_output += ", ";
+		write(argument);
+	}
+	*m_output += ")";
 }
 
-std::string AsmPrinter::operator()(If const& _if)
+void AsmPrinter::write(If const& _if)
 {
 	yulAssert(_if.condition, "Invalid if condition.");
 
-	std::string out = formatDebugData(_if);
-	out += "if " + std::visit(*this, *_if.condition);
+	writeDebugData(_if);
+	*m_output += "if ";
+	write(*_if.condition);
 
-	std::string body = (*this)(_if.body);
-	char delim = '\n';
-	if (body.find('\n') == std::string::npos)
-		delim = ' ';
-
-	return out + delim + body;
+	size_t const delimiter = m_output->size();
+	*m_output += ' ';
+	size_t const lineBreaksBeforeBody = m_lineBreaks;
+	write(_if.body);
+	if (m_lineBreaks != lineBreaksBeforeBody)
+		breakLineAt(delimiter);
 }
 
-std::string AsmPrinter::operator()(Switch const& _switch)
+void AsmPrinter::write(Switch const& _switch)
 {
 	yulAssert(_switch.expression, "Invalid expression pointer.");
 
-	std::string out = formatDebugData(_switch);
-	out += "switch " + std::visit(*this, *_switch.expression);
+	writeDebugData(_switch);
+	*m_output += "switch ";
+	write(*_switch.expression);
 
 	for (auto const& _case: _switch.cases)
 	{
+		newLine();
 		if (!_case.value)
-			out += "\ndefault ";
+			*m_output += "default ";
 		else
-			out += "\ncase " + (*this)(*_case.value) + " ";
-		out += (*this)(_case.body);
+		{
+			*m_output += "case ";
+			write(*_case.value);
+			*m_output += " ";
+		}
+		write(_case.body);
 	}
-	return out;
 }
 
-std::string AsmPrinter::operator()(ForLoop const& _forLoop)
+void AsmPrinter::write(ForLoop const& _forLoop)
 {
 	yulAssert(_forLoop.condition, "Invalid for loop condition.");
-	std::string const locationComment = formatDebugData(_forLoop);
-
-	std::string pre = (*this)(_forLoop.pre);
-	std::string condition = std::visit(*this, *_forLoop.condition);
-	std::string post = (*this)(_forLoop.post);
-
-	char delim = '\n';
-	if (
-		pre.size() + condition.size() + post.size() < 60 &&
-		pre.find('\n') == std::string::npos &&
-		post.find('\n') == std::string::npos
-	)
-		delim = ' ';
-	return
-		locationComment +
-		("for " + std::move(pre) + delim + std::move(condition) + delim + std::move(post) + "\n") +
-		(*this)(_forLoop.body);
+	writeDebugData(_forLoop);
+
+	*m_output += "for ";
+	size_t const preStart = m_output->size();
+	size_t const lineBreaksBeforePre = m_lineBreaks;
+	write(_forLoop.pre);
+	bool const multiLinePre = m_lineBreaks != lineBreaksBeforePre;
+	size_t const firstDelimiter = m_output->size();
+	*m_output += ' ';
+	write(*_forLoop.condition);
+	size_t const secondDelimiter = m_output->size();
+	*m_output += ' ';
+	size_t const lineBreaksBeforePost = m_lineBreaks;
+	write(_forLoop.post);
+	bool const multiLinePost = m_lineBreaks != lineBreaksBeforePost;
+
+	// Excludes the two delimiters.
+	size_t const headerSize = m_output->size() - preStart - 2;
+	if (headerSize >= 60 || multiLinePre || multiLinePost)
+	{
+		breakLineAt(secondDelimiter);
+		breakLineAt(firstDelimiter);
+	}
+	newLine();
+	write(_forLoop.body);
 }
 
-std::string AsmPrinter::operator()(Break const& _break)
+void AsmPrinter::write(Break const& _break)
 {
-	return formatDebugData(_break) + "break";
+	writeDebugData(_break);
+	*m_output += "break";
 }
 
-std::string AsmPrinter::operator()(Continue const& _continue)
+void AsmPrinter::write(Continue const& _continue)
 {
-	return formatDebugData(_continue) + "continue";
+	writeDebugData(_continue);
+	*m_output += "continue";
 }
 
 // '_leave' and '__leave' is reserved in VisualStudio
-std::string AsmPrinter::operator()(Leave const& leave_)
+void AsmPrinter::write(Leave const& leave_)
 {
-	return formatDebugData(leave_) + "leave";
+	writeDebugData(leave_);
+	*m_output += "leave";
 }
 
-std::string AsmPrinter::operator()(Block const& _block)
+void AsmPrinter::write(Block const& _block)
 {
-	std::string const locationComment = formatDebugData(_block);
+	writeDebugData(_block);
 
 	if (_block.statements.empty())
-		return locationComment + "{ }";
-	std::string body = boost::algorithm::join(
-		_block.statements | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-		"\n"
-	);
-	if (body.size() < 30 && body.find('\n') == std::string::npos)
-		return locationComment + "{ " + body + " }";
+	{
+		*m_output += "{ }";
+		return;
+	}
+
+	// The block is written on multiple lines first and joined into a single line
+	// afterwards if it turns out to be short enough.
+	*m_output += "{";
+	size_t const openingEnd = m_output->size();
+	++m_indentation;
+	newLine();
+	size_t const bodyStart = m_output->size();
+	size_t const lineBreaksBeforeBody = m_lineBreaks;
+	for (auto&& [i, statement]: _block.statements | ranges::views::enumerate)
+	{
+		if (i > 0)
+			newLine();
+		write(statement);
+	}
+	--m_indentation;
+
+	if (m_output->size() - bodyStart < 30 && m_lineBreaks == lineBreaksBeforeBody)
+	{
+		m_output->replace(openingEnd, bodyStart - openingEnd, " ");
+		--m_lineBreaks;
+		*m_output += " }";
+	}
 	else
 	{
-		boost::replace_all(body, "\n", "\n    ");
-		return locationComment + "{\n    " + body + "\n}";
+		newLine();
+		*m_output += "}";
 	}
 }
 
-std::string AsmPrinter::formatNameWithDebugData(NameWithDebugData _variable)
+void AsmPrinter::write(Expression const& _expression)
+{
+	std::visit([&](auto const& _node) { write(_node); }, _expression);
+}
+
+void AsmPrinter::write(Statement const& _statement)
+{
+	std::visit([&](auto const& _node) { write(_node); }, _statement);
+}
+
+void AsmPrinter::writeNameWithDebugData(NameWithDebugData const& _variable)
 {
 	yulAssert(!_variable.name.empty(), "Invalid variable name.");
-	return formatDebugData(_variable) + _variable.name.str();
+	writeDebugData(_variable);
+	*m_output += _variable.name.str();
 }
 
 std::string AsmPrinter::formatSourceLocation(
@@ -289,15 +353,18 @@ std::string AsmPrinter::formatSourceLocation(
 	return sourceLocation + (solidityCodeSnippet.empty() ? "" : "  ") + solidityCodeSnippet;
 }
 
-std::string AsmPrinter::formatDebugData(langutil::DebugData::ConstPtr const& _debugData, bool _statement)
+void AsmPrinter::writeDebugData(langutil::DebugData::ConstPtr const& _debugData, bool _statement)
 {
 	if (!_debugData || m_debugInfoSelection.none())
-		return "";
+		return;
+
+	size_t const commentStart = m_output->size();
+	*m_output += _statement ? "/// " : "/** ";
+	size_t const bodyStart = m_output->size();
 
-	std::vector<std::string> items;
 	if (auto id = _debugData->astID)
 		if (m_debugInfoSelection.astID)
-			items.emplace_back("@ast-id " + std::to_string(*id));
+			*m_output += "@ast-id " + std::to_string(*id);
 
 	if (
 		m_lastLocation != _debugData->originLocation &&
@@ -306,20 +373,36 @@ std::string AsmPrinter::formatDebugData(langutil::DebugData::ConstPtr const& _de
 	{
 		m_lastLocation = _debugData->originLocation;
 
-		items.emplace_back(formatSourceLocation(
+		std::string const sourceLocation = formatSourceLocation(
 			_debugData->originLocation,
 			m_nameToSourceIndex,
 			m_debugInfoSelection,
 			m_soliditySourceProvider
-		));
+		);
+		if (m_output->size() > bodyStart && !sourceLocation.empty())
+			*m_output += " ";
+		*m_output += sourceLocation;
 	}
 
-	std::string commentBody = joinHumanReadable(items, " ");
-	if (commentBody.empty())
-		return "";
+	if (m_output->size() == bodyStart)
+		m_output->resize(commentStart);
+	else if (_statement)
+		newLine();
 	else
-		return
-			_statement ?
-			"/// " + commentBody + "\n" :
-			"/** " + commentBody + " */ ";
+		*m_output += " */ ";
+}
+
+void AsmPrinter::newLine()
+{
+	m_output->push_back('\n');
+	m_output->append(4 * m_indentation, ' ');
+	++m_lineBreaks;
+}
+
+void AsmPrinter::breakLineAt(size_t _position)
+{
+	yulAssert((*m_output)[_position] == ' ');
+	(*m_output)[_position] = '\n';
+	m_output->insert(_position + 1, 4 * m_indentation, ' ');
+	++m_lineBreaks;
 }
@@ -40,6 +40,10 @@ namespace solidity::yul
 /**
  * Converts a parsed Yul AST into readable string representation.
  * Ignores source locations.
+ *
+ * All nodes are written directly into a single output buffer. The layout decisions that depend
+ * on the printed size of a node (e.g. printing short blocks on a single line) are made after the
+ * node has been written, by adjusting the buffer in place.
  */
 class AsmPrinter
 {
@@ -57,20 +61,24 @@ public:
 				m_nameToSourceIndex[*name] = index;
 	}
 
-	std::string operator()(Literal const& _literal);
-	std::string operator()(Identifier const& _identifier);
-	std::string operator()(ExpressionStatement const& _expr);
-	std::string operator()(Assignment const& _assignment);
-	std::string operator()(VariableDeclaration const& _variableDeclaration);
-	std::string operator()(FunctionDefinition const& _functionDefinition);
-	std::string operator()(FunctionCall const& _functionCall);
-	std::string operator()(If const& _if);
-	std::string operator()(Switch const& _switch);
-	std::string operator()(ForLoop const& _forLoop);
-	std::string operator()(Break const& _break);
-	std::string operator()(Continue const& _continue);
-	std::string operator()(Leave const& _continue);
-	std::string operator()(Block const& _block);
+	std::string operator()(Literal const& _literal) { return toString(_literal); }
+	std::string operator()(Identifier const& _identifier) { return toString(_identifier); }
+	std::string operator()(ExpressionStatement const& _expr) { return toString(_expr); }
+	std::string operator()(Assignment const& _assignment) { return toString(_assignment); }
+	std::string operator()(VariableDeclaration const& _variableDeclaration) { return toString(_variableDeclaration); }
+	std::string operator()(FunctionDefinition const& _functionDefinition) { return toString(_functionDefinition); }
+	std::string operator()(FunctionCall const& _functionCall) { return toString(_functionCall); }
+	std::string operator()(If const& _if) { return toString(_if); }
+	std::string operator()(Switch const& _switch) { return toString(_switch); }
+	std::string operator()(ForLoop const& _forLoop) { return toString(_forLoop); }
+	std::string operator()(Break const& _break) { return toString(_break); }
+	std::string operator()(Continue const& _continue) { return toString(_continue); }
+	std::string operator()(Leave const& _leave) { return toString(_leave); }
+	std::string operator()(Block const& _block) { return toString(_block); }
+
+	/// Appends the representation of @a _block to @a _output. All lines but the first one
+	/// are indented by @a _indentation levels of four spaces.
+	void print(std::string& _output, Block const& _block, size_t _indentation = 0);
 
 	static std::string formatSourceLocation(
 		langutil::SourceLocation const& _location,
@@ -80,19 +88,55 @@ public:
 	);
 
 private:
-	std::string formatNameWithDebugData(NameWithDebugData _variable);
-	std::string formatDebugData(langutil::DebugData::ConstPtr const& _debugData, bool _statement);
 	template <class T>
-	std::string formatDebugData(T const& _node)
+	std::string toString(T const& _node)
+	{
+		std::string output;
+		m_output = &output;
+		m_indentation = 0;
+		write(_node);
+		m_output = nullptr;
+		return output;
+	}
+
+	void write(Literal const& _literal);
+	void write(Identifier const& _identifier);
+	void write(ExpressionStatement const& _statement);
+	void write(Assignment const& _assignment);
+	void write(VariableDeclaration const& _variableDeclaration);
+	void write(FunctionDefinition const& _functionDefinition);
+	void write(FunctionCall const& _functionCall);
+	void write(If const& _if);
+	void write(Switch const& _switch);
+	void write(ForLoop const& _forLoop);
+	void write(Break const& _break);
+	void write(Continue const& _continue);
+	void write(Leave const& _leave);
+	void write(Block const& _block);
+	void write(Expression const& _expression);
+	void write(Statement const& _statement);
+	void writeNameWithDebugData(NameWithDebugData const& _variable);
+	void writeDebugData(langutil::DebugData::ConstPtr const& _debugData, bool _statement);
+	template <class T>
+	void writeDebugData(T const& _node)
 	{
 		bool isExpression = std::is_constructible<Expression, T>::value;
-		return formatDebugData(_node.debugData, !isExpression);
+		writeDebugData(_node.debugData, !isExpression);
 	}
+	/// Starts a new line at the current indentation.
+	void newLine();
+	/// Replaces the space at @a _position by a line break followed by the current indentation.
+	void breakLineAt(size_t _position);
 
 	std::map<std::string, unsigned> m_nameToSourceIndex;
 	langutil::SourceLocation m_lastLocation = {};
 	langutil::DebugInfoSelection m_debugInfoSelection = {};
 	langutil::CharStreamProvider const* m_soliditySourceProvider = nullptr;
+
+	std::string* m_output = nullptr;
+	size_t m_indentation = 0;
+	/// Number of line breaks written so far. Used to find out whether a node spans several lines.
+	size_t m_lineBreaks = 0;
 };
 
 }
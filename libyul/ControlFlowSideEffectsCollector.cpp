@@ -185,14 +185,26 @@ ControlFlowSideEffectsCollector::ControlFlowSideEffectsCollector(
 	}
 
 	// Process functions while we have progress. For now, we are only interested
-	// in `canContinue`.
-	bool progress = true;
-	while (progress)
+	// in `canContinue`. A function only has to be processed again once one of the
+	// functions it is waiting for turns out to be able to continue.
+	std::vector<FunctionDefinition const*> worklist;
+	for (FunctionDefinition const* function: m_pendingNodes | ranges::views::keys)
+		worklist.emplace_back(function);
+	std::set<FunctionDefinition const*> inWorklist(worklist.begin(), worklist.end());
+	while (!worklist.empty())
 	{
-		progress = false;
-		for (FunctionDefinition const* function: m_pendingNodes | ranges::views::keys)
-			if (processFunction(*function))
-				progress = true;
+		FunctionDefinition const* function = worklist.back();
+		worklist.pop_back();
+		inWorklist.erase(function);
+		bool couldContinue = m_functionSideEffects[function].canContinue;
+		processFunction(*function);
+		if (!couldContinue && m_functionSideEffects[function].canContinue)
+		{
+			for (FunctionDefinition const* caller: m_waitingCallers[function])
+				if (inWorklist.insert(caller).second)
+					worklist.emplace_back(caller);
+			m_waitingCallers.erase(function);
+		}
 	}
 
 	// No progress anymore: All remaining nodes are calls
@@ -202,30 +214,33 @@ ControlFlowSideEffectsCollector::ControlFlowSideEffectsCollector(
 
 	// Now it is sufficient to handle the reachable function calls (`m_functionCalls`),
 	// we do not have to consider the control-flow graph anymore.
-	for (auto&& [function, calls]: m_functionCalls)
+	// The components of the call graph are in reverse topological order, so the side-effects
+	// of all called functions outside of a component are final once it is processed.
+	// All functions of a component call each other and thus share their side-effects.
+	util::StronglyConnectedComponents<FunctionDefinition const*> callGraphComponents;
+	auto forEachCallee = [&](FunctionDefinition const* _function, auto&& _addChild) {
+		for (FunctionCall const* call: m_functionCalls.at(_function))
+			if (FunctionDefinition const* const* callee = util::valueOrNullptr(m_functionReferences, call))
+				_addChild(*callee);
+	};
+	for (FunctionDefinition const* function: m_functionCalls | ranges::views::keys)
+		callGraphComponents.run(function, forEachCallee);
+	for (std::vector<FunctionDefinition const*> const& component: callGraphComponents.components)
 	{
-		yulAssert(function);
-		ControlFlowSideEffects& functionSideEffects = m_functionSideEffects[function];
-		auto _visit = [&, visited = std::set<FunctionDefinition const*>{}](FunctionDefinition const& _function, auto&& _recurse) mutable {
-			// Worst side-effects already, stop searching.
-			if (functionSideEffects.canTerminate && functionSideEffects.canRevert)
-				return;
-			if (!visited.insert(&_function).second)
-				return;
-
-			for (FunctionCall const* call: m_functionCalls.at(&_function))
+		bool canTerminate = false;
+		bool canRevert = false;
+		for (FunctionDefinition const* function: component)
+			for (FunctionCall const* call: m_functionCalls.at(function))
 			{
 				ControlFlowSideEffects const& calledSideEffects = sideEffects(*call);
-				if (calledSideEffects.canTerminate)
-					functionSideEffects.canTerminate = true;
-				if (calledSideEffects.canRevert)
-					functionSideEffects.canRevert = true;
-
-				if (m_functionReferences.count(call))
-					_recurse(*m_functionReferences.at(call), _recurse);
+				canTerminate = canTerminate || calledSideEffects.canTerminate;
+				canRevert = canRevert || calledSideEffects.canRevert;
 			}
-		};
-		_visit(*function, _visit);
+		for (FunctionDefinition const* function: component)
+		{
+			m_functionSideEffects[function].canTerminate = canTerminate;
+			m_functionSideEffects[function].canRevert = canRevert;
+		}
 	}
 }
 
@@ -243,10 +258,7 @@ bool ControlFlowSideEffectsCollector::processFunction(FunctionDefinition const&
 	while (ControlFlowNode const* node = nextProcessableNode(_function))
 	{
 		if (node == m_cfgBuilder.functionFlows().at(&_function).exit)
-		{
 			m_functionSideEffects[&_function].canContinue = true;
-			return true;
-		}
 		for (ControlFlowNode const* s: node->successors)
 			recordReachabilityAndQueue(_function, s);
 
@@ -258,8 +270,12 @@ bool ControlFlowSideEffectsCollector::processFunction(FunctionDefinition const&
 ControlFlowNode const* ControlFlowSideEffectsCollector::nextProcessableNode(FunctionDefinition const& _function)
 {
 	std::list<ControlFlowNode const*>& nodes = m_pendingNodes[&_function];
-	auto it = ranges::find_if(nodes, [this](ControlFlowNode const* _node) {
-		return !_node->functionCall || sideEffects(*_node->functionCall).canContinue;
+	auto it = ranges::find_if(nodes, [&](ControlFlowNode const* _node) {
+		if (!_node->functionCall || sideEffects(*_node->functionCall).canContinue)
+			return true;
+		if (FunctionDefinition const* const* callee = util::valueOrNullptr(m_functionReferences, _node->functionCall))
+			m_waitingCallers[*callee].insert(&_function);
+		return false;
 	});
 	if (it == nodes.end())
 		return nullptr;
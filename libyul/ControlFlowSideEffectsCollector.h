@@ -104,12 +104,15 @@ public:
 	std::map<YulName, ControlFlowSideEffects> functionSideEffectsNamed() const;
 private:
 
+	/// Processes all nodes of the function that are reachable as far as the side-effects of
+	/// the called functions are known.
 	/// @returns false if nothing could be processed.
 	bool processFunction(FunctionDefinition const& _function);
 
 	/// @returns the next pending node of the function that is not
 	/// a function call to a function that might not continue.
 	/// De-queues the node or returns nullptr if no such node is found.
+	/// Records the function as waiting for the called functions of the skipped nodes.
 	ControlFlowNode const* nextProcessableNode(FunctionDefinition const& _function);
 
 	/// @returns the side-effects of either a builtin call or a user defined function
@@ -133,6 +136,9 @@ private:
 	std::map<FunctionDefinition const*, std::set<ControlFlowNode const*>> m_processedNodes;
 	/// Set of reachable function calls nodes in each function (including calls to builtins).
 	std::map<FunctionDefinition const*, std::set<FunctionCall const*>> m_functionCalls;
+	/// Functions that have pending nodes calling a function that is not yet known to continue,
+	/// per called function.
+	std::map<FunctionDefinition const*, std::set<FunctionDefinition const*>> m_waitingCallers;
 };
 
 
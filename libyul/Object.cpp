@@ -38,12 +38,24 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
 
-std::string Data::toString(DebugInfoSelection const&, CharStreamProvider const*) const
+std::string ObjectNode::toString(
+	DebugInfoSelection const& _debugInfoSelection,
+	CharStreamProvider const* _soliditySourceProvider
+) const
+{
+	std::string output;
+	print(output, 0, _debugInfoSelection, _soliditySourceProvider);
+	return output;
+}
+
+void Data::print(std::string& _output, size_t, DebugInfoSelection const&, CharStreamProvider const*) const
 {
-	return "data \"" + name + "\" hex\"" + util::toHex(data) + "\"";
+	_output += "data \"" + name + "\" hex\"" + util::toHex(data) + "\"";
 }
 
-std::string Object::toString(
+void Object::print(
+	std::string& _output,
+	size_t _indentation,
 	DebugInfoSelection const& _debugInfoSelection,
 	CharStreamProvider const* _soliditySourceProvider
 ) const
@@ -51,20 +63,36 @@ std::string Object::toString(
 	yulAssert(hasCode(), "No code");
 	yulAssert(debugData, "No debug data");
 
-	std::string inner = "code " + AsmPrinter(
+	auto newLine = [&](size_t _level) {
+		_output.push_back('\n');
+		_output.append(4 * _level, ' ');
+	};
+
+	std::string useSrcComment = debugData->formatUseSrcComment();
+	if (!useSrcComment.empty())
+	{
+		yulAssert(useSrcComment.back() == '\n');
+		useSrcComment.pop_back();
+		_output += useSrcComment;
+		newLine(_indentation);
+	}
+	_output += "object \"" + name + "\" {";
+	newLine(_indentation + 1);
+	_output += "code ";
+	AsmPrinter(
 		debugData->sourceNames,
 		_debugInfoSelection,
 		_soliditySourceProvider
-	)(code()->root());
+	).print(_output, code()->root(), _indentation + 1);
 
 	for (auto const& obj: subObjects)
-		inner += "\n" + obj->toString(_debugInfoSelection, _soliditySourceProvider);
+	{
+		newLine(_indentation + 1);
+		obj->print(_output, _indentation + 1, _debugInfoSelection, _soliditySourceProvider);
+	}
 
-	return
-		debugData->formatUseSrcComment() +
-		"object \"" + name + "\" {\n" +
-		indent(inner) + "\n" +
-		"}";
+	newLine(_indentation);
+	_output += "}";
 }
 
 Json Data::toJson() const
@@ -105,8 +133,8 @@ Json Object::toJson() const
 	Json ret;
 	ret["nodeType"] = "YulObject";
 	ret["name"] = name;
-	ret["code"] = codeJson;
-	ret["subObjects"] = subObjectsJson;
+	ret["code"] = std::move(codeJson);
+	ret["subObjects"] = std::move(subObjectsJson);
 	return ret;
 }
 
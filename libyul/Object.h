@@ -56,6 +56,14 @@ struct ObjectNode
 	virtual std::string toString(
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
+	) const;
+	/// Appends the string representation to @a _output. All lines but the first one are indented
+	/// by @a _indentation levels of four spaces.
+	virtual void print(
+		std::string& _output,
+		size_t _indentation,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const = 0;
 	virtual Json toJson() const = 0;
 };
@@ -69,7 +77,9 @@ struct Data: public ObjectNode
 
 	bytes data;
 
-	std::string toString(
+	void print(
+		std::string& _output,
+		size_t _indentation,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const override;
@@ -95,6 +105,15 @@ public:
 	std::string toString(
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
+	) const override
+	{
+		return ObjectNode::toString(_debugInfoSelection, _soliditySourceProvider);
+	}
+	void print(
+		std::string& _output,
+		size_t _indentation,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const override;
 	/// @returns a compact JSON representation of the AST.
 	Json toJson() const override;
@@ -20,20 +20,31 @@
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmAnalysis.h>
+#include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/Cancellation.h>
+#include <libsolutil/CommonIO.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <fstream>
 #include <limits>
 #include <numeric>
 
@@ -54,79 +65,159 @@ Dialect const& yul::languageToDialect(Language _language, EVMVersion _version, s
 	util::unreachable();
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings)
+void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, size_t _numThreads)
 {
 	yulAssert(_object.subId == std::numeric_limits<size_t>::max(), "Not a top-level object.");
 
-	optimize(_object, _settings, true /* _isCreation */);
+	std::vector<std::pair<Object*, bool>> objects;
+	collectObjects(_object, true /* _isCreation */, objects);
+
+	if (_numThreads <= 1 || objects.size() <= 1)
+	{
+		for (auto const& [object, isCreation]: objects)
+			optimizeSingleObject(*object, _settings, isCreation, _numThreads);
+		return;
+	}
+
+	// Threads not needed for the objects themselves are shared out among their functions,
+	// so that no more than _numThreads threads work at the same time.
+	size_t const threadsPerObject = std::max<size_t>(1, _numThreads / objects.size());
+	std::vector<std::future<void>> results;
+	{
+		ThreadPool threadPool(std::min(_numThreads, objects.size()));
+		for (auto const& [object, isCreation]: objects)
+			results.emplace_back(threadPool.submit([this, object = object, isCreation = isCreation, &_settings, threadsPerObject]() {
+				optimizeSingleObject(*object, _settings, isCreation, threadsPerObject);
+			}));
+	}
+	// Rethrow the exception of the first failed object, as the sequential order would.
+	for (std::future<void>& result: results)
+		result.get();
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool _isCreation)
+void ObjectOptimizer::collectObjects(
+	Object& _object,
+	bool _isCreation,
+	std::vector<std::pair<Object*, bool>>& o_objects
+)
 {
-	yulAssert(_object.code());
-	yulAssert(_object.debugData);
-
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
-			optimize(
-				*subObject,
-				_settings,
-				isCreation
-			);
+			collectObjects(*subObject, isCreation, o_objects);
 		}
+	o_objects.emplace_back(&_object, _isCreation);
+}
+
+void ObjectOptimizer::optimizeSingleObject(Object& _object, Settings const& _settings, bool _isCreation, size_t _numThreads)
+{
+	yulAssert(_object.code());
+	yulAssert(_object.debugData);
 
 	Dialect const& dialect = languageToDialect(_settings.language, _settings.evmVersion, _settings.eofVersion);
 	std::unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, _settings.expectedExecutionsPerDeployment);
 
+	auto runOptimiser = [&]() {
+		OptimiserSuite::run(
+			dialect,
+			meter.get(),
+			_object,
+			_settings.optimizeStackAllocation,
+			_settings.yulOptimiserSteps,
+			_settings.yulOptimiserCleanupSteps,
+			_isCreation ? std::nullopt : std::make_optional(_settings.expectedExecutionsPerDeployment),
+			{},
+			_numThreads
+		);
+	};
+
 	std::optional<h256> cacheKey = calculateCacheKey(_object.code()->root(), *_object.debugData, _settings, _isCreation);
-	if (cacheKey.has_value() && m_cachedObjects.count(*cacheKey) != 0)
+	if (!cacheKey.has_value())
 	{
-		overwriteWithOptimizedObject(*cacheKey, _object);
+		runOptimiser();
 		return;
 	}
 
-	OptimiserSuite::run(
-		dialect,
-		meter.get(),
-		_object,
-		_settings.optimizeStackAllocation,
-		_settings.yulOptimiserSteps,
-		_settings.yulOptimiserCleanupSteps,
-		_isCreation ? std::nullopt : std::make_optional(_settings.expectedExecutionsPerDeployment),
-		{}
-	);
+	std::promise<CachedObject> promise;
+	std::shared_future<CachedObject> cachedObject;
+	{
+		std::lock_guard lock(m_cacheMutex);
+		auto [it, inserted] = m_cachedObjects.try_emplace(*cacheKey);
+		if (inserted)
+			it->second = promise.get_future().share();
+		else
+			cachedObject = it->second;
+	}
 
-	if (cacheKey.has_value())
-		storeOptimizedObject(*cacheKey, _object, dialect);
+	if (cachedObject.valid())
+	{
+		util::Profiler::count("Yul optimizer cache hits");
+		try
+		{
+			// Blocks if another thread is still optimizing an identical object.
+			overwriteWithOptimizedObject(cachedObject.get(), _object);
+		}
+		catch (util::CompilationCancelled const&)
+		{
+			// The other compilation was cancelled and removed the entry, this one has to retry.
+			util::CancellationToken::check();
+			optimizeSingleObject(_object, _settings, _isCreation, _numThreads);
+		}
+		return;
+	}
+
+	try
+	{
+		if (std::optional<CachedObject> persistentObject = loadPersistentObject(*cacheKey, _object, dialect))
+		{
+			util::Profiler::count("Yul optimizer persistent cache hits");
+			overwriteWithOptimizedObject(*persistentObject, _object);
+			promise.set_value(std::move(*persistentObject));
+		}
+		else
+		{
+			util::Profiler::count("Yul optimizer cache misses");
+			runOptimiser();
+			CachedObject optimizedObject = createCachedObject(_object, dialect);
+			storePersistentObject(*cacheKey, optimizedObject, *_object.debugData);
+			promise.set_value(std::move(optimizedObject));
+		}
+	}
+	catch (...)
+	{
+		// Let waiting threads fail the same way, but allow later requests to retry.
+		{
+			std::lock_guard lock(m_cacheMutex);
+			m_cachedObjects.erase(*cacheKey);
+		}
+		promise.set_exception(std::current_exception());
+		throw;
+	}
 }
 
-void ObjectOptimizer::storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect)
+ObjectOptimizer::CachedObject ObjectOptimizer::createCachedObject(Object const& _optimizedObject, Dialect const& _dialect)
 {
-	m_cachedObjects[_cacheKey] = CachedObject{
+	return CachedObject{
 		std::make_shared<Block>(ASTCopier{}.translate(_optimizedObject.code()->root())),
 		&_dialect,
 	};
 }
 
-void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
+void ObjectOptimizer::overwriteWithOptimizedObject(CachedObject const& _cachedObject, Object& _object)
 {
-	yulAssert(m_cachedObjects.count(_cacheKey) != 0);
-	CachedObject const& cachedObject = m_cachedObjects.at(_cacheKey);
-
-	yulAssert(cachedObject.optimizedAST);
-	_object.setCode(std::make_shared<AST>(ASTCopier{}.translate(*cachedObject.optimizedAST)));
+	yulAssert(_cachedObject.optimizedAST);
+	_object.setCode(std::make_shared<AST>(ASTCopier{}.translate(*_cachedObject.optimizedAST)));
 	yulAssert(_object.code());
 
 	// There's no point in caching AnalysisInfo because it references AST nodes. It can't be shared
 	// by multiple ASTs and it's easier to recalculate it than properly clone it.
-	yulAssert(cachedObject.dialect);
+	yulAssert(_cachedObject.dialect);
 	_object.analysisInfo = std::make_shared<AsmAnalysisInfo>(
 		AsmAnalyzer::analyzeStrictAssertCorrect(
-			*cachedObject.dialect,
+			*_cachedObject.dialect,
 			_object
 		)
 	);
@@ -134,6 +225,129 @@ void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object&
 	// NOTE: Source name index is included in the key so it must be identical. No need to store and restore it.
 }
 
+void ObjectOptimizer::setPersistentCacheDirectory(
+	std::optional<boost::filesystem::path> _directory,
+	std::string _compilerVersion
+)
+{
+	m_persistentCacheDirectory = std::move(_directory);
+	m_compilerVersion = std::move(_compilerVersion);
+}
+
+std::optional<ObjectOptimizer::CachedObject> ObjectOptimizer::loadPersistentObject(
+	h256 const& _cacheKey,
+	Object const& _object,
+	Dialect const& _dialect
+) const
+{
+	if (!m_persistentCacheDirectory.has_value())
+		return std::nullopt;
+
+	boost::filesystem::path const path = persistentCachePath(_cacheKey);
+	boost::system::error_code errorCode;
+	if (!boost::filesystem::is_regular_file(path, errorCode))
+		return std::nullopt;
+
+	std::string entry;
+	try
+	{
+		entry = readFileAsString(path);
+	}
+	catch (util::Exception const&)
+	{
+		return std::nullopt;
+	}
+
+	// The first line holds the checksum of the key and the code, which rejects truncated entries
+	// and entries stored under a different key.
+	size_t const checksumEnd = entry.find('\n');
+	if (checksumEnd == std::string::npos)
+		return std::nullopt;
+	std::string source = entry.substr(checksumEnd + 1);
+	if (entry.substr(0, checksumEnd) != "// " + persistentEntryChecksum(_cacheKey, source))
+		return std::nullopt;
+
+	// The entry was printed with the same source names, which are a part of the key, so the
+	// debug data of the parsed AST is identical to that of the originally optimized one.
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(std::move(source), path.string());
+	std::unique_ptr<AST> ast = Parser(errorReporter, _dialect, _object.debugData->sourceNames).parse(charStream);
+	if (!ast || errorReporter.hasErrors())
+		return std::nullopt;
+
+	// Do not trust the checksum alone, the entry must also be valid code in this context.
+	AsmAnalysisInfo analysisInfo;
+	if (
+		!AsmAnalyzer(analysisInfo, errorReporter, _dialect, {}, _object.qualifiedDataNames()).analyze(ast->root()) ||
+		errorReporter.hasErrors()
+	)
+		return std::nullopt;
+
+	return CachedObject{
+		std::make_shared<Block>(ASTCopier{}.translate(ast->root())),
+		&_dialect,
+	};
+}
+
+void ObjectOptimizer::storePersistentObject(
+	h256 const& _cacheKey,
+	CachedObject const& _cachedObject,
+	ObjectDebugData const& _debugData
+) const
+{
+	if (!m_persistentCacheDirectory.has_value())
+		return;
+
+	yulAssert(_cachedObject.optimizedAST);
+	std::string const source = AsmPrinter(_debugData.sourceNames, DebugInfoSelection::All())(*_cachedObject.optimizedAST);
+	std::string const entry = "// " + persistentEntryChecksum(_cacheKey, source) + "\n" + source;
+
+	boost::system::error_code errorCode;
+	boost::filesystem::path const path = persistentCachePath(_cacheKey);
+	boost::filesystem::create_directories(path.parent_path(), errorCode);
+	if (errorCode)
+		return;
+
+	// Write to a unique temporary file first and move it into place afterwards so that
+	// concurrent compiler runs never observe a partially written entry.
+	boost::filesystem::path const temporaryPath = boost::filesystem::unique_path(
+		path.string() + ".%%%%-%%%%-%%%%-%%%%.tmp",
+		errorCode
+	);
+	if (errorCode)
+		return;
+
+	{
+		std::ofstream output(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+		output << entry;
+		if (!output)
+		{
+			output.close();
+			boost::filesystem::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+
+	boost::filesystem::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		boost::filesystem::remove(temporaryPath, errorCode);
+}
+
+boost::filesystem::path ObjectOptimizer::persistentCachePath(h256 const& _cacheKey) const
+{
+	yulAssert(m_persistentCacheDirectory.has_value());
+	return
+		*m_persistentCacheDirectory /
+		"yul-optimizer" /
+		(keccak256(m_compilerVersion + _cacheKey.hex()).hex() + ".yul");
+}
+
+std::string ObjectOptimizer::persistentEntryChecksum(h256 const& _cacheKey, std::string const& _source) const
+{
+	return keccak256(m_compilerVersion + _cacheKey.hex() + _source).hex();
+}
+
 std::optional<h256> ObjectOptimizer::calculateCacheKey(
 	Block const& _ast,
 	ObjectDebugData const& _debugData,
@@ -141,17 +355,12 @@ std::optional<h256> ObjectOptimizer::calculateCacheKey(
 	bool _isCreation
 )
 {
-	AsmPrinter asmPrinter(
-		_debugData.sourceNames,
-		DebugInfoSelection::All()
-	);
-
 	bytes rawKey;
-	// NOTE: AsmPrinter never prints nativeLocations included in debug data, so ASTs differing only
+	// NOTE: The ASTKeccakHasher ignores nativeLocations included in debug data, so ASTs differing only
 	// in that regard are considered equal here.  This is fine because the optimizer does not keep
 	// them up to date across AST transformations anyway so in any use where they need to be reliable,
 	// we just regenerate them by reparsing the object.
-	rawKey += keccak256(asmPrinter(_ast)).asBytes();
+	rawKey += ASTKeccakHasher::run(_ast).asBytes();
 	rawKey += keccak256(_debugData.formatUseSrcComment()).asBytes();
 	rawKey += h256(u256(_settings.language)).asBytes();
 	rawKey += FixedHash<1>(uint8_t(_settings.optimizeStackAllocation ? 0 : 1)).asBytes();
@@ -25,9 +25,15 @@
 
 #include <libsolutil/FixedHash.h>
 
+#include <boost/filesystem/path.hpp>
+
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -47,7 +53,20 @@ Dialect const& languageToDialect(Language _language, langutil::EVMVersion _versi
 /// need to invalidate entries due to changing settings or context.
 /// Caching is performed at the granularity of individual ASTs rather than whole object trees,
 /// which means that reuse is possible even within a single hierarchy, e.g. when creation and
-/// deployed objects have common dependencies.
+/// deployed objects have common dependencies. Finer granularity, e.g. reusing optimized bodies
+/// of functions shared by different objects, is not possible, because the optimizer works across
+/// function boundaries (inlining, specialization, combining of functions, pruning of parameters)
+/// and the optimized body of a function therefore depends on the whole AST it is part of.
+///
+/// Access to the cache is synchronized so that a single instance can be used to optimize
+/// independent objects on multiple threads at the same time. When multiple threads request the
+/// same cache entry, only one of them runs the optimizer and the others wait for its result.
+///
+/// Objects of a hierarchy can be optimized in parallel (see optimize()), because the
+/// optimization of an object never depends on the code of its sub-objects.
+///
+/// Optionally, the cache can be backed by a directory on disk (see setPersistentCacheDirectory()),
+/// which makes optimized ASTs reusable across compiler runs.
 class ObjectOptimizer
 {
 public:
@@ -68,10 +87,28 @@ public:
 	/// Recursively optimizes a Yul object with given settings, reusing cached ASTs where possible
 	/// or caching the result otherwise. The object is modified in-place.
 	/// Automatically accounts for the difference between creation and deployed objects.
+	/// The objects of the hierarchy and the functions within each object are optimized on
+	/// @a _numThreads threads in total, which does not affect the result. It is a parameter rather
+	/// than a setting of the instance, because compilations sharing the cache can have different budgets.
 	/// @warning Does not ensure that nativeLocations in the resulting AST match the optimized code.
-	void optimize(Object& _object, Settings const& _settings);
+	void optimize(Object& _object, Settings const& _settings, size_t _numThreads = 1);
+
+	/// Makes the cache persistent by also storing optimized ASTs as files in the given directory.
+	/// Entries are only reused by the compiler identified by @a _compilerVersion. The cache is
+	/// best-effort: unreadable or invalid entries and entries whose checksum does not match are
+	/// ignored and recomputed, and failures to write to the directory do not affect the result.
+	/// The checksum is not a protection against other users, so the directory must be private.
+	/// Passing std::nullopt disables the persistent cache. Must not be called during optimization.
+	void setPersistentCacheDirectory(
+		std::optional<boost::filesystem::path> _directory,
+		std::string _compilerVersion = {}
+	);
 
-	size_t size() const { return m_cachedObjects.size(); }
+	size_t size() const
+	{
+		std::lock_guard lock(m_cacheMutex);
+		return m_cachedObjects.size();
+	}
 
 private:
 	struct CachedObject
@@ -80,10 +117,29 @@ private:
 		Dialect const* dialect;
 	};
 
-	void optimize(Object& _object, Settings const& _settings, bool _isCreation);
-
-	void storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect);
-	void overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+	/// Optimizes a single object without descending into its sub-objects, using up to
+	/// @a _numThreads threads for steps that can process functions in parallel.
+	void optimizeSingleObject(Object& _object, Settings const& _settings, bool _isCreation, size_t _numThreads);
+
+	static void collectObjects(Object& _object, bool _isCreation, std::vector<std::pair<Object*, bool>>& o_objects);
+	static CachedObject createCachedObject(Object const& _optimizedObject, Dialect const& _dialect);
+	static void overwriteWithOptimizedObject(CachedObject const& _cachedObject, Object& _object);
+
+	/// @returns the optimized AST stored in the persistent cache under the given key, provided
+	/// that it can be parsed and analyzed in the context of @a _object.
+	std::optional<CachedObject> loadPersistentObject(
+		util::h256 const& _cacheKey,
+		Object const& _object,
+		Dialect const& _dialect
+	) const;
+	void storePersistentObject(
+		util::h256 const& _cacheKey,
+		CachedObject const& _cachedObject,
+		ObjectDebugData const& _debugData
+	) const;
+	boost::filesystem::path persistentCachePath(util::h256 const& _cacheKey) const;
+	/// @returns the checksum stored in the first line of a persistent cache entry.
+	std::string persistentEntryChecksum(util::h256 const& _cacheKey, std::string const& _source) const;
 
 	static std::optional<util::h256> calculateCacheKey(
 		Block const& _ast,
@@ -92,7 +148,11 @@ private:
 		bool _isCreation
 	);
 
-	std::map<util::h256, CachedObject> m_cachedObjects;
+	/// Cached objects, including ones that are still being computed by another thread.
+	std::map<util::h256, std::shared_future<CachedObject>> m_cachedObjects;
+	std::mutex mutable m_cacheMutex;
+	std::optional<boost::filesystem::path> m_persistentCacheDirectory;
+	std::string m_compilerVersion;
 };
 
 }
@@ -0,0 +1,255 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Flat hash containers keyed by YulName.
+ */
+
+#pragma once
+
+#include <libyul/Exceptions.h>
+#include <libyul/YulName.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+namespace detail
+{
+
+inline YulName const& entryName(YulName const& _entry) { return _entry; }
+template<typename T>
+YulName const& entryName(std::pair<YulName, T> const& _entry) { return _entry.first; }
+
+/**
+ * Open-addressing hash table with linear probing that stores its entries in a single array.
+ *
+ * Names are compared by their ID and placed according to their string hash, so unlike
+ * the tree-based std::map no string is ever compared, and unlike std::unordered_map no
+ * node is allocated per entry. Since the placement does not depend on the IDs, the iteration
+ * order only depends on the names and on the order of insertions and removals and is thus
+ * deterministic, although it is unrelated to the order of std::map<YulName, ...>.
+ *
+ * Insertions and removals invalidate all iterators, pointers and references into the table.
+ */
+template<typename Entry>
+class YulNameTable
+{
+	using Slot = std::optional<Entry>;
+
+	template<typename SlotType, typename Value>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::remove_const_t<Value>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Value*;
+		using reference = Value&;
+
+		Iterator(SlotType* _slot, SlotType* _end): m_slot(_slot), m_end(_end) { skipEmptySlots(); }
+
+		reference operator*() const { return **m_slot; }
+		pointer operator->() const { return &**m_slot; }
+		Iterator& operator++() { ++m_slot; skipEmptySlots(); return *this; }
+		Iterator operator++(int) { Iterator result = *this; ++*this; return result; }
+		bool operator==(Iterator const& _other) const { return m_slot == _other.m_slot; }
+		bool operator!=(Iterator const& _other) const { return m_slot != _other.m_slot; }
+
+	private:
+		void skipEmptySlots()
+		{
+			while (m_slot != m_end && !m_slot->has_value())
+				++m_slot;
+		}
+
+		SlotType* m_slot;
+		SlotType* m_end;
+	};
+
+public:
+	using iterator = Iterator<Slot, Entry>;
+	using const_iterator = Iterator<Slot const, Entry const>;
+
+	iterator begin() { return {m_slots.data(), m_slots.data() + m_slots.size()}; }
+	iterator end() { return {m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()}; }
+	const_iterator begin() const { return {m_slots.data(), m_slots.data() + m_slots.size()}; }
+	const_iterator end() const { return {m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()}; }
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	void clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+
+	iterator find(YulName _name)
+	{
+		size_t index = findIndex(_name);
+		return index == npos ? end() : iterator{m_slots.data() + index, m_slots.data() + m_slots.size()};
+	}
+	const_iterator find(YulName _name) const
+	{
+		size_t index = findIndex(_name);
+		return index == npos ? end() : const_iterator{m_slots.data() + index, m_slots.data() + m_slots.size()};
+	}
+	bool contains(YulName _name) const { return findIndex(_name) != npos; }
+	size_t count(YulName _name) const { return contains(_name) ? 1 : 0; }
+
+	/// Removes the entry for @a _name, if present.
+	/// @returns the number of removed entries.
+	size_t erase(YulName _name)
+	{
+		size_t index = findIndex(_name);
+		if (index == npos)
+			return 0;
+		m_slots[index].reset();
+		--m_size;
+
+		// Move following entries of the same probe sequence back into the gap, so that
+		// lookups can stop at the first empty slot without the need for tombstones.
+		size_t gap = index;
+		for (size_t i = next(gap); m_slots[i].has_value(); i = next(i))
+		{
+			size_t home = homeIndex(entryName(*m_slots[i]));
+			bool reachableFromGap = gap <= i ? (home <= gap || home > i) : (home <= gap && home > i);
+			if (reachableFromGap)
+			{
+				m_slots[gap] = std::move(m_slots[i]);
+				m_slots[i].reset();
+				gap = i;
+			}
+		}
+		return 1;
+	}
+
+protected:
+	static size_t constexpr npos = static_cast<size_t>(-1);
+
+	size_t findIndex(YulName _name) const
+	{
+		if (m_slots.empty())
+			return npos;
+		for (size_t i = homeIndex(_name); m_slots[i].has_value(); i = next(i))
+			if (entryName(*m_slots[i]) == _name)
+				return i;
+		return npos;
+	}
+
+	/// @returns the index of the slot of @a _name, creating the entry with @a _createEntry if it does not exist yet.
+	template<typename CreateEntry>
+	std::pair<size_t, bool> findOrInsert(YulName _name, CreateEntry&& _createEntry)
+	{
+		if (size_t index = findIndex(_name); index != npos)
+			return {index, false};
+
+		// Keep the load factor at or below one half.
+		if ((m_size + 1) * 2 > m_slots.size())
+			rehash(std::max<size_t>(16, m_slots.size() * 2));
+
+		size_t index = homeIndex(_name);
+		while (m_slots[index].has_value())
+			index = next(index);
+		m_slots[index].emplace(_createEntry());
+		++m_size;
+		return {index, true};
+	}
+
+	std::vector<Slot> m_slots;
+
+private:
+	size_t homeIndex(YulName _name) const
+	{
+		std::uint64_t hash = _name.hash();
+		return static_cast<size_t>(hash ^ (hash >> 32)) & (m_slots.size() - 1);
+	}
+	size_t next(size_t _index) const { return (_index + 1) & (m_slots.size() - 1); }
+
+	void rehash(size_t _numSlots)
+	{
+		std::vector<Slot> oldSlots(_numSlots);
+		std::swap(oldSlots, m_slots);
+		for (Slot& slot: oldSlots)
+			if (slot.has_value())
+			{
+				size_t index = homeIndex(entryName(*slot));
+				while (m_slots[index].has_value())
+					index = next(index);
+				m_slots[index] = std::move(slot);
+			}
+	}
+
+	size_t m_size = 0;
+};
+
+}
+
+/**
+ * Map from YulName to @a T, intended as a faster replacement for std::map<YulName, T> in
+ * the optimiser. See detail::YulNameTable for the properties of the underlying table.
+ */
+template<typename T>
+class YulNameMap: public detail::YulNameTable<std::pair<YulName, T>>
+{
+	using Base = detail::YulNameTable<std::pair<YulName, T>>;
+
+public:
+	T& operator[](YulName _name)
+	{
+		size_t index = Base::findOrInsert(_name, [&]() { return std::pair<YulName, T>{_name, T{}}; }).first;
+		return Base::m_slots[index]->second;
+	}
+	T& at(YulName _name)
+	{
+		size_t index = Base::findIndex(_name);
+		yulAssert(index != Base::npos, "Name not found: " + _name.str());
+		return Base::m_slots[index]->second;
+	}
+	T const& at(YulName _name) const
+	{
+		size_t index = Base::findIndex(_name);
+		yulAssert(index != Base::npos, "Name not found: " + _name.str());
+		return Base::m_slots[index]->second;
+	}
+};
+
+/**
+ * Set of YulNames, intended as a faster replacement for std::set<YulName> in
+ * the optimiser. See detail::YulNameTable for the properties of the underlying table.
+ */
+class YulNameSet: public detail::YulNameTable<YulName>
+{
+	using Base = detail::YulNameTable<YulName>;
+
+public:
+	/// @returns true if @a _name was not contained in the set before.
+	bool insert(YulName _name)
+	{
+		return Base::findOrInsert(_name, [&]() { return _name; }).second;
+	}
+};
+
+}
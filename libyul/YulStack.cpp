@@ -33,8 +33,11 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <boost/algorithm/string.hpp>
 
+#include <functional>
 #include <optional>
 
 using namespace solidity;
@@ -135,7 +138,8 @@ void YulStack::optimize()
 				yulOptimiserSteps,
 				yulOptimiserCleanupSteps,
 				m_optimiserSettings.expectedExecutionsPerDeployment
-			}
+			},
+			m_numThreads
 		);
 
 		// Optimizer does not maintain correct native source locations in the AST.
@@ -159,24 +163,48 @@ bool YulStack::analyzeParsed(Object& _object)
 {
 	yulAssert(m_stackState >= Parsed);
 	yulAssert(_object.hasCode());
-	_object.analysisInfo = std::make_shared<AsmAnalysisInfo>();
 
-	AsmAnalyzer analyzer(
-		*_object.analysisInfo,
-		m_errorReporter,
-		languageToDialect(m_language, m_evmVersion, m_eofVersion),
-		{},
-		_object.qualifiedDataNames()
-	);
+	// Objects are analysed independently of each other and their errors are reported in this order.
+	std::vector<Object*> objects;
+	std::function<void(Object&)> collectObjects = [&](Object& _current) {
+		objects.emplace_back(&_current);
+		for (auto& subNode: _current.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				collectObjects(*subObject);
+	};
+	collectObjects(_object);
 
-	bool success = false;
+	bool success = true;
 	try
 	{
-		success = analyzer.analyze(_object.code()->root());
-		for (auto& subNode: _object.subObjects)
-			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-				if (!analyzeParsed(*subObject))
+		if (m_numThreads <= 1 || objects.size() <= 1)
+		{
+			for (Object* object: objects)
+				if (!analyzeSingleObject(*object, m_errorReporter))
 					success = false;
+		}
+		else
+		{
+			std::vector<std::future<std::pair<bool, ErrorList>>> results;
+			{
+				ThreadPool threadPool(std::min(m_numThreads, objects.size()));
+				for (Object* object: objects)
+					results.emplace_back(threadPool.submit([this, object]() {
+						std::pair<bool, ErrorList> result;
+						ErrorReporter errorReporter(result.second);
+						result.first = analyzeSingleObject(*object, errorReporter);
+						return result;
+					}));
+			}
+			// An exception stops the analysis at the object that threw it, as the sequential order would.
+			for (auto& result: results)
+			{
+				auto [objectSuccess, errors] = result.get();
+				m_errorReporter.append(errors);
+				if (!objectSuccess)
+					success = false;
+			}
+		}
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
@@ -190,6 +218,21 @@ bool YulStack::analyzeParsed(Object& _object)
 	return success;
 }
 
+bool YulStack::analyzeSingleObject(Object& _object, ErrorReporter& _errorReporter) const
+{
+	yulAssert(_object.hasCode());
+	_object.analysisInfo = std::make_shared<AsmAnalysisInfo>();
+
+	AsmAnalyzer analyzer(
+		*_object.analysisInfo,
+		_errorReporter,
+		languageToDialect(m_language, m_evmVersion, m_eofVersion),
+		{},
+		_object.qualifiedDataNames()
+	);
+	return analyzer.analyze(_object.code()->root());
+}
+
 void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 {
 	EVMDialect const* dialect = nullptr;
@@ -204,7 +247,16 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_optimize,
+		m_eofVersion,
+		m_optimiserSettings.useSSACodeTransform,
+		m_optimiserSettings.optimizeCallingConvention,
+		m_optimiserSettings.optimizeFunctionExits
+	);
 }
 
 void YulStack::reparse()
@@ -106,6 +106,10 @@ public:
 	/// @returns the char stream used during parsing
 	langutil::CharStream const& charStream(std::string const& _sourceName) const override;
 
+	/// Sets the number of threads used to analyse and optimize the objects of the input in parallel.
+	/// The errors and the results do not depend on this setting.
+	void setNumThreads(size_t _numThreads) { m_numThreads = _numThreads; }
+
 	/// Runs parsing and analysis steps, returns false if input cannot be assembled.
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
@@ -154,6 +158,8 @@ private:
 	bool parse(std::string const& _sourceName, std::string const& _source);
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
+	/// Analyses the code of @a _object, but not that of its sub-objects, and reports errors to @a _errorReporter.
+	bool analyzeSingleObject(yul::Object& _object, langutil::ErrorReporter& _errorReporter) const;
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
@@ -185,6 +191,7 @@ private:
 	langutil::ErrorReporter m_errorReporter;
 
 	std::shared_ptr<ObjectOptimizer> m_objectOptimizer;
+	size_t m_numThreads = 1;
 };
 
 }
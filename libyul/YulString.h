@@ -23,10 +23,15 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <functional>
 
 namespace solidity::yul
@@ -36,6 +41,11 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository can be used from multiple threads at the same time. Interning is distributed
+/// over independently locked shards selected by a fast lookup hash, while resolving an ID back to
+/// its string does not take any lock. IDs stay valid and stable until the next reset().
+/// The deterministic string hash of the handle is only computed once for every distinct string.
 class YulStringRepository
 {
 public:
@@ -55,22 +65,32 @@ public:
 	{
 		if (_string.empty())
 			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
+		size_t lookup = lookupHash(_string);
+		Shard& shard = m_shards[shardIndex(lookup)];
+		std::lock_guard lock(shard.mutex);
+		auto range = shard.lookupHashToID.equal_range(lookup);
 		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
+			if (idToString(it->second) == _string)
+				return Handle{it->second, idToHash(it->second)};
+		std::uint64_t h = hash(_string);
+		size_t id = storeString(_string, h);
+		shard.lookupHashToID.emplace_hint(range.second, std::make_pair(lookup, id));
 
 		return Handle{id, h};
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
+	std::string const& idToString(size_t _id) const
+	{
+		Chunk const* chunk = m_chunks[_id >> chunkSizeBits].load(std::memory_order_acquire);
+		return *chunk->strings[_id & (chunkSize - 1)];
+	}
 
+	/// FNV hash of the string.
+	/// The hash determines the (deterministic) order of YulStrings and thereby the iteration order
+	/// of many containers used during optimization, so it cannot be replaced without changing the
+	/// generated code. Interning only computes it for strings that are not yet in the repository
+	/// and uses lookupHash() to find existing strings.
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -81,15 +101,18 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
+	/// @returns the number of strings stored since the last reset(), including the empty string.
+	size_t size() const { return m_numStrings.load(std::memory_order_relaxed); }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references and no other thread
+	/// may use the repository concurrently.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
 	static void reset()
 	{
 		for (auto const& cb: resetCallbacks())
 			cb();
-		instance() = YulStringRepository{};
+		instance().clear();
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
@@ -102,11 +125,92 @@ public:
 	};
 
 private:
-	YulStringRepository() = default;
+	static constexpr size_t numShards = 16;
+	static constexpr size_t chunkSizeBits = 14;
+	static constexpr size_t chunkSize = size_t(1) << chunkSizeBits;
+	static constexpr size_t maxChunks = 4096;
+
+	struct Shard
+	{
+		std::unordered_multimap<size_t, size_t> lookupHashToID;
+		std::mutex mutex;
+	};
+	/// Fixed-size block of string slots and their hashes. Chunks are never moved or freed before clear(),
+	/// which makes it possible to read slots without locking while new strings are being added.
+	struct Chunk
+	{
+		std::array<std::unique_ptr<std::string const>, chunkSize> strings;
+		std::array<std::uint64_t, chunkSize> hashes;
+	};
+
+	YulStringRepository() { clear(); }
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	/// Hash used to find strings in the shards. It processes several bytes at a time and, unlike hash(),
+	/// it does not have to be the same across platforms, since it does not affect the order of YulStrings.
+	static size_t lookupHash(std::string const& _string)
+	{
+		return std::hash<std::string_view>{}(_string);
+	}
+
+	/// Folds the upper half of the hash into the lower one, which also works where size_t has 32 bits.
+	static size_t shardIndex(size_t _lookupHash)
+	{
+		return (_lookupHash ^ (_lookupHash >> (sizeof(size_t) * 4))) % numShards;
+	}
+
+	std::uint64_t idToHash(size_t _id) const
+	{
+		Chunk const* chunk = m_chunks[_id >> chunkSizeBits].load(std::memory_order_acquire);
+		return chunk->hashes[_id & (chunkSize - 1)];
+	}
+
+	/// Stores a copy of the string with hash @a _hash under a fresh ID. Must only be called while
+	/// holding the lock of the shard the string belongs to.
+	size_t storeString(std::string const& _string, std::uint64_t _hash)
+	{
+		size_t id = m_numStrings.fetch_add(1, std::memory_order_relaxed);
+		size_t chunkIndex = id >> chunkSizeBits;
+		if (chunkIndex >= maxChunks)
+			throw std::length_error("Too many distinct YulStrings.");
+
+		Chunk* chunk = m_chunks[chunkIndex].load(std::memory_order_acquire);
+		if (!chunk)
+		{
+			std::lock_guard lock(m_chunkAllocationMutex);
+			chunk = m_chunks[chunkIndex].load(std::memory_order_relaxed);
+			if (!chunk)
+			{
+				chunk = m_ownedChunks.emplace_back(std::make_unique<Chunk>()).get();
+				m_chunks[chunkIndex].store(chunk, std::memory_order_release);
+			}
+		}
+		chunk->strings[id & (chunkSize - 1)] = std::make_unique<std::string const>(_string);
+		chunk->hashes[id & (chunkSize - 1)] = _hash;
+		return id;
+	}
+
+	void clear()
+	{
+		for (Shard& shard: m_shards)
+		{
+			std::lock_guard lock(shard.mutex);
+			shard.lookupHashToID.clear();
+		}
+		std::lock_guard lock(m_chunkAllocationMutex);
+		for (std::atomic<Chunk*>& chunk: m_chunks)
+			chunk.store(nullptr, std::memory_order_relaxed);
+		m_ownedChunks.clear();
+
+		// The empty string always has ID zero.
+		Chunk* firstChunk = m_ownedChunks.emplace_back(std::make_unique<Chunk>()).get();
+		firstChunk->strings[0] = std::make_unique<std::string const>();
+		firstChunk->hashes[0] = emptyHash();
+		m_chunks[0].store(firstChunk, std::memory_order_release);
+		m_numStrings.store(1, std::memory_order_relaxed);
+		m_shards[shardIndex(lookupHash({}))].lookupHashToID.emplace(lookupHash({}), 0);
+	}
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -114,8 +218,11 @@ private:
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, numShards> m_shards;
+	std::array<std::atomic<Chunk*>, maxChunks> m_chunks{};
+	std::vector<std::unique_ptr<Chunk>> m_ownedChunks;
+	std::atomic<size_t> m_numStrings = 1;
+	std::mutex m_chunkAllocationMutex;
 };
 
 /// Wrapper around handles into the YulString repository.
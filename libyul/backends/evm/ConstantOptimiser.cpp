@@ -150,27 +150,58 @@ Representation const& RepresentationFinder::findRepresentation(u256 const& _valu
 			continue;
 		if (abs(lowerPart) >= (powerOfTwo >> 8))
 			continue;
-		Representation newRoutine;
-		if (m_dialect.evmVersion().hasBitwiseShifting())
-			newRoutine = represent("shl"_yulname, represent(bits), findRepresentation(upperPart));
+
+		// Most candidates are more expensive than the best representation found so far, so their
+		// costs are computed from the costs of their parts and only the cheaper ones are built.
+		bool const shift = m_dialect.evmVersion().hasBitwiseShifting();
+		Representation const bitsLiteral = represent(bits);
+		Representation const* upperRoutine = nullptr;
+		bigint newCost;
+		if (shift)
+		{
+			upperRoutine = &findRepresentation(upperPart);
+			newCost = m_meter.instructionCosts(evmasm::Instruction::SHL) + bitsLiteral.cost + upperRoutine->cost;
+		}
 		else
 		{
-			newRoutine = represent("exp"_yulname, represent(2), represent(bits));
+			newCost = m_meter.instructionCosts(evmasm::Instruction::EXP) + represent(2).cost + bitsLiteral.cost;
 			if (upperPart != 1)
-				newRoutine = represent("mul"_yulname, findRepresentation(upperPart), newRoutine);
+			{
+				upperRoutine = &findRepresentation(upperPart);
+				newCost += m_meter.instructionCosts(evmasm::Instruction::MUL) + upperRoutine->cost;
+			}
 		}
 
-		if (newRoutine.cost >= routine.cost)
+		if (newCost >= routine.cost)
 			continue;
 
-		if (lowerPart > 0)
-			newRoutine = represent("add"_yulname, newRoutine, findRepresentation(u256(abs(lowerPart))));
-		else if (lowerPart < 0)
-			newRoutine = represent("sub"_yulname, newRoutine, findRepresentation(u256(abs(lowerPart))));
+		Representation const* lowerRoutine = nullptr;
+		if (lowerPart != 0)
+		{
+			lowerRoutine = &findRepresentation(u256(abs(lowerPart)));
+			newCost +=
+				m_meter.instructionCosts(lowerPart > 0 ? evmasm::Instruction::ADD : evmasm::Instruction::SUB) +
+				lowerRoutine->cost;
+		}
 
 		if (m_maxSteps > 0)
 			m_maxSteps--;
-		routine = min(std::move(routine), std::move(newRoutine));
+		if (newCost >= routine.cost)
+			continue;
+
+		Representation newRoutine;
+		if (shift)
+			newRoutine = represent("shl"_yulname, bitsLiteral, *upperRoutine);
+		else
+		{
+			newRoutine = represent("exp"_yulname, represent(2), bitsLiteral);
+			if (upperRoutine)
+				newRoutine = represent("mul"_yulname, *upperRoutine, newRoutine);
+		}
+		if (lowerRoutine)
+			newRoutine = represent(lowerPart > 0 ? "add"_yulname : "sub"_yulname, newRoutine, *lowerRoutine);
+		yulAssert(newRoutine.cost == newCost);
+		routine = std::move(newRoutine);
 	}
 	yulAssert(MiniEVMInterpreter{m_dialect}.eval(*routine.expression) == _value, "Invalid expression generated.");
 	return m_cache[_value] = std::move(routine);
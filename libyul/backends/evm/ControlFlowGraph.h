@@ -29,6 +29,7 @@
 
 #include <libsolutil/Numeric.h>
 
+#include <deque>
 #include <functional>
 #include <list>
 #include <vector>
@@ -228,15 +229,16 @@ struct CFG
 	std::list<Scope::Function const*> functions;
 
 	/// Container for blocks for explicit ownership.
-	std::list<BasicBlock> blocks;
+	/// Uses a deque, s.t. blocks are allocated in chunks, while references to them stay valid.
+	std::deque<BasicBlock> blocks;
 	/// Container for generated variables for explicit ownership.
 	/// Ghost variables are generated to store switch conditions when transforming the control flow
 	/// of a switch to a sequence of conditional jumps.
-	std::list<Scope::Variable> ghostVariables;
+	std::deque<Scope::Variable> ghostVariables;
 	/// Container for generated calls for explicit ownership.
 	/// Ghost calls are used for the equality comparisons of the switch condition ghost variable with
 	/// the switch case literals when transforming the control flow of a switch to a sequence of conditional jumps.
-	std::list<yul::FunctionCall> ghostCalls;
+	std::deque<yul::FunctionCall> ghostCalls;
 
 	BasicBlock& makeBlock(langutil::DebugData::ConstPtr _debugData)
 	{
@@ -31,6 +31,7 @@
 #include <libyul/Utilities.h>
 #include <libyul/backends/evm/AbstractAssembly.h>
 
+#include <mutex>
 #include <regex>
 
 using namespace std::string_literals;
@@ -106,7 +107,7 @@ std::pair<YulName, BuiltinFunctionForEVM> createFunction(
 	return {name, f};
 }
 
-std::set<YulName> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
+std::unordered_set<YulName> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 {
 	// TODO remove this in 0.9.0. We allow creating functions or identifiers in Yul with the name
 	// basefee for VMs before london.
@@ -152,8 +153,8 @@ std::set<YulName> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 			(_instr == evmasm::Instruction::TSTORE || _instr == evmasm::Instruction::TLOAD);
 	};
 
-	std::set<YulName> reserved;
-	for (auto const& instr: evmasm::c_instructions)
+	std::unordered_set<YulName> reserved;
+	for (auto const& instr: evmasm::instructionsByName())
 	{
 		std::string name = toLower(instr.first);
 		if (
@@ -166,18 +167,18 @@ std::set<YulName> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 		)
 			reserved.emplace(name);
 	}
-	reserved += std::vector<YulName>{
+	reserved.insert({
 		"linkersymbol"_yulname,
 		"datasize"_yulname,
 		"dataoffset"_yulname,
 		"datacopy"_yulname,
 		"setimmutable"_yulname,
 		"loadimmutable"_yulname,
-	};
+	});
 	return reserved;
 }
 
-std::map<YulName, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion, bool _objectAccess)
+std::unordered_map<YulName, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion, bool _objectAccess)
 {
 
 	// Exclude prevrandao as builtin for VMs before paris and difficulty for VMs after paris.
@@ -186,8 +187,8 @@ std::map<YulName, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _ev
 		return (_instrName == "prevrandao" && _evmVersion < langutil::EVMVersion::paris()) || (_instrName == "difficulty" && _evmVersion >= langutil::EVMVersion::paris());
 	};
 
-	std::map<YulName, BuiltinFunctionForEVM> builtins;
-	for (auto const& instr: evmasm::c_instructions)
+	std::unordered_map<YulName, BuiltinFunctionForEVM> builtins;
+	for (auto const& instr: evmasm::instructionsByName())
 	{
 		std::string name = toLower(instr.first);
 		auto const opcode = instr.second;
@@ -369,13 +370,15 @@ EVMDialect::EVMDialect(langutil::EVMVersion _evmVersion, std::optional<uint8_t>
 
 BuiltinFunctionForEVM const* EVMDialect::builtin(YulName _name) const
 {
-	if (m_objectAccess)
+	auto it = m_functions.find(_name);
+	if (it == m_functions.end() && m_objectAccess)
 	{
+		std::string const& name = _name.str();
 		std::smatch match;
-		if (regex_match(_name.str(), match, verbatimPattern()))
+		// Checking the prefix first avoids running the regular expression for ordinary identifiers.
+		if (name.compare(0, "verbatim_"s.size(), "verbatim_"s) == 0 && regex_match(name, match, verbatimPattern()))
 			return verbatimFunction(stoul(match[1]), stoul(match[2]));
 	}
-	auto it = m_functions.find(_name);
 	if (it != m_functions.end())
 		return &it->second;
 	else
@@ -393,7 +396,12 @@ bool EVMDialect::reservedIdentifier(YulName _name) const
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
 {
 	static std::map<std::pair<langutil::EVMVersion, std::optional<uint8_t>>, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex dialectsMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		std::lock_guard lock(dialectsMutex);
+		dialects.clear();
+	}};
+	std::lock_guard lock(dialectsMutex);
 	if (!dialects[{_evmVersion, _eofVersion}])
 		dialects[{_evmVersion, _eofVersion}] = std::make_unique<EVMDialect>(_evmVersion, _eofVersion, false);
 	return *dialects[{_evmVersion, _eofVersion}];
@@ -402,7 +410,12 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _evmVers
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
 {
 	static std::map<std::pair<langutil::EVMVersion, std::optional<uint8_t>>, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex dialectsMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		std::lock_guard lock(dialectsMutex);
+		dialects.clear();
+	}};
+	std::lock_guard lock(dialectsMutex);
 	if (!dialects[{_evmVersion, _eofVersion}])
 		dialects[{_evmVersion, _eofVersion}] = std::make_unique<EVMDialect>(_evmVersion, _eofVersion, true);
 	return *dialects[{_evmVersion, _eofVersion}];
@@ -431,6 +444,7 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	std::pair<size_t, size_t> key{_arguments, _returnVariables};
+	std::lock_guard lock(m_verbatimFunctionsMutex);
 	std::shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
@@ -28,7 +28,10 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace solidity::yul
 {
@@ -98,9 +101,10 @@ protected:
 	bool const m_objectAccess;
 	langutil::EVMVersion const m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
-	std::map<YulName, BuiltinFunctionForEVM> m_functions;
+	std::unordered_map<YulName, BuiltinFunctionForEVM> m_functions;
 	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctions;
-	std::set<YulName> m_reserved;
+	std::mutex mutable m_verbatimFunctionsMutex;
+	std::unordered_set<YulName> m_reserved;
 };
 
 }
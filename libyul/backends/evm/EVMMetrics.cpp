@@ -92,7 +92,7 @@ void GasMeterVisitor::operator()(Literal const& _lit)
 	m_dataGas += singleByteDataGas();
 	if (!m_dialect.evmVersion().hasPush0() || _lit.value.value() != u256(0))
 		m_dataGas += evmasm::GasMeter::dataGas(
-			toCompactBigEndian(_lit.value.value(), 1),
+			toCompactBigEndianInline(_lit.value.value(), 1).ref(),
 			m_isCreation,
 			m_dialect.evmVersion()
 		);
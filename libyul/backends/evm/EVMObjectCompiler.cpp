@@ -23,7 +23,10 @@
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/NoOutputAssembly.h>
 #include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/SSAEVMCodeTransform.h>
 
 #include <libyul/optimiser/FunctionCallFinder.h>
 
@@ -34,16 +37,27 @@
 
 using namespace solidity::yul;
 
-void EVMObjectCompiler::compile(
+bool EVMObjectCompiler::compile(
 	Object const& _object,
 	AbstractAssembly& _assembly,
 	EVMDialect const& _dialect,
 	bool _optimize,
-	std::optional<uint8_t> _eofVersion
+	std::optional<uint8_t> _eofVersion,
+	bool _useSSACodeTransform,
+	bool _optimizeCallingConvention,
+	bool _optimizeFunctionExits
 )
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion);
+	EVMObjectCompiler compiler(
+		_assembly,
+		_dialect,
+		_eofVersion,
+		_useSSACodeTransform,
+		_optimizeCallingConvention,
+		_optimizeFunctionExits
+	);
 	compiler.run(_object, _optimize);
+	return compiler.m_usedSSACodeTransformOnly;
 }
 
 void EVMObjectCompiler::run(Object const& _object, bool _optimize)
@@ -59,7 +73,17 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name);
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion);
+			if (!compile(
+				*subObject,
+				*subAssemblyAndID.first,
+				m_dialect,
+				_optimize,
+				m_eofVersion,
+				m_useSSACodeTransform,
+				m_optimizeCallingConvention,
+				m_optimizeFunctionExits
+			))
+				m_usedSSACodeTransformOnly = false;
 		}
 		else
 		{
@@ -78,6 +102,16 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			_optimize && (m_dialect.evmVersion() >= langutil::EVMVersion::prague()),
 			"Experimental EOF support is only available for optimized via-IR compilation and the most recent EVM version."
 		);
+	if (
+		_optimize &&
+		m_dialect.evmVersion().canOverchargeGasForCall() &&
+		m_useSSACodeTransform &&
+		!m_eofVersion.has_value() &&
+		runSSACodeTransform(_object, context)
+	)
+		return;
+	m_usedSSACodeTransformOnly = false;
+
 	if (_optimize && m_dialect.evmVersion().canOverchargeGasForCall())
 	{
 		auto stackErrors = OptimizedEVMCodeTransform::run(
@@ -86,7 +120,9 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			_object.code()->root(),
 			m_dialect,
 			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName,
+			m_optimizeCallingConvention,
+			m_optimizeFunctionExits
 		);
 		if (!stackErrors.empty())
 		{
@@ -125,3 +161,38 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			BOOST_THROW_EXCEPTION(transform.stackErrors().front());
 	}
 }
+
+bool EVMObjectCompiler::runSSACodeTransform(Object const& _object, BuiltinContext& _context)
+{
+	// The control flow graph and its liveness are shared between the dry run and the actual code generation.
+	std::unique_ptr<ControlFlow> controlFlow = SSAControlFlowGraphBuilder::build(
+		*_object.analysisInfo,
+		m_dialect,
+		_object.code()->root()
+	);
+	ControlFlowLiveness liveness(*controlFlow);
+
+	// Since code cannot be removed from an assembly, perform a dry run first.
+	{
+		NoOutputAssembly dryRunAssembly{m_dialect.evmVersion()};
+		BuiltinContext dryRunContext = _context;
+		if (!SSAEVMCodeTransform::run(
+			dryRunAssembly,
+			*controlFlow,
+			liveness,
+			dryRunContext,
+			SSAEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+		).empty())
+			return false;
+	}
+
+	auto stackErrors = SSAEVMCodeTransform::run(
+		m_assembly,
+		*controlFlow,
+		liveness,
+		_context,
+		SSAEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+	);
+	yulAssert(stackErrors.empty(), "Stack errors in SSA code transform despite successful dry run.");
+	return true;
+}
@@ -28,28 +28,61 @@ namespace solidity::yul
 {
 struct Object;
 class AbstractAssembly;
+struct BuiltinContext;
 struct EVMDialect;
 
 class EVMObjectCompiler
 {
 public:
-	static void compile(
+	/// @param _useSSACodeTransform if true and @a _optimize is set, code is generated from the SSA control
+	/// flow graph (using @a SSAEVMCodeTransform), falling back to @a OptimizedEVMCodeTransform for objects
+	/// that run into stack too deep errors. EOF is not supported by the SSA code transform.
+	/// @param _optimizeCallingConvention if true and @a _optimize is set, @a OptimizedEVMCodeTransform chooses
+	/// for each function whether its return label is pushed before or after its arguments.
+	/// @param _optimizeFunctionExits if true and @a _optimize is set, @a OptimizedEVMCodeTransform lowers calls
+	/// whose results are directly returned to tail calls and shares identical function exits.
+	/// @returns true if the code of @a _object and all its sub-objects was generated by @a SSAEVMCodeTransform.
+	static bool compile(
 		Object const& _object,
 		AbstractAssembly& _assembly,
 		EVMDialect const& _dialect,
 		bool _optimize,
-		std::optional<uint8_t> _eofVersion
+		std::optional<uint8_t> _eofVersion,
+		bool _useSSACodeTransform = false,
+		bool _optimizeCallingConvention = false,
+		bool _optimizeFunctionExits = false
 	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, std::optional<uint8_t> _eofVersion):
-		m_assembly(_assembly), m_dialect(_dialect), m_eofVersion(_eofVersion)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		std::optional<uint8_t> _eofVersion,
+		bool _useSSACodeTransform,
+		bool _optimizeCallingConvention,
+		bool _optimizeFunctionExits
+	):
+		m_assembly(_assembly),
+		m_dialect(_dialect),
+		m_eofVersion(_eofVersion),
+		m_useSSACodeTransform(_useSSACodeTransform),
+		m_optimizeCallingConvention(_optimizeCallingConvention),
+		m_optimizeFunctionExits(_optimizeFunctionExits)
 	{}
 
+	/// Generates the code of @a _object using @a SSAEVMCodeTransform, if this does not result in stack errors.
+	/// @returns false (without generating any code) otherwise.
+	bool runSSACodeTransform(Object const& _object, BuiltinContext& _context);
+
 	void run(Object const& _object, bool _optimize);
 
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	std::optional<uint8_t> m_eofVersion;
+	bool m_useSSACodeTransform = false;
+	bool m_optimizeCallingConvention = false;
+	bool m_optimizeFunctionExits = false;
+	/// Cleared as soon as the code of one object is not generated by @a SSAEVMCodeTransform.
+	bool m_usedSSACodeTransformOnly = true;
 };
 
 }
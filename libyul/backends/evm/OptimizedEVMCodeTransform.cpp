@@ -29,6 +29,7 @@
 #include <libsolutil/cxx20.h>
 
 #include <range/v3/view/drop.hpp>
+#include <range/v3/view/drop_last.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/iota.hpp>
@@ -45,23 +46,38 @@ std::vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 	Block const& _block,
 	EVMDialect const& _dialect,
 	BuiltinContext& _builtinContext,
-	UseNamedLabels _useNamedLabelsForFunctions
+	UseNamedLabels _useNamedLabelsForFunctions,
+	bool _optimizeCallingConvention,
+	bool _optimizeFunctionExits
 )
 {
 	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
-	StackLayout stackLayout = StackLayoutGenerator::run(*dfg);
+	StackLayout stackLayout = StackLayoutGenerator::run(*dfg, false, _optimizeCallingConvention);
+	return run(_assembly, *dfg, stackLayout, _builtinContext, _useNamedLabelsForFunctions, _optimizeFunctionExits);
+}
+
+std::vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
+	AbstractAssembly& _assembly,
+	CFG const& _dfg,
+	StackLayout const& _stackLayout,
+	BuiltinContext& _builtinContext,
+	UseNamedLabels _useNamedLabelsForFunctions,
+	bool _optimizeFunctionExits
+)
+{
 	OptimizedEVMCodeTransform optimizedCodeTransform(
 		_assembly,
 		_builtinContext,
 		_useNamedLabelsForFunctions,
-		*dfg,
-		stackLayout
+		_dfg,
+		_stackLayout,
+		_optimizeFunctionExits
 	);
 	// Create initial entry layout.
-	optimizedCodeTransform.createStackLayout(debugDataOf(*dfg->entry), stackLayout.blockInfos.at(dfg->entry).entryLayout);
-	optimizedCodeTransform(*dfg->entry);
-	for (Scope::Function const* function: dfg->functions)
-		optimizedCodeTransform(dfg->functionInfo.at(function));
+	optimizedCodeTransform.createStackLayout(debugDataOf(*_dfg.entry), _stackLayout.blockInfos.at(_dfg.entry).entryLayout);
+	optimizedCodeTransform(*_dfg.entry);
+	for (Scope::Function const* function: _dfg.functions)
+		optimizedCodeTransform(_dfg.functionInfo.at(function));
 	return std::move(optimizedCodeTransform.m_stackErrors);
 }
 
@@ -71,16 +87,23 @@ void OptimizedEVMCodeTransform::operator()(CFG::FunctionCall const& _call)
 	{
 		yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
 		yulAssert(m_stack.size() >= _call.function.get().numArguments + (_call.canContinue ? 1 : 0), "");
+		// The return label is either pushed before or after the arguments, depending on the calling convention.
+		bool const returnLabelAfterArguments =
+			_call.canContinue && m_stackLayout.returnLabelAfterArguments.count(&_call.function.get());
 		// Assert that we got the correct arguments on stack for the call.
 		for (auto&& [arg, slot]: ranges::zip_view(
 			_call.functionCall.get().arguments | ranges::views::reverse,
-			m_stack | ranges::views::take_last(_call.functionCall.get().arguments.size())
+			m_stack |
+				ranges::views::drop_last(returnLabelAfterArguments ? 1 : 0) |
+				ranges::views::take_last(_call.functionCall.get().arguments.size())
 		))
 			validateSlot(slot, arg);
 		// Assert that we got the correct return label on stack.
 		if (_call.canContinue)
 		{
 			auto const* returnLabelSlot = std::get_if<FunctionCallReturnLabelSlot>(
+				returnLabelAfterArguments ?
+				&m_stack.back() :
 				&m_stack.at(m_stack.size() - _call.functionCall.get().arguments.size() - 1)
 			);
 			yulAssert(returnLabelSlot && &returnLabelSlot->call.get() == &_call.functionCall.get(), "");
@@ -177,7 +200,8 @@ OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
 	BuiltinContext& _builtinContext,
 	UseNamedLabels _useNamedLabelsForFunctions,
 	CFG const& _dfg,
-	StackLayout const& _stackLayout
+	StackLayout const& _stackLayout,
+	bool _optimizeFunctionExits
 ):
 	m_assembly(_assembly),
 	m_builtinContext(_builtinContext),
@@ -203,7 +227,8 @@ OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
 				m_assembly.newLabelId();
 		}
 		return functionLabels;
-	}())
+	}()),
+	m_optimizeFunctionExits(_optimizeFunctionExits)
 {
 }
 
@@ -366,6 +391,81 @@ void OptimizedEVMCodeTransform::createStackLayout(langutil::DebugData::ConstPtr
 	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
 }
 
+std::optional<size_t> OptimizedEVMCodeTransform::shuffleCosts(Stack _source, Stack const& _target)
+{
+	size_t costs = 0;
+	bool valid = true;
+	::createStackLayout(
+		_source,
+		_target,
+		[&](unsigned _i)
+		{
+			++costs;
+			if (_i > 16)
+				valid = false;
+		},
+		[&](StackSlot const& _slot)
+		{
+			++costs;
+			auto depth = util::findOffset(_source | ranges::views::reverse, _slot);
+			if (depth ? (*depth >= 16 && !canBeFreelyGenerated(_slot)) : std::holds_alternative<FunctionReturnLabelSlot>(_slot))
+				valid = false;
+		},
+		[&]() { ++costs; }
+	);
+	if (!valid)
+		return std::nullopt;
+	return costs;
+}
+
+std::optional<Stack> OptimizedEVMCodeTransform::tailCallLayout(CFG::BasicBlock const& _block, size_t _operationIndex) const
+{
+	if (!m_currentFunctionInfo || !std::holds_alternative<CFG::BasicBlock::FunctionReturn>(_block.exit))
+		return std::nullopt;
+
+	CFG::Operation const& operation = _block.operations.at(_operationIndex);
+	auto const* call = std::get_if<CFG::FunctionCall>(&operation.operation);
+	if (
+		!call ||
+		!call->canContinue ||
+		call->function.get().numReturns != m_currentFunctionInfo->returnVariables.size()
+	)
+		return std::nullopt;
+	// The return label of the call may already have been pushed while creating an earlier layout.
+	if (m_returnLabels.count(&call->functionCall.get()))
+		return std::nullopt;
+
+	// The results of the call have to be returned unchanged, i.e. the call is either the last operation of
+	// the block or only followed by assigning its results to the return variables in order.
+	size_t remainingOperations = _block.operations.size() - _operationIndex - 1;
+	if (remainingOperations == 0)
+	{
+		if (call->function.get().numReturns != 0)
+			return std::nullopt;
+	}
+	else if (remainingOperations == 1)
+	{
+		CFG::Operation const& nextOperation = _block.operations.back();
+		auto const* assignment = std::get_if<CFG::Assignment>(&nextOperation.operation);
+		if (
+			!assignment ||
+			nextOperation.input != operation.output ||
+			assignment->variables != m_currentFunctionInfo->returnVariables
+		)
+			return std::nullopt;
+	}
+	else
+		return std::nullopt;
+
+	Stack layout = m_stackLayout.operationInput(operation);
+	for (StackSlot& slot: layout)
+		if (std::holds_alternative<FunctionCallReturnLabelSlot>(slot))
+			slot = FunctionReturnLabelSlot{m_currentFunctionInfo->function};
+	if (!shuffleCosts(m_stack, layout))
+		return std::nullopt;
+	return layout;
+}
+
 void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 {
 	// Assert that this is the first visit of the block and mark as generated.
@@ -383,8 +483,26 @@ void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 	if (auto label = util::valueOrNullptr(m_blockLabels, &_block))
 		m_assembly.appendLabel(*label);
 
-	for (auto const& operation: _block.operations)
+	for (auto&& [operationIndex, operation]: _block.operations | ranges::views::enumerate)
 	{
+		// Jump directly to the callee with the return label of the current function, if the call results
+		// are returned unchanged. The remaining operations and the exit of the block are skipped.
+		if (m_optimizeFunctionExits)
+			if (std::optional<Stack> tailCallStack = tailCallLayout(_block, operationIndex))
+			{
+				CFG::FunctionCall const& call = std::get<CFG::FunctionCall>(operation.operation);
+				createStackLayout(debugDataOf(call), *tailCallStack);
+				yulAssert(m_stack == *tailCallStack);
+				m_assembly.setSourceLocation(originLocationOf(call));
+				m_assembly.appendJumpTo(
+					getFunctionLabel(call.function),
+					static_cast<int>(call.function.get().numReturns) - static_cast<int>(call.function.get().numArguments) - 1
+				);
+				m_stack.clear();
+				m_assembly.setStackHeight(0);
+				return;
+			}
+
 		// Create required layout for entering the operation.
 		createStackLayout(debugDataOf(operation.operation), m_stackLayout.operationEntryLayout.at(&operation));
 
@@ -394,7 +512,7 @@ void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 		size_t baseHeight = m_stack.size() - operation.input.size();
 		assertLayoutCompatibility(
 			m_stack | ranges::views::take_last(operation.input.size()) | ranges::to<Stack>,
-			operation.input
+			m_stackLayout.operationInput(operation)
 		);
 
 		// Perform the operation.
@@ -495,6 +613,24 @@ void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 			}) | ranges::to<Stack>;
 			exitStack.emplace_back(FunctionReturnLabelSlot{_functionReturn.info->function});
 
+			// Share the shuffling code of exits starting from the same layout. Sharing is only worthwhile, if
+			// the shuffling is longer than the jump to the shared exit (PUSH tag, JUMP) plus its JUMPDEST.
+			if (m_optimizeFunctionExits)
+			{
+				static size_t constexpr minSharedShuffleCosts = 5;
+				if (auto const* exitLabel = util::valueOrNullptr(m_functionExits, m_stack))
+				{
+					m_assembly.appendJumpTo(*exitLabel);
+					return;
+				}
+				if (auto costs = shuffleCosts(m_stack, exitStack); costs && *costs >= minSharedShuffleCosts)
+				{
+					AbstractAssembly::LabelID exitLabel = m_assembly.newLabelId();
+					m_functionExits[m_stack] = exitLabel;
+					m_assembly.appendLabel(exitLabel);
+				}
+			}
+
 			// Create the function return layout and jump.
 			createStackLayout(debugDataOf(_functionReturn), exitStack);
 			m_assembly.appendJump(0, AbstractAssembly::JumpType::OutOfFunction);
@@ -520,14 +656,12 @@ void OptimizedEVMCodeTransform::operator()(CFG::FunctionInfo const& _functionInf
 {
 	yulAssert(!m_currentFunctionInfo, "");
 	ScopedSaveAndRestore currentFunctionInfoRestore(m_currentFunctionInfo, &_functionInfo);
+	m_functionExits.clear();
 
 	yulAssert(m_stack.empty() && m_assembly.stackHeight() == 0, "");
 
 	// Create function entry layout in m_stack.
-	if (_functionInfo.canContinue)
-		m_stack.emplace_back(FunctionReturnLabelSlot{_functionInfo.function});
-	for (auto const& param: _functionInfo.parameters | ranges::views::reverse)
-		m_stack.emplace_back(param);
+	m_stack = m_stackLayout.functionEntryLayout(_functionInfo);
 	m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
 
 	m_assembly.setSourceLocation(originLocationOf(_functionInfo));
@@ -47,13 +47,29 @@ public:
 	/// 2) For none of the functions 3) for the first function of each name.
 	enum class UseNamedLabels { YesAndForceUnique, Never, ForFirstFunctionOfEachName };
 
+	/// @param _optimizeCallingConvention if true, the calling convention of each function, i.e. whether its return
+	/// label is pushed before or after its arguments, is chosen to reduce stack shuffling.
+	/// @param _optimizeFunctionExits if true, calls whose results are directly returned jump to the callee with the
+	/// return label of the calling function (tail calls) and function exits requiring the same shuffling share it.
 	[[nodiscard]] static std::vector<StackTooDeepError> run(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
 		Block const& _block,
 		EVMDialect const& _dialect,
 		BuiltinContext& _builtinContext,
-		UseNamedLabels _useNamedLabelsForFunctions
+		UseNamedLabels _useNamedLabelsForFunctions,
+		bool _optimizeCallingConvention = false,
+		bool _optimizeFunctionExits = false
+	);
+	/// Generates code for a control flow graph @a _dfg with stack layout @a _stackLayout that was already built,
+	/// s.t. both can be shared with other consumers.
+	[[nodiscard]] static std::vector<StackTooDeepError> run(
+		AbstractAssembly& _assembly,
+		CFG const& _dfg,
+		StackLayout const& _stackLayout,
+		BuiltinContext& _builtinContext,
+		UseNamedLabels _useNamedLabelsForFunctions,
+		bool _optimizeFunctionExits = false
 	);
 
 	/// Generate code for the function call @a _call. Only public for using with std::visit.
@@ -68,7 +84,8 @@ private:
 		BuiltinContext& _builtinContext,
 		UseNamedLabels _useNamedLabelsForFunctions,
 		CFG const& _dfg,
-		StackLayout const& _stackLayout
+		StackLayout const& _stackLayout,
+		bool _optimizeFunctionExits
 	);
 
 	/// Assert that it is valid to transition from @a _currentStack to @a _desiredStack.
@@ -84,6 +101,13 @@ private:
 	/// Shuffles m_stack to the desired @a _targetStack while emitting the shuffling code to m_assembly.
 	/// Sets the source locations to the one in @a _debugData.
 	void createStackLayout(langutil::DebugData::ConstPtr _debugData, Stack _targetStack);
+	/// @returns the number of shuffling operations required to transform @a _source to @a _target or
+	/// std::nullopt, if this would result in a stack too deep error.
+	static std::optional<size_t> shuffleCosts(Stack _source, Stack const& _target);
+	/// @returns the stack layout for performing the operation at @a _operationIndex in @a _block as tail call,
+	/// i.e. the layout expected by the callee with the return label of the current function in place of a fresh
+	/// return label, or std::nullopt if the operation cannot be performed as tail call from the current m_stack.
+	std::optional<Stack> tailCallLayout(CFG::BasicBlock const& _block, size_t _operationIndex) const;
 
 	/// Generate code for the given block @a _block.
 	/// Expects the current stack layout m_stack to be a stack layout that is compatible with the
@@ -110,6 +134,10 @@ private:
 	std::set<CFG::BasicBlock const*> m_generated;
 	CFG::FunctionInfo const* m_currentFunctionInfo = nullptr;
 	std::vector<StackTooDeepError> m_stackErrors;
+	bool const m_optimizeFunctionExits = false;
+	/// Labels of the already generated function exits by the stack layout they start from.
+	/// Only used, if m_optimizeFunctionExits is set. Reset for each function.
+	std::map<Stack, AbstractAssembly::LabelID> m_functionExits;
 };
 
 }
@@ -0,0 +1,173 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libyul/backends/evm/SSACFGTopologicalSort.h>
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+enum class SSACFGDataFlowDirection { Forward, Backward };
+enum class SSACFGDataFlowMeet { Union, Intersection };
+
+/// Facts of a dataflow problem, e.g. a set of values indexed by SSACFG::ValueId.
+using SSACFGDataFlowFacts = boost::dynamic_bitset<>;
+
+/// Solves dataflow problems over the blocks of an SSA CFG whose facts are bit vectors.
+///
+/// The problem type has to provide
+///  - ``static constexpr SSACFGDataFlowDirection direction``, the direction facts are propagated in,
+///  - ``static constexpr SSACFGDataFlowMeet meet``, i.e. whether the facts of several incoming edges
+///    are united (e.g. liveness) or intersected (e.g. available expressions),
+///  - ``size_t numBits() const``, the size of the bit vectors,
+///  - ``void boundary(SSACFG::BlockId, SSACFGDataFlowFacts&) const``, which sets the facts flowing
+///    into the entry block for forward problems or out of blocks without successors for backward
+///    problems,
+///  - ``void transfer(SSACFG::BlockId, SSACFGDataFlowFacts&) const``, which transforms the facts at one
+///    end of a block into the facts at its other end in propagation direction,
+///  - ``void transferEdge(SSACFG::BlockId _from, SSACFG::BlockId _to, SSACFGDataFlowFacts&) const``,
+///    which transforms the facts flowing along the edge from @a _from to @a _to, e.g. to account for
+///    phi functions. For backward problems, the facts at the entry of @a _to are transformed into
+///    facts at the exit of @a _from.
+///
+/// Blocks are processed from a worklist in reverse post-order (post-order for backward problems), so
+/// acyclic graphs are solved in a single pass and loops only require few additional passes.
+/// Blocks that are not reachable from the entry are not analyzed.
+/// Facts at individual operations can be obtained by applying the transfer function of the problem
+/// operation by operation to the facts at the ends of a block.
+template<typename Problem>
+class SSACFGDataFlowAnalysis
+{
+public:
+	SSACFGDataFlowAnalysis(ForwardSSACFGTopologicalSort const& _topologicalSort, Problem const& _problem);
+
+	/// @returns the facts at the start of a block, in program order.
+	SSACFGDataFlowFacts const& atEntry(SSACFG::BlockId _block) const { return m_atEntry.at(_block.value); }
+	/// @returns the facts at the end of a block, in program order.
+	SSACFGDataFlowFacts const& atExit(SSACFG::BlockId _block) const { return m_atExit.at(_block.value); }
+
+private:
+	std::vector<SSACFGDataFlowFacts> m_atEntry;
+	std::vector<SSACFGDataFlowFacts> m_atExit;
+};
+
+template<typename Problem>
+SSACFGDataFlowAnalysis<Problem>::SSACFGDataFlowAnalysis(
+	ForwardSSACFGTopologicalSort const& _topologicalSort,
+	Problem const& _problem
+)
+{
+	constexpr bool forward = Problem::direction == SSACFGDataFlowDirection::Forward;
+	constexpr bool intersect = Problem::meet == SSACFGDataFlowMeet::Intersection;
+	constexpr size_t unreachable = std::numeric_limits<size_t>::max();
+	SSACFG const& cfg = _topologicalSort.cfg();
+	size_t const numBits = _problem.numBits();
+
+	// Start from the neutral element of the meet, so that edges that were not processed yet do not matter.
+	SSACFGDataFlowFacts top(numBits);
+	if constexpr (intersect)
+		top.set();
+	m_atEntry.assign(cfg.numBlocks(), top);
+	m_atExit.assign(cfg.numBlocks(), top);
+
+	std::vector<size_t> order = _topologicalSort.postOrder();
+	if constexpr (forward)
+		std::reverse(order.begin(), order.end());
+	std::vector<size_t> position(cfg.numBlocks(), unreachable);
+	for (size_t index = 0; index < order.size(); ++index)
+		position[order[index]] = index;
+
+	std::set<size_t> worklist;
+	for (size_t index = 0; index < order.size(); ++index)
+		worklist.insert(worklist.end(), index);
+	auto schedule = [&](SSACFG::BlockId const& _block) {
+		if (position[_block.value] != unreachable)
+			worklist.insert(position[_block.value]);
+	};
+
+	while (!worklist.empty())
+	{
+		SSACFG::BlockId const blockId{order[*worklist.begin()]};
+		worklist.erase(worklist.begin());
+		SSACFG::BasicBlock const& block = cfg.block(blockId);
+
+		std::optional<SSACFGDataFlowFacts> incoming;
+		auto meetWith = [&](SSACFGDataFlowFacts const& _facts) {
+			if (!incoming)
+				incoming = _facts;
+			else if constexpr (intersect)
+				*incoming &= _facts;
+			else
+				*incoming |= _facts;
+		};
+		auto meetWithEdge = [&](SSACFG::BlockId const& _from, SSACFG::BlockId const& _to, SSACFGDataFlowFacts _facts) {
+			_problem.transferEdge(_from, _to, _facts);
+			meetWith(_facts);
+		};
+		auto meetWithBoundary = [&]() {
+			SSACFGDataFlowFacts boundary(numBits);
+			_problem.boundary(blockId, boundary);
+			meetWith(boundary);
+		};
+		if constexpr (forward)
+		{
+			if (blockId == cfg.entry)
+				meetWithBoundary();
+			for (SSACFG::BlockId const& predecessor: block.entries)
+				if (position[predecessor.value] != unreachable)
+					meetWithEdge(predecessor, blockId, m_atExit[predecessor.value]);
+		}
+		else
+		{
+			block.forEachExit([&](SSACFG::BlockId const& _successor) {
+				meetWithEdge(blockId, _successor, m_atEntry[_successor.value]);
+			});
+			if (!incoming)
+				meetWithBoundary();
+		}
+		yulAssert(incoming);
+
+		SSACFGDataFlowFacts& in = forward ? m_atEntry[blockId.value] : m_atExit[blockId.value];
+		SSACFGDataFlowFacts& out = forward ? m_atExit[blockId.value] : m_atEntry[blockId.value];
+		in = std::move(*incoming);
+		SSACFGDataFlowFacts result = in;
+		_problem.transfer(blockId, result);
+		if (result == out)
+			continue;
+		out = std::move(result);
+
+		if constexpr (forward)
+			block.forEachExit(schedule);
+		else
+			for (SSACFG::BlockId const& predecessor: block.entries)
+				schedule(predecessor);
+	}
+}
+
+}
@@ -170,6 +170,8 @@ public:
 	{
 		return m_valueInfos.at(_var.value);
 	}
+	/// @returns the number of values, i.e. an upper bound for the ids of all values.
+	size_t numValues() const { return m_valueInfos.size(); }
 	ValueId newPhi(BlockId const _definingBlock)
 	{
 		ValueId id { m_valueInfos.size() };
@@ -0,0 +1,531 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/SSAEVMCodeTransform.h>
+
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/StackHelpers.h>
+
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/view/reverse.hpp>
+#include <range/v3/view/take_last.hpp>
+#include <range/v3/view/zip.hpp>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+std::vector<StackTooDeepError> SSAEVMCodeTransform::run(
+	AbstractAssembly& _assembly,
+	AsmAnalysisInfo& _analysisInfo,
+	Block const& _block,
+	EVMDialect const& _dialect,
+	BuiltinContext& _builtinContext,
+	UseNamedLabels _useNamedLabelsForFunctions
+)
+{
+	std::unique_ptr<ControlFlow> controlFlow = SSAControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
+	ControlFlowLiveness liveness(*controlFlow);
+	return run(_assembly, *controlFlow, liveness, _builtinContext, _useNamedLabelsForFunctions);
+}
+
+std::vector<StackTooDeepError> SSAEVMCodeTransform::run(
+	AbstractAssembly& _assembly,
+	ControlFlow const& _controlFlow,
+	ControlFlowLiveness const& _liveness,
+	BuiltinContext& _builtinContext,
+	UseNamedLabels _useNamedLabelsForFunctions
+)
+{
+	yulAssert(&_liveness.controlFlow.get() == &_controlFlow);
+	SSAEVMCodeTransform codeTransform(_assembly, _builtinContext, _controlFlow, _useNamedLabelsForFunctions);
+	codeTransform(*_controlFlow.mainGraph, *_liveness.mainLiveness);
+	for (auto&& [functionGraph, functionLiveness]: ranges::zip_view(_controlFlow.functionGraphs, _liveness.functionLiveness))
+		codeTransform(*functionGraph, *functionLiveness);
+	return std::move(codeTransform.m_stackErrors);
+}
+
+SSAEVMCodeTransform::SSAEVMCodeTransform(
+	AbstractAssembly& _assembly,
+	BuiltinContext& _builtinContext,
+	ControlFlow const& _controlFlow,
+	UseNamedLabels _useNamedLabelsForFunctions
+):
+	m_assembly(_assembly),
+	m_builtinContext(_builtinContext),
+	m_controlFlow(_controlFlow),
+	m_functionLabels([&](){
+		std::map<Scope::Function const*, AbstractAssembly::LabelID> functionLabels;
+		std::set<YulName> assignedFunctionNames;
+		for (auto const& functionGraph: m_controlFlow.functionGraphs)
+		{
+			Scope::Function const* function = functionGraph->function;
+			yulAssert(function);
+			bool nameAlreadySeen = !assignedFunctionNames.insert(function->name).second;
+			if (_useNamedLabelsForFunctions == UseNamedLabels::YesAndForceUnique)
+				yulAssert(!nameAlreadySeen);
+			bool useNamedLabel = _useNamedLabelsForFunctions != UseNamedLabels::Never && !nameAlreadySeen;
+			functionLabels[function] = useNamedLabel ?
+				m_assembly.namedLabel(
+					function->name.str(),
+					function->numArguments,
+					function->numReturns,
+					functionGraph->debugData ? functionGraph->debugData->astID : std::nullopt
+				) :
+				m_assembly.newLabelId();
+		}
+		return functionLabels;
+	}())
+{
+}
+
+void SSAEVMCodeTransform::operator()(SSACFG const& _cfg, SSACFGLiveness const& _liveness)
+{
+	m_cfg = &_cfg;
+	m_liveness = &_liveness;
+	m_valueVariables.clear();
+	m_variableValues.clear();
+	m_entryLayouts.assign(_cfg.numBlocks(), std::nullopt);
+	m_blockLabels.assign(_cfg.numBlocks(), std::nullopt);
+	m_generated.assign(_cfg.numBlocks(), false);
+
+	yulAssert(m_stack.empty() && m_assembly.stackHeight() == 0);
+	if (_cfg.function)
+	{
+		// Function entry layout: the return label, if any, followed by the arguments in reverse order,
+		// i.e. the first argument is on top.
+		if (_cfg.canContinue)
+			m_stack.emplace_back(FunctionReturnLabelSlot{*_cfg.function});
+		for (auto const& [variable, value]: _cfg.arguments | ranges::views::reverse)
+			m_stack.emplace_back(slotOf(value));
+		m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+		m_assembly.setSourceLocation(originLocationOf(_cfg));
+		m_assembly.appendLabel(m_functionLabels.at(_cfg.function));
+	}
+	yulAssert(_cfg.block(_cfg.entry).entries.empty());
+	m_entryLayouts[_cfg.entry.value] = m_stack;
+	(*this)(_cfg.entry);
+
+	m_stack.clear();
+	m_assembly.setStackHeight(0);
+	m_cfg = nullptr;
+	m_liveness = nullptr;
+}
+
+void SSAEVMCodeTransform::operator()(SSACFG::BlockId _blockId)
+{
+	yulAssert(!m_generated[_blockId.value]);
+	m_generated[_blockId.value] = true;
+
+	SSACFG::BasicBlock const& block = m_cfg->block(_blockId);
+	m_assembly.setSourceLocation(originLocationOf(block));
+
+	// Assert that the stack is valid for entering the block.
+	yulAssert(m_entryLayouts[_blockId.value]);
+	Stack const& entryLayout = *m_entryLayouts[_blockId.value];
+	yulAssert(m_stack.size() == entryLayout.size());
+	for (auto&& [currentSlot, entrySlot]: ranges::zip_view(m_stack, entryLayout))
+		yulAssert(std::holds_alternative<JunkSlot>(entrySlot) || currentSlot == entrySlot);
+	m_stack = entryLayout;
+	yulAssert(static_cast<int>(m_stack.size()) == m_assembly.stackHeight());
+
+	if (m_blockLabels[_blockId.value])
+		m_assembly.appendLabel(*m_blockLabels[_blockId.value]);
+
+	for (auto&& [operation, liveOut]: ranges::zip_view(block.operations, m_liveness->operationsLiveOut(_blockId)))
+	{
+		// Keep everything that is needed after the operation below its inputs. Inputs that are not live
+		// afterwards are thereby moved instead of copied.
+		Stack targetStack = liveSlots(m_stack, liveOut);
+		if (auto const* call = std::get_if<SSACFG::Call>(&operation.kind); call && call->canContinue)
+			targetStack.emplace_back(FunctionCallReturnLabelSlot{call->call.get()});
+		for (SSACFG::ValueId input: operation.inputs)
+			targetStack.emplace_back(slotOf(input));
+		createStackLayout(debugDataOf(operation.kind), std::move(targetStack));
+
+		(*this)(operation);
+	}
+
+	m_assembly.setSourceLocation(originLocationOf(block));
+	std::visit(util::GenericVisitor{
+		[&](SSACFG::BasicBlock::MainExit const&)
+		{
+			m_assembly.appendInstruction(evmasm::Instruction::STOP);
+		},
+		[&](SSACFG::BasicBlock::Jump const& _jump)
+		{
+			transition(_jump.debugData, _blockId, _jump.target);
+		},
+		[&](SSACFG::BasicBlock::ConditionalJump const& _conditionalJump)
+		{
+			yulAssert(_conditionalJump.nonZero != _conditionalJump.zero);
+			Stack targetStack = liveSlots(m_stack, m_liveness->liveOut(_blockId));
+			targetStack.emplace_back(slotOf(_conditionalJump.condition));
+			createStackLayout(_conditionalJump.debugData, std::move(targetStack));
+			m_stack.pop_back();
+
+			// If the non-zero target has no other entry, it directly takes over the current stack.
+			// Otherwise, jump to a separate piece of code that shuffles for the edge first.
+			SSACFG::BasicBlock const& nonZero = m_cfg->block(_conditionalJump.nonZero);
+			bool jumpDirectly =
+				!m_entryLayouts[_conditionalJump.nonZero.value] &&
+				nonZero.entries.size() == 1 &&
+				nonZero.phis.empty();
+			AbstractAssembly::LabelID nonZeroLabel = m_assembly.newLabelId();
+			if (jumpDirectly)
+			{
+				Stack entryLayout = m_stack;
+				auto const& liveIn = m_liveness->liveIn(_conditionalJump.nonZero);
+				for (auto& slot: entryLayout)
+					if (auto value = valueOf(slot); value && !liveIn.count(*value))
+						slot = JunkSlot{};
+				m_entryLayouts[_conditionalJump.nonZero.value] = std::move(entryLayout);
+				m_blockLabels[_conditionalJump.nonZero.value] = nonZeroLabel;
+			}
+			m_assembly.setSourceLocation(originLocationOf(_conditionalJump));
+			m_assembly.appendJumpToIf(nonZeroLabel);
+
+			{
+				// Restore the stack afterwards for the non-zero case below.
+				ScopeGuard stackRestore([storedStack = m_stack, this]() {
+					m_stack = std::move(storedStack);
+					m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+				});
+				transition(_conditionalJump.debugData, _blockId, _conditionalJump.zero);
+			}
+
+			if (jumpDirectly)
+			{
+				// The zero case cannot have reached the non-zero target, since this block is its only entry.
+				yulAssert(!m_generated[_conditionalJump.nonZero.value]);
+				(*this)(_conditionalJump.nonZero);
+			}
+			else
+			{
+				m_assembly.appendLabel(nonZeroLabel);
+				transition(_conditionalJump.debugData, _blockId, _conditionalJump.nonZero);
+			}
+		},
+		[&](SSACFG::BasicBlock::JumpTable const&)
+		{
+			yulAssert(false, "Jump tables are not yet supported.");
+		},
+		[&](SSACFG::BasicBlock::FunctionReturn const& _functionReturn)
+		{
+			yulAssert(m_cfg->function && m_cfg->canContinue);
+			// The return values with the deepest one first, followed by the return label.
+			Stack exitStack;
+			for (SSACFG::ValueId returnValue: _functionReturn.returnValues)
+				exitStack.emplace_back(slotOf(returnValue));
+			exitStack.emplace_back(FunctionReturnLabelSlot{*m_cfg->function});
+			createStackLayout(_functionReturn.debugData, std::move(exitStack));
+			m_assembly.setSourceLocation(originLocationOf(_functionReturn));
+			m_assembly.appendJump(0, AbstractAssembly::JumpType::OutOfFunction);
+		},
+		[&](SSACFG::BasicBlock::Terminated const&)
+		{
+			yulAssert(!block.operations.empty());
+			std::visit(util::GenericVisitor{
+				[](SSACFG::BuiltinCall const& _call) {
+					yulAssert(_call.builtin.get().controlFlowSideEffects.terminatesOrReverts());
+				},
+				[](SSACFG::Call const& _call) {
+					yulAssert(!_call.canContinue);
+				}
+			}, block.operations.back().kind);
+		}
+	}, block.exit);
+
+	m_stack.clear();
+	m_assembly.setStackHeight(0);
+}
+
+void SSAEVMCodeTransform::operator()(SSACFG::Operation const& _operation)
+{
+	yulAssert(static_cast<int>(m_stack.size()) == m_assembly.stackHeight());
+	yulAssert(m_stack.size() >= _operation.inputs.size());
+	for (auto&& [input, slot]: ranges::zip_view(_operation.inputs, m_stack | ranges::views::take_last(_operation.inputs.size())))
+		yulAssert(std::holds_alternative<JunkSlot>(slotOf(input)) || slot == slotOf(input));
+	size_t consumedSlots = _operation.inputs.size();
+
+	m_assembly.setSourceLocation(originLocationOf(_operation.kind));
+	std::visit(util::GenericVisitor{
+		[&](SSACFG::BuiltinCall const& _call)
+		{
+			static_cast<BuiltinFunctionForEVM const&>(_call.builtin.get()).generateCode(
+				_call.call,
+				m_assembly,
+				m_builtinContext
+			);
+		},
+		[&](SSACFG::Call const& _call)
+		{
+			Scope::Function const& function = _call.function;
+			if (_call.canContinue)
+			{
+				++consumedSlots;
+				auto const* returnLabelSlot = std::get_if<FunctionCallReturnLabelSlot>(
+					&m_stack.at(m_stack.size() - _operation.inputs.size() - 1)
+				);
+				yulAssert(returnLabelSlot && &returnLabelSlot->call.get() == &_call.call.get());
+			}
+			m_assembly.appendJumpTo(
+				m_functionLabels.at(&function),
+				static_cast<int>(function.numReturns) - static_cast<int>(consumedSlots),
+				AbstractAssembly::JumpType::IntoFunction
+			);
+			if (_call.canContinue)
+				m_assembly.appendLabel(m_returnLabels.at(&_call.call.get()));
+		}
+	}, _operation.kind);
+
+	for (size_t i = 0; i < consumedSlots; ++i)
+		m_stack.pop_back();
+	for (SSACFG::ValueId output: _operation.outputs)
+		m_stack.emplace_back(slotOf(output));
+	yulAssert(static_cast<int>(m_stack.size()) == m_assembly.stackHeight());
+}
+
+void SSAEVMCodeTransform::transition(
+	langutil::DebugData::ConstPtr _debugData,
+	SSACFG::BlockId _from,
+	SSACFG::BlockId _to
+)
+{
+	std::optional<Stack>& entryLayout = m_entryLayouts[_to.value];
+	if (!entryLayout)
+		entryLayout = deriveEntryLayout(m_stack, _from, _to);
+
+	// Resolve the phis of the target for this edge.
+	SSACFG::BasicBlock const& target = m_cfg->block(_to);
+	Stack targetStack = *entryLayout;
+	for (auto& slot: targetStack)
+		if (auto value = valueOf(slot); value && target.phis.count(*value))
+			slot = slotOf(phiArgument(*value, _from));
+	createStackLayout(_debugData, std::move(targetStack));
+	m_stack = *entryLayout;
+
+	if (m_generated[_to.value])
+	{
+		yulAssert(m_blockLabels[_to.value]);
+		m_assembly.appendJumpTo(*m_blockLabels[_to.value]);
+	}
+	else
+	{
+		// Blocks with more than one entry will be jumped to later.
+		if (target.entries.size() > 1 && !m_blockLabels[_to.value])
+			m_blockLabels[_to.value] = m_assembly.newLabelId();
+		(*this)(_to);
+	}
+}
+
+Stack SSAEVMCodeTransform::deriveEntryLayout(Stack const& _stack, SSACFG::BlockId _from, SSACFG::BlockId _to)
+{
+	SSACFG::BasicBlock const& target = m_cfg->block(_to);
+	auto const& liveIn = m_liveness->liveIn(_to);
+	std::set<SSACFG::ValueId> placed;
+	Stack layout;
+	for (StackSlot const& slot: _stack)
+	{
+		if (std::holds_alternative<FunctionReturnLabelSlot>(slot))
+		{
+			layout.emplace_back(slot);
+			continue;
+		}
+		std::optional<SSACFG::ValueId> value = valueOf(slot);
+		if (!value)
+			continue;
+		if (liveIn.count(*value) && !target.phis.count(*value) && placed.insert(*value).second)
+		{
+			layout.emplace_back(slot);
+			continue;
+		}
+		// Reuse the slot for a phi that takes this value as argument on this edge.
+		for (SSACFG::ValueId phi: target.phis)
+			if (!placed.count(phi) && phiArgument(phi, _from) == *value)
+			{
+				placed.insert(phi);
+				layout.emplace_back(slotOf(phi));
+				break;
+			}
+	}
+	for (SSACFG::ValueId phi: target.phis)
+		if (!placed.count(phi))
+			layout.emplace_back(slotOf(phi));
+	return layout;
+}
+
+Stack SSAEVMCodeTransform::liveSlots(Stack const& _stack, std::set<SSACFG::ValueId> const& _live)
+{
+	std::set<SSACFG::ValueId> kept;
+	Stack result;
+	for (StackSlot const& slot: _stack)
+		if (std::holds_alternative<FunctionReturnLabelSlot>(slot))
+			result.emplace_back(slot);
+		else if (auto value = valueOf(slot); value && _live.count(*value) && kept.insert(*value).second)
+			result.emplace_back(slot);
+	return result;
+}
+
+SSACFG::ValueId SSAEVMCodeTransform::phiArgument(SSACFG::ValueId _phi, SSACFG::BlockId _from) const
+{
+	auto const* phiInfo = std::get_if<SSACFG::PhiValue>(&m_cfg->valueInfo(_phi));
+	yulAssert(phiInfo);
+	auto const& entries = m_cfg->block(phiInfo->block).entries;
+	auto it = entries.find(_from);
+	yulAssert(it != entries.end());
+	// The arguments of a phi correspond to the entries of its block in order.
+	return phiInfo->arguments.at(static_cast<size_t>(std::distance(entries.begin(), it)));
+}
+
+StackSlot SSAEVMCodeTransform::slotOf(SSACFG::ValueId _value)
+{
+	return std::visit(util::GenericVisitor{
+		[&](SSACFG::LiteralValue const& _literal) -> StackSlot {
+			return LiteralSlot{_literal.value, _literal.debugData};
+		},
+		[&](SSACFG::UnreachableValue const&) -> StackSlot {
+			return JunkSlot{};
+		},
+		[&](auto const& _info) -> StackSlot {
+			auto [it, inserted] = m_valueVariables.try_emplace(
+				_value.value,
+				Scope::Variable{YulName{"v" + std::to_string(_value.value)}}
+			);
+			if (inserted)
+				m_variableValues[&it->second] = _value;
+			return VariableSlot{it->second, _info.debugData};
+		}
+	}, m_cfg->valueInfo(_value));
+}
+
+std::optional<SSACFG::ValueId> SSAEVMCodeTransform::valueOf(StackSlot const& _slot) const
+{
+	if (auto const* variableSlot = std::get_if<VariableSlot>(&_slot))
+		return m_variableValues.at(&variableSlot->variable.get());
+	return std::nullopt;
+}
+
+void SSAEVMCodeTransform::createStackLayout(langutil::DebugData::ConstPtr _debugData, Stack _targetStack)
+{
+	Scope::Function const* currentFunction = m_cfg->function;
+	YulName functionName = currentFunction ? currentFunction->name : YulName{};
+	auto slotName = [](StackSlot const& _slot) {
+		if (auto const* variableSlot = std::get_if<VariableSlot>(&_slot))
+			return variableSlot->variable.get().name;
+		return YulName{};
+	};
+
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()));
+	langutil::SourceLocation sourceLocation = _debugData ? _debugData->originLocation : langutil::SourceLocation{};
+	m_assembly.setSourceLocation(sourceLocation);
+	::createStackLayout(
+		m_stack,
+		_targetStack,
+		// Swap callback.
+		[&](unsigned _i)
+		{
+			yulAssert(_i > 0 && _i < m_stack.size());
+			if (_i <= 16)
+				m_assembly.appendInstruction(evmasm::swapInstruction(_i));
+			else
+			{
+				int deficit = static_cast<int>(_i) - 16;
+				StackSlot const& deepSlot = m_stack.at(m_stack.size() - _i - 1);
+				std::string msg =
+					"Cannot swap slot " + stackSlotToString(deepSlot) + " with slot " + stackSlotToString(m_stack.back()) +
+					": too deep in the stack by " + std::to_string(deficit) + " slots in " + stackToString(m_stack);
+				m_stackErrors.emplace_back(StackTooDeepError(
+					functionName,
+					slotName(deepSlot),
+					deficit,
+					msg
+				) << langutil::errinfo_sourceLocation(sourceLocation));
+				m_assembly.markAsInvalid();
+			}
+		},
+		// Push or dup callback.
+		[&](StackSlot const& _slot)
+		{
+			if (auto depth = util::findOffset(m_stack | ranges::views::reverse, _slot))
+			{
+				if (*depth < 16)
+				{
+					m_assembly.appendInstruction(evmasm::dupInstruction(static_cast<unsigned>(*depth + 1)));
+					return;
+				}
+				else if (!canBeFreelyGenerated(_slot))
+				{
+					int deficit = static_cast<int>(*depth - 15);
+					std::string msg =
+						"Slot " + stackSlotToString(_slot) + " is " + std::to_string(deficit) +
+						" too deep in the stack " + stackToString(m_stack);
+					m_stackErrors.emplace_back(StackTooDeepError(
+						functionName,
+						slotName(_slot),
+						deficit,
+						msg
+					) << langutil::errinfo_sourceLocation(sourceLocation));
+					m_assembly.markAsInvalid();
+					m_assembly.appendConstant(u256(0xCAFFEE));
+					return;
+				}
+				// else: the slot is too deep in stack, but can be freely generated, we fall through to push it again.
+			}
+
+			std::visit(util::GenericVisitor{
+				[&](LiteralSlot const& _literal)
+				{
+					m_assembly.setSourceLocation(originLocationOf(_literal));
+					m_assembly.appendConstant(_literal.value);
+					m_assembly.setSourceLocation(sourceLocation);
+				},
+				[&](FunctionCallReturnLabelSlot const& _returnLabel)
+				{
+					if (!m_returnLabels.count(&_returnLabel.call.get()))
+						m_returnLabels[&_returnLabel.call.get()] = m_assembly.newLabelId();
+					m_assembly.appendLabelReference(m_returnLabels.at(&_returnLabel.call.get()));
+				},
+				[&](JunkSlot const&)
+				{
+					// Note: this will always be popped, so we can push anything.
+					if (m_assembly.evmVersion().hasPush0())
+						m_assembly.appendConstant(0);
+					else
+						m_assembly.appendInstruction(evmasm::Instruction::CODESIZE);
+				},
+				[&](auto const&)
+				{
+					yulAssert(false, "Value not found on stack: " + stackSlotToString(_slot));
+				}
+			}, _slot);
+		},
+		// Pop callback.
+		[&]()
+		{
+			m_assembly.appendInstruction(evmasm::Instruction::POP);
+		},
+		StackShuffling::ExactForSmallLayouts
+	);
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()));
+}
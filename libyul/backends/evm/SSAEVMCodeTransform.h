@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Code generator translating the SSA control flow graph of a Yul AST to EVM.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlow.h>
+#include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Scope.h>
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+struct AsmAnalysisInfo;
+
+/**
+ * Code generator that works on the SSA control flow graph (@a SSAControlFlowGraphBuilder) instead of the
+ * variable-based control flow graph used by @a OptimizedEVMCodeTransform.
+ *
+ * Stack slots are allocated based on the liveness of SSA values: before each operation, values that are no longer
+ * live are removed and the inputs are moved or copied to the top of the stack, depending on whether they are still
+ * live afterwards. The entry layout of a block is fixed when it is first jumped to and keeps live values
+ * in the positions they occupy on that edge. Phi values are placed at the positions of their arguments whenever
+ * possible. In a loop, the entry layout of the header is determined by the edge entering the loop, so that the
+ * back edge only has to restore the positions of the values modified in the loop.
+ *
+ * Values are not spilled to memory. If a layout cannot be reached, a stack too deep error is reported
+ * in the same way as by @a OptimizedEVMCodeTransform.
+ */
+class SSAEVMCodeTransform
+{
+public:
+	using UseNamedLabels = OptimizedEVMCodeTransform::UseNamedLabels;
+
+	[[nodiscard]] static std::vector<StackTooDeepError> run(
+		AbstractAssembly& _assembly,
+		AsmAnalysisInfo& _analysisInfo,
+		Block const& _block,
+		EVMDialect const& _dialect,
+		BuiltinContext& _builtinContext,
+		UseNamedLabels _useNamedLabelsForFunctions
+	);
+	/// Generates code for the already built @a _controlFlow with liveness @a _liveness, s.t. both can be
+	/// shared between several runs and with other consumers like the YulControlFlowGraphExporter.
+	[[nodiscard]] static std::vector<StackTooDeepError> run(
+		AbstractAssembly& _assembly,
+		ControlFlow const& _controlFlow,
+		ControlFlowLiveness const& _liveness,
+		BuiltinContext& _builtinContext,
+		UseNamedLabels _useNamedLabelsForFunctions
+	);
+
+private:
+	SSAEVMCodeTransform(
+		AbstractAssembly& _assembly,
+		BuiltinContext& _builtinContext,
+		ControlFlow const& _controlFlow,
+		UseNamedLabels _useNamedLabelsForFunctions
+	);
+
+	/// Generate code for the main graph or a function graph.
+	void operator()(SSACFG const& _cfg, SSACFGLiveness const& _liveness);
+
+	/// Generate code for the given block. Expects m_stack to be compatible with the entry layout of the block.
+	/// Recursively generates code for the blocks that are jumped to.
+	/// Always exits with an empty stack layout.
+	void operator()(SSACFG::BlockId _block);
+
+	/// Generate code for the given operation and update m_stack accordingly.
+	/// Expects the inputs of the operation on top of the stack.
+	void operator()(SSACFG::Operation const& _operation);
+
+	/// Transfers control from the end of @a _from to @a _to: shuffles m_stack to the entry layout of @a _to
+	/// (which is fixed on the first transition to a block), resolving the phis of @a _to for this edge,
+	/// and either jumps to @a _to or generates it in place.
+	void transition(langutil::DebugData::ConstPtr _debugData, SSACFG::BlockId _from, SSACFG::BlockId _to);
+
+	/// @returns an entry layout for @a _to that keeps the slots of @a _stack that are live in @a _to in place
+	/// and puts phis of @a _to at the positions of their arguments on the edge from @a _from, if possible.
+	Stack deriveEntryLayout(Stack const& _stack, SSACFG::BlockId _from, SSACFG::BlockId _to);
+	/// @returns @a _stack with all slots removed that are not live according to @a _live,
+	/// keeping the first occurrence of each live value and the function return label.
+	Stack liveSlots(Stack const& _stack, std::set<SSACFG::ValueId> const& _live);
+	/// @returns the argument of @a _phi on the edge from @a _from.
+	SSACFG::ValueId phiArgument(SSACFG::ValueId _phi, SSACFG::BlockId _from) const;
+
+	/// @returns the stack slot representing @a _value.
+	StackSlot slotOf(SSACFG::ValueId _value);
+	/// @returns the SSA value represented by @a _slot, if any.
+	std::optional<SSACFG::ValueId> valueOf(StackSlot const& _slot) const;
+
+	/// Shuffles m_stack to @a _targetStack while emitting the shuffling code to m_assembly.
+	void createStackLayout(langutil::DebugData::ConstPtr _debugData, Stack _targetStack);
+
+	AbstractAssembly& m_assembly;
+	BuiltinContext& m_builtinContext;
+	ControlFlow const& m_controlFlow;
+	std::map<Scope::Function const*, AbstractAssembly::LabelID> const m_functionLabels;
+	std::map<yul::FunctionCall const*, AbstractAssembly::LabelID> m_returnLabels;
+	std::vector<StackTooDeepError> m_stackErrors;
+
+	/// State of the graph currently being generated.
+	SSACFG const* m_cfg = nullptr;
+	SSACFGLiveness const* m_liveness = nullptr;
+	/// Artificial variables representing SSA values on the stack, so that the generic shuffling
+	/// of @a createStackLayout can be used.
+	std::map<size_t, Scope::Variable> m_valueVariables;
+	std::map<Scope::Variable const*, SSACFG::ValueId> m_variableValues;
+	std::vector<std::optional<Stack>> m_entryLayouts;
+	std::vector<std::optional<AbstractAssembly::LabelID>> m_blockLabels;
+	std::vector<bool> m_generated;
+	Stack m_stack;
+};
+
+}
@@ -19,8 +19,10 @@
 #pragma once
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/backends/evm/StackShuffleSolver.h>
 #include <libyul/Exceptions.h>
 
+#include <libsolutil/CommonData.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/all_of.hpp>
@@ -30,6 +32,8 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/take.hpp>
 
+#include <functional>
+
 namespace solidity::yul
 {
 
@@ -429,8 +433,17 @@ private:
 /// @a _pushOrDup is a function with signature void(StackSlot const&) that is called to push or dup the slot given as
 /// its argument to the stack top.
 /// @a _pop is a function with signature void() that is called when the top most slot is popped.
+/// With @a _strategy set to StackShuffling::ExactForSmallLayouts, the operations found by
+/// @a findOptimalStackShuffle are used instead of the greedy ones whenever they are strictly cheaper.
 template<typename Swap, typename PushOrDup, typename Pop>
-void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _swap, PushOrDup _pushOrDup, Pop _pop)
+void createStackLayout(
+	Stack& _currentStack,
+	Stack const& _targetStack,
+	Swap _swap,
+	PushOrDup _pushOrDup,
+	Pop _pop,
+	StackShuffling _strategy = StackShuffling::Greedy
+)
 {
 	struct ShuffleOperations
 	{
@@ -498,7 +511,57 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 		}
 	};
 
-	Shuffler<ShuffleOperations>::shuffle(_currentStack, _targetStack, _swap, _pushOrDup, _pop);
+	std::optional<std::vector<StackShuffleOperation>> exactOperations;
+	if (_strategy == StackShuffling::ExactForSmallLayouts)
+		if ((exactOperations = findOptimalStackShuffle(_currentStack, _targetStack)))
+		{
+			// Determine the costs of the greedy solution on a copy. Operations that would result in
+			// stack too deep errors make the greedy solution infinitely expensive.
+			Stack greedyStack = _currentStack;
+			size_t greedyCosts = 0;
+			bool greedyValid = true;
+			// Type-erased, so that this recursion does not instantiate further templates.
+			std::function<void(unsigned)> countSwap = [&](unsigned _i)
+			{
+				greedyCosts += stackShuffleCosts(StackShuffleOperation::Kind::Swap);
+				if (_i > 16)
+					greedyValid = false;
+			};
+			std::function<void(StackSlot const&)> countPushOrDup = [&](StackSlot const& _slot)
+			{
+				greedyCosts += stackShuffleCosts(StackShuffleOperation::Kind::PushOrDup);
+				auto depth = util::findOffset(greedyStack | ranges::views::reverse, _slot);
+				if (depth && *depth >= 16 && !canBeFreelyGenerated(_slot))
+					greedyValid = false;
+			};
+			std::function<void()> countPop = [&]() { greedyCosts += stackShuffleCosts(StackShuffleOperation::Kind::Pop); };
+			createStackLayout(greedyStack, _targetStack, countSwap, countPushOrDup, countPop);
+			size_t exactCosts = 0;
+			for (StackShuffleOperation const& operation: *exactOperations)
+				exactCosts += stackShuffleCosts(operation.kind);
+			if (greedyValid && exactCosts >= greedyCosts)
+				exactOperations.reset();
+		}
+
+	if (exactOperations)
+		for (StackShuffleOperation const& operation: *exactOperations)
+			switch (operation.kind)
+			{
+			case StackShuffleOperation::Kind::Swap:
+				_swap(operation.swapDepth);
+				std::swap(_currentStack.at(_currentStack.size() - operation.swapDepth - 1), _currentStack.back());
+				break;
+			case StackShuffleOperation::Kind::PushOrDup:
+				_pushOrDup(operation.slot);
+				_currentStack.push_back(operation.slot);
+				break;
+			case StackShuffleOperation::Kind::Pop:
+				_pop();
+				_currentStack.pop_back();
+				break;
+			}
+	else
+		Shuffler<ShuffleOperations>::shuffle(_currentStack, _targetStack, _swap, _pushOrDup, _pop);
 
 	yulAssert(_currentStack.size() == _targetStack.size(), "");
 	for (auto&& [current, target]: ranges::zip_view(_currentStack, _targetStack))
@@ -26,6 +26,7 @@
 #include <libevmasm/GasMeter.h>
 
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Cancellation.h>
 #include <libsolutil/cxx20.h>
 #include <libsolutil/Visitor.h>
 
@@ -47,13 +48,41 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-StackLayout StackLayoutGenerator::run(CFG const& _cfg)
+Stack StackLayout::operationInput(CFG::Operation const& _operation) const
+{
+	if (auto const* call = std::get_if<CFG::FunctionCall>(&_operation.operation))
+		if (call->canContinue && returnLabelAfterArguments.count(&call->function.get()))
+		{
+			yulAssert(!_operation.input.empty() && std::holds_alternative<FunctionCallReturnLabelSlot>(_operation.input.front()));
+			Stack input = _operation.input | ranges::views::drop(1) | ranges::to<Stack>;
+			input.emplace_back(_operation.input.front());
+			return input;
+		}
+	return _operation.input;
+}
+
+Stack StackLayout::functionEntryLayout(CFG::FunctionInfo const& _functionInfo) const
+{
+	Stack layout;
+	bool const returnLabelAfter = returnLabelAfterArguments.count(&_functionInfo.function);
+	if (_functionInfo.canContinue && !returnLabelAfter)
+		layout.emplace_back(FunctionReturnLabelSlot{_functionInfo.function});
+	for (auto const& param: _functionInfo.parameters | ranges::views::reverse)
+		layout.emplace_back(param);
+	if (_functionInfo.canContinue && returnLabelAfter)
+		layout.emplace_back(FunctionReturnLabelSlot{_functionInfo.function});
+	return layout;
+}
+
+StackLayout StackLayoutGenerator::run(CFG const& _cfg, bool _weightShufflesByLoopDepth, bool _optimizeCallingConvention)
 {
 	StackLayout stackLayout;
-	StackLayoutGenerator{stackLayout, nullptr}.processEntryPoint(*_cfg.entry);
+	if (_optimizeCallingConvention)
+		stackLayout.returnLabelAfterArguments = chooseCallingConventions(_cfg, run(_cfg, _weightShufflesByLoopDepth));
+	StackLayoutGenerator{stackLayout, nullptr, _weightShufflesByLoopDepth}.processEntryPoint(*_cfg.entry);
 
 	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout, &functionInfo}.processEntryPoint(*functionInfo.entry, &functionInfo);
+		StackLayoutGenerator{stackLayout, &functionInfo, _weightShufflesByLoopDepth}.processEntryPoint(*functionInfo.entry, &functionInfo);
 
 	return stackLayout;
 }
@@ -88,9 +117,14 @@ std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStac
 	return generator.reportStackTooDeep(*entry);
 }
 
-StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout, CFG::FunctionInfo const* _functionInfo):
+StackLayoutGenerator::StackLayoutGenerator(
+	StackLayout& _layout,
+	CFG::FunctionInfo const* _functionInfo,
+	bool _weightShufflesByLoopDepth
+):
 	m_layout(_layout),
-	m_currentFunctionInfo(_functionInfo)
+	m_currentFunctionInfo(_functionInfo),
+	m_weightShufflesByLoopDepth(_weightShufflesByLoopDepth)
 {
 }
 
@@ -290,8 +324,8 @@ Stack StackLayoutGenerator::propagateStackThroughOperation(Stack _exitStack, CFG
 				yulAssert(!util::contains(assignment->variables, *varSlot), "");
 
 	// Since stack+_operation.output can be easily shuffled to _exitLayout, the desired layout before the operation
-	// is stack+_operation.input;
-	stack += _operation.input;
+	// is stack+_operation.input (in the order required by the calling convention of a called function);
+	stack += m_layout.operationInput(_operation);
 
 	// Store the exact desired operation entry layout. The stored layout will be recreated by the code transform
 	// before executing the operation. However, this recreation can produce slots that can be freely generated or
@@ -339,9 +373,12 @@ void StackLayoutGenerator::processEntryPoint(CFG::BasicBlock const& _entry, CFG:
 
 	// TODO: check whether visiting only a subset of these in the outer iteration below is enough.
 	std::list<std::pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> backwardsJumps = collectBackwardsJumps(_entry);
+	if (m_weightShufflesByLoopDepth)
+		computeLoopDepths(backwardsJumps);
 
 	while (!toVisit.empty())
 	{
+		util::CancellationToken::check();
 		// First calculate stack layouts without walking backwards jumps, i.e. assuming the current preliminary
 		// entry layout of the backwards jump target as the initial exit layout of the backwards-jumping block.
 		while (!toVisit.empty())
@@ -444,7 +481,9 @@ std::optional<Stack> StackLayoutGenerator::getExitLayoutOrStageDependencies(
 				// If the current iteration has already visited both jump targets, start from its entry layout.
 				Stack stack = combineStack(
 					m_layout.blockInfos.at(_conditionalJump.zero).entryLayout,
-					m_layout.blockInfos.at(_conditionalJump.nonZero).entryLayout
+					m_layout.blockInfos.at(_conditionalJump.nonZero).entryLayout,
+					shuffleWeight(*_conditionalJump.zero),
+					shuffleWeight(*_conditionalJump.nonZero)
 				);
 				// Additionally, the jump condition has to be at the stack top at exit.
 				stack.emplace_back(_conditionalJump.condition);
@@ -545,7 +584,58 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 	});
 }
 
-Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+void StackLayoutGenerator::computeLoopDepths(
+	std::list<std::pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> const& _backwardsJumps
+)
+{
+	m_loopDepths.clear();
+	// Backwards jumps to the same target (e.g. from ``continue`` statements) belong to the same loop.
+	std::map<CFG::BasicBlock const*, std::set<CFG::BasicBlock const*>> loops;
+	for (auto [jumpingBlock, target]: _backwardsJumps)
+	{
+		auto& loop = loops[target];
+		util::BreadthFirstSearch<CFG::BasicBlock const*>{{jumpingBlock}}.run(
+			[&loop, target = target](CFG::BasicBlock const* _block, auto _addChild) {
+				loop.insert(_block);
+				if (_block == target)
+					return;
+				for (auto const* entry: _block->entries)
+					_addChild(entry);
+			}
+		);
+	}
+	for (auto const& loop: loops | ranges::views::values)
+		for (CFG::BasicBlock const* block: loop)
+			++m_loopDepths[block];
+}
+
+size_t StackLayoutGenerator::shuffleWeight(CFG::BasicBlock const& _block) const
+{
+	if (!m_weightShufflesByLoopDepth)
+		return 1;
+	// Assume a small number of iterations per loop, s.t. deeply nested loops do not dominate
+	// the costs entirely.
+	static constexpr size_t iterationsPerLoop = 8;
+	static constexpr size_t maxDepth = 4;
+	auto it = m_loopDepths.find(&_block);
+	size_t depth = it == m_loopDepths.end() ? 0 : std::min(it->second, maxDepth);
+	size_t weight = 1;
+	for (size_t i = 0; i < depth; ++i)
+		weight *= iterationsPerLoop;
+	return weight;
+}
+
+Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2, size_t _weight1, size_t _weight2) const
+{
+	auto key = std::make_tuple(_stack1, _stack2, _weight1, _weight2);
+	if (Stack const* combined = util::valueOrNullptr(m_combinedStacks, key))
+		return *combined;
+	Stack combined = computeCombinedStack(_stack1, _stack2, _weight1, _weight2);
+	m_combinedStacks.emplace(std::move(key), combined);
+	return combined;
+}
+
+Stack StackLayoutGenerator::computeCombinedStack(Stack const& _stack1, Stack const& _stack2, size_t _weight1, size_t _weight2)
 {
 	// TODO: it would be nicer to replace this by a constructive algorithm.
 	// Currently it uses a reduced version of the Heap Algorithm to partly brute-force, which seems
@@ -591,9 +681,11 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 				numOps += 1000;
 		};
 		createStackLayout(testStack, stack1Tail, swap, dupOrPush, [&](){});
+		size_t numOps1 = numOps;
+		numOps = 0;
 		testStack = _candidate;
 		createStackLayout(testStack, stack2Tail, swap, dupOrPush, [&](){});
-		return numOps;
+		return _weight1 * numOps1 + _weight2 * numOps;
 	};
 
 	// See https://en.wikipedia.org/wiki/Heap's_algorithm
@@ -632,6 +724,89 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 	return commonPrefix + bestCandidate;
 }
 
+namespace
+{
+/// @returns an estimate of the size in bytes of the code shuffling @a _source to @a _target.
+size_t shuffleSize(Stack _source, Stack const& _target)
+{
+	size_t size = 0;
+	createStackLayout(
+		_source,
+		_target,
+		[&](unsigned) { ++size; },
+		// Freely generated slots are pushed, i.e. are at least two bytes (a label usually requires three).
+		[&](StackSlot const& _slot) { size += canBeFreelyGenerated(_slot) ? 3 : 1; },
+		[&]() { ++size; }
+	);
+	return size;
+}
+}
+
+std::set<Scope::Function const*> StackLayoutGenerator::chooseCallingConventions(CFG const& _cfg, StackLayout const& _layout)
+{
+	// Estimated shuffling costs of each candidate function with the return label pushed before resp. after the
+	// arguments.
+	std::map<Scope::Function const*, std::pair<size_t, size_t>> costs;
+	for (CFG::FunctionInfo const& functionInfo: _cfg.functionInfo | ranges::views::values)
+		if (functionInfo.canContinue && !functionInfo.parameters.empty())
+		{
+			Stack const& bodyEntry = _layout.blockInfos.at(functionInfo.entry).entryLayout;
+			Stack entry = functionInfo.parameters | ranges::views::reverse | ranges::to<Stack>;
+			Stack alternativeEntry = entry;
+			entry.insert(entry.begin(), FunctionReturnLabelSlot{functionInfo.function});
+			alternativeEntry.emplace_back(FunctionReturnLabelSlot{functionInfo.function});
+			costs[&functionInfo.function] = {shuffleSize(entry, bodyEntry), shuffleSize(alternativeEntry, bodyEntry)};
+		}
+
+	auto addCallSiteCosts = [&](CFG::BasicBlock const& _entry) {
+		util::BreadthFirstSearch<CFG::BasicBlock const*>{{&_entry}}.run([&](CFG::BasicBlock const* _block, auto _addChild) {
+			Stack currentStack = _layout.blockInfos.at(_block).entryLayout;
+			for (auto const& operation: _block->operations)
+			{
+				Stack const& operationEntry = _layout.operationEntryLayout.at(&operation);
+				if (auto const* call = std::get_if<CFG::FunctionCall>(&operation.operation))
+					if (auto* functionCosts = util::valueOrNullptr(costs, &call->function.get()); functionCosts && call->canContinue)
+					{
+						// Move the return label from below the arguments to the top.
+						size_t const labelOffset = operationEntry.size() - operation.input.size();
+						Stack alternativeEntry = operationEntry;
+						yulAssert(std::holds_alternative<FunctionCallReturnLabelSlot>(alternativeEntry.at(labelOffset)));
+						alternativeEntry.erase(alternativeEntry.begin() + static_cast<std::ptrdiff_t>(labelOffset));
+						alternativeEntry.emplace_back(operationEntry.at(labelOffset));
+						functionCosts->first += shuffleSize(currentStack, operationEntry);
+						functionCosts->second += shuffleSize(currentStack, alternativeEntry);
+					}
+				currentStack = operationEntry;
+				for (size_t i = 0; i < operation.input.size(); i++)
+					currentStack.pop_back();
+				currentStack += operation.output;
+			}
+			std::visit(util::GenericVisitor{
+				[&](CFG::BasicBlock::Jump const& _jump)
+				{
+					if (!_jump.backwards)
+						_addChild(_jump.target);
+				},
+				[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
+				{
+					_addChild(_conditionalJump.zero);
+					_addChild(_conditionalJump.nonZero);
+				},
+				[&](auto const&) {},
+			}, _block->exit);
+		});
+	};
+	addCallSiteCosts(*_cfg.entry);
+	for (CFG::FunctionInfo const& functionInfo: _cfg.functionInfo | ranges::views::values)
+		addCallSiteCosts(*functionInfo.entry);
+
+	std::set<Scope::Function const*> result;
+	for (auto&& [function, functionCosts]: costs)
+		if (functionCosts.second < functionCosts.first)
+			result.insert(function);
+	return result;
+}
+
 std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG::BasicBlock const& _entry) const
 {
 	std::vector<StackTooDeep> stackTooDeepErrors;
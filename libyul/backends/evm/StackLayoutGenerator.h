@@ -23,7 +23,10 @@
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
 
+#include <list>
 #include <map>
+#include <set>
+#include <tuple>
 
 namespace solidity::yul
 {
@@ -42,6 +45,15 @@ struct StackLayout
 	/// - has the slots required for the operation at the stack top.
 	/// - will have the operation result in a layout that makes it easy to achieve the next desired layout.
 	std::map<CFG::Operation const*, Stack> operationEntryLayout;
+	/// Functions using the alternative calling convention, in which the caller pushes the return label after
+	/// the arguments instead of before them.
+	std::set<Scope::Function const*> returnLabelAfterArguments;
+
+	/// @returns the slots @a _operation requires on the stack top, taking the calling convention of
+	/// the called function into account.
+	Stack operationInput(CFG::Operation const& _operation) const;
+	/// @returns the stack layout on entry of the function described by @a _functionInfo.
+	Stack functionEntryLayout(CFG::FunctionInfo const& _functionInfo) const;
 };
 
 class StackLayoutGenerator
@@ -55,7 +67,17 @@ public:
 		std::vector<YulName> variableChoices;
 	};
 
-	static StackLayout run(CFG const& _cfg);
+	/// @param _weightShufflesByLoopDepth if true, the shuffling costs towards the targets of conditional jumps are
+	/// weighted by the loop nesting depth of the targets when combining their entry layouts, so that shuffling
+	/// is preferably moved out of loops.
+	/// @param _optimizeCallingConvention if true, the return label of a function is pushed after its arguments
+	/// instead of before them, if this is estimated to reduce the size of the shuffling code at the call sites
+	/// and the function entry.
+	static StackLayout run(
+		CFG const& _cfg,
+		bool _weightShufflesByLoopDepth = false,
+		bool _optimizeCallingConvention = false
+	);
 	/// @returns a map from function names to the stack too deep errors occurring in that function.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
 	/// The empty string is mapped to the stack too deep errors of the main entry point.
@@ -66,7 +88,7 @@ public:
 	static std::vector<StackTooDeep> reportStackTooDeep(CFG const& _cfg, YulName _functionName);
 
 private:
-	StackLayoutGenerator(StackLayout& _context, CFG::FunctionInfo const* _functionInfo);
+	StackLayoutGenerator(StackLayout& _context, CFG::FunctionInfo const* _functionInfo, bool _weightShufflesByLoopDepth = false);
 
 	/// @returns the optimal entry stack layout, s.t. @a _operation can be applied to it and
 	/// the result can be transformed to @a _exitStack with minimal stack shuffling.
@@ -98,9 +120,26 @@ private:
 	/// exactly, except that slots not required after the jump are marked as `JunkSlot`s.
 	void stitchConditionalJumps(CFG::BasicBlock const& _block);
 
+	/// Determines the loop nesting depth of all blocks from the backwards jumps in the graph.
+	/// A block is contained in the loop of a backwards jump, if it lies on a path from the jump target
+	/// to the jumping block.
+	void computeLoopDepths(std::list<std::pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> const& _backwardsJumps);
+	/// @returns the factor by which the costs of shuffling to the entry of @a _block are weighted.
+	size_t shuffleWeight(CFG::BasicBlock const& _block) const;
+
 	/// Calculates the ideal stack layout, s.t. both @a _stack1 and @a _stack2 can be achieved with minimal
-	/// stack shuffling when starting from the returned layout.
-	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+	/// stack shuffling when starting from the returned layout. The shuffling costs towards @a _stack1 and
+	/// @a _stack2 are weighted by @a _weight1 and @a _weight2, respectively.
+	/// The results are memoised, since revisiting blocks along backwards jumps usually combines the same
+	/// layouts again.
+	Stack combineStack(Stack const& _stack1, Stack const& _stack2, size_t _weight1 = 1, size_t _weight2 = 1) const;
+	/// Uncached version of @a combineStack.
+	static Stack computeCombinedStack(Stack const& _stack1, Stack const& _stack2, size_t _weight1, size_t _weight2);
+
+	/// @returns the functions for which pushing the return label after the arguments is estimated to require less
+	/// shuffling at the call sites and the function entry than pushing it before the arguments, judging by the
+	/// layouts in @a _layout, which was generated using the default calling convention.
+	static std::set<Scope::Function const*> chooseCallingConventions(CFG const& _cfg, StackLayout const& _layout);
 
 	/// Walks through the CFG and reports any stack too deep errors that would occur when generating code for it
 	/// without countermeasures.
@@ -116,6 +155,11 @@ private:
 
 	StackLayout& m_layout;
 	CFG::FunctionInfo const* m_currentFunctionInfo = nullptr;
+	bool m_weightShufflesByLoopDepth = false;
+	/// Loop nesting depth of the blocks of the current entry point, if m_weightShufflesByLoopDepth is set.
+	std::map<CFG::BasicBlock const*, size_t> m_loopDepths;
+	/// Results of @a combineStack for pairs of layouts and their weights.
+	mutable std::map<std::tuple<Stack, Stack, size_t, size_t>, Stack> m_combinedStacks;
 };
 
 }
@@ -0,0 +1,256 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/StackShuffleSolver.h>
+
+#include <libyul/Exceptions.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <queue>
+#include <tuple>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum depth of swaps and one more than the maximum depth of dups.
+constexpr size_t reachableDepth = 16;
+/// Junk slots in the target layout accept any slot.
+constexpr uint8_t wildcard = 0;
+
+/// A shuffling problem in which slots are replaced by small integers, assigned in order of their first
+/// occurrence. The canonical problem only depends on which slots are equal and which can be freely generated,
+/// so that it can be shared between many different actual layouts.
+struct CanonicalProblem
+{
+	std::vector<uint8_t> source;
+	std::vector<uint8_t> target;
+	/// Slots that can be pushed or dupped to reach the target, i.e. the non-junk slots of the target and
+	/// (if the target contains junk) the junk slot.
+	std::vector<uint8_t> candidates;
+	std::vector<bool> freelyGenerated;
+	size_t maxNodes = 0;
+
+	bool operator<(CanonicalProblem const& _other) const
+	{
+		return
+			std::tie(source, target, candidates, freelyGenerated, maxNodes) <
+			std::tie(_other.source, _other.target, _other.candidates, _other.freelyGenerated, _other.maxNodes);
+	}
+};
+
+struct CanonicalOperation
+{
+	StackShuffleOperation::Kind kind;
+	unsigned swapDepth = 0;
+	uint8_t slot = wildcard;
+};
+
+bool isSolved(std::vector<uint8_t> const& _stack, std::vector<uint8_t> const& _target)
+{
+	if (_stack.size() != _target.size())
+		return false;
+	for (size_t i = 0; i < _stack.size(); ++i)
+		if (_target[i] != wildcard && _stack[i] != _target[i])
+			return false;
+	return true;
+}
+
+/// Lower bound of the costs required to reach the target height.
+size_t heuristic(std::vector<uint8_t> const& _stack, std::vector<uint8_t> const& _target)
+{
+	if (_stack.size() > _target.size())
+		return (_stack.size() - _target.size()) * stackShuffleCosts(StackShuffleOperation::Kind::Pop);
+	else
+		return (_target.size() - _stack.size()) * stackShuffleCosts(StackShuffleOperation::Kind::PushOrDup);
+}
+
+/// A* search over stack states. Ties are broken by insertion order, which makes the result deterministic.
+std::optional<std::vector<CanonicalOperation>> solve(CanonicalProblem const& _problem)
+{
+	struct Node
+	{
+		std::vector<uint8_t> stack;
+		size_t costs;
+		size_t parent;
+		CanonicalOperation operation;
+	};
+	std::vector<Node> nodes;
+	std::map<std::vector<uint8_t>, size_t> bestCosts;
+	using QueueEntry = std::tuple<size_t, size_t>; // (estimated total costs, node index)
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+
+	size_t const maxHeight = std::max(_problem.source.size(), _problem.target.size()) + 2;
+	auto enqueue = [&](std::vector<uint8_t> _stack, size_t _costs, size_t _parent, CanonicalOperation _operation)
+	{
+		auto [it, inserted] = bestCosts.emplace(_stack, _costs);
+		if (!inserted)
+		{
+			if (it->second <= _costs)
+				return;
+			it->second = _costs;
+		}
+		size_t estimate = _costs + heuristic(_stack, _problem.target);
+		nodes.emplace_back(Node{std::move(_stack), _costs, _parent, _operation});
+		queue.emplace(estimate, nodes.size() - 1);
+	};
+
+	enqueue(_problem.source, 0, std::numeric_limits<size_t>::max(), {});
+	size_t expanded = 0;
+	while (!queue.empty())
+	{
+		auto [estimate, index] = queue.top();
+		queue.pop();
+		// Copy, since enqueue may reallocate the node storage.
+		std::vector<uint8_t> stack = nodes[index].stack;
+		size_t costs = nodes[index].costs;
+		if (bestCosts.at(stack) < costs)
+			continue;
+
+		if (isSolved(stack, _problem.target))
+		{
+			std::vector<CanonicalOperation> operations;
+			for (; nodes[index].parent != std::numeric_limits<size_t>::max(); index = nodes[index].parent)
+				operations.emplace_back(nodes[index].operation);
+			std::reverse(operations.begin(), operations.end());
+			return operations;
+		}
+
+		if (++expanded > _problem.maxNodes)
+			return std::nullopt;
+
+		size_t const height = stack.size();
+		for (size_t depth = 1; depth <= reachableDepth && depth < height; ++depth)
+		{
+			if (stack[height - depth - 1] == stack.back())
+				continue;
+			std::vector<uint8_t> next = stack;
+			std::swap(next[height - depth - 1], next.back());
+			enqueue(
+				std::move(next),
+				costs + stackShuffleCosts(StackShuffleOperation::Kind::Swap),
+				index,
+				{StackShuffleOperation::Kind::Swap, static_cast<unsigned>(depth), wildcard}
+			);
+		}
+		if (height > 0)
+			enqueue(
+				std::vector<uint8_t>(stack.begin(), stack.end() - 1),
+				costs + stackShuffleCosts(StackShuffleOperation::Kind::Pop),
+				index,
+				{StackShuffleOperation::Kind::Pop, 0, wildcard}
+			);
+		if (height < maxHeight)
+			for (uint8_t candidate: _problem.candidates)
+			{
+				auto found = std::find(stack.rbegin(), stack.rend(), candidate);
+				bool reachable = found != stack.rend() && static_cast<size_t>(found - stack.rbegin()) < reachableDepth;
+				if (!reachable && !_problem.freelyGenerated[candidate])
+					continue;
+				std::vector<uint8_t> next = stack;
+				next.push_back(candidate);
+				enqueue(
+					std::move(next),
+					costs + stackShuffleCosts(StackShuffleOperation::Kind::PushOrDup),
+					index,
+					{StackShuffleOperation::Kind::PushOrDup, 0, candidate}
+				);
+			}
+	}
+	return std::nullopt;
+}
+
+}
+
+size_t solidity::yul::stackShuffleCosts(StackShuffleOperation::Kind _kind)
+{
+	switch (_kind)
+	{
+	case StackShuffleOperation::Kind::Swap:
+	case StackShuffleOperation::Kind::PushOrDup:
+		return 3;
+	case StackShuffleOperation::Kind::Pop:
+		return 2;
+	}
+	yulAssert(false, "");
+}
+
+std::optional<std::vector<StackShuffleOperation>> solidity::yul::findOptimalStackShuffle(
+	Stack const& _source,
+	Stack const& _target,
+	StackShuffleSolverLimits const& _limits
+)
+{
+	if (_source.size() > _limits.maxLayoutSize || _target.size() > _limits.maxLayoutSize)
+		return std::nullopt;
+
+	// Index 0 is reserved for the wildcard.
+	std::vector<StackSlot> slots{JunkSlot{}};
+	auto idOf = [&](StackSlot const& _slot) -> uint8_t {
+		auto it = std::find(slots.begin() + 1, slots.end(), _slot);
+		if (it == slots.end())
+		{
+			slots.emplace_back(_slot);
+			return static_cast<uint8_t>(slots.size() - 1);
+		}
+		return static_cast<uint8_t>(it - slots.begin());
+	};
+
+	CanonicalProblem problem;
+	problem.maxNodes = _limits.maxNodes;
+	for (StackSlot const& slot: _source)
+		problem.source.emplace_back(idOf(slot));
+	bool targetHasJunk = false;
+	for (StackSlot const& slot: _target)
+		if (std::holds_alternative<JunkSlot>(slot))
+		{
+			problem.target.emplace_back(wildcard);
+			targetHasJunk = true;
+		}
+		else
+		{
+			uint8_t id = idOf(slot);
+			problem.target.emplace_back(id);
+			if (std::find(problem.candidates.begin(), problem.candidates.end(), id) == problem.candidates.end())
+				problem.candidates.emplace_back(id);
+		}
+	if (targetHasJunk)
+		problem.candidates.emplace_back(idOf(JunkSlot{}));
+	for (StackSlot const& slot: slots)
+		problem.freelyGenerated.emplace_back(canBeFreelyGenerated(slot));
+
+	thread_local std::map<CanonicalProblem, std::optional<std::vector<CanonicalOperation>>> cache;
+	auto it = cache.find(problem);
+	if (it == cache.end())
+	{
+		if (cache.size() >= 65536)
+			cache.clear();
+		it = cache.emplace(problem, solve(problem)).first;
+	}
+
+	if (!it->second)
+		return std::nullopt;
+	std::vector<StackShuffleOperation> result;
+	for (CanonicalOperation const& operation: *it->second)
+		result.emplace_back(StackShuffleOperation{operation.kind, operation.swapDepth, slots.at(operation.slot)});
+	return result;
+}
@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Exact search for the cheapest stack shuffling operations between two small stack layouts.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/// Selects the algorithm used by @a createStackLayout.
+enum class StackShuffling
+{
+	/// Always use the greedy shuffler.
+	Greedy,
+	/// Use @a findOptimalStackShuffle if the layouts are small enough and the result is cheaper
+	/// than the one of the greedy shuffler.
+	ExactForSmallLayouts
+};
+
+/// A single stack shuffling operation in terms of the callbacks of @a createStackLayout.
+struct StackShuffleOperation
+{
+	enum class Kind { Swap, PushOrDup, Pop };
+	Kind kind;
+	/// Depth of the swap, only used for swaps.
+	unsigned swapDepth = 0;
+	/// Slot to push or dup, only used for PushOrDup.
+	StackSlot slot = JunkSlot{};
+};
+
+struct StackShuffleSolverLimits
+{
+	/// Maximum number of slots in the source and in the target layout.
+	size_t maxLayoutSize = 8;
+	/// Maximum number of stack states to explore.
+	size_t maxNodes = 4096;
+};
+
+/// @returns the gas costs of performing @a _kind, assuming that pushes and dups have the same costs.
+size_t stackShuffleCosts(StackShuffleOperation::Kind _kind);
+
+/// Searches for the sequence of operations with minimal gas costs that transforms @a _source into a layout
+/// compatible with @a _target (i.e. it is equal to it, except for the positions of junk slots in the target).
+/// Swaps are restricted to a depth of 16 and slots are only dupped if they are reachable. Slots that cannot be
+/// reached are only pushed if they can be freely generated. The stack is never more than two slots higher than
+/// the larger one of the two layouts.
+/// The results are memoised per thread, since the result only depends on which slots are equal and which can be
+/// freely generated, and the same small shuffles occur over and over again.
+/// @returns std::nullopt if a layout exceeds the limits or no solution was found within the node budget.
+std::optional<std::vector<StackShuffleOperation>> findOptimalStackShuffle(
+	Stack const& _source,
+	Stack const& _target,
+	StackShuffleSolverLimits const& _limits = {}
+);
+
+}
@@ -23,6 +23,9 @@
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
@@ -59,6 +62,26 @@ std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 	return result;
 }
 
+uint64_t BlockHasher::functionHash(
+	FunctionDefinition const& _function,
+	std::map<YulName, YulName> const& _functionNames
+)
+{
+	std::map<Block const*, uint64_t> blockHashes;
+	BlockHasher hasher(blockHashes, &_functionNames);
+	hasher.hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hasher.hash64(_function.parameters.size());
+	hasher.hash64(_function.returnVariables.size());
+	// Declaring the parameters and return variables upfront makes their references in the
+	// body hash as positions instead of as arbitrary external variables.
+	for (auto const& parameter: _function.parameters)
+		hasher.declareVariable(parameter.name);
+	for (auto const& returnVariable: _function.returnVariables)
+		hasher.declareVariable(returnVariable.name);
+	hasher(_function.body);
+	return hasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hashLiteral(_literal);
@@ -86,7 +109,11 @@ void BlockHasher::operator()(Identifier const& _identifier)
 void BlockHasher::operator()(FunctionCall const& _funCall)
 {
 	hash64(compileTimeLiteralHash("FunctionCall"));
-	hash64(_funCall.functionName.name.hash());
+	YulName functionName = _funCall.functionName.name;
+	if (m_functionNames)
+		if (YulName const* replacement = util::valueOrNullptr(*m_functionNames, functionName))
+			functionName = *replacement;
+	hash64(functionName.hash());
 	hash64(_funCall.arguments.size());
 	ASTWalker::operator()(_funCall);
 }
@@ -111,13 +138,7 @@ void BlockHasher::operator()(VariableDeclaration const& _varDecl)
 	hash64(compileTimeLiteralHash("VariableDeclaration"));
 	hash64(_varDecl.variables.size());
 	for (auto const& var: _varDecl.variables)
-	{
-		yulAssert(!m_variableReferences.count(var.name), "");
-		m_variableReferences[var.name] = VariableReference{
-			m_internalIdentifierCount++,
-			false
-		};
-	}
+		declareVariable(var.name);
 	ASTWalker::operator()(_varDecl);
 }
 
@@ -185,7 +206,7 @@ void BlockHasher::operator()(Block const& _block)
 	if (_block.statements.empty())
 		return;
 
-	BlockHasher subBlockHasher(m_blockHashes);
+	BlockHasher subBlockHasher(m_blockHashes, m_functionNames);
 	for (auto const& statement: _block.statements)
 		subBlockHasher.visit(statement);
 
@@ -198,6 +219,15 @@ void BlockHasher::operator()(Block const& _block)
 		(*this)(Identifier{{}, externalReference});
 }
 
+void BlockHasher::declareVariable(YulName _name)
+{
+	yulAssert(!m_variableReferences.count(_name), "");
+	m_variableReferences[_name] = VariableReference{
+		m_internalIdentifierCount++,
+		false
+	};
+}
+
 uint64_t ExpressionHasher::run(Expression const& _e)
 {
 	ExpressionHasher expressionHasher;
@@ -223,3 +253,321 @@ void ExpressionHasher::operator()(FunctionCall const& _funCall)
 	hash64(_funCall.arguments.size());
 	ASTWalker::operator()(_funCall);
 }
+
+uint64_t ASTHasher::run(Block const& _block)
+{
+	ASTHasher hasher;
+	hasher(_block);
+	return hasher.m_hash;
+}
+
+void ASTHasher::operator()(Literal const& _literal)
+{
+	hashDebugData(_literal.debugData);
+	hashLiteral(_literal);
+	hash8(static_cast<uint8_t>(_literal.kind));
+	if (_literal.value.hint())
+		hash64(std::hash<std::string>{}(*_literal.value.hint()));
+}
+
+void ASTHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hashDebugData(_identifier.debugData);
+	hash64(_identifier.name.hash());
+}
+
+void ASTHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hashDebugData(_funCall.debugData);
+	(*this)(_funCall.functionName);
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTHasher::operator()(ExpressionStatement const& _statement)
+{
+	hash64(compileTimeLiteralHash("ExpressionStatement"));
+	hashDebugData(_statement.debugData);
+	ASTWalker::operator()(_statement);
+}
+
+void ASTHasher::operator()(Assignment const& _assignment)
+{
+	hash64(compileTimeLiteralHash("Assignment"));
+	hashDebugData(_assignment.debugData);
+	hash64(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		(*this)(name);
+	visit(*_assignment.value);
+}
+
+void ASTHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hash64(compileTimeLiteralHash("VariableDeclaration"));
+	hashDebugData(_varDecl.debugData);
+	hashNames(_varDecl.variables);
+	hash8(_varDecl.value != nullptr);
+	if (_varDecl.value)
+		visit(*_varDecl.value);
+}
+
+void ASTHasher::operator()(If const& _if)
+{
+	hash64(compileTimeLiteralHash("If"));
+	hashDebugData(_if.debugData);
+	ASTWalker::operator()(_if);
+}
+
+void ASTHasher::operator()(Switch const& _switch)
+{
+	hash64(compileTimeLiteralHash("Switch"));
+	hashDebugData(_switch.debugData);
+	visit(*_switch.expression);
+	hash64(_switch.cases.size());
+	for (auto const& _case: _switch.cases)
+	{
+		hashDebugData(_case.debugData);
+		hash8(_case.value != nullptr);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void ASTHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hashDebugData(_funDef.debugData);
+	hash64(_funDef.name.hash());
+	hashNames(_funDef.parameters);
+	hashNames(_funDef.returnVariables);
+	(*this)(_funDef.body);
+}
+
+void ASTHasher::operator()(ForLoop const& _loop)
+{
+	hash64(compileTimeLiteralHash("ForLoop"));
+	hashDebugData(_loop.debugData);
+	ASTWalker::operator()(_loop);
+}
+
+void ASTHasher::operator()(Break const& _break)
+{
+	hash64(compileTimeLiteralHash("Break"));
+	hashDebugData(_break.debugData);
+}
+
+void ASTHasher::operator()(Continue const& _continue)
+{
+	hash64(compileTimeLiteralHash("Continue"));
+	hashDebugData(_continue.debugData);
+}
+
+void ASTHasher::operator()(Leave const& _leave)
+{
+	hash64(compileTimeLiteralHash("Leave"));
+	hashDebugData(_leave.debugData);
+}
+
+void ASTHasher::operator()(Block const& _block)
+{
+	hash64(compileTimeLiteralHash("Block"));
+	hashDebugData(_block.debugData);
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void ASTHasher::hashDebugData(langutil::DebugData::ConstPtr const& _debugData)
+{
+	hash8(_debugData != nullptr);
+	if (!_debugData)
+		return;
+	for (langutil::SourceLocation const& location: {_debugData->nativeLocation, _debugData->originLocation})
+	{
+		hash32(static_cast<uint32_t>(location.start));
+		hash32(static_cast<uint32_t>(location.end));
+	}
+	hash64(static_cast<uint64_t>(_debugData->astID.value_or(-1)));
+}
+
+void ASTHasher::hashNames(std::vector<NameWithDebugData> const& _names)
+{
+	hash64(_names.size());
+	for (auto const& name: _names)
+	{
+		hashDebugData(name.debugData);
+		hash64(name.name.hash());
+	}
+}
+
+h256 ASTKeccakHasher::run(Block const& _block)
+{
+	ASTKeccakHasher hasher;
+	hasher(_block);
+	return keccak256(hasher.m_encoding);
+}
+
+void ASTKeccakHasher::operator()(Literal const& _literal)
+{
+	appendNode(NodeType::Literal, _literal.debugData);
+	m_encoding.push_back(static_cast<uint8_t>(_literal.kind));
+	m_encoding.push_back(_literal.value.unlimited());
+	if (_literal.value.unlimited())
+		appendString(_literal.value.builtinStringLiteralValue());
+	else
+	{
+		h256 const value{_literal.value.value()};
+		m_encoding.insert(m_encoding.end(), value.data(), value.data() + h256::size);
+	}
+	m_encoding.push_back(_literal.value.hint() != nullptr);
+	if (_literal.value.hint())
+		appendString(*_literal.value.hint());
+}
+
+void ASTKeccakHasher::operator()(Identifier const& _identifier)
+{
+	appendNode(NodeType::Identifier, _identifier.debugData);
+	appendString(_identifier.name.str());
+}
+
+void ASTKeccakHasher::operator()(FunctionCall const& _funCall)
+{
+	appendNode(NodeType::FunctionCall, _funCall.debugData);
+	(*this)(_funCall.functionName);
+	appendNumber(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTKeccakHasher::operator()(ExpressionStatement const& _statement)
+{
+	appendNode(NodeType::ExpressionStatement, _statement.debugData);
+	ASTWalker::operator()(_statement);
+}
+
+void ASTKeccakHasher::operator()(Assignment const& _assignment)
+{
+	appendNode(NodeType::Assignment, _assignment.debugData);
+	appendNumber(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		(*this)(name);
+	visit(*_assignment.value);
+}
+
+void ASTKeccakHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	appendNode(NodeType::VariableDeclaration, _varDecl.debugData);
+	appendNames(_varDecl.variables);
+	m_encoding.push_back(_varDecl.value != nullptr);
+	if (_varDecl.value)
+		visit(*_varDecl.value);
+}
+
+void ASTKeccakHasher::operator()(If const& _if)
+{
+	appendNode(NodeType::If, _if.debugData);
+	ASTWalker::operator()(_if);
+}
+
+void ASTKeccakHasher::operator()(Switch const& _switch)
+{
+	appendNode(NodeType::Switch, _switch.debugData);
+	visit(*_switch.expression);
+	appendNumber(_switch.cases.size());
+	for (auto const& _case: _switch.cases)
+	{
+		appendNode(NodeType::Case, _case.debugData);
+		m_encoding.push_back(_case.value != nullptr);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void ASTKeccakHasher::operator()(FunctionDefinition const& _funDef)
+{
+	appendNode(NodeType::FunctionDefinition, _funDef.debugData);
+	appendString(_funDef.name.str());
+	appendNames(_funDef.parameters);
+	appendNames(_funDef.returnVariables);
+	(*this)(_funDef.body);
+}
+
+void ASTKeccakHasher::operator()(ForLoop const& _loop)
+{
+	appendNode(NodeType::ForLoop, _loop.debugData);
+	ASTWalker::operator()(_loop);
+}
+
+void ASTKeccakHasher::operator()(Break const& _break)
+{
+	appendNode(NodeType::Break, _break.debugData);
+}
+
+void ASTKeccakHasher::operator()(Continue const& _continue)
+{
+	appendNode(NodeType::Continue, _continue.debugData);
+}
+
+void ASTKeccakHasher::operator()(Leave const& _leave)
+{
+	appendNode(NodeType::Leave, _leave.debugData);
+}
+
+void ASTKeccakHasher::operator()(Block const& _block)
+{
+	appendNode(NodeType::Block, _block.debugData);
+	appendNumber(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void ASTKeccakHasher::appendNode(NodeType _type, langutil::DebugData::ConstPtr const& _debugData)
+{
+	m_encoding.push_back(static_cast<uint8_t>(_type));
+	appendDebugData(_debugData);
+}
+
+void ASTKeccakHasher::appendDebugData(langutil::DebugData::ConstPtr const& _debugData)
+{
+	m_encoding.push_back(_debugData != nullptr);
+	if (!_debugData)
+		return;
+
+	langutil::SourceLocation const& location = _debugData->originLocation;
+	m_encoding.push_back(location.sourceName != nullptr);
+	if (location.sourceName)
+	{
+		auto [it, inserted] = m_sourceNameIndices.emplace(location.sourceName.get(), m_sourceNameIndices.size());
+		appendNumber(it->second);
+		if (inserted)
+			appendString(*location.sourceName);
+	}
+	appendNumber(static_cast<uint64_t>(location.start));
+	appendNumber(static_cast<uint64_t>(location.end));
+	m_encoding.push_back(_debugData->astID.has_value());
+	if (_debugData->astID)
+		appendNumber(static_cast<uint64_t>(*_debugData->astID));
+}
+
+void ASTKeccakHasher::appendNames(std::vector<NameWithDebugData> const& _names)
+{
+	appendNumber(_names.size());
+	for (auto const& name: _names)
+	{
+		appendDebugData(name.debugData);
+		appendString(name.name.str());
+	}
+}
+
+void ASTKeccakHasher::appendNumber(uint64_t _value)
+{
+	for (size_t i = 0; i < 8; ++i)
+		m_encoding.push_back(static_cast<uint8_t>(_value >> (8 * i)));
+}
+
+void ASTKeccakHasher::appendString(std::string_view _value)
+{
+	appendNumber(_value.size());
+	m_encoding.insert(m_encoding.end(), _value.begin(), _value.end());
+}
@@ -24,6 +24,14 @@
 #include <libyul/ASTForward.h>
 #include <libyul/YulName.h>
 
+#include <liblangutil/DebugData.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <string_view>
+#include <vector>
+
 namespace solidity::yul
 {
 
@@ -76,6 +84,10 @@ protected:
  * Similarly, the names of referenced external variables are not considered,
  * but replaced by a (distinct) counter as well.
  *
+ * The hash of a function computed by ``functionHash`` also takes the positions of
+ * parameters and return variables into account, so that functions that only differ in
+ * the names of their variables have the same hash and other functions likely do not.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
 class BlockHasher: public ASTWalker, public ASTHasherBase
@@ -100,12 +112,27 @@ public:
 	void operator()(Block const& _block) override;
 
 	static std::map<Block const*, uint64_t> run(Block const& _block);
+	/// @returns the hash of the function @a _function. Names of called functions are replaced
+	/// according to @a _functionNames before they are hashed.
+	static uint64_t functionHash(
+		FunctionDefinition const& _function,
+		std::map<YulName, YulName> const& _functionNames
+	);
 
 
 private:
-	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
+	BlockHasher(
+		std::map<Block const*, uint64_t>& _blockHashes,
+		std::map<YulName, YulName> const* _functionNames = nullptr
+	):
+		m_blockHashes(_blockHashes),
+		m_functionNames(_functionNames)
+	{}
+
+	void declareVariable(YulName _name);
 
 	std::map<Block const*, uint64_t>& m_blockHashes;
+	std::map<YulName, YulName> const* m_functionNames = nullptr;
 
 	struct VariableReference
 	{
@@ -147,4 +174,83 @@ struct ExpressionHash
 	}
 };
 
+/**
+ * Computes a hash of a complete AST that is likely different for ASTs that are not syntactically
+ * equal or that differ in their debug data. In contrast to the BlockHasher, all names are hashed
+ * exactly as they are.
+ */
+class ASTHasher: public ASTWalker, public ASTHasherBase
+{
+public:
+	static uint64_t run(Block const& _block);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const& _break) override;
+	void operator()(Continue const& _continue) override;
+	void operator()(Leave const& _leave) override;
+	void operator()(Block const& _block) override;
+
+private:
+	void hashDebugData(langutil::DebugData::ConstPtr const& _debugData);
+	void hashNames(std::vector<NameWithDebugData> const& _names);
+};
+
+/**
+ * Computes a Keccak-256 hash of a complete AST that is suitable as a key for caching, i.e. ASTs
+ * with the same hash can be assumed to be syntactically equal and to have the same debug data.
+ * In contrast to the ASTHasher, the AST is encoded exactly, including all names and the source names of
+ * the locations, and the encoding is hashed as a whole. Native source locations are not taken into account.
+ */
+class ASTKeccakHasher: public ASTWalker
+{
+public:
+	static util::h256 run(Block const& _block);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const& _break) override;
+	void operator()(Continue const& _continue) override;
+	void operator()(Leave const& _leave) override;
+	void operator()(Block const& _block) override;
+
+private:
+	enum class NodeType: uint8_t
+	{
+		Literal, Identifier, FunctionCall, ExpressionStatement, Assignment, VariableDeclaration,
+		If, Switch, Case, FunctionDefinition, ForLoop, Break, Continue, Leave, Block
+	};
+
+	void appendNode(NodeType _type, langutil::DebugData::ConstPtr const& _debugData);
+	void appendDebugData(langutil::DebugData::ConstPtr const& _debugData);
+	void appendNames(std::vector<NameWithDebugData> const& _names);
+	void appendNumber(uint64_t _value);
+	void appendString(std::string_view _value);
+
+	bytes m_encoding;
+	/// Indices of the source names in the order of their first occurrence, which makes it
+	/// sufficient to encode each name only once.
+	std::map<std::string const*, size_t> m_sourceNameIndices;
+};
+
 }
@@ -21,9 +21,8 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
-#include <libyul/optimiser/SyntacticalEquality.h>
-#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FunctionParallelism.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/SideEffects.h>
 #include <libyul/Exceptions.h>
@@ -31,17 +30,28 @@
 #include <libyul/Dialect.h>
 #include <libyul/Utilities.h>
 
+#include <libsolutil/Visitor.h>
+
+#include <algorithm>
+
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
 void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
-	};
-	cse(_ast);
+	std::map<YulName, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	bool const ranInParallel = runOnTopLevelStatementsInParallel(_context, _ast, [&](size_t _begin, size_t _end) {
+		CommonSubexpressionEliminator cse{_context.dialect, functionSideEffects};
+		for (size_t i = _begin; i < _end; ++i)
+			cse.visit(_ast.statements[i]);
+	});
+	if (!ranInParallel)
+	{
+		CommonSubexpressionEliminator cse{_context.dialect, std::move(functionSideEffects)};
+		cse(_ast);
+	}
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
@@ -56,6 +66,7 @@ void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
 {
 	ScopedSaveAndRestore returnVariables(m_returnVariables, {});
 	ScopedSaveAndRestore replacementCandidates(m_replacementCandidates, {});
+	ScopedSaveAndRestore valueNumbers(m_valueNumbers, {});
 
 	for (auto const& v: _fun.returnVariables)
 		m_returnVariables.insert(v.name);
@@ -65,6 +76,12 @@ void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
 
 void CommonSubexpressionEliminator::visit(Expression& _e)
 {
+	// Numbers of the visited subexpressions of the outermost expression start at the beginning.
+	if (m_expressionDepth == 0)
+		m_visitedExpressions.clear();
+	ScopedSaveAndRestore expressionDepth(m_expressionDepth, m_expressionDepth + 1);
+	size_t const subexpressionsBegin = m_visitedExpressions.size();
+
 	bool descend = true;
 	// If this is a function call to a function that requires literal arguments,
 	// do not try to simplify there.
@@ -93,6 +110,7 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	if (descend)
 		DataFlowAnalyzer::visit(_e);
 
+	ExpressionNumbering::Number number = numberOf(_e, subexpressionsBegin);
 	if (Identifier const* identifier = std::get_if<Identifier>(&_e))
 	{
 		YulName identifierName = identifier->name;
@@ -101,10 +119,13 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 			assertThrow(assignedValue->value, OptimizerException, "");
 			if (Identifier const* value = std::get_if<Identifier>(assignedValue->value))
 				if (inScope(value->name))
+				{
+					number = m_numbering.identifier(value->name);
 					_e = Identifier{debugDataOf(_e), value->name};
+				}
 		}
 	}
-	else if (auto const* candidates = util::valueOrNullptr(m_replacementCandidates, _e))
+	else if (auto const* candidates = util::valueOrNullptr(m_replacementCandidates, number))
 		for (auto const& variable: *candidates)
 			if (AssignedValue const* value = variableValue(variable))
 			{
@@ -117,18 +138,54 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 					std::get<Literal>(*value->value).value.value() == 0
 				)
 					continue;
-				// We check for syntactic equality again because the value might have changed.
-				if (inScope(variable) && SyntacticallyEqual{}(_e, *value->value))
+				// We compare the numbers again because the value might have changed.
+				if (inScope(variable) && m_valueNumbers.at(variable) == number)
 				{
+					number = m_numbering.identifier(variable);
 					_e = Identifier{debugDataOf(_e), variable};
 					break;
 				}
 			}
+	m_visitedExpressions.emplace_back(&_e, number);
 }
 
 void CommonSubexpressionEliminator::assignValue(YulName _variable, Expression const* _value)
 {
 	if (_value)
-		m_replacementCandidates[*_value].insert(_variable);
+	{
+		// The value was usually visited right before, unless it is the default value.
+		ExpressionNumbering::Number number =
+			!m_visitedExpressions.empty() && m_visitedExpressions.back().first == _value ?
+			m_visitedExpressions.back().second :
+			m_numbering(*_value);
+		m_replacementCandidates[number].insert(_variable);
+		m_valueNumbers[_variable] = number;
+	}
 	DataFlowAnalyzer::assignValue(_variable, _value);
 }
+
+ExpressionNumbering::Number CommonSubexpressionEliminator::numberOf(Expression const& _e, size_t _subexpressionsBegin)
+{
+	ExpressionNumbering::Number number = std::visit(GenericVisitor{
+		[&](Literal const& _literal) { return m_numbering.literal(_literal.value); },
+		[&](Identifier const& _identifier) { return m_numbering.identifier(_identifier.name); },
+		[&](FunctionCall const& _functionCall) {
+			// The arguments that were visited have been numbered already. They all
+			// come after _subexpressionsBegin, but not in the order of the arguments.
+			std::vector<ExpressionNumbering::Number> arguments;
+			arguments.reserve(_functionCall.arguments.size());
+			for (Expression const& argument: _functionCall.arguments)
+			{
+				auto visited = std::find_if(
+					m_visitedExpressions.begin() + static_cast<std::ptrdiff_t>(_subexpressionsBegin),
+					m_visitedExpressions.end(),
+					[&](auto const& _visited) { return _visited.first == &argument; }
+				);
+				arguments.emplace_back(visited != m_visitedExpressions.end() ? visited->second : m_numbering(argument));
+			}
+			return m_numbering.functionCall(_functionCall.functionName.name, std::move(arguments));
+		}
+	}, _e);
+	m_visitedExpressions.resize(_subexpressionsBegin);
+	return number;
+}
@@ -23,11 +23,14 @@
 #pragma once
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/ExpressionNumbering.h>
 #include <libyul/optimiser/OptimiserStep.h>
-#include <libyul/optimiser/SyntacticalEquality.h>
-#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/YulNameMap.h>
 
 #include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -62,13 +65,19 @@ protected:
 
 	void assignValue(YulName _variable, Expression const* _value) override;
 private:
+	/// @returns the number of @a _e and removes the numbers of its visited subexpressions,
+	/// which start at @a _subexpressionsBegin in m_visitedExpressions.
+	ExpressionNumbering::Number numberOf(Expression const& _e, size_t _subexpressionsBegin);
+
 	std::set<YulName> m_returnVariables;
-	std::unordered_map<
-		std::reference_wrapper<Expression const>,
-		std::set<YulName>,
-		ExpressionHash,
-		SyntacticallyEqualExpression
-	> m_replacementCandidates;
+	ExpressionNumbering m_numbering;
+	/// Variables whose current value has the given number.
+	std::unordered_map<ExpressionNumbering::Number, std::set<YulName>> m_replacementCandidates;
+	/// Number of the value of each variable when it was last assigned.
+	YulNameMap<ExpressionNumbering::Number> m_valueNumbers;
+	/// Numbers of expressions whose parent is currently being visited.
+	std::vector<std::pair<Expression const*, ExpressionNumbering::Number>> m_visitedExpressions;
+	size_t m_expressionDepth = 0;
 };
 
 
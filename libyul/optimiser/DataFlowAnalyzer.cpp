@@ -45,10 +45,12 @@ using namespace solidity::yul;
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
 	MemoryAndStorage _analyzeStores,
-	std::map<YulName, SideEffects> _functionSideEffects
+	std::map<YulName, SideEffects> _functionSideEffects,
+	std::map<YulName, StorageWrites> _functionStorageWrites
 ):
 	m_dialect(_dialect),
 	m_functionSideEffects(std::move(_functionSideEffects)),
+	m_functionStorageWrites(std::move(_functionStorageWrites)),
 	m_knowledgeBase([this](YulName _var) { return variableValue(_var); }),
 	m_analyzeStores(_analyzeStores == MemoryAndStorage::Analyze)
 {
@@ -72,23 +74,31 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
+			eraseIf(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
 				return
 					!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
 					vars->second != value;
 			}));
-			m_state.environment.storage[vars->first] = vars->second;
+			assignIfDifferent(m_state.environment.storage, vars->first, vars->second);
 			return;
 		}
 		else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
+			// Storing the value that is already known to be there does not change memory.
+			if (memoryValue(vars->first) == vars->second)
+				return;
+			eraseIf(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
 				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
 			}));
-			// TODO erase keccak knowledge, but in a more clever way
-			m_state.environment.keccak = {};
-			m_state.environment.memory[vars->first] = vars->second;
+			// Only keep hashes of areas that are known not to overlap with the 32 bytes written.
+			eraseIf(m_state.environment.keccak, [&](auto&& _item) {
+				auto&& [start, length] = _item.first;
+				std::optional<u256> byteLength = m_knowledgeBase.valueIfKnownConstant(length);
+				std::optional<u256> offset = m_knowledgeBase.differenceIfKnownConstant(vars->first, start);
+				return !byteLength || !offset || *offset < *byteLength || *offset > u256(0) - 32;
+			});
+			assignIfDifferent(m_state.environment.memory, vars->first, vars->second);
 			return;
 		}
 	}
@@ -112,7 +122,8 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 	std::set<YulName> names;
 	for (auto const& var: _varDecl.variables)
 		names.emplace(var.name);
-	m_variableScopes.back().variables += names;
+	for (YulName name: names)
+		m_variableScopes.back().variables.insert(name);
 
 	if (_varDecl.value)
 	{
@@ -165,10 +176,10 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
-		m_variableScopes.back().variables.emplace(parameter.name);
+		m_variableScopes.back().variables.insert(parameter.name);
 	for (auto const& var: _fun.returnVariables)
 	{
-		m_variableScopes.back().variables.emplace(var.name);
+		m_variableScopes.back().variables.insert(var.name);
 		handleAssignment({var.name}, nullptr, true);
 	}
 	ASTModifier::operator()(_fun);
@@ -224,7 +235,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 std::optional<YulName> DataFlowAnalyzer::storageValue(YulName _key) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.storage, _key))
+	if (YulName const* value = valueOrNullptr(*m_state.environment.storage, _key))
 		return *value;
 	else
 		return std::nullopt;
@@ -232,15 +243,39 @@ std::optional<YulName> DataFlowAnalyzer::storageValue(YulName _key) const
 
 std::optional<YulName> DataFlowAnalyzer::memoryValue(YulName _key) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.memory, _key))
+	if (YulName const* value = valueOrNullptr(*m_state.environment.memory, _key))
 		return *value;
 	else
 		return std::nullopt;
 }
 
+std::optional<bytes> DataFlowAnalyzer::memoryContentIfKnownConstant(YulName _start, YulName _length)
+{
+	std::optional<u256> length = m_knowledgeBase.valueIfKnownConstant(_length);
+	if (!length || *length > c_maxKnownMemoryContentLength)
+		return std::nullopt;
+
+	// Words that are stored to are pairwise at least 32 bytes apart, so a word at an offset
+	// that is a multiple of 32 cannot overlap with any other known word of the area.
+	std::vector<std::optional<u256>> words((static_cast<size_t>(*length) + 31) / 32);
+	for (auto const& [key, value]: *m_state.environment.memory)
+		if (std::optional<u256> offset = m_knowledgeBase.differenceIfKnownConstant(key, _start))
+			if (*offset % 32 == 0 && *offset / 32 < words.size() && inScope(value))
+				words[static_cast<size_t>(*offset / 32)] = valueOfIdentifier(value);
+
+	bytes content;
+	for (std::optional<u256> const& word: words)
+		if (word)
+			content += toBigEndian(*word);
+		else
+			return std::nullopt;
+	content.resize(static_cast<size_t>(*length));
+	return content;
+}
+
 std::optional<YulName> DataFlowAnalyzer::keccakValue(YulName _start, YulName _length) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.keccak, std::make_pair(_start, _length)))
+	if (YulName const* value = valueOrNullptr(*m_state.environment.keccak, std::make_pair(_start, _length)))
 		return *value;
 	else
 		return std::nullopt;
@@ -273,17 +308,17 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulName> const& _variables, Exp
 		m_state.references[name] = referencedVariables;
 		if (!_isDeclaration)
 		{
-			// assignment to slot denoted by "name"
-			m_state.environment.storage.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
-			// assignment to slot denoted by "name"
-			m_state.environment.memory.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.keccak, [&name](auto&& _item) {
+			// assignment to slot denoted by "name" or to slot contents denoted by "name"
+			eraseIf(m_state.environment.storage, mapTuple([&name](auto&& key, auto&& value) {
+				return key == name || value == name;
+			}));
+			eraseIf(m_state.environment.keccak, [&name](auto&& _item) {
 				return _item.first.first == name || _item.first.second == name || _item.second == name;
 			});
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			// assignment to slot denoted by "name" or to slot contents denoted by "name"
+			eraseIf(m_state.environment.memory, mapTuple([&name](auto&& key, auto&& value) {
+				return key == name || value == name;
+			}));
 		}
 	}
 
@@ -296,11 +331,11 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulName> const& _variables, Exp
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_state.environment.memory[*key] = variable;
+				assignIfDifferent(m_state.environment.memory, *key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_state.environment.storage[*key] = variable;
+				assignIfDifferent(m_state.environment.storage, *key, variable);
 			else if (auto arguments = isKeccak(*_value))
-				m_state.environment.keccak[*arguments] = variable;
+				assignIfDifferent(m_state.environment.keccak, *arguments, variable);
 		}
 	}
 }
@@ -341,9 +376,9 @@ void DataFlowAnalyzer::clearValues(std::set<YulName> _variables)
 	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
 		return _variables.count(key) || _variables.count(value);
 	});
-	cxx20::erase_if(m_state.environment.storage, eraseCondition);
-	cxx20::erase_if(m_state.environment.memory, eraseCondition);
-	cxx20::erase_if(m_state.environment.keccak, [&_variables](auto&& _item) {
+	eraseIf(m_state.environment.storage, eraseCondition);
+	eraseIf(m_state.environment.memory, eraseCondition);
+	eraseIf(m_state.environment.keccak, [&_variables](auto&& _item) {
 		return
 			_variables.count(_item.first.first) ||
 			_variables.count(_item.first.second) ||
@@ -376,7 +411,7 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 		return;
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
+		clearStorageKnowledge(StorageWriteCollector::storageWrites(m_dialect, _block, m_functionStorageWrites));
 	if (sideEffects.invalidatesMemory())
 	{
 		m_state.environment.memory.clear();
@@ -390,7 +425,7 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 		return;
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
+		clearStorageKnowledge(StorageWriteCollector::storageWrites(m_dialect, _expr, m_functionStorageWrites));
 	if (sideEffects.invalidatesMemory())
 	{
 		m_state.environment.memory.clear();
@@ -398,6 +433,21 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 	}
 }
 
+void DataFlowAnalyzer::clearStorageKnowledge(StorageWrites const& _writes)
+{
+	if (_writes.anySlot())
+	{
+		m_state.environment.storage.clear();
+		return;
+	}
+	if (_writes.none())
+		return;
+	eraseIf(m_state.environment.storage, mapTuple([&](auto&& key, auto&& /* value */) {
+		std::optional<u256> slot = m_knowledgeBase.valueIfKnownConstant(key);
+		return !slot || _writes.slots->count(*slot);
+	}));
+}
+
 bool DataFlowAnalyzer::inScope(YulName _variableName) const
 {
 	for (auto const& scope: m_variableScopes | ranges::views::reverse)
@@ -459,23 +509,29 @@ void DataFlowAnalyzer::joinKnowledge(Environment const& _olderEnvironment)
 		return;
 	joinKnowledgeHelper(m_state.environment.storage, _olderEnvironment.storage);
 	joinKnowledgeHelper(m_state.environment.memory, _olderEnvironment.memory);
-	cxx20::erase_if(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
-		YulName const* oldValue = valueOrNullptr(_olderEnvironment.keccak, key);
+	if (m_state.environment.keccak.sharesValueWith(_olderEnvironment.keccak))
+		return;
+	eraseIf(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
+		YulName const* oldValue = valueOrNullptr(*_olderEnvironment.keccak, key);
 		return !oldValue || *oldValue != currentValue;
 	}));
 }
 
 void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulName, YulName>& _this,
-	std::unordered_map<YulName, YulName> const& _older
+	CopyOnWrite<std::unordered_map<YulName, YulName>>& _this,
+	CopyOnWrite<std::unordered_map<YulName, YulName>> const& _older
 )
 {
+	// Nothing changed since the older point.
+	if (_this.sharesValueWith(_older))
+		return;
+
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
 	// of m_state.environment.memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_state.environment.memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulName const* oldValue = valueOrNullptr(_older, key);
+	eraseIf(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
+		YulName const* oldValue = valueOrNullptr(*_older, key);
 		return !oldValue || *oldValue != currentValue;
 	}));
 }
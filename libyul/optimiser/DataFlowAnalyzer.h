@@ -25,15 +25,21 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/StorageWriteCollector.h>
 #include <libyul/YulName.h>
+#include <libyul/YulNameMap.h>
 #include <libyul/AST.h> // Needed for m_zero below.
 #include <libyul/SideEffects.h>
 
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Common.h>
+#include <libsolutil/cxx20.h>
 
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -65,6 +71,9 @@ struct AssignedValue
  *   where we cannot prove x != t or y == m_storage[t] using the current values of the variables x and t.
  * Otherwise, determine if the statement invalidates storage/memory. If yes, clear all knowledge
  * about storage/memory before visiting the statement. Then visit the statement.
+ * If the storage slots the statement may write to are known (from literal slots of sstore and
+ * the summaries of the called functions), only the knowledge about slots that are not known to be
+ * different from these is cleared.
  *
  * For forward-joining control flow, storage/memory information from the branches is combined.
  * If the keys or values are different or non-existent in one branch, the key is deleted.
@@ -86,10 +95,14 @@ public:
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
 	///            The parameter is mostly used to determine movability of expressions.
+	/// @param _functionStorageWrites
+	///            Storage slots written by user-defined functions. Functions not found
+	///            are assumed to write to any slot if their side-effects allow it.
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
 		MemoryAndStorage _analyzeStores,
-		std::map<YulName, SideEffects> _functionSideEffects = {}
+		std::map<YulName, SideEffects> _functionSideEffects = {},
+		std::map<YulName, StorageWrites> _functionStorageWrites = {}
 	);
 
 	using ASTModifier::operator();
@@ -105,7 +118,7 @@ public:
 	/// @returns the current value of the given variable, if known - always movable.
 	AssignedValue const* variableValue(YulName _variable) const { return util::valueOrNullptr(m_state.value, _variable); }
 	std::set<YulName> const* references(YulName _variable) const { return util::valueOrNullptr(m_state.references, _variable); }
-	std::map<YulName, AssignedValue> const& allValues() const { return m_state.value; }
+	YulNameMap<AssignedValue> const& allValues() const { return m_state.value; }
 	std::optional<YulName> storageValue(YulName _key) const;
 	std::optional<YulName> memoryValue(YulName _key) const;
 	std::optional<YulName> keccakValue(YulName _start, YulName _length) const;
@@ -138,6 +151,12 @@ protected:
 	/// Returns the literal value of the identifier, if it exists.
 	std::optional<u256> valueOfIdentifier(YulName const& _name) const;
 
+	/// Maximum length of a memory area whose content is reconstructed by memoryContentIfKnownConstant.
+	static constexpr size_t c_maxKnownMemoryContentLength = 256;
+	/// @returns the content of the memory area starting at @a _start if its length @a _length is a
+	/// known constant and all words in the area are known to hold constants.
+	std::optional<bytes> memoryContentIfKnownConstant(YulName _start, YulName _length);
+
 	enum class StoreLoadLocation {
 		Memory = 0,
 		Storage = 1,
@@ -166,25 +185,59 @@ protected:
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulName, SideEffects> m_functionSideEffects;
+	/// Storage slots written by user-defined functions. Any slot is assumed
+	/// if this is not provided or the function is not found.
+	std::map<YulName, StorageWrites> m_functionStorageWrites;
 
 private:
+	/// Value that is shared between copies until one of them is modified, so that
+	/// saving the environment at control-flow splits does not copy its contents.
+	template<typename T>
+	class CopyOnWrite
+	{
+	public:
+		T const& operator*() const { return *m_value; }
+		T const* operator->() const { return m_value.get(); }
+		/// @returns a reference to a value not shared with any other copy.
+		T& modify()
+		{
+			if (m_value.use_count() > 1)
+				m_value = std::make_shared<T>(*m_value);
+			return *m_value;
+		}
+		void clear()
+		{
+			if (!m_value->empty())
+				m_value = std::make_shared<T>();
+		}
+		bool isShared() const { return m_value.use_count() > 1; }
+		/// @returns true if both copies share the same value, i.e. neither was modified since the copy.
+		bool sharesValueWith(CopyOnWrite const& _other) const { return m_value == _other.m_value; }
+
+	private:
+		std::shared_ptr<T> m_value = std::make_shared<T>();
+	};
+
 	struct Environment
 	{
-		std::unordered_map<YulName, YulName> storage;
-		std::unordered_map<YulName, YulName> memory;
+		CopyOnWrite<std::unordered_map<YulName, YulName>> storage;
+		CopyOnWrite<std::unordered_map<YulName, YulName>> memory;
 		/// If keccak[s, l] = y then y := keccak256(s, l) occurs in the code.
-		std::map<std::pair<YulName, YulName>, YulName> keccak;
+		CopyOnWrite<std::map<std::pair<YulName, YulName>, YulName>> keccak;
 	};
 	struct State
 	{
 		/// Current values of variables, always movable.
-		std::map<YulName, AssignedValue> value;
+		YulNameMap<AssignedValue> value;
 		/// m_references[a].contains(b) <=> the current expression assigned to a references b
-		std::unordered_map<YulName, std::set<YulName>> references;
+		YulNameMap<std::set<YulName>> references;
 
 		Environment environment;
 	};
 
+	/// Clears knowledge about the storage slots that are not known to be different from @a _writes.
+	void clearStorageKnowledge(StorageWrites const& _writes);
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_olderState.storage` and `_olderState.memory` cannot have additional changes.
@@ -192,10 +245,28 @@ private:
 	void joinKnowledge(Environment const& _olderEnvironment);
 
 	static void joinKnowledgeHelper(
-		std::unordered_map<YulName, YulName>& _thisData,
-		std::unordered_map<YulName, YulName> const& _olderData
+		CopyOnWrite<std::unordered_map<YulName, YulName>>& _thisData,
+		CopyOnWrite<std::unordered_map<YulName, YulName>> const& _olderData
 	);
 
+	/// Removes all elements matching @a _predicate from @a _container without
+	/// unsharing it if there are none.
+	template<typename Container, typename Predicate>
+	static void eraseIf(CopyOnWrite<Container>& _container, Predicate const& _predicate)
+	{
+		if (_container.isShared() && std::none_of(_container->begin(), _container->end(), _predicate))
+			return;
+		cxx20::erase_if(_container.modify(), _predicate);
+	}
+	/// Sets @a _container[_key] to @a _value without unsharing it if it already has that value.
+	template<typename Container, typename Key>
+	static void assignIfDifferent(CopyOnWrite<Container>& _container, Key const& _key, YulName _value)
+	{
+		auto it = _container->find(_key);
+		if (it == _container->end() || it->second != _value)
+			_container.modify()[_key] = _value;
+	}
+
 	State m_state;
 
 protected:
@@ -212,7 +283,7 @@ protected:
 	struct Scope
 	{
 		explicit Scope(bool _isFunction): isFunction(_isFunction) {}
-		std::set<YulName> variables;
+		YulNameSet variables;
 		bool isFunction;
 	};
 	/// Special expression whose address will be used in m_value.
@@ -30,6 +30,72 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+/**
+ * Replaces identifiers in place. Visits the identifiers in the same order as the ASTCopier,
+ * so that the same names are chosen as when translating a copy.
+ */
+class Disambiguator::InPlaceTranslator: public ASTModifier
+{
+public:
+	explicit InPlaceTranslator(Disambiguator& _disambiguator): m_disambiguator(_disambiguator) {}
+
+	using ASTModifier::operator();
+	void operator()(Identifier& _identifier) override
+	{
+		_identifier.name = m_disambiguator.translateIdentifier(_identifier.name);
+	}
+	void operator()(FunctionCall& _funCall) override
+	{
+		(*this)(_funCall.functionName);
+		walkVector(_funCall.arguments);
+	}
+	void operator()(VariableDeclaration& _varDecl) override
+	{
+		translate(_varDecl.variables);
+		ASTModifier::operator()(_varDecl);
+	}
+	void operator()(FunctionDefinition& _function) override
+	{
+		_function.name = m_disambiguator.translateIdentifier(_function.name);
+		m_disambiguator.enterFunction(_function);
+		translate(_function.parameters);
+		translate(_function.returnVariables);
+		(*this)(_function.body);
+		m_disambiguator.leaveFunction(_function);
+	}
+	void operator()(ForLoop& _forLoop) override
+	{
+		m_disambiguator.enterScope(_forLoop.pre);
+		ASTModifier::operator()(_forLoop);
+		m_disambiguator.leaveScope(_forLoop.pre);
+	}
+	void operator()(Block& _block) override
+	{
+		m_disambiguator.enterScope(_block);
+		ASTModifier::operator()(_block);
+		m_disambiguator.leaveScope(_block);
+	}
+
+private:
+	void translate(NameWithDebugDataList& _names)
+	{
+		for (NameWithDebugData& name: _names)
+			name.name = m_disambiguator.translateIdentifier(name.name);
+	}
+
+	Disambiguator& m_disambiguator;
+};
+
+void Disambiguator::disambiguateInPlace(Block& _ast)
+{
+	InPlaceTranslator{*this}(_ast);
+}
+
+NameDispenser Disambiguator::nameDispenser() const
+{
+	return NameDispenser{m_dialect, m_nameDispenser.usedNames(), m_externallyUsedIdentifiers};
+}
+
 YulName Disambiguator::translateIdentifier(YulName _originalName)
 {
 	if (m_dialect.builtin(_originalName) || m_externallyUsedIdentifiers.count(_originalName))
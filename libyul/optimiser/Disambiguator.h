@@ -24,6 +24,7 @@
 #include <libyul/ASTForward.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDispenser.h>
 
 #include <optional>
@@ -35,6 +36,9 @@ struct Dialect;
 
 /**
  * Creates a copy of a Yul AST replacing all identifiers by unique names.
+ *
+ * If the caller owns the analysed AST, the identifiers can also be replaced in place
+ * using disambiguateInPlace(), which results in the same names.
  */
 class Disambiguator: public ASTCopier
 {
@@ -51,6 +55,15 @@ public:
 	{
 	}
 
+	/// Replaces all identifiers in @a _ast by unique names without copying it.
+	/// @a _ast has to be the AST the analysis info passed to the constructor was created for.
+	void disambiguateInPlace(Block& _ast);
+
+	/// @returns a name dispenser that considers all names of the translated code and the externally
+	/// used identifiers as used, i.e. one that is equivalent to a dispenser created from the
+	/// translated code, but without having to collect its names again.
+	NameDispenser nameDispenser() const;
+
 protected:
 	void enterScope(Block const& _block) override;
 	void leaveScope(Block const& _block) override;
@@ -61,6 +74,8 @@ protected:
 	void enterScopeInternal(Scope& _scope);
 	void leaveScopeInternal(Scope& _scope);
 
+	class InPlaceTranslator;
+
 	AsmAnalysisInfo const& m_info;
 	Dialect const& m_dialect;
 	std::set<YulName> const& m_externallyUsedIdentifiers;
@@ -37,7 +37,8 @@ void EqualStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast
 {
 	EqualStoreEliminator eliminator{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		StorageWriteCollector::functionStorageWrites(_context.dialect, _ast)
 	};
 	eliminator(_ast);
 
@@ -20,22 +20,56 @@
  */
 
 #include <libyul/optimiser/EquivalentFunctionDetector.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 
 #include <libyul/AST.h>
-#include <libyul/optimiser/Metrics.h>
 
 using namespace solidity;
 using namespace solidity::yul;
 
+std::map<YulName, FunctionDefinition const*> EquivalentFunctionDetector::run(Block& _block)
+{
+	EquivalentFunctionDetector detector;
+	detector(_block);
+
+	CallGraph callGraph = CallGraphGenerator::callGraph(_block);
+	std::set<YulName> visited;
+	for (YulName name: detector.m_functionNames)
+		detector.visitInCallOrder(name, callGraph, visited);
+	return std::move(detector.m_duplicates);
+}
+
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	uint64_t bodyHash = m_blockHashes[&_fun.body];
-	auto& candidates = m_candidates[bodyHash];
+	m_functions[_fun.name] = &_fun;
+	m_functionNames.emplace_back(_fun.name);
+	ASTWalker::operator()(_fun);
+}
+
+void EquivalentFunctionDetector::visitInCallOrder(
+	YulName _function,
+	CallGraph const& _callGraph,
+	std::set<YulName>& _visited
+)
+{
+	if (!_visited.insert(_function).second)
+		return;
+	for (YulName callee: _callGraph.functionCalls.at(_function))
+		if (m_functions.count(callee))
+			visitInCallOrder(callee, _callGraph, _visited);
+	checkForDuplicate(*m_functions.at(_function));
+}
+
+void EquivalentFunctionDetector::checkForDuplicate(FunctionDefinition const& _fun)
+{
+	uint64_t hash = BlockHasher::functionHash(_fun, m_representatives);
+	auto& candidates = m_candidates[hash];
 	for (auto const& candidate: candidates)
-		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
+		if (SyntacticallyEqual{m_representatives}.statementEqual(_fun, *candidate))
 		{
 			m_duplicates[_fun.name] = candidate;
+			m_representatives[_fun.name] = candidate->name;
 			return;
 		}
 	candidates.push_back(&_fun);
@@ -21,8 +21,13 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
-#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/ASTForward.h>
+#include <libyul/YulName.h>
+
+#include <map>
+#include <set>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -30,26 +35,37 @@ namespace solidity::yul
 /**
  * Optimiser component that detects syntactically equivalent functions.
  *
+ * Functions are bucketed by a hash that does not depend on the names of their variables,
+ * but on the positions of parameters and return variables, and only compared
+ * to the functions in the same bucket.
+ *
+ * Functions are visited such that called functions are visited before the functions
+ * calling them (except for recursion). Calls to functions already found to be duplicates
+ * are considered to be calls to the function they are a duplicate of, so functions
+ * that only differ in calling equivalent functions are detected in a single run.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
 class EquivalentFunctionDetector: public ASTWalker
 {
 public:
-	static std::map<YulName, FunctionDefinition const*> run(Block& _block)
-	{
-		EquivalentFunctionDetector detector{BlockHasher::run(_block)};
-		detector(_block);
-		return std::move(detector.m_duplicates);
-	}
+	static std::map<YulName, FunctionDefinition const*> run(Block& _block);
 
 	using ASTWalker::operator();
 	void operator()(FunctionDefinition const& _fun) override;
 
 private:
-	EquivalentFunctionDetector(std::map<Block const*, uint64_t> _blockHashes): m_blockHashes(std::move(_blockHashes)) {}
+	EquivalentFunctionDetector() = default;
+
+	void visitInCallOrder(YulName _function, CallGraph const& _callGraph, std::set<YulName>& _visited);
+	void checkForDuplicate(FunctionDefinition const& _fun);
 
-	std::map<Block const*, uint64_t> m_blockHashes;
+	std::map<YulName, FunctionDefinition const*> m_functions;
+	/// Names of the functions in the order of their definitions.
+	std::vector<YulName> m_functionNames;
 	std::map<uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
+	/// Maps the names of duplicate functions to the names of the functions they are a duplicate of.
+	std::map<YulName, YulName> m_representatives;
 	std::map<YulName, FunctionDefinition const*> m_duplicates;
 };
 
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/ExpressionNumbering.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/Visitor.h>
+
+#include <cstdint>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+ExpressionNumbering::Number ExpressionNumbering::operator()(Expression const& _expression)
+{
+	return std::visit(util::GenericVisitor{
+		[&](Literal const& _literal) { return literal(_literal.value); },
+		[&](Identifier const& _identifier) { return identifier(_identifier.name); },
+		[&](FunctionCall const& _functionCall) {
+			std::vector<Number> arguments;
+			arguments.reserve(_functionCall.arguments.size());
+			for (Expression const& argument: _functionCall.arguments)
+				arguments.emplace_back((*this)(argument));
+			return functionCall(_functionCall.functionName.name, std::move(arguments));
+		}
+	}, _expression);
+}
+
+ExpressionNumbering::Number ExpressionNumbering::literal(LiteralValue const& _value)
+{
+	auto [it, inserted] = m_literals.try_emplace(_value, m_nextNumber);
+	if (inserted)
+		++m_nextNumber;
+	return it->second;
+}
+
+ExpressionNumbering::Number ExpressionNumbering::identifier(YulName _name)
+{
+	if (auto it = m_identifiers.find(_name); it != m_identifiers.end())
+		return it->second;
+	return m_identifiers[_name] = m_nextNumber++;
+}
+
+ExpressionNumbering::Number ExpressionNumbering::functionCall(YulName _functionName, std::vector<Number> _argumentNumbers)
+{
+	auto [it, inserted] = m_functionCalls.try_emplace(FunctionCallKey{_functionName, std::move(_argumentNumbers)}, m_nextNumber);
+	if (inserted)
+		++m_nextNumber;
+	return it->second;
+}
+
+size_t ExpressionNumbering::FunctionCallKeyHash::operator()(FunctionCallKey const& _key) const
+{
+	std::uint64_t hash = _key.functionName.hash();
+	for (Number argument: _key.arguments)
+		hash = (hash ^ static_cast<std::uint64_t>(argument)) * HasherBase::fnvPrime;
+	return static_cast<size_t>(hash);
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Value numbering of Yul expressions by hash-consing.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulName.h>
+#include <libyul/YulNameMap.h>
+#include <libyul/AST.h>
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Assigns numbers to expressions such that two expressions receive the same number
+ * if and only if they are syntactically equal, i.e. comparing two expressions becomes
+ * an integer comparison.
+ *
+ * Identifiers are numbered by their name and literals by their value, which matches
+ * SyntacticallyEqual on expressions from a disambiguated AST. The number of a function call
+ * only depends on the function name and the numbers of its arguments, so callers that
+ * visit expressions bottom-up can number every node in constant time using
+ * @a functionCall() instead of re-traversing subexpressions.
+ *
+ * Numbers are only meaningful within one instance.
+ *
+ * Prerequisite: Disambiguator
+ */
+class ExpressionNumbering
+{
+public:
+	using Number = size_t;
+
+	/// @returns the number of @a _expression, numbering all its subexpressions.
+	Number operator()(Expression const& _expression);
+
+	Number literal(LiteralValue const& _value);
+	Number identifier(YulName _name);
+	Number functionCall(YulName _functionName, std::vector<Number> _argumentNumbers);
+
+	/// @returns the number of expressions that are not syntactically equal to each other
+	/// numbered so far.
+	size_t size() const { return m_nextNumber; }
+
+private:
+	struct FunctionCallKey
+	{
+		YulName functionName;
+		std::vector<Number> arguments;
+
+		bool operator==(FunctionCallKey const& _other) const
+		{
+			return functionName == _other.functionName && arguments == _other.arguments;
+		}
+	};
+	struct FunctionCallKeyHash
+	{
+		size_t operator()(FunctionCallKey const& _key) const;
+	};
+
+	std::map<LiteralValue, Number> m_literals;
+	YulNameMap<Number> m_identifiers;
+	std::unordered_map<FunctionCallKey, Number, FunctionCallKeyHash> m_functionCalls;
+	Number m_nextNumber = 0;
+};
+
+}
@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/ExpressionSimplifier.h>
 
+#include <libyul/optimiser/FunctionParallelism.h>
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
@@ -34,7 +35,13 @@ using namespace solidity::yul;
 
 void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	bool const ranInParallel = runOnTopLevelStatementsInParallel(_context, _ast, [&](size_t _begin, size_t _end) {
+		ExpressionSimplifier simplifier{_context.dialect};
+		for (size_t i = _begin; i < _end; ++i)
+			simplifier.visit(_ast.statements[i]);
+	});
+	if (!ranInParallel)
+		ExpressionSimplifier{_context.dialect}(_ast);
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
@@ -48,6 +48,7 @@ public:
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
+	using ASTModifier::visit;
 	void visit(Expression& _expression) override;
 
 private:
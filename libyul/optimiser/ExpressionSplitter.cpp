@@ -103,6 +103,6 @@ void ExpressionSplitter::outlineExpression(Expression& _expr)
 		{{NameWithDebugData{debugData, var}}},
 		std::make_unique<Expression>(std::move(_expr))
 	});
-	_expr = Identifier{debugData, var};
+	_expr = Identifier{std::move(debugData), var};
 }
 
@@ -51,8 +51,9 @@ void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 	inliner.run(Pass::InlineRest);
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
+FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect, Budget _budget):
 	m_ast(_ast),
+	m_budget(_budget),
 	m_recursiveFunctions(CallGraphGenerator::callGraph(_ast).recursiveFunctions()),
 	m_nameDispenser(_dispenser),
 	m_dialect(_dialect)
@@ -70,10 +71,17 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 	std::map<YulName, size_t> references = ReferencesCounter::countReferences(m_ast);
 	for (auto& statement: m_ast.statements)
 	{
+		if (Block const* block = std::get_if<Block>(&statement))
+		{
+			for (auto const& [name, count]: ReferencesCounter::countReferences(*block))
+				m_callCounts[YulName{}][name] += count;
+			continue;
+		}
 		if (!std::holds_alternative<FunctionDefinition>(statement))
 			continue;
 		FunctionDefinition& fun = std::get<FunctionDefinition>(statement);
 		m_functions[fun.name] = &fun;
+		m_callCounts[fun.name] = ReferencesCounter::countReferences(fun.body);
 		if (LeaveFinder::containsLeave(fun))
 			m_noInlineFunctions.insert(fun.name);
 		// Always inline functions that are only called once.
@@ -87,6 +95,15 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 	// We will perform less aggressive inlining, if no ``memoryguard`` call is found.
 	if (!memoryGuardCalls.empty())
 		m_hasMemoryGuard = true;
+
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	// No aggressive inlining with the old code transform
+	// and if we cannot perform stack-to-memory.
+	m_aggressiveInliningPossible =
+		evmDialect &&
+		evmDialect->providesObjectAccess() &&
+		evmDialect->evmVersion() > langutil::EVMVersion::homestead() &&
+		m_hasMemoryGuard;
 }
 
 void FullInliner::run(Pass _pass)
@@ -193,27 +210,17 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
 
 	// Inline really, really tiny functions
 	size_t size = m_functionSizes.at(calledFunction->name);
-	if (size <= 1)
+	if (size <= m_budget.tinyFunctionSize)
 		return true;
 
 	// In the first pass, only inline tiny functions.
 	if (m_pass == Pass::InlineTiny)
 		return false;
 
-	bool aggressiveInlining = true;
-
-	if (
-		EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect);
-		!evmDialect || !evmDialect->providesObjectAccess() || evmDialect->evmVersion() <= langutil::EVMVersion::homestead()
-	)
-		// No aggressive inlining with the old code transform.
-		aggressiveInlining = false;
-
 	// No aggressive inlining, if we cannot perform stack-to-memory.
-	if (!m_hasMemoryGuard || m_recursiveFunctions.count(_callSite))
-		aggressiveInlining = false;
+	bool aggressiveInlining = m_aggressiveInliningPossible && !m_recursiveFunctions.count(_callSite);
 
-	if (!aggressiveInlining && m_functionSizes.at(_callSite) > 45)
+	if (!aggressiveInlining && m_functionSizes.at(_callSite) > m_budget.maxCallSiteSizeWithoutStackToMemory)
 		return false;
 
 	if (m_singleUse.count(calledFunction->name))
@@ -231,12 +238,23 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
 			break;
 		}
 
-	return (size < (aggressiveInlining ? 8u : 6u) || (constantArg && size < (aggressiveInlining ? 16u : 12u)));
+	if (aggressiveInlining)
+		return size < m_budget.smallFunctionSizeAggressive || (constantArg && size < m_budget.smallFunctionSizeConstantArgumentAggressive);
+	else
+		return size < m_budget.smallFunctionSize || (constantArg && size < m_budget.smallFunctionSizeConstantArgument);
 }
 
-void FullInliner::tentativelyUpdateCodeSize(YulName _function, YulName _callSite)
+void FullInliner::recordInlining(YulName _function, YulName _callSite)
 {
+	yulAssert(_function != _callSite);
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+
+	std::map<YulName, size_t>& callSiteCalls = m_callCounts[_callSite];
+	size_t& directCalls = callSiteCalls[_function];
+	yulAssert(directCalls > 0);
+	--directCalls;
+	for (auto const& [callee, count]: m_callCounts[_function])
+		callSiteCalls[callee] += count;
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
@@ -251,8 +269,8 @@ void FullInliner::handleBlock(YulName _currentFunctionName, Block& _block)
 
 bool FullInliner::recursive(FunctionDefinition const& _fun) const
 {
-	std::map<YulName, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	auto calls = m_callCounts.find(_fun.name);
+	return calls != m_callCounts.end() && util::valueOrDefault(calls->second, _fun.name, size_t(0), util::allow_copy) > 0;
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -294,7 +312,7 @@ std::vector<Statement> InlineModifier::performInline(Statement& _statement, Func
 	FunctionDefinition* function = m_driver.function(_funCall.functionName.name);
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
-	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	m_driver.recordInlining(function->name, m_currentFunction);
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
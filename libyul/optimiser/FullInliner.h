@@ -73,6 +73,21 @@ public:
 	static constexpr char const* name{"FullInliner"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
 
+	/// Size limits, in terms of CodeSize, used by the inlining heuristic.
+	struct Budget
+	{
+		/// Functions up to this size are inlined in both passes.
+		size_t tinyFunctionSize = 1;
+		/// Limit on the size of the calling function if code cannot be moved to memory later.
+		size_t maxCallSiteSizeWithoutStackToMemory = 45;
+		/// Functions below this size are inlined.
+		size_t smallFunctionSize = 6;
+		size_t smallFunctionSizeAggressive = 8;
+		/// Functions below this size are inlined if an argument is constant.
+		size_t smallFunctionSizeConstantArgument = 12;
+		size_t smallFunctionSizeConstantArgumentAggressive = 16;
+	};
+
 	/// Inlining heuristic.
 	/// @param _callSite the name of the function in which the function call is located.
 	bool shallInline(FunctionCall const& _funCall, YulName _callSite);
@@ -85,15 +100,17 @@ public:
 		return nullptr;
 	}
 
-	/// Adds the size of _funCall to the size of _callSite. This is just
+	/// Updates the cost model for one call to @a _function being inlined into @a _callSite.
+	/// Adds the size of _function to the size of _callSite. This is just
 	/// a rough estimate that is done during inlining. The proper size
-	/// should be determined after inlining is completed.
-	void tentativelyUpdateCodeSize(YulName _function, YulName _callSite);
+	/// is determined after inlining into _callSite is completed.
+	/// The call counts are exact, since the inlined code is a copy of the body of _function.
+	void recordInlining(YulName _function, YulName _callSite);
 
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect, Budget _budget = {});
 	void run(Pass _pass);
 
 	/// @returns a map containing the maximum depths of a call chain starting at each
@@ -102,6 +119,7 @@ private:
 
 	void updateCodeSize(FunctionDefinition const& _fun);
 	void handleBlock(YulName _currentFunctionName, Block& _block);
+	/// @returns true if the current body of @a _fun calls @a _fun.
 	bool recursive(FunctionDefinition const& _fun) const;
 
 	Pass m_pass;
@@ -111,8 +129,11 @@ private:
 	std::map<YulName, FunctionDefinition*> m_functions;
 	/// Functions not to be inlined (because they contain the ``leave`` statement).
 	std::set<YulName> m_noInlineFunctions;
+	Budget m_budget;
 	/// True, if the code contains a ``memoryguard`` and we can expect to be able to move variables to memory later.
 	bool m_hasMemoryGuard = false;
+	/// True, if the dialect and the code allow aggressive inlining in non-recursive functions.
+	bool m_aggressiveInliningPossible = false;
 	/// Set of recursive functions.
 	std::set<YulName> m_recursiveFunctions;
 	/// Names of functions to always inline.
@@ -120,6 +141,10 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulName> m_constants;
 	std::map<YulName, size_t> m_functionSizes;
+	/// Number of references to each name from the body of each function (the empty name
+	/// stands for the global statements). The counts of function calls are kept up to date
+	/// during inlining.
+	std::map<YulName, std::map<YulName, size_t>> m_callCounts;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
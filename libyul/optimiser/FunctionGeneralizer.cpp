@@ -0,0 +1,214 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that merges functions that only differ in literals.
+ */
+
+#include <libyul/optimiser/FunctionGeneralizer.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <map>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Minimum code size of the body of a function to be merged.
+size_t constexpr c_minBodySize = 8;
+/// Maximum number of parameters added to a function.
+size_t constexpr c_maxNewParameters = 2;
+/// Maximum number of parameters and return variables of a merged function.
+size_t constexpr c_maxVariables = 8;
+
+/// Collects the literals that could be replaced by variables in the order they are visited.
+class ReplaceableLiteralCollector: public ASTModifier
+{
+public:
+	explicit ReplaceableLiteralCollector(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _funCall) override
+	{
+		BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name);
+		for (size_t i = _funCall.arguments.size(); i > 0; --i)
+			if (!builtin || !builtin->literalArgument(i - 1))
+				visit(_funCall.arguments[i - 1]);
+	}
+	void visit(Expression& _expression) override
+	{
+		if (Literal const* literal = std::get_if<Literal>(&_expression))
+		{
+			if (!literal->value.unlimited())
+				literals.emplace_back(&_expression);
+		}
+		else
+			ASTModifier::visit(_expression);
+	}
+
+	std::vector<Expression*> literals;
+
+private:
+	Dialect const& m_dialect;
+};
+
+struct FunctionInfo
+{
+	FunctionDefinition* function = nullptr;
+	/// The function with all replaceable literals set to zero.
+	FunctionDefinition normalized;
+	/// The replaceable literals of the original function.
+	std::vector<Expression*> literals;
+};
+
+/// Appends the given literal arguments to calls to the given functions and redirects them.
+class CallRewriter: public ASTModifier
+{
+public:
+	struct Target
+	{
+		YulName function;
+		std::vector<Literal> arguments;
+	};
+
+	explicit CallRewriter(std::map<YulName, Target> _targets): m_targets(std::move(_targets)) {}
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _funCall) override
+	{
+		ASTModifier::operator()(_funCall);
+		if (Target const* target = util::valueOrNullptr(m_targets, _funCall.functionName.name))
+		{
+			_funCall.functionName.name = target->function;
+			for (Literal const& argument: target->arguments)
+				_funCall.arguments.emplace_back(argument);
+		}
+	}
+
+private:
+	std::map<YulName, Target> m_targets;
+};
+
+}
+
+void FunctionGeneralizer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	std::vector<FunctionInfo> functions;
+	for (Statement& statement: _ast.statements)
+		if (FunctionDefinition* function = std::get_if<FunctionDefinition>(&statement))
+		{
+			if (CodeSize::codeSize(function->body) < c_minBodySize)
+				continue;
+			FunctionInfo& info = functions.emplace_back(FunctionInfo{
+				function,
+				std::get<FunctionDefinition>(ASTCopier{}(*function)),
+				{}
+			});
+			ReplaceableLiteralCollector originalCollector{_context.dialect};
+			originalCollector(function->body);
+			info.literals = std::move(originalCollector.literals);
+			ReplaceableLiteralCollector normalizedCollector{_context.dialect};
+			normalizedCollector(info.normalized.body);
+			for (Expression* literal: normalizedCollector.literals)
+				*literal = Literal{debugDataOf(*literal), LiteralKind::Number, LiteralValue{0, std::nullopt}};
+		}
+
+	// Groups of functions that are equal up to the replaceable literals.
+	std::vector<std::vector<FunctionInfo const*>> groups;
+	std::map<uint64_t, std::vector<size_t>> groupsByHash;
+	for (FunctionInfo const& info: functions)
+	{
+		std::vector<size_t>& candidates = groupsByHash[BlockHasher::functionHash(info.normalized, {})];
+		bool found = false;
+		for (size_t candidate: candidates)
+			if (SyntacticallyEqual{}.statementEqual(info.normalized, groups[candidate].front()->normalized))
+			{
+				groups[candidate].emplace_back(&info);
+				found = true;
+				break;
+			}
+		if (!found)
+		{
+			candidates.emplace_back(groups.size());
+			groups.push_back({&info});
+		}
+	}
+
+	std::map<YulName, size_t> references = ReferencesCounter::countReferences(_ast);
+	std::map<YulName, CallRewriter::Target> targets;
+	for (auto const& group: groups)
+	{
+		if (group.size() < 2)
+			continue;
+		FunctionInfo const& representative = *group.front();
+		std::vector<size_t> differingLiterals;
+		for (size_t i = 0; i < representative.literals.size(); ++i)
+			for (FunctionInfo const* member: group)
+				if (!(std::get<Literal>(*member->literals[i]).value == std::get<Literal>(*representative.literals[i]).value))
+				{
+					differingLiterals.emplace_back(i);
+					break;
+				}
+		// Functions without differing literals are left to the EquivalentFunctionCombiner.
+		FunctionDefinition& function = *representative.function;
+		if (
+			differingLiterals.empty() ||
+			differingLiterals.size() > c_maxNewParameters ||
+			function.parameters.size() + function.returnVariables.size() + differingLiterals.size() > c_maxVariables
+		)
+			continue;
+
+		// Each call has to pass the additional arguments, while all but one copy of the body are removed.
+		size_t calls = 0;
+		for (FunctionInfo const* member: group)
+			calls += util::valueOrDefault(references, member->function->name);
+		if ((group.size() - 1) * CodeSize::codeSize(function.body) <= calls * differingLiterals.size())
+			continue;
+
+		for (FunctionInfo const* member: group)
+		{
+			CallRewriter::Target& target = targets[member->function->name];
+			target.function = function.name;
+			for (size_t i: differingLiterals)
+				target.arguments.emplace_back(std::get<Literal>(*member->literals[i]));
+		}
+		for (size_t i: differingLiterals)
+		{
+			Expression& literal = *representative.literals[i];
+			YulName parameter = _context.dispenser.newName({});
+			function.parameters.emplace_back(NameWithDebugData{debugDataOf(literal), parameter});
+			literal = Identifier{debugDataOf(literal), parameter};
+		}
+	}
+
+	if (!targets.empty())
+		CallRewriter{std::move(targets)}(_ast);
+}
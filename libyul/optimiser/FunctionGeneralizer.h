@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that merges functions that only differ in literals.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that merges functions which are syntactically equal except for the values of
+ * some literals into a single function that takes the differing values as additional parameters.
+ * This is the inverse of the FunctionSpecializer. For example
+ *
+ *   function f(a) { sstore(a, 1) mstore(0, a) }
+ *   function g(b) { sstore(b, 2) mstore(0, b) }
+ *   f(x)
+ *   g(y)
+ *
+ * is transformed to
+ *
+ *   function f(a, _1) { sstore(a, _1) mstore(0, a) }
+ *   function g(b) { sstore(b, 2) mstore(0, b) }
+ *   f(x, 1)
+ *   f(y, 2)
+ *
+ * so that the UnusedPruner can remove ``g``.
+ *
+ * Literals that are arguments of built-in functions requiring literal arguments and
+ * the values of switch cases are never replaced. Functions are only merged if they
+ * are large enough that removing the copies saves more code than passing the
+ * additional arguments costs and if only few parameters have to be added, since
+ * each of them occupies a stack slot.
+ *
+ * Since the FunctionSpecializer would revert the transformation, it should not be run afterwards.
+ *
+ * Prerequisite: Disambiguator, FunctionHoister.
+ */
+class FunctionGeneralizer
+{
+public:
+	static constexpr char const* name{"FunctionGeneralizer"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+};
+
+}
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/FunctionParallelism.h>
+
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+/// Number of chunks per thread. More than one chunk per thread evens out the load
+/// if functions differ a lot in size.
+size_t constexpr chunksPerThread = 4;
+}
+
+bool solidity::yul::runOnTopLevelStatementsInParallel(
+	OptimiserStepContext const& _context,
+	Block const& _ast,
+	std::function<void(size_t _begin, size_t _end)> const& _visitChunk
+)
+{
+	if (!_context.threadPool || _context.threadPool->numThreads() < 2)
+		return false;
+	size_t const numStatements = _ast.statements.size();
+	if (numStatements < 2 || !FunctionGrouper::alreadyGrouped(_ast))
+		return false;
+
+	size_t const numChunks = std::min(numStatements, _context.threadPool->numThreads() * chunksPerThread);
+	std::vector<std::future<void>> results;
+	results.reserve(numChunks);
+	for (size_t chunk = 0; chunk < numChunks; ++chunk)
+	{
+		size_t begin = numStatements * chunk / numChunks;
+		size_t end = numStatements * (chunk + 1) / numChunks;
+		results.emplace_back(_context.threadPool->submit([&_visitChunk, begin, end]() {
+			_visitChunk(begin, end);
+		}));
+	}
+
+	// Wait for all chunks before rethrowing, so that no task still accesses the AST
+	// or the caller's state once the stack is unwound.
+	for (std::future<void>& result: results)
+		result.wait();
+	for (std::future<void>& result: results)
+		result.get();
+	return true;
+}
@@ -0,0 +1,52 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helper to run optimiser steps on the functions of a Yul program in parallel.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::yul
+{
+
+struct Block;
+struct OptimiserStepContext;
+
+/**
+ * Splits the top-level statements of @a _ast into contiguous chunks and calls @a _visitChunk
+ * with the statement index range [begin, end) of each chunk on the thread pool of @a _context.
+ *
+ * Only applicable to steps that treat every function definition independently of the code
+ * around it, do not create new names and only modify the statements inside the given range.
+ * Requires @a _ast to be grouped by the FunctionGrouper, because then the top-level
+ * statements are the main block followed by function definitions only.
+ *
+ * @returns false without calling @a _visitChunk if there is no thread pool with at least two
+ * threads in the context or if the AST is not suitable. The caller is expected to
+ * process the whole AST sequentially in that case.
+ */
+bool runOnTopLevelStatementsInParallel(
+	OptimiserStepContext const& _context,
+	Block const& _ast,
+	std::function<void(size_t _begin, size_t _end)> const& _visitChunk
+);
+
+}
@@ -20,21 +20,60 @@
 
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/NameDispenser.h>
 
 #include <libyul/AST.h>
 #include <libyul/YulName.h>
+
+#include <libevmasm/GasMeter.h>
+
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Numeric.h>
 
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
+#include <algorithm>
 #include <variant>
 
+using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// Rough gas saved per execution for every argument that is not passed to the function and
+/// for every reference to a specialized parameter, i.e. the costs of a ``PUSH`` or ``DUP``.
+size_t constexpr c_gasPerSpecializedReference = 3;
+/// Rough number of bytes of bytecode per unit of the CodeSize metric.
+size_t constexpr c_bytesPerCodeSize = 2;
+/// Minimum code size the specialized functions may add regardless of the size of the code.
+size_t constexpr c_minBudget = 50;
+
+/// Calls the callback for every function call, visiting the arguments first.
+class FunctionCallCollector: public ASTWalker
+{
+public:
+	explicit FunctionCallCollector(std::function<void(FunctionCall const&)> _callback):
+		m_callback(std::move(_callback))
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		m_callback(_functionCall);
+	}
+
+private:
+	std::function<void(FunctionCall const&)> m_callback;
+};
+
+}
+
 FunctionSpecializer::LiteralArguments FunctionSpecializer::specializableArguments(
 	FunctionCall const& _f
 )
@@ -49,34 +88,112 @@ FunctionSpecializer::LiteralArguments FunctionSpecializer::specializableArgument
 	return applyMap(_f.arguments, heuristic);
 }
 
-void FunctionSpecializer::operator()(FunctionCall& _f)
+FunctionSpecializer::LiteralValues FunctionSpecializer::literalValues(LiteralArguments const& _arguments)
 {
-	ASTModifier::operator()(_f);
+	return applyMap(_arguments, [](std::optional<Expression> const& _argument) -> std::optional<LiteralValue> {
+		if (_argument)
+			return std::get<Literal>(*_argument).value;
+		return std::nullopt;
+	});
+}
 
-	// TODO When backtracking is implemented, the restriction of recursive functions can be lifted.
-	if (
-		m_dialect.builtin(_f.functionName.name) ||
-		m_recursiveFunctions.count(_f.functionName.name)
-	)
-		return;
+void FunctionSpecializer::selectSpecializations(Block const& _ast)
+{
+	struct Candidate
+	{
+		YulName function;
+		LiteralArguments arguments;
+		size_t calls = 0;
+		size_t codeSize = 0;
+		bigint gasSaved = 0;
+	};
+	std::vector<Candidate> candidates;
+	std::map<std::pair<YulName, LiteralValues>, size_t> candidateIndices;
+	std::map<YulName, size_t> callCounts;
+	FunctionCallCollector{[&](FunctionCall const& _f) {
+		// TODO When backtracking is implemented, the restriction of recursive functions can be lifted.
+		if (
+			m_dialect.builtin(_f.functionName.name) ||
+			m_recursiveFunctions.count(_f.functionName.name)
+		)
+			return;
+		++callCounts[_f.functionName.name];
 
-	LiteralArguments arguments = specializableArguments(_f);
+		LiteralArguments arguments = specializableArguments(_f);
+		if (!ranges::any_of(arguments, [](auto& _a) { return _a.has_value(); }))
+			return;
+		auto [it, inserted] = candidateIndices.emplace(
+			std::make_pair(_f.functionName.name, literalValues(arguments)),
+			candidates.size()
+		);
+		if (inserted)
+			candidates.emplace_back(Candidate{_f.functionName.name, std::move(arguments)});
+		++candidates[it->second].calls;
+	}}(_ast);
 
-	if (ranges::any_of(arguments, [](auto& _a) { return _a.has_value(); }))
+	std::map<YulName, FunctionDefinition const*> functions = allFunctionDefinitions(_ast);
+	size_t executions = m_expectedExecutionsPerDeployment.value_or(1);
+	std::vector<size_t> profitable;
+	for (auto&& [index, candidate]: candidates | ranges::views::enumerate)
 	{
-		YulName oldName = std::move(_f.functionName.name);
-		auto newName = m_nameDispenser.newName(oldName);
+		FunctionDefinition const& function = *functions.at(candidate.function);
+		std::map<YulName, size_t> references = VariableReferencesCounter::countReferences(function.body);
+		size_t savedOperations = 0;
+		for (auto&& [parameterIndex, argument]: candidate.arguments | ranges::views::enumerate)
+			if (argument)
+				savedOperations += 1 + util::valueOrDefault(references, function.parameters[parameterIndex].name);
+		candidate.gasSaved = bigint(savedOperations * c_gasPerSpecializedReference) * candidate.calls * executions;
 
-		m_oldToNewMap[oldName].emplace_back(std::make_pair(newName, arguments));
+		// If all calls are replaced, the original function is removed and the code does not grow.
+		if (candidate.calls < callCounts[candidate.function])
+			candidate.codeSize = CodeSize::codeSize(function.body);
+		bigint codeDepositGas = bigint(candidate.codeSize * c_bytesPerCodeSize) * evmasm::GasCosts::createDataGas;
+		if (candidate.gasSaved >= codeDepositGas)
+			profitable.emplace_back(index);
+	}
 
-		_f.functionName.name = newName;
-		_f.arguments = util::filter(
-			_f.arguments,
-			applyMap(arguments, [](auto& _a) { return !_a; })
-		);
+	// Prefer the candidates that save the most gas relative to their code size.
+	std::stable_sort(profitable.begin(), profitable.end(), [&](size_t _lhs, size_t _rhs) {
+		return candidates[_lhs].gasSaved * candidates[_rhs].codeSize > candidates[_rhs].gasSaved * candidates[_lhs].codeSize;
+	});
+	size_t budget = std::max(c_minBudget, CodeSize::codeSizeIncludingFunctions(_ast) / 2);
+	std::set<size_t> selected;
+	for (size_t index: profitable)
+		if (candidates[index].codeSize <= budget)
+		{
+			budget -= candidates[index].codeSize;
+			selected.insert(index);
+		}
+
+	// Names are assigned in the order of the calls to keep the output deterministic.
+	for (size_t index: selected)
+	{
+		Candidate& candidate = candidates[index];
+		YulName newName = m_nameDispenser.newName(candidate.function);
+		m_specializations[{candidate.function, literalValues(candidate.arguments)}] = newName;
+		m_oldToNewMap[candidate.function].emplace_back(std::make_pair(newName, std::move(candidate.arguments)));
 	}
 }
 
+void FunctionSpecializer::operator()(FunctionCall& _f)
+{
+	ASTModifier::operator()(_f);
+
+	if (m_dialect.builtin(_f.functionName.name))
+		return;
+
+	LiteralArguments arguments = specializableArguments(_f);
+	auto it = m_specializations.find({_f.functionName.name, literalValues(arguments)});
+	if (it == m_specializations.end())
+		return;
+
+	_f.functionName.name = it->second;
+	_f.arguments = util::filter(
+		_f.arguments,
+		applyMap(arguments, [](auto& _a) { return !_a; })
+	);
+}
+
 FunctionDefinition FunctionSpecializer::specialize(
 	FunctionDefinition const& _f,
 	YulName _newName,
@@ -129,8 +246,10 @@ void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
 	FunctionSpecializer f{
 		CallGraphGenerator::callGraph(_ast).recursiveFunctions(),
 		_context.dispenser,
-		_context.dialect
+		_context.dialect,
+		_context.expectedExecutionsPerDeployment
 	};
+	f.selectSpecializations(_ast);
 	f(_ast);
 
 	iterateReplacing(_ast.statements, [&](Statement& _s) -> std::optional<std::vector<Statement>>
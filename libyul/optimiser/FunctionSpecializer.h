@@ -47,6 +47,13 @@ namespace solidity::yul
  * Other optimization steps will be able to make more simplifications to the function. The
  * optimization step is mainly useful for functions that would not be inlined.
  *
+ * All calls with the same literal arguments share one specialized function. A specialization
+ * is only created if the gas estimated to be saved by not passing the arguments and by
+ * constants replacing the parameters, weighted by the expected number of executions, outweighs
+ * the deposit costs of the additional code. Specializations that replace all calls of a
+ * function do not increase the code size and are always created. The total code size of all
+ * other specializations is limited by a budget relative to the size of the whole code.
+ *
  * Prerequisites: Disambiguator, FunctionHoister
  *
  * LiteralRematerialiser is recommended as a prerequisite, even though it's not required for
@@ -58,6 +65,8 @@ public:
 	/// A vector of function-call arguments. An element 'has value' if it's a literal, and the
 	/// corresponding Expression would be the literal.
 	using LiteralArguments = std::vector<std::optional<Expression>>;
+	/// The values of the literal arguments of a call, which identify a specialization.
+	using LiteralValues = std::vector<std::optional<LiteralValue>>;
 
 	static constexpr char const* name{"FunctionSpecializer"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
@@ -69,15 +78,21 @@ private:
 	explicit FunctionSpecializer(
 		std::set<YulName> _recursiveFunctions,
 		NameDispenser& _nameDispenser,
-		Dialect const& _dialect
+		Dialect const& _dialect,
+		std::optional<size_t> _expectedExecutionsPerDeployment
 	):
 		m_recursiveFunctions(std::move(_recursiveFunctions)),
 		m_nameDispenser(_nameDispenser),
-		m_dialect(_dialect)
+		m_dialect(_dialect),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment)
 	{}
 	/// Returns a vector of Expressions, where the index `i` is an expression if the function's
 	/// `i`-th argument can be specialized, nullopt otherwise.
 	LiteralArguments specializableArguments(FunctionCall const& _f);
+	static LiteralValues literalValues(LiteralArguments const& _arguments);
+	/// Decides which of the candidates found in @a _ast are specialized and
+	/// assigns the names of the specialized functions.
+	void selectSpecializations(Block const& _ast);
 	/// Given a function definition `_f` and its arguments `_arguments`, of which, at least one is a
 	/// literal, this function returns a new function with the literal arguments specialized.
 	///
@@ -103,11 +118,14 @@ private:
 	/// A mapping between the old function name and a pair of new function name and its arguments.
 	/// Note that at least one of the argument will have a literal value.
 	std::map<YulName, std::vector<std::pair<YulName, LiteralArguments>>> m_oldToNewMap;
+	/// The names of the specialized functions by the called function and the values of the literal arguments.
+	std::map<std::pair<YulName, LiteralValues>, YulName> m_specializations;
 	/// We skip specializing recursive functions. Need backtracking to properly deal with them.
 	std::set<YulName> const m_recursiveFunctions;
 
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
 };
 
 }
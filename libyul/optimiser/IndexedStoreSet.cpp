@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Set of store statements indexed by the region they write to.
+ */
+
+#include <libyul/optimiser/IndexedStoreSet.h>
+
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <algorithm>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+void IndexedStoreSet::insert(Statement const* _store, std::optional<Region> const& _region)
+{
+	if (!_region)
+	{
+		m_unindexed.insert(_store);
+		return;
+	}
+
+	Group& group = m_indexed[_region->reference];
+	group.stores.emplace(_region->offset, _store);
+	group.maxLength = std::max(group.maxLength, _region->length);
+}
+
+void IndexedStoreSet::merge(IndexedStoreSet&& _other)
+{
+	m_unindexed.merge(_other.m_unindexed);
+	for (auto&& [reference, otherGroup]: _other.m_indexed)
+	{
+		Group& group = m_indexed[reference];
+		group.stores.merge(otherGroup.stores);
+		group.maxLength = std::max(group.maxLength, otherGroup.maxLength);
+	}
+	_other.clear();
+}
+
+void IndexedStoreSet::clear()
+{
+	m_unindexed.clear();
+	m_indexed.clear();
+}
+
+void IndexedStoreSet::forEach(std::function<void(Statement const*)> const& _callback) const
+{
+	for (Statement const* store: m_unindexed)
+		_callback(store);
+	for (auto const& [reference, group]: m_indexed)
+		for (auto const& [offset, store]: group.stores)
+			_callback(store);
+}
+
+void IndexedStoreSet::eraseIf(Predicate const& _predicate)
+{
+	eraseUnindexedIf(_predicate);
+	for (auto group = m_indexed.begin(); group != m_indexed.end();)
+		group = eraseInGroupIf(group, group->second.stores.begin(), _predicate);
+}
+
+void IndexedStoreSet::eraseUnindexedIf(Predicate const& _predicate)
+{
+	for (auto it = m_unindexed.begin(); it != m_unindexed.end();)
+		if (_predicate(*it))
+			it = m_unindexed.erase(it);
+		else
+			++it;
+}
+
+void IndexedStoreSet::eraseOtherReferencesIf(YulName _reference, Predicate const& _predicate)
+{
+	for (auto group = m_indexed.begin(); group != m_indexed.end();)
+		if (group->first == _reference)
+			++group;
+		else
+			group = eraseInGroupIf(group, group->second.stores.begin(), _predicate);
+}
+
+void IndexedStoreSet::eraseReferenceIf(YulName _reference, Predicate const& _predicate)
+{
+	auto group = m_indexed.find(_reference);
+	if (group != m_indexed.end())
+		eraseInGroupIf(group, group->second.stores.begin(), _predicate);
+}
+
+void IndexedStoreSet::eraseInRangeIf(
+	YulName _reference,
+	u256 const& _from,
+	u256 const& _to,
+	Predicate const& _predicate
+)
+{
+	yulAssert(_from <= _to);
+	auto group = m_indexed.find(_reference);
+	if (group != m_indexed.end())
+		eraseInGroupIf(group, group->second.stores.lower_bound({_from, nullptr}), _predicate, _to);
+}
+
+u256 IndexedStoreSet::maxLength(YulName _reference) const
+{
+	auto group = m_indexed.find(_reference);
+	return group == m_indexed.end() ? u256(0) : group->second.maxLength;
+}
+
+std::map<YulName, IndexedStoreSet::Group>::iterator IndexedStoreSet::eraseInGroupIf(
+	std::map<YulName, Group>::iterator _group,
+	std::set<std::pair<u256, Statement const*>>::iterator _begin,
+	Predicate const& _predicate,
+	std::optional<u256> const& _maxOffset
+)
+{
+	std::set<std::pair<u256, Statement const*>>& stores = _group->second.stores;
+	for (auto it = _begin; it != stores.end() && (!_maxOffset || it->first <= *_maxOffset);)
+		if (_predicate(it->second))
+			it = stores.erase(it);
+		else
+			++it;
+	return stores.empty() ? m_indexed.erase(_group) : std::next(_group);
+}
@@ -0,0 +1,114 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Set of store statements indexed by the region they write to.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulName.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+
+namespace solidity::yul
+{
+
+/**
+ * Set of store statements used by the UnusedStoreEliminator to track the active stores.
+ *
+ * Stores whose region is known to start at a constant offset from some reference variable
+ * are indexed by that reference and offset, so that the stores that may be affected by an
+ * operation with a known region can be found without looking at all active stores. All other
+ * stores are kept in a separate unindexed set.
+ *
+ * The index only speeds up finding the candidates of a query. The caller still has to decide
+ * for each of them whether it is actually affected.
+ */
+class IndexedStoreSet
+{
+public:
+	/// Region written by a store: @a length bytes starting at @a offset relative to the value of
+	/// the variable @a reference, or, if @a reference is empty, at the absolute address @a offset.
+	struct Region
+	{
+		YulName reference;
+		u256 offset;
+		u256 length;
+	};
+	using Predicate = std::function<bool(Statement const*)>;
+
+	/// Adds @a _store, writing to @a _region if known.
+	void insert(Statement const* _store, std::optional<Region> const& _region);
+	/// Adds all stores of @a _other. Will destroy @a _other.
+	void merge(IndexedStoreSet&& _other);
+
+	bool empty() const { return m_unindexed.empty() && m_indexed.empty(); }
+	void clear();
+
+	/// Calls @a _callback for every store in the set.
+	void forEach(std::function<void(Statement const*)> const& _callback) const;
+
+	/// Removes the stores for which @a _predicate returns true.
+	void eraseIf(Predicate const& _predicate);
+	/// Removes the stores with an unknown region for which @a _predicate returns true.
+	void eraseUnindexedIf(Predicate const& _predicate);
+	/// Removes the stores with a known region relative to a reference other than @a _reference
+	/// for which @a _predicate returns true.
+	void eraseOtherReferencesIf(YulName _reference, Predicate const& _predicate);
+	/// Removes the stores with a known region relative to @a _reference for which @a _predicate returns true.
+	void eraseReferenceIf(YulName _reference, Predicate const& _predicate);
+	/// Removes the stores with a known region relative to @a _reference that start at an offset
+	/// between @a _from and @a _to (inclusive) for which @a _predicate returns true.
+	void eraseInRangeIf(YulName _reference, u256 const& _from, u256 const& _to, Predicate const& _predicate);
+
+	/// @returns an upper bound for the length of the regions relative to @a _reference
+	/// or zero if there are none.
+	u256 maxLength(YulName _reference) const;
+
+private:
+	/// Stores with a known region relative to the same reference.
+	struct Group
+	{
+		/// Start offset and statement of each store.
+		std::set<std::pair<u256, Statement const*>> stores;
+		/// Upper bound for the length of the regions. Not reduced when stores are removed.
+		u256 maxLength;
+	};
+
+	/// Removes the stores of @a _group from @a _begin up to an offset of @a _maxOffset for which
+	/// @a _predicate returns true and the group itself if it becomes empty.
+	/// @returns the iterator to the group following @a _group.
+	std::map<YulName, Group>::iterator eraseInGroupIf(
+		std::map<YulName, Group>::iterator _group,
+		std::set<std::pair<u256, Statement const*>>::iterator _begin,
+		Predicate const& _predicate,
+		std::optional<u256> const& _maxOffset = std::nullopt
+	);
+
+	std::set<Statement const*> m_unindexed;
+	std::map<YulName, Group> m_indexed;
+};
+
+}
@@ -83,6 +83,11 @@ std::optional<u256> KnowledgeBase::valueIfKnownConstant(Expression const& _expre
 		return std::nullopt;
 }
 
+KnowledgeBase::VariableOffset KnowledgeBase::groupOffset(YulName _a)
+{
+	return explore(_a);
+}
+
 KnowledgeBase::VariableOffset KnowledgeBase::explore(YulName _var)
 {
 	Expression const* value = nullptr;
@@ -174,16 +179,19 @@ void KnowledgeBase::reset(YulName _var)
 			m_groupMembers[offset->reference].erase(_var);
 		m_offsets.erase(_var);
 	}
-	if (std::set<YulName>* group = util::valueOrNullptr(m_groupMembers, _var))
+	if (auto groupIt = m_groupMembers.find(_var); groupIt != m_groupMembers.end())
 	{
+		// Take the group out first, modifying m_groupMembers invalidates groupIt.
+		std::set<YulName> group = std::move(groupIt->second);
+		m_groupMembers.erase(_var);
 		// _var was a representative, we might have to find a new one.
-		if (!group->empty())
+		if (!group.empty())
 		{
-			YulName newRepresentative = *group->begin();
+			YulName newRepresentative = *group.begin();
 			yulAssert(newRepresentative != _var);
 			u256 newOffset = m_offsets[newRepresentative].offset;
 			// newOffset = newRepresentative - _var
-			for (YulName groupMember: *group)
+			for (YulName groupMember: group)
 			{
 				yulAssert(m_offsets[groupMember].reference == _var);
 				m_offsets[groupMember].reference = newRepresentative;
@@ -193,10 +201,8 @@ void KnowledgeBase::reset(YulName _var)
 				// just with _var replaced by newRepresentative
 				m_offsets[groupMember].offset -= newOffset;
 			}
-			m_groupMembers[newRepresentative] = std::move(*group);
-
+			m_groupMembers[newRepresentative] = std::move(group);
 		}
-		m_groupMembers.erase(_var);
 	}
 }
 
@@ -23,12 +23,14 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulName.h>
+#include <libyul/YulNameMap.h>
 
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 
 #include <map>
 #include <functional>
+#include <set>
 
 namespace solidity::yul
 {
@@ -60,22 +62,6 @@ struct AssignedValue;
 class KnowledgeBase
 {
 public:
-	/// Constructor for arbitrary value callback that allows for variable values
-	/// to change in between calls to functions of this class.
-	explicit KnowledgeBase(std::function<AssignedValue const*(YulName)> _variableValues):
-		m_variableValues(std::move(_variableValues))
-	{}
-	/// Constructor to use if source code is in SSA form and values are constant.
-	explicit KnowledgeBase(std::map<YulName, AssignedValue> const& _ssaValues);
-
-	bool knownToBeDifferent(YulName _a, YulName _b);
-	std::optional<u256> differenceIfKnownConstant(YulName _a, YulName _b);
-	bool knownToBeDifferentByAtLeast32(YulName _a, YulName _b);
-	bool knownToBeZero(YulName _a);
-	std::optional<u256> valueIfKnownConstant(YulName _a);
-	std::optional<u256> valueIfKnownConstant(Expression const& _expression);
-
-private:
 	/**
 	 * Constant offset relative to a reference variable, or absolute constant if the
 	 * reference variable is the empty YulName.
@@ -99,6 +85,25 @@ private:
 		}
 	};
 
+	/// Constructor for arbitrary value callback that allows for variable values
+	/// to change in between calls to functions of this class.
+	explicit KnowledgeBase(std::function<AssignedValue const*(YulName)> _variableValues):
+		m_variableValues(std::move(_variableValues))
+	{}
+	/// Constructor to use if source code is in SSA form and values are constant.
+	explicit KnowledgeBase(std::map<YulName, AssignedValue> const& _ssaValues);
+
+	bool knownToBeDifferent(YulName _a, YulName _b);
+	std::optional<u256> differenceIfKnownConstant(YulName _a, YulName _b);
+	bool knownToBeDifferentByAtLeast32(YulName _a, YulName _b);
+	bool knownToBeZero(YulName _a);
+	std::optional<u256> valueIfKnownConstant(YulName _a);
+	std::optional<u256> valueIfKnownConstant(Expression const& _expression);
+	/// @returns the offset of @a _a relative to the representative of its group.
+	/// Two variables have a known constant difference if and only if they have the same representative.
+	VariableOffset groupOffset(YulName _a);
+
+private:
 	VariableOffset explore(YulName _var);
 	std::optional<VariableOffset> explore(Expression const& _value);
 
@@ -118,11 +123,11 @@ private:
 
 	/// Offsets for each variable to one representative per group.
 	/// The empty string is the representative of the constant value zero.
-	std::map<YulName, VariableOffset> m_offsets;
+	YulNameMap<VariableOffset> m_offsets;
 	/// Last known value of each variable we queried.
-	std::map<YulName, Expression const*> m_lastKnownValue;
+	YulNameMap<Expression const*> m_lastKnownValue;
 	/// For each representative, variables that use it to offset from.
-	std::map<YulName, std::set<YulName>> m_groupMembers;
+	YulNameMap<std::set<YulName>> m_groupMembers;
 };
 
 }
@@ -26,6 +26,7 @@
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FunctionParallelism.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/SideEffects.h>
 #include <libyul/AST.h>
@@ -44,12 +45,29 @@ using namespace solidity::yul;
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	LoadResolver{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
-		_context.expectedExecutionsPerDeployment
-	}(_ast);
+	std::map<YulName, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	std::map<YulName, StorageWrites> functionStorageWrites =
+		StorageWriteCollector::functionStorageWrites(_context.dialect, _ast);
+	bool const ranInParallel = runOnTopLevelStatementsInParallel(_context, _ast, [&](size_t _begin, size_t _end) {
+		LoadResolver resolver{
+			_context.dialect,
+			functionSideEffects,
+			functionStorageWrites,
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		};
+		for (size_t i = _begin; i < _end; ++i)
+			resolver.visit(_ast.statements[i]);
+	});
+	if (!ranInParallel)
+		LoadResolver{
+			_context.dialect,
+			std::move(functionSideEffects),
+			std::move(functionStorageWrites),
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		}(_ast);
 }
 
 void LoadResolver::visit(Expression& _e)
@@ -112,7 +130,8 @@ void LoadResolver::tryEvaluateKeccak(
 	if (!memoryKey || !length)
 		return;
 
-	// The costs are only correct for hashes of 32 bytes or 1 word (when rounded up).
+	// The costs assume a hash of 32 bytes or 1 word (when rounded up), so they underestimate
+	// the savings for longer areas.
 	GasMeter gasMeter{
 		dynamic_cast<EVMDialect const&>(m_dialect),
 		!m_expectedExecutionsPerDeployment,
@@ -136,21 +155,10 @@ void LoadResolver::tryEvaluateKeccak(
 	if (costOfLiteral > costOfKeccak)
 		return;
 
-	std::optional<YulName> value = memoryValue(memoryKey->name);
-	if (value && inScope(*value))
-	{
-		std::optional<u256> memoryContent = valueOfIdentifier(*value);
-		std::optional<u256> byteLength = valueOfIdentifier(length->name);
-		if (memoryContent && byteLength && *byteLength <= 32)
-		{
-			bytes contentAsBytes = toBigEndian(*memoryContent);
-			contentAsBytes.resize(static_cast<size_t>(*byteLength));
-			u256 const contentHash (keccak256(contentAsBytes));
-			_e = Literal{
-				debugDataOf(_e),
-				LiteralKind::Number,
-				LiteralValue{contentHash}
-			};
-		}
-	}
+	if (std::optional<bytes> content = memoryContentIfKnownConstant(memoryKey->name, length->name))
+		_e = Literal{
+			debugDataOf(_e),
+			LiteralKind::Number,
+			LiteralValue{u256(keccak256(*content))}
+		};
 }
@@ -32,8 +32,8 @@ namespace solidity::yul
  * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
  * currently stored in storage resp. memory, if known.
  *
- * Also evaluates simple ``keccak256(a, c)`` when the value at memory location `a` is known and `c`
- * is a constant `<= 32`.
+ * Also evaluates ``keccak256(a, c)`` when `c` is a constant and all words of the memory area
+ * starting at `a` are known to hold constants, e.g. for mapping slots with constant keys.
  *
  * Works best if the code is in SSA form.
  *
@@ -50,10 +50,16 @@ private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulName, SideEffects> _functionSideEffects,
+		std::map<YulName, StorageWrites> _functionStorageWrites,
 		bool _containsMSize,
 		std::optional<size_t> _expectedExecutionsPerDeployment
 	):
-		DataFlowAnalyzer(_dialect, MemoryAndStorage::Analyze, std::move(_functionSideEffects)),
+		DataFlowAnalyzer(
+			_dialect,
+			MemoryAndStorage::Analyze,
+			std::move(_functionSideEffects),
+			std::move(_functionStorageWrites)
+		),
 		m_containsMSize(_containsMSize),
 		m_expectedExecutionsPerDeployment(std::move(_expectedExecutionsPerDeployment))
 	{}
@@ -68,8 +74,8 @@ protected:
 		std::vector<Expression> const& _arguments
 	);
 
-	/// Evaluates simple ``keccak256(a, c)`` when the value at memory location ``a`` is known and
-	/// `c` is a constant `<= 32`.
+	/// Evaluates ``keccak256(a, c)`` when ``c`` is a constant and the content of the memory area
+	/// of ``c`` bytes starting at ``a`` is known.
 	void tryEvaluateKeccak(
 		Expression& _e,
 		std::vector<Expression> const& _arguments
@@ -19,10 +19,13 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
 #include <libsolutil/CommonData.h>
 
 #include <utility>
@@ -30,13 +33,76 @@
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+SideEffects::Effect effectOn(SideEffects const& _sideEffects, evmasm::SemanticInformation::Location _location)
+{
+	using Location = evmasm::SemanticInformation::Location;
+	switch (_location)
+	{
+	case Location::Storage: return _sideEffects.storage;
+	case Location::Memory: return _sideEffects.memory;
+	case Location::TransientStorage: return _sideEffects.transientStorage;
+	}
+	util::unreachable();
+}
+
+/// Collects all function calls inside a for loop that may write to storage, transient storage or memory.
+class LoopWritesCollector: public ASTWalker
+{
+public:
+	LoopWritesCollector(Dialect const& _dialect, std::map<YulName, SideEffects> const& _functionSideEffects):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		SideEffects const& sideEffects = sideEffectsOf(_functionCall);
+		if (
+			sideEffects.storage == SideEffects::Write ||
+			sideEffects.memory == SideEffects::Write ||
+			sideEffects.transientStorage == SideEffects::Write
+		)
+			m_writes.push_back(&_functionCall);
+	}
+
+	SideEffects const& sideEffectsOf(FunctionCall const& _functionCall) const
+	{
+		if (BuiltinFunction const* f = m_dialect.builtin(_functionCall.functionName.name))
+			return f->sideEffects;
+		else
+			return m_functionSideEffects.at(_functionCall.functionName.name);
+	}
+
+	std::vector<FunctionCall const*> const& writes() const { return m_writes; }
+
+private:
+	Dialect const& m_dialect;
+	std::map<YulName, SideEffects> const& m_functionSideEffects;
+	std::vector<FunctionCall const*> m_writes;
+};
+
+}
+
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
 	std::map<YulName, SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	std::set<YulName> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	std::set<YulName> ssaVars;
+	std::map<YulName, AssignedValue> values;
+	for (auto const& [name, expression]: ssaValues.values())
+	{
+		ssaVars.insert(name);
+		values[name] = AssignedValue{expression, {}};
+	}
+	LoopInvariantCodeMotion{_context.dialect, ssaVars, values, functionSideEffects, containsMSize}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -57,13 +123,14 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	std::set<YulName> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
+	SideEffects const& _forLoopSideEffects,
+	std::vector<FunctionCall const*> const& _loopWrites
 ) const
 {
 	// A declaration can be promoted iff
 	// 1. Its LHS is a SSA variable
 	// 2. Its RHS only references SSA variables declared outside of the current scope
-	// 3. Its RHS is movable
+	// 3. Its RHS is movable or a load from a location the loop does not write to
 
 	for (auto const& var: _varDecl.variables)
 		if (!m_ssaVariables.count(var.name))
@@ -74,18 +141,123 @@ bool LoopInvariantCodeMotion::canBePromoted(
 			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
 				return false;
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (
+			!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize) &&
+			!loadNotWrittenTo(*_varDecl.value, _loopWrites)
+		)
+			return false;
+	}
+	return true;
+}
+
+bool LoopInvariantCodeMotion::loadNotWrittenTo(
+	Expression const& _value,
+	std::vector<FunctionCall const*> const& _loopWrites
+) const
+{
+	using evmasm::Instruction;
+
+	FunctionCall const* load = std::get_if<FunctionCall>(&_value);
+	if (!load)
+		return false;
+	// Only consider arguments that are movable themselves.
+	for (Expression const& argument: load->arguments)
+		if (!std::holds_alternative<Identifier>(argument) && !std::holds_alternative<Literal>(argument))
+			return false;
+	std::optional<Instruction> instruction = toEVMInstruction(m_dialect, load->functionName.name);
+	if (!instruction || (*instruction != Instruction::SLOAD && *instruction != Instruction::TLOAD && *instruction != Instruction::MLOAD))
+		return false;
+	// Moving an mload changes msize.
+	if (*instruction == Instruction::MLOAD && m_containsMSize)
+		return false;
+
+	std::vector<evmasm::SemanticInformation::Operation> operations =
+		evmasm::SemanticInformation::readWriteOperations(*instruction);
+	yulAssert(operations.size() == 1);
+	auto const& read = operations.front();
+	yulAssert(read.startParameter && read.lengthConstant);
+
+	for (FunctionCall const* write: _loopWrites)
+		if (!knownNotWriting(*write, read.location, load->arguments.at(*read.startParameter), *read.lengthConstant))
+			return false;
+	return true;
+}
+
+bool LoopInvariantCodeMotion::knownNotWriting(
+	FunctionCall const& _call,
+	Location _location,
+	Expression const& _readStart,
+	u256 const& _readLength
+) const
+{
+	std::optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, _call.functionName.name);
+	if (!instruction)
+	{
+		SideEffects const& sideEffects = LoopWritesCollector{m_dialect, m_functionSideEffects}.sideEffectsOf(_call);
+		return effectOn(sideEffects, _location) != SideEffects::Write;
+	}
+
+	for (auto const& operation: evmasm::SemanticInformation::readWriteOperations(*instruction))
+	{
+		if (operation.location != _location || operation.effect != evmasm::SemanticInformation::Write)
+			continue;
+		if (!operation.startParameter)
 			return false;
+
+		std::optional<u256> writeLength;
+		if (operation.lengthConstant)
+			writeLength = *operation.lengthConstant;
+		else if (operation.lengthParameter)
+			writeLength = m_knowledgeBase.valueIfKnownConstant(_call.arguments.at(*operation.lengthParameter));
+		if (!writeLength)
+			return false;
+
+		std::optional<KnowledgeBase::VariableOffset> readStart = ssaOffset(_readStart);
+		std::optional<KnowledgeBase::VariableOffset> writeStart = ssaOffset(_call.arguments.at(*operation.startParameter));
+		if (!readStart || !writeStart || readStart->reference != writeStart->reference)
+			return false;
+
+		// Offset of the written area relative to the read one, wrapping around like the addresses.
+		u256 difference = writeStart->offset - readStart->offset;
+		if (_location != Location::Memory)
+		{
+			// Slots are only ever read and written one at a time.
+			if (difference == 0)
+				return false;
+		}
+		else if (*writeLength != 0)
+		{
+			// The written area has to start after the end of the read one and end before it
+			// wraps around to its start.
+			if (*writeLength > u256(0) - _readLength || difference < _readLength || difference > u256(0) - *writeLength)
+				return false;
+		}
 	}
 	return true;
 }
 
+std::optional<KnowledgeBase::VariableOffset> LoopInvariantCodeMotion::ssaOffset(Expression const& _expression) const
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		return KnowledgeBase::VariableOffset{YulName{}, literal->value.value()};
+	Identifier const* identifier = std::get_if<Identifier>(&_expression);
+	if (!identifier || !m_ssaVariables.count(identifier->name))
+		return std::nullopt;
+	KnowledgeBase::VariableOffset offset = m_knowledgeBase.groupOffset(identifier->name);
+	// The representative has to keep its value throughout the loop.
+	if (!offset.reference.empty() && !m_ssaVariables.count(offset.reference))
+		return std::nullopt;
+	return offset;
+}
+
 std::optional<std::vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	LoopWritesCollector loopWrites{m_dialect, m_functionSideEffects};
+	loopWrites(_for);
 
 	std::vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -98,7 +270,7 @@ std::optional<std::vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLo
 				if (std::holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, loopWrites.writes()))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
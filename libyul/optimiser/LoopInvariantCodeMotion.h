@@ -18,9 +18,12 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <libevmasm/SemanticInformation.h>
+
 namespace solidity::yul
 {
 
@@ -32,6 +35,10 @@ namespace solidity::yul
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
  *
+ * A declaration whose value is an ``sload``, ``tload`` or ``mload`` is also moved if the loop writes to the same data
+ * location, as long as all these writes are known to be to different slots or to memory areas
+ * that do not overlap with the one read.
+ *
  * Requirements:
  * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
  * - Expression splitter and SSA transform should be run upfront to obtain better result.
@@ -49,27 +56,47 @@ private:
 	explicit LoopInvariantCodeMotion(
 		Dialect const& _dialect,
 		std::set<YulName> const& _ssaVariables,
+		std::map<YulName, AssignedValue> const& _ssaValues,
 		std::map<YulName, SideEffects> const& _functionSideEffects,
 		bool _containsMSize
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
-		m_functionSideEffects(_functionSideEffects)
+		m_functionSideEffects(_functionSideEffects),
+		m_knowledgeBase(_ssaValues)
 	{ }
 
+	using Location = evmasm::SemanticInformation::Location;
+
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulName> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
+		SideEffects const& _forLoopSideEffects,
+		std::vector<FunctionCall const*> const& _loopWrites
+	) const;
+	/// @returns true if @a _value is a load from storage, transient storage or memory and
+	/// none of the calls in @a _loopWrites writes to the location it reads.
+	bool loadNotWrittenTo(Expression const& _value, std::vector<FunctionCall const*> const& _loopWrites) const;
+	/// @returns true if @a _call is known not to write to the @a _readLength bytes or slots
+	/// of @a _location starting at @a _readStart.
+	bool knownNotWriting(
+		FunctionCall const& _call,
+		Location _location,
+		Expression const& _readStart,
+		u256 const& _readLength
 	) const;
+	/// @returns the value of @a _expression relative to the representative of its group in the
+	/// knowledge base if it is a literal or an SSA variable whose representative is one as well.
+	std::optional<KnowledgeBase::VariableOffset> ssaOffset(Expression const& _expression) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
 	bool m_containsMSize = true;
 	Dialect const& m_dialect;
 	std::set<YulName> const& m_ssaVariables;
 	std::map<YulName, SideEffects> const& m_functionSideEffects;
+	KnowledgeBase mutable m_knowledgeBase;
 };
 
 }
@@ -0,0 +1,263 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that unrolls for loops with a constant number of iterations.
+ */
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/Instruction.h>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of iterations of a loop that is unrolled.
+size_t constexpr c_maxIterations = 256;
+/// Maximum code size of the copies of the body (and the post block) that replace a loop.
+size_t constexpr c_maxUnrolledSize = 120;
+/// Rough number of bytes of bytecode per unit of the CodeSize metric.
+size_t constexpr c_bytesPerCodeSize = 2;
+
+/// Finds ``break`` or ``continue`` statements that belong to the outermost loop.
+class LoopControlFinder: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(ForLoop const&) override {}
+	void operator()(FunctionDefinition const&) override {}
+	void operator()(Break const&) override { found = true; }
+	void operator()(Continue const&) override { found = true; }
+
+	bool found = false;
+};
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	// Unrolling only pays off for code that is executed more than once.
+	if (!_context.expectedExecutionsPerDeployment)
+		return;
+	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect))
+		LoopUnroller{*evmDialect, _context.dispenser, *_context.expectedExecutionsPerDeployment}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	std::vector<Statement> statements;
+	statements.reserve(_block.statements.size());
+	for (Statement& statement: _block.statements)
+	{
+		// Inner loops are unrolled first.
+		visit(statement);
+		if (ForLoop* loop = std::get_if<ForLoop>(&statement))
+			if (!statements.empty())
+				if (VariableDeclaration const* counter = std::get_if<VariableDeclaration>(&statements.back()))
+					if (std::optional<std::vector<Statement>> replacement = tryUnroll(*counter, *loop))
+					{
+						for (Statement& replacementStatement: *replacement)
+							statements.emplace_back(std::move(replacementStatement));
+						continue;
+					}
+		statements.emplace_back(std::move(statement));
+	}
+	_block.statements = std::move(statements);
+}
+
+std::optional<std::vector<Statement>> LoopUnroller::tryUnroll(
+	VariableDeclaration const& _counterDeclaration,
+	ForLoop& _loop
+)
+{
+	yulAssert(_loop.pre.statements.empty(), "ForLoopInitRewriter has to be run upfront.");
+
+	if (_counterDeclaration.variables.size() != 1)
+		return std::nullopt;
+	YulName counter = _counterDeclaration.variables.front().name;
+	u256 initialValue = 0;
+	if (_counterDeclaration.value)
+	{
+		Literal const* literal = std::get_if<Literal>(_counterDeclaration.value.get());
+		if (!literal || literal->kind != LiteralKind::Number)
+			return std::nullopt;
+		initialValue = literal->value.value();
+	}
+
+	if (_loop.post.statements.size() != 1)
+		return std::nullopt;
+	Assignment const* increment = std::get_if<Assignment>(&_loop.post.statements.front());
+	if (!increment || increment->variableNames.size() != 1 || increment->variableNames.front().name != counter)
+		return std::nullopt;
+
+	if (assignedVariableNames(_loop.body).count(counter))
+		return std::nullopt;
+	LoopControlFinder loopControlFinder;
+	loopControlFinder(_loop.body);
+	if (loopControlFinder.found)
+		return std::nullopt;
+
+	std::optional<size_t> iterations = iterationCount(_loop, counter, initialValue);
+	if (!iterations)
+		return std::nullopt;
+	std::optional<size_t> factor = unrollFactor(_loop, *iterations);
+	if (!factor)
+		return std::nullopt;
+
+	std::vector<Statement> replacement;
+	if (*factor == *iterations)
+		appendCopies(replacement, std::move(_loop.body), _loop.post.statements.front(), *iterations, true);
+	else
+	{
+		Block body = std::move(_loop.body);
+		_loop.body = Block{body.debugData, {}};
+		appendCopies(_loop.body.statements, std::move(body), _loop.post.statements.front(), *factor, false);
+		replacement.emplace_back(std::move(_loop));
+	}
+	return replacement;
+}
+
+std::optional<size_t> LoopUnroller::iterationCount(ForLoop const& _loop, YulName _counter, u256 _initialValue) const
+{
+	Expression const& nextValue = *std::get<Assignment>(_loop.post.statements.front()).value;
+	u256 value = std::move(_initialValue);
+	for (size_t iterations = 0; iterations <= c_maxIterations; ++iterations)
+	{
+		std::optional<u256> condition = evaluate(*_loop.condition, _counter, value);
+		if (!condition)
+			return std::nullopt;
+		if (*condition == 0)
+			return iterations;
+		std::optional<u256> next = evaluate(nextValue, _counter, value);
+		if (!next)
+			return std::nullopt;
+		value = *next;
+	}
+	return std::nullopt;
+}
+
+std::optional<size_t> LoopUnroller::unrollFactor(ForLoop const& _loop, size_t _iterations) const
+{
+	size_t copySize = CodeSize::codeSize(_loop.body) + CodeSize::codeSize(_loop.post);
+
+	// Gas spent in every iteration for the condition and for jumping back to it.
+	bigint iterationGas = GasMeterVisitor::costs(*_loop.condition, m_dialect, false).first;
+	for (Instruction instruction: {
+		Instruction::JUMPDEST,
+		Instruction::ISZERO,
+		Instruction::PUSH1,
+		Instruction::JUMPI,
+		Instruction::PUSH1,
+		Instruction::JUMP
+	})
+		iterationGas += GasMeterVisitor::instructionCosts(instruction, m_dialect).first;
+	bigint copyDataGas = bigint(copySize * c_bytesPerCodeSize) * GasCosts::createDataGas;
+
+	auto profitable = [&](size_t _copies, size_t _savedIterations) {
+		return iterationGas * _savedIterations * m_expectedExecutionsPerDeployment >= copyDataGas * (_copies - 1);
+	};
+
+	// The condition is also evaluated after the last iteration.
+	if (_iterations * copySize <= c_maxUnrolledSize && (_iterations == 0 || profitable(_iterations, _iterations + 1)))
+		return _iterations;
+	for (size_t factor: {8u, 4u, 2u})
+		if (
+			_iterations > factor &&
+			_iterations % factor == 0 &&
+			factor * copySize <= c_maxUnrolledSize &&
+			profitable(factor, _iterations - _iterations / factor)
+		)
+			return factor;
+	return std::nullopt;
+}
+
+std::optional<u256> LoopUnroller::evaluate(Expression const& _expression, YulName _counter, u256 const& _value) const
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+	{
+		if (literal->kind == LiteralKind::String)
+			return std::nullopt;
+		return literal->value.value();
+	}
+	else if (Identifier const* identifier = std::get_if<Identifier>(&_expression))
+	{
+		if (identifier->name == _counter)
+			return _value;
+		return std::nullopt;
+	}
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	std::optional<Instruction> instruction = toEVMInstruction(m_dialect, call.functionName.name);
+	if (!instruction)
+		return std::nullopt;
+	std::vector<u256> arguments;
+	for (Expression const& argument: call.arguments)
+		if (std::optional<u256> value = evaluate(argument, _counter, _value))
+			arguments.emplace_back(std::move(*value));
+		else
+			return std::nullopt;
+
+	switch (*instruction)
+	{
+	case Instruction::ADD: return arguments.at(0) + arguments.at(1);
+	case Instruction::SUB: return arguments.at(0) - arguments.at(1);
+	case Instruction::MUL: return arguments.at(0) * arguments.at(1);
+	case Instruction::LT: return u256(arguments.at(0) < arguments.at(1) ? 1 : 0);
+	case Instruction::GT: return u256(arguments.at(0) > arguments.at(1) ? 1 : 0);
+	case Instruction::EQ: return u256(arguments.at(0) == arguments.at(1) ? 1 : 0);
+	case Instruction::ISZERO: return u256(arguments.at(0) == 0 ? 1 : 0);
+	default: return std::nullopt;
+	}
+}
+
+void LoopUnroller::appendCopies(
+	std::vector<Statement>& _statements,
+	Block _body,
+	Statement const& _post,
+	size_t _copies,
+	bool _lastPost
+)
+{
+	if (_copies == 0)
+		return;
+
+	std::vector<Statement> copies;
+	for (size_t copy = 1; copy < _copies; ++copy)
+		copies.emplace_back(BodyCopier{m_nameDispenser, {}}(_body));
+	copies.insert(copies.begin(), std::move(_body));
+	for (size_t copy = 0; copy < _copies; ++copy)
+	{
+		_statements.emplace_back(std::move(copies[copy]));
+		if (copy + 1 < _copies || _lastPost)
+			_statements.emplace_back(BodyCopier{m_nameDispenser, {}}.translate(_post));
+	}
+}
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that unrolls for loops with a constant number of iterations.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+class NameDispenser;
+
+/**
+ * Optimisation stage that fully or partially unrolls for loops whose number of iterations
+ * is known at compile time.
+ *
+ * A loop is considered if it is directly preceded by the declaration of its counter, which is
+ * initialized with a literal, its condition only depends on the counter and literals
+ * and its post block only consists of an assignment to the counter that also only depends on
+ * the counter and literals. The counter must not be assigned to in the loop body and the body
+ * must not contain ``break`` or ``continue`` statements of the loop itself. For example
+ *
+ *   let i := 0
+ *   for { } lt(i, 3) { i := add(i, 1) } { f(i) }
+ *
+ * is fully unrolled to
+ *
+ *   let i := 0
+ *   { f(i) }
+ *   i := add(i, 1)
+ *   { f(i) }
+ *   i := add(i, 1)
+ *   { f(i) }
+ *   i := add(i, 1)
+ *
+ * If the loop is too large to be fully unrolled, but its number of iterations is a multiple of 2, 4 or 8,
+ * several copies of the body are put into a single iteration of the loop instead.
+ *
+ * The decision is based on a rough estimate of the gas saved by not evaluating the condition
+ * and jumping back in every iteration and of the costs of deploying the additional code, so
+ * loops are never unrolled in creation code. Variables declared in the copies of the body
+ * are renamed to keep the names unique.
+ *
+ * Works best if run after the ExpressionSimplifier and before the SSATransform, which allow the
+ * following steps to replace the counter by constants in the copies of the body.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter, FunctionHoister.
+ */
+class LoopUnroller: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	LoopUnroller(EVMDialect const& _dialect, NameDispenser& _nameDispenser, size_t _expectedExecutionsPerDeployment):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment)
+	{}
+
+	/// @returns the statements replacing @a _loop, which is preceded by @a _counterDeclaration,
+	/// or nullopt if the loop is not unrolled.
+	std::optional<std::vector<Statement>> tryUnroll(VariableDeclaration const& _counterDeclaration, ForLoop& _loop);
+	/// @returns the number of iterations of @a _loop if the counter @a _counter starts at @a _initialValue.
+	std::optional<size_t> iterationCount(ForLoop const& _loop, YulName _counter, u256 _initialValue) const;
+	/// @returns the number of copies of the body to put into a single iteration or nullopt
+	/// if the loop should not be unrolled. If the result is @a _iterations, the loop is unrolled fully.
+	std::optional<size_t> unrollFactor(ForLoop const& _loop, size_t _iterations) const;
+	/// @returns the value of @a _expression if it only depends on the counter @a _counter with the
+	/// value @a _value and on literals.
+	std::optional<u256> evaluate(Expression const& _expression, YulName _counter, u256 const& _value) const;
+	/// Appends @a _copies copies of @a _body, each followed by a copy of @a _post except for
+	/// the last one if @a _lastPost is false. The first copy is @a _body itself.
+	void appendCopies(
+		std::vector<Statement>& _statements,
+		Block _body,
+		Statement const& _post,
+		size_t _copies,
+		bool _lastPost
+	);
+
+	EVMDialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	size_t m_expectedExecutionsPerDeployment;
+};
+
+}
@@ -33,14 +33,18 @@ using namespace solidity::yul;
 using namespace solidity::util;
 
 NameDispenser::NameDispenser(Dialect const& _dialect, Block const& _ast, std::set<YulName> _reservedNames):
-	NameDispenser(_dialect, NameCollector(_ast).names() + _reservedNames)
+	NameDispenser(_dialect, NameCollector(_ast).names(), std::move(_reservedNames))
 {
-	m_reservedNames = std::move(_reservedNames);
 }
 
-NameDispenser::NameDispenser(Dialect const& _dialect, std::set<YulName> _usedNames):
+NameDispenser::NameDispenser(
+	Dialect const& _dialect,
+	std::set<YulName> _usedNames,
+	std::set<YulName> _reservedNames
+):
 	m_dialect(_dialect),
-	m_usedNames(std::move(_usedNames))
+	m_usedNames(std::move(_usedNames) + _reservedNames),
+	m_reservedNames(std::move(_reservedNames))
 {
 }
 
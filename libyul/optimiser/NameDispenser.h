@@ -41,8 +41,13 @@ class NameDispenser
 public:
 	/// Initialize the name dispenser with all the names used in the given AST.
 	explicit NameDispenser(Dialect const& _dialect, Block const& _ast, std::set<YulName> _reservedNames = {});
-	/// Initialize the name dispenser with the given used names.
-	explicit NameDispenser(Dialect const& _dialect, std::set<YulName> _usedNames);
+	/// Initialize the name dispenser with the given used names and the reserved names, which are
+	/// also kept as used by reset().
+	explicit NameDispenser(
+		Dialect const& _dialect,
+		std::set<YulName> _usedNames,
+		std::set<YulName> _reservedNames = {}
+	);
 
 	/// @returns a currently unused name that should be similar to _nameHint.
 	YulName newName(YulName _nameHint);
@@ -51,7 +56,7 @@ public:
 	/// return it.
 	void markUsed(YulName _name) { m_usedNames.insert(_name); }
 
-	std::set<YulName> const& usedNames() { return m_usedNames; }
+	std::set<YulName> const& usedNames() const { return m_usedNames; }
 
 	/// Returns true if `_name` is either used or is a restricted identifier.
 	bool illegalName(YulName _name);
@@ -24,6 +24,11 @@
 #include <string>
 #include <set>
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 
@@ -38,6 +43,8 @@ struct OptimiserStepContext
 	std::set<YulName> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Optional thread pool steps can use to process independent functions in parallel.
+	util::ThreadPool* threadPool = nullptr;
 };
 
 
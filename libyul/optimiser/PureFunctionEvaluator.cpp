@@ -0,0 +1,357 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that evaluates calls to pure functions with constant arguments.
+ */
+
+#include <libyul/optimiser/PureFunctionEvaluator.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/FixedU256.h>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of statements and expressions evaluated for a single call.
+size_t constexpr c_maxSteps = 10000;
+/// Maximum depth of nested calls to user-defined functions during the evaluation of a single call.
+size_t constexpr c_maxCallDepth = 64;
+
+std::optional<u256> literalValue(Expression const& _expression)
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		if (!literal->value.unlimited())
+			return literal->value.value();
+	return std::nullopt;
+}
+
+/// @returns the result of @a _instruction applied to @a _arguments or nullopt if the instruction
+/// does not purely compute on its arguments.
+std::optional<u256> evaluateInstruction(Instruction _instruction, std::vector<u256> const& _arguments)
+{
+	auto fixed = [&](size_t _index) { return FixedU256(_arguments.at(_index)); };
+	auto boolean = [](bool _value) { return u256(_value ? 1 : 0); };
+	switch (_instruction)
+	{
+	case Instruction::ADD: return _arguments.at(0) + _arguments.at(1);
+	case Instruction::SUB: return _arguments.at(0) - _arguments.at(1);
+	case Instruction::MUL: return (fixed(0) * fixed(1)).toU256();
+	case Instruction::DIV: return _arguments.at(1) == 0 ? 0 : (fixed(0) / fixed(1)).toU256();
+	case Instruction::SDIV: return _arguments.at(1) == 0 ? 0 : FixedU256::signedDiv(fixed(0), fixed(1)).toU256();
+	case Instruction::MOD: return _arguments.at(1) == 0 ? 0 : (fixed(0) % fixed(1)).toU256();
+	case Instruction::SMOD: return _arguments.at(1) == 0 ? 0 : FixedU256::signedMod(fixed(0), fixed(1)).toU256();
+	case Instruction::ADDMOD:
+		return _arguments.at(2) == 0 ? 0 : FixedU256::addMod(fixed(0), fixed(1), fixed(2)).toU256();
+	case Instruction::MULMOD:
+		return _arguments.at(2) == 0 ? 0 : FixedU256::mulMod(fixed(0), fixed(1), fixed(2)).toU256();
+	case Instruction::EXP: return FixedU256::exp(fixed(0), fixed(1)).toU256();
+	case Instruction::SIGNEXTEND:
+	{
+		u256 const& value = _arguments.at(1);
+		if (_arguments.at(0) >= 31)
+			return value;
+		unsigned testBit = unsigned(_arguments.at(0)) * 8 + 7;
+		u256 mask = (u256(1) << testBit) - 1;
+		return boost::multiprecision::bit_test(value, testBit) ? value | ~mask : value & mask;
+	}
+	case Instruction::LT: return boolean(_arguments.at(0) < _arguments.at(1));
+	case Instruction::GT: return boolean(_arguments.at(0) > _arguments.at(1));
+	case Instruction::SLT: return boolean(u2s(_arguments.at(0)) < u2s(_arguments.at(1)));
+	case Instruction::SGT: return boolean(u2s(_arguments.at(0)) > u2s(_arguments.at(1)));
+	case Instruction::EQ: return boolean(_arguments.at(0) == _arguments.at(1));
+	case Instruction::ISZERO: return boolean(_arguments.at(0) == 0);
+	case Instruction::AND: return _arguments.at(0) & _arguments.at(1);
+	case Instruction::OR: return _arguments.at(0) | _arguments.at(1);
+	case Instruction::XOR: return _arguments.at(0) ^ _arguments.at(1);
+	case Instruction::NOT: return ~_arguments.at(0);
+	case Instruction::BYTE:
+		if (_arguments.at(0) >= 32)
+			return 0;
+		return (_arguments.at(1) >> unsigned(8 * (31 - _arguments.at(0)))) & 0xff;
+	case Instruction::SHL:
+		return _arguments.at(0) >= 256 ? 0 : (fixed(1) << size_t(_arguments.at(0))).toU256();
+	case Instruction::SHR:
+		return _arguments.at(0) >= 256 ? 0 : (fixed(1) >> size_t(_arguments.at(0))).toU256();
+	case Instruction::SAR:
+	{
+		bool negative = boost::multiprecision::bit_test(_arguments.at(1), 255);
+		size_t shift = _arguments.at(0) >= 256 ? 256 : size_t(_arguments.at(0));
+		if (shift == 256)
+			return negative ? ~u256(0) : 0;
+		// Shifting the complement of a negative number fills in ones from the left.
+		return negative ? ~((~fixed(1)) >> shift).toU256() : (fixed(1) >> shift).toU256();
+	}
+	default:
+		return std::nullopt;
+	}
+}
+
+/**
+ * Interprets calls to user-defined functions as long as they only use built-in functions
+ * that purely compute on their arguments.
+ */
+class Evaluator
+{
+public:
+	Evaluator(EVMDialect const& _dialect, std::map<YulName, FunctionDefinition const*> const& _functions):
+		m_dialect(_dialect),
+		m_functions(_functions)
+	{}
+
+	/// @returns the return values of @a _function called with @a _arguments or nullopt if the
+	/// call cannot be evaluated.
+	std::optional<std::vector<u256>> call(FunctionDefinition const& _function, std::vector<u256> const& _arguments)
+	{
+		yulAssert(_arguments.size() == _function.parameters.size());
+		if (m_callDepth >= c_maxCallDepth)
+			return std::nullopt;
+
+		Variables variables;
+		for (size_t i = 0; i < _arguments.size(); ++i)
+			variables[_function.parameters[i].name] = _arguments[i];
+		for (NameWithDebugData const& returnVariable: _function.returnVariables)
+			variables[returnVariable.name] = 0;
+
+		++m_callDepth;
+		std::optional<Control> control = execute(_function.body, variables);
+		--m_callDepth;
+		if (!control)
+			return std::nullopt;
+
+		std::vector<u256> returnValues;
+		for (NameWithDebugData const& returnVariable: _function.returnVariables)
+			returnValues.emplace_back(variables.at(returnVariable.name));
+		return returnValues;
+	}
+
+private:
+	enum class Control { Next, Break, Continue, Leave };
+	/// Values of the variables of a function call. Names are unique due to the Disambiguator.
+	using Variables = std::map<YulName, u256>;
+
+	bool step() { return m_steps++ < c_maxSteps; }
+
+	std::optional<Control> execute(Block const& _block, Variables& _variables)
+	{
+		for (Statement const& statement: _block.statements)
+		{
+			std::optional<Control> control = execute(statement, _variables);
+			if (!control || *control != Control::Next)
+				return control;
+		}
+		return Control::Next;
+	}
+
+	std::optional<Control> execute(Statement const& _statement, Variables& _variables)
+	{
+		if (!step())
+			return std::nullopt;
+
+		if (auto const* expressionStatement = std::get_if<ExpressionStatement>(&_statement))
+		{
+			if (!evaluate(expressionStatement->expression, _variables))
+				return std::nullopt;
+		}
+		else if (auto const* assignment = std::get_if<Assignment>(&_statement))
+		{
+			std::optional<std::vector<u256>> values = evaluate(*assignment->value, _variables);
+			if (!values)
+				return std::nullopt;
+			yulAssert(values->size() == assignment->variableNames.size());
+			for (size_t i = 0; i < values->size(); ++i)
+				_variables[assignment->variableNames[i].name] = (*values)[i];
+		}
+		else if (auto const* declaration = std::get_if<VariableDeclaration>(&_statement))
+		{
+			std::vector<u256> values(declaration->variables.size(), 0);
+			if (declaration->value)
+			{
+				std::optional<std::vector<u256>> initialValues = evaluate(*declaration->value, _variables);
+				if (!initialValues)
+					return std::nullopt;
+				values = std::move(*initialValues);
+			}
+			yulAssert(values.size() == declaration->variables.size());
+			for (size_t i = 0; i < values.size(); ++i)
+				_variables[declaration->variables[i].name] = values[i];
+		}
+		else if (auto const* if_ = std::get_if<If>(&_statement))
+		{
+			std::optional<u256> condition = evaluateSingle(*if_->condition, _variables);
+			if (!condition)
+				return std::nullopt;
+			if (*condition != 0)
+				return execute(if_->body, _variables);
+		}
+		else if (auto const* switch_ = std::get_if<Switch>(&_statement))
+		{
+			std::optional<u256> value = evaluateSingle(*switch_->expression, _variables);
+			if (!value)
+				return std::nullopt;
+			Case const* matchingCase = nullptr;
+			for (Case const& case_: switch_->cases)
+				if (!case_.value || case_.value->value.value() == *value)
+				{
+					matchingCase = &case_;
+					if (case_.value)
+						break;
+				}
+			if (matchingCase)
+				return execute(matchingCase->body, _variables);
+		}
+		else if (auto const* forLoop = std::get_if<ForLoop>(&_statement))
+		{
+			yulAssert(forLoop->condition);
+			std::optional<Control> control = execute(forLoop->pre, _variables);
+			if (!control || *control == Control::Leave)
+				return control;
+			while (true)
+			{
+				std::optional<u256> condition = evaluateSingle(*forLoop->condition, _variables);
+				if (!condition)
+					return std::nullopt;
+				if (*condition == 0)
+					break;
+				control = execute(forLoop->body, _variables);
+				if (!control || *control == Control::Leave)
+					return control;
+				if (*control == Control::Break)
+					break;
+				control = execute(forLoop->post, _variables);
+				if (!control || *control == Control::Leave)
+					return control;
+			}
+		}
+		else if (std::holds_alternative<Break>(_statement))
+			return Control::Break;
+		else if (std::holds_alternative<Continue>(_statement))
+			return Control::Continue;
+		else if (std::holds_alternative<Leave>(_statement))
+			return Control::Leave;
+		else if (auto const* block = std::get_if<Block>(&_statement))
+			return execute(*block, _variables);
+		else
+			yulAssert(std::holds_alternative<FunctionDefinition>(_statement));
+		return Control::Next;
+	}
+
+	std::optional<u256> evaluateSingle(Expression const& _expression, Variables& _variables)
+	{
+		std::optional<std::vector<u256>> values = evaluate(_expression, _variables);
+		if (!values)
+			return std::nullopt;
+		yulAssert(values->size() == 1);
+		return values->front();
+	}
+
+	std::optional<std::vector<u256>> evaluate(Expression const& _expression, Variables& _variables)
+	{
+		if (!step())
+			return std::nullopt;
+
+		if (std::holds_alternative<Literal>(_expression))
+		{
+			if (std::optional<u256> value = literalValue(_expression))
+				return std::vector<u256>{*value};
+			return std::nullopt;
+		}
+		else if (auto const* identifier = std::get_if<Identifier>(&_expression))
+		{
+			if (u256 const* value = valueOrNullptr(_variables, identifier->name))
+				return std::vector<u256>{*value};
+			return std::nullopt;
+		}
+
+		FunctionCall const& functionCall = std::get<FunctionCall>(_expression);
+		std::vector<u256> arguments;
+		for (Expression const& argument: functionCall.arguments)
+			if (std::optional<u256> value = evaluateSingle(argument, _variables))
+				arguments.emplace_back(*value);
+			else
+				return std::nullopt;
+
+		if (m_dialect.builtin(functionCall.functionName.name))
+		{
+			std::optional<Instruction> instruction = toEVMInstruction(m_dialect, functionCall.functionName.name);
+			if (!instruction)
+				return std::nullopt;
+			if (std::optional<u256> value = evaluateInstruction(*instruction, arguments))
+				return std::vector<u256>{*value};
+			return std::nullopt;
+		}
+		if (FunctionDefinition const* const* function = valueOrNullptr(m_functions, functionCall.functionName.name))
+			return call(**function, arguments);
+		return std::nullopt;
+	}
+
+	EVMDialect const& m_dialect;
+	std::map<YulName, FunctionDefinition const*> const& m_functions;
+	size_t m_steps = 0;
+	size_t m_callDepth = 0;
+};
+
+}
+
+void PureFunctionEvaluator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect))
+		PureFunctionEvaluator{*evmDialect, allFunctionDefinitions(_ast)}(_ast);
+}
+
+void PureFunctionEvaluator::visit(Expression& _expression)
+{
+	// Inner calls are evaluated first, which may turn the arguments of this call into literals.
+	ASTModifier::visit(_expression);
+
+	auto const* functionCall = std::get_if<FunctionCall>(&_expression);
+	if (!functionCall)
+		return;
+	FunctionDefinition const* function = valueOrDefault(m_functions, functionCall->functionName.name, nullptr);
+	if (!function || function->returnVariables.size() != 1)
+		return;
+	std::vector<u256> arguments;
+	for (Expression const& argument: functionCall->arguments)
+		if (std::optional<u256> value = literalValue(argument))
+			arguments.emplace_back(*value);
+		else
+			return;
+
+	auto [result, inserted] = m_results.try_emplace({function->name, arguments});
+	if (inserted)
+		if (std::optional<std::vector<u256>> returnValues = Evaluator{m_dialect, m_functions}.call(*function, arguments))
+			result->second = returnValues->front();
+	if (result->second)
+		_expression = Literal{
+			debugDataOf(_expression),
+			LiteralKind::Number,
+			LiteralValue{*result->second, std::nullopt}
+		};
+}
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that evaluates calls to pure functions with constant arguments.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/YulName.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+
+/**
+ * Optimisation stage that replaces calls to user-defined functions with a single return value
+ * whose arguments are all literals by the value the call returns, if it can be computed at
+ * compile time. For example
+ *
+ *   function pow10(n) -> r { r := 1 for { } n { n := sub(n, 1) } { r := mul(r, 10) } }
+ *   sstore(0, pow10(18))
+ *
+ * is turned into
+ *
+ *   function pow10(n) -> r { r := 1 for { } n { n := sub(n, 1) } { r := mul(r, 10) } }
+ *   sstore(0, 1000000000000000000)
+ *
+ * The call is evaluated by interpreting the function body. The evaluation fails and the call is
+ * kept if it reaches a built-in function other than one that purely computes on its arguments
+ * (like ``add``, ``lt`` or ``shl``, but not ``mload``, ``sload``, ``revert`` or ``calldataload``),
+ * if it exceeds a budget of evaluated statements and expressions or if it nests calls too deeply.
+ * Since only the path that is actually taken matters, the function may have other side-effects
+ * on paths that are not taken for the given arguments.
+ *
+ * The function definitions themselves are not changed and can be removed by the UnusedPruner
+ * if no other calls are left.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class PureFunctionEvaluator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"PureFunctionEvaluator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override;
+
+private:
+	PureFunctionEvaluator(EVMDialect const& _dialect, std::map<YulName, FunctionDefinition const*> _functions):
+		m_dialect(_dialect),
+		m_functions(std::move(_functions))
+	{}
+
+	EVMDialect const& m_dialect;
+	std::map<YulName, FunctionDefinition const*> m_functions;
+	/// Results of evaluated calls, nullopt if the evaluation failed.
+	std::map<std::pair<YulName, std::vector<u256>>, std::optional<u256>> m_results;
+};
+
+}
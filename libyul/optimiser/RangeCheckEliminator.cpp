@@ -0,0 +1,620 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes if statements whose condition is known to be
+ * zero from the ranges of values the involved variables can take.
+ */
+
+#include <libyul/optimiser/RangeCheckEliminator.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::evmasm;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of variable values and nested expressions that are followed
+/// when computing ranges.
+size_t constexpr c_maxDepth = 8;
+
+u256 const c_maxValue = std::numeric_limits<u256>::max();
+
+/// @returns the smallest value of the form 2**n - 1 that is not smaller than @a _value.
+u256 fillBits(u256 const& _value)
+{
+	if (_value == 0)
+		return 0;
+	return u256((bigint(1) << (boost::multiprecision::msb(_value) + 1)) - 1);
+}
+
+/// Finds ``break`` or ``continue`` statements that belong to the outermost loop.
+class LoopControlFinder: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(ForLoop const&) override {}
+	void operator()(FunctionDefinition const&) override {}
+	void operator()(Break const&) override { foundBreak = true; }
+	void operator()(Continue const&) override { foundContinue = true; }
+
+	bool foundBreak = false;
+	bool foundContinue = false;
+};
+
+}
+
+void RangeCheckEliminator::run(OptimiserStepContext const& _context, Block& _ast)
+{
+	RangeCheckEliminator eliminator{
+		_context.dialect,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+	};
+	eliminator(_ast);
+
+	StatementRemover remover{eliminator.m_pendingRemovals};
+	remover(_ast);
+}
+
+void RangeCheckEliminator::operator()(Assignment& _assignment)
+{
+	DataFlowAnalyzer::operator()(_assignment);
+	std::set<YulName> names;
+	for (auto const& var: _assignment.variableNames)
+		names.emplace(var.name);
+	forget(names);
+}
+
+void RangeCheckEliminator::operator()(VariableDeclaration& _varDecl)
+{
+	DataFlowAnalyzer::operator()(_varDecl);
+	std::set<YulName> names;
+	for (auto const& var: _varDecl.variables)
+		names.emplace(var.name);
+	forget(names);
+}
+
+void RangeCheckEliminator::operator()(If& _if)
+{
+	Bounds outerBounds = m_bounds;
+	learn(*_if.condition, true);
+	DataFlowAnalyzer::operator()(_if);
+	m_bounds = std::move(outerBounds);
+	forget(assignedVariableNames(_if.body));
+
+	// If the body does not continue, the condition is false after the if statement.
+	if (
+		!_if.body.statements.empty() &&
+		TerminationFinder(m_dialect, &m_controlFlowSideEffects).controlFlowKind(_if.body.statements.back()) !=
+			TerminationFinder::ControlFlow::FlowOut
+	)
+		learn(*_if.condition, false);
+}
+
+void RangeCheckEliminator::operator()(Switch& _switch)
+{
+	Bounds outerBounds = m_bounds;
+	std::set<YulName> assignedVariables;
+	for (auto const& _case: _switch.cases)
+	{
+		m_bounds = outerBounds;
+		if (_case.value)
+			restrict(*_switch.expression, Range{_case.value->value.value(), _case.value->value.value()});
+		m_initialBounds[&_case.body] = m_bounds;
+		assignedVariables += assignedVariableNames(_case.body);
+	}
+	m_bounds = outerBounds;
+
+	DataFlowAnalyzer::operator()(_switch);
+
+	for (auto const& _case: _switch.cases)
+		m_initialBounds.erase(&_case.body);
+	m_bounds = std::move(outerBounds);
+	forget(assignedVariables);
+}
+
+void RangeCheckEliminator::operator()(FunctionDefinition& _function)
+{
+	ScopedSaveAndRestore boundsResetter(m_bounds, {});
+	DataFlowAnalyzer::operator()(_function);
+}
+
+void RangeCheckEliminator::operator()(ForLoop& _for)
+{
+	forget(assignedVariableNames(_for.body) + assignedVariableNames(_for.post));
+	Bounds outerBounds = m_bounds;
+
+	m_loopBodies[&_for.body] = &_for;
+	DataFlowAnalyzer::operator()(_for);
+	m_loopBodies.erase(&_for.body);
+	m_initialBounds.erase(&_for.post);
+
+	m_bounds = std::move(outerBounds);
+	LoopControlFinder loopControl;
+	loopControl(_for.body);
+	// The loop can only be left through the condition or ``leave``.
+	if (!loopControl.foundBreak)
+		learn(*_for.condition, false);
+}
+
+void RangeCheckEliminator::operator()(Block& _block)
+{
+	if (Bounds const* initialBounds = valueOrNullptr(m_initialBounds, &_block))
+		m_bounds = *initialBounds;
+	if (ForLoop const* loop = valueOrDefault(m_loopBodies, &_block, nullptr))
+	{
+		learn(*loop->condition, true);
+		LoopControlFinder loopControl;
+		loopControl(_block);
+		// With ``continue``, the post block can be reached from anywhere in the body,
+		// so only the facts valid at its start can be used there.
+		if (loopControl.foundContinue)
+		{
+			Bounds bodyBounds = m_bounds;
+			forget(assignedVariableNames(_block));
+			m_initialBounds[&loop->post] = std::move(m_bounds);
+			m_bounds = std::move(bodyBounds);
+		}
+	}
+	DataFlowAnalyzer::operator()(_block);
+}
+
+void RangeCheckEliminator::visit(Statement& _statement)
+{
+	if (If const* _if = std::get_if<If>(&_statement))
+		if (range(*_if->condition).max == 0)
+		{
+			MovableChecker movableChecker{m_dialect, &m_functionSideEffects};
+			movableChecker.visit(*_if->condition);
+			if (movableChecker.movable())
+			{
+				m_pendingRemovals.insert(&_statement);
+				return;
+			}
+		}
+
+	DataFlowAnalyzer::visit(_statement);
+}
+
+RangeCheckEliminator::Range RangeCheckEliminator::range(Expression const& _expression, size_t _depth)
+{
+	Range result;
+	if (_depth > c_maxDepth)
+		return result;
+
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		return Range{literal->value.value(), literal->value.value()};
+	else if (Identifier const* identifier = std::get_if<Identifier>(&_expression))
+	{
+		if (Range const* bound = valueOrNullptr(m_bounds.ranges, identifier->name))
+			result = *bound;
+		if (AssignedValue const* value = variableValue(identifier->name))
+			result = result.intersectedWith(range(*value->value, _depth + 1));
+		return result;
+	}
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	std::optional<Instruction> instruction = toEVMInstruction(m_dialect, call.functionName.name);
+	if (!instruction)
+		return result;
+	auto const& arguments = call.arguments;
+	auto argumentRange = [&](size_t _index) { return range(arguments.at(_index), _depth + 1); };
+	switch (*instruction)
+	{
+	case Instruction::ADD:
+	{
+		Range a = argumentRange(0);
+		Range b = argumentRange(1);
+		if (bigint(a.max) + b.max <= c_maxValue)
+			result = Range{a.min + b.min, a.max + b.max};
+		break;
+	}
+	case Instruction::SUB:
+	{
+		Range a = argumentRange(0);
+		Range b = argumentRange(1);
+		if (a.min >= b.max)
+			result = Range{a.min - b.max, a.max - b.min};
+		else if (a.max >= b.min && knownNotLessThan(arguments.at(0), arguments.at(1), _depth + 1))
+			result = Range{0, a.max - b.min};
+		break;
+	}
+	case Instruction::MUL:
+	{
+		Range a = argumentRange(0);
+		Range b = argumentRange(1);
+		if (bigint(a.max) * b.max <= c_maxValue)
+			result = Range{a.min * b.min, a.max * b.max};
+		break;
+	}
+	case Instruction::DIV:
+	{
+		// Division by zero results in zero.
+		Range a = argumentRange(0);
+		Range b = argumentRange(1);
+		if (b.max == 0)
+			result = Range{0, 0};
+		else if (b.min == 0)
+			result = Range{0, a.max};
+		else
+			result = Range{a.min / b.max, a.max / b.min};
+		break;
+	}
+	case Instruction::MOD:
+	{
+		Range a = argumentRange(0);
+		Range b = argumentRange(1);
+		if (b.max == 0)
+			result = Range{0, 0};
+		else if (a.max < b.min)
+			result = a;
+		else
+			result = Range{0, std::min(a.max, b.max - 1)};
+		break;
+	}
+	case Instruction::AND:
+		result = Range{0, std::min(argumentRange(0).max, argumentRange(1).max)};
+		break;
+	case Instruction::OR:
+	{
+		Range a = argumentRange(0);
+		Range b = argumentRange(1);
+		result = Range{std::max(a.min, b.min), fillBits(std::max(a.max, b.max))};
+		break;
+	}
+	case Instruction::XOR:
+		result = Range{0, fillBits(std::max(argumentRange(0).max, argumentRange(1).max))};
+		break;
+	case Instruction::NOT:
+	{
+		Range a = argumentRange(0);
+		result = Range{~a.max, ~a.min};
+		break;
+	}
+	case Instruction::SHR:
+	{
+		Range shift = argumentRange(0);
+		Range value = argumentRange(1);
+		result = Range{
+			shift.max >= 256 ? 0 : u256(value.min >> unsigned(shift.max)),
+			shift.min >= 256 ? 0 : u256(value.max >> unsigned(shift.min))
+		};
+		break;
+	}
+	case Instruction::SHL:
+	{
+		Range shift = argumentRange(0);
+		Range value = argumentRange(1);
+		if (shift.isConstant() && shift.min < 256 && (bigint(value.max) << unsigned(shift.min)) <= c_maxValue)
+			result = Range{value.min << unsigned(shift.min), value.max << unsigned(shift.min)};
+		break;
+	}
+	case Instruction::BYTE:
+		result = Range{0, 0xff};
+		break;
+	case Instruction::LT:
+		result = lessThanRange(arguments.at(0), arguments.at(1), _depth + 1);
+		break;
+	case Instruction::GT:
+		result = lessThanRange(arguments.at(1), arguments.at(0), _depth + 1);
+		break;
+	case Instruction::SLT:
+		result = signedLessThanRange(arguments.at(0), arguments.at(1), _depth + 1);
+		break;
+	case Instruction::SGT:
+		result = signedLessThanRange(arguments.at(1), arguments.at(0), _depth + 1);
+		break;
+	case Instruction::EQ:
+	{
+		Range a = argumentRange(0);
+		Range b = argumentRange(1);
+		if (a.max < b.min || b.max < a.min)
+			result = Range{0, 0};
+		else if (knownEqual(arguments.at(0), arguments.at(1), _depth + 1))
+			result = Range{1, 1};
+		else
+			result = Range{0, 1};
+		break;
+	}
+	case Instruction::ISZERO:
+	{
+		Range a = argumentRange(0);
+		if (a.min > 0)
+			result = Range{0, 0};
+		else if (a.max == 0)
+			result = Range{1, 1};
+		else
+			result = Range{0, 1};
+		break;
+	}
+	default:
+		break;
+	}
+	return result;
+}
+
+RangeCheckEliminator::Range RangeCheckEliminator::lessThanRange(
+	Expression const& _a,
+	Expression const& _b,
+	size_t _depth
+)
+{
+	Identifier const* a = std::get_if<Identifier>(&_a);
+	Identifier const* b = std::get_if<Identifier>(&_b);
+	if (a && b)
+		for (auto const& [smaller, larger]: m_bounds.lessThan)
+		{
+			if (knownEqual(Identifier{{}, smaller}, _a, _depth) && knownEqual(Identifier{{}, larger}, _b, _depth))
+				return Range{1, 1};
+			if (knownEqual(Identifier{{}, smaller}, _b, _depth) && knownEqual(Identifier{{}, larger}, _a, _depth))
+				return Range{0, 0};
+		}
+	if (knownNotLessThan(_a, _b, _depth))
+		return Range{0, 0};
+
+	Range rangeA = range(_a, _depth);
+	Range rangeB = range(_b, _depth);
+	if (rangeA.max < rangeB.min)
+		return Range{1, 1};
+	else if (rangeA.min >= rangeB.max)
+		return Range{0, 0};
+	else
+		return Range{0, 1};
+}
+
+RangeCheckEliminator::Range RangeCheckEliminator::signedLessThanRange(
+	Expression const& _a,
+	Expression const& _b,
+	size_t _depth
+)
+{
+	// Within the non-negative and within the negative values, signed and unsigned
+	// comparison agree.
+	u256 const signBit = u256(1) << 255;
+	Range a = range(_a, _depth);
+	Range b = range(_b, _depth);
+	bool aNonNegative = a.max < signBit;
+	bool aNegative = a.min >= signBit;
+	bool bNonNegative = b.max < signBit;
+	bool bNegative = b.min >= signBit;
+	if ((aNonNegative && bNonNegative) || (aNegative && bNegative))
+		return lessThanRange(_a, _b, _depth);
+	else if (aNegative && bNonNegative)
+		return Range{1, 1};
+	else if (aNonNegative && bNegative)
+		return Range{0, 0};
+	else
+		return Range{0, 1};
+}
+
+bool RangeCheckEliminator::knownNotLessThan(Expression const& _a, Expression const& _b, size_t _depth)
+{
+	if (_depth > c_maxDepth)
+		return false;
+
+	Identifier const* a = std::get_if<Identifier>(&_a);
+	Identifier const* b = std::get_if<Identifier>(&_b);
+	if (a && b)
+		// _a = _b + difference
+		if (std::optional<u256> difference = m_knowledgeBase.differenceIfKnownConstant(a->name, b->name))
+			if (bigint(range(_b, _depth + 1).max) + *difference <= c_maxValue)
+				return true;
+
+	size_t depthA = _depth;
+	if (FunctionCall const* call = std::get_if<FunctionCall>(&resolve(_a, depthA)))
+		if (toEVMInstruction(m_dialect, call->functionName.name) == Instruction::ADD)
+		{
+			// _a = add(x, y) >= x if there is no overflow.
+			auto const& arguments = call->arguments;
+			if (
+				(knownEqual(arguments.at(0), _b, depthA + 1) || knownEqual(arguments.at(1), _b, depthA + 1)) &&
+				bigint(range(arguments.at(0), depthA + 1).max) + range(arguments.at(1), depthA + 1).max <= c_maxValue
+			)
+				return true;
+		}
+
+	size_t depthB = _depth;
+	if (FunctionCall const* call = std::get_if<FunctionCall>(&resolve(_b, depthB)))
+	{
+		auto const& arguments = call->arguments;
+		switch (toEVMInstruction(m_dialect, call->functionName.name).value_or(Instruction::INVALID))
+		{
+		case Instruction::SUB:
+			// _b = sub(x, y) <= x if there is no underflow.
+			return
+				knownEqual(arguments.at(0), _a, depthB + 1) &&
+				(
+					range(arguments.at(0), depthB + 1).min >= range(arguments.at(1), depthB + 1).max ||
+					knownNotLessThan(arguments.at(0), arguments.at(1), depthB + 1)
+				);
+		case Instruction::AND:
+			return knownEqual(arguments.at(0), _a, depthB + 1) || knownEqual(arguments.at(1), _a, depthB + 1);
+		case Instruction::DIV:
+		case Instruction::MOD:
+			return knownEqual(arguments.at(0), _a, depthB + 1);
+		case Instruction::SHR:
+			return knownEqual(arguments.at(1), _a, depthB + 1);
+		default:
+			break;
+		}
+	}
+	return false;
+}
+
+bool RangeCheckEliminator::knownEqual(Expression const& _a, Expression const& _b, size_t _depth)
+{
+	if (_depth > c_maxDepth)
+		return false;
+
+	Identifier const* a = std::get_if<Identifier>(&_a);
+	Identifier const* b = std::get_if<Identifier>(&_b);
+	if (a && b && (a->name == b->name || m_knowledgeBase.differenceIfKnownConstant(a->name, b->name) == u256(0)))
+		return true;
+
+	size_t depthA = _depth;
+	size_t depthB = _depth;
+	Expression const& resolvedA = resolve(_a, depthA);
+	Expression const& resolvedB = resolve(_b, depthB);
+	if (std::holds_alternative<Identifier>(resolvedA) != std::holds_alternative<Identifier>(resolvedB))
+		return false;
+	return SyntacticallyEqual{}(resolvedA, resolvedB);
+}
+
+Expression const& RangeCheckEliminator::resolve(Expression const& _expression, size_t& _depth) const
+{
+	Expression const* expression = &_expression;
+	while (_depth <= c_maxDepth)
+	{
+		Identifier const* identifier = std::get_if<Identifier>(expression);
+		AssignedValue const* value = identifier ? variableValue(identifier->name) : nullptr;
+		if (!value)
+			break;
+		expression = value->value;
+		++_depth;
+	}
+	return *expression;
+}
+
+void RangeCheckEliminator::learn(Expression const& _condition, bool _holds, size_t _depth)
+{
+	if (_depth > c_maxDepth)
+		return;
+
+	if (Identifier const* identifier = std::get_if<Identifier>(&_condition))
+	{
+		restrict(_condition, _holds ? Range{1, c_maxValue} : Range{0, 0});
+		if (AssignedValue const* value = variableValue(identifier->name))
+			learn(*value->value, _holds, _depth + 1);
+		return;
+	}
+
+	FunctionCall const* call = std::get_if<FunctionCall>(&_condition);
+	if (!call)
+		return;
+	auto const& arguments = call->arguments;
+	switch (toEVMInstruction(m_dialect, call->functionName.name).value_or(Instruction::INVALID))
+	{
+	case Instruction::ISZERO:
+		learn(arguments.at(0), !_holds, _depth + 1);
+		break;
+	case Instruction::LT:
+		learnLessThan(arguments.at(0), arguments.at(1), _holds, _depth + 1);
+		break;
+	case Instruction::GT:
+		learnLessThan(arguments.at(1), arguments.at(0), _holds, _depth + 1);
+		break;
+	case Instruction::EQ:
+	{
+		Range a = range(arguments.at(0), _depth + 1);
+		Range b = range(arguments.at(1), _depth + 1);
+		if (_holds)
+		{
+			restrict(arguments.at(0), b);
+			restrict(arguments.at(1), a);
+		}
+		else
+		{
+			// Only a constant at the boundary of a range can be excluded.
+			auto exclude = [&](Expression const& _expression, Range const& _range, Range const& _excluded) {
+				if (!_excluded.isConstant())
+					return;
+				if (_excluded.min == _range.min && _range.min < c_maxValue)
+					restrict(_expression, Range{_range.min + 1, c_maxValue});
+				else if (_excluded.min == _range.max && _range.max > 0)
+					restrict(_expression, Range{0, _range.max - 1});
+			};
+			exclude(arguments.at(0), a, b);
+			exclude(arguments.at(1), b, a);
+		}
+		break;
+	}
+	case Instruction::AND:
+		if (_holds)
+		{
+			learn(arguments.at(0), true, _depth + 1);
+			learn(arguments.at(1), true, _depth + 1);
+		}
+		break;
+	case Instruction::OR:
+		if (!_holds)
+		{
+			learn(arguments.at(0), false, _depth + 1);
+			learn(arguments.at(1), false, _depth + 1);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void RangeCheckEliminator::learnLessThan(Expression const& _a, Expression const& _b, bool _holds, size_t _depth)
+{
+	Range a = range(_a, _depth);
+	Range b = range(_b, _depth);
+	if (_holds)
+	{
+		if (b.max > 0)
+			restrict(_a, Range{0, b.max - 1});
+		if (a.min < c_maxValue)
+			restrict(_b, Range{a.min + 1, c_maxValue});
+		Identifier const* identifierA = std::get_if<Identifier>(&_a);
+		Identifier const* identifierB = std::get_if<Identifier>(&_b);
+		if (identifierA && identifierB)
+			m_bounds.lessThan.emplace(identifierA->name, identifierB->name);
+	}
+	else
+	{
+		restrict(_a, Range{b.min, c_maxValue});
+		restrict(_b, Range{0, a.max});
+	}
+}
+
+void RangeCheckEliminator::restrict(Expression const& _expression, Range const& _range)
+{
+	Identifier const* identifier = std::get_if<Identifier>(&_expression);
+	if (!identifier)
+		return;
+	Range current = valueOrDefault(m_bounds.ranges, identifier->name, Range{});
+	m_bounds.ranges[identifier->name] = current.intersectedWith(_range);
+}
+
+void RangeCheckEliminator::forget(std::set<YulName> const& _variables)
+{
+	for (YulName const& variable: _variables)
+		m_bounds.ranges.erase(variable);
+	for (auto it = m_bounds.lessThan.begin(); it != m_bounds.lessThan.end();)
+		if (_variables.count(it->first) || _variables.count(it->second))
+			it = m_bounds.lessThan.erase(it);
+		else
+			++it;
+}
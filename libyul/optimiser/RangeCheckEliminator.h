@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes if statements whose condition is known to be
+ * zero from the ranges of values the involved variables can take.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ControlFlowSideEffects.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that removes if statements whose condition is known to be
+ * zero from the ranges of values the involved variables can take.
+ *
+ * The main targets are the overflow and bounds checks of checked arithmetic and
+ * array accesses, like ``if gt(x, add(x, y)) { panic() }``, where ``x`` and ``y``
+ * are small enough for the addition not to overflow.
+ *
+ * For each variable, an interval of its possible (unsigned) values is computed from
+ * its current value and from facts established by the control-flow:
+ *  - inside the body of an if statement, its condition is non-zero,
+ *  - inside the body of a for loop, its condition is non-zero,
+ *  - after an if statement whose body does not continue, its condition is zero,
+ *  - after a for loop without ``break``, its condition is zero.
+ * Conditions of the form ``lt(a, b)`` between variables are also remembered,
+ * so that the same comparison can be evaluated later on.
+ *
+ * Works best if the code is in SSA form and the for loop conditions have been
+ * moved into the loop body by the ForLoopConditionIntoBody step.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter, FunctionHoister.
+ */
+class RangeCheckEliminator: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"RangeCheckEliminator"};
+	static void run(OptimiserStepContext const&, Block& _ast);
+
+	using DataFlowAnalyzer::operator();
+	void operator()(Assignment& _assignment) override;
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+	void operator()(FunctionDefinition& _function) override;
+	void operator()(ForLoop& _for) override;
+	void operator()(Block& _block) override;
+
+private:
+	/// Closed interval of unsigned values.
+	struct Range
+	{
+		u256 min = 0;
+		u256 max = std::numeric_limits<u256>::max();
+
+		bool isConstant() const { return min == max; }
+		/// @returns the intersection with @a _other or this range if the intersection is empty,
+		/// which can only happen in unreachable code.
+		Range intersectedWith(Range const& _other) const
+		{
+			Range result{std::max(min, _other.min), std::min(max, _other.max)};
+			return result.min <= result.max ? result : *this;
+		}
+	};
+	/// Facts about the variables that hold at the current point of the analysis.
+	struct Bounds
+	{
+		YulNameMap<Range> ranges;
+		/// Pairs of variables (a, b) such that a < b.
+		std::set<std::pair<YulName, YulName>> lessThan;
+	};
+
+	RangeCheckEliminator(
+		Dialect const& _dialect,
+		std::map<YulName, SideEffects> _functionSideEffects,
+		std::map<YulName, ControlFlowSideEffects> _controlFlowSideEffects
+	):
+		DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore, std::move(_functionSideEffects)),
+		m_controlFlowSideEffects(std::move(_controlFlowSideEffects))
+	{}
+
+	using ASTModifier::visit;
+	void visit(Statement& _statement) override;
+
+	/// @returns the range of values the expression can evaluate to.
+	Range range(Expression const& _expression, size_t _depth = 0);
+	/// @returns the range of ``lt(_a, _b)``.
+	Range lessThanRange(Expression const& _a, Expression const& _b, size_t _depth);
+	/// @returns the range of ``slt(_a, _b)``.
+	Range signedLessThanRange(Expression const& _a, Expression const& _b, size_t _depth);
+	/// @returns true if ``_a >= _b`` follows from the values of the expressions,
+	/// for example because ``_a`` is ``add(_b, y)`` and the addition does not overflow.
+	bool knownNotLessThan(Expression const& _a, Expression const& _b, size_t _depth);
+	/// @returns true if ``_a`` and ``_b`` are known to evaluate to the same value.
+	bool knownEqual(Expression const& _a, Expression const& _b, size_t _depth);
+	/// Follows the current values of variables as long as they are known.
+	Expression const& resolve(Expression const& _expression, size_t& _depth) const;
+
+	/// Records the facts implied by @a _condition being non-zero (if @a _holds is true)
+	/// or zero (if @a _holds is false).
+	void learn(Expression const& _condition, bool _holds, size_t _depth = 0);
+	void learnLessThan(Expression const& _a, Expression const& _b, bool _holds, size_t _depth);
+	/// Intersects the range of @a _expression with @a _range if it is a variable.
+	void restrict(Expression const& _expression, Range const& _range);
+	/// Removes all facts about the given variables.
+	void forget(std::set<YulName> const& _variables);
+
+	std::map<YulName, ControlFlowSideEffects> m_controlFlowSideEffects;
+	Bounds m_bounds;
+	/// For loops by their body.
+	std::map<Block const*, ForLoop const*> m_loopBodies;
+	/// Facts valid at the start of switch case bodies and of loop post blocks
+	/// that can be reached through ``continue``.
+	std::map<Block const*, Bounds> m_initialBounds;
+	std::set<Statement const*> m_pendingRemovals;
+};
+
+}
@@ -126,37 +126,44 @@ std::map<YulName, SideEffects> SideEffectsPropagator::sideEffects(
 	// In the future, we should refine that, because the property
 	// is actually a bit different from "not movable".
 
-	std::map<YulName, SideEffects> ret;
-	for (auto const& function: _directCallGraph.functionsWithLoops + _directCallGraph.recursiveFunctions())
-	{
-		ret[function].movable = false;
-		ret[function].canBeRemoved = false;
-		ret[function].canBeRemovedIfNoMSize = false;
-		ret[function].cannotLoop = false;
-	}
-
+	util::StronglyConnectedComponents<YulName> callGraphComponents;
+	auto forEachCallee = [&](YulName _function, auto&& _addChild) {
+		for (YulName callee: _directCallGraph.functionCalls.at(_function))
+			if (!_dialect.builtin(callee))
+				_addChild(callee);
+	};
 	for (auto const& call: _directCallGraph.functionCalls)
+		callGraphComponents.run(call.first, forEachCallee);
+
+	// The components are in reverse topological order, so the side-effects of all
+	// called functions outside of a component are final once it is processed.
+	// All functions of a component call each other and thus share their side-effects.
+	std::map<YulName, SideEffects> ret;
+	for (std::vector<YulName> const& component: callGraphComponents.components)
 	{
-		YulName funName = call.first;
 		SideEffects sideEffects;
-		auto _visit = [&, visited = std::set<YulName>{}](YulName _function, auto&& _recurse) mutable {
-			if (!visited.insert(_function).second)
-				return;
-			if (sideEffects == SideEffects::worst())
-				return;
-			if (BuiltinFunction const* f = _dialect.builtin(_function))
-				sideEffects += f->sideEffects;
-			else
-			{
-				if (ret.count(_function))
-					sideEffects += ret[_function];
-				for (YulName callee: _directCallGraph.functionCalls.at(_function))
-					_recurse(callee, _recurse);
-			}
-		};
-		for (auto const& _v: call.second)
-			_visit(_v, _visit);
-		ret[funName] += sideEffects;
+		bool containsLoop = component.size() > 1;
+		for (YulName function: component)
+		{
+			if (_directCallGraph.functionsWithLoops.count(function))
+				containsLoop = true;
+			for (YulName callee: _directCallGraph.functionCalls.at(function))
+				if (BuiltinFunction const* f = _dialect.builtin(callee))
+					sideEffects += f->sideEffects;
+				else if (callee == function)
+					containsLoop = true;
+				else if (SideEffects const* calleeSideEffects = util::valueOrNullptr(ret, callee))
+					sideEffects += *calleeSideEffects;
+		}
+		if (containsLoop)
+		{
+			sideEffects.movable = false;
+			sideEffects.canBeRemoved = false;
+			sideEffects.canBeRemovedIfNoMSize = false;
+			sideEffects.cannotLoop = false;
+		}
+		for (YulName function: component)
+			ret[function] = sideEffects;
 	}
 	return ret;
 }
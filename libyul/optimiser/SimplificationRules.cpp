@@ -47,20 +47,53 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// Rules store their match groups internally, so each thread needs its own instance.
+	thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
 		version = evmDialect->evmVersion();
 
-	if (!evmRules[version])
-		evmRules[version] = std::make_unique<SimplificationRules>(version);
+	std::unique_ptr<SimplificationRules>& rulesForVersion = evmRules[version];
+	if (!rulesForVersion)
+		rulesForVersion = std::make_unique<SimplificationRules>(version);
 
-	SimplificationRules& rules = *evmRules[version];
+	SimplificationRules& rules = *rulesForVersion;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	std::vector<Rule> const& candidates = rules.m_rules[uint8_t(instruction->first)];
+	if (candidates.empty())
+		return nullptr;
+
+	// Resolve the arguments only once for all candidate rules. Direct function calls
+	// as arguments are never matched, see Pattern::matches.
+	rules.m_resolvedArguments.clear();
+	for (Expression const& argument: *instruction->second)
 	{
+		if (std::holds_alternative<FunctionCall>(argument))
+			return nullptr;
+		Expression const* value = &argument;
+		if (Identifier const* identifier = std::get_if<Identifier>(&argument))
+			if (AssignedValue const* assignedValue = _ssaValues(identifier->name))
+				if (assignedValue->value)
+					value = assignedValue->value;
+
+		ResolvedArgument& resolved = rules.m_resolvedArguments.emplace_back();
+		if (Literal const* literal = std::get_if<Literal>(value))
+		{
+			if (literal->kind == LiteralKind::Number)
+				resolved.numberLiteral = literal;
+		}
+		else if (auto argumentInstruction = instructionAndArguments(_dialect, *value))
+			resolved.instruction = argumentInstruction->first;
+	}
+
+	std::vector<std::vector<ArgumentFilter>> const& filters = rules.m_argumentFilters[uint8_t(instruction->first)];
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		if (!rules.mayMatch(filters[i]))
+			continue;
+		Rule const& rule = candidates[i];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -69,6 +102,32 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	return nullptr;
 }
 
+bool SimplificationRules::mayMatch(std::vector<ArgumentFilter> const& _filters) const
+{
+	yulAssert(_filters.size() == m_resolvedArguments.size());
+	for (size_t i = 0; i < _filters.size(); ++i)
+	{
+		ArgumentFilter const& filter = _filters[i];
+		ResolvedArgument const& argument = m_resolvedArguments[i];
+		switch (filter.kind)
+		{
+		case PatternKind::Constant:
+			if (!argument.numberLiteral)
+				return false;
+			if (filter.value && *filter.value != argument.numberLiteral->value.value())
+				return false;
+			break;
+		case PatternKind::Operation:
+			if (argument.instruction != filter.instruction)
+				return false;
+			break;
+		case PatternKind::Any:
+			break;
+		}
+	}
+	return true;
+}
+
 bool SimplificationRules::isInitialized() const
 {
 	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
@@ -94,7 +153,15 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
+	std::vector<ArgumentFilter> filters;
+	for (Pattern const& argument: _rule.pattern.arguments())
+		filters.push_back({
+			argument.kind(),
+			argument.kind() == PatternKind::Operation ? argument.instruction() : evmasm::Instruction{},
+			argument.kind() == PatternKind::Constant ? argument.constantValue() : std::nullopt
+		});
 	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_argumentFilters[uint8_t(_rule.pattern.instruction())].push_back(std::move(filters));
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
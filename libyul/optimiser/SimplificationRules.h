@@ -42,6 +42,13 @@ struct Dialect;
 struct AssignedValue;
 class Pattern;
 
+enum class PatternKind
+{
+	Operation,
+	Constant,
+	Any
+};
+
 using DebugData = langutil::DebugData;
 
 /**
@@ -75,20 +82,39 @@ public:
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
 private:
+	/// Requirement of a rule on one argument of the expression, derived from the top-level
+	/// pattern of the rule. Checking it is much cheaper than running the full pattern
+	/// matcher and rejects most rules that do not apply.
+	struct ArgumentFilter
+	{
+		PatternKind kind;
+		/// Only valid if kind is Operation.
+		evmasm::Instruction instruction;
+		/// Required value if kind is Constant and the pattern requires a specific value.
+		std::optional<u256> value;
+	};
+	/// What an argument of the expression is known to be after resolving variables to their values.
+	struct ResolvedArgument
+	{
+		Literal const* numberLiteral = nullptr;
+		std::optional<evmasm::Instruction> instruction;
+	};
+
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
+	/// @returns false if the rule with the given argument filters cannot match arguments
+	/// resolved to m_resolvedArguments.
+	bool mayMatch(std::vector<ArgumentFilter> const& _filters) const;
+
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
-};
-
-enum class PatternKind
-{
-	Operation,
-	Constant,
-	Any
+	/// Argument filters of the rules in m_rules, in the same order.
+	std::vector<std::vector<ArgumentFilter>> m_argumentFilters[256];
+	/// Arguments of the expression currently being matched, reused across calls.
+	std::vector<ResolvedArgument> m_resolvedArguments;
 };
 
 /**
@@ -125,6 +151,9 @@ public:
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	PatternKind kind() const { return m_kind; }
+	/// @returns the value a constant pattern requires, if it requires a specific one.
+	std::optional<u256> constantValue() const { return m_data ? std::make_optional(*m_data) : std::nullopt; }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
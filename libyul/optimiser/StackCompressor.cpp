@@ -27,6 +27,7 @@
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
 
 #include <libyul/backends/evm/ControlFlowGraphBuilder.h>
 #include <libyul/backends/evm/StackHelpers.h>
@@ -234,6 +235,67 @@ void eliminateVariablesOptimizedCodegen(
 	UnusedPruner::runUntilStabilised(_dialect, _ast, _allowMSizeOptimization, nullptr, allFunctions);
 }
 
+/// @returns the stack deficit of every function of @a _object with the code @a _astRoot that is not
+/// compilable. If @a _functionsToCheck is given, only the main block (the empty name) and the listed
+/// functions are compiled. The bodies of the other functions are left out, so they are assumed to be
+/// compilable. This is correct since the stack layout of a function does not depend on the bodies
+/// of other functions.
+std::map<YulName, int> stackDeficit(
+	Dialect const& _dialect,
+	Object const& _object,
+	Block const& _astRoot,
+	bool _optimizeStackAllocation,
+	std::optional<std::set<YulName>> const& _functionsToCheck
+)
+{
+	auto check = [&](YulName _name) { return !_functionsToCheck || _functionsToCheck->count(_name); };
+	Block code{_astRoot.debugData, {}};
+	code.statements.reserve(_astRoot.statements.size());
+	for (Statement const& statement: _astRoot.statements)
+		if (FunctionDefinition const* function = std::get_if<FunctionDefinition>(&statement); function && !check(function->name))
+			code.statements.emplace_back(FunctionDefinition{
+				function->debugData,
+				function->name,
+				function->parameters,
+				function->returnVariables,
+				Block{function->body.debugData, {}}
+			});
+		else if (Block const* block = std::get_if<Block>(&statement); block && !check(YulName{}))
+			code.statements.emplace_back(Block{block->debugData, {}});
+		else
+			code.statements.emplace_back(ASTCopier{}.translate(statement));
+
+	Object object(_object);
+	object.setCode(std::make_shared<AST>(std::move(code)));
+	return CompilabilityChecker(_dialect, object, _optimizeStackAllocation).stackDeficit;
+}
+
+/// @returns the names of the functions that differ between @a _before and @a _after, with the
+/// empty name for the main block, or nullopt if the top-level statements do not correspond.
+std::optional<std::set<YulName>> changedFunctions(Block const& _before, Block const& _after)
+{
+	if (_before.statements.size() != _after.statements.size())
+		return std::nullopt;
+
+	std::set<YulName> changed;
+	for (size_t i = 0; i < _before.statements.size(); ++i)
+	{
+		Statement const& before = _before.statements[i];
+		Statement const& after = _after.statements[i];
+		if (before.index() != after.index())
+			return std::nullopt;
+		if (SyntacticallyEqual{}(before, after))
+			continue;
+		if (FunctionDefinition const* function = std::get_if<FunctionDefinition>(&after))
+			changed.insert(function->name);
+		else if (std::holds_alternative<Block>(after))
+			changed.insert(YulName{});
+		else
+			return std::nullopt;
+	}
+	return changed;
+}
+
 }
 
 std::tuple<bool, Block> StackCompressor::run(
@@ -259,28 +321,48 @@ std::tuple<bool, Block> StackCompressor::run(
 	{
 		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, astRoot, _object.qualifiedDataNames());
 		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, astRoot);
+		auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg);
+		if (std::all_of(stackTooDeepErrors.begin(), stackTooDeepErrors.end(), [](auto const& _item) { return _item.second.empty(); }))
+			return std::make_tuple(true, std::move(astRoot));
 		eliminateVariablesOptimizedCodegen(
 			_dialect,
 			astRoot,
-			StackLayoutGenerator::reportStackTooDeep(*cfg),
+			stackTooDeepErrors,
 			allowMSizeOptimization
 		);
 	}
 	else
 	{
+		// Functions are only compiled again if they were not compilable or changed since they were
+		// last compiled. This requires all functions to be defined at the top level.
+		bool const onlyTopLevelFunctions =
+			NameCollector{astRoot, NameCollector::OnlyFunctions}.names().size() ==
+			static_cast<size_t>(std::count_if(astRoot.statements.begin(), astRoot.statements.end(), [](Statement const& _statement) {
+				return std::holds_alternative<FunctionDefinition>(_statement);
+			}));
+		std::optional<std::set<YulName>> functionsToCheck;
 		for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 		{
-			Object object(_object);
-			object.setCode(std::make_shared<AST>(std::get<Block>(ASTCopier{}(astRoot))));
-			std::map<YulName, int> stackSurplus = CompilabilityChecker(_dialect, object, _optimizeStackAllocation).stackDeficit;
+			std::map<YulName, int> stackSurplus = stackDeficit(_dialect, _object, astRoot, _optimizeStackAllocation, functionsToCheck);
 			if (stackSurplus.empty())
 				return std::make_tuple(true, std::move(astRoot));
+
+			std::optional<Block> before;
+			if (onlyTopLevelFunctions)
+				before = ASTCopier{}.translate(astRoot);
 			eliminateVariables(
 				_dialect,
 				astRoot,
 				stackSurplus,
 				allowMSizeOptimization
 			);
+			if (before)
+			{
+				functionsToCheck = changedFunctions(*before, astRoot);
+				if (functionsToCheck)
+					for (auto const& [functionName, surplus]: stackSurplus)
+						functionsToCheck->insert(functionName);
+			}
 		}
 	}
 	return std::make_tuple(false, std::move(astRoot));
@@ -46,6 +46,8 @@ class StackCompressor
 public:
 	/// Try to remove local variables until the AST is compilable.
 	/// @returns tuple with true if it was successful as first element, second element is the modified AST.
+	/// With the optimized code generator, success is only reported if the AST was already compilable,
+	/// in which case it is returned unchanged.
 	static std::tuple<bool, Block> run(
 		Dialect const& _dialect,
 		Object const& _object,
@@ -16,6 +16,7 @@
 */
 
 #include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
@@ -33,8 +34,11 @@
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/CommonData.h>
 
+#include <range/v3/algorithm/stable_sort.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/concat.hpp>
+#include <range/v3/view/map.hpp>
+#include <range/v3/view/reverse.hpp>
 #include <range/v3/view/take.hpp>
 
 using namespace solidity;
@@ -42,6 +46,215 @@ using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Determines which of the given candidate variables interfere, i.e. cannot share a memory slot, using a
+ * backwards liveness analysis of the candidates on the AST of each function (and of the main code).
+ * A variable interferes with every candidate that is live after any of its declarations or assignments, and
+ * with the other variables declared or assigned by the same statement. Function parameters and return variables
+ * are assigned on function entry and return variables are live at every exit of their function.
+ */
+class VariableInterference
+{
+public:
+	VariableInterference(Block const& _astRoot, std::set<YulName> _candidates):
+		m_candidates(std::move(_candidates))
+	{
+		block(_astRoot, {});
+	}
+
+	/// @returns true, if @a _a and @a _b may be live at the same time.
+	bool interfering(YulName _a, YulName _b) const
+	{
+		return m_interferences.count(std::minmax(_a, _b));
+	}
+
+private:
+	using Live = std::set<YulName>;
+	struct LoopContext
+	{
+		Live breakLive;
+		Live continueLive;
+	};
+
+	Live block(Block const& _block, Live _live)
+	{
+		for (Statement const& statement: _block.statements | ranges::views::reverse)
+			_live = std::visit([&](auto const& _statement) { return visit(_statement, std::move(_live)); }, statement);
+		return _live;
+	}
+
+	Live visit(ExpressionStatement const& _statement, Live _live)
+	{
+		addUses(_statement.expression, _live);
+		return _live;
+	}
+	Live visit(Assignment const& _assignment, Live _live)
+	{
+		std::vector<YulName> names;
+		for (Identifier const& identifier: _assignment.variableNames)
+			names.emplace_back(identifier.name);
+		define(names, _live);
+		addUses(*_assignment.value, _live);
+		return _live;
+	}
+	Live visit(VariableDeclaration const& _varDecl, Live _live)
+	{
+		std::vector<YulName> names;
+		for (NameWithDebugData const& var: _varDecl.variables)
+			names.emplace_back(var.name);
+		define(names, _live);
+		if (_varDecl.value)
+			addUses(*_varDecl.value, _live);
+		return _live;
+	}
+	Live visit(If const& _if, Live _live)
+	{
+		_live += block(_if.body, _live);
+		addUses(*_if.condition, _live);
+		return _live;
+	}
+	Live visit(Switch const& _switch, Live _live)
+	{
+		bool hasDefault = false;
+		Live result;
+		for (Case const& _case: _switch.cases)
+		{
+			hasDefault = hasDefault || !_case.value;
+			result += block(_case.body, _live);
+		}
+		if (!hasDefault)
+			result += _live;
+		addUses(*_switch.expression, result);
+		return result;
+	}
+	Live visit(ForLoop const& _loop, Live _live)
+	{
+		// Iterate to a fixed point of the variables live at the loop condition.
+		Live conditionLive;
+		while (true)
+		{
+			Live postLive = block(_loop.post, conditionLive);
+			m_loops.emplace_back(LoopContext{_live, postLive});
+			Live newConditionLive = block(_loop.body, postLive) + _live;
+			m_loops.pop_back();
+			addUses(*_loop.condition, newConditionLive);
+			if (newConditionLive == conditionLive)
+				break;
+			conditionLive = std::move(newConditionLive);
+		}
+		return block(_loop.pre, std::move(conditionLive));
+	}
+	Live visit(Break const&, Live)
+	{
+		yulAssert(!m_loops.empty());
+		return m_loops.back().breakLive;
+	}
+	Live visit(Continue const&, Live)
+	{
+		yulAssert(!m_loops.empty());
+		return m_loops.back().continueLive;
+	}
+	Live visit(Leave const&, Live)
+	{
+		return m_leaveLive;
+	}
+	Live visit(FunctionDefinition const& _function, Live _live)
+	{
+		std::vector<LoopContext> outerLoops = std::exchange(m_loops, {});
+		Live outerLeaveLive = std::exchange(m_leaveLive, {});
+
+		std::vector<YulName> arguments;
+		for (NameWithDebugData const& var: ranges::concat_view(_function.parameters, _function.returnVariables))
+			arguments.emplace_back(var.name);
+		for (NameWithDebugData const& var: _function.returnVariables)
+			if (m_candidates.count(var.name))
+				m_leaveLive.insert(var.name);
+		Live entryLive = block(_function.body, m_leaveLive);
+		define(arguments, entryLive);
+
+		m_loops = std::move(outerLoops);
+		m_leaveLive = std::move(outerLeaveLive);
+		return _live;
+	}
+	Live visit(Block const& _block, Live _live)
+	{
+		return block(_block, std::move(_live));
+	}
+
+	/// Records the interferences of assigning to @a _names and removes them from @a _live.
+	void define(std::vector<YulName> const& _names, Live& _live)
+	{
+		for (YulName name: _names)
+			if (m_candidates.count(name))
+			{
+				for (YulName other: _live + _names)
+					if (other != name && m_candidates.count(other))
+						m_interferences.insert(std::minmax(name, other));
+			}
+		for (YulName name: _names)
+			_live.erase(name);
+	}
+	void addUses(Expression const& _expression, Live& _live)
+	{
+		if (Identifier const* identifier = std::get_if<Identifier>(&_expression))
+		{
+			if (m_candidates.count(identifier->name))
+				_live.insert(identifier->name);
+		}
+		else if (FunctionCall const* call = std::get_if<FunctionCall>(&_expression))
+			for (Expression const& argument: call->arguments)
+				addUses(argument, _live);
+	}
+
+	std::set<YulName> m_candidates;
+	std::set<std::pair<YulName, YulName>> m_interferences;
+	std::vector<LoopContext> m_loops;
+	Live m_leaveLive;
+};
+
+/**
+ * Estimates the cost of moving each variable to memory by counting its declarations, references and assignments.
+ * Accesses inside for-loops are weighted by 8 to the power of the loop nesting depth (capped at a depth of 4).
+ */
+struct AccessCostEstimator: ASTWalker
+{
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override
+	{
+		costs[_identifier.name] += weight();
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (NameWithDebugData const& var: _varDecl.variables)
+			costs[var.name] += weight();
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(ForLoop const& _for) override
+	{
+		(*this)(_for.pre);
+		++loopDepth;
+		visit(*_for.condition);
+		(*this)(_for.body);
+		(*this)(_for.post);
+		--loopDepth;
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		size_t outerLoopDepth = std::exchange(loopDepth, 0);
+		for (NameWithDebugData const& var: ranges::concat_view(_function.parameters, _function.returnVariables))
+			costs[var.name] += weight();
+		ASTWalker::operator()(_function);
+		loopDepth = outerLoopDepth;
+	}
+	uint64_t weight() const
+	{
+		return uint64_t(1) << (3 * std::min<size_t>(loopDepth, 4));
+	}
+
+	size_t loopDepth = 0;
+	std::map<YulName, uint64_t> costs;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -53,6 +266,8 @@ namespace
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
  * - If not, assign each variable its slot starting from ``n`` (incrementing it).
+ *   If ``interference`` is set, a variable instead gets the lowest slot starting from ``n`` that is not yet
+ *   used by an interfering variable of the same function.
  * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
  */
 struct MemoryOffsetAllocator
@@ -85,11 +300,26 @@ struct MemoryOffsetAllocator
 
 			// Assign slots for all variables that become unreachable in the function body, if the above did not
 			// assign a slot for them already.
+			uint64_t const firstSharedSlot = requiredSlots;
+			std::vector<YulName> allocatedVariables;
 			for (YulName variable: *unreachables)
 				// The empty case is a function with too many arguments or return values,
 				// which was already handled above.
 				if (!variable.empty() && !slotAllocations.count(variable))
-					slotAllocations[variable] = requiredSlots++;
+				{
+					uint64_t slot = requiredSlots;
+					if (interference)
+					{
+						std::set<uint64_t> occupiedSlots;
+						for (YulName other: allocatedVariables)
+							if (interference->interfering(variable, other))
+								occupiedSlots.insert(slotAllocations.at(other));
+						for (slot = firstSharedSlot; occupiedSlots.count(slot); ++slot) {}
+					}
+					slotAllocations[variable] = slot;
+					allocatedVariables.emplace_back(variable);
+					requiredSlots = std::max(requiredSlots, slot + 1);
+				}
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
@@ -102,6 +332,8 @@ struct MemoryOffsetAllocator
 	std::map<YulName, std::vector<YulName>> const& callGraph;
 	/// Maps the name of each user-defined function to its definition.
 	std::map<YulName, FunctionDefinition const*> const& functionDefinitions;
+	/// If set, used to let variables with disjoint lifetimes share memory slots.
+	VariableInterference const* interference = nullptr;
 
 	/// Maps variable names to the memory slot the respective variable is assigned.
 	std::map<YulName, uint64_t> slotAllocations{};
@@ -120,7 +352,9 @@ u256 literalArgumentValue(FunctionCall const& _call)
 
 Block StackLimitEvader::run(
 	OptimiserStepContext& _context,
-	Object const& _object
+	Object const& _object,
+	bool _chooseByAccessCosts,
+	bool _reuseSlots
 )
 {
 	yulAssert(_object.hasCode());
@@ -134,7 +368,7 @@ Block StackLimitEvader::run(
 	{
 		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(*evmDialect, astRoot, _object.qualifiedDataNames());
 		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *evmDialect, astRoot);
-		run(_context, astRoot, StackLayoutGenerator::reportStackTooDeep(*cfg));
+		run(_context, astRoot, StackLayoutGenerator::reportStackTooDeep(*cfg), _chooseByAccessCosts, _reuseSlots);
 	}
 	else
 	{
@@ -142,7 +376,7 @@ Block StackLimitEvader::run(
 			_context.dialect,
 			_object,
 			true,
-		}.unreachableVariables);
+		}.unreachableVariables, _reuseSlots);
 	}
 	return astRoot;
 }
@@ -150,26 +384,59 @@ Block StackLimitEvader::run(
 void StackLimitEvader::run(
 	OptimiserStepContext& _context,
 	Block& _astRoot,
-	std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors
+	std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors,
+	bool _chooseByAccessCosts,
+	bool _reuseSlots
 )
 {
+	std::map<YulName, uint64_t> accessCosts;
+	if (_chooseByAccessCosts)
+	{
+		AccessCostEstimator estimator;
+		estimator(_astRoot);
+		accessCosts = std::move(estimator.costs);
+	}
+
 	std::map<YulName, std::vector<YulName>> unreachableVariables;
 	for (auto&& [function, stackTooDeepErrors]: _stackTooDeepErrors)
 	{
 		auto& unreachables = unreachableVariables[function];
-		// TODO: choose wisely.
 		for (auto const& stackTooDeepError: stackTooDeepErrors)
-			for (auto variable: stackTooDeepError.variableChoices | ranges::views::take(stackTooDeepError.deficit))
-				if (!util::contains(unreachables, variable))
-					unreachables.emplace_back(variable);
+		{
+			if (!_chooseByAccessCosts)
+			{
+				for (auto variable: stackTooDeepError.variableChoices | ranges::views::take(stackTooDeepError.deficit))
+					if (!util::contains(unreachables, variable))
+						unreachables.emplace_back(variable);
+				continue;
+			}
+
+			// Variables already moved to memory for a previous error reduce the deficit of this one.
+			// The rest of the deficit is covered by the variables that are cheapest to access from memory.
+			size_t deficit = stackTooDeepError.deficit;
+			std::vector<YulName> candidates;
+			for (YulName variable: stackTooDeepError.variableChoices)
+				if (util::contains(unreachables, variable))
+					deficit -= std::min<size_t>(deficit, 1);
+				else if (!util::contains(candidates, variable))
+					candidates.emplace_back(variable);
+			ranges::stable_sort(candidates, [&](YulName _a, YulName _b) {
+				return
+					util::valueOrDefault(accessCosts, _a, uint64_t(0), util::allow_copy) <
+					util::valueOrDefault(accessCosts, _b, uint64_t(0), util::allow_copy);
+			});
+			for (YulName variable: candidates | ranges::views::take(deficit))
+				unreachables.emplace_back(variable);
+		}
 	}
-	run(_context, _astRoot, unreachableVariables);
+	run(_context, _astRoot, unreachableVariables, _reuseSlots);
 }
 
 void StackLimitEvader::run(
 	OptimiserStepContext& _context,
 	Block& _astRoot,
-	std::map<YulName, std::vector<YulName>> const& _unreachableVariables
+	std::map<YulName, std::vector<YulName>> const& _unreachableVariables,
+	bool _reuseSlots
 )
 {
 	auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
@@ -200,7 +467,23 @@ void StackLimitEvader::run(
 
 	std::map<YulName, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(_astRoot);
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
+	std::optional<VariableInterference> interference;
+	if (_reuseSlots)
+	{
+		std::set<YulName> candidates;
+		for (auto const& variables: _unreachableVariables | ranges::views::values)
+			for (YulName variable: variables)
+				if (!variable.empty())
+					candidates.insert(variable);
+		interference.emplace(_astRoot, std::move(candidates));
+	}
+
+	MemoryOffsetAllocator memoryOffsetAllocator{
+		_unreachableVariables,
+		callGraph.functionCalls,
+		functionDefinitions,
+		interference ? &*interference : nullptr
+	};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 	yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
 
@@ -45,6 +45,11 @@ struct Object;
  * The current arguments to the ``memoryguard`` calls are used as base memory offset and then replaced by the offset past
  * the last memory offset used for a variable on any path through the call graph.
  *
+ * Optionally, variables of the same function whose lifetimes are disjoint (determined by a liveness analysis of the
+ * moved variables) can share a memory offset, and the variables chosen to resolve a stack too deep error can be the ones with
+ * the lowest estimated access costs (static uses weighted by their loop nesting depth) instead of the first ones
+ * reported.
+ *
  * Finally, the StackToMemoryMover is called to actually move the variables to their offsets in memory.
  *
  * Prerequisite: Disambiguator
@@ -57,20 +62,26 @@ public:
 	/// Abort and do nothing, if no ``memoryguard`` call or several ``memoryguard`` calls
 	/// with non-matching arguments are found, or if any of the @a _unreachableVariables
 	/// are contained in a recursive function.
+	/// If @a _reuseSlots is true, variables with disjoint lifetimes may share a memory slot.
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _astRoot,
-		std::map<YulName, std::vector<YulName>> const& _unreachableVariables
+		std::map<YulName, std::vector<YulName>> const& _unreachableVariables,
+		bool _reuseSlots = false
 	);
 	/// @a _stackTooDeepErrors can be determined by the StackLayoutGenerator.
 	/// Can only be run on the EVM dialect with objects.
 	/// Abort and do nothing, if no ``memoryguard`` call or several ``memoryguard`` calls
 	/// with non-matching arguments are found, or if any of the @a _stackTooDeepErrors
 	/// are contained in a recursive function.
+	/// If @a _chooseByAccessCosts is true, each error is resolved by moving the variables that are cheapest
+	/// to access from memory, taking variables already moved for other errors into account.
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _astRoot,
-		std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors
+		std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors,
+		bool _chooseByAccessCosts = false,
+		bool _reuseSlots = false
 	);
 	/// Determines stack too deep errors using the appropriate code generation backend.
 	/// Can only be run on the EVM dialect with objects.
@@ -79,7 +90,9 @@ public:
 	/// are contained in a recursive function.
 	static Block run(
 		OptimiserStepContext& _context,
-		Object const& _object
+		Object const& _object,
+		bool _chooseByAccessCosts = false,
+		bool _reuseSlots = false
 	);
 };
 
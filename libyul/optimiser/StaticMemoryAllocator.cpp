@@ -0,0 +1,421 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that moves constant-size memory allocations to fixed memory offsets.
+ */
+
+#include <libyul/optimiser/StaticMemoryAllocator.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FunctionCallFinder.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Numeric.h>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum size of a single allocation that is moved to a fixed offset.
+u256 const c_maxAllocationSize = 0x200;
+/// Maximum amount of memory that is reserved for all moved allocations together,
+/// since it is added to the memory used by any code that allocates memory.
+u256 const c_maxReservedMemory = 0x400;
+
+std::optional<u256> literalNumber(Expression const& _expression)
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		if (literal->kind == LiteralKind::Number && !literal->value.unlimited())
+			return literal->value.value();
+	return std::nullopt;
+}
+
+/// Memory area accessed by a built-in function, given by the index of its offset argument and
+/// either the index of its length argument or a fixed length.
+struct MemoryAccess
+{
+	size_t offsetArgument;
+	std::optional<size_t> lengthArgument;
+	u256 fixedLength = 0;
+};
+
+/// @returns the memory areas accessed by @a _instruction if it only reads from or writes to them.
+/// For all other instructions, pointers passed as arguments are considered to escape.
+std::vector<MemoryAccess> memoryAccesses(Instruction _instruction)
+{
+	switch (_instruction)
+	{
+	case Instruction::MLOAD:
+	case Instruction::MSTORE:
+		return {{0, std::nullopt, 32}};
+	case Instruction::MSTORE8:
+		return {{0, std::nullopt, 1}};
+	case Instruction::KECCAK256:
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		return {{0, 1}};
+	case Instruction::CALLDATACOPY:
+	case Instruction::CODECOPY:
+	case Instruction::RETURNDATACOPY:
+		return {{0, 2}};
+	case Instruction::MCOPY:
+		return {{0, 2}, {1, 2}};
+	default:
+		return {};
+	}
+}
+
+/// @returns true if @a _expression only references the variables @a _variables.
+bool onlyReferences(Expression const& _expression, std::set<YulName> const& _variables)
+{
+	if (Identifier const* identifier = std::get_if<Identifier>(&_expression))
+		return _variables.count(identifier->name);
+	if (FunctionCall const* call = std::get_if<FunctionCall>(&_expression))
+		for (Expression const& argument: call->arguments)
+			if (!onlyReferences(argument, _variables))
+				return false;
+	return true;
+}
+
+/// A memory allocation of a constant size.
+struct Allocation
+{
+	/// The function containing the allocation, empty for code outside of functions.
+	YulName function;
+	/// The declaration of the pointer to the allocated memory, whose value is replaced.
+	VariableDeclaration* pointerDeclaration = nullptr;
+	/// The update of the free memory pointer, which is removed.
+	Statement const* freeMemoryPointerUpdate = nullptr;
+	/// The number of allocated bytes.
+	u256 size;
+	/// False if the pointer might escape or the allocation cannot be moved for other reasons.
+	bool movable = true;
+};
+
+/**
+ * Finds allocations and the variables pointing into them. Variables declared as the sum
+ * of such a variable and a literal also point into the allocation.
+ */
+class AllocationFinder: public ASTModifier
+{
+public:
+	explicit AllocationFinder(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	using ASTModifier::operator();
+	void operator()(FunctionDefinition& _function) override
+	{
+		YulName outerFunction = std::exchange(m_currentFunction, _function.name);
+		ASTModifier::operator()(_function);
+		m_currentFunction = outerFunction;
+	}
+	void operator()(VariableDeclaration& _varDecl) override
+	{
+		if (_varDecl.variables.size() == 1 && _varDecl.value)
+			if (std::optional<std::pair<size_t, bigint>> pointer = pointerInto(*_varDecl.value))
+			{
+				pointers[_varDecl.variables.front().name] = *pointer;
+				ignoredExpressions.insert(_varDecl.value.get());
+				if (pointer->second > bigint(allocations[pointer->first].size))
+					allocations[pointer->first].movable = false;
+			}
+		ASTModifier::operator()(_varDecl);
+	}
+	void operator()(Block& _block) override
+	{
+		for (size_t index = 0; index < _block.statements.size(); ++index)
+			findAllocation(_block.statements, index);
+		ASTModifier::operator()(_block);
+	}
+
+	/// @returns the allocation @a _expression points into and the offset from its start, if it is
+	/// a variable pointing into an allocation or the sum of such a variable and a literal.
+	std::optional<std::pair<size_t, bigint>> pointerInto(Expression const& _expression) const
+	{
+		if (Identifier const* identifier = std::get_if<Identifier>(&_expression))
+		{
+			if (auto const* pointer = util::valueOrNullptr(pointers, identifier->name))
+				return *pointer;
+			return std::nullopt;
+		}
+		FunctionCall const* call = std::get_if<FunctionCall>(&_expression);
+		if (!call || toEVMInstruction(m_dialect, call->functionName.name) != Instruction::ADD)
+			return std::nullopt;
+		for (size_t index: {0u, 1u})
+			if (Identifier const* identifier = std::get_if<Identifier>(&call->arguments.at(index)))
+				if (auto const* pointer = util::valueOrNullptr(pointers, identifier->name))
+					if (std::optional<u256> value = literalNumber(call->arguments.at(1 - index)))
+						return std::make_pair(pointer->first, pointer->second + bigint(*value));
+		return std::nullopt;
+	}
+
+	std::vector<Allocation> allocations;
+	/// Maps variables to the allocation they point into and their offset from its start.
+	std::map<YulName, std::pair<size_t, bigint>> pointers;
+	/// Expressions of the allocations and of the declarations of pointers, which are not
+	/// considered when looking for escaping pointers.
+	std::set<Expression const*> ignoredExpressions;
+
+private:
+	/// Records the allocation starting at @a _statements[_index], if there is one.
+	void findAllocation(std::vector<Statement>& _statements, size_t _index)
+	{
+		VariableDeclaration* pointerDeclaration = std::get_if<VariableDeclaration>(&_statements[_index]);
+		if (
+			!pointerDeclaration ||
+			pointerDeclaration->variables.size() != 1 ||
+			!pointerDeclaration->value ||
+			!isFreeMemoryPointerAccess(*pointerDeclaration->value, Instruction::MLOAD)
+		)
+			return;
+		YulName pointer = pointerDeclaration->variables.front().name;
+
+		// @returns the size if @a _expression is the sum of the pointer and a literal.
+		auto allocationSize = [&](Expression const& _expression) -> std::optional<u256> {
+			FunctionCall const* call = std::get_if<FunctionCall>(&_expression);
+			if (!call || toEVMInstruction(m_dialect, call->functionName.name) != Instruction::ADD)
+				return std::nullopt;
+			for (size_t index: {0u, 1u})
+				if (Identifier const* identifier = std::get_if<Identifier>(&call->arguments.at(index)))
+					if (identifier->name == pointer)
+						return literalNumber(call->arguments.at(1 - index));
+			return std::nullopt;
+		};
+
+		size_t next = _index + 1;
+		std::optional<YulName> end;
+		std::optional<u256> size;
+		if (next < _statements.size())
+			if (auto const* endDeclaration = std::get_if<VariableDeclaration>(&_statements[next]))
+				if (endDeclaration->variables.size() == 1 && endDeclaration->value)
+					if ((size = allocationSize(*endDeclaration->value)))
+					{
+						end = endDeclaration->variables.front().name;
+						++next;
+					}
+
+		If const* check = next < _statements.size() ? std::get_if<If>(&_statements[next]) : nullptr;
+		if (check)
+		{
+			std::set<YulName> variables{pointer};
+			if (end)
+				variables.insert(*end);
+			if (
+				onlyReferences(*check->condition, variables) &&
+				SideEffectsCollector{m_dialect, *check->condition}.movable()
+			)
+				++next;
+			else
+				check = nullptr;
+		}
+
+		if (next >= _statements.size())
+			return;
+		ExpressionStatement const* update = std::get_if<ExpressionStatement>(&_statements[next]);
+		if (!update || !isFreeMemoryPointerAccess(update->expression, Instruction::MSTORE))
+			return;
+		Expression const& newFreeMemoryPointer = std::get<FunctionCall>(update->expression).arguments.at(1);
+		if (end)
+		{
+			Identifier const* identifier = std::get_if<Identifier>(&newFreeMemoryPointer);
+			if (!identifier || identifier->name != *end)
+				return;
+		}
+		else
+			size = allocationSize(newFreeMemoryPointer);
+		if (!size || *size == 0 || *size > c_maxAllocationSize)
+			return;
+
+		ignoredExpressions.insert(&update->expression);
+		if (check)
+			ignoredExpressions.insert(check->condition.get());
+		allocations.emplace_back(Allocation{m_currentFunction, pointerDeclaration, &_statements[next], *size});
+		pointers[pointer] = {allocations.size() - 1, 0};
+	}
+
+	/// @returns true if @a _expression is a call to @a _instruction with the free memory pointer
+	/// as its first argument.
+	bool isFreeMemoryPointerAccess(Expression const& _expression, Instruction _instruction) const
+	{
+		FunctionCall const* call = std::get_if<FunctionCall>(&_expression);
+		return
+			call &&
+			toEVMInstruction(m_dialect, call->functionName.name) == _instruction &&
+			literalNumber(call->arguments.at(0)) == u256(0x40);
+	}
+
+	Dialect const& m_dialect;
+	YulName m_currentFunction;
+};
+
+/**
+ * Marks allocations as not movable, if any variable pointing into them is used in any other
+ * way than as the offset of a memory access that stays within the allocation.
+ */
+class EscapeChecker: public ASTWalker
+{
+public:
+	EscapeChecker(Dialect const& _dialect, AllocationFinder& _finder): m_dialect(_dialect), m_finder(_finder) {}
+
+	using ASTWalker::operator();
+	void visit(Expression const& _expression) override
+	{
+		if (!m_finder.ignoredExpressions.count(&_expression))
+			ASTWalker::visit(_expression);
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		if (auto const* pointer = util::valueOrNullptr(m_finder.pointers, _identifier.name))
+			m_finder.allocations[pointer->first].movable = false;
+	}
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		std::vector<MemoryAccess> accesses;
+		if (std::optional<Instruction> instruction = toEVMInstruction(m_dialect, _functionCall.functionName.name))
+			accesses = memoryAccesses(*instruction);
+
+		std::set<size_t> offsetArguments;
+		for (MemoryAccess const& access: accesses)
+			if (std::optional<std::pair<size_t, bigint>> pointer = m_finder.pointerInto(_functionCall.arguments.at(access.offsetArgument)))
+			{
+				Allocation& allocation = m_finder.allocations[pointer->first];
+				std::optional<u256> length =
+					access.lengthArgument ?
+					literalNumber(_functionCall.arguments.at(*access.lengthArgument)) :
+					access.fixedLength;
+				if (!length || pointer->second + bigint(*length) > bigint(allocation.size))
+					allocation.movable = false;
+				offsetArguments.insert(access.offsetArgument);
+			}
+
+		for (size_t index = 0; index < _functionCall.arguments.size(); ++index)
+			if (!offsetArguments.count(index))
+				visit(_functionCall.arguments[index]);
+	}
+
+private:
+	Dialect const& m_dialect;
+	AllocationFinder& m_finder;
+};
+
+}
+
+void StaticMemoryAllocator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	// Moving allocations changes the size of the memory.
+	if (MSizeFinder::containsMSize(_context.dialect, _ast))
+		return;
+
+	std::vector<FunctionCall*> memoryGuardCalls = findFunctionCalls(_ast, "memoryguard"_yulname);
+	if (memoryGuardCalls.empty())
+		return;
+	std::optional<u256> reservedMemory = literalNumber(memoryGuardCalls.front()->arguments.at(0));
+	if (!reservedMemory || *reservedMemory >= u256(1) << 32)
+		return;
+	for (FunctionCall const* memoryGuardCall: memoryGuardCalls)
+		if (literalNumber(memoryGuardCall->arguments.at(0)) != reservedMemory)
+			return;
+
+	AllocationFinder finder{_context.dialect};
+	finder(_ast);
+	EscapeChecker{_context.dialect, finder}(_ast);
+
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	std::set<YulName> recursiveFunctions = callGraph.recursiveFunctions();
+
+	// Memory required by the moved allocations of each function itself.
+	std::map<YulName, u256> ownMemory;
+	for (Allocation& allocation: finder.allocations)
+	{
+		// Allocations in recursive functions may be live in several invocations at the same time.
+		if (recursiveFunctions.count(allocation.function))
+			allocation.movable = false;
+		if (allocation.movable)
+			ownMemory[allocation.function] += (allocation.size + 31) / 32 * 32;
+	}
+	if (ownMemory.empty())
+		return;
+
+	// Like in the StackLimitEvader, the allocations of a function are placed after the memory required
+	// by all functions it calls, so the allocations on every path through the call graph are disjoint.
+	// Functions in cycles do not have allocations themselves, so this terminates.
+	std::map<YulName, u256> requiredMemory;
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto const& [function, callees]: callGraph.functionCalls)
+		{
+			u256 required = 0;
+			for (YulName callee: callees)
+				required = std::max(required, requiredMemory[callee]);
+			required += ownMemory[function];
+			if (required != requiredMemory[function])
+			{
+				requiredMemory[function] = required;
+				changed = true;
+			}
+		}
+	}
+
+	u256 totalMemory = 0;
+	for (auto const& [function, required]: requiredMemory)
+		totalMemory = std::max(totalMemory, required);
+	if (totalMemory > c_maxReservedMemory)
+		return;
+
+	std::map<YulName, u256> nextOffset;
+	for (auto const& [function, memory]: ownMemory)
+		nextOffset[function] = *reservedMemory + requiredMemory.at(function) - memory;
+	std::set<Statement const*> freeMemoryPointerUpdates;
+	for (Allocation const& allocation: finder.allocations)
+		if (allocation.movable)
+		{
+			u256& offset = nextOffset.at(allocation.function);
+			allocation.pointerDeclaration->value = std::make_unique<Expression>(Literal{
+				debugDataOf(*allocation.pointerDeclaration->value),
+				LiteralKind::Number,
+				LiteralValue{offset, toCompactHexWithPrefix(offset)}
+			});
+			offset += (allocation.size + 31) / 32 * 32;
+			freeMemoryPointerUpdates.insert(allocation.freeMemoryPointerUpdate);
+		}
+	StatementRemover{freeMemoryPointerUpdates}(_ast);
+
+	*reservedMemory += totalMemory;
+	for (FunctionCall* memoryGuardCall: findFunctionCalls(_ast, "memoryguard"_yulname))
+		memoryGuardCall->arguments.front() = Literal{
+			debugDataOf(memoryGuardCall->arguments.front()),
+			LiteralKind::Number,
+			LiteralValue{*reservedMemory, toCompactHexWithPrefix(*reservedMemory)}
+		};
+}
@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that moves constant-size memory allocations to fixed memory offsets.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that replaces memory allocations of a constant size whose pointer does not
+ * escape by fixed memory offsets reserved via ``memoryguard``, similar to how the StackLimitEvader
+ * moves variables to memory.
+ *
+ * An allocation is a sequence of statements of the form
+ *
+ *   let p := mload(64)
+ *   let end := add(p, 64)
+ *   if or(gt(end, 0xffffffffffffffff), lt(end, p)) { panic() }
+ *   mstore(64, end)
+ *
+ * with a literal size. The declaration of ``end`` is optional, in which case ``add(p, 64)`` is stored directly,
+ * and so is the check, which may only depend on ``p`` and ``end``. The pointer does not escape, if it and the variables
+ * declared as ``add`` of it and a literal are only used as the memory offset of built-in functions
+ * accessing memory, with a constant length that stays within the allocated size. In particular, they must not
+ * be stored, compared or passed to user-defined functions and they must never be assigned to.
+ *
+ * Such an allocation is replaced by a fixed memory offset and the update of the free memory pointer
+ * is removed, while the check is left for later steps to remove. Offsets are assigned along the call graph
+ * like in the StackLimitEvader, so allocations in functions that are in a cycle in the call graph are
+ * not moved. Nothing is done, if there is no ``memoryguard`` call, if the ``memoryguard`` calls have
+ * different arguments, if the code uses ``msize`` or if more memory than a small limit would be reserved.
+ *
+ * Prerequisite: Disambiguator, FunctionHoister.
+ */
+class StaticMemoryAllocator
+{
+public:
+	static constexpr char const* name{"StaticMemoryAllocator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+};
+
+}
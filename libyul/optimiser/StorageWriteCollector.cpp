@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Determines the storage slots code and user-defined functions may write to.
+ */
+
+#include <libyul/optimiser/StorageWriteCollector.h>
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/SideEffects.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of slots that are tracked individually before assuming that any slot may be written to.
+size_t constexpr c_maxSlots = 16;
+
+std::optional<u256> literalValue(Expression const& _expression)
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		if (!literal->value.unlimited())
+			return literal->value.value();
+	return std::nullopt;
+}
+
+}
+
+StorageWrites& StorageWrites::operator+=(StorageWrites const& _other)
+{
+	if (anySlot())
+		return *this;
+	if (_other.anySlot())
+		return *this = any();
+	slots->insert(_other.slots->begin(), _other.slots->end());
+	if (slots->size() > c_maxSlots)
+		*this = any();
+	return *this;
+}
+
+StorageWrites StorageWriteCollector::storageWrites(
+	Dialect const& _dialect,
+	Block const& _block,
+	std::map<YulName, StorageWrites> const& _functionStorageWrites
+)
+{
+	StorageWriteCollector collector{_dialect, _functionStorageWrites, literalValue};
+	collector(_block);
+	return collector.writes();
+}
+
+StorageWrites StorageWriteCollector::storageWrites(
+	Dialect const& _dialect,
+	Expression const& _expression,
+	std::map<YulName, StorageWrites> const& _functionStorageWrites
+)
+{
+	StorageWriteCollector collector{_dialect, _functionStorageWrites, literalValue};
+	collector.visit(_expression);
+	return collector.writes();
+}
+
+std::map<YulName, StorageWrites> StorageWriteCollector::functionStorageWrites(Dialect const& _dialect, Block const& _ast)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	std::map<YulName, AssignedValue> values;
+	for (auto const& [name, expression]: ssaValues.values())
+		values[name] = AssignedValue{expression, {}};
+	KnowledgeBase knowledgeBase{values};
+	auto slotValue = [&](Expression const& _slot) { return knowledgeBase.valueIfKnownConstant(_slot); };
+
+	std::map<YulName, FunctionDefinition const*> functions = allFunctionDefinitions(_ast);
+	std::map<YulName, StorageWrites> writes;
+	for (auto const& [name, function]: functions)
+		writes[name] = StorageWrites{};
+
+	// The summaries only grow and are bounded by c_maxSlots, so this terminates.
+	// Starting from empty summaries is fine for recursive functions, since a slot can only
+	// be written if it is written somewhere inside the cycle.
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto const& [name, function]: functions)
+		{
+			StorageWriteCollector collector{_dialect, writes, slotValue};
+			collector(function->body);
+			if (collector.writes() != writes[name])
+			{
+				writes[name] = collector.writes();
+				changed = true;
+			}
+		}
+	}
+	return writes;
+}
+
+void StorageWriteCollector::operator()(FunctionCall const& _functionCall)
+{
+	ASTWalker::operator()(_functionCall);
+	if (m_writes.anySlot())
+		return;
+
+	YulName functionName = _functionCall.functionName.name;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(functionName))
+	{
+		if (builtin->sideEffects.storage != SideEffects::Write)
+			return;
+		if (toEVMInstruction(m_dialect, functionName) == evmasm::Instruction::SSTORE)
+			if (std::optional<u256> slot = m_slotValue(_functionCall.arguments.at(0)))
+			{
+				m_writes += StorageWrites{std::set<u256>{*slot}};
+				return;
+			}
+		m_writes = StorageWrites::any();
+	}
+	else if (StorageWrites const* functionWrites = util::valueOrNullptr(m_functionStorageWrites, functionName))
+		m_writes += *functionWrites;
+	else
+		m_writes = StorageWrites::any();
+}
@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Determines the storage slots code and user-defined functions may write to.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/YulName.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/**
+ * Storage slots a piece of code may write to.
+ */
+struct StorageWrites
+{
+	/// The constant slots that may be written to or nullopt if any slot may be written to.
+	std::optional<std::set<u256>> slots = std::set<u256>{};
+
+	static StorageWrites any() { return StorageWrites{std::nullopt}; }
+	bool anySlot() const { return !slots.has_value(); }
+	bool none() const { return slots && slots->empty(); }
+
+	/// Adds the slots of @a _other. Falls back to any slot if too many slots are collected.
+	StorageWrites& operator+=(StorageWrites const& _other);
+	bool operator==(StorageWrites const& _other) const { return slots == _other.slots; }
+	bool operator!=(StorageWrites const& _other) const { return slots != _other.slots; }
+};
+
+/**
+ * Collects the storage slots code may write to, including the slots written by
+ * user-defined functions it calls.
+ *
+ * Only ``sstore`` calls whose slot evaluates to a constant are tracked individually.
+ * Any other built-in function that may write to storage (e.g. external calls) or call to a
+ * user-defined function with an unknown summary may write to any slot.
+ * Does not enter into function definitions.
+ */
+class StorageWriteCollector: public ASTWalker
+{
+public:
+	/// Callback to retrieve the constant value of the slot argument of an ``sstore``, if known.
+	using SlotValue = std::function<std::optional<u256>(Expression const&)>;
+
+	StorageWriteCollector(
+		Dialect const& _dialect,
+		std::map<YulName, StorageWrites> const& _functionStorageWrites,
+		SlotValue _slotValue
+	):
+		m_dialect(_dialect),
+		m_functionStorageWrites(_functionStorageWrites),
+		m_slotValue(std::move(_slotValue))
+	{}
+
+	/// @returns the storage slots the given code may write to. Slots are only known if they are
+	/// literals, since values of variables might change during the execution of the code.
+	static StorageWrites storageWrites(
+		Dialect const& _dialect,
+		Block const& _block,
+		std::map<YulName, StorageWrites> const& _functionStorageWrites
+	);
+	static StorageWrites storageWrites(
+		Dialect const& _dialect,
+		Expression const& _expression,
+		std::map<YulName, StorageWrites> const& _functionStorageWrites
+	);
+
+	/// @returns the storage slots each user-defined function in @a _ast may write to, including
+	/// the slots written by the functions it calls. Slots of ``sstore`` calls are determined
+	/// from the values of SSA variables.
+	/// Requires the Disambiguator to be run upfront.
+	static std::map<YulName, StorageWrites> functionStorageWrites(Dialect const& _dialect, Block const& _ast);
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override;
+	void operator()(FunctionDefinition const&) override {}
+
+	StorageWrites const& writes() const { return m_writes; }
+
+private:
+	Dialect const& m_dialect;
+	std::map<YulName, StorageWrites> const& m_functionStorageWrites;
+	SlotValue m_slotValue;
+	StorageWrites m_writes;
+};
+
+}
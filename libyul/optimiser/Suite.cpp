@@ -30,6 +30,7 @@
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/FunctionGeneralizer.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/EqualStoreEliminator.h>
@@ -43,6 +44,7 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/RangeCheckEliminator.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
@@ -53,6 +55,8 @@
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/PureFunctionEvaluator.h>
+#include <libyul/optimiser/StaticMemoryAllocator.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/UnusedAssignEliminator.h>
@@ -60,6 +64,8 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
@@ -71,7 +77,10 @@
 
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libsolutil/Cancellation.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -80,55 +89,20 @@
 #include <range/v3/algorithm/count.hpp>
 #include <range/v3/algorithm/none_of.hpp>
 
-#include <limits>
-#include <tuple>
+#include <fmt/format.h>
 
-#ifdef PROFILE_OPTIMIZER_STEPS
 #include <chrono>
-#include <fmt/format.h>
-#endif
+#include <limits>
+#include <memory>
+#include <tuple>
 
 using namespace solidity;
 using namespace solidity::yul;
-#ifdef PROFILE_OPTIMIZER_STEPS
-using namespace std::chrono;
-#endif
 using namespace std::string_literals;
 
 namespace
 {
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-void outputPerformanceMetrics(std::map<std::string, int64_t> const& _metrics)
-{
-	std::vector<std::pair<std::string, int64_t>> durations(_metrics.begin(), _metrics.end());
-	sort(
-		durations.begin(),
-		durations.end(),
-		[](std::pair<std::string, int64_t> const& _lhs, std::pair<std::string, int64_t> const& _rhs) -> bool
-		{
-			return _lhs.second < _rhs.second;
-		}
-	);
-
-	int64_t totalDurationInMicroseconds = 0;
-	for (auto&& [step, durationInMicroseconds]: durations)
-		totalDurationInMicroseconds += durationInMicroseconds;
-
-	std::cerr << "Performance metrics of optimizer steps" << std::endl;
-	std::cerr << "======================================" << std::endl;
-	constexpr double microsecondsInSecond = 1000000;
-	for (auto&& [step, durationInMicroseconds]: durations)
-	{
-		double percentage = 100.0 * static_cast<double>(durationInMicroseconds) / static_cast<double>(totalDurationInMicroseconds);
-		double sec = static_cast<double>(durationInMicroseconds) / microsecondsInSecond;
-		std::cerr << fmt::format("{:>7.3f}% ({} s): {}", percentage, sec, step) << std::endl;
-	}
-	double totalDurationInSeconds = static_cast<double>(totalDurationInMicroseconds) / microsecondsInSecond;
-	std::cerr << "--------------------------------------" << std::endl;
-	std::cerr << fmt::format("{:>7}% ({:.3f} s)", 100, totalDurationInSeconds) << std::endl;
-}
-#endif
 
 }
 
@@ -141,7 +115,8 @@ void OptimiserSuite::run(
 	std::string_view _optimisationSequence,
 	std::string_view _optimisationCleanupSequence,
 	std::optional<size_t> _expectedExecutionsPerDeployment,
-	std::set<YulName> const& _externallyUsedIdentifiers
+	std::set<YulName> const& _externallyUsedIdentifiers,
+	size_t _numThreads
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -153,20 +128,31 @@ void OptimiserSuite::run(
 	std::set<YulName> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
-	auto astRoot = std::get<Block>(Disambiguator(
-		_dialect,
-		*_object.analysisInfo,
-		reservedIdentifiers
-	)(_object.code()->root()));
+	// The code of the object is shared, so it has to be copied anyway. The disambiguator
+	// already knows all names of the copy, so they do not have to be collected again.
+	Disambiguator disambiguator(_dialect, *_object.analysisInfo, reservedIdentifiers);
+	auto astRoot = std::get<Block>(disambiguator(_object.code()->root()));
 
-	NameDispenser dispenser{_dialect, astRoot, reservedIdentifiers};
+	NameDispenser dispenser = disambiguator.nameDispenser();
 	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	std::unique_ptr<util::ThreadPool> threadPool;
+	if (_numThreads > 1)
+	{
+		threadPool = std::make_unique<util::ThreadPool>(_numThreads);
+		context.threadPool = threadPool.get();
+	}
 
+#ifdef PROFILE_OPTIMIZER_STEPS
+	OptimiserSuite suite(context, Debug::Statistics);
+#else
 	OptimiserSuite suite(context, Debug::None);
+#endif
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
-	suite.runSequence("hgfo", astRoot);
+	// Unreachable functions (e.g. unused helpers generated by the code generator) are removed
+	// right away, so that no other step has to process them.
+	suite.runSequence("hgfol", astRoot);
 
 	NameSimplifier::run(suite.m_context, astRoot);
 	// Now the user-supplied part
@@ -203,16 +189,24 @@ void OptimiserSuite::run(
 		if (usesOptimizedCodeGenerator)
 		{
 			_object.setCode(std::make_shared<AST>(std::move(astRoot)));
-			astRoot = std::get<1>(StackCompressor::run(
+			bool compilable = false;
+			std::tie(compilable, astRoot) = StackCompressor::run(
 				_dialect,
 				_object,
 				_optimizeStackAllocation,
 				stackCompressorMaxIterations
-			));
+			);
 			if (evmDialect->providesObjectAccess())
 			{
-				_object.setCode(std::make_shared<AST>(std::move(astRoot)));
-				astRoot = StackLimitEvader::run(suite.m_context, _object);
+				// The stack compressor did not find any stack too deep errors in the unchanged code,
+				// so there is no need to analyse it and to generate its stack layout again.
+				if (compilable)
+					StackLimitEvader::run(suite.m_context, astRoot, std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>>{});
+				else
+				{
+					_object.setCode(std::make_shared<AST>(std::move(astRoot)));
+					astRoot = StackLimitEvader::run(suite.m_context, _object);
+				}
 			}
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
@@ -227,7 +221,7 @@ void OptimiserSuite::run(
 	VarNameCleaner::run(suite.m_context, astRoot);
 
 #ifdef PROFILE_OPTIMIZER_STEPS
-	outputPerformanceMetrics(suite.m_durationPerStepInMicroseconds);
+	suite.printStatistics(std::cerr);
 #endif
 
 	_object.setCode(std::make_shared<AST>(std::move(astRoot)));
@@ -251,46 +245,77 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 	return ret;
 }
 
+/// Steps that never put anything but identifiers into places the ExpressionSplitter has
+/// to split, i.e. that keep code in the form produced by the ExpressionSplitter.
+std::set<std::string> const& stepsPreservingSplitForm()
+{
+	static std::set<std::string> const steps{
+		BlockFlattener::name,
+		CircularReferencesPruner::name,
+		CommonSubexpressionEliminator::name,
+		ConditionalSimplifier::name,
+		ConditionalUnsimplifier::name,
+		DeadCodeEliminator::name,
+		EqualStoreEliminator::name,
+		EquivalentFunctionCombiner::name,
+		ForLoopInitRewriter::name,
+		FunctionGrouper::name,
+		FunctionHoister::name,
+		LoopInvariantCodeMotion::name,
+		SSAReverser::name,
+		SSATransform::name,
+		UnusedAssignEliminator::name,
+		UnusedFunctionParameterPruner::name,
+		UnusedPruner::name,
+		UnusedStoreEliminator::name,
+		VarDeclInitializer::name,
+	};
+	return steps;
+}
+
 }
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGeneralizer,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		LoopUnroller,
+		PureFunctionEvaluator,
+		RangeCheckEliminator,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StaticMemoryAllocator,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -316,17 +341,22 @@ std::map<std::string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{ForLoopConditionOutOfBody::name,     'O'},
 		{ForLoopInitRewriter::name,           'o'},
 		{FullInliner::name,                   'i'},
+		{FunctionGeneralizer::name,           'G'},
 		{FunctionGrouper::name,               'g'},
 		{FunctionHoister::name,               'h'},
 		{FunctionSpecializer::name,           'F'},
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnroller::name,                  'N'},
+		{PureFunctionEvaluator::name,         'P'},
+		{RangeCheckEliminator::name,          'R'},
 		{UnusedAssignEliminator::name,        'r'},
 		{UnusedStoreEliminator::name,         'S'},
 		{Rematerialiser::name,                'm'},
 		{SSAReverser::name,                   'V'},
 		{SSATransform::name,                  'a'},
+		{StaticMemoryAllocator::name,         'A'},
 		{StructuralSimplifier::name,          't'},
 		{UnusedFunctionParameterPruner::name, 'p'},
 		{UnusedPruner::name,                  'u'},
@@ -403,6 +433,19 @@ bool OptimiserSuite::isEmptyOptimizerSequence(std::string const& _sequence)
 }
 
 void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
+{
+	m_pruneAfterFullInliner =
+		_stepAbbreviations.find(stepNameToAbbreviationMap().at(CircularReferencesPruner::name)) != std::string_view::npos;
+	bool splitForm = false;
+	runSequence(_stepAbbreviations, _ast, _repeatUntilStable, splitForm);
+}
+
+void OptimiserSuite::runSequence(
+	std::string_view _stepAbbreviations,
+	Block& _ast,
+	bool _repeatUntilStable,
+	bool& _splitForm
+)
 {
 	validateSequence(_stepAbbreviations);
 
@@ -475,43 +518,196 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 	// NOTE: If _repeatUntilStable is false, the value will not be used so do not calculate it.
 	size_t codeSize = (_repeatUntilStable ? CodeSize::codeSizeIncludingFunctions(_ast) : 0);
 
+	// When repeating, every step and every nested repeated subsequence remembers the hash of the code
+	// it last ran on if that run did not change anything. Steps are deterministic, so if the code is
+	// still the same in the next round, running them again would not change it either and they
+	// are skipped. This saves most of the final round, which usually only confirms that the code
+	// is stable, without affecting the result.
+	std::vector<std::optional<uint64_t>> hashesOfUnchangedInput;
+	uint64_t hash = (_repeatUntilStable ? ASTHasher::run(_ast) : 0);
+	auto runUnlessUnchanged = [&](size_t _unit, std::string const* _step, auto const& _run)
+	{
+		if (hashesOfUnchangedInput.size() <= _unit)
+			hashesOfUnchangedInput.resize(_unit + 1);
+		if (hashesOfUnchangedInput[_unit] == hash)
+		{
+			if (_step && m_debug == Debug::PrintStep)
+				std::cout << "Skipping " << *_step << " (code unchanged since its last run)" << std::endl;
+			if (_step && m_debug == Debug::Statistics)
+				++m_statistics.steps[*_step].skippedRuns;
+			return;
+		}
+
+		_run();
+
+		uint64_t newHash = ASTHasher::run(_ast);
+		if (newHash == hash)
+			hashesOfUnchangedInput[_unit] = hash;
+		else
+			hashesOfUnchangedInput[_unit] = std::nullopt;
+		hash = newHash;
+	};
+
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
+		size_t unit = 0;
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
-			if (repeat)
-				runSequence(subsequence, _ast, true);
+			if (!_repeatUntilStable)
+			{
+				if (repeat)
+					runSequence(subsequence, _ast, true, _splitForm);
+				else
+					runSequence(abbreviationsToSteps(subsequence), _ast, _splitForm);
+			}
+			else if (repeat)
+				runUnlessUnchanged(unit++, nullptr, [&]() { runSequence(subsequence, _ast, true, _splitForm); });
 			else
-				runSequence(abbreviationsToSteps(subsequence), _ast);
+				for (std::string const& step: abbreviationsToSteps(subsequence))
+					runUnlessUnchanged(unit++, &step, [&]() { runSequence(std::vector<std::string>{step}, _ast, _splitForm); });
 		}
 
 		if (!_repeatUntilStable)
 			break;
 
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
+		if (m_debug == Debug::Statistics)
+		{
+			++m_statistics.repeatedRounds;
+			if (newSize == codeSize)
+				++m_statistics.repeatedRoundsWithoutSizeChange;
+		}
 		if (newSize == codeSize)
 			break;
 		codeSize = newSize;
 	}
 }
 
+void OptimiserSuite::printStatistics(std::ostream& _stream) const
+{
+	std::vector<std::pair<std::string, StepStatistics>> steps(m_statistics.steps.begin(), m_statistics.steps.end());
+	sort(
+		steps.begin(),
+		steps.end(),
+		[](auto const& _lhs, auto const& _rhs) -> bool
+		{
+			return _lhs.second.durationInMicroseconds < _rhs.second.durationInMicroseconds;
+		}
+	);
+
+	int64_t totalDurationInMicroseconds = 0;
+	size_t totalRuns = 0;
+	size_t totalRunsWithChanges = 0;
+	for (auto&& [step, statistics]: steps)
+	{
+		totalDurationInMicroseconds += statistics.durationInMicroseconds;
+		totalRuns += statistics.runs;
+		totalRunsWithChanges += statistics.runsWithChanges;
+	}
+
+	constexpr double microsecondsInSecond = 1000000;
+	auto percentage = [&](int64_t _durationInMicroseconds) {
+		if (totalDurationInMicroseconds == 0)
+			return 0.0;
+		return 100.0 * static_cast<double>(_durationInMicroseconds) / static_cast<double>(totalDurationInMicroseconds);
+	};
+
+	_stream << "Statistics of optimizer steps" << std::endl;
+	_stream << "=============================" << std::endl;
+	_stream << fmt::format(
+		"{:>8} {:>10} {:>6} {:>8} {:>8} {:>12} {:>12}  {}",
+		"time %", "time (s)", "runs", "changed", "skipped", "size before", "size after", "step"
+	) << std::endl;
+	for (auto&& [step, statistics]: steps)
+	{
+		auto abbreviation = stepNameToAbbreviationMap().find(step);
+		_stream << fmt::format(
+			"{:>7.3f}% {:>10.6f} {:>6} {:>8} {:>8} {:>12} {:>12}  {} ({})",
+			percentage(statistics.durationInMicroseconds),
+			static_cast<double>(statistics.durationInMicroseconds) / microsecondsInSecond,
+			statistics.runs,
+			statistics.runsWithChanges,
+			statistics.skippedRuns,
+			statistics.codeSizeBefore,
+			statistics.codeSizeAfter,
+			step,
+			abbreviation != stepNameToAbbreviationMap().end() ? std::string(1, abbreviation->second) : "-"s
+		) << std::endl;
+	}
+	_stream << "-----------------------------" << std::endl;
+	_stream << fmt::format(
+		"{:>7}% {:>10.6f} {:>6} {:>8}",
+		100,
+		static_cast<double>(totalDurationInMicroseconds) / microsecondsInSecond,
+		totalRuns,
+		totalRunsWithChanges
+	) << std::endl;
+	_stream << fmt::format(
+		"Repeated rounds: {}, of which {} did not change the code size.",
+		m_statistics.repeatedRounds,
+		m_statistics.repeatedRoundsWithoutSizeChange
+	) << std::endl;
+}
+
 void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
+{
+	m_pruneAfterFullInliner = util::contains(_steps, std::string(CircularReferencesPruner::name));
+	bool splitForm = false;
+	runSequence(_steps, _ast, splitForm);
+}
+
+void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast, bool& _splitForm)
 {
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = std::make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
 	for (std::string const& step: _steps)
 	{
+		// Sequences often split the code again after steps that keep it split. Since every
+		// expression would only be visited to find nothing to split, such runs are skipped.
+		if (step == ExpressionSplitter::name && _splitForm)
+		{
+			if (m_debug == Debug::PrintStep)
+				std::cout << "Skipping " << step << " (code is still split)" << std::endl;
+			if (m_debug == Debug::Statistics)
+				++m_statistics.steps[step].skippedRuns;
+			continue;
+		}
+
 		if (m_debug == Debug::PrintStep)
 			std::cout << "Running " << step << std::endl;
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point startTime = steady_clock::now();
-#endif
-		allSteps().at(step)->run(m_context, _ast);
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point endTime = steady_clock::now();
-		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
-#endif
+
+		std::unique_ptr<Block> astBeforeStep;
+		size_t codeSizeBeforeStep = 0;
+		if (m_debug == Debug::Statistics)
+		{
+			astBeforeStep = std::make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+			codeSizeBeforeStep = CodeSize::codeSizeIncludingFunctions(_ast);
+		}
+
+		util::CancellationToken::check();
+		auto startTime = std::chrono::steady_clock::now();
+		{
+			util::Profiler::Scope profilerScope(step, "yul");
+			allSteps().at(step)->run(m_context, _ast);
+			// Functions inlined at all call sites are unreachable now. Remove them before
+			// the following steps spend time on them.
+			if (step == FullInliner::name && m_pruneAfterFullInliner)
+				CircularReferencesPruner::run(m_context, _ast);
+		}
+		auto endTime = std::chrono::steady_clock::now();
+		_splitForm = step == ExpressionSplitter::name || (_splitForm && stepsPreservingSplitForm().count(step));
+
+		if (m_debug == Debug::Statistics)
+		{
+			StepStatistics& statistics = m_statistics.steps[step];
+			++statistics.runs;
+			if (!SyntacticallyEqual{}.statementEqual(_ast, *astBeforeStep))
+				++statistics.runsWithChanges;
+			statistics.durationInMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+			statistics.codeSizeBefore += codeSizeBeforeStep;
+			statistics.codeSizeAfter += CodeSize::codeSizeIncludingFunctions(_ast);
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
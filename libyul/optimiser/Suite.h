@@ -27,6 +27,9 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <cstdint>
+#include <map>
+#include <ostream>
 #include <set>
 #include <string>
 #include <string_view>
@@ -57,11 +60,43 @@ public:
 	{
 		None,
 		PrintStep,
-		PrintChanges
+		PrintChanges,
+		/// Collect statistics about every step that is run, see @a statistics().
+		Statistics
 	};
+
+	/// Statistics collected in Debug::Statistics mode, aggregated over all runs of a step,
+	/// including the repeated rounds of bracketed subsequences.
+	struct StepStatistics
+	{
+		size_t runs = 0;
+		/// Number of runs that resulted in an AST that is not syntactically equal to the input.
+		size_t runsWithChanges = 0;
+		/// Number of times the step was skipped in a repeated subsequence because the code did
+		/// not change since its last run, which did not change anything either, or, for the
+		/// ExpressionSplitter, because the code was still split.
+		size_t skippedRuns = 0;
+		int64_t durationInMicroseconds = 0;
+		/// Sums of CodeSize::codeSizeIncludingFunctions() before and after every run.
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+	struct Statistics
+	{
+		/// Step name -> statistics.
+		std::map<std::string, StepStatistics> steps;
+		/// Number of rounds of bracketed subsequences...
+		size_t repeatedRounds = 0;
+		/// ...and how many of them ended without changing the code size, i.e. only confirmed
+		/// that the code is stable.
+		size_t repeatedRoundsWithoutSizeChange = 0;
+	};
+
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _numThreads is greater than one, steps that support it process independent
+	/// functions on that many threads. The result does not depend on the number of threads.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +105,8 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulName> const& _externallyUsedIdentifiers = {}
+		std::set<YulName> const& _externallyUsedIdentifiers = {},
+		size_t _numThreads = 1
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -84,16 +120,28 @@ public:
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
 	void runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
 
+	/// @returns the statistics collected so far. Only populated in Debug::Statistics mode.
+	Statistics const& statistics() const { return m_statistics; }
+	/// Prints the collected statistics as a table, ordered by the time spent in each step.
+	void printStatistics(std::ostream& _stream) const;
+
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// @a _splitForm tracks whether the AST is known to be in the form produced by the
+	/// ExpressionSplitter, i.e. whether running it again would not change anything.
+	void runSequence(std::vector<std::string> const& _steps, Block& _ast, bool& _splitForm);
+	void runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable, bool& _splitForm);
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
-#ifdef PROFILE_OPTIMIZER_STEPS
-	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
-#endif
+	Statistics m_statistics;
+	/// Whether the CircularReferencesPruner also runs after every FullInliner run. Only done for
+	/// sequences that contain the CircularReferencesPruner, so that other sequences run exactly
+	/// the steps they list.
+	bool m_pruneAfterFullInliner = false;
 };
 
 }
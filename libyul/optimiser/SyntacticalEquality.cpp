@@ -47,11 +47,20 @@ bool SyntacticallyEqual::operator()(Statement const& _lhs, Statement const& _rhs
 
 bool SyntacticallyEqual::expressionEqual(FunctionCall const& _lhs, FunctionCall const& _rhs)
 {
-	return
-		expressionEqual(_lhs.functionName, _rhs.functionName) &&
-		util::containerEqual(_lhs.arguments, _rhs.arguments, [this](Expression const& _lhsExpr, Expression const& _rhsExpr) -> bool {
-			return (*this)(_lhsExpr, _rhsExpr);
-		});
+	if (m_functionNames)
+	{
+		auto functionName = [&](YulName _name) {
+			YulName const* replacement = util::valueOrNullptr(*m_functionNames, _name);
+			return replacement ? *replacement : _name;
+		};
+		if (functionName(_lhs.functionName.name) != functionName(_rhs.functionName.name))
+			return false;
+	}
+	else if (!expressionEqual(_lhs.functionName, _rhs.functionName))
+		return false;
+	return util::containerEqual(_lhs.arguments, _rhs.arguments, [this](Expression const& _lhsExpr, Expression const& _rhsExpr) -> bool {
+		return (*this)(_lhsExpr, _rhsExpr);
+	});
 }
 
 bool SyntacticallyEqual::expressionEqual(Identifier const& _lhs, Identifier const& _rhs)
@@ -38,11 +38,17 @@ namespace solidity::yul
  * Note that this does not apply to unlimited literal strings, which are never considered equal to normal literals,
  * even when the values would look like identical strings in the source.
  *
+ * If a map of function names is provided, names of called functions are replaced according to it
+ * before they are compared.
+ *
  * Prerequisite: Disambiguator (unless only expressions are compared)
  */
 class SyntacticallyEqual
 {
 public:
+	SyntacticallyEqual() = default;
+	explicit SyntacticallyEqual(std::map<YulName, YulName> const& _functionNames): m_functionNames(&_functionNames) {}
+
 	bool operator()(Expression const& _lhs, Expression const& _rhs);
 	bool operator()(Statement const& _lhs, Statement const& _rhs);
 
@@ -83,6 +89,7 @@ private:
 		return (_lhs == _rhs) || (_lhs && _rhs && (this->*CompareMember)(*_lhs, *_rhs));
 	}
 
+	std::map<YulName, YulName> const* m_functionNames = nullptr;
 	std::size_t m_idsUsed = 0;
 	std::map<YulName, std::size_t> m_identifiersLHS;
 	std::map<YulName, std::size_t> m_identifiersRHS;
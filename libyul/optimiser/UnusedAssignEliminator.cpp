@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/UnusedAssignEliminator.h>
 
+#include <libyul/optimiser/FunctionParallelism.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/ControlFlowSideEffectsCollector.h>
@@ -39,10 +40,27 @@ using namespace solidity::yul;
 
 void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedAssignEliminator uae{
-		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
-	};
+	std::map<YulName, ControlFlowSideEffects> controlFlowSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+
+	// Stores are only ever used within the function they occur in, so each chunk of
+	// functions can be analysed and cleaned up on its own.
+	bool const ranInParallel = runOnTopLevelStatementsInParallel(_context, _ast, [&](size_t _begin, size_t _end) {
+		UnusedAssignEliminator uae{_context.dialect, controlFlowSideEffects};
+		for (size_t i = _begin; i < _end; ++i)
+			uae.visit(_ast.statements[i]);
+
+		uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
+
+		std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
+		StatementRemover remover{toRemove};
+		for (size_t i = _begin; i < _end; ++i)
+			remover.visit(_ast.statements[i]);
+	});
+	if (ranInParallel)
+		return;
+
+	UnusedAssignEliminator uae{_context.dialect, controlFlowSideEffects};
 	uae(_ast);
 
 	uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
@@ -21,6 +21,8 @@
 
 #include <libyul/optimiser/UnusedStoreBase.h>
 
+#include <libyul/optimiser/IndexedStoreSet.h>
+
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/AST.h>
@@ -32,7 +34,8 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void UnusedStoreBase::operator()(If const& _if)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::operator()(If const& _if)
 {
 	visit(*_if.condition);
 
@@ -42,7 +45,8 @@ void UnusedStoreBase::operator()(If const& _if)
 	merge(m_activeStores, std::move(skipBranch));
 }
 
-void UnusedStoreBase::operator()(Switch const& _switch)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::operator()(Switch const& _switch)
 {
 	visit(*_switch.expression);
 
@@ -68,7 +72,8 @@ void UnusedStoreBase::operator()(Switch const& _switch)
 		merge(m_activeStores, std::move(branch));
 }
 
-void UnusedStoreBase::operator()(FunctionDefinition const& _functionDefinition)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::operator()(FunctionDefinition const& _functionDefinition)
 {
 	ScopedSaveAndRestore allStores(m_allStores, {});
 	ScopedSaveAndRestore usedStores(m_usedStores, {});
@@ -82,7 +87,8 @@ void UnusedStoreBase::operator()(FunctionDefinition const& _functionDefinition)
 	m_storesToRemove += m_allStores - m_usedStores;
 }
 
-void UnusedStoreBase::operator()(ForLoop const& _forLoop)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::operator()(ForLoop const& _forLoop)
 {
 	ScopedSaveAndRestore outerForLoopInfo(m_forLoopInfo, {});
 	ScopedSaveAndRestore forLoopNestingDepth(m_forLoopNestingDepth, m_forLoopNestingDepth + 1);
@@ -130,32 +136,39 @@ void UnusedStoreBase::operator()(ForLoop const& _forLoop)
 	m_forLoopInfo.pendingBreakStmts.clear();
 }
 
-void UnusedStoreBase::operator()(Break const&)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::operator()(Break const&)
 {
 	m_forLoopInfo.pendingBreakStmts.emplace_back(std::move(m_activeStores));
 	m_activeStores.clear();
 }
 
-void UnusedStoreBase::operator()(Continue const&)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::operator()(Continue const&)
 {
 	m_forLoopInfo.pendingContinueStmts.emplace_back(std::move(m_activeStores));
 	m_activeStores.clear();
 }
 
-void UnusedStoreBase::merge(ActiveStores& _target, ActiveStores&& _other)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::merge(ActiveStores& _target, ActiveStores&& _other)
 {
 	util::joinMap(_target, std::move(_other), [](
-		std::set<Statement const*>& _storesHere,
-		std::set<Statement const*>&& _storesThere
+		StoreSet& _storesHere,
+		StoreSet&& _storesThere
 	)
 	{
-		_storesHere += _storesThere;
+		_storesHere.merge(std::move(_storesThere));
 	});
 }
 
-void UnusedStoreBase::merge(ActiveStores& _target, std::vector<ActiveStores>&& _source)
+template <typename StoreSet>
+void UnusedStoreBase<StoreSet>::merge(ActiveStores& _target, std::vector<ActiveStores>&& _source)
 {
 	for (ActiveStores& ts: _source)
 		merge(_target, std::move(ts));
 	_source.clear();
 }
+
+template class solidity::yul::UnusedStoreBase<std::set<Statement const*>>;
+template class solidity::yul::UnusedStoreBase<IndexedStoreSet>;
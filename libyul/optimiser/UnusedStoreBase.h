@@ -26,6 +26,8 @@
 
 #include <range/v3/action/remove_if.hpp>
 
+#include <map>
+#include <set>
 #include <variant>
 
 
@@ -44,8 +46,12 @@ struct Dialect;
  * or not. Those are split and joined at control-flow forks. Once a store has been deemed
  * used, it is removed from the active set and marked as used and this will never change.
  *
+ * The active stores are kept in sets of type @a StoreSet, which has to provide a `merge` function
+ * that adds all elements of another set, like std::set.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
+template <typename StoreSet>
 class UnusedStoreBase: public ASTWalker
 {
 public:
@@ -60,7 +66,7 @@ public:
 	void operator()(Continue const&) override;
 
 protected:
-	using ActiveStores = std::map<YulName, std::set<Statement const*>>;
+	using ActiveStores = std::map<YulName, StoreSet>;
 
 	/// This function is called for a loop that is nested too deep to avoid
 	/// horrible runtime and should just resolve the situation in a pragmatic
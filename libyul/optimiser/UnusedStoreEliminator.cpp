@@ -40,6 +40,8 @@
 
 #include <range/v3/algorithm/all_of.hpp>
 
+#include <limits>
+
 using namespace solidity;
 using namespace solidity::yul;
 
@@ -212,11 +214,11 @@ void UnusedStoreEliminator::visit(Statement const& _statement)
 		std::vector<Operation> operations = operationsFromFunctionCall(*funCall);
 		yulAssert(operations.size() == 1, "");
 		if (operations.front().location == Location::Storage)
-			activeStorageStores().insert(&_statement);
+			activeStorageStores().insert(&_statement, std::nullopt);
 		else
 		{
 			yulAssert(operations.front().location == Location::Memory, "");
-			activeMemoryStores().insert(&_statement);
+			activeMemoryStores().insert(&_statement, indexedRegion(operations.front()));
 		}
 		m_storeOperations[&_statement] = std::move(operations.front());
 	}
@@ -274,28 +276,119 @@ std::vector<UnusedStoreEliminator::Operation> UnusedStoreEliminator::operationsF
 
 void UnusedStoreEliminator::applyOperation(UnusedStoreEliminator::Operation const& _operation)
 {
-	std::set<Statement const*>& active =
-		_operation.location == Location::Storage ?
-		activeStorageStores() :
-		activeMemoryStores();
+	if (_operation.effect == Effect::Read)
+	{
+		// Nothing is read from an empty region.
+		if (
+			_operation.location == Location::Memory &&
+			_operation.length &&
+			m_knowledgeBase.knownToBeZero(*_operation.length)
+		)
+			return;
+		eraseAffectedIf(_operation, [&](Statement const* _store) {
+			if (knownUnrelated(m_storeOperations.at(_store), _operation))
+				return false;
+			// This store is read from, mark it as used and remove it from the active set.
+			m_usedStores.insert(_store);
+			return true;
+		});
+	}
+	else if (_operation.effect == Effect::Write)
+		eraseAffectedIf(_operation, [&](Statement const* _store) {
+			// This store is overwritten before being read, remove it from the active set.
+			return knownCovered(m_storeOperations.at(_store), _operation);
+		});
+}
+
+void UnusedStoreEliminator::eraseAffectedIf(
+	UnusedStoreEliminator::Operation const& _operation,
+	IndexedStoreSet::Predicate const& _predicate
+)
+{
+	if (_operation.location == Location::Storage)
+	{
+		activeStorageStores().eraseIf(_predicate);
+		return;
+	}
 
+	IndexedStoreSet& active = activeMemoryStores();
+	if (!_operation.start)
+	{
+		active.eraseIf(_predicate);
+		return;
+	}
 
-	for (auto it = active.begin(); it != active.end();)
+	// The indexed stores skipped below are known to be unrelated to or not covered by the operation,
+	// so the predicate would return false for them in any case.
+	active.eraseUnindexedIf(_predicate);
+	KnowledgeBase::VariableOffset const start = m_knowledgeBase.groupOffset(*_operation.start);
+	std::optional<u256> const length =
+		_operation.length ?
+		m_knowledgeBase.valueIfKnownConstant(*_operation.length) :
+		std::nullopt;
+	bool const knownAbsoluteRegion =
+		start.isAbsolute() &&
+		length && *length > 0 &&
+		start.offset + *length >= start.offset; // no overflow
+
+	if (_operation.effect == Effect::Read)
 	{
-		Statement const* statement = *it;
-		Operation const& storeOperation = m_storeOperations.at(statement);
-		if (_operation.effect == Effect::Read && !knownUnrelated(storeOperation, _operation))
+		// Regions relative to different variables are never known to be unrelated to regions of non-zero length.
+		active.eraseOtherReferencesIf(start.reference, _predicate);
+		if (knownAbsoluteRegion)
 		{
-			// This store is read from, mark it as used and remove it from the active set.
-			m_usedStores.insert(statement);
-			it = active.erase(it);
+			// Only regions overlapping the one read from are related.
+			u256 const maxLength = active.maxLength(start.reference);
+			if (maxLength > 0)
+				active.eraseInRangeIf(
+					start.reference,
+					start.offset >= maxLength ? start.offset - maxLength + 1 : u256(0),
+					start.offset + *length - 1,
+					_predicate
+				);
+		}
+		else if (!start.isAbsolute() && length && *length <= 32)
+		{
+			// Relative regions of at most 32 bytes are only unrelated if their starts differ by at least 32.
+			u256 const from = start.offset - 31;
+			u256 const to = start.offset + 31;
+			if (from <= to)
+				active.eraseInRangeIf(start.reference, from, to, _predicate);
+			else
+			{
+				active.eraseInRangeIf(start.reference, from, std::numeric_limits<u256>::max(), _predicate);
+				active.eraseInRangeIf(start.reference, 0, to, _predicate);
+			}
 		}
-		else if (_operation.effect == Effect::Write && knownCovered(storeOperation, _operation))
-			// This store is overwritten before being read, remove it from the active set.
-			it = active.erase(it);
 		else
-			++it;
+			active.eraseReferenceIf(start.reference, _predicate);
 	}
+	else
+	{
+		// Only stores starting at the same variable or, for constant regions, stores inside
+		// the region written to can be covered.
+		if (knownAbsoluteRegion)
+			active.eraseInRangeIf(start.reference, start.offset, start.offset + *length - 1, _predicate);
+		else
+			active.eraseInRangeIf(start.reference, start.offset, start.offset, _predicate);
+	}
+}
+
+std::optional<IndexedStoreSet::Region> UnusedStoreEliminator::indexedRegion(
+	UnusedStoreEliminator::Operation const& _store
+) const
+{
+	yulAssert(_store.location == Location::Memory);
+	if (!_store.start || !_store.length)
+		return std::nullopt;
+	std::optional<u256> const length = m_knowledgeBase.valueIfKnownConstant(*_store.length);
+	if (!length || *length == 0)
+		return std::nullopt;
+
+	KnowledgeBase::VariableOffset const start = m_knowledgeBase.groupOffset(*_store.start);
+	if (start.isAbsolute() ? start.offset + *length < start.offset : *length > 32)
+		return std::nullopt;
+	return IndexedStoreSet::Region{start.reference, start.offset, *length};
 }
 
 bool UnusedStoreEliminator::knownUnrelated(
@@ -416,12 +509,11 @@ void UnusedStoreEliminator::markActiveAsUsed(
 	std::optional<UnusedStoreEliminator::Location> _onlyLocation
 )
 {
+	auto markUsed = [&](Statement const* _statement) { m_usedStores.insert(_statement); };
 	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Memory)
-		for (Statement const* statement: activeMemoryStores())
-			m_usedStores.insert(statement);
+		activeMemoryStores().forEach(markUsed);
 	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Storage)
-		for (Statement const* statement: activeStorageStores())
-			m_usedStores.insert(statement);
+		activeStorageStores().forEach(markUsed);
 	clearActive(_onlyLocation);
 }
 
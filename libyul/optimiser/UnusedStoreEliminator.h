@@ -24,6 +24,7 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/IndexedStoreSet.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/UnusedStoreBase.h>
@@ -51,12 +52,14 @@ struct AssignedValue;
  * so the statement will be removed only if all code code paths lead to a memory overwrite.
  *
  * The m_store member of UnusedStoreBase uses the key "m" for memory and "s" for storage stores.
+ * Memory stores to a region with a known offset from some variable are indexed by that offset,
+ * so that an operation on a known region only has to check the stores close to it.
  *
  * Best run in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
-class UnusedStoreEliminator: public UnusedStoreBase
+class UnusedStoreEliminator: public UnusedStoreBase<IndexedStoreSet>
 {
 public:
 	static constexpr char const* name{"UnusedStoreEliminator"};
@@ -92,8 +95,8 @@ public:
 	};
 
 private:
-	std::set<Statement const*>& activeMemoryStores() { return m_activeStores["m"_yulname]; }
-	std::set<Statement const*>& activeStorageStores() { return m_activeStores["s"_yulname]; }
+	IndexedStoreSet& activeMemoryStores() { return m_activeStores["m"_yulname]; }
+	IndexedStoreSet& activeStorageStores() { return m_activeStores["s"_yulname]; }
 
 	void shortcutNestedLoop(ActiveStores const&) override
 	{
@@ -107,6 +110,11 @@ private:
 
 	std::vector<Operation> operationsFromFunctionCall(FunctionCall const& _functionCall) const;
 	void applyOperation(Operation const& _operation);
+	/// Removes the active stores that may be affected by @a _operation and for which @a _predicate returns true.
+	void eraseAffectedIf(Operation const& _operation, IndexedStoreSet::Predicate const& _predicate);
+	/// @returns the region written by a memory store if its start is known relative to some
+	/// variable and its length is a non-zero constant that is at most 32 for non-constant starts.
+	std::optional<IndexedStoreSet::Region> indexedRegion(Operation const& _store) const;
 	bool knownUnrelated(Operation const& _op1, Operation const& _op2) const;
 	bool knownCovered(Operation const& _covered, Operation const& _covering) const;
 
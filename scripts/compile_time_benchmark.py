@@ -0,0 +1,399 @@
+#!/usr/bin/env python3
+"""Measures the compilation time of a set of workloads and compares it against a baseline.
+
+The `run` command compiles every workload with the legacy and the via-IR pipeline, using the
+profiling output of the compiler (`--profile`) to break the time down into phases. It records:
+
+- wall clock and CPU time (user + system) of the compiler process,
+- peak resident set size of the compiler process,
+- total size of the runtime and creation bytecode of all contracts,
+- time spent in each profiled phase, summed over all contracts.
+
+Each workload is either a single Solidity file or a Foundry project, e.g. one of the projects
+checked out by `test/benchmarks/external-setup.sh`. Without explicit workloads, the files in
+`test/benchmarks/` and all the projects present in `$BENCHMARK_DIR` are used.
+
+The `compare` command reports the relative differences between two result files and exits with
+a non-zero status if a tracked metric grew by more than the threshold, or if a compilation that
+used to succeed now fails.
+
+Examples:
+    scripts/compile_time_benchmark.py run --solc build/solc/solc --output current.json
+    scripts/compile_time_benchmark.py compare baseline.json current.json --format markdown
+"""
+
+from argparse import ArgumentParser, RawDescriptionHelpFormatter
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from statistics import median
+from typing import Dict, List, Optional, Sequence
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+REPO_ROOT = Path(__file__).parent.parent
+LOCAL_BENCHMARK_DIR = REPO_ROOT / 'test/benchmarks'
+DEFAULT_EXTERNAL_BENCHMARK_DIR = REPO_ROOT / 'benchmarks'
+
+PIPELINES = ('legacy', 'ir')
+# Profiler categories whose events are reported as phases. The remaining ones (e.g. "smtchecker")
+# are not relevant when compiling without the SMTChecker.
+PHASE_CATEGORIES = ('compiler', 'evmasm', 'yul')
+DEFAULT_TRACKED_METRICS = ('cpu_time', 'peak_rss')
+DEFAULT_THRESHOLD = 0.05
+
+
+class BenchmarkError(Exception):
+    pass
+
+
+@dataclass(frozen=True)
+class Workload:
+    name: str
+    source_files: Sequence[Path]
+    base_path: Optional[Path] = None
+    include_paths: Sequence[Path] = ()
+    remappings: Sequence[str] = ()
+
+    @staticmethod
+    def from_path(path: Path) -> 'Workload':
+        if path.is_file():
+            return Workload(path.stem, [path])
+        if (path / 'foundry.toml').is_file():
+            return Workload.from_foundry_project(path)
+        raise BenchmarkError(f"{path} is neither a Solidity file nor a Foundry project.")
+
+    @staticmethod
+    def from_foundry_project(project_dir: Path) -> 'Workload':
+        source_files = sorted((project_dir / 'src').rglob('*.sol'))
+        if len(source_files) == 0:
+            raise BenchmarkError(f"No Solidity files found in {project_dir / 'src'}.")
+
+        include_paths = [project_dir / 'lib'] if (project_dir / 'lib').is_dir() else []
+        return Workload(
+            project_dir.name,
+            source_files,
+            base_path=project_dir,
+            include_paths=include_paths,
+            remappings=foundry_remappings(project_dir),
+        )
+
+
+@dataclass
+class Measurement:
+    exit_code: int
+    # In seconds.
+    wall_time: float
+    cpu_time: float
+    # In bytes.
+    peak_rss: int
+    bytecode_size: int
+    # Time in seconds spent in each profiled phase, keyed by "<category>/<name>".
+    phases: Dict[str, float] = field(default_factory=dict)
+
+
+def foundry_remappings(project_dir: Path) -> List[str]:
+    if shutil.which('forge') is not None:
+        output = subprocess.run(
+            ['forge', 'remappings'],
+            cwd=project_dir,
+            check=True,
+            encoding='utf-8',
+            stdout=subprocess.PIPE,
+        ).stdout
+    elif (project_dir / 'remappings.txt').is_file():
+        output = (project_dir / 'remappings.txt').read_text(encoding='utf-8')
+    else:
+        return []
+
+    return [line.strip() for line in output.splitlines() if line.strip() != '']
+
+
+def default_workloads(external_benchmark_dir: Path) -> List[Workload]:
+    workloads = [Workload.from_path(path) for path in sorted(LOCAL_BENCHMARK_DIR.glob('*.sol'))]
+    if external_benchmark_dir.is_dir():
+        workloads += [
+            Workload.from_foundry_project(path)
+            for path in sorted(external_benchmark_dir.iterdir())
+            if (path / 'foundry.toml').is_file()
+        ]
+    return workloads
+
+
+def phase_timings(trace: dict) -> Dict[str, float]:
+    """Sums up the durations of the events in a Chrome trace produced by `solc --profile` by name."""
+
+    phases: Dict[str, float] = {}
+    for event in trace['traceEvents']:
+        if event['cat'] not in PHASE_CATEGORIES:
+            continue
+        key = f"{event['cat']}/{event['name']}"
+        phases[key] = phases.get(key, 0.0) + event['dur'] / 1e6
+    return phases
+
+
+def bytecode_size(combined_json: dict) -> int:
+    """Total size in bytes of the creation and runtime bytecode in the output of `solc --combined-json`."""
+
+    return sum(
+        (len(contract.get('bin', '')) + len(contract.get('bin-runtime', ''))) // 2
+        for contract in combined_json.get('contracts', {}).values()
+    )
+
+
+def compile_workload(solc: Path, workload: Workload, pipeline: str) -> Measurement:
+    assert pipeline in PIPELINES
+
+    with tempfile.TemporaryDirectory(prefix='solc-benchmark-') as output_dir:
+        profile_path = Path(output_dir) / 'profile.json'
+        stdout_path = Path(output_dir) / 'stdout.json'
+
+        command = [
+            str(solc),
+            '--optimize',
+            '--combined-json', 'bin,bin-runtime',
+            '--profile', str(profile_path),
+        ]
+        if pipeline == 'ir':
+            command.append('--via-ir')
+        if workload.base_path is not None:
+            command += ['--base-path', str(workload.base_path)]
+        for include_path in workload.include_paths:
+            command += ['--include-path', str(include_path)]
+        command += workload.remappings
+        command += [str(path) for path in workload.source_files]
+
+        with open(stdout_path, 'w', encoding='utf-8') as stdout_file:
+            start = time.perf_counter()
+            # NOTE: The legacy pipeline may fail with "Stack too deep". The exit code is recorded
+            # and the compiler output is discarded so that it does not drown the results.
+            process = subprocess.Popen(
+                command,
+                cwd=workload.base_path,
+                stdout=stdout_file,
+                stderr=subprocess.DEVNULL,
+            )
+            _, status, usage = os.wait4(process.pid, 0)
+            wall_time = time.perf_counter() - start
+            # Popen must not try to reap the process it no longer knows about.
+            process.returncode = os.waitstatus_to_exitcode(status)
+
+        # ru_maxrss is reported in bytes on macOS and in kilobytes everywhere else.
+        peak_rss = usage.ru_maxrss if sys.platform == 'darwin' else usage.ru_maxrss * 1024
+
+        measurement = Measurement(
+            exit_code=process.returncode,
+            wall_time=wall_time,
+            cpu_time=usage.ru_utime + usage.ru_stime,
+            peak_rss=peak_rss,
+            bytecode_size=0,
+        )
+        if measurement.exit_code == 0:
+            measurement.bytecode_size = bytecode_size(json.loads(stdout_path.read_text(encoding='utf-8')))
+            measurement.phases = phase_timings(json.loads(profile_path.read_text(encoding='utf-8')))
+        return measurement
+
+
+def summarize(measurements: Sequence[Measurement]) -> Measurement:
+    """Combines repeated measurements of the same compilation into their medians."""
+
+    assert len(measurements) > 0
+    phase_names = sorted({name for measurement in measurements for name in measurement.phases})
+    return Measurement(
+        exit_code=max(measurements, key=lambda measurement: abs(measurement.exit_code)).exit_code,
+        wall_time=median(measurement.wall_time for measurement in measurements),
+        cpu_time=median(measurement.cpu_time for measurement in measurements),
+        peak_rss=int(median(measurement.peak_rss for measurement in measurements)),
+        bytecode_size=measurements[-1].bytecode_size,
+        phases={
+            name: median(measurement.phases.get(name, 0.0) for measurement in measurements)
+            for name in phase_names
+        },
+    )
+
+
+def run_benchmarks(solc: Path, workloads: Sequence[Workload], pipelines: Sequence[str], repetitions: int) -> dict:
+    version = subprocess.run(
+        [str(solc), '--version'],
+        check=True,
+        encoding='utf-8',
+        stdout=subprocess.PIPE,
+    ).stdout.strip().splitlines()[-1]
+
+    results: Dict[str, Dict[str, dict]] = {}
+    for workload in workloads:
+        for pipeline in pipelines:
+            print(f"Compiling {workload.name} via {pipeline}...", file=sys.stderr)
+            measurements = [compile_workload(solc, workload, pipeline) for _ in range(repetitions)]
+            results.setdefault(workload.name, {})[pipeline] = asdict(summarize(measurements))
+
+    return {
+        'compiler': version,
+        'repetitions': repetitions,
+        'results': results,
+    }
+
+
+def flatten_metrics(measurement: dict) -> Dict[str, float]:
+    metrics = {name: value for name, value in measurement.items() if name not in ('exit_code', 'phases')}
+    metrics.update({f"phases/{name}": value for name, value in measurement.get('phases', {}).items()})
+    return metrics
+
+
+def compare_results(
+    baseline: dict,
+    current: dict,
+    tracked_metrics: Sequence[str] = DEFAULT_TRACKED_METRICS,
+    threshold: float = DEFAULT_THRESHOLD,
+) -> dict:
+    """Computes the relative differences of all metrics present in both results.
+
+    @returns a dict with the differences per workload, pipeline and metric and a list of
+    regressions, i.e. tracked metrics that grew by more than @a threshold and compilations
+    that failed in @a current but not in @a baseline.
+    """
+
+    differences: Dict[str, Dict[str, Dict[str, Optional[float]]]] = {}
+    regressions: List[str] = []
+    for workload, pipelines in sorted(current['results'].items()):
+        for pipeline, measurement in sorted(pipelines.items()):
+            baseline_measurement = baseline['results'].get(workload, {}).get(pipeline)
+            if baseline_measurement is None:
+                continue
+
+            if measurement['exit_code'] != 0 and baseline_measurement['exit_code'] == 0:
+                regressions.append(f"{workload} via {pipeline}: compilation failed")
+
+            before = flatten_metrics(baseline_measurement)
+            after = flatten_metrics(measurement)
+            pipeline_differences: Dict[str, Optional[float]] = {}
+            for metric in sorted(set(before) & set(after)):
+                if before[metric] == 0:
+                    pipeline_differences[metric] = None if after[metric] != 0 else 0.0
+                    continue
+                difference = (after[metric] - before[metric]) / before[metric]
+                pipeline_differences[metric] = difference
+                if metric in tracked_metrics and difference > threshold:
+                    regressions.append(f"{workload} via {pipeline}: {metric} increased by {difference:+.1%}")
+            differences.setdefault(workload, {})[pipeline] = pipeline_differences
+
+    return {
+        'baseline': baseline.get('compiler'),
+        'current': current.get('compiler'),
+        'differences': differences,
+        'regressions': regressions,
+    }
+
+
+def format_comparison(comparison: dict, output_format: str) -> str:
+    if output_format == 'json':
+        return json.dumps(comparison, indent=4, sort_keys=True)
+
+    assert output_format in ('console', 'markdown')
+    markdown = (output_format == 'markdown')
+
+    def formatted_difference(difference: Optional[float]) -> str:
+        return 'new' if difference is None else f"{difference:+.1%}"
+
+    metrics = ['wall_time', 'cpu_time', 'peak_rss', 'bytecode_size']
+    rows = [
+        [workload, pipeline] + [formatted_difference(differences.get(metric)) for metric in metrics]
+        for workload, pipelines in comparison['differences'].items()
+        for pipeline, differences in pipelines.items()
+    ]
+    header = ['Workload', 'Pipeline'] + metrics
+
+    lines = [f"Baseline: {comparison['baseline']}", f"Current:  {comparison['current']}", '']
+    if markdown:
+        lines.append('| ' + ' | '.join(header) + ' |')
+        lines.append('|' + '|'.join(['---'] * 2 + ['---:'] * len(metrics)) + '|')
+        lines += ['| ' + ' | '.join(row) + ' |' for row in rows]
+    else:
+        widths = [max(len(str(cell)) for cell in column) for column in zip(header, *rows)]
+        for row in [header] + rows:
+            lines.append('  '.join(cell.ljust(width) for cell, width in zip(row, widths)).rstrip())
+
+    lines.append('')
+    if len(comparison['regressions']) == 0:
+        lines.append('No regressions.')
+    else:
+        lines.append('Regressions:')
+        lines += [f"- {regression}" for regression in comparison['regressions']]
+    return '\n'.join(lines)
+
+
+def process_commandline():
+    parser = ArgumentParser(description=__doc__, formatter_class=RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser('run', help="Compile the workloads and record the measurements.")
+    run_parser.add_argument('workloads', nargs='*', type=Path, help="Solidity files or Foundry project directories.")
+    run_parser.add_argument('--solc', type=Path, default=REPO_ROOT / 'build/solc/solc', help="Compiler binary to benchmark.")
+    run_parser.add_argument('--pipelines', nargs='+', choices=PIPELINES, default=list(PIPELINES))
+    run_parser.add_argument('--repetitions', type=int, default=3, help="Number of runs per compilation, the median is reported.")
+    run_parser.add_argument('--output', type=Path, help="File to write the results to instead of the standard output.")
+
+    compare_parser = subparsers.add_parser('compare', help="Compare results against a baseline.")
+    compare_parser.add_argument('baseline', type=Path)
+    compare_parser.add_argument('current', type=Path)
+    compare_parser.add_argument(
+        '--threshold',
+        type=float,
+        default=DEFAULT_THRESHOLD,
+        help="Relative increase of a tracked metric that is reported as a regression.",
+    )
+    compare_parser.add_argument(
+        '--tracked-metrics',
+        nargs='+',
+        default=list(DEFAULT_TRACKED_METRICS),
+        help="Metrics checked for regressions, e.g. cpu_time, peak_rss, bytecode_size or \"phases/compiler/Analysis\".",
+    )
+    compare_parser.add_argument('--format', choices=('console', 'markdown', 'json'), default='console')
+
+    return parser.parse_args()
+
+
+def main():
+    try:
+        options = process_commandline()
+
+        if options.command == 'run':
+            if options.repetitions < 1:
+                raise BenchmarkError("The number of repetitions must be positive.")
+            if len(options.workloads) > 0:
+                workloads = [Workload.from_path(path.resolve()) for path in options.workloads]
+            else:
+                workloads = default_workloads(Path(os.environ.get('BENCHMARK_DIR', DEFAULT_EXTERNAL_BENCHMARK_DIR)))
+
+            results = json.dumps(
+                run_benchmarks(options.solc.resolve(), workloads, options.pipelines, options.repetitions),
+                indent=4,
+                sort_keys=True,
+            )
+            if options.output is not None:
+                options.output.write_text(results + '\n', encoding='utf-8')
+            else:
+                print(results)
+            return 0
+
+        assert options.command == 'compare'
+        comparison = compare_results(
+            json.loads(options.baseline.read_text(encoding='utf-8')),
+            json.loads(options.current.read_text(encoding='utf-8')),
+            options.tracked_metrics,
+            options.threshold,
+        )
+        print(format_comparison(comparison, options.format))
+        return 0 if len(comparison['regressions']) == 0 else 1
+    except (BenchmarkError, subprocess.CalledProcessError) as exception:
+        print(f"[ERROR] {exception}", file=sys.stderr)
+        return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,380 @@
+#!/usr/bin/env python3
+"""Evaluates candidate Yul optimizer sequences on a corpus and recommends the Pareto-optimal ones.
+
+Every candidate sequence is measured on three objectives, all of which are to be minimised:
+
+- compile time: CPU time (user + system) of compiling each file of the corpus via IR with the
+  sequence, the minimum over `--repeat` runs, summed over all files,
+- bytecode size: total size of the runtime bytecode of all contracts in the corpus,
+- gas: total gas used by the calls of the corpus, including the code deposit of contract creations.
+
+The corpus is a directory of test files in the format of the semantic tests (see the files in
+`test/libsolidity/semanticTests/`), i.e. contracts followed by the calls to execute on them.
+Gas is measured by running the given `isoltest` binary with `--optimize --yul-optimizations <sequence>`
+on a temporary copy of the corpus and reading the `gas irOptimized:` expectations it records.
+Without `--isoltest`, gas is not measured and the candidates are compared on the other two objectives.
+Files with multiple sources are skipped since they cannot be compiled on their own.
+
+The default sequence of the compiler is always evaluated as well and serves as the baseline. A
+candidate that fails to compile a file that compiles with the default sequence, or that changes
+the result of any call, is rejected. A candidate whose compile time is more than
+`--max-compile-time-increase` above the baseline is over the budget and is never recommended.
+
+The recommended sequences are the candidates within the budget that are not dominated by any
+other candidate within the budget, i.e. no other candidate is at least as good on every
+objective and better on one. They are sorted by gas, then bytecode size, then compile time.
+
+Candidates are passed via `--sequence` or via `--sequences-file`, which contains one sequence per
+line in the format of `solc --yul-optimizations`. Empty lines and lines starting with `#` are
+ignored. Population files written by `yulPhaser --population-autosave` have this format too,
+so the output of an optimiser search can be evaluated directly.
+
+Examples:
+    scripts/optimiser_sequence_search.py corpus/ --solc build/solc/solc --sequence 'dhfoDgvulfnTUtnIf' --sequence 'fDnTOc'
+    scripts/optimiser_sequence_search.py corpus/ --solc build/solc/solc --isoltest build/test/tools/isoltest \\
+        --sequences-file population.txt --max-compile-time-increase 0.1 --format json
+"""
+
+from argparse import ArgumentParser, RawDescriptionHelpFormatter
+from dataclasses import asdict, dataclass
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence, Tuple
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+# NOTE: semantic_gas_report.py is located in the same directory as this script.
+from semantic_gas_report import SEMANTIC_TEST_SUBDIR, collect_gas  # pylint: disable=import-error
+
+
+DEFAULT_SEQUENCE = 'default'
+DEFAULT_REPETITIONS = 3
+GAS_SETTINGS = ('irOptimized', 'irOptimized code')
+MULTI_SOURCE_MARKERS = ('==== Source:', '==== ExternalSource:')
+
+
+class SequenceSearchError(Exception):
+    pass
+
+
+@dataclass
+class Evaluation:
+    sequence: str
+    compile_time: float = 0.0
+    bytecode_size: int = 0
+    gas: Optional[int] = None
+    failure: Optional[str] = None
+    within_budget: bool = True
+    pareto_optimal: bool = False
+
+    def objectives(self) -> Tuple[float, ...]:
+        return (self.compile_time, self.bytecode_size, self.gas if self.gas is not None else 0)
+
+
+def parse_sequences(text: str) -> List[str]:
+    return [
+        line.strip()
+        for line in text.splitlines()
+        if line.strip() != '' and not line.strip().startswith('#')
+    ]
+
+
+def corpus_files(corpus_dir: Path) -> List[Path]:
+    """@returns the files of the corpus that can be compiled on their own, relative to @a corpus_dir."""
+
+    if not corpus_dir.is_dir():
+        raise SequenceSearchError(f"Corpus not found. '{corpus_dir}' is missing or not a directory.")
+
+    return [
+        path.relative_to(corpus_dir)
+        for path in sorted(corpus_dir.rglob('*.sol'))
+        if not any(marker in path.read_text(encoding='utf-8') for marker in MULTI_SOURCE_MARKERS)
+    ]
+
+
+def runtime_bytecode_size(combined_json: dict) -> int:
+    return sum(
+        len(contract.get('bin-runtime', '')) // 2
+        for contract in combined_json.get('contracts', {}).values()
+    )
+
+
+def compile_file(solc: Path, source_file: Path, sequence: str) -> Optional[Tuple[float, int]]:
+    """Compiles @a source_file via IR with the optimizer using @a sequence.
+
+    @returns the CPU time of the compiler and the runtime bytecode size or None if compilation failed.
+    """
+
+    command = [str(solc), '--via-ir', '--optimize', '--combined-json', 'bin-runtime']
+    if sequence != DEFAULT_SEQUENCE:
+        command += ['--yul-optimizations', sequence]
+    command.append(str(source_file))
+
+    with tempfile.TemporaryFile(mode='w+', encoding='utf-8') as stdout_file:
+        process = subprocess.Popen(command, stdout=stdout_file, stderr=subprocess.DEVNULL)
+        _, status, usage = os.wait4(process.pid, 0)
+        # Popen must not try to reap the process it no longer knows about.
+        process.returncode = os.waitstatus_to_exitcode(status)
+        if process.returncode != 0:
+            return None
+
+        stdout_file.seek(0)
+        return usage.ru_utime + usage.ru_stime, runtime_bytecode_size(json.load(stdout_file))
+
+
+def without_gas_expectations(test_source: str) -> str:
+    return '\n'.join(line for line in test_source.splitlines() if not line.startswith('// gas '))
+
+
+def run_isoltest(
+    isoltest: Path,
+    corpus_dir: Path,
+    files: Sequence[Path],
+    sequence: str,
+) -> Tuple[Dict[str, Dict[str, Dict[str, int]]], Dict[str, str]]:
+    """Runs @a isoltest with @a sequence on a copy of @a files and records the gas used by each call.
+
+    @returns the gas expectations of each test as returned by collect_gas() and the updated
+    test files with the gas expectations removed, i.e. the results of the calls.
+    """
+
+    with tempfile.TemporaryDirectory(prefix='optimiser-sequence-search-') as temporary_dir:
+        test_dir = Path(temporary_dir) / SEMANTIC_TEST_SUBDIR
+        for file in files:
+            (test_dir / file).parent.mkdir(parents=True, exist_ok=True)
+            shutil.copyfile(corpus_dir / file, test_dir / file)
+
+        command = [
+            str(isoltest),
+            '--testpath', temporary_dir,
+            '--test', 'semanticTests/*',
+            '--optimize',
+            '--enforce-gas-cost',
+            '--enforce-gas-cost-min-value', '0',
+            '--accept-updates',
+            '--no-smt',
+        ]
+        if sequence != DEFAULT_SEQUENCE:
+            command += ['--yul-optimizations', sequence]
+        process = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, check=False)
+        if process.returncode != 0:
+            raise SequenceSearchError(f"isoltest failed with exit code {process.returncode}")
+
+        results = {
+            file.as_posix(): without_gas_expectations((test_dir / file).read_text(encoding='utf-8'))
+            for file in files
+        }
+        return collect_gas(test_dir), results
+
+
+def changed_results(results: Dict[str, str], baseline_results: Dict[str, str]) -> List[str]:
+    """@returns the names of the tests whose calls have different results than in @a baseline_results.
+
+    With --accept-updates isoltest also accepts different results of the calls, which would hide
+    miscompilations. Only changes to the gas expectations are acceptable.
+    """
+
+    return [test_name for test_name, result in results.items() if baseline_results.get(test_name) != result]
+
+
+def total_gas(tests: Dict[str, Dict[str, Dict[str, int]]], baseline: Dict[str, Dict[str, Dict[str, int]]]) -> int:
+    """@returns the gas used by the calls of @a tests that are also recorded in @a baseline.
+
+    @raises SequenceSearchError if a call of the baseline has not been recorded in @a tests.
+    """
+
+    total = 0
+    for test_name, calls in baseline.items():
+        for call, settings in calls.items():
+            for setting in GAS_SETTINGS:
+                if setting not in settings:
+                    continue
+                gas = tests.get(test_name, {}).get(call, {}).get(setting)
+                if gas is None:
+                    raise SequenceSearchError(f"{test_name}: no gas recorded for '{call}' ({setting})")
+                total += gas
+    return total
+
+
+def dominates(a: Evaluation, b: Evaluation) -> bool:
+    return all(x <= y for x, y in zip(a.objectives(), b.objectives())) and a.objectives() != b.objectives()
+
+
+def mark_pareto_front(evaluations: Sequence[Evaluation], max_compile_time_increase: Optional[float]):
+    """Marks the evaluations that are within the compile time budget and the non-dominated ones among them.
+
+    The first evaluation is the baseline the budget is relative to.
+    """
+
+    baseline = evaluations[0]
+    assert baseline.sequence == DEFAULT_SEQUENCE and baseline.failure is None
+
+    for evaluation in evaluations:
+        evaluation.within_budget = evaluation.failure is None and (
+            max_compile_time_increase is None or
+            evaluation.compile_time <= baseline.compile_time * (1.0 + max_compile_time_increase)
+        )
+        evaluation.pareto_optimal = False
+
+    candidates = [evaluation for evaluation in evaluations if evaluation.within_budget]
+    for evaluation in candidates:
+        evaluation.pareto_optimal = not any(dominates(other, evaluation) for other in candidates)
+
+
+def recommended(evaluations: Sequence[Evaluation]) -> List[Evaluation]:
+    return sorted(
+        [evaluation for evaluation in evaluations if evaluation.pareto_optimal],
+        key=lambda evaluation: (evaluation.gas or 0, evaluation.bytecode_size, evaluation.compile_time),
+    )
+
+
+def evaluate_sequences(
+    solc: Path,
+    isoltest: Optional[Path],
+    corpus_dir: Path,
+    sequences: Sequence[str],
+    repetitions: int,
+) -> List[Evaluation]:
+    """Evaluates the default sequence followed by @a sequences on the corpus."""
+
+    files = corpus_files(corpus_dir)
+    baseline_gas = None
+    baseline_results: Dict[str, str] = {}
+    evaluations: List[Evaluation] = []
+    for sequence in [DEFAULT_SEQUENCE] + [sequence for sequence in sequences if sequence != DEFAULT_SEQUENCE]:
+        evaluation = Evaluation(sequence)
+        evaluations.append(evaluation)
+        print(f"Evaluating {sequence}", file=sys.stderr)
+
+        for file in list(files):
+            results = [compile_file(solc, corpus_dir / file, sequence) for _ in range(repetitions)]
+            if any(result is None for result in results):
+                if sequence == DEFAULT_SEQUENCE:
+                    print(f"Skipping {file.as_posix()}: compilation failed with the default sequence", file=sys.stderr)
+                    files.remove(file)
+                    continue
+                evaluation.failure = f"{file.as_posix()}: compilation failed"
+                break
+            evaluation.compile_time += min(cpu_time for cpu_time, _ in results)
+            evaluation.bytecode_size += results[0][1]
+
+        if evaluation.failure is not None or isoltest is None:
+            continue
+
+        try:
+            tests, results = run_isoltest(isoltest, corpus_dir, files, sequence)
+            if baseline_gas is None:
+                baseline_gas, baseline_results = tests, results
+            if len(changed := changed_results(results, baseline_results)) > 0:
+                raise SequenceSearchError(f"{changed[0]}: results of the calls differ from the default sequence")
+            evaluation.gas = total_gas(tests, baseline_gas)
+        except SequenceSearchError as exception:
+            if sequence == DEFAULT_SEQUENCE:
+                raise SequenceSearchError(f"Default sequence: {exception}") from exception
+            evaluation.failure = str(exception)
+
+    if len(files) == 0:
+        raise SequenceSearchError("No file of the corpus compiles with the default sequence.")
+    return evaluations
+
+
+def format_report(evaluations: Sequence[Evaluation], output_format: str) -> str:
+    if output_format == 'json':
+        return json.dumps(
+            {
+                'evaluations': [asdict(evaluation) for evaluation in evaluations],
+                'recommended': [evaluation.sequence for evaluation in recommended(evaluations)],
+            },
+            indent=4,
+            sort_keys=True,
+        )
+
+    assert output_format == 'console'
+    baseline = evaluations[0]
+
+    def with_relative(text: str, value: float, baseline_value: Optional[float]) -> str:
+        if baseline_value is None or baseline_value == 0:
+            return text
+        return f"{text} ({(value - baseline_value) / baseline_value:+.2%})"
+
+    header = ['Sequence', 'Compile time', 'Size', 'Gas', '']
+    rows = []
+    for evaluation in evaluations:
+        if evaluation.failure is not None:
+            rows.append([evaluation.sequence, '', '', '', f"rejected ({evaluation.failure})"])
+            continue
+        rows.append([
+            evaluation.sequence,
+            with_relative(f"{evaluation.compile_time:.2f} s", evaluation.compile_time, baseline.compile_time),
+            with_relative(str(evaluation.bytecode_size), evaluation.bytecode_size, baseline.bytecode_size),
+            with_relative(str(evaluation.gas), evaluation.gas, baseline.gas) if evaluation.gas is not None else '',
+            'pareto-optimal' if evaluation.pareto_optimal else ('' if evaluation.within_budget else 'over budget'),
+        ])
+
+    widths = [max(len(cell) for cell in column) for column in zip(header, *rows)]
+    lines = [
+        '  '.join(cell.ljust(width) for cell, width in zip(row, widths)).rstrip()
+        for row in [header] + rows
+    ]
+    lines += ['', 'Recommended sequences:']
+    lines += [f"- {evaluation.sequence}" for evaluation in recommended(evaluations)]
+    return '\n'.join(lines)
+
+
+def process_commandline():
+    parser = ArgumentParser(description=__doc__, formatter_class=RawDescriptionHelpFormatter)
+    parser.add_argument('corpus', type=Path, help="Directory with the test files to evaluate the sequences on.")
+    parser.add_argument('--solc', type=Path, required=True, help="Compiler binary to use.")
+    parser.add_argument('--isoltest', type=Path, help="isoltest binary used to measure gas. Gas is not measured without it.")
+    parser.add_argument('--sequence', action='append', default=[], help="Candidate sequence. Can be given multiple times.")
+    parser.add_argument('--sequences-file', type=Path, help="File with one candidate sequence per line.")
+    parser.add_argument(
+        '--repeat',
+        type=int,
+        default=DEFAULT_REPETITIONS,
+        help="Number of times each file is compiled with each sequence. The fastest run is used.",
+    )
+    parser.add_argument(
+        '--max-compile-time-increase',
+        type=float,
+        help="Relative increase of the compile time over the default sequence above which a candidate is not recommended.",
+    )
+    parser.add_argument('--format', choices=('console', 'json'), default='console')
+    parser.add_argument('--output', type=Path, help="File to write the report to instead of the standard output.")
+
+    return parser.parse_args()
+
+
+def main():
+    try:
+        options = process_commandline()
+
+        sequences = list(options.sequence)
+        if options.sequences_file is not None:
+            sequences += parse_sequences(options.sequences_file.read_text(encoding='utf-8'))
+
+        evaluations = evaluate_sequences(
+            options.solc.resolve(),
+            options.isoltest.resolve() if options.isoltest is not None else None,
+            options.corpus,
+            sequences,
+            max(options.repeat, 1),
+        )
+        mark_pareto_front(evaluations, options.max_compile_time_increase)
+
+        report = format_report(evaluations, options.format)
+        if options.output is not None:
+            options.output.write_text(report + '\n', encoding='utf-8')
+        else:
+            print(report)
+        return 0
+    except SequenceSearchError as exception:
+        print(f"[ERROR] {exception}", file=sys.stderr)
+        return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
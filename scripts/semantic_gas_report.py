@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""Aggregates the gas costs recorded in the semantic tests and compares them against a baseline.
+
+Semantic tests record the gas used by each call in the `gas legacy:`, `gas legacyOptimized:`,
+`gas ir:` and `gas irOptimized:` expectations, as well as the gas paid for the code deposit of
+contract creations (`gas legacy code:` etc.).
+
+The `collect` command reads these expectations from all the semantic tests and sums them up per
+category (the top-level directory of a test in `semanticTests/`) and setting. The expectations
+describe the compiler the tests were last updated with. To record the costs of a different build,
+pass its `isoltest` binary via `--isoltest`. It is then run with `--enforce-gas-cost --accept-updates`
+on a temporary copy of the tests, so that the working tree is not modified.
+
+The `compare` command reports the relative change of the total gas per category and setting.
+Only calls recorded in both results are taken into account, so that added or removed tests
+do not distort the totals. It exits with a non-zero status if a total grew by more than the
+threshold.
+
+Examples:
+    scripts/semantic_gas_report.py collect --output baseline.json
+    scripts/semantic_gas_report.py collect --isoltest build/test/tools/isoltest --output current.json
+    scripts/semantic_gas_report.py compare baseline.json current.json --format markdown
+"""
+
+from argparse import ArgumentParser, RawDescriptionHelpFormatter
+from pathlib import Path
+from typing import Dict, Iterable, List, Optional, Tuple
+import json
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+REPO_ROOT = Path(__file__).parent.parent
+TEST_DIR = REPO_ROOT / 'test'
+SEMANTIC_TEST_SUBDIR = Path('libsolidity/semanticTests')
+
+SETTINGS = (
+    'legacy',
+    'legacyOptimized',
+    'ir',
+    'irOptimized',
+    'legacy code',
+    'legacyOptimized code',
+    'ir code',
+    'irOptimized code',
+)
+TOTAL = 'total'
+DEFAULT_THRESHOLD = 0.0
+
+GAS_EXPECTATION = re.compile(r'^// gas (?P<setting>(legacy|legacyOptimized|ir|irOptimized)( code)?): (?P<gas>[0-9]+)\s*$')
+CALL = re.compile(r'^// (?P<call>[^\s~].*?)\s*$')
+
+
+class GasReportError(Exception):
+    pass
+
+
+def parse_gas_expectations(test_source: str) -> Dict[str, Dict[str, int]]:
+    """Extracts the gas expectations of a semantic test.
+
+    @returns the gas used by each call for each setting. Calls are identified by their expectation
+    line, with a `#<n>` suffix for the n-th repetition of the same line within the test.
+    """
+
+    expectations_started = False
+    current_call: Optional[str] = None
+    occurrences: Dict[str, int] = {}
+    gas: Dict[str, Dict[str, int]] = {}
+    for line in test_source.splitlines():
+        if not expectations_started:
+            expectations_started = line.strip() == '// ----'
+            continue
+
+        if match := GAS_EXPECTATION.match(line):
+            if current_call is None:
+                raise GasReportError(f"Gas expectation without a call: {line}")
+            gas.setdefault(current_call, {})[match['setting']] = int(match['gas'])
+        elif match := CALL.match(line):
+            call = match['call']
+            occurrences[call] = occurrences.get(call, 0) + 1
+            current_call = call if occurrences[call] == 1 else f"{call}#{occurrences[call]}"
+    return gas
+
+
+def category_of(test_name: str) -> str:
+    return test_name.split('/', 1)[0] if '/' in test_name else '.'
+
+
+def collect_gas(semantic_test_dir: Path) -> Dict[str, Dict[str, Dict[str, int]]]:
+    """@returns the gas expectations of all tests in @a semantic_test_dir that have any."""
+
+    if not semantic_test_dir.is_dir():
+        raise GasReportError(f"Semantic tests not found. '{semantic_test_dir}' is missing or not a directory.")
+
+    tests = {}
+    for path in sorted(semantic_test_dir.rglob('*.sol')):
+        gas = parse_gas_expectations(path.read_text(encoding='utf-8'))
+        if len(gas) > 0:
+            tests[path.relative_to(semantic_test_dir).as_posix()] = gas
+    return tests
+
+
+def update_gas_expectations(isoltest: Path, test_dir: Path):
+    """Runs @a isoltest on the semantic tests in @a test_dir, updating their gas expectations."""
+
+    subprocess.run(
+        [
+            str(isoltest),
+            '--testpath', str(test_dir),
+            '--test', 'semanticTests/*',
+            '--enforce-gas-cost',
+            '--accept-updates',
+            '--no-smt',
+        ],
+        check=True,
+        stdout=subprocess.DEVNULL,
+    )
+
+
+def aggregate(tests: Dict[str, Dict[str, Dict[str, int]]]) -> Dict[str, Dict[str, int]]:
+    """Sums up the gas per category and setting and over all categories."""
+
+    totals: Dict[str, Dict[str, int]] = {}
+    for test_name, calls in tests.items():
+        for category in (category_of(test_name), TOTAL):
+            for settings in calls.values():
+                for setting, gas in settings.items():
+                    totals.setdefault(category, {})
+                    totals[category][setting] = totals[category].get(setting, 0) + gas
+    return totals
+
+
+def collect_report(isoltest: Optional[Path]) -> dict:
+    if isoltest is None:
+        tests = collect_gas(TEST_DIR / SEMANTIC_TEST_SUBDIR)
+    else:
+        with tempfile.TemporaryDirectory(prefix='semantic-gas-report-') as temporary_dir:
+            test_dir = Path(temporary_dir)
+            shutil.copytree(TEST_DIR / SEMANTIC_TEST_SUBDIR, test_dir / SEMANTIC_TEST_SUBDIR)
+            update_gas_expectations(isoltest, test_dir)
+            tests = collect_gas(test_dir / SEMANTIC_TEST_SUBDIR)
+
+    return {
+        'source': 'test files' if isoltest is None else str(isoltest),
+        'totals': aggregate(tests),
+        'tests': tests,
+    }
+
+
+def matched_gas(baseline: dict, current: dict) -> Iterable[Tuple[str, str, int, int]]:
+    """@returns (test name, setting, baseline gas, current gas) for each call and setting recorded in both results."""
+
+    for test_name, calls in current['tests'].items():
+        baseline_calls = baseline['tests'].get(test_name, {})
+        for call, settings in calls.items():
+            for setting, gas in settings.items():
+                baseline_gas = baseline_calls.get(call, {}).get(setting)
+                if baseline_gas is not None:
+                    yield test_name, setting, baseline_gas, gas
+
+
+def compare_reports(baseline: dict, current: dict, threshold: float = DEFAULT_THRESHOLD) -> dict:
+    """Compares the total gas of the calls recorded in both reports.
+
+    @returns a dict with the totals per category and setting before and after and their relative
+    change, as well as a list of regressions, i.e. totals that grew by more than @a threshold.
+    """
+
+    totals: Dict[str, Dict[str, List[int]]] = {}
+    for test_name, setting, before, after in matched_gas(baseline, current):
+        for category in (category_of(test_name), TOTAL):
+            total = totals.setdefault(category, {}).setdefault(setting, [0, 0])
+            total[0] += before
+            total[1] += after
+
+    differences: Dict[str, Dict[str, dict]] = {}
+    regressions: List[str] = []
+    for category in sorted(totals, key=lambda category: (category == TOTAL, category)):
+        for setting in [setting for setting in SETTINGS if setting in totals[category]]:
+            before, after = totals[category][setting]
+            difference = (after - before) / before if before != 0 else 0.0
+            differences.setdefault(category, {})[setting] = {
+                'baseline': before,
+                'current': after,
+                'difference': difference,
+            }
+            if difference > threshold:
+                regressions.append(f"{category} ({setting}): gas increased by {difference:+.2%}")
+
+    return {
+        'baseline': baseline.get('source'),
+        'current': current.get('source'),
+        'differences': differences,
+        'regressions': regressions,
+    }
+
+
+def format_comparison(comparison: dict, output_format: str) -> str:
+    if output_format == 'json':
+        return json.dumps(comparison, indent=4, sort_keys=True)
+
+    assert output_format in ('console', 'markdown')
+    markdown = (output_format == 'markdown')
+
+    settings = [
+        setting
+        for setting in SETTINGS
+        if any(setting in differences for differences in comparison['differences'].values())
+    ]
+    rows = [
+        [category] + [
+            f"{differences[setting]['difference']:+.2%}" if setting in differences else ''
+            for setting in settings
+        ]
+        for category, differences in comparison['differences'].items()
+    ]
+    header = ['Category'] + settings
+
+    lines = [f"Baseline: {comparison['baseline']}", f"Current:  {comparison['current']}", '']
+    if markdown:
+        lines.append('| ' + ' | '.join(header) + ' |')
+        lines.append('|' + '|'.join(['---'] + ['---:'] * len(settings)) + '|')
+        lines += ['| ' + ' | '.join(row) + ' |' for row in rows]
+    else:
+        widths = [max(len(str(cell)) for cell in column) for column in zip(header, *rows)]
+        for row in [header] + rows:
+            lines.append('  '.join(cell.ljust(width) for cell, width in zip(row, widths)).rstrip())
+
+    lines.append('')
+    if len(comparison['regressions']) == 0:
+        lines.append('No regressions.')
+    else:
+        lines.append('Regressions:')
+        lines += [f"- {regression}" for regression in comparison['regressions']]
+    return '\n'.join(lines)
+
+
+def process_commandline():
+    parser = ArgumentParser(description=__doc__, formatter_class=RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    collect_parser = subparsers.add_parser('collect', help="Collect the gas costs recorded in the semantic tests.")
+    collect_parser.add_argument(
+        '--isoltest',
+        type=Path,
+        help="Record the gas costs by running this isoltest binary instead of reading the test files as they are.",
+    )
+    collect_parser.add_argument('--output', type=Path, help="File to write the report to instead of the standard output.")
+
+    compare_parser = subparsers.add_parser('compare', help="Compare a report against a baseline.")
+    compare_parser.add_argument('baseline', type=Path)
+    compare_parser.add_argument('current', type=Path)
+    compare_parser.add_argument(
+        '--threshold',
+        type=float,
+        default=DEFAULT_THRESHOLD,
+        help="Relative increase of a total that is reported as a regression.",
+    )
+    compare_parser.add_argument('--format', choices=('console', 'markdown', 'json'), default='console')
+
+    return parser.parse_args()
+
+
+def main():
+    try:
+        options = process_commandline()
+
+        if options.command == 'collect':
+            report = json.dumps(
+                collect_report(options.isoltest.resolve() if options.isoltest is not None else None),
+                indent=4,
+                sort_keys=True,
+            )
+            if options.output is not None:
+                options.output.write_text(report + '\n', encoding='utf-8')
+            else:
+                print(report)
+            return 0
+
+        assert options.command == 'compare'
+        comparison = compare_reports(
+            json.loads(options.baseline.read_text(encoding='utf-8')),
+            json.loads(options.current.read_text(encoding='utf-8')),
+            options.threshold,
+        )
+        print(format_comparison(comparison, options.format))
+        return 0 if len(comparison['regressions']) == 0 else 1
+    except (GasReportError, subprocess.CalledProcessError) as exception:
+        print(f"[ERROR] {exception}", file=sys.stderr)
+        return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())
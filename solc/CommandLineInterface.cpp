@@ -32,6 +32,7 @@
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -42,6 +43,7 @@
 #include <libsolidity/lsp/Transport.h>
 
 #include <libyul/YulStack.h>
+#include <libyul/YulString.h>
 
 #include <libevmasm/Disassemble.h>
 
@@ -54,10 +56,15 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <algorithm>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <mutex>
 
 #include <range/v3/view/map.hpp>
 
@@ -92,6 +99,10 @@ std::set<frontend::InputMode> const CompilerInputModes{
 	frontend::InputMode::CompilerWithASTImport,
 };
 
+/// Number of interned Yul strings at which the jobs of --batch are drained, so that the
+/// repository they share can be reset.
+size_t constexpr c_maxYulStringsInBatch = 1 << 20;
+
 } // anonymous namespace
 
 namespace solidity::frontend
@@ -150,6 +161,7 @@ static bool needsHumanTargetedStdout(CommandLineOptions const& _options)
 		_options.compiler.outputs.asmJson ||
 		_options.compiler.outputs.binary ||
 		_options.compiler.outputs.binaryRuntime ||
+		_options.compiler.outputs.binaryRuntimeTemplate ||
 		_options.compiler.outputs.metadata ||
 		_options.compiler.outputs.natspecUser ||
 		_options.compiler.outputs.natspecDev ||
@@ -177,11 +189,7 @@ void CommandLineInterface::handleEVMAssembly(std::string const& _contract)
 	if (!m_options.compiler.outputs.asm_ && !m_options.compiler.outputs.asmJson)
 		return;
 
-	std::string assembly;
-	if (m_options.compiler.outputs.asmJson)
-		assembly = util::jsonPrint(m_assemblyStack->assemblyJSON(_contract), m_options.formatting.json);
-	else
-		assembly = m_assemblyStack->assemblyString(_contract, m_fileReader.sourceUnits());
+	std::string const& assembly = evmOutputs(_contract).assembly;
 
 	if (!m_options.output.dir.empty())
 		createFile(
@@ -201,12 +209,8 @@ void CommandLineInterface::handleBinary(std::string const& _contract)
 		m_options.input.mode == frontend::InputMode::EVMAssemblerJSON
 	);
 
-	std::string binary;
-	std::string binaryRuntime;
-	if (m_options.compiler.outputs.binary)
-		binary = objectWithLinkRefsHex(m_assemblyStack->object(_contract));
-	if (m_options.compiler.outputs.binaryRuntime)
-		binaryRuntime = objectWithLinkRefsHex(m_assemblyStack->runtimeObject(_contract));
+	std::string const& binary = evmOutputs(_contract).binary;
+	std::string const& binaryRuntime = evmOutputs(_contract).binaryRuntime;
 
 	if (m_options.compiler.outputs.binary)
 	{
@@ -228,6 +232,17 @@ void CommandLineInterface::handleBinary(std::string const& _contract)
 			sout() << binaryRuntime << std::endl;
 		}
 	}
+	if (m_options.compiler.outputs.binaryRuntimeTemplate)
+	{
+		std::string const& binaryRuntimeTemplate = evmOutputs(_contract).binaryRuntimeTemplate;
+		if (!m_options.output.dir.empty())
+			createFile(m_assemblyStack->filesystemFriendlyName(_contract) + "_runtime-template.json", binaryRuntimeTemplate);
+		else
+		{
+			sout() << "Binary template of the runtime part:" << std::endl;
+			sout() << binaryRuntimeTemplate << std::endl;
+		}
+	}
 }
 
 void CommandLineInterface::handleOpcode(std::string const& _contract)
@@ -238,7 +253,7 @@ void CommandLineInterface::handleOpcode(std::string const& _contract)
 		m_options.input.mode == frontend::InputMode::EVMAssemblerJSON
 	);
 
-	std::string opcodes{evmasm::disassemble(m_assemblyStack->object(_contract).bytecode, m_options.output.evmVersion)};
+	std::string const& opcodes = evmOutputs(_contract).opcodes;
 
 	if (!m_options.output.dir.empty())
 		createFile(m_assemblyStack->filesystemFriendlyName(_contract) + ".opcode", opcodes);
@@ -368,7 +383,11 @@ void CommandLineInterface::handleBytecode(std::string const& _contract)
 
 	if (m_options.compiler.outputs.opcodes)
 		handleOpcode(_contract);
-	if (m_options.compiler.outputs.binary || m_options.compiler.outputs.binaryRuntime)
+	if (
+		m_options.compiler.outputs.binary ||
+		m_options.compiler.outputs.binaryRuntime ||
+		m_options.compiler.outputs.binaryRuntimeTemplate
+	)
 		handleBinary(_contract);
 }
 
@@ -399,7 +418,7 @@ void CommandLineInterface::handleSignatureHashes(std::string const& _contract)
 	}
 
 	if (!m_options.output.dir.empty())
-		createFile(m_compiler->filesystemFriendlyName(_contract) + ".signatures", out);
+		createFile(m_compiler->filesystemFriendlyName(_contract) + ".signatures", std::move(out));
 	else
 		sout() << out;
 }
@@ -413,7 +432,7 @@ void CommandLineInterface::handleMetadata(std::string const& _contract)
 
 	std::string data = m_compiler->metadata(_contract);
 	if (!m_options.output.dir.empty())
-		createFile(m_compiler->filesystemFriendlyName(_contract) + "_meta.json", data);
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_meta.json", std::move(data));
 	else
 		sout() << "Metadata:" << std::endl << data << std::endl;
 }
@@ -427,7 +446,7 @@ void CommandLineInterface::handleABI(std::string const& _contract)
 
 	std::string data = jsonPrint(removeNullMembers(m_compiler->contractABI(_contract)), m_options.formatting.json);
 	if (!m_options.output.dir.empty())
-		createFile(m_compiler->filesystemFriendlyName(_contract) + ".abi", data);
+		createFile(m_compiler->filesystemFriendlyName(_contract) + ".abi", std::move(data));
 	else
 		sout() << "Contract JSON ABI" << std::endl << data << std::endl;
 }
@@ -441,7 +460,7 @@ void CommandLineInterface::handleStorageLayout(std::string const& _contract)
 
 	std::string data = jsonPrint(removeNullMembers(m_compiler->storageLayout(_contract)), m_options.formatting.json);
 	if (!m_options.output.dir.empty())
-		createFile(m_compiler->filesystemFriendlyName(_contract) + "_storage.json", data);
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_storage.json", std::move(data));
 	else
 		sout() << "Contract Storage Layout:" << std::endl << data << std::endl;
 }
@@ -454,7 +473,7 @@ void CommandLineInterface::handleTransientStorageLayout(std::string const& _cont
 		return;
 	std::string data = jsonPrint(removeNullMembers(m_compiler->transientStorageLayout(_contract)), m_options.formatting.json);
 	if (!m_options.output.dir.empty())
-		createFile(m_compiler->filesystemFriendlyName(_contract) + "_transient_storage.json", data);
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_transient_storage.json", std::move(data));
 	else
 		sout() << "Contract Transient Storage Layout:" << std::endl << data << std::endl;
 }
@@ -492,7 +511,7 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, std::string const& _c
 		);
 
 		if (!m_options.output.dir.empty())
-			createFile(m_compiler->filesystemFriendlyName(_contract) + suffix, output);
+			createFile(m_compiler->filesystemFriendlyName(_contract) + suffix, std::move(output));
 		else
 		{
 			sout() << title << std::endl;
@@ -502,6 +521,75 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, std::string const& _c
 	}
 }
 
+Json CommandLineInterface::runtimeObjectTemplate(std::string const& _contract) const
+{
+	solAssert(m_assemblyStack);
+
+	evmasm::LinkerObject const& object = m_assemblyStack->runtimeObject(_contract);
+	Json output;
+	output["object"] = object.toHex();
+	output["linkReferences"] = StandardCompiler::formatLinkReferences(object.linkReferences);
+	output["immutableReferences"] = StandardCompiler::formatImmutableReferences(object.immutableReferences);
+
+	// The immutables of Solidity contracts are identified by the AST IDs of their declarations.
+	Json immutables = Json::object();
+	if (m_compiler && CompilerInputModes.count(m_options.input.mode) == 1)
+		for (ContractDefinition const* contract: m_compiler->contractDefinition(_contract).annotation().linearizedBaseContracts)
+			for (VariableDeclaration const* variable: contract->stateVariables())
+				if (variable->immutable() && output["immutableReferences"].contains(std::to_string(variable->id())))
+				{
+					Json immutable;
+					immutable["name"] = contract->name() + "." + variable->name();
+					immutable["type"] = variable->type()->toString(true);
+					immutables[std::to_string(variable->id())] = std::move(immutable);
+				}
+	output["immutables"] = std::move(immutables);
+	return output;
+}
+
+CommandLineInterface::EVMOutputs CommandLineInterface::formatEVMOutputs(std::string const& _contract) const
+{
+	solAssert(m_assemblyStack);
+
+	EVMOutputs outputs;
+	if (m_options.compiler.outputs.asmJson)
+		outputs.assembly = util::jsonPrint(m_assemblyStack->assemblyJSON(_contract), m_options.formatting.json);
+	else if (m_options.compiler.outputs.asm_)
+		outputs.assembly = m_assemblyStack->assemblyString(_contract, m_fileReader.sourceUnits());
+	if (m_options.compiler.outputs.binary)
+		outputs.binary = objectWithLinkRefsHex(m_assemblyStack->object(_contract));
+	if (m_options.compiler.outputs.binaryRuntime)
+		outputs.binaryRuntime = objectWithLinkRefsHex(m_assemblyStack->runtimeObject(_contract));
+	if (m_options.compiler.outputs.binaryRuntimeTemplate)
+		outputs.binaryRuntimeTemplate = util::jsonPrint(runtimeObjectTemplate(_contract), m_options.formatting.json);
+	if (m_options.compiler.outputs.opcodes)
+		outputs.opcodes = evmasm::disassemble(m_assemblyStack->object(_contract).bytecode, m_options.output.evmVersion);
+	return outputs;
+}
+
+void CommandLineInterface::prepareEVMOutputs(std::vector<std::string> const& _contracts)
+{
+	if (m_options.output.numThreads <= 1 || _contracts.size() <= 1)
+		return;
+
+	// The assembled objects are no longer modified at this point, so unlike the outputs
+	// that depend on the AST, these can be formatted for several contracts at once.
+	util::ThreadPool threadPool(m_options.output.numThreads);
+	std::vector<std::future<EVMOutputs>> outputs;
+	for (std::string const& contract: _contracts)
+		outputs.emplace_back(threadPool.submit([this, &contract]() { return formatEVMOutputs(contract); }));
+	for (size_t i = 0; i < _contracts.size(); ++i)
+		m_evmOutputs[_contracts[i]] = outputs[i].get();
+}
+
+CommandLineInterface::EVMOutputs const& CommandLineInterface::evmOutputs(std::string const& _contract)
+{
+	auto it = m_evmOutputs.find(_contract);
+	if (it == m_evmOutputs.end())
+		it = m_evmOutputs.emplace(_contract, formatEVMOutputs(_contract)).first;
+	return it->second;
+}
+
 void CommandLineInterface::handleGasEstimation(std::string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -646,6 +734,8 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		!m_options.input.server &&
+		!m_options.input.batch &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -662,18 +752,23 @@ std::map<std::string, Json> CommandLineInterface::parseAstFromInput()
 	for (SourceCode const& sourceCode: m_fileReader.sourceUnits() | ranges::views::values)
 	{
 		Json ast;
-		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
+		if (isJsonBinary(sourceCode))
+			astAssert(jsonParseBinary(sourceCode, ast), "Input file could not be parsed as binary AST");
+		else
+			astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.contains("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
-		for (auto const& [src, value]: ast["sources"].items())
+		// Printed only once per file, before the ASTs are moved out of it.
+		std::string const printedAst = util::jsonCompactPrint(ast);
+		for (auto&& [src, value]: ast["sources"].items())
 		{
 			std::string astKey = value.contains("ast") ? "ast" : "AST";
 
-			astAssert(ast["sources"][src].contains(astKey), "astkey is not member");
-			astAssert(ast["sources"][src][astKey]["nodeType"].get<std::string>() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
+			astAssert(value.contains(astKey), "astkey is not member");
+			astAssert(value[astKey]["nodeType"].get<std::string>() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
 			astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
 			sourceJsons.emplace(src, std::move(value[astKey]));
-			tmpSources[src] = util::jsonCompactPrint(ast);
+			tmpSources[src] = printedAst;
 		}
 	}
 
@@ -682,7 +777,7 @@ std::map<std::string, Json> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(std::string const& _fileName, std::string const& _data)
+void CommandLineInterface::createFile(std::string const& _fileName, std::string _data, bool _binary)
 {
 	namespace fs = boost::filesystem;
 
@@ -694,13 +789,41 @@ void CommandLineInterface::createFile(std::string const& _fileName, std::string
 	fs::create_directories(fs::absolute(m_options.output.dir));
 
 	std::string pathName = (m_options.output.dir / _fileName).string();
-	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
+	// Files of this run may not have reached the disk yet, so they have to be checked separately.
+	bool alreadyCreated = !m_createdFiles.insert(pathName).second;
+	if ((alreadyCreated || fs::exists(pathName)) && !m_options.output.overwriteFiles)
 		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
-	std::ofstream outFile(pathName);
-	outFile << _data;
-	if (!outFile)
-		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
+	if (!m_fileWriter)
+		m_fileWriter = std::make_unique<util::ThreadPool>(1);
+	m_pendingFileWrites.emplace_back(m_fileWriter->submit([pathName, data = std::move(_data), _binary]() {
+		std::ofstream outFile(pathName, _binary ? std::ios::out | std::ios::binary : std::ios::out);
+		outFile.write(data.data(), static_cast<std::streamsize>(data.size()));
+		outFile.close();
+		if (!outFile)
+			solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
+	}));
+}
+
+void CommandLineInterface::finishFileWrites()
+{
+	std::vector<std::future<void>> pendingFileWrites = std::move(m_pendingFileWrites);
+	m_pendingFileWrites.clear();
+
+	// Wait for all writes before reporting the first failure.
+	std::exception_ptr failure;
+	for (std::future<void>& write: pendingFileWrites)
+		try
+		{
+			write.get();
+		}
+		catch (...)
+		{
+			if (!failure)
+				failure = std::current_exception();
+		}
+	if (failure)
+		std::rethrow_exception(failure);
 }
 
 void CommandLineInterface::createJson(std::string const& _fileName, std::string const& _json)
@@ -717,6 +840,7 @@ bool CommandLineInterface::run(int _argc, char const* const* _argv)
 
 		readInputFiles();
 		processInput();
+		finishFileWrites();
 		return true;
 	}
 	catch (CommandLineError const& _exception)
@@ -790,9 +914,24 @@ void CommandLineInterface::processInput()
 		break;
 	case InputMode::StandardJson:
 	{
+		if (m_options.input.server)
+		{
+			serveStandardJson();
+			break;
+		}
+		if (m_options.input.batch)
+		{
+			compileStandardJsonBatch();
+			break;
+		}
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+		compiler.setCacheDirectory(m_options.output.cacheDir);
+		if (m_options.output.stream)
+			compiler.setOutputChunkCallback([&](Json _chunk) {
+				sout() << util::jsonCompactPrint(_chunk) << std::endl;
+			});
 		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
 		m_standardJsonInput.reset();
 		break;
@@ -804,6 +943,11 @@ void CommandLineInterface::processInput()
 		assembleYul(m_options.assembly.inputLanguage, m_options.assembly.targetMachine);
 		break;
 	case InputMode::Linker:
+		if (m_options.linker.linkSetsFile)
+		{
+			linkSets();
+			break;
+		}
 		link();
 		writeLinkedFiles();
 		break;
@@ -867,11 +1011,18 @@ void CommandLineInterface::compile()
 	solAssert(!m_assemblyStack);
 	solAssert(!m_evmAssemblyStack && !m_compiler);
 
+	m_solverCommand.setPersistentProcesses(m_options.modelChecker.persistentSolvers);
+	m_solverCommand.setPersistentCacheDirectory(m_options.output.cacheDir);
 	m_compiler = std::make_unique<CompilerStack>(m_universalCallback.callback());
 	m_assemblyStack = m_compiler.get();
 
 	SourceReferenceFormatter formatter(serr(false), *m_compiler, coloredOutput(m_options), m_options.formatting.withErrorIds);
 
+	std::optional<util::Profiler> profiler;
+	if (m_options.output.profileFile.has_value())
+		profiler.emplace();
+	util::Profiler::Activation profilerActivation(profiler.has_value() ? &profiler.value() : nullptr);
+
 	try
 	{
 		if (m_options.metadata.literalSources)
@@ -883,6 +1034,8 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setNumThreads(m_options.output.numThreads);
+		m_compiler->setCacheDirectory(m_options.output.cacheDir);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -905,6 +1058,7 @@ void CommandLineInterface::compile()
 			m_options.compiler.outputs.opcodes ||
 			m_options.compiler.outputs.binary ||
 			m_options.compiler.outputs.binaryRuntime ||
+			m_options.compiler.outputs.binaryRuntimeTemplate ||
 			(m_options.compiler.combinedJsonRequests && (
 				m_options.compiler.combinedJsonRequests->binary ||
 				m_options.compiler.combinedJsonRequests->binaryRuntime ||
@@ -946,6 +1100,15 @@ void CommandLineInterface::compile()
 
 		bool successful = m_compiler->compile(m_options.output.stopAfter);
 
+		if (profiler.has_value())
+		{
+			std::string pathName = m_options.output.profileFile->string();
+			std::ofstream outFile(pathName);
+			outFile << util::jsonPrint(profiler->chromeTrace(), m_options.formatting.json);
+			if (!outFile)
+				solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
+		}
+
 		for (auto const& error: m_compiler->errors())
 		{
 			m_hasOutput = true;
@@ -982,11 +1145,52 @@ void CommandLineInterface::handleCombinedJSON()
 	output[g_strVersion] = frontend::VersionString;
 	std::vector<std::string> contracts = m_assemblyStack->contractNames();
 
+	// The outputs that only depend on the assembled objects are collected concurrently.
+	// Everything that reads the AST stays on this thread.
+	auto evmData = [&](std::string const& _contractName) {
+		Json contractData = Json::object();
+		if (!m_assemblyStack->compilationSuccessful())
+			return contractData;
+
+		if (m_options.compiler.combinedJsonRequests->binary)
+			contractData[g_strBinary] = m_assemblyStack->object(_contractName).toHex();
+		if (m_options.compiler.combinedJsonRequests->binaryRuntime)
+			contractData[g_strBinaryRuntime] = m_assemblyStack->runtimeObject(_contractName).toHex();
+		if (m_options.compiler.combinedJsonRequests->opcodes)
+			contractData[g_strOpcodes] = evmasm::disassemble(m_assemblyStack->object(_contractName).bytecode, m_options.output.evmVersion);
+		if (m_options.compiler.combinedJsonRequests->asm_)
+			contractData[g_strAsm] = m_assemblyStack->assemblyJSON(_contractName);
+		if (m_options.compiler.combinedJsonRequests->srcMap)
+		{
+			auto map = m_assemblyStack->sourceMapping(_contractName);
+			contractData[g_strSrcMap] = map ? *map : "";
+		}
+		if (m_options.compiler.combinedJsonRequests->srcMapRuntime)
+		{
+			auto map = m_assemblyStack->runtimeSourceMapping(_contractName);
+			contractData[g_strSrcMapRuntime] = map ? *map : "";
+		}
+		if (m_options.compiler.combinedJsonRequests->funDebug)
+			contractData[g_strFunDebug] = StandardCompiler::formatFunctionDebugData(
+				m_assemblyStack->object(_contractName).functionDebugData
+			);
+		if (m_options.compiler.combinedJsonRequests->funDebugRuntime)
+			contractData[g_strFunDebugRuntime] = StandardCompiler::formatFunctionDebugData(
+				m_assemblyStack->runtimeObject(_contractName).functionDebugData
+			);
+		return contractData;
+	};
+	util::ThreadPool threadPool(m_options.output.numThreads > 1 ? m_options.output.numThreads : 0);
+	std::vector<std::future<Json>> evmContractData;
+	for (std::string const& contractName: contracts)
+		evmContractData.emplace_back(threadPool.submit([&evmData, &contractName]() { return evmData(contractName); }));
+
 	if (!contracts.empty())
 		output[g_strContracts] = Json::object();
-	for (std::string const& contractName: contracts)
+	for (size_t i = 0; i < contracts.size(); ++i)
 	{
-		Json& contractData = output[g_strContracts][contractName] = Json::object();
+		std::string const& contractName = contracts[i];
+		Json& contractData = output[g_strContracts][contractName] = evmContractData[i].get();
 
 		// NOTE: The state checks here are more strict that in Standard JSON. There we allow
 		// requesting certain outputs even if compilation fails as long as analysis went ok.
@@ -1011,36 +1215,6 @@ void CommandLineInterface::handleCombinedJSON()
 			if (m_options.compiler.combinedJsonRequests->natspecUser)
 				contractData[g_strNatspecUser] = m_compiler->natspecUser(contractName);
 		}
-
-		if (m_assemblyStack->compilationSuccessful())
-		{
-			if (m_options.compiler.combinedJsonRequests->binary)
-				contractData[g_strBinary] = m_assemblyStack->object(contractName).toHex();
-			if (m_options.compiler.combinedJsonRequests->binaryRuntime)
-				contractData[g_strBinaryRuntime] = m_assemblyStack->runtimeObject(contractName).toHex();
-			if (m_options.compiler.combinedJsonRequests->opcodes)
-				contractData[g_strOpcodes] = evmasm::disassemble(m_assemblyStack->object(contractName).bytecode, m_options.output.evmVersion);
-			if (m_options.compiler.combinedJsonRequests->asm_)
-				contractData[g_strAsm] = m_assemblyStack->assemblyJSON(contractName);
-			if (m_options.compiler.combinedJsonRequests->srcMap)
-			{
-				auto map = m_assemblyStack->sourceMapping(contractName);
-				contractData[g_strSrcMap] = map ? *map : "";
-			}
-			if (m_options.compiler.combinedJsonRequests->srcMapRuntime)
-			{
-				auto map = m_assemblyStack->runtimeSourceMapping(contractName);
-				contractData[g_strSrcMapRuntime] = map ? *map : "";
-			}
-			if (m_options.compiler.combinedJsonRequests->funDebug)
-				contractData[g_strFunDebug] = StandardCompiler::formatFunctionDebugData(
-					m_assemblyStack->object(contractName).functionDebugData
-				);
-			if (m_options.compiler.combinedJsonRequests->funDebugRuntime)
-				contractData[g_strFunDebugRuntime] = StandardCompiler::formatFunctionDebugData(
-					m_assemblyStack->runtimeObject(contractName).functionDebugData
-				);
-		}
 	}
 
 	bool needsSourceList =
@@ -1082,7 +1256,7 @@ void CommandLineInterface::handleAst()
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
 
-	if (!m_options.compiler.outputs.astCompactJson)
+	if (!m_options.compiler.outputs.astCompactJson && !m_options.compiler.outputs.astBinary)
 		return;
 
 	std::vector<ASTNode const*> asts;
@@ -1093,15 +1267,26 @@ void CommandLineInterface::handleAst()
 	{
 		for (auto const& sourceCode: m_fileReader.sourceUnits())
 		{
-			std::stringstream data;
-			std::string postfix = "";
-			ASTJsonExporter(m_compiler->state(), m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first), m_options.formatting.json);
-			postfix += "_json";
 			boost::filesystem::path path(sourceCode.first);
-			createFile(path.filename().string() + postfix + ".ast", data.str());
+			if (m_options.compiler.outputs.astCompactJson)
+			{
+				std::stringstream data;
+				std::string postfix = "";
+				ASTJsonExporter(m_compiler->state(), m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first), m_options.formatting.json);
+				postfix += "_json";
+				createFile(path.filename().string() + postfix + ".ast", data.str());
+			}
+			if (m_options.compiler.outputs.astBinary)
+			{
+				// Uses the layout expected by --import-ast, so that each file can be imported as is.
+				Json sources;
+				sources["sources"][sourceCode.first]["ast"] =
+					ASTJsonExporter(m_compiler->state(), m_compiler->sourceIndices()).toJson(m_compiler->ast(sourceCode.first));
+				createFile(path.filename().string() + "_bin.ast", jsonBinaryPrint(sources), true /* _binary */);
+			}
 		}
 	}
-	else
+	else if (m_options.compiler.outputs.astCompactJson)
 	{
 		sout() << "JSON AST (compact format):" << std::endl << std::endl;
 		for (auto const& sourceCode: m_fileReader.sourceUnits())
@@ -1119,6 +1304,95 @@ void CommandLineInterface::serveLSP()
 		solThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	solAssert(m_options.input.server);
+
+	// A single compiler for all requests, so that optimized Yul objects are reused between them.
+	StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+	compiler.keepYulStringRepository();
+	compiler.setCacheDirectory(m_options.output.cacheDir);
+	lsp::IOStreamTransport transport(m_sin, m_sout);
+	// Peek before receiving, so that closing the input between two requests is not reported as an error.
+	while (m_sin.peek() != std::istream::traits_type::eof())
+	{
+		std::optional<Json> message = transport.receive();
+		if (!message)
+			continue;
+
+		lsp::MessageID id = message->contains("id") ? (*message)["id"] : Json{};
+		if (!message->contains("method") || !(*message)["method"].is_string())
+			transport.error(id, lsp::ErrorCode::ParseError, "\"method\" has to be a string.");
+		else if ((*message)["method"] == "exit")
+			break;
+		else if ((*message)["method"] != "compile")
+			transport.error(id, lsp::ErrorCode::MethodNotFound, "Unknown method " + (*message)["method"].get<std::string>());
+		else if (!message->contains("params") || !(*message)["params"].is_object())
+			transport.error(id, lsp::ErrorCode::InvalidParams, "\"params\" has to be a Standard JSON input object.");
+		else
+		{
+			transport.reply(id, compiler.compile((*message)["params"]));
+			// Requests are handled one at a time, so nothing uses the caches now.
+			compiler.compactCaches();
+		}
+	}
+}
+
+void CommandLineInterface::compileStandardJsonBatch()
+{
+	solAssert(m_options.input.batch);
+
+	// The file reader is not thread-safe, the SMT solver command is.
+	std::mutex fileReaderMutex;
+	ReadCallback::Callback callback = [&, universalCallback = m_universalCallback.callback()](
+		std::string const& _kind,
+		std::string const& _data
+	) {
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+			return universalCallback(_kind, _data);
+		std::lock_guard lock(fileReaderMutex);
+		return universalCallback(_kind, _data);
+	};
+
+	util::ThreadPool threadPool(m_options.output.numThreads);
+	std::deque<std::future<std::string>> outputs;
+	auto printFinishedOutputs = [&](size_t _maxPending) {
+		while (
+			!outputs.empty() &&
+			(outputs.size() > _maxPending || outputs.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		)
+		{
+			sout() << outputs.front().get() << std::endl;
+			outputs.pop_front();
+		}
+	};
+
+	for (std::string line; std::getline(m_sin, line);)
+	{
+		if (boost::trim_copy(line).empty())
+			continue;
+		outputs.emplace_back(threadPool.submit([&callback, cacheDir = m_options.output.cacheDir, input = std::move(line)]() {
+			// Types belong to a single compilation, everything else is shared between the jobs.
+			TypeProvider typeProvider;
+			TypeProvider::Activation typeProviderActivation(&typeProvider);
+			// Compact output, so that every output fits on a single line.
+			StandardCompiler compiler(callback, util::JsonFormat{});
+			compiler.keepYulStringRepository();
+			compiler.setCacheDirectory(cacheDir);
+			return compiler.compile(input);
+		}));
+		// Limits the number of inputs and outputs kept in memory.
+		printFinishedOutputs(2 * m_options.output.numThreads);
+		// The repository is only safe to reset while no job is running.
+		if (yul::YulStringRepository::instance().size() > c_maxYulStringsInBatch)
+		{
+			printFinishedOutputs(0);
+			yul::YulStringRepository::reset();
+		}
+	}
+	printFinishedOutputs(0);
+}
+
 void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker);
@@ -1185,6 +1459,134 @@ void CommandLineInterface::link()
 	m_fileReader.setSourceUnits(std::move(sourceCodes));
 }
 
+namespace
+{
+
+util::h160 parseLinkSetAddress(Json const& _address, std::string const& _libraryName)
+{
+	std::string address = _address.is_string() ? _address.get<std::string>() : "";
+	if (address.size() != 42 || address.substr(0, 2) != "0x" || !util::isValidHex(address))
+		solThrow(CommandLineExecutionError, "Invalid address for library \"" + _libraryName + "\" in --link-sets.");
+	if (!util::passesAddressChecksum(address.substr(2), false))
+		solThrow(
+			CommandLineExecutionError,
+			"Invalid checksum on address for library \"" + _libraryName + "\": " + address + "\n"
+			"The correct checksum is " + util::getChecksummedAddress(address.substr(2))
+		);
+	return util::h160(address, util::h160::FromHex, util::h160::AlignRight);
+}
+
+u256 parseLinkSetImmutable(Json const& _value, std::string const& _identifier)
+{
+	std::string value = _value.is_string() ? _value.get<std::string>() : "";
+	if (value.size() < 3 || value.size() > 66 || value.substr(0, 2) != "0x" || !util::isValidHex(value))
+		solThrow(
+			CommandLineExecutionError,
+			"Invalid value for immutable \"" + _identifier + "\" in --link-sets. Expected a hex string prefixed by 0x of at most 32 bytes."
+		);
+	return u256(value);
+}
+
+/// @returns the object described by a bytecode object of the Standard JSON output.
+evmasm::LinkerObject parseStandardJsonBytecodeObject(Json const& _json)
+{
+	if (!_json.is_object() || !_json.contains("object") || !_json["object"].is_string())
+		solThrow(CommandLineExecutionError, "The input of --link-sets must be a JSON object with the bytecode as \"object\".");
+	std::string hex = _json["object"].get<std::string>();
+	if (hex.substr(0, 2) == "0x")
+		hex = hex.substr(2);
+
+	evmasm::LinkerObject object;
+	auto checkedRange = [&](Json const& _reference, size_t _length) {
+		if (
+			!_reference.is_object() ||
+			!_reference.contains("start") || !_reference["start"].is_number_unsigned() ||
+			_reference.value("length", Json()) != _length ||
+			(_reference["start"].get<size_t>() + _length) * 2 > hex.size()
+		)
+			solThrow(CommandLineExecutionError, "Invalid reference in the input of --link-sets: " + util::jsonCompactPrint(_reference));
+		return _reference["start"].get<size_t>();
+	};
+
+	for (auto const& [file, libraries]: _json.value("linkReferences", Json::object()).items())
+		for (auto const& [library, references]: libraries.items())
+			for (Json const& reference: references)
+			{
+				size_t start = checkedRange(reference, 20);
+				object.linkReferences[start] = file.empty() ? library : file + ":" + library;
+				// The placeholder is not valid hex.
+				std::fill_n(hex.begin() + static_cast<std::ptrdiff_t>(start * 2), 40, '0');
+			}
+	for (auto const& [identifier, references]: _json.value("immutableReferences", Json::object()).items())
+	{
+		evmasm::LinkerObject::ImmutableRefs& immutableRefs = object.immutableReferences[u256(util::keccak256(identifier))];
+		immutableRefs.first = identifier;
+		for (Json const& reference: references)
+			immutableRefs.second.emplace_back(checkedRange(reference, 32));
+	}
+
+	if (hex.size() % 2 != 0 || !util::isValidHex("0x" + hex))
+		solThrow(CommandLineExecutionError, "The bytecode in the input of --link-sets is not valid hex apart from link references.");
+	object.bytecode = util::fromHex(hex);
+	return object;
+}
+
+}
+
+void CommandLineInterface::linkSets()
+{
+	solAssert(m_options.input.mode == InputMode::Linker);
+	solAssert(m_options.linker.linkSetsFile);
+
+	if (m_fileReader.sourceUnits().size() != 1)
+		solThrow(CommandLineValidationError, "Exactly one input file is required together with --link-sets.");
+
+	if (!boost::filesystem::is_regular_file(*m_options.linker.linkSetsFile))
+		solThrow(CommandLineValidationError, '"' + m_options.linker.linkSetsFile->string() + "\" is not a valid file.");
+
+	Json input;
+	Json linkSets;
+	if (!util::jsonParseStrict(m_fileReader.sourceUnits().begin()->second, input))
+		solThrow(CommandLineExecutionError, "The input of --link-sets is not valid JSON.");
+	if (!util::jsonParseStrict(readFileAsString(*m_options.linker.linkSetsFile), linkSets) || !linkSets.is_array())
+		solThrow(CommandLineExecutionError, "The file given to --link-sets must contain a JSON array.");
+
+	// Link the libraries common to all sets only once.
+	evmasm::LinkerObject object = parseStandardJsonBytecodeObject(input);
+	object.link(m_options.linker.libraries);
+
+	Json output = Json::array();
+	for (Json const& linkSet: linkSets)
+	{
+		if (!linkSet.is_object())
+			solThrow(CommandLineExecutionError, "Every entry of --link-sets must be a JSON object.");
+		std::map<std::string, util::h160> libraries;
+		for (auto const& [name, address]: linkSet.value("libraries", Json::object()).items())
+			libraries[name] = parseLinkSetAddress(address, name);
+		std::map<std::string, u256> immutables;
+		for (auto const& [identifier, value]: linkSet.value("immutables", Json::object()).items())
+			immutables[identifier] = parseLinkSetImmutable(value, identifier);
+
+		evmasm::LinkerObject linked;
+		linked.bytecode = object.bytecode;
+		linked.linkReferences = object.linkReferences;
+		linked.immutableReferences = object.immutableReferences;
+		linked.link(libraries);
+		linked.setImmutables(immutables);
+		if (!linked.linkReferences.empty())
+			report(
+				Error::Severity::Warning,
+				fmt::format(
+					"Reference to \"{}\" still unresolved by entry {} of --link-sets.",
+					linked.linkReferences.begin()->second,
+					output.size()
+				)
+			);
+		output.emplace_back(linked.toHex());
+	}
+	sout() << util::jsonPrint(output, m_options.formatting.json) << std::endl;
+}
+
 void CommandLineInterface::writeLinkedFiles()
 {
 	solAssert(m_options.input.mode == InputMode::Linker);
@@ -1236,6 +1638,7 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 				m_options.output.debugInfoSelection.value() :
 				DebugInfoSelection::Default()
 		);
+		stack.setNumThreads(m_options.output.numThreads);
 
 		if (!stack.parseAndAnalyze(src.first, src.second))
 			successful = false;
@@ -1344,14 +1747,16 @@ void CommandLineInterface::outputCompilationResults()
 	// do we need AST output?
 	handleAst();
 
-	CompilerOutputs astOutputSelection;
-	astOutputSelection.astCompactJson = true;
-	if (m_options.compiler.outputs != CompilerOutputs() && m_options.compiler.outputs != astOutputSelection)
+	CompilerOutputs nonAstOutputSelection = m_options.compiler.outputs;
+	nonAstOutputSelection.astCompactJson = false;
+	nonAstOutputSelection.astBinary = false;
+	if (nonAstOutputSelection != CompilerOutputs())
 	{
 		// Currently AST is the only output allowed with --stop-after parsing. For all of the others
 		// we can safely assume that full compilation was performed and successful.
 		solAssert(m_options.output.stopAfter >= CompilerStack::State::CompilationSuccessful);
 
+		prepareEVMOutputs(m_compiler->contractNames());
 		for (std::string const& contract: m_compiler->contractNames())
 		{
 			if (needsHumanTargetedStdout(m_options))
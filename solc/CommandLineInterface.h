@@ -33,9 +33,15 @@
 #include <libsolidity/interface/UniversalCallback.h>
 #include <libyul/YulStack.h>
 
+#include <libsolutil/ThreadPool.h>
+
+#include <future>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -88,7 +94,16 @@ private:
 	void compile();
 	void assembleFromEVMAssemblyJSON();
 	void serveLSP();
+	/// Compiles the Standard JSON inputs that arrive as "compile" requests on standard input
+	/// until it is closed or an "exit" notification is received.
+	void serveStandardJson();
+	/// Compiles the Standard JSON inputs given one per line on standard input on a pool of
+	/// threads and prints their outputs in the order of the inputs.
+	void compileStandardJsonBatch();
 	void link();
+	/// Links a single bytecode object of the Standard JSON output against every set of library
+	/// addresses and immutable values in --link-sets and prints the results.
+	void linkSets();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
 	static std::string libraryPlaceholderHint(std::string const& _libraryName);
@@ -118,16 +133,41 @@ private:
 	void handleStorageLayout(std::string const& _contract);
 	void handleTransientStorageLayout(std::string const& _contract);
 
+	/// Outputs of a contract that are computed from its assembly and bytecode alone and can
+	/// therefore be formatted for all contracts concurrently.
+	struct EVMOutputs
+	{
+		std::string assembly;
+		std::string binary;
+		std::string binaryRuntime;
+		std::string binaryRuntimeTemplate;
+		std::string opcodes;
+	};
+	/// @returns the runtime object of @a _contract in the format of the Standard JSON output,
+	/// together with the names and types of its immutable variables if they are known.
+	Json runtimeObjectTemplate(std::string const& _contract) const;
+	/// Formats the selected EVM outputs of @a _contract. Only reads from the assembly stack.
+	EVMOutputs formatEVMOutputs(std::string const& _contract) const;
+	/// Formats the EVM outputs of all @a _contracts using up to @a m_options.output.numThreads threads.
+	void prepareEVMOutputs(std::vector<std::string> const& _contracts);
+	/// @returns the outputs prepared by prepareEVMOutputs() or formats them if there are none.
+	EVMOutputs const& evmOutputs(std::string const& _contract);
+
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
 	/// such that they can be imported into the compiler  (importASTs())
 	/// (produced by --combined-json ast <file.sol>
 	/// or standard-json output
 	std::map<std::string, Json> parseAstFromInput();
 
-	/// Create a file in the given directory
+	/// Create a file in the given directory. The file is written in the background,
+	/// finishFileWrites() waits for it and reports write errors.
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	/// @arg _binary if true, @a _data is written without newline conversion
+	void createFile(std::string const& _fileName, std::string _data, bool _binary = false);
+	/// Waits until all files passed to createFile() have been written.
+	/// @throws CommandLineOutputError if any of them could not be written.
+	void finishFileWrites();
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -155,6 +195,12 @@ private:
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
 	std::unique_ptr<evmasm::EVMAssemblyStack> m_evmAssemblyStack;
 	evmasm::AbstractAssemblyStack* m_assemblyStack = nullptr;
+	std::map<std::string, EVMOutputs> m_evmOutputs;
+	/// Paths of the files passed to createFile() so far.
+	std::set<std::string> m_createdFiles;
+	std::vector<std::future<void>> m_pendingFileWrites;
+	/// Writes the files created with createFile() on its own thread.
+	std::unique_ptr<util::ThreadPool> m_fileWriter;
 	CommandLineOptions m_options;
 };
 
@@ -42,6 +42,7 @@ namespace solidity::frontend
 
 static std::string const g_strAllowPaths = "allow-paths";
 static std::string const g_strBasePath = "base-path";
+static std::string const g_strBatch = "batch";
 static std::string const g_strIncludePath = "include-path";
 static std::string const g_strAssemble = "assemble";
 static std::string const g_strCombinedJson = "combined-json";
@@ -61,18 +62,22 @@ static std::string const g_strDebugInfo = "debug-info";
 static std::string const g_strIPFS = "ipfs";
 static std::string const g_strLicense = "license";
 static std::string const g_strLibraries = "libraries";
+static std::string const g_strLinkSets = "link-sets";
 static std::string const g_strLink = "link";
 static std::string const g_strLSP = "lsp";
 static std::string const g_strMachine = "machine";
 static std::string const g_strNoCBORMetadata = "no-cbor-metadata";
 static std::string const g_strMetadataHash = "metadata-hash";
 static std::string const g_strMetadataLiteral = "metadata-literal";
+static std::string const g_strModelCheckerCHCThreads = "model-checker-chc-threads";
 static std::string const g_strModelCheckerContracts = "model-checker-contracts";
 static std::string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static std::string const g_strModelCheckerEngine = "model-checker-engine";
 static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
 static std::string const g_strModelCheckerInvariants = "model-checker-invariants";
+static std::string const g_strModelCheckerPersistentSolvers = "model-checker-persistent-solvers";
 static std::string const g_strModelCheckerPrintQuery = "model-checker-print-query";
+static std::string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static std::string const g_strModelCheckerShowProvedSafe = "model-checker-show-proved-safe";
 static std::string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static std::string const g_strModelCheckerShowUnsupported = "model-checker-show-unsupported";
@@ -84,13 +89,21 @@ static std::string const g_strNone = "none";
 static std::string const g_strNoOptimizeYul = "no-optimize-yul";
 static std::string const g_strNoImportCallback = "no-import-callback";
 static std::string const g_strOptimize = "optimize";
+static std::string const g_strOptimizeCallingConvention = "optimize-calling-convention";
+static std::string const g_strOptimizeCodeSizeTarget = "optimize-code-size-target";
+static std::string const g_strOptimizeFunctionExits = "optimize-function-exits";
 static std::string const g_strOptimizeRuns = "optimize-runs";
 static std::string const g_strOptimizeYul = "optimize-yul";
 static std::string const g_strYulOptimizations = "yul-optimizations";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
 static std::string const g_strRevertStrings = "revert-strings";
+static std::string const g_strServer = "server";
 static std::string const g_strStopAfter = "stop-after";
+static std::string const g_strStreamOutput = "stream-output";
+static std::string const g_strThreads = "threads";
+static std::string const g_strCacheDir = "cache-dir";
+static std::string const g_strProfile = "profile";
 static std::string const g_strParsing = "parsing";
 
 /// Possible arguments to for --revert-strings
@@ -231,10 +244,16 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
 		input.noImportCallback == _other.input.noImportCallback &&
+		input.server == _other.input.server &&
+		input.batch == _other.input.batch &&
+		output.stream == _other.output.stream &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.numThreads == _other.output.numThreads &&
+		output.cacheDir == _other.output.cacheDir &&
+		output.profileFile == _other.output.profileFile &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -243,6 +262,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		assembly.targetMachine == _other.assembly.targetMachine &&
 		assembly.inputLanguage == _other.assembly.inputLanguage &&
 		linker.libraries == _other.linker.libraries &&
+		linker.linkSetsFile == _other.linker.linkSetsFile &&
 		formatting.json == _other.formatting.json &&
 		formatting.coloredOutput == _other.formatting.coloredOutput &&
 		formatting.withErrorIds == _other.formatting.withErrorIds &&
@@ -255,9 +275,13 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeEvmasm == _other.optimizer.optimizeEvmasm &&
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
+		optimizer.codeSizeTarget == _other.optimizer.codeSizeTarget &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.optimizeCallingConvention == _other.optimizer.optimizeCallingConvention &&
+		optimizer.optimizeFunctionExits == _other.optimizer.optimizeFunctionExits &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
-		modelChecker.settings == _other.modelChecker.settings;
+		modelChecker.settings == _other.modelChecker.settings &&
+		modelChecker.persistentSolvers == _other.modelChecker.persistentSolvers;
 }
 
 OptimiserSettings CommandLineOptions::optimiserSettings() const
@@ -278,6 +302,9 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 	if (optimizer.expectedExecutionsPerDeployment.has_value())
 		settings.expectedExecutionsPerDeployment = optimizer.expectedExecutionsPerDeployment.value();
 
+	if (optimizer.codeSizeTarget.has_value())
+		settings.codeSizeTarget = optimizer.codeSizeTarget.value();
+
 	if (optimizer.yulSteps.has_value())
 	{
 		std::string const fullSequence = optimizer.yulSteps.value();
@@ -290,6 +317,9 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 			solAssert(settings.yulOptimiserCleanupSteps == OptimiserSettings::DefaultYulOptimiserCleanupSteps);
 	}
 
+	settings.optimizeCallingConvention = optimizer.optimizeCallingConvention;
+	settings.optimizeFunctionExits = optimizer.optimizeFunctionExits;
+
 	return settings;
 }
 
@@ -339,7 +369,25 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJson && m_options.input.server)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"Input files are not accepted in --" + g_strServer + " mode.\n"
+				"Please send the Standard JSON inputs as requests on standard input."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson && m_options.input.batch)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"Input files are not accepted in --" + g_strBatch + " mode.\n"
+				"Please send the Standard JSON inputs on standard input, one per line."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -458,6 +506,13 @@ void CommandLineParser::parseLibraryOption(std::string const& _input)
 		}
 }
 
+void CommandLineParser::parseNumThreads()
+{
+	if (m_args[g_strThreads].as<unsigned>() == 0)
+		solThrow(CommandLineValidationError, "Option --" + g_strThreads + " must be a positive integer.");
+	m_options.output.numThreads = m_args[g_strThreads].as<unsigned>();
+}
+
 void CommandLineParser::parseOutputSelection()
 {
 	static auto outputSupported = [](InputMode _mode, std::string_view _outputName)
@@ -528,6 +583,12 @@ void CommandLineParser::parseOutputSelection()
 			joinOptionNames(unsupportedOutputs) + "."
 		);
 
+	if (m_options.compiler.outputs.astBinary && m_options.output.dir.empty())
+		solThrow(
+			CommandLineValidationError,
+			"Option --" + CompilerOutputs::componentName(&CompilerOutputs::astBinary) + " requires --" + g_strOutputDir + "."
+		);
+
 	// TODO: restrict EOF version to correct EVM version.
 }
 
@@ -632,6 +693,26 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to optimize and generate code for contracts in parallel. "
+			"Code generation is only parallelized when compiling via the IR. The outputs of the contracts "
+			"are formatted in parallel regardless. In assembly mode, the objects of the input are analysed "
+			"and optimized in parallel. The output does not depend on this setting."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Directory in which optimized Yul code and the answers of SMT solvers called by the model checker "
+			"are stored for reuse by later runs of the same compiler version. The output does not depend on this setting."
+		)
+		(
+			g_strProfile.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Write the wall time and memory usage of the compilation phases and optimiser steps "
+			"to the given file, in the Chrome trace event format."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -659,6 +740,24 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			("Used together with --" + g_strStandardJSON + ". Keep running and compile every Standard JSON "
+			"input received on standard input, framed like LSP messages, reusing the optimized Yul code "
+			"between requests.").c_str()
+		)
+		(
+			g_strStreamOutput.c_str(),
+			("Used together with --" + g_strStandardJSON + ". Write the output of every source and contract "
+			"as soon as it is ready, as a separate JSON object on its own line, followed by a line with the "
+			"remaining output. Merging the objects yields the usual output.").c_str()
+		)
+		(
+			g_strBatch.c_str(),
+			("Used together with --" + g_strStandardJSON + ". Read one Standard JSON input per line from "
+			"standard input and write the output of each of them on a line of its own, in the same order. "
+			"Up to --" + g_strThreads + " inputs are compiled at the same time.").c_str()
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -714,6 +813,14 @@ General Information)").c_str(),
 			"<libraryName>=<address> [, or whitespace] ...\n"
 			"Address is interpreted as a hex string prefixed by 0x."
 		)
+		(
+			g_strLinkSets.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"JSON file with an array of objects, each with the library addresses under \"libraries\" and "
+			"the values of immutables under \"immutables\". Links the single input, a bytecode object of the "
+			"Standard JSON output with its \"linkReferences\" and \"immutableReferences\", against every "
+			"set in one go and prints the array of linked objects instead of modifying the input."
+		)
 	;
 	desc.add(linkerModeOptions);
 
@@ -746,11 +853,21 @@ General Information)").c_str(),
 	po::options_description outputComponents("Output Components");
 	outputComponents.add_options()
 		(CompilerOutputs::componentName(&CompilerOutputs::astCompactJson).c_str(), "AST of all source files in a compact JSON format.")
+		(
+			CompilerOutputs::componentName(&CompilerOutputs::astBinary).c_str(),
+			"AST of all source files in a binary encoding of the compact JSON format, which can be "
+			"imported with --import-ast. Requires --output-dir."
+		)
 		(CompilerOutputs::componentName(&CompilerOutputs::asm_).c_str(), "EVM assembly of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::asmJson).c_str(), "EVM assembly of the contracts in JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::opcodes).c_str(), "Opcodes of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::binary).c_str(), "Binary of the contracts in hex.")
 		(CompilerOutputs::componentName(&CompilerOutputs::binaryRuntime).c_str(), "Binary of the runtime part of the contracts in hex.")
+		(
+			CompilerOutputs::componentName(&CompilerOutputs::binaryRuntimeTemplate).c_str(),
+			"Binary of the runtime part of the contracts as a JSON object with the positions, names and types "
+			"of its immutable variables and library addresses, which can be filled in with --link-sets."
+		)
 		(CompilerOutputs::componentName(&CompilerOutputs::abi).c_str(), "ABI specification of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::ir).c_str(), "Intermediate Representation (IR) of all contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::irAstJson).c_str(), "AST of Intermediate Representation (IR) of all contracts in a compact JSON format.")
@@ -815,6 +932,13 @@ General Information)").c_str(),
 			"The number of runs specifies roughly how often each opcode of the deployed code will be executed across the lifetime of the contract. "
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
+		(
+			g_strOptimizeCodeSizeTarget.c_str(),
+			po::value<unsigned>()->value_name("bytes"),
+			("Size of the deployed code in bytes that each contract should not exceed (e.g. 24576). "
+			"If it does, the contract is compiled again with the largest number of runs up to --" +
+			g_strOptimizeRuns + " that meets the target.").c_str()
+		)
 		(
 			g_strOptimizeYul.c_str(),
 			("Enable Yul optimizer (independently of the EVM assembly optimizer). "
@@ -830,6 +954,16 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strOptimizeCallingConvention.c_str(),
+			("Choose for each Yul function whether its return label is pushed before or after its arguments "
+			"to reduce stack shuffling. Requires the Yul optimizer (--" + g_strOptimizeYul + ").").c_str()
+		)
+		(
+			g_strOptimizeFunctionExits.c_str(),
+			("Jump directly to Yul functions whose results are returned by the caller and share identical "
+			"function exits. Requires the Yul optimizer (--" + g_strOptimizeYul + ").").c_str()
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -865,10 +999,20 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerPersistentSolvers.c_str(),
+			"Keep the processes of solvers called via SMT-LIB2 alive between queries instead of"
+			" starting a new process for every query. Currently only supported for z3."
+		)
 		(
 			g_strModelCheckerPrintQuery.c_str(),
 			"Print the queries created by the SMTChecker in the SMTLIB2 format."
 		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run the selected solvers of the BMC engine in parallel and use the first conclusive answer,"
+			" interrupting the others, instead of running them one after the other."
+		)
 		(
 			g_strModelCheckerShowProvedSafe.c_str(),
 			"Show all targets that were proved safe separately."
@@ -906,6 +1050,13 @@ General Information)").c_str(),
 			"Set loop unrolling depth for BMC engine."
 			"Default is 1."
 		)
+		(
+			g_strModelCheckerCHCThreads.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Send up to n queries of the CHC engine to the solver at the same time."
+			" Only applies to solvers called via SMT-LIB2. The results are reported in the same order as with 1,"
+			" which is the default."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1004,14 +1155,27 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strServer, {InputMode::StandardJson}},
+		{g_strStreamOutput, {InputMode::StandardJson}},
+		{g_strBatch, {InputMode::StandardJson}},
+		{g_strLinkSets, {InputMode::Linker}},
+		{g_strThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler}},
+		{g_strCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson}},
+		{g_strOptimizeCodeSizeTarget, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strOptimizeCallingConvention, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler}},
+		{g_strOptimizeFunctionExits, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler}},
+		{g_strProfile, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCHCThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerPersistentSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerPrintQuery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerRaceSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowProvedSafe, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnsupported, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1021,6 +1185,9 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
 	};
+	// Determines how many Standard JSON inputs of a batch are compiled at the same time.
+	if (m_args.count(g_strBatch))
+		validOptionInputModeCombinations[g_strThreads].insert(InputMode::StandardJson);
 	std::vector<std::string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
 	{
@@ -1046,7 +1213,10 @@ void CommandLineParser::processArgs()
 	checkMutuallyExclusive({g_strStopAfter, g_strGas});
 
 	for (std::string const& option: CompilerOutputs::componentMap() | ranges::views::keys)
-		if (option != CompilerOutputs::componentName(&CompilerOutputs::astCompactJson))
+		if (
+			option != CompilerOutputs::componentName(&CompilerOutputs::astCompactJson) &&
+			option != CompilerOutputs::componentName(&CompilerOutputs::astBinary)
+		)
 			checkMutuallyExclusive({g_strStopAfter, option});
 
 	if (m_options.input.mode == InputMode::EVMAssemblerJSON)
@@ -1178,6 +1348,25 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strNoImportCallback))
 		m_options.input.noImportCallback = true;
 
+	if (m_args.count(g_strServer))
+		m_options.input.server = true;
+
+	checkMutuallyExclusive({g_strServer, g_strStreamOutput, g_strBatch});
+	if (m_args.count(g_strStreamOutput))
+	{
+		// Every streamed chunk has to fit on a single line.
+		if (m_options.formatting.json.format == util::JsonFormat::Pretty)
+			solThrow(
+				CommandLineValidationError,
+				"Option --" + g_strStreamOutput + " cannot be used together with --" + g_strPrettyJson +
+				" or --" + g_strJsonIndent + "."
+			);
+		m_options.output.stream = true;
+	}
+
+	if (m_args.count(g_strBatch))
+		m_options.input.batch = true;
+
 	if (m_args.count(g_strAllowPaths))
 	{
 		std::vector<std::string> paths;
@@ -1197,14 +1386,22 @@ void CommandLineParser::processArgs()
 	parseInputPathsAndRemappings();
 
 	if (m_options.input.mode == InputMode::StandardJson)
+	{
+		if (m_options.input.batch)
+			parseNumThreads();
 		return;
+	}
 
 	if (m_args.count(g_strLibraries))
 		for (std::string const& library: m_args[g_strLibraries].as<std::vector<std::string>>())
 			parseLibraryOption(library);
 
 	if (m_options.input.mode == InputMode::Linker)
+	{
+		if (m_args.count(g_strLinkSets))
+			m_options.linker.linkSetsFile = m_args[g_strLinkSets].as<std::string>();
 		return;
+	}
 
 	if (m_args.count(g_strEVMVersion))
 	{
@@ -1237,6 +1434,17 @@ void CommandLineParser::processArgs()
 	);
 	if (!m_args[g_strOptimizeRuns].defaulted())
 		m_options.optimizer.expectedExecutionsPerDeployment = m_args.at(g_strOptimizeRuns).as<unsigned>();
+	if (m_args.count(g_strOptimizeCodeSizeTarget))
+		m_options.optimizer.codeSizeTarget = m_args.at(g_strOptimizeCodeSizeTarget).as<unsigned>();
+
+	for (std::string const& option: {g_strOptimizeCallingConvention, g_strOptimizeFunctionExits})
+		if (m_args.count(option) > 0 && !m_options.optimizer.optimizeYul)
+			solThrow(
+				CommandLineValidationError,
+				"Option --" + option + " requires the Yul optimizer to be enabled."
+			);
+	m_options.optimizer.optimizeCallingConvention = (m_args.count(g_strOptimizeCallingConvention) > 0);
+	m_options.optimizer.optimizeFunctionExits = (m_args.count(g_strOptimizeFunctionExits) > 0);
 
 	if (m_args.count(g_strYulOptimizations))
 	{
@@ -1312,6 +1520,7 @@ void CommandLineParser::processArgs()
 				CommandLineValidationError,
 				"Optimizer can only be used for strict assembly. Use --"  + g_strStrictAssembly + "."
 			);
+		parseNumThreads();
 		return;
 	}
 	else if (countEnabledOptions({g_strYulDialect, g_strMachine}) >= 1)
@@ -1387,6 +1596,11 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	m_options.modelChecker.persistentSolvers = (m_args.count(g_strModelCheckerPersistentSolvers) > 0);
+
+	if (m_args.count(g_strModelCheckerRaceSolvers))
+		m_options.modelChecker.settings.raceSolvers = true;
+
 	if (m_args.count(g_strModelCheckerShowProvedSafe))
 		m_options.modelChecker.settings.showProvedSafe = true;
 
@@ -1431,13 +1645,22 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.bmcLoopIterations = m_args[g_strModelCheckerBMCLoopIterations].as<unsigned>();
 	}
 
+	if (m_args.count(g_strModelCheckerCHCThreads))
+	{
+		if (m_args[g_strModelCheckerCHCThreads].as<unsigned>() == 0)
+			solThrow(CommandLineValidationError, "Option --" + g_strModelCheckerCHCThreads + " must be a positive integer.");
+		m_options.modelChecker.settings.chcThreads = m_args[g_strModelCheckerCHCThreads].as<unsigned>();
+	}
+
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerCHCThreads) ||
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerRaceSolvers) ||
 		m_args.count(g_strModelCheckerShowProvedSafe) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerShowUnsupported) ||
@@ -1446,6 +1669,22 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
+	parseNumThreads();
+
+	if (m_args.count(g_strCacheDir))
+	{
+		if (m_args[g_strCacheDir].as<std::string>().empty())
+			solThrow(CommandLineValidationError, "Option --" + g_strCacheDir + " must not be empty.");
+		m_options.output.cacheDir = m_args[g_strCacheDir].as<std::string>();
+	}
+
+	if (m_args.count(g_strProfile))
+	{
+		if (m_args[g_strProfile].as<std::string>().empty())
+			solThrow(CommandLineValidationError, "Option --" + g_strProfile + " must not be empty.");
+		m_options.output.profileFile = m_args[g_strProfile].as<std::string>();
+	}
+
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
 		m_options.input.mode == InputMode::CompilerWithASTImport ||
@@ -71,11 +71,13 @@ struct CompilerOutputs
 	{
 		static std::map<std::string, bool CompilerOutputs::*> const components = {
 			{"ast-compact-json", &CompilerOutputs::astCompactJson},
+			{"ast-binary", &CompilerOutputs::astBinary},
 			{"asm", &CompilerOutputs::asm_},
 			{"asm-json", &CompilerOutputs::asmJson},
 			{"opcodes", &CompilerOutputs::opcodes},
 			{"bin", &CompilerOutputs::binary},
 			{"bin-runtime", &CompilerOutputs::binaryRuntime},
+			{"bin-runtime-template", &CompilerOutputs::binaryRuntimeTemplate},
 			{"abi", &CompilerOutputs::abi},
 			{"ir", &CompilerOutputs::ir},
 			{"ir-ast-json", &CompilerOutputs::irAstJson},
@@ -110,6 +112,8 @@ struct CompilerOutputs
 	bool metadata = false;
 	bool storageLayout = false;
 	bool transientStorageLayout = false;
+	bool astBinary = false;
+	bool binaryRuntimeTemplate = false;
 };
 
 struct CombinedJsonRequests
@@ -182,6 +186,10 @@ struct CommandLineOptions
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
 		bool noImportCallback = false;
+		/// Keep compiling Standard JSON inputs received as requests until the input is closed.
+		bool server = false;
+		/// Compile Standard JSON inputs given one per line, several of them at the same time.
+		bool batch = false;
 	} input;
 
 	struct
@@ -190,10 +198,15 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
+		size_t numThreads = 1;
+		std::optional<boost::filesystem::path> cacheDir;
+		std::optional<boost::filesystem::path> profileFile;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
 		std::optional<uint8_t> eofVersion;
+		/// Write the Standard JSON output in chunks, one line per source and contract.
+		bool stream = false;
 	} output;
 
 	struct
@@ -205,6 +218,8 @@ struct CommandLineOptions
 	struct
 	{
 		std::map<std::string, util::h160> libraries; // library name -> address
+		/// File with the sets of library addresses and immutable values to link the input against.
+		std::optional<boost::filesystem::path> linkSetsFile;
 	} linker;
 
 	struct
@@ -233,13 +248,18 @@ struct CommandLineOptions
 		bool optimizeEvmasm = false;
 		bool optimizeYul = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
+		std::optional<unsigned> codeSizeTarget;
 		std::optional<std::string> yulSteps;
+		bool optimizeCallingConvention = false;
+		bool optimizeFunctionExits = false;
 	} optimizer;
 
 	struct
 	{
 		bool initialize = false;
 		ModelCheckerSettings settings;
+		/// Reuse the processes of solvers called via SMT-LIB2 between queries.
+		bool persistentSolvers = false;
 	} modelChecker;
 };
 
@@ -291,6 +311,10 @@ private:
 
 	void parseOutputSelection();
 
+	/// Parses the value supplied to --threads.
+	/// @throws CommandLineValidationError in case of validation errors.
+	void parseNumThreads();
+
 	void checkMutuallyExclusive(std::vector<std::string> const& _optionNames);
 	size_t countEnabledOptions(std::vector<std::string> const& _optionNames) const;
 	static std::string joinOptionNames(std::vector<std::string> const& _optionNames, std::string _separator = ", ");
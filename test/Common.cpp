@@ -22,6 +22,9 @@
 #include <test/EVMHost.h>
 #include <test/libsolidity/util/SoltestErrors.h>
 
+#include <libyul/optimiser/Suite.h>
+#include <libyul/Exceptions.h>
+
 #include <libsolutil/Assertions.h>
 #include <libsolutil/StringUtils.h>
 #include <boost/algorithm/string.hpp>
@@ -116,6 +119,7 @@ void CommonOptions::addOptions()
 		("optimize", po::bool_switch(&optimize)->default_value(optimize), "enables optimization")
 		("enforce-gas-cost", po::value<bool>(&enforceGasTest)->default_value(enforceGasTest)->implicit_value(true), "Enforce checking gas cost in semantic tests.")
 		("enforce-gas-cost-min-value", po::value(&enforceGasTestMinValue)->default_value(enforceGasTestMinValue), "Threshold value to enforce adding gas checks to a test.")
+		("yul-optimizations", po::value(&yulOptimiserSteps), "Yul optimizer sequence to use instead of the built-in one when optimizing, in the format of solc --yul-optimizations.")
 		("abiencoderv1", po::bool_switch(&useABIEncoderV1)->default_value(useABIEncoderV1), "enables abi encoder v1")
 		("show-messages", po::bool_switch(&showMessages)->default_value(showMessages), "enables message output")
 		("show-metadata", po::bool_switch(&showMetadata)->default_value(showMetadata), "enables metadata output");
@@ -144,15 +148,29 @@ void CommonOptions::validate() const
 		"Selected batch has to be less than number of batches."
 	);
 
+	if (!yulOptimiserSteps.empty())
+	{
+		try
+		{
+			yul::OptimiserSuite::validateSequence(yulOptimiserSteps);
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			solThrow(ConfigException, std::string("Invalid optimizer step sequence in --yul-optimizations: ") + _exception.what());
+		}
+	}
+
 	if (!enforceGasTest)
 		std::cout << std::endl << "WARNING :: Gas cost expectations are not being enforced" << std::endl << std::endl;
-	else if (evmVersion() != langutil::EVMVersion{} || useABIEncoderV1)
+	else if (evmVersion() != langutil::EVMVersion{} || useABIEncoderV1 || !yulOptimiserSteps.empty())
 	{
 		std::cout << std::endl << "WARNING :: Enforcing gas cost expectations with non-standard settings:" << std::endl;
 		if (evmVersion() != langutil::EVMVersion{})
 			std::cout << "- EVM version: " << evmVersion().name() << " (default: " << langutil::EVMVersion{}.name() << ")" << std::endl;
 		if (useABIEncoderV1)
 			std::cout << "- ABI coder: v1 (default: v2)" << std::endl;
+		if (!yulOptimiserSteps.empty())
+			std::cout << "- Yul optimizer sequence: " << yulOptimiserSteps << std::endl;
 		std::cout << std::endl << "DO NOT COMMIT THE UPDATED EXPECTATIONS." << std::endl << std::endl;
 	}
 
@@ -61,6 +61,9 @@ struct CommonOptions
 	bool useABIEncoderV1 = false;
 	bool showMessages = false;
 	bool showMetadata = false;
+	/// Yul optimiser sequence to use instead of the default one when optimizing, in the format
+	/// of the --yul-optimizations option of solc. Empty to use the default sequence.
+	std::string yulOptimiserSteps;
 	size_t batches = 1;
 	size_t selectedBatch = 0;
 
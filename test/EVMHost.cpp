@@ -29,8 +29,11 @@
 #include <libsolutil/Exceptions.h>
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Visitor.h>
 #include <libsolutil/picosha2.h>
 
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::test;
@@ -40,6 +43,9 @@ evmc::VM& EVMHost::getVM(std::string const& _path)
 {
 	static evmc::VM NullVM{nullptr};
 	static std::map<std::string, std::unique_ptr<evmc::VM>> vms;
+	// Test cases running on different threads share the loaded VMs.
+	static std::mutex vmsMutex;
+	std::lock_guard lock(vmsMutex);
 	if (vms.count(_path) == 0)
 	{
 		evmc_loader_error_code errorCode = {};
@@ -161,6 +167,8 @@ void EVMHost::reset()
 	recorded_selfdestructs.clear();
 	// Clear call records
 	recorded_calls.clear();
+	// Clear logs
+	recorded_logs.clear();
 	// Clear EIP-2929 account access indicator
 	recorded_account_accesses.clear();
 	m_newlyCreatedAccounts.clear();
@@ -211,11 +219,64 @@ void EVMHost::newTransactionFrame()
 	recorded_selfdestructs.clear();
 }
 
-void EVMHost::transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept
+evmc::MockedAccount& EVMHost::journaledAccount(evmc::address const& _addr)
+{
+	auto [account, inserted] = accounts.try_emplace(_addr);
+	if (inserted)
+		m_journal.emplace_back(AccountCreated{_addr});
+	return account->second;
+}
+
+void EVMHost::journalStorage(evmc::address const& _addr, evmc::bytes32 const& _key)
+{
+	StorageMap const& storage = journaledAccount(_addr).storage;
+	auto slot = storage.find(_key);
+	m_journal.emplace_back(StorageChanged{
+		_addr,
+		_key,
+		slot == storage.end() ? std::nullopt : std::make_optional(slot->second)
+	});
+}
+
+void EVMHost::revertJournal(size_t _size)
+{
+	solAssert(_size <= m_journal.size());
+	for (; m_journal.size() > _size; m_journal.pop_back())
+		std::visit(util::GenericVisitor{
+			[&](AccountCreated const& _entry) { accounts.erase(_entry.address); },
+			[&](BalanceChanged const& _entry) { accounts.at(_entry.address).balance = _entry.previous; },
+			[&](NonceChanged const& _entry) { accounts.at(_entry.address).nonce = _entry.previous; },
+			[&](CodeChanged& _entry) {
+				evmc::MockedAccount& account = accounts.at(_entry.address);
+				account.code = std::move(_entry.previousCode);
+				account.codehash = _entry.previousCodeHash;
+			},
+			[&](StorageChanged const& _entry) {
+				StorageMap& storage = accounts.at(_entry.address).storage;
+				if (_entry.previous)
+					storage[_entry.key] = *_entry.previous;
+				else
+					storage.erase(_entry.key);
+			},
+			[&](TransientStorageChanged const& _entry) {
+				auto& storage = accounts.at(_entry.address).transient_storage;
+				if (_entry.previous)
+					storage[_entry.key] = *_entry.previous;
+				else
+					storage.erase(_entry.key);
+			}
+		}, m_journal.back());
+}
+
+void EVMHost::transfer(evmc::address const& _sender, evmc::address const& _recipient, u256 const& _value) noexcept
 {
-	assertThrow(u256(convertFromEVMC(_sender.balance)) >= _value, Exception, "Insufficient balance for transfer");
-	_sender.balance = convertToEVMC(u256(convertFromEVMC(_sender.balance)) - _value);
-	_recipient.balance = convertToEVMC(u256(convertFromEVMC(_recipient.balance)) + _value);
+	evmc::MockedAccount& sender = journaledAccount(_sender);
+	evmc::MockedAccount& recipient = journaledAccount(_recipient);
+	assertThrow(u256(convertFromEVMC(sender.balance)) >= _value, Exception, "Insufficient balance for transfer");
+	m_journal.emplace_back(BalanceChanged{_sender, sender.balance});
+	sender.balance = convertToEVMC(u256(convertFromEVMC(sender.balance)) - _value);
+	m_journal.emplace_back(BalanceChanged{_recipient, recipient.balance});
+	recipient.balance = convertToEVMC(u256(convertFromEVMC(recipient.balance)) + _value);
 }
 
 bool EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _beneficiary) noexcept
@@ -224,12 +285,44 @@ bool EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _ben
 
 	// NOTE: EIP-6780: The transfer of the entire account balance to the beneficiary should still happen
 	// after cancun.
-	transfer(accounts[_addr], accounts[_beneficiary], convertFromEVMC(accounts[_addr].balance));
+	transfer(_addr, _beneficiary, convertFromEVMC(journaledAccount(_addr).balance));
 
 	// Record self destructs. Clearing will be done in newTransactionFrame().
 	return MockedHost::selfdestruct(_addr, _beneficiary);
 }
 
+evmc_storage_status EVMHost::set_storage(
+	evmc::address const& _addr,
+	evmc::bytes32 const& _key,
+	evmc::bytes32 const& _value
+) noexcept
+{
+	journalStorage(_addr, _key);
+	return MockedHost::set_storage(_addr, _key, _value);
+}
+
+evmc_access_status EVMHost::access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept
+{
+	journalStorage(_addr, _key);
+	return MockedHost::access_storage(_addr, _key);
+}
+
+void EVMHost::set_transient_storage(
+	evmc::address const& _addr,
+	evmc::bytes32 const& _key,
+	evmc::bytes32 const& _value
+) noexcept
+{
+	auto const& storage = journaledAccount(_addr).transient_storage;
+	auto slot = storage.find(_key);
+	m_journal.emplace_back(TransientStorageChanged{
+		_addr,
+		_key,
+		slot == storage.end() ? std::nullopt : std::make_optional(slot->second)
+	});
+	MockedHost::set_transient_storage(_addr, _key, _value);
+}
+
 void EVMHost::recordCalls(evmc_message const& _message) noexcept
 {
 	if (recorded_calls.size() < max_recorded_calls)
@@ -275,10 +368,16 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 	else if (_message.recipient == 0x0000000000000000000000000000000000000009_address && m_evmVersion >= langutil::EVMVersion::istanbul())
 		return precompileBlake2f(_message);
 
-	auto const stateBackup = accounts;
+	// Changes are recorded in the journal, so that they can be reverted if the call fails.
+	// The journal is only needed until the end of the transaction.
+	size_t const journalSize = m_journal.size();
+	ScopeGuard clearJournal([&] {
+		if (_message.depth == 0)
+			m_journal.clear();
+	});
 
 	u256 value{convertFromEVMC(_message.value)};
-	auto& sender = accounts[_message.sender];
+	auto& sender = journaledAccount(_message.sender);
 
 	evmc::bytes code;
 
@@ -292,7 +391,7 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::Result result;
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertJournal(journalSize);
 			return result;
 		}
 	}
@@ -302,6 +401,7 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		// TODO is the nonce incremented on failure, too?
 		// NOTE: nonce for creation from contracts starts at 1
 		// TODO: check if sender is an EOA and do not pre-increment
+		m_journal.emplace_back(NonceChanged{_message.sender, sender.nonce});
 		sender.nonce++;
 
 		auto encodeRlpInteger = [](int value) -> bytes {
@@ -349,16 +449,16 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::Result result;
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertJournal(journalSize);
 			return result;
 		}
 
 		code = evmc::bytes(message.input_data, message.input_data + message.input_size);
 	}
 	else
-		code = accounts[message.code_address].code;
+		code = journaledAccount(message.code_address).code;
 
-	auto& destination = accounts[message.recipient];
+	auto& destination = journaledAccount(message.recipient);
 	if (message.kind == EVMC_CREATE || message.kind == EVMC_CREATE2)
 		// Mark account as created if it is a CREATE or CREATE2 call
 		// TODO: Should we roll changes back on failure like we do for `accounts`?
@@ -370,10 +470,10 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::Result result;
 			result.status_code = EVMC_INSUFFICIENT_BALANCE;
-			accounts = stateBackup;
+			revertJournal(journalSize);
 			return result;
 		}
-		transfer(sender, destination, value);
+		transfer(message.sender, message.recipient, value);
 	}
 
 	// Populate the access access list (enabled since Berlin).
@@ -411,13 +511,14 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			m_totalCodeDepositGas += codeDepositGas;
 			result.create_address = message.recipient;
+			m_journal.emplace_back(CodeChanged{message.recipient, std::move(destination.code), destination.codehash});
 			destination.code = evmc::bytes(result.output_data, result.output_data + result.output_size);
 			destination.codehash = convertToEVMC(keccak256({result.output_data, result.output_size}));
 		}
 	}
 
 	if (result.status_code != EVMC_SUCCESS)
-		accounts = stateBackup;
+		revertJournal(journalSize);
 
 	return result;
 }
@@ -32,7 +32,9 @@
 
 #include <boost/filesystem.hpp>
 
-#include<unordered_set>
+#include <optional>
+#include <unordered_set>
+#include <variant>
 
 namespace solidity::test
 {
@@ -50,7 +52,6 @@ public:
 	// Verbatim features of MockedHost.
 	using MockedHost::account_exists;
 	using MockedHost::get_storage;
-	using MockedHost::set_storage;
 	using MockedHost::get_balance;
 	using MockedHost::get_code_size;
 	using MockedHost::get_code_hash;
@@ -58,10 +59,20 @@ public:
 	using MockedHost::get_tx_context;
 	using MockedHost::emit_log;
 	using MockedHost::access_account;
-	using MockedHost::access_storage;
 
 	// Modified features of MockedHost.
 	bool selfdestruct(evmc::address const& _addr, evmc::address const& _beneficiary) noexcept final;
+	evmc_storage_status set_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final;
+	evmc_access_status access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept final;
+	void set_transient_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final;
 	evmc::Result call(evmc_message const& _message) noexcept final;
 	evmc::bytes32 get_block_hash(int64_t number) const noexcept final;
 
@@ -101,8 +112,32 @@ public:
 	static util::h256 convertFromEVMC(evmc::bytes32 const& _data);
 	static evmc::bytes32 convertToEVMC(util::h256 const& _data);
 private:
+	/// Entries of the journal of changes to the accounts. Each entry stores what is needed to undo the change.
+	struct AccountCreated { evmc::address address; };
+	struct BalanceChanged { evmc::address address; evmc::uint256be previous; };
+	struct NonceChanged { evmc::address address; int previous; };
+	struct CodeChanged { evmc::address address; evmc::bytes previousCode; evmc::bytes32 previousCodeHash; };
+	/// The previous value is empty if there was no entry for the key.
+	struct StorageChanged { evmc::address address; evmc::bytes32 key; std::optional<evmc::StorageValue> previous; };
+	struct TransientStorageChanged { evmc::address address; evmc::bytes32 key; std::optional<evmc::bytes32> previous; };
+	using JournalEntry = std::variant<
+		AccountCreated,
+		BalanceChanged,
+		NonceChanged,
+		CodeChanged,
+		StorageChanged,
+		TransientStorageChanged
+	>;
+
+	/// @returns the account at @param _addr and records its creation in the journal if it did not exist.
+	evmc::MockedAccount& journaledAccount(evmc::address const& _addr);
+	/// Records the current value of the storage slot @param _key of @param _addr in the journal.
+	void journalStorage(evmc::address const& _addr, evmc::bytes32 const& _key);
+	/// Undoes all changes recorded in the journal after its first @param _size entries.
+	void revertJournal(size_t _size);
+
 	/// Transfer value between accounts. Checks for sufficient balance.
-	void transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept;
+	void transfer(evmc::address const& _sender, evmc::address const& _recipient, u256 const& _value) noexcept;
 
 	/// Start a new transaction frame.
 	/// This will perform selfdestructs, apply storage status changes across all accounts,
@@ -140,6 +175,10 @@ private:
 	/// Store the accounts that have been created in the current transaction.
 	std::unordered_set<evmc::address> m_newlyCreatedAccounts;
 
+	/// Changes to the accounts made by the current transaction. A failing call reverts
+	/// the changes made since it started instead of restoring a copy of all accounts.
+	std::vector<JournalEntry> m_journal;
+
 	/// The part of the total cost of the current transaction that paid for the code deposits.
 	/// I.e. GAS_CODE_DEPOSIT times the total size of deployed code of all newly created contracts,
 	/// including the current contract itself if it was a creation transaction.
@@ -58,10 +58,24 @@ ExecutionFramework::ExecutionFramework(langutil::EVMVersion _evmVersion, std::ve
 	m_vmPaths(_vmPaths)
 {
 	if (solidity::test::CommonOptions::get().optimize)
-		m_optimiserSettings = solidity::frontend::OptimiserSettings::standard();
+		m_optimiserSettings = fullOptimiserSettings();
 	selectVM(evmc_capabilities::EVMC_CAPABILITY_EVM1);
 }
 
+solidity::frontend::OptimiserSettings ExecutionFramework::fullOptimiserSettings()
+{
+	solidity::frontend::OptimiserSettings settings = solidity::frontend::OptimiserSettings::full();
+	std::string const& sequence = solidity::test::CommonOptions::get().yulOptimiserSteps;
+	if (!sequence.empty())
+	{
+		auto const delimiterPos = sequence.find(":");
+		settings.yulOptimiserSteps = sequence.substr(0, delimiterPos);
+		if (delimiterPos != std::string::npos)
+			settings.yulOptimiserCleanupSteps = sequence.substr(delimiterPos + 1);
+	}
+	return settings;
+}
+
 void ExecutionFramework::selectVM(evmc_capabilities _cap)
 {
 	m_evmcHost.reset();
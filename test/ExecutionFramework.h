@@ -274,6 +274,10 @@ private:
 protected:
 	u256 const InitialGas = 100000000;
 
+	/// @returns the settings used when the tests are run with optimization, i.e. the full optimiser
+	/// settings with the Yul optimiser sequence selected on the command line, if any.
+	static solidity::frontend::OptimiserSettings fullOptimiserSettings();
+
 	void selectVM(evmc_capabilities _cap = evmc_capabilities::EVMC_CAPABILITY_EVM1);
 	void reset();
 
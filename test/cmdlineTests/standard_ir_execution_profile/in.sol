@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+contract C {
+    function a() public {}
+    function b() public {}
+    function c() public {}
+    function d() public {}
+    function e() public {}
+    function f() public {}
+    function g() public {}
+    function h() public {}
+}
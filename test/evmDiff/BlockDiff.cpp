@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <tools/evmDiff/BlockDiff.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::util;
+
+namespace solidity::evmdiff::test
+{
+
+namespace
+{
+
+BlockDiff diff(std::string const& _before, std::string const& _after)
+{
+	OpcodeTable opcodes{langutil::EVMVersion{}};
+	return diffBlocks(buildControlFlowGraph(fromHex(_before), opcodes), buildControlFlowGraph(fromHex(_after), opcodes));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(EVMDiff, *boost::unit_test::label("nooptions"))
+BOOST_AUTO_TEST_SUITE(BlockDiffTest)
+
+BOOST_AUTO_TEST_CASE(identical)
+{
+	BlockDiff result = diff("600456fe5b00", "600456fe5b00");
+	BOOST_CHECK(result.identical());
+	BOOST_CHECK_EQUAL(result.matched.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(moved_blocks_are_matched)
+{
+	// An INVALID is inserted in front of the jump target, which moves the target.
+	BlockDiff result = diff("600456fe5b00", "600556fefe5b00");
+	BOOST_CHECK(result.removed.empty());
+	BOOST_REQUIRE_EQUAL(result.added.size(), 1);
+	BOOST_CHECK_EQUAL(result.added[0].blockCount, 1);
+	BOOST_CHECK_EQUAL(result.matched.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(changed_blocks_form_regions)
+{
+	// PUSH1 0x01 STOP INVALID INVALID PUSH1 0x01 STOP vs. PUSH1 0x02 STOP INVALID INVALID PUSH1 0x03 STOP
+	BlockDiff result = diff("600100fefe600100", "600200fefe600300");
+	BOOST_CHECK(!result.identical());
+	BOOST_REQUIRE_EQUAL(result.removed.size(), 2);
+	BOOST_REQUIRE_EQUAL(result.added.size(), 2);
+	BOOST_CHECK_EQUAL(result.removed[0].firstBlock, 0);
+	BOOST_CHECK_EQUAL(result.removed[1].firstBlock, 3);
+	BOOST_CHECK_EQUAL(result.matched.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <tools/evmDiff/ControlFlowGraph.h>
+#include <tools/evmDiff/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::util;
+
+namespace solidity::evmdiff::test
+{
+
+namespace
+{
+
+ControlFlowGraph build(std::string const& _hex)
+{
+	return buildControlFlowGraph(fromHex(_hex), OpcodeTable{langutil::EVMVersion{}});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(EVMDiff, *boost::unit_test::label("nooptions"))
+BOOST_AUTO_TEST_SUITE(ControlFlowGraphTest)
+
+BOOST_AUTO_TEST_CASE(splits_at_jumpdests_and_terminators)
+{
+	// PUSH1 0x04 JUMP INVALID JUMPDEST STOP
+	ControlFlowGraph cfg = build("600456fe5b00");
+	BOOST_REQUIRE_EQUAL(cfg.blocks.size(), 3);
+	BOOST_CHECK_EQUAL(cfg.blocks[0].begin, 0);
+	BOOST_CHECK_EQUAL(cfg.blocks[0].end, 3);
+	BOOST_CHECK_EQUAL(cfg.blocks[0].instructionCount, 2);
+	BOOST_CHECK(cfg.blocks[0].successors == std::vector<size_t>{2});
+	BOOST_CHECK_EQUAL(cfg.blocks[1].begin, 3);
+	BOOST_CHECK(cfg.blocks[1].successors.empty());
+	BOOST_CHECK_EQUAL(cfg.blocks[2].begin, 4);
+	BOOST_CHECK_EQUAL(cfg.blocks[2].end, 6);
+	BOOST_CHECK(cfg.blocks[2].successors.empty());
+	BOOST_CHECK(cfg.blockAt(4) == 2);
+	BOOST_CHECK(!cfg.blockAt(5));
+}
+
+BOOST_AUTO_TEST_CASE(conditional_jump_has_both_successors)
+{
+	// PUSH1 0x04 JUMPI STOP JUMPDEST STOP
+	ControlFlowGraph cfg = build("600457005b00");
+	BOOST_REQUIRE_EQUAL(cfg.blocks.size(), 3);
+	BOOST_CHECK((cfg.blocks[0].successors == std::vector<size_t>{2, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(jumpdest_in_push_data_is_ignored)
+{
+	// PUSH1 0x5b STOP
+	ControlFlowGraph cfg = build("605b00");
+	BOOST_REQUIRE_EQUAL(cfg.blocks.size(), 1);
+	BOOST_CHECK_EQUAL(cfg.blocks[0].instructionCount, 2);
+}
+
+BOOST_AUTO_TEST_CASE(jump_targets_do_not_affect_hash)
+{
+	// PUSH1 0x04 JUMP INVALID JUMPDEST STOP vs. PUSH1 0x05 JUMP INVALID INVALID JUMPDEST STOP
+	ControlFlowGraph before = build("600456fe5b00");
+	ControlFlowGraph after = build("600556fefe5b00");
+	BOOST_CHECK_EQUAL(before.blocks[0].hash, after.blocks[0].hash);
+	BOOST_CHECK_EQUAL(before.blocks[2].hash, after.blocks[3].hash);
+	// PUSH1 0x01 STOP vs. PUSH1 0x02 STOP
+	BOOST_CHECK_NE(build("600100").blocks[0].hash, build("600200").blocks[0].hash);
+}
+
+BOOST_AUTO_TEST_CASE(strip_metadata)
+{
+	BOOST_CHECK(stripMetadata(fromHex("00a1000002")) == fromHex("00"));
+	// Not a CBOR map.
+	BOOST_CHECK(stripMetadata(fromHex("0000000002")) == fromHex("0000000002"));
+	// Length exceeds the bytecode.
+	BOOST_CHECK(stripMetadata(fromHex("00a1000009")) == fromHex("00a1000009"));
+}
+
+BOOST_AUTO_TEST_CASE(bytecode_from_hex)
+{
+	BOOST_CHECK(bytecodeFromHex(" 0x6001\n") == fromHex("6001"));
+	BOOST_CHECK(bytecodeFromHex("73__$0123456789abcdef0123456789abcdef01$__00") == fromHex("73") + bytes(20) + fromHex("00"));
+	BOOST_CHECK_THROW(bytecodeFromHex("60zz"), InvalidBytecode);
+	BOOST_CHECK_THROW(bytecodeFromHex("73__$0123"), InvalidBytecode);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
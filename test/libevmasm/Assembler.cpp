@@ -422,6 +422,63 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_sub_assembly_optimisation)
+{
+	if (solidity::test::CommonOptions::get().eofVersion().has_value())
+		return;
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	// Creates an assembly with sub-assemblies containing duplicate blocks, which optionally share a sub-assembly.
+	auto createAssembly = [&](bool _shareSub) {
+		auto createSub = [&](u256 const& _value) {
+			auto sub = std::make_shared<Assembly>(evmVersion, false, std::nullopt, std::string{});
+			for (size_t i = 0; i < 3; ++i)
+			{
+				AssemblyItem tag = sub->newTag();
+				sub->appendJumpI(tag);
+				sub->append(u256(_value));
+				sub->append(u256(0));
+				sub->append(Instruction::SSTORE);
+				sub->append(Instruction::STOP);
+				sub->append(tag);
+				sub->append(u256(_value));
+				sub->append(u256(0));
+				sub->append(Instruction::SSTORE);
+				sub->append(Instruction::STOP);
+			}
+			return sub;
+		};
+		auto assembly = std::make_shared<Assembly>(evmVersion, true, std::nullopt, std::string{});
+		auto sharedSub = createSub(42);
+		for (u256 value: {1, 2, 3, 4})
+		{
+			auto sub = createSub(value);
+			if (_shareSub)
+				sub->appendSubroutine(sharedSub);
+			assembly->pushSubroutineOffset(static_cast<size_t>(assembly->appendSubroutine(sub).data()));
+		}
+		assembly->append(Instruction::STOP);
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings = Assembly::OptimiserSettings::translateSettings(
+		OptimiserSettings::full(),
+		evmVersion
+	);
+	// A shared sub-assembly prevents optimising the subs concurrently.
+	for (bool shareSub: {false, true})
+	{
+		settings.numThreads = 1;
+		std::shared_ptr<Assembly> sequential = createAssembly(shareSub);
+		sequential->optimise(settings);
+		settings.numThreads = 4;
+		std::shared_ptr<Assembly> concurrent = createAssembly(shareSub);
+		concurrent->optimise(settings);
+		BOOST_CHECK_EQUAL(concurrent->assemblyString(), sequential->assemblyString());
+		BOOST_CHECK(concurrent->assemble().bytecode == sequential->assemble().bytecode);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -1302,6 +1302,49 @@ BOOST_AUTO_TEST_CASE(peephole_iszero_iszero_jumpi)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(peephole_multiple_patterns_single_pass)
+{
+	AssemblyItems items{
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		Instruction::DUP1,
+		Instruction::POP,
+		Instruction::SWAP1,
+		Instruction::SWAP1,
+		Instruction::EQ,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		Instruction::SUB,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 2),
+		Instruction::STOP
+	};
+	PeepholeOptimiser peepOpt(items, solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	// Nothing left to optimise, the items have to stay unchanged.
+	BOOST_CHECK(!peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal)
 {
 	AssemblyItems items{
@@ -2047,6 +2090,54 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 }
 
 
+BOOST_AUTO_TEST_CASE(inliner_code_size_limit)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	// A function with two call sites whose body is large enough that inlining grows the code.
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 3),
+		jumpInto,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 3),
+		jumpInto,
+		AssemblyItem(Tag, 2),
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+	};
+	for (size_t i = 0; i < 30; ++i)
+		items.emplace_back(Instruction::CALLVALUE);
+	items.emplace_back(jumpOutOf);
+
+	auto countCallValues = [](AssemblyItems const& _items) {
+		return std::count(_items.begin(), _items.end(), AssemblyItem{Instruction::CALLVALUE});
+	};
+	size_t const runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
+
+	AssemblyItems unlimited = items;
+	Inliner{unlimited, {}, runs, false, {}}.optimise();
+	BOOST_CHECK_EQUAL(countCallValues(unlimited), 90);
+
+	AssemblyItems withinLimit = items;
+	Inliner{withinLimit, {}, runs, false, {}, 1000}.optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		withinLimit.begin(), withinLimit.end(),
+		unlimited.begin(), unlimited.end()
+	);
+
+	AssemblyItems exceedingLimit = items;
+	Inliner{exceedingLimit, {}, runs, false, {}, 50}.optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		exceedingLimit.begin(), exceedingLimit.end(),
+		items.begin(), items.end()
+	);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
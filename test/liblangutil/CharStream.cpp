@@ -130,6 +130,34 @@ BOOST_AUTO_TEST_CASE(translateLineColumnToPosition)
 	BOOST_CHECK_EQUAL(toPosition(2, 2, "ABC\nDEF\nGHI\n"), 10);
 }
 
+BOOST_AUTO_TEST_CASE(translatePositionToLineColumn)
+{
+	CharStream const stream{"ABC\nDE\r\n\nF", "source"};
+	auto lineColumn = [&](int _position) {
+		LineColumn result = stream.translatePositionToLineColumn(_position);
+		return std::make_pair(result.line, result.column);
+	};
+
+	BOOST_CHECK(lineColumn(0) == std::make_pair(0, 0));
+	BOOST_CHECK(lineColumn(3) == std::make_pair(0, 3));
+	BOOST_CHECK(lineColumn(4) == std::make_pair(1, 0));
+	BOOST_CHECK(lineColumn(7) == std::make_pair(1, 3));
+	BOOST_CHECK(lineColumn(8) == std::make_pair(2, 0));
+	BOOST_CHECK(lineColumn(9) == std::make_pair(3, 0));
+	BOOST_CHECK(lineColumn(10) == std::make_pair(3, 1));
+	// Positions past the end are clamped.
+	BOOST_CHECK(lineColumn(100) == std::make_pair(3, 1));
+
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "ABC");
+	// A position at a line break refers to the line before it.
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(3), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(4), "DE");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(8), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(9), "F");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(100), "F");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
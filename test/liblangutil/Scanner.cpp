@@ -895,6 +895,46 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_comments_and_literals)
+{
+	std::string const text(1000, 'x');
+	TestScanner scanner(
+		"/** " + text + "\n * " + text + " */ " + text + "\n"
+		"/* " + text + " *" + text + " */ \"" + text + "\" // " + text + "\n"
+		"/// " + text + "\n/// " + text + "\n a"
+	);
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), text + "\n " + text + " ");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a");
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), text + "\n " + text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(direction_override_in_long_comments)
+{
+	std::string const text(1000, 'x');
+	std::string const rightToLeftOverride = "\xE2\x80\xAE";
+	std::string const popFormatting = "\xE2\x80\xAC";
+	TestScanner scanner("/* " + text + rightToLeftOverride + text + popFormatting + " */ a // " + rightToLeftOverride + text + popFormatting + "\n b");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+
+	scanner.reset("/* " + text + rightToLeftOverride + text + " */ a");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK(scanner.currentError() == ScannerError::DirectionalOverrideMismatch);
+
+	scanner.reset("// " + text + popFormatting + text + "\n a");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK(scanner.currentError() == ScannerError::DirectionalOverrideUnderflow);
+}
+
 BOOST_AUTO_TEST_CASE(solidity_keywords)
 {
 	// These are tokens which have a different meaning in Yul.
@@ -296,6 +296,38 @@ BOOST_AUTO_TEST_CASE(regular_functions_exclude_fallback)
 	testRunTimeGas("x()", std::vector<bytes>{encodeArgs()});
 }
 
+BOOST_AUTO_TEST_CASE(parametric_loop_estimation)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function f(uint n) public pure returns (uint s) {
+				for (uint i = 0; i < n; i++)
+					s += i;
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	evmasm::AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	GasEstimator estimator(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_CHECK(estimator.functionalEstimation(items, "f(uint256)").isInfinite);
+
+	GasEstimator::ParametricGasConsumption gas = estimator.parametricEstimation(items, "f(uint256)");
+	BOOST_REQUIRE(!gas.base.isInfinite);
+	BOOST_REQUIRE_EQUAL(gas.loops.size(), 1);
+	BOOST_REQUIRE(!gas.loops.begin()->second.isInfinite);
+	BOOST_CHECK(gas.externalCalls.empty());
+
+	util::FixedHash<4> hash = util::selectorFromSignatureH32("f(uint256)");
+	for (unsigned iterations: {1u, 3u, 10u})
+	{
+		bytes data = hash.asBytes() + encodeArgs(iterations);
+		sendMessage(data, false, 0);
+		BOOST_CHECK(m_transactionSuccessful);
+		u256 bound = gasForTransaction(data, false).value + gas.base.value + gas.loops.begin()->second.value * iterations;
+		BOOST_CHECK_LE(m_gasUsed, bound);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(complex_control_flow)
 {
 	// This crashed the gas estimator previously (or took a very long time).
@@ -447,6 +479,29 @@ BOOST_AUTO_TEST_CASE(
 	testRunTimeGas("overlap_full()", {encodeArgs()});
 }
 
+BOOST_AUTO_TEST_CASE(step_budget)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint a) public {
+				if (a > 7)
+					data = a;
+				else
+					data = 2 * a;
+			}
+		}
+	)";
+	compile(sourceCode);
+	AssemblyItems const& items = *m_compiler.assemblyItems(m_compiler.lastContractName());
+	auto evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	GasMeter::GasConsumption unlimited = PathGasMeter::estimateMax(items, evmVersion, 0, std::make_shared<KnownState>());
+	BOOST_REQUIRE(!unlimited.isInfinite);
+	GasMeter::GasConsumption exhausted = PathGasMeter::estimateMax(items, evmVersion, 0, std::make_shared<KnownState>(), 10);
+	BOOST_CHECK(exhausted.isInfinite);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
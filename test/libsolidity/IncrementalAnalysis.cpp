@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the reuse of analysis results across compilations in CompilerStack.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <string>
+
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+StringMap const sources{
+	{"a.sol", "pragma solidity >=0.0; import \"b.sol\"; contract A is B { function f() public pure { uint x; } }"},
+	{"b.sol", "pragma solidity >=0.0; contract B { function g() public pure returns (uint) { return 1; } }"},
+};
+
+bytes compileFromScratch(StringMap const& _sources, std::string const& _contractName)
+{
+	CompilerStack compiler;
+	compiler.setSources(_sources);
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compiler.compile());
+	return compiler.object(_contractName).bytecode;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalAnalysis)
+
+// NOTE: Reuse is detected via the identity of the char stream: setSources() always creates a new
+// one while the retained analysis still keeps the old one alive.
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_not_reanalyzed)
+{
+	bytes expectedBytecode = compileFromScratch(sources, "a.sol:A");
+
+	CompilerStack compiler;
+	compiler.setIncrementalAnalysis(true);
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setSources(sources);
+	BOOST_REQUIRE(compiler.compile());
+	CharStream const* charStreamA = &compiler.charStream("a.sol");
+	size_t numErrors = compiler.errors().size();
+	BOOST_TEST(numErrors > 0);
+
+	compiler.reset(true /* _keepSettings */);
+	compiler.setSources(sources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_TEST(&compiler.charStream("a.sol") == charStreamA);
+	BOOST_TEST(compiler.errors().size() == numErrors);
+	BOOST_TEST(compiler.object("a.sol:A").bytecode == expectedBytecode);
+}
+
+BOOST_AUTO_TEST_CASE(modified_sources_are_reanalyzed)
+{
+	StringMap modifiedSources = sources;
+	modifiedSources["b.sol"] = "pragma solidity >=0.0; contract B { function g() public pure returns (uint) { return 2; } }";
+	bytes expectedBytecode = compileFromScratch(modifiedSources, "a.sol:A");
+
+	CompilerStack compiler;
+	compiler.setIncrementalAnalysis(true);
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setSources(sources);
+	BOOST_REQUIRE(compiler.compile());
+	CharStream const* charStreamA = &compiler.charStream("a.sol");
+
+	compiler.reset(true /* _keepSettings */);
+	compiler.setSources(modifiedSources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_TEST(&compiler.charStream("a.sol") != charStreamA);
+	BOOST_TEST(compiler.object("a.sol:A").bytecode == expectedBytecode);
+}
+
+BOOST_AUTO_TEST_CASE(sources_loaded_via_callback_are_checked)
+{
+	std::string contentB = sources.at("b.sol");
+	CompilerStack compiler([&](std::string const&, std::string const& _path) {
+		if (_path == "b.sol")
+			return ReadCallback::Result{true, contentB};
+		return ReadCallback::Result{false, "Not found."};
+	});
+	compiler.setIncrementalAnalysis(true);
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setSources({{"a.sol", sources.at("a.sol")}});
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+	CharStream const* charStreamA = &compiler.charStream("a.sol");
+
+	compiler.reset(true /* _keepSettings */);
+	compiler.setSources({{"a.sol", sources.at("a.sol")}});
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+	BOOST_TEST(&compiler.charStream("a.sol") == charStreamA);
+
+	contentB = "pragma solidity >=0.0; contract B {} contract C {}";
+	compiler.reset(true /* _keepSettings */);
+	compiler.setSources({{"a.sol", sources.at("a.sol")}});
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+	BOOST_TEST(&compiler.charStream("a.sol") != charStreamA);
+	BOOST_TEST(compiler.ast("b.sol").nodes().size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(changed_settings_invalidate_analysis)
+{
+	StringMap const transientStorageSource{
+		{"a.sol", "pragma solidity >=0.0; contract A { function f() public { assembly { tstore(0, 1) } } }"},
+	};
+
+	CompilerStack compiler;
+	compiler.setIncrementalAnalysis(true);
+	compiler.setEVMVersion(EVMVersion::cancun());
+	compiler.setSources(transientStorageSource);
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+	compiler.reset(true /* _keepSettings */);
+	compiler.setEVMVersion(EVMVersion::london());
+	compiler.setSources(transientStorageSource);
+	BOOST_TEST(!compiler.parseAndAnalyze());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -21,6 +21,8 @@
  */
 
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -178,6 +180,47 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_instances)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "contract A { mapping(uint => string) m; function f(uint x) public view returns (string memory) { return m[x]; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {"*": {"*": ["evm.bytecode.object", "abi"]}}
+		}
+	}
+	)";
+
+	std::vector<std::string> outputs(4);
+	std::vector<std::thread> threads;
+	for (std::string& output: outputs)
+		threads.emplace_back([&input, &output]() {
+			SolidityInstance* instance = solidity_create_instance();
+			for (size_t i = 0; i < 2; ++i)
+			{
+				char* output_ptr = solidity_compile_with(instance, input, nullptr, nullptr);
+				output = output_ptr;
+				solidity_free(output_ptr);
+			}
+			solidity_destroy_instance(instance);
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+	solidity_reset();
+
+	Json result;
+	BOOST_REQUIRE(util::jsonParseStrict(outputs[0], result));
+	BOOST_REQUIRE(!result.contains("errors"));
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].get<std::string>().empty());
+	for (std::string const& output: outputs)
+		BOOST_CHECK(output == outputs[0]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
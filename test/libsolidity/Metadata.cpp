@@ -26,6 +26,7 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -300,6 +301,33 @@ BOOST_AUTO_TEST_CASE(metadata_relevant_sources_imports)
 	BOOST_CHECK(metadata["sources"].contains("C"));
 }
 
+BOOST_AUTO_TEST_CASE(metadata_shared_source_hashes)
+{
+	CompilerStack compilerStack;
+	std::string sourceCodeLib = R"(
+		pragma solidity >=0.0;
+		library L { function f() internal pure returns (uint) { return 1; } }
+	)";
+	compilerStack.setSources({
+		{"L", sourceCodeLib},
+		{"A", "pragma solidity >=0.0; import \"L\"; contract A { function a() public pure returns (uint) { return L.f(); } }"},
+		{"B", "pragma solidity >=0.0; import \"L\"; contract B { function b() public pure returns (uint) { return L.f(); } }"}
+	});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+	BOOST_CHECK(compilerStack.sourceKeccak256("L") == util::keccak256(sourceCodeLib));
+	for (std::string const& contractName: {"A", "B"})
+	{
+		Json metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(compilerStack.metadata(contractName), metadata));
+		Json const& library = metadata["sources"]["L"];
+		BOOST_CHECK(library["keccak256"] == "0x" + util::toHex(compilerStack.sourceKeccak256("L").asBytes()));
+		BOOST_CHECK(library["urls"][0] == "bzz-raw://" + util::toHex(util::bzzr1Hash(sourceCodeLib).asBytes()));
+		BOOST_CHECK(library["urls"][1] == "dweb:/ipfs/" + util::ipfsHashBase58(sourceCodeLib));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(metadata_useLiteralContent)
 {
 	// Check that the metadata contains "useLiteralContent"
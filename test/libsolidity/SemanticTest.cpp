@@ -14,6 +14,7 @@
 
 #include <test/libsolidity/SemanticTest.h>
 
+#include <libsolutil/StringUtils.h>
 #include <libsolutil/Whiskers.h>
 #include <libyul/Exceptions.h>
 #include <test/Common.h>
@@ -45,6 +46,22 @@ using namespace boost::unit_test;
 using namespace std::string_literals;
 namespace fs = boost::filesystem;
 
+namespace
+{
+
+/// Code generator optimizations that can be switched on by semantic tests.
+std::map<std::string, bool OptimiserSettings::*> const codeGenerationOptimizationSettings{
+	{"copyABIDecodedArrays", &OptimiserSettings::copyABIDecodedArrays},
+	{"optimizeCallingConvention", &OptimiserSettings::optimizeCallingConvention},
+	{"optimizeFunctionExits", &OptimiserSettings::optimizeFunctionExits},
+	{"decodeReadOnlyStructsFromCalldata", &OptimiserSettings::decodeReadOnlyStructsFromCalldata},
+	{"encodeEventDataInScratchSpace", &OptimiserSettings::encodeEventDataInScratchSpace},
+	{"splitSelectorSwitch", &OptimiserSettings::splitSelectorSwitch},
+	{"useSSACodeTransform", &OptimiserSettings::useSSACodeTransform},
+};
+
+}
+
 std::ostream& solidity::frontend::test::operator<<(std::ostream& _output, RequiresYulOptimizer _requiresYulOptimizer)
 {
 	switch (_requiresYulOptimizer)
@@ -108,6 +125,33 @@ SemanticTest::SemanticTest(
 
 	m_allowNonExistingFunctions = m_reader.boolSetting("allowNonExistingFunctions", false);
 
+	std::vector<std::string> codeGenerationOptimizations;
+	boost::split(codeGenerationOptimizations, m_reader.stringSetting("codeGenerationOptimizations", ""), boost::is_any_of(","));
+	for (std::string& name: codeGenerationOptimizations)
+	{
+		boost::trim(name);
+		if (name.empty())
+			continue;
+		if (!codeGenerationOptimizationSettings.count(name))
+			BOOST_THROW_EXCEPTION(std::runtime_error("Invalid codeGenerationOptimizations value: " + name + "."));
+		m_codeGenerationOptimizations.insert(name);
+	}
+
+	std::vector<std::string> executionProfile;
+	boost::split(executionProfile, m_reader.stringSetting("executionProfile", ""), boost::is_any_of(";"));
+	for (std::string& entry: executionProfile)
+	{
+		boost::trim(entry);
+		if (entry.empty())
+			continue;
+		size_t const separator = entry.rfind('=');
+		std::string signature = boost::trim_copy(entry.substr(0, separator));
+		std::string calls = separator == std::string::npos ? "" : boost::trim_copy(entry.substr(separator + 1));
+		if (signature.empty() || calls.empty() || !std::all_of(calls.begin(), calls.end(), isDigit))
+			BOOST_THROW_EXCEPTION(std::runtime_error("Invalid executionProfile entry: " + entry + "."));
+		m_executionProfile[signature] = std::stoul(calls);
+	}
+
 	parseExpectations(m_reader.stream());
 	soltestAssert(!m_tests.empty(), "No tests specified in " + _filename);
 
@@ -307,11 +351,18 @@ frontend::OptimiserSettings SemanticTest::optimizerSettingsFor(RequiresYulOptimi
 		return settings;
 	}
 	case RequiresYulOptimizer::Full:
-		return OptimiserSettings::full();
+		return fullOptimiserSettings();
 	}
 	unreachable();
 }
 
+void SemanticTest::applyCodeGenerationOptimizations(OptimiserSettings& _settings) const
+{
+	for (std::string const& name: m_codeGenerationOptimizations)
+		_settings.*codeGenerationOptimizationSettings.at(name) = true;
+	_settings.executionProfile = m_executionProfile;
+}
+
 TestCase::TestResult SemanticTest::run(std::ostream& _stream, std::string const& _linePrefix, bool _formatted)
 {
 	TestResult result = TestResult::Success;
@@ -353,6 +404,10 @@ TestCase::TestResult SemanticTest::runTest(
 
 	m_compileViaYul = _isYulRun;
 
+	OptimiserSettings optimiserSettings = m_optimiserSettings;
+	applyCodeGenerationOptimizations(optimiserSettings);
+	ScopedSaveAndRestore codeGenerationOptimizations(m_optimiserSettings, std::move(optimiserSettings));
+
 	if (_isYulRun)
 		AnsiColorized(_stream, _formatted, {BOLD, CYAN}) << _linePrefix << "Running via Yul: " << std::endl;
 
@@ -565,9 +620,11 @@ TestCase::TestResult SemanticTest::tryRunTestWithYulOptimizer(
 
 bool SemanticTest::checkGasCostExpectation(TestFunctionCall& io_test, bool _compileViaYul) const
 {
+	OptimiserSettings optimizedSettings = fullOptimiserSettings();
+	applyCodeGenerationOptimizations(optimizedSettings);
 	std::string setting =
 		(_compileViaYul ? "ir"s : "legacy"s) +
-		(m_optimiserSettings == OptimiserSettings::full() ? "Optimized" : "");
+		(m_optimiserSettings == optimizedSettings ? "Optimized" : "");
 
 	soltestAssert(
 		io_test.call().expectations.gasUsedExcludingCode.count(setting) ==
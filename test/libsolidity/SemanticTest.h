@@ -111,6 +111,9 @@ private:
 	static std::string formatEventParameter(std::optional<AnnotatedEventSignature> _signature, bool _indexed, size_t _index, bytes const& _data);
 
 	OptimiserSettings optimizerSettingsFor(RequiresYulOptimizer _requiresYulOptimizer);
+	/// Enables the code generator optimizations and sets the execution profile requested by the
+	/// test in @a _settings.
+	void applyCodeGenerationOptimizations(OptimiserSettings& _settings) const;
 
 	SourceMap m_sources;
 	std::size_t m_lineOffset;
@@ -124,6 +127,12 @@ private:
 	bool m_gasCostFailure = false;
 	bool m_enforceGasCost = false;
 	RequiresYulOptimizer m_requiresYulOptimizer{};
+	/// Names of the code generator optimizations that are switched on in every run, as used in
+	/// settings.optimizer.details of the Standard JSON input.
+	std::set<std::string> m_codeGenerationOptimizations;
+	/// Number of calls per external function signature the dispatcher is optimized for, given
+	/// as ``signature=calls`` entries separated by ``;``.
+	std::map<std::string, size_t> m_executionProfile;
 	u256 m_enforceGasCostMinValue;
 };
 
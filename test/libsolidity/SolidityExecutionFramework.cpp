@@ -50,43 +50,86 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	if (_mainSourceName.has_value())
 		solAssert(_sourceCode.find(_mainSourceName.value()) != _sourceCode.end(), "");
 
-	m_compiler.reset();
-	m_compiler.setSources(withPreamble(
-		_sourceCode,
-		solidity::test::CommonOptions::get().useABIEncoderV1 // _addAbicoderV1Pragma
-	));
-	m_compiler.setLibraries(_libraryAddresses);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	m_compiler.setEVMVersion(m_evmVersion);
-	m_compiler.setEOFVersion(m_eofVersion);
-	m_compiler.setOptimiserSettings(m_optimiserSettings);
-	m_compiler.setViaIR(m_compileViaYul);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	if (!m_appendCBORMetadata) {
-		m_compiler.setMetadataFormat(CompilerStack::MetadataFormat::NoMetadata);
-	}
-	m_compiler.setMetadataHash(m_metadataHash);
+	// Without a metadata hash, library addresses do not affect the bytecode and are linked after the
+	// compilation, so that the same compilation can be used to deploy the libraries and the contracts.
+	bool const librariesAffectBytecode = m_appendCBORMetadata && m_metadataHash != CompilerStack::MetadataHash::None;
+	CompilationInput input{
+		withPreamble(
+			_sourceCode,
+			solidity::test::CommonOptions::get().useABIEncoderV1 // _addAbicoderV1Pragma
+		),
+		librariesAffectBytecode ? _libraryAddresses : std::map<std::string, Address>{},
+		m_evmVersion,
+		m_eofVersion,
+		m_optimiserSettings,
+		m_compileViaYul,
+		m_revertStrings,
+		m_appendCBORMetadata,
+		m_metadataHash
+	};
 
-	if (!m_compiler.compile())
+	if (!compiled(input))
 	{
-		// The testing framework expects an exception for
-		// "unimplemented" yul IR generation.
-		if (m_compileViaYul)
-			for (auto const& error: m_compiler.errors())
-				if (error->type() == langutil::Error::Type::CodeGenerationError)
-					BOOST_THROW_EXCEPTION(*error);
-		langutil::SourceReferenceFormatter{std::cerr, m_compiler, true, false}
-			.printErrorInformation(m_compiler.errors());
-		BOOST_ERROR("Compiling contract failed");
+		m_lastCompilationInput.reset();
+		m_compiler.reset();
+		m_compiler.setSources(input.sources);
+		m_compiler.setLibraries(input.libraries);
+		m_compiler.setEVMVersion(m_evmVersion);
+		m_compiler.setEOFVersion(m_eofVersion);
+		m_compiler.setOptimiserSettings(m_optimiserSettings);
+		m_compiler.setViaIR(m_compileViaYul);
+		m_compiler.setRevertStringBehaviour(m_revertStrings);
+		if (!m_appendCBORMetadata) {
+			m_compiler.setMetadataFormat(CompilerStack::MetadataFormat::NoMetadata);
+		}
+		m_compiler.setMetadataHash(m_metadataHash);
+
+		if (!m_compiler.compile())
+		{
+			// The testing framework expects an exception for
+			// "unimplemented" yul IR generation.
+			if (m_compileViaYul)
+				for (auto const& error: m_compiler.errors())
+					if (error->type() == langutil::Error::Type::CodeGenerationError)
+						BOOST_THROW_EXCEPTION(*error);
+			langutil::SourceReferenceFormatter{std::cerr, m_compiler, true, false}
+				.printErrorInformation(m_compiler.errors());
+			BOOST_ERROR("Compiling contract failed");
+		}
+		else
+			m_lastCompilationInput = std::move(input);
 	}
 	std::string contractName(_contractName.empty() ? m_compiler.lastContractName(_mainSourceName) : _contractName);
 	evmasm::LinkerObject obj = m_compiler.object(contractName);
+	obj.link(_libraryAddresses);
 	BOOST_REQUIRE(obj.linkReferences.empty());
 	if (m_showMetadata)
 		std::cout << "metadata: " << m_compiler.metadata(contractName) << std::endl;
 	return obj.bytecode;
 }
 
+bool SolidityExecutionFramework::CompilationInput::operator==(CompilationInput const& _other) const
+{
+	return
+		std::tie(sources, libraries, evmVersion, eofVersion, viaIR, revertStrings, appendCBORMetadata, metadataHash) ==
+		std::tie(_other.sources, _other.libraries, _other.evmVersion, _other.eofVersion, _other.viaIR, _other.revertStrings, _other.appendCBORMetadata, _other.metadataHash) &&
+		optimiserSettings == _other.optimiserSettings;
+}
+
+bool SolidityExecutionFramework::compiled(CompilationInput const& _input) const
+{
+	if (!m_lastCompilationInput || !(*m_lastCompilationInput == _input))
+		return false;
+
+	// Derived test frameworks may have used the compiler directly in the meantime.
+	if (m_compiler.state() != CompilerStack::CompilationSuccessful || m_compiler.sourceNames().size() != _input.sources.size())
+		return false;
+	for (auto const& [name, source]: _input.sources)
+		if (m_compiler.charStream(name).source() != source)
+			return false;
+	return true;
+}
+
 bytes SolidityExecutionFramework::compileContract(
 	std::string const& _sourceCode,
 	std::string const& _contractName,
@@ -88,6 +88,31 @@ protected:
 	bool m_appendCBORMetadata = true;
 	CompilerStack::MetadataHash m_metadataHash = CompilerStack::MetadataHash::IPFS;
 	RevertStrings m_revertStrings = RevertStrings::Default;
+
+private:
+	/// Sources and settings that determine the result of multiSourceCompileContract().
+	struct CompilationInput
+	{
+		std::map<std::string, std::string> sources;
+		/// Only set if the library addresses affect the bytecode, otherwise they are linked afterwards.
+		std::map<std::string, solidity::test::Address> libraries;
+		langutil::EVMVersion evmVersion;
+		std::optional<uint8_t> eofVersion;
+		OptimiserSettings optimiserSettings;
+		bool viaIR = false;
+		RevertStrings revertStrings = RevertStrings::Default;
+		bool appendCBORMetadata = true;
+		CompilerStack::MetadataHash metadataHash = CompilerStack::MetadataHash::IPFS;
+
+		bool operator==(CompilationInput const& _other) const;
+	};
+
+	/// @returns true if m_compiler holds the successful compilation of @a _input.
+	bool compiled(CompilationInput const& _input) const;
+
+	/// Input of the last successful compilation, which is reused as long as the input does not change,
+	/// e.g. when deploying multiple libraries and contracts from the same sources.
+	std::optional<CompilationInput> m_lastCompilationInput;
 };
 
 } // end namespaces
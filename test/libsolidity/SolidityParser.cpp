@@ -50,8 +50,9 @@ ASTPointer<ContractDefinition> parseText(std::string const& _source, ErrorList&
 	if (!sourceUnit)
 		return ASTPointer<ContractDefinition>();
 	for (ASTPointer<ASTNode> const& node: sourceUnit->nodes())
-		if (ASTPointer<ContractDefinition> contract = std::dynamic_pointer_cast<ContractDefinition>(node))
-			return contract;
+		if (auto contract = dynamic_cast<ContractDefinition*>(node.get()))
+			// Keeps the source unit alive, which owns the memory of the contract.
+			return ASTPointer<ContractDefinition>(sourceUnit, contract);
 	BOOST_FAIL("No contract found in source.");
 	return ASTPointer<ContractDefinition>();
 }
@@ -611,6 +612,37 @@ BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 	BOOST_CHECK_MESSAGE(visitor.visited, "No inline asm block found?!");
 }
 
+BOOST_AUTO_TEST_CASE(identifier_names_are_shared)
+{
+	char const* text = R"(
+		contract C {
+			uint x;
+			function f() public { x = x + 1; }
+		}
+	)";
+	ErrorList errors;
+	ASTPointer<ContractDefinition> contract = parseText(text, errors);
+	BOOST_REQUIRE(contract);
+	BOOST_REQUIRE_EQUAL(contract->stateVariables().size(), 1);
+
+	class CollectIdentifiers: public ASTConstVisitor
+	{
+	public:
+		bool visit(Identifier const& _identifier) override
+		{
+			names.push_back(&_identifier.name());
+			return false;
+		}
+		std::vector<ASTString const*> names;
+	};
+
+	CollectIdentifiers visitor;
+	contract->accept(visitor);
+	BOOST_REQUIRE_EQUAL(visitor.names.size(), 2);
+	for (ASTString const* name: visitor.names)
+		BOOST_CHECK(name == &contract->stateVariables().front()->name());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
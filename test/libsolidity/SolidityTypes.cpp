@@ -245,6 +245,34 @@ BOOST_AUTO_TEST_CASE(encoded_sizes)
 	BOOST_CHECK_EQUAL(twoDimArray.calldataEncodedSize(false), 9 * 3 * 32);
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	Type const* uint8 = TypeProvider::uint(8);
+	ArrayType const* dynamicArray = TypeProvider::array(DataLocation::Memory, uint8);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint8) == dynamicArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Storage, uint8) != dynamicArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint8, 2) != dynamicArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint8, 2) == TypeProvider::array(DataLocation::Memory, uint8, 2));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint8, 2) != TypeProvider::array(DataLocation::Memory, uint8, 3));
+
+	ReferenceType const* storageArray = TypeProvider::withLocation(dynamicArray, DataLocation::Storage, true);
+	BOOST_CHECK(TypeProvider::withLocation(dynamicArray, DataLocation::Storage, true) == storageArray);
+	BOOST_CHECK(TypeProvider::withLocation(dynamicArray, DataLocation::Storage, false) != storageArray);
+	BOOST_CHECK(TypeProvider::withLocation(dynamicArray, DataLocation::Memory, true) == dynamicArray);
+
+	MappingType const* mapping = TypeProvider::mapping(uint8, "key", dynamicArray, "");
+	BOOST_CHECK(TypeProvider::mapping(uint8, "key", dynamicArray, "") == mapping);
+	BOOST_CHECK(TypeProvider::mapping(uint8, "", dynamicArray, "") != mapping);
+
+	BOOST_CHECK(TypeProvider::tuple({uint8, mapping}) == TypeProvider::tuple({uint8, mapping}));
+	BOOST_CHECK(TypeProvider::tuple({uint8, mapping}) != TypeProvider::tuple({mapping, uint8}));
+	BOOST_CHECK(TypeProvider::typeType(mapping) == TypeProvider::typeType(mapping));
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(7, 2)) == TypeProvider::rationalNumber(rational(14, 4)));
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(1)) != TypeProvider::rationalNumber(rational(1), TypeProvider::fixedBytes(1)));
+
+	TypeProvider::reset();
+}
+
 BOOST_AUTO_TEST_CASE(helper_bool_result)
 {
 	BoolResult r1{true};
@@ -28,6 +28,7 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 #include <test/Metadata.h>
 #include <test/Common.h>
 
@@ -1224,6 +1225,43 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].get<unsigned>() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_details_code_transform)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"useSSACodeTransform": true,
+				"optimizeCallingConvention": true,
+				"optimizeFunctionExits": true
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x + 1; } }"
+			}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.is_object());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].get<std::string>().empty());
+	Json metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].get<std::string>(), metadata));
+
+	Json const& details = metadata["settings"]["optimizer"]["details"];
+	BOOST_CHECK(details["useSSACodeTransform"].get<bool>() == true);
+	BOOST_CHECK(details["optimizeCallingConvention"].get<bool>() == true);
+	BOOST_CHECK(details["optimizeFunctionExits"].get<bool>() == true);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1782,6 +1820,308 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_via_ir_compilation)
+{
+	auto compileWithThreads = [](size_t _numThreads) {
+		char const* inputTemplate = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract A { uint public x; function f(uint y) public { x += y; } }"
+				},
+				"B.sol": {
+					"content": "import \"A.sol\"; contract B { A a = new A(); function g() public { a.f(2); } }"
+				},
+				"C.sol": {
+					"content": "import \"B.sol\"; contract C { B b = new B(); A a = new A(); function h() public returns (uint) { b.g(); return a.x(); } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"threads": NUM_THREADS,
+				"optimizer": {"enabled": true},
+				"outputSelection": {
+					"*": {"*": ["irOptimized", "evm.bytecode.object", "evm.deployedBytecode.object", "metadata"]}
+				}
+			}
+		}
+		)";
+		Json parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(
+			boost::replace_all_copy(std::string(inputTemplate), "NUM_THREADS", std::to_string(_numThreads)),
+			parsedInput
+		));
+
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	Json sequentialResult = compileWithThreads(1);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(getContractResult(sequentialResult, "C.sol", "C").is_object());
+
+	for (size_t numThreads: std::vector<size_t>{2, 4})
+		// The number of threads is limited by the machine.
+		if (numThreads <= util::ThreadPool::hardwareConcurrency())
+			BOOST_CHECK(compileWithThreads(numThreads) == sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_number_of_threads)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract A {}"}},
+		"settings": {"threads": 0}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.threads\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(too_many_threads)
+{
+	size_t const maxThreads = util::ThreadPool::hardwareConcurrency();
+	std::string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract A {}"}},
+		"settings": {"threads": )" + std::to_string(maxThreads + 1) + R"(}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.threads\" must not exceed the number of hardware threads (" + std::to_string(maxThreads) + ")."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(compact_caches)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract A { function f(uint x) public pure returns (uint) { return x * 2; } }"}},
+		"settings": {
+			"viaIR": true,
+			"optimizer": {"enabled": true},
+			"outputSelection": {"*": {"*": ["irOptimized", "evm.bytecode.object"]}}
+		}
+	}
+	)";
+	Json parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	// The first call only measures the repository, later ones may compact it.
+	solidity::frontend::StandardCompiler compiler;
+	compiler.keepYulStringRepository();
+	Json expectedResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(expectedResult));
+	for (size_t i = 0; i < 3; ++i)
+	{
+		compiler.compactCaches();
+		BOOST_CHECK(compiler.compile(parsedInput) == expectedResult);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cache_directory_not_settable_from_input)
+{
+	// Only the command-line interface can set the cache directory, the input must not make the
+	// compiler access arbitrary files.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract A {}"}},
+		"settings": {"cacheDirectory": "cache"}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"cacheDirectory\""));
+}
+
+BOOST_AUTO_TEST_CASE(profiling)
+{
+	auto compileWithProfiling = [](bool _profiling) {
+		std::string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {"A.sol": {"content": "contract A { function f() public pure returns (uint) { return 42; } }"}},
+			"settings": {
+				"profiling": )" + std::string(_profiling ? "true" : "false") + R"(,
+				"viaIR": true,
+				"optimizer": {"enabled": true},
+				"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}
+			}
+		}
+		)";
+		return compile(input);
+	};
+
+	BOOST_CHECK(!compileWithProfiling(false).contains("profiling"));
+
+	Json result = compileWithProfiling(true);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["profiling"]["traceEvents"].is_array());
+	std::set<std::string> phases;
+	for (Json const& event: result["profiling"]["traceEvents"])
+	{
+		BOOST_TEST(event["ph"] == "X");
+		if (event["cat"] == "compiler")
+			phases.insert(event["name"].get<std::string>());
+	}
+	for (std::string const& phase: {"Parsing", "Analysis", "IR generation", "IR optimisation", "EVM code generation", "Assembly"})
+		BOOST_TEST(phases.count(phase) == 1, phase);
+}
+
+BOOST_AUTO_TEST_CASE(bytecode_only_generated_for_contracts_requesting_it)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract A { function f() public returns (address) { return address(new C()); } } contract B {} contract C {}"}},
+		"settings": {
+			"profiling": true,
+			"outputSelection": {"A.sol": {"A": ["evm.bytecode.object"], "B": ["abi"]}}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_TEST(result["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].is_string());
+	BOOST_TEST(result["contracts"]["A.sol"]["B"]["abi"].is_array());
+	BOOST_TEST(!result["contracts"]["A.sol"]["B"].contains("evm"));
+
+	std::set<std::string> compiledContracts;
+	for (Json const& event: result["profiling"]["traceEvents"])
+		if (event["name"] == "Code generation")
+			compiledContracts.insert(event["args"]["contract"].get<std::string>());
+	// C is compiled as a dependency of A.
+	BOOST_TEST(compiledContracts == (std::set<std::string>{"A.sol:A", "A.sol:C"}));
+}
+
+BOOST_AUTO_TEST_CASE(storage_layout_suggestion)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract B { uint x; } contract C is B { uint128 a; uint b; uint128 c; function f() public view returns (uint) { return a + c; } }"}},
+		"settings": {
+			"outputSelection": {"A.sol": {"C": ["storageLayoutSuggestion"]}}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	Json const& suggestion = result["contracts"]["A.sol"]["C"]["storageLayoutSuggestion"];
+	BOOST_REQUIRE(suggestion.is_object());
+	BOOST_CHECK(suggestion["current"]["slots"] == "4");
+	BOOST_CHECK(suggestion["current"]["slotAccesses"] == 2);
+	BOOST_CHECK(suggestion["suggested"]["slots"] == "3");
+	BOOST_CHECK(suggestion["suggested"]["slotAccesses"] == 1);
+
+	std::vector<std::tuple<std::string, std::string, unsigned>> layout;
+	for (Json const& variable: suggestion["storage"])
+		layout.emplace_back(
+			variable["label"].get<std::string>(),
+			variable["slot"].get<std::string>(),
+			variable["offset"].get<unsigned>()
+		);
+	std::vector<std::tuple<std::string, std::string, unsigned>> expectedLayout{
+		{"x", "0", 0},
+		{"a", "1", 0},
+		{"c", "1", 16},
+		{"b", "2", 0}
+	};
+	BOOST_CHECK(layout == expectedLayout);
+}
+
+BOOST_AUTO_TEST_CASE(storage_access)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract C { uint a; uint b; mapping(uint => uint) m; function f() public { b = a + 1; } function g(uint k) public view returns (uint) { return m[k]; } }"}},
+		"settings": {
+			"viaIR": true,
+			"optimizer": {"enabled": true},
+			"outputSelection": {"A.sol": {"C": ["storageAccess"]}}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	Json const& storageAccess = result["contracts"]["A.sol"]["C"]["storageAccess"];
+	BOOST_REQUIRE(storageAccess.is_object());
+
+	Json const& f = storageAccess["f()"];
+	BOOST_CHECK(f["reads"] == Json::array({"0"}));
+	BOOST_CHECK(f["writes"] == Json::array({"1"}));
+	BOOST_CHECK(f["dynamicReads"] == false);
+	BOOST_CHECK(f["dynamicWrites"] == false);
+	BOOST_CHECK(f["coldAccesses"] == 2);
+
+	Json const& g = storageAccess["g(uint256)"];
+	BOOST_CHECK(g["reads"] == Json::array());
+	BOOST_CHECK(g["writes"] == Json::array());
+	BOOST_CHECK(g["dynamicReads"] == true);
+	BOOST_CHECK(g["dynamicWrites"] == false);
+}
+
+BOOST_AUTO_TEST_CASE(batch_read_callback)
+{
+	std::map<std::string, std::string> files{
+		{"a.sol", "import \"c.sol\"; contract A {}"},
+		{"b.sol", "import \"c.sol\"; import \"d.sol\"; contract B {}"},
+		{"c.sol", "contract C {}"},
+		{"d.sol", "contract D {}"},
+	};
+	std::vector<std::vector<std::string>> batches;
+	std::vector<std::string> singleReads;
+	frontend::StandardCompiler compiler([&](std::string const&, std::string const& _path) {
+		singleReads.push_back(_path);
+		return ReadCallback::Result{true, "contract E {}"};
+	});
+	compiler.setBatchReadCallback([&](std::string const& _kind, std::vector<std::string> const& _paths) {
+		BOOST_TEST(_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile));
+		batches.push_back(_paths);
+		std::vector<ReadCallback::Result> results;
+		for (std::string const& path: _paths)
+			if (files.count(path))
+				results.push_back({true, files.at(path)});
+			else
+				results.push_back({false, "Not found."});
+		return results;
+	});
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"root.sol": {"content": "import \"a.sol\"; import \"b.sol\"; import \"e.sol\"; contract R {}"}},
+		"settings": {"outputSelection": {"*": {"": ["ast"]}}}
+	}
+	)";
+	Json result = compiler.compile(Json::parse(input));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_TEST(result["sources"].size() == 6);
+	BOOST_CHECK(batches == (std::vector<std::vector<std::string>>{{"a.sol", "b.sol", "e.sol"}, {"c.sol", "d.sol"}}));
+	// Only the import the batch callback could not load is requested again.
+	BOOST_TEST(singleReads == std::vector<std::string>{"e.sol"});
+}
+
+BOOST_AUTO_TEST_CASE(invalid_profiling)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "contract A {}"}},
+		"settings": {"profiling": "yes"}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profiling\" must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
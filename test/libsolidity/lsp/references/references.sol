@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+contract C
+{
+    uint counter;
+    //   ^^^^^^^ @CounterDeclaration
+
+    function increment(uint by) public returns (uint)
+    //       ^^^^^^^^^ @IncrementDeclaration
+    {
+        counter += by;
+    //  ^^^^^^^ @CounterInIncrement
+        return counter;
+    //         ^^^^^^^ @CounterInReturn
+    }
+
+    function twice() public
+    {
+        increment(1);
+    //  ^^^^^^^^^ @FirstIncrementCall
+        this.increment(counter);
+    //       ^^^^^^^^^ @SecondIncrementCall
+    //                 ^^^^^^^ @CounterAsArgument
+    }
+}
+// ----
+// -> textDocument/references {
+//     "context": { "includeDeclaration": true },
+//     "position": @CounterInIncrement
+// }
+// <- [
+//     {
+//         "range": @CounterDeclaration,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @CounterInIncrement,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @CounterInReturn,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @CounterAsArgument,
+//         "uri": "references.sol"
+//     }
+// ]
+// -> textDocument/references {
+//     "context": { "includeDeclaration": false },
+//     "position": @CounterDeclaration
+// }
+// <- [
+//     {
+//         "range": @CounterInIncrement,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @CounterInReturn,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @CounterAsArgument,
+//         "uri": "references.sol"
+//     }
+// ]
+// -> textDocument/references {
+//     "context": { "includeDeclaration": false },
+//     "position": @FirstIncrementCall
+// }
+// <- [
+//     {
+//         "range": @FirstIncrementCall,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @SecondIncrementCall,
+//         "uri": "references.sol"
+//     }
+// ]
+// -> textDocument/references {
+//     "context": { "includeDeclaration": true },
+//     "position": @SecondIncrementCall
+// }
+// <- [
+//     {
+//         "range": @IncrementDeclaration,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @FirstIncrementCall,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @SecondIncrementCall,
+//         "uri": "references.sol"
+//     }
+// ]
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+interface IToken
+//        ^^^^^^ @IToken
+{
+    function totalSupply() external view returns (uint);
+//           ^^^^^^^^^^^ @ITokenTotalSupply
+}
+
+contract Token is IToken
+//       ^^^^^ @Token
+{
+    uint constant MAX_SUPPLY = 1000;
+//                ^^^^^^^^^^ @MaxSupply
+    uint supply;
+//       ^^^^^^ @Supply
+
+    event Minted(uint amount);
+//        ^^^^^^ @Minted
+
+    function totalSupply() external view override returns (uint) { return supply; }
+//           ^^^^^^^^^^^ @TokenTotalSupply
+}
+
+function tokenSupply(IToken _token) view returns (uint)
+//       ^^^^^^^^^^^ @FreeTokenSupply
+{
+    return _token.totalSupply();
+}
@@ -0,0 +1,25 @@
+pragma abicoder v2;
+
+type Price is uint256;
+
+contract C {
+	function f(uint[] memory a, bytes32[2] memory b, Price[] memory c) public pure returns (uint, uint, uint, bytes32, bytes32, uint, uint) {
+		return (a.length, a[0], a[a.length - 1], b[0], b[1], c.length, Price.unwrap(c[1]));
+	}
+
+	function g(bytes memory _data) public pure returns (uint, uint, uint) {
+		uint[] memory a = abi.decode(_data, (uint[]));
+		return (a.length, a[0], a[2]);
+	}
+
+	function h(uint[] memory a) public pure returns (uint[] memory) {
+		return a;
+	}
+}
+// ====
+// codeGenerationOptimizations: copyABIDecodedArrays
+// ----
+// f(uint256[],bytes32[2],uint256[]): 0x80, 0x0b, 0x0c, 0x100, 3, 1, 2, 3, 2, 7, 8 -> 3, 1, 3, 0x0b, 0x0c, 2, 8
+// g(bytes): 0x20, 0xa0, 0x20, 3, 4, 5, 6 -> 3, 4, 6
+// h(uint256[]): 0x20, 2, 5, 6 -> 0x20, 2, 5, 6
+// h(uint256[]): 0x20, 0 -> 0x20, 0
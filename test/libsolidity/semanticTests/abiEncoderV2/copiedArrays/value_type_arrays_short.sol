@@ -0,0 +1,20 @@
+pragma abicoder v2;
+
+contract C {
+	function f(uint[] memory) public pure {}
+
+	function g(bytes memory _data) public pure {
+		abi.decode(_data, (bytes32[]));
+	}
+}
+// ====
+// codeGenerationOptimizations: copyABIDecodedArrays
+// revertStrings: debug
+// ----
+// f(uint256[]): 0x20, 0 ->
+// f(uint256[]): 0x20, 1, 7 ->
+// f(uint256[]): 0x20, 1 -> FAILURE, hex"08c379a0", 0x20, 0x2b, "ABI decoding: invalid calldata a", "rray stride"
+// f(uint256[]): 0x20, 3, 7, 8 -> FAILURE, hex"08c379a0", 0x20, 0x2b, "ABI decoding: invalid calldata a", "rray stride"
+// f(uint256[]): 0x20, 0x10000000000000000 -> FAILURE, hex"4e487b71", 0x41
+// g(bytes): 0x20, 0x60, 0x20, 1, 7 ->
+// g(bytes): 0x20, 0x40, 0x20, 1 -> FAILURE, hex"08c379a0", 0x20, 0x2b, "ABI decoding: invalid calldata a", "rray stride"
@@ -0,0 +1,39 @@
+pragma abicoder v2;
+
+contract C {
+	enum E { A, B, C }
+	struct S { int16 a; bool b; address c; E d; bytes2 e; uint256 f; }
+
+	function sum(S memory s) external pure returns (int) {
+		return s.a + int(s.f);
+	}
+
+	function members(S memory s) external pure returns (int16, bool, address, E, bytes2) {
+		return (s.a, s.b, s.c, s.d, s.e);
+	}
+
+	function twice(uint x, S memory s, uint y) external pure returns (uint, int16, uint, uint) {
+		return (x, s.a, s.f + s.f, y);
+	}
+
+	function modified(S memory s) external pure returns (int16, uint) {
+		s.a = 7;
+		return (s.a, s.f);
+	}
+}
+// ====
+// codeGenerationOptimizations: decodeReadOnlyStructsFromCalldata
+// ----
+// sum((int16,bool,address,uint8,bytes2,uint256)): 1, true, 0x1234, 2, "ab", 10 -> 11
+// sum((int16,bool,address,uint8,bytes2,uint256)): -3, true, 0x1234, 2, "ab", 10 -> 7
+// members((int16,bool,address,uint8,bytes2,uint256)): -1, false, 0x1234, 1, "ab", 10 -> -1, false, 0x1234, 1, "ab"
+// twice(uint256,(int16,bool,address,uint8,bytes2,uint256),uint256): 5, 1, true, 0x1234, 2, "ab", 10, 6 -> 5, 1, 20, 6
+// modified((int16,bool,address,uint8,bytes2,uint256)): 1, true, 0x1234, 2, "ab", 10 -> 7, 10
+// sum((int16,bool,address,uint8,bytes2,uint256)): 0x8000, true, 0x1234, 2, "ab", 10 -> FAILURE
+// sum((int16,bool,address,uint8,bytes2,uint256)): 1, 2, 0x1234, 2, "ab", 10 -> FAILURE
+// sum((int16,bool,address,uint8,bytes2,uint256)): 1, true, 0x10000000000000000000000000000000000000000, 2, "ab", 10 -> FAILURE
+// sum((int16,bool,address,uint8,bytes2,uint256)): 1, true, 0x1234, 3, "ab", 10 -> FAILURE
+// sum((int16,bool,address,uint8,bytes2,uint256)): 1, true, 0x1234, 2, "abc", 10 -> FAILURE
+// sum((int16,bool,address,uint8,bytes2,uint256)): 1, true, 0x1234, 2, "ab" -> FAILURE
+// members((int16,bool,address,uint8,bytes2,uint256)): 1, 2, 0x1234, 2, "ab", 10 -> FAILURE
+// twice(uint256,(int16,bool,address,uint8,bytes2,uint256),uint256): 5, 1, true, 0x1234, 3, "ab", 10, 6 -> FAILURE
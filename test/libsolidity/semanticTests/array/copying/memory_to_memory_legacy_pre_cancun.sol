@@ -0,0 +1,38 @@
+// Copies memory with a loop, since mcopy is not available.
+pragma abicoder v1;
+
+contract C {
+    // Memory past the free memory pointer may be dirty, the copies must not rely on it being zero.
+    function dirtyFreeMemory() internal pure {
+        assembly {
+            let p := mload(0x40)
+            for { let i := 0 } lt(i, 0x200) { i := add(i, 0x20) } { mstore(add(p, i), not(0)) }
+        }
+    }
+
+    function packed(bytes memory a, bytes memory b) public pure returns (bytes memory) {
+        dirtyFreeMemory();
+        return abi.encodePacked(a, b);
+    }
+
+    function encoded(bytes memory a) public pure returns (bytes memory) {
+        dirtyFreeMemory();
+        return abi.encode(a);
+    }
+
+    function words(uint16[] memory a) public pure returns (bytes memory) {
+        dirtyFreeMemory();
+        return abi.encodePacked(a);
+    }
+}
+// ====
+// EVMVersion: <cancun
+// ABIEncoderV1Only: true
+// compileViaYul: false
+// ----
+// packed(bytes,bytes): 0x40, 0x60, 0, 0 -> 0x20, 0
+// packed(bytes,bytes): 0x40, 0x80, 3, "abc", 33, "0123456789abcdef0123456789abcdef", "x" -> 0x20, 36, "abc0123456789abcdef0123456789abc", "defx"
+// encoded(bytes): 0x20, 3, "abc" -> 0x20, 0x60, 0x20, 3, "abc"
+// encoded(bytes): 0x20, 33, "0123456789abcdef0123456789abcdef", "x" -> 0x20, 0x80, 0x20, 33, "0123456789abcdef0123456789abcdef", "x"
+// words(uint16[]): 0x20, 0 -> 0x20, 0
+// words(uint16[]): 0x20, 3, 1, 2, 0xffff -> 0x20, 0x60, 1, 2, 0xffff
@@ -0,0 +1,68 @@
+contract C {
+    uint8 first;
+    uint24[5] fixedData;
+    bytes4[9] multiSlot;
+    uint128[] dynamicData;
+    uint8 last;
+
+    function setNeighbours() public {
+        first = 7;
+        last = 9;
+    }
+    function setFixed() public {
+        fixedData = [uint24(1), 2, 3, 4, 0xffffff];
+    }
+    function setMultiSlot() public {
+        multiSlot[0] = 0x01020304;
+        multiSlot[7] = 0x05060708;
+        multiSlot[8] = 0x090a0b0c;
+    }
+    function push(uint128 _value) public {
+        dynamicData.push(_value);
+    }
+    function getFixed() public view returns (uint24[5] memory) {
+        return fixedData;
+    }
+    function getMultiSlot() public view returns (bytes4, bytes4, bytes4) {
+        return (multiSlot[0], multiSlot[7], multiSlot[8]);
+    }
+    // Returns the length and the raw contents of the slots that held the elements.
+    function getDynamic() public view returns (uint length, uint slot0, uint slot1) {
+        length = dynamicData.length;
+        assembly {
+            mstore(0, dynamicData.slot)
+            let data := keccak256(0, 0x20)
+            slot0 := sload(data)
+            slot1 := sload(add(data, 1))
+        }
+    }
+    function del() public {
+        delete fixedData;
+        delete multiSlot;
+        delete dynamicData;
+    }
+    function neighbours() public view returns (uint8, uint8) {
+        return (first, last);
+    }
+    function delNeighbours() public {
+        delete first;
+        delete last;
+    }
+}
+// ----
+// setNeighbours() ->
+// setFixed() ->
+// setMultiSlot() ->
+// push(uint128): 1 ->
+// push(uint128): 2 ->
+// push(uint128): 3 ->
+// getFixed() -> 1, 2, 3, 4, 0xffffff
+// getMultiSlot() -> left(0x01020304), left(0x05060708), left(0x090a0b0c)
+// getDynamic() -> 3, 0x0200000000000000000000000000000001, 3
+// del() ->
+// getFixed() -> 0, 0, 0, 0, 0
+// getMultiSlot() -> 0, 0, 0
+// getDynamic() -> 0, 0, 0
+// neighbours() -> 7, 9
+// delNeighbours() ->
+// storageEmpty -> 1
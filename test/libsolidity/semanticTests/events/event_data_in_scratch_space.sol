@@ -0,0 +1,45 @@
+contract C {
+	event Zero(uint indexed a);
+	event One(uint a);
+	event Two(uint a, bytes32 b);
+	event Three(uint a, uint b, uint c);
+	event Mixed(string indexed s, uint a, bool b);
+
+	function f() public returns (uint[] memory r) {
+		r = new uint[](2);
+		r[0] = 7;
+		r[1] = 8;
+		emit Zero(1);
+		emit One(2);
+		emit Two(3, "x");
+		emit Three(4, 5, 6);
+		emit Mixed("abc", 9, true);
+		uint[] memory t = new uint[](1);
+		t[0] = 1;
+		r[1] += t[0];
+	}
+
+	function g() public returns (bool, uint) {
+		uint freeMemoryPointer;
+		uint zeroSlot;
+		assembly { freeMemoryPointer := mload(0x40) }
+		emit Two(1, bytes32(uint(2)));
+		bool unchangedPointer;
+		assembly {
+			unchangedPointer := eq(mload(0x40), freeMemoryPointer)
+			zeroSlot := mload(0x60)
+		}
+		return (unchangedPointer, zeroSlot);
+	}
+}
+// ====
+// codeGenerationOptimizations: encodeEventDataInScratchSpace
+// ----
+// f() -> 0x20, 2, 7, 9
+// ~ emit Zero(uint256): #0x01
+// ~ emit One(uint256): 0x02
+// ~ emit Two(uint256,bytes32): 0x03, "x"
+// ~ emit Three(uint256,uint256,uint256): 0x04, 0x05, 0x06
+// ~ emit Mixed(string,uint256,bool): #0x4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45, 0x09, true
+// g() -> true, 0
+// ~ emit Two(uint256,bytes32): 0x01, 0x02
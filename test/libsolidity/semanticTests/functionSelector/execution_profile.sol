@@ -0,0 +1,42 @@
+contract C {
+	function f0() external pure returns (uint) { return 0; }
+	function f1() external pure returns (uint) { return 1; }
+	function f2() external pure returns (uint) { return 2; }
+	function f3() external pure returns (uint) { return 3; }
+	function f4() external pure returns (uint) { return 4; }
+	function f5() external pure returns (uint) { return 5; }
+	function f6() external pure returns (uint) { return 6; }
+	function f7() external pure returns (uint) { return 7; }
+	function f8() external pure returns (uint) { return 8; }
+	function f9() external pure returns (uint) { return 9; }
+	function f10() external pure returns (uint) { return 10; }
+	function f11() external pure returns (uint) { return 11; }
+	function g(uint x, bool b) external pure returns (uint) { return b ? x : 0; }
+
+	fallback(bytes calldata _input) external returns (bytes memory) {
+		return abi.encode(uint(1000), _input.length);
+	}
+}
+// ====
+// codeGenerationOptimizations: splitSelectorSwitch
+// executionProfile: f7()=1000; f3()=20; f11()=10; g(uint256,bool)=5; h()=7
+// ----
+// f0() -> 0
+// f1() -> 1
+// f2() -> 2
+// f3() -> 3
+// f4() -> 4
+// f5() -> 5
+// f6() -> 6
+// f7() -> 7
+// f8() -> 8
+// f9() -> 9
+// f10() -> 10
+// f11() -> 11
+// g(uint256,bool): 7, true -> 7
+// g(uint256,bool): 7, false -> 0
+// () -> 1000, 0
+// (): hex"aabbcc" -> 1000, 3
+// (): hex"00000000" -> 1000, 4
+// (): hex"ffffffff" -> 1000, 4
+// (): hex"ffffffff00" -> 1000, 5
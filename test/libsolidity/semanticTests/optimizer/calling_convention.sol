@@ -0,0 +1,31 @@
+contract C {
+	function clean(uint x) internal pure returns (uint) {
+		return x & 0xffff;
+	}
+
+	function mix(uint a, uint b, uint c) internal pure returns (uint, uint) {
+		if (a > b)
+			return mix(b, a, c + 1);
+		return (clean(a) * c, clean(b) + c);
+	}
+
+	function f(uint a, uint b, uint c) public pure returns (uint, uint) {
+		return mix(a, b, c);
+	}
+
+	function g(uint n) public pure returns (uint r) {
+		for (uint i = 0; i < n; ++i)
+			(r, ) = mix(r + i, i, 2);
+	}
+}
+// ====
+// codeGenerationOptimizations: optimizeCallingConvention
+// ----
+// f(uint256,uint256,uint256): 5, 3, 2 -> 9, 8
+// f(uint256,uint256,uint256): 1, 2, 3 -> 3, 5
+// f(uint256,uint256,uint256): 0x10005, 0x20003, 1 -> 5, 4
+// g(uint256): 0 -> 0
+// g(uint256): 1 -> 0
+// g(uint256): 2 -> 2
+// g(uint256): 3 -> 6
+// g(uint256): 4 -> 9
@@ -0,0 +1,47 @@
+contract C {
+	function sumTo(uint n, uint acc) internal pure returns (uint) {
+		if (n == 0)
+			return acc;
+		return sumTo(n - 1, acc + n);
+	}
+
+	function collatzSteps(uint n, uint steps) internal pure returns (uint) {
+		if (n == 1)
+			return steps;
+		if (n % 2 == 0)
+			return collatzSteps(n / 2, steps + 1);
+		return collatzSteps(3 * n + 1, steps + 1);
+	}
+
+	function pick(uint selector, uint a, uint b) internal pure returns (uint, uint) {
+		if (selector == 0)
+			return (a, b);
+		if (selector == 1)
+			return (b, a);
+		return (a + b, a * b);
+	}
+
+	function f(uint n) public pure returns (uint) {
+		return sumTo(n, 0);
+	}
+
+	function g(uint n) public pure returns (uint) {
+		return collatzSteps(n, 0);
+	}
+
+	function h(uint selector, uint a, uint b) public pure returns (uint, uint) {
+		return pick(selector, a, b);
+	}
+}
+// ====
+// codeGenerationOptimizations: optimizeFunctionExits
+// ----
+// f(uint256): 0 -> 0
+// f(uint256): 10 -> 55
+// f(uint256): 30 -> 465
+// g(uint256): 1 -> 0
+// g(uint256): 6 -> 8
+// g(uint256): 9 -> 19
+// h(uint256,uint256,uint256): 0, 3, 4 -> 3, 4
+// h(uint256,uint256,uint256): 1, 3, 4 -> 4, 3
+// h(uint256,uint256,uint256): 2, 3, 4 -> 7, 12
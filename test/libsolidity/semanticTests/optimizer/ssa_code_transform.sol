@@ -0,0 +1,42 @@
+contract C {
+	function fib(uint n) public pure returns (uint) {
+		if (n < 2)
+			return n;
+		return fib(n - 1) + fib(n - 2);
+	}
+
+	function sumOfSquares(uint n) public pure returns (uint sum) {
+		for (uint i = 1; i <= n; ++i)
+		{
+			if (i % 3 == 0)
+				continue;
+			sum += i * i;
+			if (sum > 1000)
+				break;
+		}
+	}
+
+	function sorted(uint a, uint b, uint c, uint d, uint e) public pure returns (uint x, uint y) {
+		x = a * b + c;
+		y = d - e;
+		if (x > y)
+			(x, y) = (y, x);
+	}
+
+	function div(uint a, uint b) public pure returns (uint) {
+		return a / b;
+	}
+}
+// ====
+// codeGenerationOptimizations: useSSACodeTransform
+// ----
+// fib(uint256): 0 -> 0
+// fib(uint256): 1 -> 1
+// fib(uint256): 10 -> 55
+// sumOfSquares(uint256): 5 -> 46
+// sumOfSquares(uint256): 100 -> 1001
+// sorted(uint256,uint256,uint256,uint256,uint256): 2, 3, 4, 10, 1 -> 9, 10
+// sorted(uint256,uint256,uint256,uint256,uint256): 1, 2, 3, 10, 1 -> 5, 9
+// sorted(uint256,uint256,uint256,uint256,uint256): 1, 2, 3, 1, 10 -> FAILURE, hex"4e487b71", 0x11
+// div(uint256,uint256): 7, 2 -> 3
+// div(uint256,uint256): 7, 0 -> FAILURE, hex"4e487b71", 0x12
@@ -0,0 +1,64 @@
+contract C {
+    struct S {
+        uint8 a;
+        bool b;
+        address c;
+        uint256 d;
+        uint16 e;
+        bytes4 f;
+        uint128[2] g;
+    }
+    uint8 first;
+    S s;
+    uint8 last;
+
+    function setPacked() public {
+        s.a = 1;
+        s.b = true;
+        s.c = address(uint160(0x1234));
+        s.e = 3;
+        s.f = 0x01020304;
+    }
+    function setFull() public {
+        s.d = 2;
+        s.g = [uint128(4), 5];
+    }
+    function setNeighbours() public {
+        first = 7;
+        last = 9;
+    }
+    // Also sets the bytes of the packed slots that do not belong to any member.
+    function dirtyPackedSlots() public {
+        assembly {
+            sstore(s.slot, not(0))
+            sstore(add(s.slot, 2), not(0))
+        }
+    }
+    function get() public view returns (uint8, bool, address, uint256, uint16, bytes4, uint128, uint128) {
+        return (s.a, s.b, s.c, s.d, s.e, s.f, s.g[0], s.g[1]);
+    }
+    function del() public {
+        delete s;
+    }
+    function neighbours() public view returns (uint8, uint8) {
+        return (first, last);
+    }
+    function delNeighbours() public {
+        delete first;
+        delete last;
+    }
+}
+// ----
+// setPacked() ->
+// setFull() ->
+// setNeighbours() ->
+// get() -> 1, true, 0x1234, 2, 3, left(0x01020304), 4, 5
+// del() ->
+// get() -> 0, false, 0, 0, 0, 0, 0, 0
+// neighbours() -> 7, 9
+// dirtyPackedSlots() ->
+// del() ->
+// get() -> 0, false, 0, 0, 0, 0, 0, 0
+// neighbours() -> 7, 9
+// delNeighbours() ->
+// storageEmpty -> 1
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the graph algorithms.
+ */
+
+#include <libsolutil/Algorithms.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+std::vector<std::vector<int>> components(std::map<int, std::vector<int>> const& _graph)
+{
+	StronglyConnectedComponents<int> scc;
+	for (auto const& [vertex, children]: _graph)
+		scc.run(vertex, [&](int _vertex, auto&& _addChild) {
+			for (int child: _graph.at(_vertex))
+				_addChild(child);
+		});
+	for (std::vector<int>& component: scc.components)
+		std::sort(component.begin(), component.end());
+	return scc.components;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(AlgorithmsTest)
+
+BOOST_AUTO_TEST_CASE(scc_chain)
+{
+	std::vector<std::vector<int>> expected{{3}, {2}, {1}};
+	BOOST_CHECK(components({{1, {2}}, {2, {3}}, {3, {}}}) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(scc_cycles)
+{
+	// 1 -> 2 -> 3 -> 1 calls into the cycle 4 <-> 5, 6 calls itself.
+	std::map<int, std::vector<int>> graph{
+		{1, {2}},
+		{2, {3}},
+		{3, {1, 4}},
+		{4, {5}},
+		{5, {4}},
+		{6, {6, 1}}
+	};
+	std::vector<std::vector<int>> expected{{4, 5}, {1, 2, 3}, {6}};
+	BOOST_CHECK(components(graph) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(scc_deep)
+{
+	// Long chains must not overflow the stack.
+	std::map<int, std::vector<int>> graph;
+	for (int i = 0; i < 100000; ++i)
+		graph[i] = {i + 1};
+	graph[100000] = {0};
+	std::vector<std::vector<int>> result = components(graph);
+	BOOST_REQUIRE_EQUAL(result.size(), 1);
+	BOOST_CHECK_EQUAL(result.front().size(), 100001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(allocations_are_aligned_and_disjoint)
+{
+	Arena arena(256);
+	std::vector<std::pair<std::byte*, size_t>> allocations;
+	for (size_t i = 0; i < 200; ++i)
+	{
+		size_t size = 1 + i % 13;
+		size_t alignment = size_t(1) << (i % 5);
+		auto* memory = static_cast<std::byte*>(arena.allocate(size, alignment));
+		BOOST_TEST(reinterpret_cast<std::uintptr_t>(memory) % alignment == 0);
+		for (auto const& [otherMemory, otherSize]: allocations)
+			BOOST_TEST((memory + size <= otherMemory || otherMemory + otherSize <= memory));
+		allocations.emplace_back(memory, size);
+	}
+	BOOST_TEST(arena.numBlocks() > 1);
+}
+
+BOOST_AUTO_TEST_CASE(large_allocations_get_dedicated_blocks)
+{
+	Arena arena(256);
+	arena.allocate(8, 8);
+	BOOST_TEST(arena.numBlocks() == 1);
+	auto* large = static_cast<std::byte*>(arena.allocate(1000, 64));
+	BOOST_TEST(reinterpret_cast<std::uintptr_t>(large) % 64 == 0);
+	BOOST_TEST(arena.numBlocks() == 2);
+	// The current block is still used for small allocations.
+	arena.allocate(8, 8);
+	BOOST_TEST(arena.numBlocks() == 2);
+	BOOST_TEST(arena.allocatedBytes() == 1016);
+}
+
+BOOST_AUTO_TEST_CASE(allocate_shared_from_arena)
+{
+	Arena arena;
+	Arena otherArena;
+	BOOST_TEST((ArenaAllocator<int>(arena) == ArenaAllocator<std::string>(arena)));
+	BOOST_TEST((ArenaAllocator<int>(arena) != ArenaAllocator<int>(otherArena)));
+
+	auto value = std::allocate_shared<std::string>(ArenaAllocator<std::string>(arena), "a string long enough to not be stored inline");
+	BOOST_TEST(arena.allocatedBytes() > sizeof(std::string));
+	BOOST_TEST(*value == "a string long enough to not be stored inline");
+	std::weak_ptr<std::string> weakValue = value;
+	value.reset();
+	BOOST_TEST(weakValue.expired());
+	BOOST_TEST(otherArena.allocatedBytes() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Cancellation.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(CancellationTest)
+
+BOOST_AUTO_TEST_CASE(check_without_active_token)
+{
+	CancellationToken token;
+	token.cancel();
+	BOOST_CHECK_NO_THROW(CancellationToken::check());
+}
+
+BOOST_AUTO_TEST_CASE(cancel)
+{
+	CancellationToken token;
+	CancellationToken::Activation activation(&token);
+	BOOST_CHECK_NO_THROW(CancellationToken::check());
+	token.cancel();
+	BOOST_TEST(token.cancelled());
+	BOOST_TEST(!token.expired());
+	BOOST_CHECK_THROW(CancellationToken::check(), CompilationCancelled);
+}
+
+BOOST_AUTO_TEST_CASE(time_budget)
+{
+	CancellationToken unlimited;
+	BOOST_TEST(!unlimited.cancelled());
+	CancellationToken expired(std::chrono::steady_clock::duration::zero());
+	BOOST_TEST(expired.expired());
+	BOOST_TEST(expired.cancelled());
+}
+
+BOOST_AUTO_TEST_CASE(parent)
+{
+	CancellationToken parent;
+	CancellationToken child(std::chrono::hours(1), &parent);
+	BOOST_TEST(!child.cancelled());
+	parent.cancel();
+	BOOST_TEST(child.cancelled());
+	BOOST_TEST(!child.expired());
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_tasks_inherit_token)
+{
+	CancellationToken token;
+	token.cancel();
+	ThreadPool pool(2);
+	std::future<void> withoutToken = pool.submit([]() { CancellationToken::check(); });
+	std::future<void> withToken;
+	{
+		CancellationToken::Activation activation(&token);
+		withToken = pool.submit([]() { CancellationToken::check(); });
+	}
+	BOOST_CHECK_NO_THROW(withoutToken.get());
+	BOOST_CHECK_THROW(withToken.get(), CompilationCancelled);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,6 +26,7 @@
 
 #include <test/Common.h>
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/test/unit_test.hpp>
 
 using namespace solidity::frontend;
@@ -96,6 +97,36 @@ BOOST_AUTO_TEST_CASE(tohex_bytes)
 	BOOST_CHECK_EQUAL(toHex(fromHex("00112233445566778899aAbBcCdDeEfF"), HexPrefix::Add, static_cast<HexCase>(42)), "0x00112233445566778899aabbccddeeff");
 }
 
+BOOST_AUTO_TEST_CASE(hex_long_strings)
+{
+	// Long enough to exercise the vectorized code paths and their scalar tails.
+	bytes data;
+	std::string lowerHex;
+	for (size_t i = 0; i < 300; ++i)
+	{
+		data.push_back(static_cast<uint8_t>(i * 37));
+		lowerHex += toHex(static_cast<uint8_t>(i * 37));
+	}
+	for (size_t length = 0; length <= data.size(); length += 7)
+	{
+		bytes prefix(data.begin(), data.begin() + static_cast<ptrdiff_t>(length));
+		std::string hex = lowerHex.substr(0, 2 * length);
+		BOOST_CHECK_EQUAL(toHex(prefix), hex);
+		BOOST_CHECK_EQUAL(toHex(prefix, HexPrefix::Add, HexCase::Upper), "0x" + boost::to_upper_copy(hex));
+		BOOST_CHECK_EQUAL(fromHex(hex), prefix);
+		BOOST_CHECK_EQUAL(fromHex("0x" + boost::to_upper_copy(hex)), prefix);
+	}
+
+	for (size_t position = 0; position < 70; ++position)
+		for (char invalid: {'g', 'G', '/', ':', '@', '`', ' '})
+		{
+			std::string hex = lowerHex.substr(0, 70);
+			hex[position] = invalid;
+			BOOST_CHECK_EQUAL(fromHex(hex), bytes());
+			BOOST_CHECK_THROW(fromHex(hex, WhenError::Throw), BadHexCharacter);
+		}
+}
+
 BOOST_AUTO_TEST_CASE(test_format_number)
 {
 	BOOST_CHECK_EQUAL(formatNumber(u256(0x8000000)), "0x08000000");
@@ -915,6 +915,114 @@ BOOST_AUTO_TEST_CASE(no_edges)
 	BOOST_TEST(dominatorFinder.dominatorTree() == test.expectedDominatorTree);
 }
 
+BOOST_AUTO_TEST_CASE(dominance_frontier)
+{
+	// Same graph as in immediate_dominator_1.
+	DominatorFinderTest test(
+		{"A", "B", "C", "D", "E", "F", "G", "H"},
+		{
+			Edge("A", "B"),
+			Edge("B", "C"),
+			Edge("B", "D"),
+			Edge("C", "D"),
+			Edge("C", "G"),
+			Edge("D", "E"),
+			Edge("E", "F"),
+			Edge("G", "H"),
+			Edge("H", "F")
+		},
+		{
+			{"A", ""},
+			{"B", "A"},
+			{"C", "B"},
+			{"D", "B"},
+			{"E", "D"},
+			{"F", "B"},
+			{"G", "C"},
+			{"H", "G"}
+		},
+		{
+			{"A", 0},
+			{"B", 1},
+			{"C", 2},
+			{"D", 3},
+			{"E", 4},
+			{"F", 5},
+			{"G", 6},
+			{"H", 7}
+		},
+		{
+			{"A", {"B"}},
+			{"B", {"C", "D", "F"}},
+			{"C", {"G"}},
+			{"D", {"E"}},
+			{"G", {"H"}}
+		}
+	);
+
+	TestDominatorFinder dominatorFinder(*test.entry);
+	BOOST_TEST(dominatorFinder.dominanceFrontiers() == test.vertexMapToVertexId({
+		{"C", {"D", "F"}},
+		{"D", {"F"}},
+		{"E", {"F"}},
+		{"G", {"F"}},
+		{"H", {"F"}}
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(dominance_frontier_loop_to_entry)
+{
+	//   ┌──►A──┐
+	//   │     ▼
+	//   └─────B
+	DominatorFinderTest test(
+		{"A", "B"},
+		{
+			Edge("A", "B"),
+			Edge("B", "A")
+		},
+		{
+			{"A", ""},
+			{"B", "A"}
+		},
+		{
+			{"A", 0},
+			{"B", 1}
+		},
+		{
+			{"A", {"B"}}
+		}
+	);
+
+	TestDominatorFinder dominatorFinder(*test.entry);
+	BOOST_TEST(dominatorFinder.dominanceFrontiers() == test.vertexMapToVertexId({
+		{"A", {"A"}},
+		{"B", {"A"}}
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(long_chain)
+{
+	// Deep enough to overflow the stack of a recursive depth-first search.
+	size_t const numVertices = 200000;
+	std::vector<TestVertex> vertices(numVertices);
+	for (size_t i = 0; i < numVertices; ++i)
+	{
+		vertices[i].id = i;
+		if (i > 0)
+			vertices[i - 1].successors.emplace_back(&vertices[i]);
+	}
+	// A back edge to the entry makes every vertex part of a loop headed by it.
+	vertices.back().successors.emplace_back(&vertices.front());
+
+	TestDominatorFinder dominatorFinder(vertices.front());
+	BOOST_TEST(dominatorFinder.verticesIdsInDFSOrder().size() == numVertices);
+	BOOST_TEST(dominatorFinder.dominates(TestVertexId(1), TestVertexId(numVertices - 1)));
+	BOOST_TEST(!dominatorFinder.dominates(TestVertexId(numVertices - 1), TestVertexId(1)));
+	BOOST_CHECK(dominatorFinder.immediateDominatorsByDfsIndex().back() == numVertices - 2);
+	BOOST_CHECK(dominatorFinder.dominanceFrontiersByDfsIndex()[numVertices / 2] == std::vector<size_t>{0});
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::util::test
@@ -0,0 +1,142 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for FixedU256, checked against the boost based u256.
+ */
+
+#include <libsolutil/FixedU256.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// @returns values around the limb boundaries and the extremes together with random values
+/// of all sizes.
+std::vector<u256> sampleValues()
+{
+	std::vector<u256> values{~u256(0)};
+	for (unsigned bits: {0u, 1u, 31u, 32u, 33u, 63u, 64u, 65u, 127u, 128u, 191u, 192u, 255u})
+	{
+		u256 power = u256(1) << bits;
+		values.push_back(power);
+		values.push_back(power - 1);
+		values.push_back(power + 1);
+		values.push_back(~u256(0) - power);
+	}
+
+	std::mt19937_64 generator(42);
+	for (unsigned bits = 1; bits <= 256; bits += 7)
+	{
+		u256 value = 0;
+		for (size_t i = 0; i < 4; ++i)
+			value = (value << 64) | u256(generator());
+		values.push_back(bits == 256 ? value : value & ((u256(1) << bits) - 1));
+	}
+	return values;
+}
+
+u256 roundTrip(FixedU256 const& _value) { return _value.toU256(); }
+
+}
+
+BOOST_AUTO_TEST_SUITE(FixedU256Test)
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+	for (u256 const& value: sampleValues())
+	{
+		BOOST_TEST(roundTrip(FixedU256(value)) == value);
+		BOOST_TEST(FixedU256(value).limb(0) == uint64_t(value & std::numeric_limits<uint64_t>::max()));
+		BOOST_TEST(FixedU256(value).isZero() == (value == 0));
+		BOOST_TEST(FixedU256(value).bitLength() == (value == 0 ? 0 : boost::multiprecision::msb(value) + 1));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic)
+{
+	for (u256 const& a: sampleValues())
+		for (u256 const& b: sampleValues())
+		{
+			FixedU256 fixedA(a);
+			FixedU256 fixedB(b);
+			BOOST_TEST(roundTrip(fixedA + fixedB) == u256(a + b));
+			BOOST_TEST(roundTrip(fixedA - fixedB) == u256(a - b));
+			BOOST_TEST(roundTrip(fixedA * fixedB) == u256(a * b));
+			BOOST_TEST(roundTrip(fixedA & fixedB) == u256(a & b));
+			BOOST_TEST(roundTrip(fixedA | fixedB) == u256(a | b));
+			BOOST_TEST(roundTrip(fixedA ^ fixedB) == u256(a ^ b));
+			BOOST_TEST((fixedA < fixedB) == (a < b));
+			BOOST_TEST((fixedA == fixedB) == (a == b));
+			if (b != 0)
+			{
+				BOOST_TEST(roundTrip(fixedA / fixedB) == u256(a / b));
+				BOOST_TEST(roundTrip(fixedA % fixedB) == u256(a % b));
+				BOOST_TEST(roundTrip(FixedU256::signedDiv(fixedA, fixedB)) == s2u(u2s(a) / u2s(b)));
+				BOOST_TEST(roundTrip(FixedU256::signedMod(fixedA, fixedB)) == s2u(u2s(a) % u2s(b)));
+			}
+		}
+}
+
+BOOST_AUTO_TEST_CASE(modular_arithmetic)
+{
+	std::vector<u256> values = sampleValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+			for (u256 const& modulus: {u256(1), u256(3), u256(1) << 64, values.back(), ~u256(0)})
+			{
+				BOOST_TEST(
+					roundTrip(FixedU256::addMod(FixedU256(a), FixedU256(b), FixedU256(modulus))) ==
+					u256((bigint(a) + bigint(b)) % modulus)
+				);
+				BOOST_TEST(
+					roundTrip(FixedU256::mulMod(FixedU256(a), FixedU256(b), FixedU256(modulus))) ==
+					u256((bigint(a) * bigint(b)) % modulus)
+				);
+			}
+}
+
+BOOST_AUTO_TEST_CASE(exponentiation)
+{
+	for (u256 const& base: sampleValues())
+		for (u256 const& exponent: {u256(0), u256(1), u256(2), u256(255), u256(256), ~u256(0)})
+			BOOST_TEST(
+				roundTrip(FixedU256::exp(FixedU256(base), FixedU256(exponent))) ==
+				u256(boost::multiprecision::powm(bigint(base), bigint(exponent), bigint(1) << 256))
+			);
+}
+
+BOOST_AUTO_TEST_CASE(shifts)
+{
+	for (u256 const& value: sampleValues())
+		for (size_t shift: std::vector<size_t>{0, 1, 31, 63, 64, 65, 128, 200, 255, 256, 300})
+		{
+			BOOST_TEST(roundTrip(FixedU256(value) << shift) == (shift >= 256 ? u256(0) : u256(value << shift)));
+			BOOST_TEST(roundTrip(FixedU256(value) >> shift) == (shift >= 256 ? u256(0) : u256(value >> shift)));
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -105,6 +105,24 @@ BOOST_AUTO_TEST_CASE(test_multi_level_tree)
 	BOOST_CHECK_EQUAL(ipfsHashBase58(data), "QmaTb1sT9hrSXJLmf8bxJ9NuwndiHuMLsgNLgkS2eXu3Xj");
 }
 
+BOOST_AUTO_TEST_CASE(test_incremental)
+{
+	// Crosses the chunk size of 256 KiB and the maximum number of links per node.
+	for (size_t length: std::vector<size_t>{0, 1, 262144, 262145, 1310710, 45613057})
+	{
+		std::string data;
+		for (size_t i = 0; i < length; i++)
+			data.push_back(char(i % 251));
+		for (size_t pieceSize: std::vector<size_t>{1000, 262144, 300000})
+		{
+			IpfsHasher hasher;
+			for (size_t offset = 0; offset < length; offset += pieceSize)
+				hasher.append(bytesConstRef(data).cropped(offset, std::min(pieceSize, length - offset)));
+			BOOST_CHECK(hasher.finish() == ipfsHash(data));
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
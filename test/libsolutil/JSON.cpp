@@ -117,6 +117,22 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK(R"({"1":1,"2":"2","3":{"3.1":"3.1","3.2":2},"4":"\u0911 \u0912 \u0913 \u0914 \u0915 \u0916","5":"\u0010","6":"\u4e2d"})" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_print_to_stream)
+{
+	Json json;
+	json["1"] = 1;
+	json["2"] = Json::array({"2", Json::object({{"3", nullptr}})});
+	json["4"] = "ऑ ऒ ओ औ क ख";
+	json["5"] = "\x10";
+
+	for (JsonFormat format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		std::stringstream stream;
+		jsonPrint(stream, json, format);
+		BOOST_CHECK(stream.str() == jsonPrint(json, format));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
@@ -166,6 +182,38 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "\xF0\x9F\x98\x8A");
 }
 
+BOOST_AUTO_TEST_CASE(json_binary)
+{
+	Json input;
+	BOOST_REQUIRE(jsonParseStrict(
+		"{\"id\":7,\"nodeType\":\"SourceUnit\",\"nodes\":[{\"isPure\":true,\"value\":-1.5}],\"license\":null,\"src\":\"0:12:0\"}",
+		input
+	));
+
+	std::string binary = jsonBinaryPrint(input);
+	BOOST_CHECK(isJsonBinary(binary));
+	BOOST_CHECK(binary.size() < jsonCompactPrint(input).size());
+
+	Json json;
+	std::string errors;
+	BOOST_CHECK(jsonParseBinary(binary, json, &errors));
+	BOOST_CHECK(json == input);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(json), jsonCompactPrint(input));
+
+	// JSON text is not mistaken for the binary format.
+	BOOST_CHECK(!isJsonBinary(jsonCompactPrint(input)));
+	BOOST_CHECK(!jsonParseBinary(jsonCompactPrint(input), json, &errors));
+
+	// Truncated input and unknown versions are rejected.
+	BOOST_CHECK(!jsonParseBinary(binary.substr(0, binary.size() - 1), json, &errors));
+	BOOST_CHECK(!jsonParseBinary(binary.substr(0, 4), json, &errors));
+	std::string otherVersion = binary;
+	otherVersion[4] = '\x02';
+	BOOST_CHECK(isJsonBinary(otherVersion));
+	BOOST_CHECK(!jsonParseBinary(otherVersion, json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Unsupported version of the binary JSON format.");
+}
+
 BOOST_AUTO_TEST_CASE(json_isOfType)
 {
 	Json json;
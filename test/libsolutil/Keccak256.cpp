@@ -68,6 +68,45 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(block_boundaries)
+{
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(135, 'a')),
+		FixedHash<32>("0x34367dc248bbd832f4e3e69dfaac2f92638bd0bbd18f2912ba4ef454919cf446")
+	);
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(136, 'a')),
+		FixedHash<32>("0xa6c4d403279fe3e0af03729caada8374b5ca54d8065329a3ebcaeb4b60aa386e")
+	);
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(137, 'a')),
+		FixedHash<32>("0xd869f639c7046b4929fc92a4d988a8b22c55fbadb802c0c66ebcd484f1915f39")
+	);
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(272, 'a')),
+		FixedHash<32>("0xcf7fcd4f705ee749930d19ca84561a9bf62516bd90a471545fa2f49fdc7e63c8")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(batch)
+{
+	std::vector<bytes> inputs;
+	for (size_t size = 0; size < 300; size += 13)
+		inputs.emplace_back(size, static_cast<uint8_t>(size));
+	inputs.emplace_back(asBytes("test"));
+
+	std::vector<bytesConstRef> refs;
+	for (bytes const& input: inputs)
+		refs.emplace_back(&input);
+	std::vector<h256> hashes = keccak256Batch(refs);
+
+	BOOST_REQUIRE(hashes.size() == inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	BOOST_CHECK_EQUAL(hashes.back(), FixedHash<32>("0x9c22ff5f21f0b81b113e63f7db6da94fedef11b2119b4088b89664fb9a3cb658"));
+	BOOST_CHECK(keccak256Batch({}).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
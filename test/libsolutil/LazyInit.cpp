@@ -114,6 +114,16 @@ BOOST_AUTO_TEST_CASE(move_constructed_has_same_value_as_original)
 	BOOST_CHECK_EQUAL(valueOf(std::move(moveConstructed)), 12);
 }
 
+BOOST_AUTO_TEST_CASE(reset_is_empty)
+{
+	LazyInit<int> lazyInit;
+	lazyInit.init([]{ return 12; });
+	lazyInit.reset();
+
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 42; }), 42);
+	assertNotEmpty(std::move(lazyInit));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
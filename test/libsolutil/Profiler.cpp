@@ -0,0 +1,157 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest)
+
+BOOST_AUTO_TEST_CASE(scopes_without_active_profiler_are_ignored)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope("ignored", "test");
+	}
+	BOOST_TEST(profiler.events().empty());
+}
+
+BOOST_AUTO_TEST_CASE(nested_scopes)
+{
+	Profiler profiler;
+	{
+		Profiler::Activation activation(&profiler);
+		Profiler::Scope outer("outer", "test", {{"contract", "C"}});
+		{
+			Profiler::Scope inner("inner", "test");
+		}
+	}
+	{
+		Profiler::Scope afterDeactivation("ignored", "test");
+	}
+	BOOST_TEST(Profiler::active() == nullptr);
+
+	std::vector<Profiler::Event> events = profiler.events();
+	BOOST_REQUIRE(events.size() == 2);
+	BOOST_TEST(events[0].name == "inner");
+	BOOST_TEST(events[1].name == "outer");
+	BOOST_TEST(events[1].category == "test");
+	BOOST_TEST(events[1].arguments.at("contract") == "C");
+	BOOST_TEST(events[0].start >= events[1].start);
+	BOOST_TEST(events[0].start + events[0].duration <= events[1].start + events[1].duration);
+}
+
+BOOST_AUTO_TEST_CASE(arguments_set_at_end_of_scope)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope("ignored", "test");
+		scope.setArgument("result", "unsat");
+	}
+	{
+		Profiler::Activation activation(&profiler);
+		Profiler::Scope scope("query", "test", {{"target", "assert"}});
+		scope.setArgument("result", "unsat");
+	}
+
+	std::vector<Profiler::Event> events = profiler.events();
+	BOOST_REQUIRE(events.size() == 1);
+	BOOST_TEST(events[0].arguments.at("target") == "assert");
+	BOOST_TEST(events[0].arguments.at("result") == "unsat");
+}
+
+BOOST_AUTO_TEST_CASE(threads)
+{
+	Profiler profiler;
+	Profiler::Activation activation(&profiler);
+	{
+		Profiler::Scope scope("main", "test");
+	}
+	std::thread worker([&]() {
+		{
+			Profiler::Scope scope("ignored", "test");
+		}
+		Profiler::Activation workerActivation(&profiler);
+		Profiler::Scope scope("worker", "test");
+	});
+	worker.join();
+
+	std::vector<Profiler::Event> events = profiler.events();
+	BOOST_REQUIRE(events.size() == 2);
+	BOOST_TEST(events[0].name == "main");
+	BOOST_TEST(events[0].thread == 0);
+	BOOST_TEST(events[1].name == "worker");
+	BOOST_TEST(events[1].thread == 1);
+}
+
+BOOST_AUTO_TEST_CASE(chrome_trace)
+{
+	Profiler profiler;
+	{
+		Profiler::Activation activation(&profiler);
+		Profiler::Scope scope("phase", "test", {{"contract", "C"}});
+	}
+
+	Json trace = profiler.chromeTrace();
+	BOOST_REQUIRE(trace["traceEvents"].is_array());
+	BOOST_REQUIRE(trace["traceEvents"].size() == 1);
+	Json const& event = trace["traceEvents"][0];
+	BOOST_TEST(event["name"] == "phase");
+	BOOST_TEST(event["cat"] == "test");
+	BOOST_TEST(event["ph"] == "X");
+	BOOST_TEST(event["ts"].is_number_integer());
+	BOOST_TEST(event["dur"].is_number_integer());
+	BOOST_TEST(event["tid"] == 0);
+	BOOST_TEST(event["args"]["contract"] == "C");
+	BOOST_TEST(event["args"]["peakMemoryIncrease"].is_number_unsigned());
+}
+
+BOOST_AUTO_TEST_CASE(counters)
+{
+	Profiler profiler;
+	Profiler::count("ignored");
+	{
+		Profiler::Activation activation(&profiler);
+		Profiler::count("hits");
+		Profiler::count("hits", 2);
+		Profiler::count("misses", 0);
+	}
+	Profiler::count("hits");
+
+	std::map<std::string, uint64_t> counters = profiler.counters();
+	BOOST_REQUIRE(counters.size() == 2);
+	BOOST_TEST(counters.at("hits") == 3);
+	BOOST_TEST(counters.at("misses") == 0);
+
+	Json trace = profiler.chromeTrace();
+	BOOST_TEST(trace["counters"]["hits"] == 3);
+	BOOST_REQUIRE(trace["traceEvents"].size() == 2);
+	Json const& event = trace["traceEvents"][0];
+	BOOST_TEST(event["name"] == "hits");
+	BOOST_TEST(event["ph"] == "C");
+	BOOST_TEST(event["args"]["value"] == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for SmallBytes and the conversions that produce it.
+ */
+
+#include <libsolutil/SmallBytes.h>
+#include <libsolutil/Numeric.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(SmallBytesTest)
+
+BOOST_AUTO_TEST_CASE(inline_storage)
+{
+	SmallBytes<4> data;
+	BOOST_TEST(data.empty());
+	for (uint8_t i = 1; i <= 4; ++i)
+		data.push_back(i);
+	BOOST_TEST(!data.onHeap());
+	BOOST_TEST(data.toBytes() == (bytes{1, 2, 3, 4}));
+
+	data.resize(2);
+	data.resize(3, 7);
+	BOOST_TEST(data.toBytes() == (bytes{1, 2, 7}));
+	BOOST_TEST(!data.onHeap());
+}
+
+BOOST_AUTO_TEST_CASE(heap_storage)
+{
+	bytes input{1, 2, 3, 4, 5, 6};
+	SmallBytes<4> data(bytesConstRef(input.data(), 3));
+	data.append(bytesConstRef(input.data() + 3, 3));
+	BOOST_TEST(data.onHeap());
+	BOOST_TEST(data.toBytes() == input);
+	BOOST_TEST(data.ref().toBytes() == input);
+
+	SmallBytes<4> copy = data;
+	copy[0] = 9;
+	BOOST_TEST(data[0] == 1);
+	BOOST_TEST(copy != data);
+	copy[0] = 1;
+	BOOST_TEST(copy == data);
+
+	data.resize(1);
+	BOOST_TEST(data.toBytes() == bytes{1});
+	BOOST_TEST(data == SmallBytes<4>(1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(compact_big_endian)
+{
+	for (u256 value: {u256(0), u256(1), u256(0x1234), u256(1) << 200, ~u256(0)})
+		for (unsigned minSize: {0u, 1u, 5u, 40u})
+		{
+			SmallBytes<32> encoded = toCompactBigEndianInline(value, minSize);
+			BOOST_TEST(encoded.toBytes() == toCompactBigEndian(value, minSize));
+			BOOST_TEST(encoded.onHeap() == (minSize > 32));
+		}
+	BOOST_TEST(toCompactBigEndianInline(bigint(1) << 300).toBytes() == toCompactBigEndian(bigint(1) << 300));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -72,6 +72,24 @@ BOOST_AUTO_TEST_CASE(test_dldistance)
 
 }
 
+BOOST_AUTO_TEST_CASE(test_bounded_dldistance)
+{
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "hello", 0), 0);
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "helol", 1), 1);
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "helol", 0), 1);
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "hllllo", 2), 2);
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "hllllo", 1), 2);
+	BOOST_CHECK_EQUAL(boundedStringDistance("a", "", 2), 1);
+	BOOST_CHECK_EQUAL(boundedStringDistance("", "", 2), 0);
+	BOOST_CHECK_EQUAL(boundedStringDistance("abc", "abcdef", 2), 3);
+	BOOST_CHECK_EQUAL(boundedStringDistance("abcd", "wxyz", 2), 3);
+	BOOST_CHECK_EQUAL(boundedStringDistance("abcdefghijklmnopqrstuvwxyz", "abcabcabcabcabcabcabcabca", 25), 23);
+	BOOST_CHECK_EQUAL(boundedStringDistance("abcdefghijklmnopqrstuvwxyz", "abcabcabcabcabcabcabcabca", 2), 3);
+	// A difference at the end must not be missed after rows within the bound.
+	BOOST_CHECK_EQUAL(boundedStringDistance(std::string(100, 'x') + "abc", std::string(100, 'x') + "bac", 1), 1);
+	BOOST_CHECK_EQUAL(boundedStringDistance(std::string(100, 'x') + "abc", std::string(100, 'x') + "cba", 1), 2);
+}
+
 BOOST_AUTO_TEST_CASE(test_alternatives_list)
 {
 	std::vector<std::string> strings;
@@ -102,6 +102,21 @@ BOOST_AUTO_TEST_CASE(bzz_hash_nonzero)
 	BOOST_CHECK_EQUAL(bzzr1HashHex(sequence(4096 * 130)), "59de730bf6c67a941f3b2ffa2f920acfaa1713695ad5deea12b4a121e5f23fa1");
 }
 
+BOOST_AUTO_TEST_CASE(bzz_hash_incremental)
+{
+	for (size_t length: std::vector<size_t>{0, 1, 4095, 4096, 4097, 4096 * 128, 4096 * 128 + 33, 4096 * 130})
+	{
+		bytes data = sequence(length);
+		for (size_t pieceSize: std::vector<size_t>{1, 63, 4096, 5000})
+		{
+			Bzzr1Hasher hasher;
+			for (size_t offset = 0; offset < length; offset += pieceSize)
+				hasher.append(bytesConstRef(&data).cropped(offset, std::min(pieceSize, length - offset)));
+			BOOST_CHECK_EQUAL(toHex(hasher.finish().asBytes()), bzzr1HashHex(data));
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
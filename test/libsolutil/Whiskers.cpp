@@ -240,6 +240,25 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(template_reused)
+{
+	std::string templ = "<?b><x><!b>-</b><#l>(<y>)</l>";
+	std::vector<std::map<std::string, std::string>> list(2);
+	list[0]["y"] = "1";
+	list[1]["y"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("b", true)("x", "X")("l", list).render(), "X(1)(2)");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("b", false)("x", "X")("l", std::vector<Whiskers::StringMap>{}).render(), "-");
+	Whiskers m(templ);
+	m("b", true)("l", list);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(unclosed_tags_kept)
+{
+	std::string templ = "<#l>x<?c>y<a>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A").render(), "<#l>x<?c>yA");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
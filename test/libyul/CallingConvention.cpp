@@ -0,0 +1,160 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the choice of calling conventions by the stack layout generator.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+#include <test/libyul/YulExecutionFramework.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/Object.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+
+#include <liblangutil/ErrorReporter.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <range/v3/view/map.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+std::string const helperHeavyCode = R"({
+	function cleanup(value) -> cleaned { cleaned := and(value, 0xffffffffffffffffffffffffffffffffffffffff) }
+	function validate(value) { if iszero(eq(value, cleanup(value))) { revert(0, 0) } }
+	function decode(offset) -> value { value := calldataload(offset) validate(value) }
+	function add_checked(x, y) -> sum {
+		sum := add(x, y)
+		if gt(x, sum) { revert(0, 0) }
+	}
+	let a := decode(4)
+	let b := decode(36)
+	let c := add_checked(cleanup(a), cleanup(b))
+	sstore(a, c)
+	sstore(b, add_checked(c, a))
+})";
+
+std::string const helperHeavyCodeWithResults = R"({
+	function cleanup(value) -> cleaned { cleaned := and(value, 0xffff) }
+	function add_checked(x, y) -> sum {
+		sum := add(x, y)
+		if gt(x, sum) { revert(0, 0) }
+	}
+	function combine(a, b, c) -> x, y {
+		x := add_checked(cleanup(a), mul(b, c))
+		y := sub(cleanup(c), b)
+	}
+	function accumulate(n) -> total {
+		for { let i := 0 } lt(i, n) { i := add(i, 1) } { total := add_checked(total, cleanup(add(i, 0x10000))) }
+	}
+	let x, y := combine(0x12345, 3, 7)
+	mstore(0, x)
+	mstore(32, y)
+	mstore(64, accumulate(5))
+	mstore(96, cleanup(add_checked(0xffff, 2)))
+	return(0, 128)
+})";
+
+std::string const overflowingCode = R"({
+	function add_checked(x, y) -> sum {
+		sum := add(x, y)
+		if gt(x, sum) { revert(0, 0) }
+	}
+	function twice(x) -> r { r := add_checked(x, x) }
+	mstore(0, twice(not(0)))
+	return(0, 32)
+})";
+}
+
+BOOST_AUTO_TEST_SUITE(CallingConvention)
+
+BOOST_AUTO_TEST_CASE(return_label_position_matches_chosen_convention)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(
+		solidity::test::CommonOptions::get().evmVersion(),
+		std::nullopt
+	);
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(helperHeavyCode, dialect, errors);
+	BOOST_REQUIRE(object && analysisInfo && !Error::containsErrors(errors));
+	std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(*analysisInfo, dialect, object->code()->root());
+
+	StackLayout defaultLayout = StackLayoutGenerator::run(*cfg);
+	BOOST_CHECK(defaultLayout.returnLabelAfterArguments.empty());
+
+	StackLayout layout = StackLayoutGenerator::run(*cfg, false, true);
+	for (auto&& [operation, entryLayout]: layout.operationEntryLayout)
+		if (auto const* call = std::get_if<CFG::FunctionCall>(&operation->operation); call && call->canContinue)
+		{
+			size_t labelOffset = layout.returnLabelAfterArguments.count(&call->function.get()) ?
+				entryLayout.size() - 1 :
+				entryLayout.size() - call->function.get().numArguments - 1;
+			BOOST_REQUIRE(labelOffset < entryLayout.size());
+			BOOST_CHECK(std::holds_alternative<FunctionCallReturnLabelSlot>(entryLayout.at(labelOffset)));
+		}
+	for (CFG::FunctionInfo const& functionInfo: cfg->functionInfo | ranges::views::values)
+	{
+		Stack entry = layout.functionEntryLayout(functionInfo);
+		BOOST_REQUIRE_EQUAL(entry.size(), functionInfo.parameters.size() + (functionInfo.canContinue ? 1 : 0));
+		if (functionInfo.canContinue)
+			BOOST_CHECK(std::holds_alternative<FunctionReturnLabelSlot>(
+				layout.returnLabelAfterArguments.count(&functionInfo.function) ? entry.back() : entry.front()
+			));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compiles_with_optimized_calling_convention)
+{
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::none();
+	settings.optimizeStackAllocation = true;
+	for (bool optimizeCallingConvention: {false, true})
+	{
+		settings.optimizeCallingConvention = optimizeCallingConvention;
+		BOOST_CHECK(!compileToBytecode(helperHeavyCode, settings).first.empty());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(CallingConventionExecution, YulExecutionFramework)
+
+BOOST_AUTO_TEST_CASE(optimized_calling_convention_preserves_results)
+{
+	m_optimiserSettings = frontend::OptimiserSettings::none();
+	m_optimiserSettings.optimizeStackAllocation = true;
+	for (bool optimizeCallingConvention: {false, true})
+	{
+		m_optimiserSettings.optimizeCallingConvention = optimizeCallingConvention;
+		ABI_CHECK(compileAndRun(helperHeavyCodeWithResults), encodeArgs(9050, 4, 10, 1));
+		compileAndRunWithoutCheck({{"", overflowingCode}});
+		BOOST_CHECK(!m_transactionSuccessful);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
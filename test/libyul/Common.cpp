@@ -29,6 +29,10 @@
 #include <libyul/YulStack.h>
 #include <libyul/AST.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMObjectCompiler.h>
+#include <libyul/backends/evm/EthAssemblyAdapter.h>
+
+#include <libevmasm/Assembly.h>
 
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/ErrorReporter.h>
@@ -91,6 +95,37 @@ std::pair<std::shared_ptr<Object>, std::shared_ptr<yul::AsmAnalysisInfo>> yul::t
 	return {std::move(parserResult), std::move(analysisInfo)};
 }
 
+std::pair<bytes, bool> yul::test::compileToBytecode(
+	std::string const& _source,
+	frontend::OptimiserSettings const& _settings
+)
+{
+	langutil::EVMVersion const evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	YulStack stack(
+		evmVersion,
+		std::nullopt,
+		YulStack::Language::StrictAssembly,
+		frontend::OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+	if (!stack.parseAndAnalyze("", _source) || Error::containsErrors(stack.errors()))
+		BOOST_FAIL("Invalid source.");
+
+	evmasm::Assembly assembly{evmVersion, false, std::nullopt, {}};
+	EthAssemblyAdapter adapter(assembly);
+	bool usedSSACodeTransform = EVMObjectCompiler::compile(
+		*stack.parserResult(),
+		adapter,
+		EVMDialect::strictAssemblyForEVMObjects(evmVersion, std::nullopt),
+		_settings.optimizeStackAllocation,
+		std::nullopt,
+		_settings.useSSACodeTransform,
+		_settings.optimizeCallingConvention,
+		_settings.optimizeFunctionExits
+	);
+	return {assembly.assemble().bytecode, usedSSACodeTransform};
+}
+
 yul::Block yul::test::disambiguate(std::string const& _source)
 {
 	auto result = parse(_source);
@@ -23,6 +23,8 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Common.h>
+
 #include <string>
 #include <vector>
 #include <memory>
@@ -33,6 +35,11 @@ class Error;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
 
+namespace solidity::frontend
+{
+struct OptimiserSettings;
+}
+
 namespace solidity::yul
 {
 struct AsmAnalysisInfo;
@@ -51,6 +58,11 @@ parse(std::string const& _source);
 std::pair<std::shared_ptr<Object>, std::shared_ptr<AsmAnalysisInfo>>
 parse(std::string const& _source, Dialect const& _dialect, langutil::ErrorList& _errors);
 
+/// Compiles the strict assembly object @a _source for the EVM version of the test options without running
+/// any optimizer, using the code transform and code generation options selected by @a _settings.
+/// @returns the assembled bytecode and whether the SSA code transform generated the code of all objects.
+std::pair<bytes, bool> compileToBytecode(std::string const& _source, frontend::OptimiserSettings const& _settings);
+
 Block disambiguate(std::string const& _source);
 std::string format(std::string const& _source);
 
@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the in-place disambiguation and the name dispenser of the Disambiguator.
+ */
+
+#include <test/libyul/Common.h>
+#include <test/Common.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+namespace
+{
+
+std::string const source = R"({
+	{
+		let x := f(1)
+		sstore(x, f(x))
+	}
+	function f(a) -> b {
+		for { let i := 0 } lt(i, a) { i := add(i, 1) } {
+			let x := i
+			b := add(b, x)
+		}
+		for { let i := 0 } lt(i, b) { i := add(i, 1) } {
+			let x_1 := x_2()
+			b := add(b, x_1)
+		}
+	}
+	{
+		let x := 2
+		switch x
+		case 0 { let a := g(x) }
+		default { let a, b := h(x) }
+		function g(a) -> r { r := f(x_2()) }
+		function h(a) -> b, c { b := a c := a }
+		sstore(k(), x)
+		function k() -> x_1 { x_1 := 3 }
+	}
+	function x_2() -> x { x := 7 }
+})";
+
+Dialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVM(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulDisambiguator)
+
+BOOST_AUTO_TEST_CASE(in_place_matches_copy)
+{
+	auto [ast, analysisInfo] = parse(source);
+	Block expected = std::get<Block>(Disambiguator(evmDialect(), *analysisInfo)(ast->root()));
+
+	Block code = std::get<Block>(ASTCopier{}(ast->root()));
+	AsmAnalysisInfo codeInfo = AsmAnalyzer::analyzeStrictAssertCorrect(evmDialect(), code, {});
+	Disambiguator(evmDialect(), codeInfo).disambiguateInPlace(code);
+
+	BOOST_CHECK_EQUAL(AsmPrinter{}(code), AsmPrinter{}(expected));
+}
+
+BOOST_AUTO_TEST_CASE(name_dispenser_matches_dispenser_of_translated_code)
+{
+	std::set<YulName> reserved{YulName{"x_3"}, YulName{"y"}};
+	auto [ast, analysisInfo] = parse(source);
+	Disambiguator disambiguator(evmDialect(), *analysisInfo, reserved);
+	Block code = std::get<Block>(disambiguator(ast->root()));
+
+	NameDispenser reused = disambiguator.nameDispenser();
+	NameDispenser collected{evmDialect(), code, reserved};
+	BOOST_CHECK(reused.usedNames() == collected.usedNames());
+	for (std::string hint: {"x", "y", "f", "a", "i", "x_1", "z"})
+		BOOST_CHECK_EQUAL(reused.newName(YulName{hint}).str(), collected.newName(YulName{hint}).str());
+
+	reused.reset(code);
+	collected.reset(code);
+	BOOST_CHECK(reused.usedNames() == collected.usedNames());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the value numbering of Yul expressions.
+ */
+
+#include <libyul/optimiser/ExpressionNumbering.h>
+
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+Expression literal(u256 _value)
+{
+	return Literal{{}, LiteralKind::Number, LiteralValue{_value}};
+}
+
+Expression identifier(std::string const& _name)
+{
+	return Identifier{{}, YulName{_name}};
+}
+
+Expression call(std::string const& _function, std::vector<Expression> _arguments)
+{
+	return FunctionCall{{}, Identifier{{}, YulName{_function}}, std::move(_arguments)};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulExpressionNumbering)
+
+BOOST_AUTO_TEST_CASE(equal_expressions_have_equal_numbers)
+{
+	ExpressionNumbering numbering;
+	Expression a = call("add", {identifier("x"), literal(1)});
+	Expression b = call("add", {identifier("x"), literal(1)});
+	BOOST_CHECK(numbering(a) == numbering(b));
+	BOOST_CHECK(numbering(literal(7)) == numbering(Literal{{}, LiteralKind::Number, LiteralValue{7, "0x07"}}));
+	BOOST_CHECK(numbering(identifier("x")) == numbering.identifier(YulName{"x"}));
+	BOOST_CHECK(
+		numbering(a) ==
+		numbering.functionCall(YulName{"add"}, {numbering.identifier(YulName{"x"}), numbering.literal(LiteralValue{1})})
+	);
+}
+
+BOOST_AUTO_TEST_CASE(different_expressions_have_different_numbers)
+{
+	ExpressionNumbering numbering;
+	std::vector<Expression> expressions;
+	expressions.emplace_back(call("add", {identifier("x"), literal(1)}));
+	expressions.emplace_back(call("add", {literal(1), identifier("x")}));
+	expressions.emplace_back(call("sub", {identifier("x"), literal(1)}));
+	expressions.emplace_back(call("add", {identifier("y"), literal(1)}));
+	expressions.emplace_back(call("add", {identifier("x"), literal(2)}));
+	expressions.emplace_back(call("add", {identifier("x")}));
+	expressions.emplace_back(identifier("x"));
+	expressions.emplace_back(literal(1));
+	expressions.emplace_back(Literal{{}, LiteralKind::String, LiteralValue{std::string("x")}});
+
+	std::set<ExpressionNumbering::Number> numbers;
+	for (Expression const& expression: expressions)
+		numbers.insert(numbering(expression));
+	BOOST_CHECK(numbers.size() == expressions.size());
+	// The subexpressions `y` and `2` are numbered as well.
+	BOOST_CHECK(numbering.size() == numbers.size() + 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
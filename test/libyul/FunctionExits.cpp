@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the tail call lowering and the sharing of function exits in the optimized EVM code transform.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+#include <test/libyul/YulExecutionFramework.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+/// Compiles @a _source with or without lowering tail calls and sharing function exits and @returns the bytecode.
+bytes compile(std::string const& _source, bool _optimizeFunctionExits)
+{
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::none();
+	settings.optimizeStackAllocation = true;
+	settings.optimizeFunctionExits = _optimizeFunctionExits;
+	return compileToBytecode(_source, settings).first;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(FunctionExits)
+
+BOOST_AUTO_TEST_CASE(tail_calls_reduce_code_size)
+{
+	std::string const source = R"({
+		function store(value) -> stored {
+			stored := mul(value, 2)
+			sstore(0, stored)
+		}
+		function forward(value) -> result { result := store(add(value, 1)) }
+		function forwardWithoutResult(value) { pop(store(value)) }
+		sstore(1, forward(calldataload(0)))
+		forwardWithoutResult(calldataload(32))
+	})";
+	bytes const defaultCode = compile(source, false);
+	bytes const optimizedCode = compile(source, true);
+	BOOST_CHECK(!defaultCode.empty());
+	BOOST_CHECK_LT(optimizedCode.size(), defaultCode.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(FunctionExitsExecution, YulExecutionFramework)
+
+BOOST_AUTO_TEST_CASE(tail_calls_and_shared_exits_preserve_results)
+{
+	std::string const source = R"({
+		function store(value) -> stored {
+			stored := mul(value, 2)
+			sstore(0, stored)
+		}
+		function forward(value) -> result { result := store(add(value, 1)) }
+		function forwardTwice(value) -> result { result := forward(forward(value)) }
+		function select(a, b, c, d) -> x, y {
+			x := a
+			y := b
+			switch c
+			case 0 { y := add(b, d) }
+			case 1 { x := add(a, d) }
+			default {
+				x := d
+				y := d
+			}
+		}
+		function sumTo(n, acc) -> r {
+			switch n
+			case 0 { r := acc }
+			default { r := sumTo(sub(n, 1), add(acc, n)) }
+		}
+		mstore(0, forward(20))
+		mstore(32, forwardTwice(3))
+		mstore(64, sload(0))
+		let x, y := select(1, 2, 0, 10)
+		mstore(96, x)
+		mstore(128, y)
+		x, y := select(1, 2, 1, 10)
+		mstore(160, x)
+		mstore(192, y)
+		x, y := select(1, 2, 7, 10)
+		mstore(224, x)
+		mstore(256, y)
+		mstore(288, sumTo(10, 0))
+		return(0, 320)
+	})";
+	m_optimiserSettings = frontend::OptimiserSettings::none();
+	m_optimiserSettings.optimizeStackAllocation = true;
+	for (bool optimizeFunctionExits: {false, true})
+	{
+		m_optimiserSettings.optimizeFunctionExits = optimizeFunctionExits;
+		ABI_CHECK(compileAndRun(source), encodeArgs(42, 18, 18, 1, 12, 11, 2, 10, 10, 55));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the set of active stores used by the UnusedStoreEliminator.
+ */
+
+#include <libyul/optimiser/IndexedStoreSet.h>
+
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::set<Statement const*> contents(IndexedStoreSet const& _set)
+{
+	std::set<Statement const*> result;
+	_set.forEach([&](Statement const* _store) { BOOST_CHECK(result.insert(_store).second); });
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IndexedStoreSetTest)
+
+BOOST_AUTO_TEST_CASE(insert_and_merge)
+{
+	std::vector<Statement> statements(4);
+	IndexedStoreSet set;
+	BOOST_CHECK(set.empty());
+
+	set.insert(&statements[0], std::nullopt);
+	set.insert(&statements[1], IndexedStoreSet::Region{YulName{}, 0x40, 32});
+	BOOST_CHECK(!set.empty());
+	BOOST_CHECK(set.maxLength(YulName{}) == 32);
+	BOOST_CHECK(set.maxLength("x"_yulname) == 0);
+
+	IndexedStoreSet other;
+	other.insert(&statements[1], IndexedStoreSet::Region{YulName{}, 0x40, 32});
+	other.insert(&statements[2], IndexedStoreSet::Region{YulName{}, 0x80, 0x100});
+	other.insert(&statements[3], IndexedStoreSet::Region{"x"_yulname, 0, 1});
+	set.merge(std::move(other));
+
+	BOOST_CHECK(contents(set) == (std::set<Statement const*>{&statements[0], &statements[1], &statements[2], &statements[3]}));
+	BOOST_CHECK(set.maxLength(YulName{}) == 0x100);
+	BOOST_CHECK(set.maxLength("x"_yulname) == 1);
+
+	set.clear();
+	BOOST_CHECK(set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(erase_by_region)
+{
+	std::vector<Statement> statements(6);
+	IndexedStoreSet set;
+	set.insert(&statements[0], std::nullopt);
+	set.insert(&statements[1], IndexedStoreSet::Region{YulName{}, 0, 32});
+	set.insert(&statements[2], IndexedStoreSet::Region{YulName{}, 0x20, 32});
+	set.insert(&statements[3], IndexedStoreSet::Region{YulName{}, 0x40, 32});
+	set.insert(&statements[4], IndexedStoreSet::Region{"x"_yulname, 0x20, 32});
+	set.insert(&statements[5], IndexedStoreSet::Region{"y"_yulname, 0x20, 32});
+
+	std::set<Statement const*> visited;
+	auto visitAll = [&](Statement const* _store) { visited.insert(_store); return false; };
+	auto eraseAll = [](Statement const*) { return true; };
+
+	set.eraseInRangeIf(YulName{}, 0x10, 0x20, visitAll);
+	BOOST_CHECK(visited == (std::set<Statement const*>{&statements[2]}));
+
+	visited.clear();
+	set.eraseOtherReferencesIf("x"_yulname, visitAll);
+	BOOST_CHECK(visited == (std::set<Statement const*>{&statements[1], &statements[2], &statements[3], &statements[5]}));
+
+	visited.clear();
+	set.eraseUnindexedIf(visitAll);
+	BOOST_CHECK(visited == (std::set<Statement const*>{&statements[0]}));
+
+	set.eraseInRangeIf(YulName{}, 0, 0x20, eraseAll);
+	BOOST_CHECK(contents(set) == (std::set<Statement const*>{&statements[0], &statements[3], &statements[4], &statements[5]}));
+
+	set.eraseReferenceIf("x"_yulname, eraseAll);
+	set.eraseIf([&](Statement const* _store) { return _store != &statements[5]; });
+	BOOST_CHECK(contents(set) == (std::set<Statement const*>{&statements[5]}));
+
+	set.eraseOtherReferencesIf(YulName{}, eraseAll);
+	BOOST_CHECK(set.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
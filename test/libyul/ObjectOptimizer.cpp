@@ -0,0 +1,229 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the optimization of Yul object hierarchies.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/ObjectOptimizer.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <range/v3/view/enumerate.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string const sourceWithNestedObjects = R"(
+	object "Factory" {
+		code {
+			let size := datasize("Child")
+			datacopy(0, dataoffset("Child"), size)
+			sstore(0, create(0, 0, size))
+		}
+		object "Child" {
+			code {
+				let x := calldataload(0)
+				let y := add(x, 1)
+				sstore(y, mul(x, 2))
+				datacopy(0, dataoffset("Child_deployed"), datasize("Child_deployed"))
+				return(0, datasize("Child_deployed"))
+			}
+			object "Child_deployed" {
+				code {
+					function f(a) -> b { b := add(a, sload(a)) }
+					sstore(0, f(calldataload(0)))
+				}
+			}
+		}
+		object "Other" {
+			code {
+				function f(a) -> b { b := add(a, sload(a)) }
+				sstore(0, f(calldataload(0)))
+			}
+		}
+	}
+)";
+
+std::string optimize(
+	std::shared_ptr<ObjectOptimizer> _objectOptimizer,
+	std::string const& _source = sourceWithNestedObjects,
+	size_t _numThreads = 1
+)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		std::nullopt, // The source uses dataoffset(), which is not available in EOF.
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All(),
+		nullptr,
+		std::move(_objectOptimizer)
+	);
+	stack.setNumThreads(_numThreads);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", _source));
+	stack.optimize();
+	return stack.print();
+}
+
+std::vector<boost::filesystem::path> persistentCacheEntries(boost::filesystem::path const& _cacheDirectory)
+{
+	if (!boost::filesystem::exists(_cacheDirectory / "yul-optimizer"))
+		return {};
+	return {
+		boost::filesystem::directory_iterator(_cacheDirectory / "yul-optimizer"),
+		boost::filesystem::directory_iterator()
+	};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectOptimizer)
+
+BOOST_AUTO_TEST_CASE(parallel_optimization_matches_sequential)
+{
+	std::string sequentialResult = optimize(std::make_shared<ObjectOptimizer>());
+
+	for (size_t numThreads: std::vector<size_t>{2, 4})
+	{
+		auto objectOptimizer = std::make_shared<ObjectOptimizer>();
+		BOOST_TEST(optimize(objectOptimizer, sourceWithNestedObjects, numThreads) == sequentialResult);
+		// Repeated optimization is served from the cache.
+		size_t cacheSize = objectOptimizer->size();
+		BOOST_TEST(optimize(objectOptimizer, sourceWithNestedObjects, numThreads) == sequentialResult);
+		BOOST_TEST(objectOptimizer->size() == cacheSize);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cache_key_distinguishes_debug_data_and_literals)
+{
+	auto source = [](std::string const& _comment, std::string const& _literal) {
+		return
+			"/// @use-src 0:\"a.sol\", 1:\"b.sol\"\n"
+			"object \"A\" { code {\n" + _comment + "\nsstore(0, " + _literal + ")\n} }";
+	};
+	std::vector<std::string> sources{
+		source("/// @src 0:1:2", "42"),
+		source("/// @src 1:1:2", "42"),
+		source("/// @src 0:1:3", "42"),
+		source("/// @ast-id 7 @src 0:1:2", "42"),
+		source("/// @src 0:1:2", "0x2a"),
+		source("/// @src 0:1:2", "43"),
+	};
+
+	auto objectOptimizer = std::make_shared<ObjectOptimizer>();
+	for (auto&& [index, variant]: sources | ranges::views::enumerate)
+	{
+		optimize(objectOptimizer, variant);
+		BOOST_TEST(objectOptimizer->size() == index + 1);
+	}
+	// Optimizing the same code again is served from the cache.
+	optimize(objectOptimizer, sources.front());
+	BOOST_TEST(objectOptimizer->size() == sources.size());
+}
+
+BOOST_AUTO_TEST_CASE(persistent_cache)
+{
+	util::TemporaryDirectory cacheDirectory("solidity-yul-cache-test");
+	std::string expectedResult = optimize(std::make_shared<ObjectOptimizer>());
+
+	auto objectOptimizer = std::make_shared<ObjectOptimizer>();
+	objectOptimizer->setPersistentCacheDirectory(cacheDirectory.path(), "version-a");
+	BOOST_TEST(optimize(objectOptimizer) == expectedResult);
+	size_t numEntries = persistentCacheEntries(cacheDirectory).size();
+	BOOST_TEST(numEntries > 0);
+
+	// A fresh instance uses the entries on disk instead of adding new ones.
+	objectOptimizer = std::make_shared<ObjectOptimizer>();
+	objectOptimizer->setPersistentCacheDirectory(cacheDirectory.path(), "version-a");
+	BOOST_TEST(optimize(objectOptimizer) == expectedResult);
+	BOOST_TEST(persistentCacheEntries(cacheDirectory).size() == numEntries);
+
+	// Entries are not shared between compiler versions.
+	objectOptimizer = std::make_shared<ObjectOptimizer>();
+	objectOptimizer->setPersistentCacheDirectory(cacheDirectory.path(), "version-b");
+	BOOST_TEST(optimize(objectOptimizer) == expectedResult);
+	BOOST_TEST(persistentCacheEntries(cacheDirectory).size() == 2 * numEntries);
+}
+
+BOOST_AUTO_TEST_CASE(persistent_cache_ignores_invalid_entries)
+{
+	util::TemporaryDirectory cacheDirectory("solidity-yul-cache-test");
+	std::string expectedResult = optimize(std::make_shared<ObjectOptimizer>());
+
+	auto objectOptimizer = std::make_shared<ObjectOptimizer>();
+	objectOptimizer->setPersistentCacheDirectory(cacheDirectory.path(), "version");
+	optimize(objectOptimizer);
+
+	std::vector<std::string> invalidContents{"", "{ let x := ", "{ sstore(0, undefined()) }"};
+	for (std::string const& invalidContent: invalidContents)
+	{
+		for (boost::filesystem::path const& entry: persistentCacheEntries(cacheDirectory))
+			std::ofstream(entry.string(), std::ios::trunc) << invalidContent;
+
+		objectOptimizer = std::make_shared<ObjectOptimizer>();
+		objectOptimizer->setPersistentCacheDirectory(cacheDirectory.path(), "version");
+		BOOST_TEST(optimize(objectOptimizer) == expectedResult);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(persistent_cache_ignores_entries_with_wrong_checksum)
+{
+	util::TemporaryDirectory cacheDirectory("solidity-yul-cache-test");
+	std::string expectedResult = optimize(std::make_shared<ObjectOptimizer>());
+
+	auto objectOptimizer = std::make_shared<ObjectOptimizer>();
+	objectOptimizer->setPersistentCacheDirectory(cacheDirectory.path(), "version");
+	optimize(objectOptimizer);
+
+	// Valid code that is not the optimized code any more, but keeps the original checksum.
+	for (boost::filesystem::path const& entry: persistentCacheEntries(cacheDirectory))
+	{
+		std::string content = util::readFileAsString(entry);
+		std::ofstream(entry.string(), std::ios::trunc) << content.substr(0, content.find('\n') + 1) << "{ }";
+	}
+
+	objectOptimizer = std::make_shared<ObjectOptimizer>();
+	objectOptimizer->setPersistentCacheDirectory(cacheDirectory.path(), "version");
+	BOOST_TEST(optimize(objectOptimizer) == expectedResult);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,186 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the statistics collected by the optimiser suite and for running it in parallel.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/ExpressionSplitter.h>
+#include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+OptimiserSuite::Statistics runWithStatistics(std::string const& _source, std::string_view _sequence)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+	Block ast = disambiguate(_source);
+	NameDispenser dispenser{dialect, ast};
+	std::set<YulName> const reservedIdentifiers;
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, 200};
+
+	OptimiserSuite suite{context, OptimiserSuite::Debug::Statistics};
+	suite.runSequence(_sequence, ast);
+
+	std::ostringstream output;
+	suite.printStatistics(output);
+	BOOST_TEST(output.str().find(std::string(UnusedPruner::name)) != std::string::npos);
+
+	return suite.statistics();
+}
+
+std::string runOnThreads(std::string const& _source, std::string_view _sequence, size_t _numThreads)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+	Block ast = disambiguate(_source);
+	NameDispenser dispenser{dialect, ast};
+	std::set<YulName> const reservedIdentifiers;
+	util::ThreadPool threadPool{_numThreads};
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, 200, &threadPool};
+
+	OptimiserSuite suite{context};
+	suite.runSequence(_sequence, ast);
+	return AsmPrinter{}(ast);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuiteStatistics)
+
+BOOST_AUTO_TEST_CASE(runs_and_changes)
+{
+	OptimiserSuite::Statistics statistics = runWithStatistics("{ let x := 1 let y := 2 sstore(0, 1) }", "uu");
+
+	BOOST_REQUIRE(statistics.steps.size() == 1);
+	OptimiserSuite::StepStatistics const& unusedPruner = statistics.steps.at(std::string(UnusedPruner::name));
+	BOOST_TEST(unusedPruner.runs == 2);
+	BOOST_TEST(unusedPruner.runsWithChanges == 1);
+	BOOST_TEST(unusedPruner.codeSizeAfter < unusedPruner.codeSizeBefore);
+	BOOST_TEST(statistics.repeatedRounds == 0);
+}
+
+BOOST_AUTO_TEST_CASE(repeated_rounds)
+{
+	OptimiserSuite::Statistics statistics = runWithStatistics("{ let x := 1 let y := 2 sstore(0, 1) }", "[u]");
+
+	OptimiserSuite::StepStatistics const& unusedPruner = statistics.steps.at(std::string(UnusedPruner::name));
+	BOOST_TEST(unusedPruner.runs == 2);
+	BOOST_TEST(unusedPruner.runsWithChanges == 1);
+	BOOST_TEST(statistics.repeatedRounds == 2);
+	BOOST_TEST(statistics.repeatedRoundsWithoutSizeChange == 1);
+}
+
+BOOST_AUTO_TEST_CASE(unchanged_steps_are_skipped_in_repeated_rounds)
+{
+	// The second round only confirms that the code is stable. CommonSubexpressionEliminator
+	// did not change anything in the first round and the code did not change since, so it is skipped.
+	OptimiserSuite::Statistics statistics = runWithStatistics("{ let x := 1 let y := 2 sstore(0, 1) }", "[uc]");
+
+	OptimiserSuite::StepStatistics const& unusedPruner = statistics.steps.at(std::string(UnusedPruner::name));
+	BOOST_TEST(unusedPruner.runs == 2);
+	BOOST_TEST(unusedPruner.skippedRuns == 0);
+	OptimiserSuite::StepStatistics const& cse = statistics.steps.at(std::string(CommonSubexpressionEliminator::name));
+	BOOST_TEST(cse.runs == 1);
+	BOOST_TEST(cse.runsWithChanges == 0);
+	BOOST_TEST(cse.skippedRuns == 1);
+	BOOST_TEST(statistics.repeatedRounds == 2);
+}
+
+BOOST_AUTO_TEST_CASE(splitting_split_code_is_skipped)
+{
+	std::string const source = "{ let x := 1 sstore(add(calldataload(0), 1), mload(2)) }";
+
+	// SSATransform and UnusedPruner keep the code split.
+	OptimiserSuite::Statistics statistics = runWithStatistics(source, "xaux");
+	OptimiserSuite::StepStatistics const& splitter = statistics.steps.at(std::string(ExpressionSplitter::name));
+	BOOST_TEST(splitter.runs == 1);
+	BOOST_TEST(splitter.skippedRuns == 1);
+
+	// The CommonSubexpressionEliminator is assumed to keep the code split, but the
+	// ExpressionSimplifier is not, so it has to be split again.
+	statistics = runWithStatistics(source, "xcuxsx");
+	OptimiserSuite::StepStatistics const& resplit = statistics.steps.at(std::string(ExpressionSplitter::name));
+	BOOST_TEST(resplit.runs == 2);
+	BOOST_TEST(resplit.skippedRuns == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuiteParallelism)
+
+BOOST_AUTO_TEST_CASE(functions_in_parallel_match_sequential_result)
+{
+	std::string const source = R"({
+		sstore(0, f(1))
+		sstore(1, g(2, 3))
+		function f(a) -> r {
+			let x := mload(0x40)
+			mstore(x, add(a, 0))
+			r := mload(x)
+			r := add(mul(a, 1), r)
+		}
+		function g(a, b) -> r {
+			let x := add(a, b)
+			let y := add(a, b)
+			r := 7
+			r := sub(x, y)
+		}
+		function h(a) -> r {
+			sstore(a, 1)
+			r := sload(a)
+			if r { r := 1 }
+		}
+		function k() { sstore(h(4), f(5)) }
+	})";
+	// ExpressionSimplifier, CommonSubexpressionEliminator, LoadResolver and
+	// UnusedAssignEliminator split the functions among the threads.
+	std::string_view const sequence = "hgfoxa[scLr]";
+
+	std::string const sequential = runOnThreads(source, sequence, 0);
+	BOOST_TEST(runOnThreads(source, sequence, 2) == sequential);
+	BOOST_TEST(runOnThreads(source, sequence, 4) == sequential);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
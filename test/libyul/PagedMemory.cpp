@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the copy-on-write containers of the Yul interpreter state.
+ */
+
+#include <test/tools/yulInterpreter/CopyOnWrite.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(PagedMemoryTest)
+
+BOOST_AUTO_TEST_CASE(read_and_write)
+{
+	PagedMemory memory;
+	BOOST_CHECK(memory.get(0x1234) == 0);
+	BOOST_CHECK(memory.read(0x10, 4) == bytes(4, 0));
+	BOOST_CHECK(memory.pages().empty());
+
+	memory.set(0x1234, 0xab);
+	BOOST_CHECK(memory.get(0x1234) == 0xab);
+	BOOST_CHECK(memory.pages().size() == 1);
+
+	// Crosses the boundary between two pages.
+	bytes const data{1, 2, 3, 4};
+	memory.write(PagedMemory::PageSize - 2, bytesConstRef(&data));
+	BOOST_CHECK(memory.read(PagedMemory::PageSize - 3, 6) == (bytes{0, 1, 2, 3, 4, 0}));
+	BOOST_CHECK(memory.pages().size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(wrap_around)
+{
+	PagedMemory memory;
+	bytes const data{1, 2, 3, 4};
+	memory.write(~u256(0) - 1, bytesConstRef(&data));
+	BOOST_CHECK(memory.get(~u256(0)) == 2);
+	BOOST_CHECK(memory.get(0) == 3);
+	BOOST_CHECK(memory.read(~u256(0) - 1, 4) == data);
+}
+
+BOOST_AUTO_TEST_CASE(copies_are_independent)
+{
+	PagedMemory memory;
+	memory.set(1, 1);
+	memory.set(PagedMemory::PageSize + 1, 2);
+
+	PagedMemory snapshot = memory;
+	BOOST_CHECK(snapshot.pages().at(0) == memory.pages().at(0));
+
+	memory.set(1, 3);
+	BOOST_CHECK(memory.get(1) == 3);
+	BOOST_CHECK(snapshot.get(1) == 1);
+	// Only the modified page was copied.
+	BOOST_CHECK(snapshot.pages().at(0) != memory.pages().at(0));
+	BOOST_CHECK(snapshot.pages().at(1) == memory.pages().at(1));
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write)
+{
+	CopyOnWrite<std::map<int, int>> storage;
+	storage.write()[1] = 1;
+
+	CopyOnWrite<std::map<int, int>> snapshot = storage;
+	BOOST_CHECK(&*snapshot == &*storage);
+
+	storage.write()[1] = 2;
+	BOOST_CHECK(storage->at(1) == 2);
+	BOOST_CHECK(snapshot->at(1) == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,257 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the dataflow analysis on the SSA control flow graph.
+ */
+
+#include <test/libyul/Common.h>
+#include <test/Common.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/SSACFGDataFlowAnalysis.h>
+#include <libyul/backends/evm/SSACFGLiveness.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+
+#include <libyul/AsmAnalysis.h>
+#include <libyul/Object.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <range/v3/view/reverse.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+bool tracked(SSACFG const& _cfg, SSACFG::ValueId _value)
+{
+	return !std::holds_alternative<SSACFG::LiteralValue>(_cfg.valueInfo(_value));
+}
+
+/// Liveness of all values that are not literals as a backward problem. Like SSACFGLiveness, it
+/// does not count unreachable values as live at the end of a block.
+struct Liveness
+{
+	static constexpr SSACFGDataFlowDirection direction = SSACFGDataFlowDirection::Backward;
+	static constexpr SSACFGDataFlowMeet meet = SSACFGDataFlowMeet::Union;
+
+	size_t numBits() const { return cfg.numValues(); }
+	void boundary(SSACFG::BlockId _block, SSACFGDataFlowFacts& _facts) const
+	{
+		if (auto const* functionReturn = std::get_if<SSACFG::BasicBlock::FunctionReturn>(&cfg.block(_block).exit))
+			for (SSACFG::ValueId value: functionReturn->returnValues)
+				if (tracked(cfg, value))
+					_facts.set(value.value);
+		removeUnreachable(_facts);
+	}
+	void transfer(SSACFG::BlockId _block, SSACFGDataFlowFacts& _facts) const
+	{
+		SSACFG::BasicBlock const& block = cfg.block(_block);
+		for (auto const& operation: block.operations | ranges::views::reverse)
+		{
+			for (SSACFG::ValueId output: operation.outputs)
+				if (tracked(cfg, output))
+					_facts.reset(output.value);
+			for (SSACFG::ValueId input: operation.inputs)
+				if (tracked(cfg, input))
+					_facts.set(input.value);
+		}
+		for (SSACFG::ValueId phi: block.phis)
+			_facts.set(phi.value);
+	}
+	void transferEdge(SSACFG::BlockId _from, SSACFG::BlockId _to, SSACFGDataFlowFacts& _facts) const
+	{
+		SSACFG::BasicBlock const& successor = cfg.block(_to);
+		auto argumentIndex = static_cast<size_t>(std::distance(successor.entries.begin(), successor.entries.find(_from)));
+		for (SSACFG::ValueId phi: successor.phis)
+		{
+			_facts.reset(phi.value);
+			SSACFG::ValueId argument = std::get<SSACFG::PhiValue>(cfg.valueInfo(phi)).arguments.at(argumentIndex);
+			if (tracked(cfg, argument))
+				_facts.set(argument.value);
+		}
+		removeUnreachable(_facts);
+	}
+	void removeUnreachable(SSACFGDataFlowFacts& _facts) const
+	{
+		for (size_t value = _facts.find_first(); value != SSACFGDataFlowFacts::npos; value = _facts.find_next(value))
+			if (std::holds_alternative<SSACFG::UnreachableValue>(cfg.valueInfo(SSACFG::ValueId{value})))
+				_facts.reset(value);
+	}
+
+	SSACFG const& cfg;
+};
+
+/// Values that are defined on all paths to a program point as a forward problem.
+struct DefinedValues
+{
+	static constexpr SSACFGDataFlowDirection direction = SSACFGDataFlowDirection::Forward;
+	static constexpr SSACFGDataFlowMeet meet = SSACFGDataFlowMeet::Intersection;
+
+	size_t numBits() const { return cfg.numValues(); }
+	void boundary(SSACFG::BlockId, SSACFGDataFlowFacts& _facts) const
+	{
+		for (auto const& argument: cfg.arguments)
+			_facts.set(std::get<1>(argument).value);
+	}
+	void transfer(SSACFG::BlockId _block, SSACFGDataFlowFacts& _facts) const
+	{
+		SSACFG::BasicBlock const& block = cfg.block(_block);
+		for (SSACFG::ValueId phi: block.phis)
+			_facts.set(phi.value);
+		for (auto const& operation: block.operations)
+			for (SSACFG::ValueId output: operation.outputs)
+				_facts.set(output.value);
+	}
+	void transferEdge(SSACFG::BlockId, SSACFG::BlockId, SSACFGDataFlowFacts&) const {}
+
+	SSACFG const& cfg;
+};
+
+SSACFGDataFlowFacts toFacts(SSACFG const& _cfg, std::set<SSACFG::ValueId> const& _values)
+{
+	SSACFGDataFlowFacts facts(_cfg.numValues());
+	for (SSACFG::ValueId value: _values)
+		facts.set(value.value);
+	return facts;
+}
+
+void checkGraph(SSACFG const& _cfg)
+{
+	SSACFGLiveness expectedLiveness(_cfg);
+	ForwardSSACFGTopologicalSort const& topologicalSort = expectedLiveness.topologicalSort();
+
+	SSACFGDataFlowAnalysis liveness(topologicalSort, Liveness{_cfg});
+	for (size_t blockIdValue: topologicalSort.postOrder())
+	{
+		SSACFG::BlockId blockId{blockIdValue};
+		BOOST_CHECK(liveness.atEntry(blockId) == toFacts(_cfg, expectedLiveness.liveIn(blockId)));
+		BOOST_CHECK(liveness.atExit(blockId) == toFacts(_cfg, expectedLiveness.liveOut(blockId)));
+	}
+
+	// In SSA form, all values are defined before they are used.
+	SSACFGDataFlowAnalysis definedValues(topologicalSort, DefinedValues{_cfg});
+	for (size_t blockIdValue: topologicalSort.postOrder())
+	{
+		SSACFG::BlockId blockId{blockIdValue};
+		SSACFG::BasicBlock const& block = _cfg.block(blockId);
+		SSACFGDataFlowFacts defined = definedValues.atEntry(blockId);
+		for (SSACFG::ValueId phi: block.phis)
+			defined.set(phi.value);
+		for (auto const& operation: block.operations)
+		{
+			for (SSACFG::ValueId input: operation.inputs)
+				if (std::holds_alternative<SSACFG::VariableValue>(_cfg.valueInfo(input)))
+					BOOST_CHECK(defined.test(input.value));
+			for (SSACFG::ValueId output: operation.outputs)
+				defined.set(output.value);
+		}
+		BOOST_CHECK(defined == definedValues.atExit(blockId));
+	}
+}
+
+void check(std::string const& _source)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(_source, dialect, errors);
+	BOOST_REQUIRE(object && analysisInfo && !Error::containsErrors(errors));
+	std::unique_ptr<ControlFlow> controlFlow = SSAControlFlowGraphBuilder::build(
+		*analysisInfo,
+		dialect,
+		object->code()->root()
+	);
+	checkGraph(*controlFlow->mainGraph);
+	for (auto const& functionGraph: controlFlow->functionGraphs)
+		checkGraph(*functionGraph);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SSACFGDataFlowAnalysisTest)
+
+BOOST_AUTO_TEST_CASE(straight_line)
+{
+	check(R"({
+		let x := calldataload(0)
+		let y := add(x, calldataload(32))
+		sstore(x, y)
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(branches)
+{
+	check(R"({
+		let x := calldataload(0)
+		let y := 0
+		if x { y := add(x, 1) }
+		switch y
+		case 0 { sstore(0, x) }
+		case 1 { revert(0, 0) }
+		default { y := mul(y, 2) }
+		sstore(1, y)
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(loops)
+{
+	check(R"({
+		let s := 0
+		for { let i := 0 } lt(i, calldataload(0)) { i := add(i, 1) }
+		{
+			if eq(i, 7) { continue }
+			for { let j := i } lt(j, 10) { j := add(j, 1) }
+			{
+				if eq(j, s) { break }
+				s := add(s, j)
+			}
+		}
+		sstore(0, s)
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(functions)
+{
+	check(R"({
+		function f(a, b) -> r
+		{
+			r := a
+			for {} lt(r, b) {} {
+				if iszero(r) { leave }
+				r := add(r, g(r))
+			}
+		}
+		function g(x) -> y
+		{
+			y := x
+			if gt(x, 100) { revert(0, 0) }
+		}
+		sstore(0, f(calldataload(0), calldataload(32)))
+	})");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
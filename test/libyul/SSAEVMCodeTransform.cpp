@@ -0,0 +1,139 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the code generator working on the SSA control flow graph.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+/// Compiles @a _source with or without the SSA code transform and @returns the assembled bytecode
+/// together with whether the SSA code transform generated the code of all objects.
+std::pair<bytes, bool> compile(std::string const& _source, bool _useSSACodeTransform)
+{
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::none();
+	settings.optimizeStackAllocation = true;
+	settings.useSSACodeTransform = _useSSACodeTransform;
+	return compileToBytecode(_source, settings);
+}
+
+/// Checks that the SSA code transform, rather than its fallback, generates the code of @a _source.
+void checkCompiles(std::string const& _source)
+{
+	auto [optimized, optimizedUsedSSA] = compile(_source, false);
+	auto [ssa, usedSSA] = compile(_source, true);
+	BOOST_CHECK(!optimized.empty());
+	BOOST_CHECK(!optimizedUsedSSA);
+	BOOST_CHECK(!ssa.empty());
+	BOOST_CHECK_EQUAL(usedSSA, solidity::test::CommonOptions::get().evmVersion().canOverchargeGasForCall());
+}
+}
+
+BOOST_AUTO_TEST_SUITE(SSAEVMCodeTransform)
+
+BOOST_AUTO_TEST_CASE(straight_line)
+{
+	checkCompiles(R"({
+		let x := calldataload(0)
+		let y := calldataload(32)
+		sstore(x, add(x, y))
+		mstore(0, mul(y, x))
+		return(0, 32)
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(conditionals)
+{
+	checkCompiles(R"({
+		let x := calldataload(0)
+		let y := 7
+		if lt(x, 10) { y := add(x, 1) }
+		switch x
+		case 0 { y := 2 }
+		case 1 { sstore(0, y) }
+		default { y := mul(y, 3) }
+		if iszero(y) { revert(0, 0) }
+		sstore(1, y)
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(loops)
+{
+	checkCompiles(R"({
+		let sum := 0
+		for { let i := 0 } lt(i, calldataload(0)) { i := add(i, 1) }
+		{
+			if eq(i, 5) { continue }
+			if gt(sum, 100) { break }
+			for { let j := i } gt(j, 0) { j := sub(j, 1) } { sum := add(sum, j) }
+		}
+		sstore(0, sum)
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(functions)
+{
+	checkCompiles(R"({
+		function f(a, b) -> x, y {
+			x := add(a, b)
+			if gt(x, 10) { leave }
+			y := g(x)
+		}
+		function g(a) -> r {
+			r := a
+			if lt(a, 100) { r := g(add(a, 1)) }
+		}
+		function h() { revert(0, 0) }
+		let p, q := f(calldataload(0), calldataload(32))
+		if iszero(p) { h() }
+		sstore(p, q)
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(objects)
+{
+	checkCompiles(R"(
+		object "a" {
+			code {
+				datacopy(0, dataoffset("b"), datasize("b"))
+				return(0, datasize("b"))
+			}
+			object "b" {
+				code {
+					let x := calldataload(0)
+					for {} x { x := sub(x, 1) } { sstore(x, x) }
+				}
+			}
+		}
+	)");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -20,6 +20,7 @@
 #include <liblangutil/Scanner.h>
 #include <libsolutil/AnsiColorized.h>
 #include <libyul/backends/evm/StackHelpers.h>
+#include <libyul/backends/evm/StackShuffleSolver.h>
 
 using namespace solidity::util;
 using namespace solidity::langutil;
@@ -133,6 +134,11 @@ StackShufflingTest::StackShufflingTest(std::string const& _filename):
 {
 	m_source = m_reader.source();
 	m_expectation = m_reader.simpleExpectations();
+	std::string shuffler = m_reader.stringSetting("shuffler", "greedy");
+	if (shuffler == "exact")
+		m_exact = true;
+	else if (shuffler != "greedy")
+		BOOST_THROW_EXCEPTION(std::runtime_error("Invalid shuffler setting \"" + shuffler + "\"."));
 }
 
 TestCase::TestResult StackShufflingTest::run(std::ostream& _stream, std::string const& _linePrefix, bool _formatted)
@@ -144,32 +150,61 @@ TestCase::TestResult StackShufflingTest::run(std::ostream& _stream, std::string
 	}
 
 	std::ostringstream output;
-	createStackLayout(
-		m_sourceStack,
-		m_targetStack,
-		[&](unsigned _swapDepth) // swap
-		{
-			output << stackToString(m_sourceStack) << std::endl;
-			output << "SWAP" << _swapDepth << std::endl;
-		},
-		[&](StackSlot const& _slot) // dupOrPush
+	auto swap = [&](unsigned _swapDepth)
+	{
+		output << stackToString(m_sourceStack) << std::endl;
+		output << "SWAP" << _swapDepth << std::endl;
+	};
+	auto dupOrPush = [&](StackSlot const& _slot)
+	{
+		output << stackToString(m_sourceStack) << std::endl;
+		if (canBeFreelyGenerated(_slot))
+			output << "PUSH " << stackSlotToString(_slot) << std::endl;
+		else
 		{
-			output << stackToString(m_sourceStack) << std::endl;
-			if (canBeFreelyGenerated(_slot))
-				output << "PUSH " << stackSlotToString(_slot) << std::endl;
+			if (auto depth = util::findOffset(m_sourceStack | ranges::views::reverse, _slot))
+				output << "DUP" << *depth + 1 << std::endl;
 			else
+				BOOST_THROW_EXCEPTION(std::runtime_error("Invalid DUP operation."));
+		}
+	};
+	auto pop = [&]()
+	{
+		output << stackToString(m_sourceStack) << std::endl;
+		output << "POP" << std::endl;
+	};
+
+	if (m_exact)
+	{
+		// Test the solver on its own, independently of whether its result is cheaper than the greedy one.
+		std::optional<std::vector<StackShuffleOperation>> operations = findOptimalStackShuffle(m_sourceStack, m_targetStack);
+		if (!operations)
+		{
+			AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "No solution found." << std::endl;
+			return TestResult::FatalError;
+		}
+		for (StackShuffleOperation const& operation: *operations)
+			switch (operation.kind)
 			{
-				if (auto depth = util::findOffset(m_sourceStack | ranges::views::reverse, _slot))
-					output << "DUP" << *depth + 1 << std::endl;
-				else
-					BOOST_THROW_EXCEPTION(std::runtime_error("Invalid DUP operation."));
+			case StackShuffleOperation::Kind::Swap:
+				swap(operation.swapDepth);
+				std::swap(m_sourceStack.at(m_sourceStack.size() - operation.swapDepth - 1), m_sourceStack.back());
+				break;
+			case StackShuffleOperation::Kind::PushOrDup:
+				dupOrPush(operation.slot);
+				m_sourceStack.push_back(operation.slot);
+				break;
+			case StackShuffleOperation::Kind::Pop:
+				pop();
+				m_sourceStack.pop_back();
+				break;
 			}
-		},
-		[&](){ // pop
-			output << stackToString(m_sourceStack) << std::endl;
-			output << "POP" << std::endl;
-		}
-    );
+		for (auto&& [current, target]: ranges::zip_view(m_sourceStack, m_targetStack))
+			if (std::holds_alternative<JunkSlot>(target))
+				current = JunkSlot{};
+	}
+	else
+		createStackLayout(m_sourceStack, m_targetStack, swap, dupOrPush, pop);
 
 	output << stackToString(m_sourceStack) << std::endl;
 	m_obtainedResult = output.str();
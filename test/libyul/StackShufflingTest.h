@@ -41,6 +41,8 @@ private:
 
 	Stack m_sourceStack;
 	Stack m_targetStack;
+	/// Whether to print the operations of the exact solver instead of the greedy ones.
+	bool m_exact = false;
 	std::map<YulName, yul::FunctionCall> m_functions;
 	std::map<YulName, Scope::Variable> m_variables;
 };
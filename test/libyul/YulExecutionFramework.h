@@ -0,0 +1,51 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Framework for executing the bytecode generated from Yul objects.
+ */
+
+#pragma once
+
+#include <test/ExecutionFramework.h>
+#include <test/libyul/Common.h>
+
+namespace solidity::yul::test
+{
+
+class YulExecutionFramework: public solidity::test::ExecutionFramework
+{
+public:
+	/// Compiles the strict assembly object in @a _sourceCode using the code generation options of
+	/// @a m_optimiserSettings and runs it as creation code. The data it returns is left in @a m_output.
+	bytes const& compileAndRunWithoutCheck(
+		std::map<std::string, std::string> const& _sourceCode,
+		u256 const& _value = 0,
+		std::string const& _contractName = "",
+		bytes const& _arguments = {},
+		std::map<std::string, util::h160> const& _libraryAddresses = {},
+		std::optional<std::string> const& = std::nullopt
+	) override
+	{
+		BOOST_REQUIRE(_sourceCode.size() == 1 && _contractName.empty() && _libraryAddresses.empty());
+		bytes bytecode = compileToBytecode(_sourceCode.begin()->second, m_optimiserSettings).first;
+		sendMessage(bytecode + _arguments, true, _value);
+		return m_output;
+	}
+};
+
+}
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the flat hash containers keyed by YulName.
+ */
+
+#include <libyul/YulNameMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulNameMapTest)
+
+BOOST_AUTO_TEST_CASE(map_basics)
+{
+	YulNameMap<int> map;
+	BOOST_CHECK(map.empty());
+	BOOST_CHECK(map.find("x"_yulname) == map.end());
+
+	map["x"_yulname] = 1;
+	map["y"_yulname] = 2;
+	++map["x"_yulname];
+	BOOST_CHECK(map.size() == 2);
+	BOOST_CHECK(map.at("x"_yulname) == 2);
+	BOOST_CHECK(map.count("y"_yulname) == 1);
+	BOOST_CHECK(map.count("z"_yulname) == 0);
+	BOOST_CHECK(map.find("y"_yulname)->second == 2);
+
+	// The empty name is a valid key.
+	map[YulName{}] = 3;
+	BOOST_CHECK(map.at(YulName{}) == 3);
+
+	BOOST_CHECK(map.erase("x"_yulname) == 1);
+	BOOST_CHECK(map.erase("x"_yulname) == 0);
+	BOOST_CHECK(!map.contains("x"_yulname));
+	BOOST_CHECK(map.size() == 2);
+
+	map.clear();
+	BOOST_CHECK(map.empty());
+	BOOST_CHECK(map.begin() == map.end());
+}
+
+BOOST_AUTO_TEST_CASE(set_basics)
+{
+	YulNameSet set;
+	BOOST_CHECK(set.insert("a"_yulname));
+	BOOST_CHECK(!set.insert("a"_yulname));
+	BOOST_CHECK(set.insert("b"_yulname));
+	BOOST_CHECK(set.size() == 2);
+	std::set<YulName> elements{set.begin(), set.end()};
+	BOOST_CHECK(elements == (std::set<YulName>{"a"_yulname, "b"_yulname}));
+}
+
+BOOST_AUTO_TEST_CASE(matches_std_map)
+{
+	std::vector<YulName> names;
+	for (size_t i = 0; i < 300; ++i)
+		names.emplace_back("name_" + std::to_string(i));
+
+	std::mt19937 random(1);
+	std::uniform_int_distribution<size_t> nameIndex(0, names.size() - 1);
+	YulNameMap<size_t> map;
+	std::map<YulName, size_t> reference;
+	for (size_t step = 0; step < 20000; ++step)
+	{
+		YulName name = names[nameIndex(random)];
+		if (random() % 3 == 0)
+			BOOST_REQUIRE(map.erase(name) == reference.erase(name));
+		else
+		{
+			map[name] = step;
+			reference[name] = step;
+		}
+		BOOST_REQUIRE(map.size() == reference.size());
+	}
+
+	for (YulName const& name: names)
+	{
+		auto it = reference.find(name);
+		if (it == reference.end())
+			BOOST_REQUIRE(map.find(name) == map.end());
+		else
+			BOOST_REQUIRE(map.at(name) == it->second);
+	}
+	std::map<YulName, size_t> iterated;
+	for (auto const& [name, value]: map)
+		BOOST_REQUIRE(iterated.emplace(name, value).second);
+	BOOST_CHECK(iterated == reference);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
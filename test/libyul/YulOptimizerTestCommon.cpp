@@ -31,6 +31,7 @@
 #include <libyul/optimiser/EqualStoreEliminator.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
+#include <libyul/optimiser/FunctionGeneralizer.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
@@ -40,8 +41,12 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/PureFunctionEvaluator.h>
+#include <libyul/optimiser/StaticMemoryAllocator.h>
 #include <libyul/optimiser/NameDisplacer.h>
+#include <libyul/optimiser/RangeCheckEliminator.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
@@ -197,6 +202,13 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionSpecializer::run(*m_context, block);
 			return block;
 		}},
+		{"functionGeneralizer", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			FunctionHoister::run(*m_context, block);
+			FunctionGeneralizer::run(*m_context, block);
+			return block;
+		}},
 		{"expressionInliner", [&]() {
 			auto block = disambiguate();
 			updateContext(block);
@@ -323,6 +335,14 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			EqualStoreEliminator::run(*m_context, block);
 			return block;
 		}},
+		{"rangeCheckEliminator", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			FunctionHoister::run(*m_context, block);
+			ForLoopInitRewriter::run(*m_context, block);
+			RangeCheckEliminator::run(*m_context, block);
+			return block;
+		}},
 		{"ssaPlusCleanup", [&]() {
 			auto block = disambiguate();
 			updateContext(block);
@@ -357,6 +377,14 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			LoopInvariantCodeMotion::run(*m_context, block);
 			return block;
 		}},
+		{"loopUnroller", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			ForLoopInitRewriter::run(*m_context, block);
+			FunctionHoister::run(*m_context, block);
+			LoopUnroller::run(*m_context, block);
+			return block;
+		}},
 		{"controlFlowSimplifier", [&]() {
 			auto block = disambiguate();
 			updateContext(block);
@@ -364,6 +392,19 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			ControlFlowSimplifier::run(*m_context, block);
 			return block;
 		}},
+		{"pureFunctionEvaluator", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			PureFunctionEvaluator::run(*m_context, block);
+			return block;
+		}},
+		{"staticMemoryAllocator", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			FunctionHoister::run(*m_context, block);
+			StaticMemoryAllocator::run(*m_context, block);
+			return block;
+		}},
 		{"structuralSimplifier", [&]() {
 			auto block = disambiguate();
 			updateContext(block);
@@ -443,47 +484,10 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			return block;
 		}},
 		{"fakeStackLimitEvader", [&]() {
-			auto block = disambiguate();
-			updateContext(block);
-			// Mark all variables with a name starting with "$" for escalation to memory.
-			struct FakeUnreachableGenerator: ASTWalker
-			{
-				std::map<YulName, std::vector<YulName>> fakeUnreachables;
-				using ASTWalker::operator();
-				void operator()(FunctionDefinition const& _function) override
-				{
-					YulName originalFunctionName = m_currentFunction;
-					m_currentFunction = _function.name;
-					for (NameWithDebugData const& _argument: _function.parameters)
-						visitVariableName(_argument.name);
-					for (NameWithDebugData const& _argument: _function.returnVariables)
-						visitVariableName(_argument.name);
-					ASTWalker::operator()(_function);
-					m_currentFunction = originalFunctionName;
-				}
-				void visitVariableName(YulName _var)
-				{
-					if (!_var.empty() && _var.str().front() == '$')
-						if (!util::contains(fakeUnreachables[m_currentFunction], _var))
-							fakeUnreachables[m_currentFunction].emplace_back(_var);
-				}
-				void operator()(VariableDeclaration const& _varDecl) override
-				{
-					for (auto const& var: _varDecl.variables)
-						visitVariableName(var.name);
-					ASTWalker::operator()(_varDecl);
-				}
-				void operator()(Identifier const& _identifier) override
-				{
-					visitVariableName(_identifier.name);
-					ASTWalker::operator()(_identifier);
-				}
-				YulName m_currentFunction = YulName{};
-			};
-			FakeUnreachableGenerator fakeUnreachableGenerator;
-			fakeUnreachableGenerator(block);
-			StackLimitEvader::run(*m_context, block, fakeUnreachableGenerator.fakeUnreachables);
-			return block;
+			return fakeStackLimitEvader(false);
+		}},
+		{"fakeStackLimitEvaderWithSlotReuse", [&]() {
+			return fakeStackLimitEvader(true);
 		}}
 	};
 }
@@ -542,6 +546,51 @@ Block const* YulOptimizerTestCommon::run()
 	return runStep() ? &m_optimizedObject->code()->root() : nullptr;
 }
 
+Block YulOptimizerTestCommon::fakeStackLimitEvader(bool _reuseSlots)
+{
+	auto block = disambiguate();
+	updateContext(block);
+	// Mark all variables with a name starting with "$" for escalation to memory.
+	struct FakeUnreachableGenerator: ASTWalker
+	{
+		std::map<YulName, std::vector<YulName>> fakeUnreachables;
+		using ASTWalker::operator();
+		void operator()(FunctionDefinition const& _function) override
+		{
+			YulName originalFunctionName = m_currentFunction;
+			m_currentFunction = _function.name;
+			for (NameWithDebugData const& _argument: _function.parameters)
+				visitVariableName(_argument.name);
+			for (NameWithDebugData const& _argument: _function.returnVariables)
+				visitVariableName(_argument.name);
+			ASTWalker::operator()(_function);
+			m_currentFunction = originalFunctionName;
+		}
+		void visitVariableName(YulName _var)
+		{
+			if (!_var.empty() && _var.str().front() == '$')
+				if (!util::contains(fakeUnreachables[m_currentFunction], _var))
+					fakeUnreachables[m_currentFunction].emplace_back(_var);
+		}
+		void operator()(VariableDeclaration const& _varDecl) override
+		{
+			for (auto const& var: _varDecl.variables)
+				visitVariableName(var.name);
+			ASTWalker::operator()(_varDecl);
+		}
+		void operator()(Identifier const& _identifier) override
+		{
+			visitVariableName(_identifier.name);
+			ASTWalker::operator()(_identifier);
+		}
+		YulName m_currentFunction = YulName{};
+	};
+	FakeUnreachableGenerator fakeUnreachableGenerator;
+	fakeUnreachableGenerator(block);
+	StackLimitEvader::run(*m_context, block, fakeUnreachableGenerator.fakeUnreachables, _reuseSlots);
+	return block;
+}
+
 Block YulOptimizerTestCommon::disambiguate()
 {
 	auto block = std::get<Block>(Disambiguator(*m_dialect, *m_object->analysisInfo)(m_object->code()->root()));
@@ -62,6 +62,8 @@ public:
 private:
 	Block disambiguate();
 	void updateContext(Block const& _block);
+	/// Moves all variables with a name starting with "$" to memory using the StackLimitEvader.
+	Block fakeStackLimitEvader(bool _reuseSlots);
 
 	std::string m_optimizerStep;
 
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a("abc");
+	YulString b(std::string("ab") + "c");
+	YulString c("abd");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK(a.str() == "abc");
+	BOOST_CHECK(c.str() == "abd");
+	BOOST_CHECK(YulString("").empty());
+	BOOST_CHECK(YulString().str().empty());
+	BOOST_CHECK(a.hash() == YulStringRepository::hash("abc"));
+	// Strings that are already interned get the same deterministic hash.
+	BOOST_CHECK(b.hash() == YulStringRepository::hash("abc"));
+	BOOST_CHECK(c.hash() == YulStringRepository::hash("abd"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const numThreads = 4;
+	size_t const numStrings = 20000;
+	std::vector<std::vector<YulString>> interned(numThreads);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < numThreads; ++thread)
+		threads.emplace_back([&, thread]() {
+			for (size_t i = 0; i < numStrings; ++i)
+				interned[thread].emplace_back("concurrent_" + std::to_string((i * (thread + 1)) % numStrings));
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	std::vector<YulString> reference;
+	for (size_t i = 0; i < numStrings; ++i)
+		reference.emplace_back("concurrent_" + std::to_string(i));
+
+	for (size_t thread = 0; thread < numThreads; ++thread)
+		for (size_t i = 0; i < numStrings; ++i)
+		{
+			size_t expected = (i * (thread + 1)) % numStrings;
+			BOOST_REQUIRE(interned[thread][i] == reference[expected]);
+			BOOST_REQUIRE(interned[thread][i].str() == "concurrent_" + std::to_string(expected));
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -146,6 +146,35 @@ def prepend_comments(sequence):
         result = result + "// " + line
     return result
 
+def decode_semantic_tokens(data):
+    """
+    Turns the relative encoding of semantic tokens into a list of
+    (line, character, length, type, modifiers) tuples with absolute positions.
+    """
+    tokens = []
+    line = 0
+    character = 0
+    for i in range(0, len(data), 5):
+        delta_line, delta_character, length, token_type, modifiers = data[i:i+5]
+        line += delta_line
+        character = character + delta_character if delta_line == 0 else delta_character
+        tokens.append((line, character, length, token_type, modifiers))
+    return tokens
+
+def encode_semantic_tokens(tokens):
+    """
+    Inverse of decode_semantic_tokens().
+    """
+    data = []
+    line = 0
+    character = 0
+    for token_line, token_character, length, token_type, modifiers in tokens:
+        delta_character = token_character - character if token_line == line else token_character
+        data += [token_line - line, delta_character, length, token_type, modifiers]
+        line = token_line
+        character = token_character
+    return data
+
 
 # {{{ JsonRpcProcess
 class BadHeader(Exception):
@@ -225,22 +254,39 @@ class JsonRpcProcess:
         self.trace('receive_message', json.dumps(json_object, indent=4, sort_keys=True))
         return json_object
 
-    def send_message(self, method_name: str, params: Optional[dict]) -> None:
-        if self.process.stdin is None:
-            return
+    def encode_message(self, method_name: str, params: Optional[dict], message_id: Optional[int] = None) -> bytes:
         message = {
             'jsonrpc': '2.0',
             'method': method_name,
             'params': params
         }
+        if message_id is not None:
+            message['id'] = message_id
         json_string = json.dumps(obj=message)
         rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
         self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
-        self.process.stdin.write(rpc_message.encode("utf-8"))
+        return rpc_message.encode("utf-8")
+
+    def send_message(self, method_name: str, params: Optional[dict], message_id: Optional[int] = None) -> None:
+        self.send_encoded_messages([self.encode_message(method_name, params, message_id)])
+
+    def send_encoded_messages(self, messages: List[bytes]) -> None:
+        """
+        Writes the given messages with a single write, so that the server receives them as one burst.
+        """
+        if self.process.stdin is None:
+            return
+        self.process.stdin.write(b"".join(messages))
         self.process.stdin.flush()
 
-    def call_method(self, method_name: str, params: Optional[dict], expects_response: bool = True) -> Any:
-        self.send_message(method_name, params)
+    def call_method(
+        self,
+        method_name: str,
+        params: Optional[dict],
+        expects_response: bool = True,
+        message_id: Optional[int] = None
+    ) -> Any:
+        self.send_message(method_name, params, message_id)
         if not expects_response:
             return None
         return self.receive_message()
@@ -2051,6 +2097,171 @@ class SolidityLSPTestSuite: # {{{
             "diagnostic: check range"
         )
 
+    def test_textDocument_didChange_burst_is_analyzed_once(self, solc: JsonRpcProcess) -> None:
+        """
+        Sends several changes at once and expects diagnostics only for the last one.
+        """
+        self.setup_lsp(solc)
+        FILE_NAME = 'didChange_template'
+        FILE_URI = self.get_test_file_uri(FILE_NAME)
+        self.expect_empty_diagnostics(self.open_file_and_wait_for_diagnostics(solc, FILE_NAME))
+
+        contents = [
+            "contract C { uint x = -1; }",
+            "contract C { function f( }",
+            self.get_test_file_contents(FILE_NAME).replace("contract C", "contract D"),
+        ]
+        solc.send_encoded_messages([
+            solc.encode_message('textDocument/didChange', {
+                'textDocument': { 'uri': FILE_URI },
+                'contentChanges': [{ 'text': text }]
+            })
+            for text in contents
+        ])
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+
+        # No diagnostics for the intermediate contents follow, so the next message is the reply.
+        reply = solc.call_method('workspace/symbol', { 'query': '' })
+        self.expect_equal(
+            [symbol['name'] for symbol in reply['result']],
+            ['D'],
+            "the last change was analyzed",
+            ExpectationFailed.Part.Methods
+        )
+
+    def test_cancelRequest(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        FILE_NAME = 'didChange_template'
+        self.expect_empty_diagnostics(self.open_file_and_wait_for_diagnostics(solc, FILE_NAME))
+
+        solc.send_encoded_messages([
+            solc.encode_message('workspace/symbol', { 'query': 'C' }, message_id=1),
+            solc.encode_message('$/cancelRequest', { 'id': 1 }),
+            solc.encode_message('workspace/symbol', { 'query': 'C' }, message_id=2),
+        ])
+        self.expect_equal(
+            solc.receive_message(),
+            {
+                'jsonrpc': '2.0',
+                'id': 1,
+                'error': { 'code': -32800, 'message': 'Request cancelled.' }
+            },
+            "pending request is cancelled",
+            ExpectationFailed.Part.Methods
+        )
+        reply = solc.receive_message()
+        self.expect_equal(reply['id'], 2, "next request is answered", ExpectationFailed.Part.Methods)
+        self.expect_equal(len(reply['result']), 1, "one symbol found", ExpectationFailed.Part.Methods)
+
+        # Requests that were already answered cannot be cancelled anymore.
+        solc.send_message('$/cancelRequest', { 'id': 2 })
+        reply = solc.call_method('workspace/symbol', { 'query': 'C' }, message_id=3)
+        self.expect_equal(reply['id'], 3, "cancelling an answered request has no effect", ExpectationFailed.Part.Methods)
+        self.expect_true('result' in reply, "request is answered", ExpectationFailed.Part.Methods)
+
+    def test_textDocument_semanticTokens_delta_and_range(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'enums'
+        SUB_DIR = 'semanticTokens'
+        FILE_URI = self.get_test_file_uri(TEST_NAME, SUB_DIR)
+        self.expect_empty_diagnostics(self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, SUB_DIR))
+
+        def request(method, params):
+            params['textDocument'] = { 'uri': FILE_URI }
+            return solc.call_method('textDocument/semanticTokens/' + method, params)['result']
+
+        full = request('full', {})
+        self.expect_true('resultId' in full, "full result has a resultId", ExpectationFailed.Part.Methods)
+
+        unchanged = request('full/delta', { 'previousResultId': full['resultId'] })
+        self.expect_equal(unchanged['edits'], [], "no edits without changes", ExpectationFailed.Part.Methods)
+        self.expect_true(unchanged['resultId'] != full['resultId'], "delta has a new resultId", ExpectationFailed.Part.Methods)
+
+        # Each reply replaces the previous result, so the first resultId is not known anymore.
+        outdated = request('full/delta', { 'previousResultId': full['resultId'] })
+        self.expect_equal(outdated['data'], full['data'], "outdated resultId gets all tokens", ExpectationFailed.Part.Methods)
+        self.expect_true(outdated['resultId'] != unchanged['resultId'], "full reply has a new resultId", ExpectationFailed.Part.Methods)
+
+        # Rename the enum value "Cloudy" to "Overcast", which only changes the length of its token.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [{
+                'range': { 'start': { 'line': 5, 'character': 4 }, 'end': { 'line': 5, 'character': 10 } },
+                'text': "Overcast"
+            }]
+        })
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+
+        delta = request('full/delta', { 'previousResultId': outdated['resultId'] })
+        self.expect_equal(len(delta['edits']), 1, "one edit", ExpectationFailed.Part.Methods)
+        data = list(outdated['data'])
+        for edit in delta['edits']:
+            data[edit['start']:edit['start'] + edit['deleteCount']] = edit['data']
+        expected_tokens = [
+            (line, character, 8 if (line, character) == (5, 4) else length, token_type, modifiers)
+            for line, character, length, token_type, modifiers in decode_semantic_tokens(full['data'])
+        ]
+        self.expect_true((5, 4, 8) in [token[:3] for token in expected_tokens], "token of Overcast", ExpectationFailed.Part.Methods)
+        self.expect_equal(data, encode_semantic_tokens(expected_tokens), "edits update the tokens", ExpectationFailed.Part.Methods)
+        self.expect_equal(request('full', {})['data'], data, "edits match all tokens", ExpectationFailed.Part.Methods)
+
+        # Only tokens starting inside the range are returned, here everything after "enum Co".
+        token_range = { 'start': { 'line': 9, 'character': 7 }, 'end': { 'line': 14, 'character': 0 } }
+        in_range = [
+            token for token in expected_tokens
+            if (9, 7) <= token[:2] < (14, 0)
+        ]
+        self.expect_true(0 < len(in_range) < len(expected_tokens), "range is a part of the file", ExpectationFailed.Part.Methods)
+        self.expect_equal(
+            request('range', { 'range': token_range })['data'],
+            encode_semantic_tokens(in_range),
+            "tokens in range",
+            ExpectationFailed.Part.Methods
+        )
+
+    def test_workspace_symbol(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'symbols'
+        SUB_DIR = 'symbols'
+        FILE_URI = self.get_test_file_uri(TEST_NAME, SUB_DIR)
+        self.expect_empty_diagnostics(self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, SUB_DIR))
+        markers = self.get_test_tags(TEST_NAME, SUB_DIR)
+
+        def symbol(name, kind, marker, container=None):
+            result = { 'name': name, 'kind': kind, 'location': { 'uri': FILE_URI, 'range': markers[marker] } }
+            if container is not None:
+                result['containerName'] = container
+            return result
+
+        def query(text):
+            reply = solc.call_method('workspace/symbol', { 'query': text })['result']
+            return sorted(reply, key=lambda s: (s['location']['range']['start']['line'], s['location']['range']['start']['character']))
+
+        self.expect_equal(
+            query('supply'),
+            [
+                symbol('totalSupply', 6, '@ITokenTotalSupply', 'IToken'),
+                symbol('MAX_SUPPLY', 14, '@MaxSupply', 'Token'),
+                symbol('supply', 8, '@Supply', 'Token'),
+                symbol('totalSupply', 6, '@TokenTotalSupply', 'Token'),
+                symbol('tokenSupply', 12, '@FreeTokenSupply'),
+            ],
+            "symbols containing the query",
+            ExpectationFailed.Part.Methods
+        )
+        self.expect_equal(
+            query('TOKEN'),
+            [
+                symbol('IToken', 11, '@IToken'),
+                symbol('Token', 5, '@Token'),
+                symbol('tokenSupply', 12, '@FreeTokenSupply'),
+            ],
+            "query is case insensitive",
+            ExpectationFailed.Part.Methods
+        )
+        self.expect_equal(query('Minted'), [symbol('Minted', 24, '@Minted', 'Token')], "events", ExpectationFailed.Part.Methods)
+        self.expect_equal(query('none'), [], "no symbols found", ExpectationFailed.Part.Methods)
+
     # }}}
     # }}}
 
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+
+import unittest
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from compile_time_benchmark import Measurement, bytecode_size, compare_results, format_comparison, phase_timings, summarize
+# pragma pylint: enable=import-error
+
+
+def measurement(exit_code=0, cpu_time=10.0, peak_rss=1000, bytecode_size=500, phases=None) -> dict:
+    return {
+        'exit_code': exit_code,
+        'wall_time': cpu_time,
+        'cpu_time': cpu_time,
+        'peak_rss': peak_rss,
+        'bytecode_size': bytecode_size,
+        'phases': phases if phases is not None else {'compiler/Analysis': 1.0},
+    }
+
+
+def results(measurements: dict) -> dict:
+    return {'compiler': 'Version: test', 'repetitions': 1, 'results': measurements}
+
+
+class TestCompileTimeBenchmark(unittest.TestCase):
+    def test_phase_timings(self):
+        trace = {
+            'traceEvents': [
+                {'name': 'Parsing', 'cat': 'compiler', 'dur': 1500000},
+                {'name': 'IR optimisation', 'cat': 'compiler', 'dur': 2000000},
+                {'name': 'IR optimisation', 'cat': 'compiler', 'dur': 500000},
+                {'name': 'EVM assembly optimisation', 'cat': 'evmasm', 'dur': 250000},
+                {'name': 'CHC query', 'cat': 'smtchecker', 'dur': 9000000},
+            ],
+            'displayTimeUnit': 'ms',
+        }
+        self.assertEqual(phase_timings(trace), {
+            'compiler/Parsing': 1.5,
+            'compiler/IR optimisation': 2.5,
+            'evmasm/EVM assembly optimisation': 0.25,
+        })
+
+    def test_bytecode_size(self):
+        combined_json = {
+            'contracts': {
+                'a.sol:A': {'bin': '6080604052', 'bin-runtime': '6080'},
+                'a.sol:I': {'bin': '', 'bin-runtime': ''},
+            },
+            'version': 'test',
+        }
+        self.assertEqual(bytecode_size(combined_json), 7)
+
+    def test_summarize_takes_medians(self):
+        summary = summarize([
+            Measurement(0, 3.0, 2.0, 300, 10, {'compiler/Parsing': 0.3}),
+            Measurement(0, 1.0, 1.0, 100, 10, {'compiler/Parsing': 0.1}),
+            Measurement(0, 2.0, 4.0, 200, 10, {'compiler/Parsing': 0.2}),
+        ])
+        self.assertEqual(summary, Measurement(0, 2.0, 2.0, 200, 10, {'compiler/Parsing': 0.2}))
+
+    def test_summarize_reports_failures(self):
+        self.assertEqual(summarize([Measurement(0, 1.0, 1.0, 1, 1), Measurement(1, 1.0, 1.0, 1, 0)]).exit_code, 1)
+
+    def test_compare_results(self):
+        baseline = results({
+            'chains': {'legacy': measurement(), 'ir': measurement()},
+            'verifier': {'ir': measurement()},
+        })
+        current = results({
+            'chains': {
+                'legacy': measurement(cpu_time=10.4, phases={'compiler/Analysis': 2.0}),
+                'ir': measurement(cpu_time=12.0, peak_rss=900, bytecode_size=600),
+            },
+            'verifier': {'ir': measurement(exit_code=1)},
+            'new': {'ir': measurement()},
+        })
+
+        comparison = compare_results(baseline, current)
+        self.assertEqual(comparison['differences']['chains']['legacy']['phases/compiler/Analysis'], 1.0)
+        self.assertAlmostEqual(comparison['differences']['chains']['legacy']['cpu_time'], 0.04)
+        self.assertAlmostEqual(comparison['differences']['chains']['ir']['cpu_time'], 0.2)
+        self.assertAlmostEqual(comparison['differences']['chains']['ir']['peak_rss'], -0.1)
+        self.assertAlmostEqual(comparison['differences']['chains']['ir']['bytecode_size'], 0.2)
+        self.assertNotIn('new', comparison['differences'])
+        # Only tracked metrics that grew by more than the threshold and new failures are regressions.
+        self.assertEqual(comparison['regressions'], [
+            'chains via ir: cpu_time increased by +20.0%',
+            'verifier via ir: compilation failed',
+        ])
+
+        comparison = compare_results(baseline, current, ['bytecode_size', 'phases/compiler/Analysis'], 0.5)
+        self.assertEqual(comparison['regressions'], [
+            'chains via legacy: phases/compiler/Analysis increased by +100.0%',
+            'verifier via ir: compilation failed',
+        ])
+
+    def test_format_comparison(self):
+        baseline = results({'chains': {'ir': measurement()}})
+        current = results({'chains': {'ir': measurement(cpu_time=12.0, bytecode_size=0)}})
+        comparison = compare_results(baseline, current)
+
+        self.assertEqual(format_comparison(comparison, 'markdown'), '\n'.join([
+            'Baseline: Version: test',
+            'Current:  Version: test',
+            '',
+            '| Workload | Pipeline | wall_time | cpu_time | peak_rss | bytecode_size |',
+            '|---|---|---:|---:|---:|---:|',
+            '| chains | ir | +20.0% | +20.0% | +0.0% | -100.0% |',
+            '',
+            'Regressions:',
+            '- chains via ir: cpu_time increased by +20.0%',
+        ]))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+
+import unittest
+from textwrap import dedent
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from optimiser_sequence_search import (
+    DEFAULT_SEQUENCE,
+    Evaluation,
+    SequenceSearchError,
+    changed_results,
+    format_report,
+    mark_pareto_front,
+    parse_sequences,
+    recommended,
+    total_gas,
+    without_gas_expectations,
+)
+# pragma pylint: enable=import-error
+
+
+class TestOptimiserSequenceSearch(unittest.TestCase):
+    def test_parse_sequences(self):
+        text = dedent("""
+            # Candidates
+            dhfoDgvulfnTUtnIf
+
+            fDnTOc:fDnTOcmu
+        """)
+        self.assertEqual(parse_sequences(text), ['dhfoDgvulfnTUtnIf', 'fDnTOc:fDnTOcmu'])
+
+    def test_total_gas_counts_only_calls_of_baseline(self):
+        baseline = {'a.sol': {'f()': {'irOptimized': 100, 'irOptimized code': 20, 'legacy': 1}}}
+        tests = {
+            'a.sol': {
+                'f()': {'irOptimized': 90, 'irOptimized code': 10, 'legacy': 1},
+                'g()': {'irOptimized': 1000},
+            },
+        }
+        self.assertEqual(total_gas(baseline, baseline), 120)
+        self.assertEqual(total_gas(tests, baseline), 100)
+        with self.assertRaises(SequenceSearchError):
+            total_gas({'a.sol': {}}, baseline)
+
+    def test_changed_results_ignores_gas(self):
+        original = dedent("""
+            // ----
+            // f() -> 1
+            // gas irOptimized: 100
+        """)
+        cheaper = original.replace('100', '90')
+        wrong = original.replace('-> 1', '-> 2')
+        baseline = {'a.sol': without_gas_expectations(original)}
+        self.assertEqual(changed_results({'a.sol': without_gas_expectations(cheaper)}, baseline), [])
+        self.assertEqual(changed_results({'a.sol': without_gas_expectations(wrong)}, baseline), ['a.sol'])
+
+    def test_pareto_front(self):
+        evaluations = [
+            Evaluation(DEFAULT_SEQUENCE, compile_time=1.0, bytecode_size=100, gas=1000),
+            Evaluation('a', compile_time=1.0, bytecode_size=110, gas=900),
+            Evaluation('b', compile_time=1.1, bytecode_size=120, gas=950),
+            Evaluation('c', compile_time=2.0, bytecode_size=90, gas=800),
+            Evaluation('d', failure='x.sol: compilation failed'),
+        ]
+        mark_pareto_front(evaluations, max_compile_time_increase=None)
+        self.assertEqual([evaluation.sequence for evaluation in recommended(evaluations)], ['c', 'a', DEFAULT_SEQUENCE])
+        self.assertFalse(evaluations[2].pareto_optimal)
+        self.assertFalse(evaluations[4].within_budget)
+
+        mark_pareto_front(evaluations, max_compile_time_increase=0.5)
+        self.assertFalse(evaluations[3].within_budget)
+        self.assertFalse(evaluations[3].pareto_optimal)
+        self.assertEqual([evaluation.sequence for evaluation in recommended(evaluations)], ['a', DEFAULT_SEQUENCE])
+
+        report = format_report(evaluations, 'console')
+        self.assertIn('over budget', report)
+        self.assertIn('rejected (x.sol: compilation failed)', report)
+        self.assertTrue(report.endswith('Recommended sequences:\n- a\n- default'))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+
+import unittest
+from textwrap import dedent
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from semantic_gas_report import aggregate, compare_reports, format_comparison, parse_gas_expectations
+# pragma pylint: enable=import-error
+
+
+def report(tests: dict, source: str = 'test files') -> dict:
+    return {'source': source, 'totals': aggregate(tests), 'tests': tests}
+
+
+class TestSemanticGasReport(unittest.TestCase):
+    def test_parse_gas_expectations(self):
+        test_source = dedent("""
+            contract C {
+                function f() public {}
+            }
+            // gas legacy: 1
+            // ----
+            // constructor()
+            // gas legacy: 100
+            // gas legacy code: 20
+            // f() -> 1
+            // ~ emit E()
+            // gas irOptimized: 200
+            // gas legacyOptimized: 300
+            // f() -> 1
+            // gas irOptimized: 400
+            // g() -> 2
+        """)
+        self.assertEqual(parse_gas_expectations(test_source), {
+            'constructor()': {'legacy': 100, 'legacy code': 20},
+            'f() -> 1': {'irOptimized': 200, 'legacyOptimized': 300},
+            'f() -> 1#2': {'irOptimized': 400},
+        })
+
+    def test_aggregate(self):
+        tests = {
+            'a/x.sol': {'f()': {'legacy': 1, 'ir': 2}, 'g()': {'legacy': 3}},
+            'a/y.sol': {'f()': {'legacy': 10}},
+            'b/z.sol': {'f()': {'ir code': 100}},
+            'top.sol': {'f()': {'ir': 1000}},
+        }
+        self.assertEqual(aggregate(tests), {
+            'a': {'legacy': 14, 'ir': 2},
+            'b': {'ir code': 100},
+            '.': {'ir': 1000},
+            'total': {'legacy': 14, 'ir': 1002, 'ir code': 100},
+        })
+
+    def test_compare_reports_only_takes_matched_calls_into_account(self):
+        baseline = report({
+            'a/x.sol': {'f()': {'legacy': 100, 'irOptimized': 100}, 'removed()': {'legacy': 1000}},
+            'b/y.sol': {'f()': {'legacy': 200}},
+        })
+        current = report({
+            'a/x.sol': {'f()': {'legacy': 110, 'irOptimized': 90}, 'added()': {'legacy': 1000}},
+            'b/y.sol': {'f()': {'legacy': 200, 'irOptimized': 50}},
+            'c/new.sol': {'f()': {'legacy': 1}},
+        })
+
+        comparison = compare_reports(baseline, current)
+        self.assertEqual(list(comparison['differences']), ['a', 'b', 'total'])
+        self.assertEqual(comparison['differences']['a']['legacy'], {'baseline': 100, 'current': 110, 'difference': 0.1})
+        self.assertEqual(comparison['differences']['a']['irOptimized']['difference'], -0.1)
+        self.assertEqual(comparison['differences']['b'], {'legacy': {'baseline': 200, 'current': 200, 'difference': 0.0}})
+        self.assertEqual(comparison['differences']['total']['legacy'], {'baseline': 300, 'current': 310, 'difference': 0.1 / 3})
+        self.assertEqual(comparison['regressions'], [
+            'a (legacy): gas increased by +10.00%',
+            'total (legacy): gas increased by +3.33%',
+        ])
+
+        self.assertEqual(compare_reports(baseline, current, 0.05)['regressions'], ['a (legacy): gas increased by +10.00%'])
+
+    def test_format_comparison(self):
+        baseline = report({'a/x.sol': {'f()': {'legacy': 100, 'irOptimized': 100}}})
+        current = report({'a/x.sol': {'f()': {'legacy': 100, 'irOptimized': 90}}}, 'isoltest')
+
+        self.assertEqual(format_comparison(compare_reports(baseline, current), 'markdown'), '\n'.join([
+            'Baseline: test files',
+            'Current:  isoltest',
+            '',
+            '| Category | legacy | irOptimized |',
+            '|---|---:|---:|',
+            '| a | +0.00% | -10.00% |',
+            '| total | +0.00% | -10.00% |',
+            '',
+            'No regressions.',
+        ]))
+
+
+if __name__ == '__main__':
+    unittest.main()
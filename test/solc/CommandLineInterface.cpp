@@ -29,6 +29,9 @@
 #include <liblangutil/SemVerHandler.h>
 #include <test/FilesystemUtils.h>
 
+#include <libsolidity/lsp/Transport.h>
+
+#include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/TemporaryDirectory.h>
 
@@ -442,6 +445,229 @@ BOOST_AUTO_TEST_CASE(standard_json_remapping)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(standard_json_server_input_file)
+{
+	std::string expectedMessage =
+		"Input files are not accepted in --server mode.\n"
+		"Please send the Standard JSON inputs as requests on standard input.";
+
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLineAndReadInputFiles({"solc", "--standard-json", "--server", "input.json"}),
+		CommandLineValidationError,
+		[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+	);
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_server)
+{
+	auto message = [](Json _message) {
+		_message["jsonrpc"] = "2.0";
+		std::string content = jsonCompactPrint(_message);
+		return "Content-Length: " + std::to_string(content.size()) + "\r\n\r\n" + content;
+	};
+	Json input = Json::parse(R"({
+		"language": "Solidity",
+		"sources": {"A.sol": {"content": "pragma solidity >=0.0; contract C { function f() public {} }"}},
+		"settings": {"optimizer": {"enabled": true}, "viaIR": true, "outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}
+	})");
+	std::string requests =
+		message({{"id", 1}, {"method", "compile"}, {"params", input}}) +
+		message({{"id", 2}, {"method", "compile"}, {"params", input}}) +
+		message({{"id", 3}, {"method", "link"}, {"params", input}}) +
+		message({{"method", "exit"}}) +
+		message({{"id", 4}, {"method", "compile"}, {"params", input}});
+
+	OptionsReaderAndMessages result = runCLI({"solc", "--standard-json", "--server"}, requests);
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.stderrContent == "");
+
+	std::vector<Json> replies;
+	for (size_t position = 0; position < result.stdoutContent.size();)
+	{
+		size_t contentStart = result.stdoutContent.find("\r\n\r\n", position) + 4;
+		size_t length = std::stoul(result.stdoutContent.substr(position + std::string("Content-Length: ").size()));
+		replies.emplace_back(Json::parse(result.stdoutContent.substr(contentStart, length)));
+		position = contentStart + length;
+	}
+	BOOST_REQUIRE(replies.size() == 3);
+	BOOST_TEST(replies[0]["id"] == 1);
+	BOOST_TEST(replies[1]["id"] == 2);
+	BOOST_TEST(replies[0]["result"]["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].is_string());
+	BOOST_TEST(replies[0]["result"] == replies[1]["result"]);
+	BOOST_TEST(replies[2]["id"] == 3);
+	BOOST_TEST(replies[2]["error"]["code"] == static_cast<int>(lsp::ErrorCode::MethodNotFound));
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_batch)
+{
+	std::string input = R"({"language": "Solidity", "sources": {"A.sol": {"content": "pragma solidity >=0.0; contract C {}"}}, "settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}})";
+	std::string inputs = input + "\n{\n\n" + input + "\n";
+
+	OptionsReaderAndMessages result = runCLI({"solc", "--standard-json", "--batch", "--threads=2"}, inputs);
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.stderrContent == "");
+
+	std::vector<std::string> lines;
+	boost::split(lines, boost::trim_copy(result.stdoutContent), boost::is_any_of("\n"));
+	BOOST_REQUIRE(lines.size() == 3);
+	BOOST_TEST(Json::parse(lines[0])["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].is_string());
+	BOOST_TEST(Json::parse(lines[1])["errors"][0]["type"] == "JSONError");
+	BOOST_TEST(lines[2] == lines[0]);
+}
+
+BOOST_AUTO_TEST_CASE(link_sets)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	std::string placeholder = "__" + evmasm::LinkerObject::libraryPlaceholder("a.sol:L") + "__";
+	std::string zeros(64, '0');
+	createFileWithContent(
+		tempDir.path() / "bytecode.json",
+		R"({"object": "60)" + placeholder + "60" + zeros + R"(",)"
+		R"("linkReferences": {"a.sol": {"L": [{"start": 1, "length": 20}]}},)"
+		R"("immutableReferences": {"7": [{"start": 22, "length": 32}]}})"
+	);
+	createFileWithContent(tempDir.path() / "sets.json", R"([
+		{"libraries": {"a.sol:L": "0x1234567890123456789012345678901234567890"}, "immutables": {"7": "0x2a"}},
+		{"immutables": {"7": "0x01"}}
+	])");
+
+	OptionsReaderAndMessages result = runCLI({
+		"solc",
+		"--link",
+		"--link-sets=" + (tempDir.path() / "sets.json").string(),
+		(tempDir.path() / "bytecode.json").string()
+	});
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.stderrContent.find("Reference to \"a.sol:L\" still unresolved by entry 1 of --link-sets.") != std::string::npos);
+	BOOST_TEST(Json::parse(result.stdoutContent) == Json::array({
+		"60" "1234567890123456789012345678901234567890" "60" + zeros.substr(2) + "2a",
+		"60" + placeholder + "60" + zeros.substr(2) + "01"
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(bin_runtime_template)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFileWithContent(
+		tempDir.path() / "a.sol",
+		"pragma solidity >=0.0; contract C { uint immutable x = 1; function f() public view returns (uint) { return x; } }"
+	);
+
+	OptionsReaderAndMessages result = runCLI({
+		"solc",
+		"--bin-runtime-template",
+		"--output-dir=" + tempDir.path().string(),
+		(tempDir.path() / "a.sol").string()
+	});
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.stderrContent == "");
+
+	Json output = Json::parse(readFileAsString(tempDir.path() / "C_runtime-template.json"));
+	BOOST_TEST(output["object"].is_string());
+	BOOST_TEST(output["linkReferences"] == Json::object());
+	BOOST_REQUIRE(output["immutableReferences"].size() == 1);
+	std::string id = output["immutableReferences"].begin().key();
+	BOOST_TEST(output["immutables"][id]["name"] == "C.x");
+	BOOST_TEST(output["immutables"][id]["type"] == "uint256");
+}
+
+BOOST_AUTO_TEST_CASE(strict_assembly_threads)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFileWithContent(
+		tempDir.path() / "input.yul",
+		"object \"A\" {\n"
+		"	code { let x := a }\n"
+		"	object \"B\" {\n"
+		"		code { let y := b }\n"
+		"		object \"C\" { code { sstore(0, 1) } }\n"
+		"	}\n"
+		"	object \"D\" { code { let z := d } }\n"
+		"}\n"
+	);
+
+	std::vector<std::string> commandLine = {"solc", "--strict-assembly", (tempDir.path() / "input.yul").string()};
+	OptionsReaderAndMessages serial = runCLI(commandLine);
+	commandLine.emplace_back("--threads=4");
+	OptionsReaderAndMessages parallel = runCLI(commandLine);
+
+	BOOST_TEST(!serial.success);
+	BOOST_TEST(!parallel.success);
+	BOOST_TEST(parallel.stderrContent == serial.stderrContent);
+	size_t a = serial.stderrContent.find("\"a\"");
+	size_t b = serial.stderrContent.find("\"b\"");
+	size_t d = serial.stderrContent.find("\"d\"");
+	BOOST_TEST((a < b && b < d && d != std::string::npos));
+}
+
+BOOST_AUTO_TEST_CASE(cli_output_dir_threads)
+{
+	TemporaryDirectory tempDir({"in", "serial", "parallel"}, TEST_CASE_NAME);
+	createFileWithContent(
+		tempDir.path() / "in/a.sol",
+		"pragma solidity >=0.0; contract A { function f() public {} } contract B { A a = new A(); } contract C {}"
+	);
+
+	std::vector<std::string> commandLine = {
+		"solc",
+		"--bin",
+		"--opcodes",
+		"--asm",
+		"--abi",
+		"--combined-json=abi,bin,opcodes,asm,srcmap",
+		(tempDir.path() / "in/a.sol").string(),
+		"--output-dir"
+	};
+	OptionsReaderAndMessages serial = runCLI(commandLine + std::vector<std::string>{(tempDir.path() / "serial").string()});
+	OptionsReaderAndMessages parallel = runCLI(commandLine + std::vector<std::string>{
+		(tempDir.path() / "parallel").string(),
+		"--threads=3"
+	});
+	BOOST_TEST(serial.success);
+	BOOST_TEST(parallel.success);
+	BOOST_TEST(parallel.stderrContent == serial.stderrContent);
+
+	size_t numFiles = 0;
+	for (auto const& entry: boost::filesystem::directory_iterator(tempDir.path() / "serial"))
+	{
+		boost::filesystem::path parallelFile = tempDir.path() / "parallel" / entry.path().filename();
+		BOOST_REQUIRE(boost::filesystem::exists(parallelFile));
+		BOOST_TEST(readFileAsString(parallelFile) == readFileAsString(entry.path()));
+		++numFiles;
+	}
+	// Four outputs for each of the three contracts and the combined JSON.
+	BOOST_TEST(numFiles == 13);
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_stream_output)
+{
+	std::string input = R"({
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {"content": "pragma solidity >=0.0; contract A {} contract B {}"},
+			"C.sol": {"content": "pragma solidity >=0.0; contract C {}"}
+		},
+		"settings": {"outputSelection": {"*": {"*": ["abi"], "": ["ast"]}}}
+	})";
+
+	OptionsReaderAndMessages streamed = runCLI({"solc", "--standard-json", "--stream-output"}, input);
+	OptionsReaderAndMessages full = runCLI({"solc", "--standard-json"}, input);
+	BOOST_TEST(streamed.success);
+	BOOST_TEST(streamed.stderrContent == "");
+
+	std::vector<std::string> lines;
+	boost::split(lines, boost::trim_copy(streamed.stdoutContent), boost::is_any_of("\n"));
+	// Two sources, three contracts and the remaining output.
+	BOOST_REQUIRE(lines.size() == 6);
+	BOOST_TEST(Json::parse(lines[0])["sources"].contains("A.sol"));
+	BOOST_TEST(Json::parse(lines[2])["contracts"]["A.sol"].contains("A"));
+
+	Json merged = Json::parse(lines.back());
+	for (size_t i = 0; i + 1 < lines.size(); ++i)
+		merged.merge_patch(Json::parse(lines[i]));
+	BOOST_TEST(merged == Json::parse(full.stdoutContent));
+}
+
 BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 {
 	TemporaryDirectory tempDirCurrent(TEST_CASE_NAME);
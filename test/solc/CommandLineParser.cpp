@@ -120,6 +120,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--threads=4",
+			"--cache-dir=/tmp/cache",
+			"--profile=/tmp/profile.json",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -129,10 +132,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--libraries="
 				"dir1/file1.sol:L=0x1234567890123456789012345678901234567890,"
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
-			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
+			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--bin-runtime-template", "--abi",
 			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata",
 			"--yul-cfg-json",
-			"--storage-layout", "--transient-storage-layout",
+			"--storage-layout", "--transient-storage-layout", "--ast-binary",
 			"--gas",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,transient-storage-layout,generated-sources,generated-sources-runtime,"
@@ -142,13 +145,19 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-yul",
 			"--optimize-runs=1000",
+			"--optimize-code-size-target=24576",
+			"--optimize-calling-convention",
+			"--optimize-function-exits",
 			"--yul-optimizations=agf",
 			"--model-checker-bmc-loop-iterations=2",
+			"--model-checker-chc-threads=4",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-persistent-solvers",
+			"--model-checker-race-solvers",
 			"--model-checker-show-proved-safe",
 			"--model-checker-show-unproved",
 			"--model-checker-show-unsupported",
@@ -181,6 +190,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.numThreads = 4;
+		expectedOptions.output.cacheDir = "/tmp/cache";
+		expectedOptions.output.profileFile = "/tmp/profile.json";
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -194,7 +206,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true, true, true,
+			true, true, true, true, true,
 		};
 		expectedOptions.compiler.estimateGas = true;
 		expectedOptions.compiler.combinedJsonRequests = {
@@ -208,17 +220,22 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.optimizeEvmasm = true;
 		expectedOptions.optimizer.optimizeYul = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
+		expectedOptions.optimizer.codeSizeTarget = 24576;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.optimizeCallingConvention = true;
+		expectedOptions.optimizer.optimizeFunctionExits = true;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
 			2,
+			4, // --model-checker-chc-threads
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
 			true,
 			{true, false},
 			{ModelCheckerExtCalls::Mode::TRUSTED},
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
 			false, // --model-checker-print-query
+			true, // --model-checker-race-solvers
 			true,
 			true,
 			true,
@@ -226,6 +243,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
 		};
+		expectedOptions.modelChecker.persistentSolvers = true;
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
@@ -267,6 +285,53 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(threads_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.numThreads == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--threads=8", "contract.sol"}).output.numThreads == 8);
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--threads=0", "contract.sol"}), CommandLineValidationError);
+	BOOST_TEST(parseCommandLine({"solc", "--standard-json", "--batch", "--threads=8"}).output.numThreads == 8);
+	BOOST_TEST(parseCommandLine({"solc", "--strict-assembly", "--threads=8", "input.yul"}).output.numThreads == 8);
+}
+
+BOOST_AUTO_TEST_CASE(stream_output_option)
+{
+	BOOST_TEST(!parseCommandLine({"solc", "--standard-json"}).output.stream);
+	BOOST_TEST(parseCommandLine({"solc", "--standard-json", "--stream-output"}).output.stream);
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--standard-json", "--stream-output", "--server"}), CommandLineValidationError);
+
+	std::string expectedMessage = "Option --stream-output cannot be used together with --pretty-json or --json-indent.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	for (std::string formattingOption: {"--pretty-json", "--json-indent=2"})
+		BOOST_CHECK_EXCEPTION(
+			parseCommandLine({"solc", "--standard-json", "--stream-output", formattingOption}),
+			CommandLineValidationError,
+			hasCorrectMessage
+		);
+}
+
+BOOST_AUTO_TEST_CASE(cache_dir_option)
+{
+	BOOST_TEST(!parseCommandLine({"solc", "contract.sol"}).output.cacheDir.has_value());
+	BOOST_TEST(parseCommandLine({"solc", "--cache-dir=/tmp/cache", "contract.sol"}).output.cacheDir == "/tmp/cache");
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--cache-dir=", "contract.sol"}), CommandLineValidationError);
+}
+
+BOOST_AUTO_TEST_CASE(profile_option)
+{
+	BOOST_TEST(!parseCommandLine({"solc", "contract.sol"}).output.profileFile.has_value());
+	BOOST_TEST(parseCommandLine({"solc", "--profile=/tmp/profile.json", "contract.sol"}).output.profileFile == "/tmp/profile.json");
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--profile=", "contract.sol"}), CommandLineValidationError);
+}
+
+BOOST_AUTO_TEST_CASE(ast_binary_option)
+{
+	BOOST_TEST(!parseCommandLine({"solc", "contract.sol"}).compiler.outputs.astBinary);
+	BOOST_TEST(parseCommandLine({"solc", "--ast-binary", "--output-dir=/tmp/out", "contract.sol"}).compiler.outputs.astBinary);
+	BOOST_TEST(parseCommandLine({"solc", "--ast-binary", "--stop-after=parsing", "-o", "/tmp/out", "contract.sol"}).compiler.outputs.astBinary);
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--ast-binary", "contract.sol"}), CommandLineValidationError);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static std::vector<std::tuple<std::vector<std::string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -423,8 +488,13 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--threads=2", {"--standard-json", "--link"}},
+		{"--cache-dir=/tmp/cache", {"--assemble", "--strict-assembly", "--link"}},
 		{"--metadata-literal", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-chc-threads=4", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-persistent-solvers", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-race-solvers", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unproved", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unsupported", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
@@ -434,7 +504,12 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-contracts=contract1.yul:A,contract2.yul:B", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
-		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--strict-assembly", "--standard-json", "--link"}}
+		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--server", {"--assemble", "--strict-assembly", "--link"}},
+		{"--batch", {"--assemble", "--strict-assembly", "--link"}},
+		{"--link-sets=sets.json", {"--assemble", "--strict-assembly", "--standard-json"}},
+		{"--optimize-calling-convention", {"--standard-json", "--link"}},
+		{"--optimize-function-exits", {"--standard-json", "--link"}}
 	};
 
 	for (auto const& [optionName, inputModes]: invalidOptionInputModeCombinations)
@@ -463,6 +538,10 @@ BOOST_AUTO_TEST_CASE(optimizer_flags)
 	OptimiserSettings evmasmOnly = OptimiserSettings::standard();
 	evmasmOnly.runYulOptimiser = false;
 
+	OptimiserSettings optimizedFunctionCalls = OptimiserSettings::standard();
+	optimizedFunctionCalls.optimizeCallingConvention = true;
+	optimizedFunctionCalls.optimizeFunctionExits = true;
+
 	std::map<std::vector<std::string>, OptimiserSettings> settingsMap = {
 		{{}, OptimiserSettings::minimal()},
 		{{"--optimize"}, OptimiserSettings::standard()},
@@ -470,6 +549,7 @@ BOOST_AUTO_TEST_CASE(optimizer_flags)
 		{{"--optimize-yul"}, yulOnly},
 		{{"--optimize", "--no-optimize-yul"}, evmasmOnly},
 		{{"--optimize", "--optimize-yul"}, OptimiserSettings::standard()},
+		{{"--optimize", "--optimize-calling-convention", "--optimize-function-exits"}, optimizedFunctionCalls},
 	};
 
 	std::map<InputMode, std::string> inputModeFlagMap = {
@@ -487,6 +567,19 @@ BOOST_AUTO_TEST_CASE(optimizer_flags)
 		}
 }
 
+BOOST_AUTO_TEST_CASE(function_call_optimizations_without_yul_optimizer)
+{
+	for (std::string const& option: {"--optimize-calling-convention", "--optimize-function-exits"})
+		for (std::vector<std::string> const& optimizerFlags: std::vector<std::vector<std::string>>{{}, {"--optimize", "--no-optimize-yul"}})
+		{
+			std::vector<std::string> commandLine = {"solc", "contract.sol", option};
+			commandLine += optimizerFlags;
+			std::string expectedMessage = "Option " + option + " requires the Yul optimizer to be enabled.";
+			auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+			BOOST_CHECK_EXCEPTION(parseCommandLine(commandLine), CommandLineValidationError, hasCorrectMessage);
+		}
+}
+
 BOOST_AUTO_TEST_CASE(default_optimiser_sequence)
 {
 	CommandLineOptions const& commandLineOptions = parseCommandLine({"solc", "contract.sol", "--optimize"});
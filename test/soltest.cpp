@@ -275,7 +275,9 @@ test_suite* init_unit_test_suite(int /*argc*/, char* /*argv*/[])
 				"GasMeterTests",
 				"GasCostTests",
 				"SolidityEndToEndTest",
-				"SolidityOptimizer"
+				"SolidityOptimizer",
+				"CallingConventionExecution",
+				"FunctionExitsExecution"
 			})
 				removeTestSuite(suite);
 		}
@@ -69,6 +69,12 @@ void IsolTestOptions::addOptions()
 		("help", po::bool_switch(&showHelp)->default_value(showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor)->default_value(noColor), "Don't use colors.")
 		("accept-updates", po::bool_switch(&acceptUpdates)->default_value(acceptUpdates), "Automatically accept expectation updates.")
+		(
+			"threads,j",
+			po::value<size_t>(&threads)->default_value(threads),
+			"Number of threads to run the test cases of a test suite on. "
+			"Results are still reported in order and failures are handled one after another."
+		)
 		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
 }
 
@@ -97,6 +103,7 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(threads > 0, ConfigException, "The number of threads must be at least 1.");
 }
 
 }
@@ -34,6 +34,7 @@ struct IsolTestOptions: CommonOptions
 	bool acceptUpdates = false;
 	std::string testFilter = std::string{};
 	std::string editor = std::string{};
+	size_t threads = 1;
 
 	explicit IsolTestOptions();
 	void addOptions() override;
@@ -18,6 +18,8 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/ThreadPool.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <memory>
 #include <test/Common.h>
@@ -28,11 +30,16 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
 
+#include <atomic>
 #include <cstdlib>
+#include <future>
 #include <iostream>
+#include <optional>
 #include <queue>
 #include <regex>
+#include <sstream>
 #include <utility>
+#include <vector>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -112,7 +119,8 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case and writes its progress and results to @a _stream.
+	Result process(std::ostream& _stream);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -138,14 +146,20 @@ private:
 	fs::path const m_path;
 	std::string const m_name;
 
+	/// Types of a test case run on a worker thread, which cannot use the global TypeProvider.
+	/// Declared before m_test, because its compiler stack uses it until it is destroyed.
+	std::unique_ptr<TypeProvider> m_typeProvider;
 	std::unique_ptr<TestCase> m_test;
+	/// Result and output of a test case run on a worker thread, before they are reported.
+	Result m_result = Result::Skipped;
+	std::stringstream m_output;
 
 	static bool m_exitRequested;
 };
 
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(std::ostream& _stream)
 {
 	bool formatted{!m_options.noColor};
 
@@ -153,7 +167,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_path, m_name))
 		{
-			(AnsiColorized(std::cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -169,22 +183,22 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(std::cout, formatted, {BOLD, GREEN}) << "OK" << std::endl;
+						AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << std::endl;
 						return Result::Success;
 					default:
-						AnsiColorized(std::cout, formatted, {BOLD, RED}) << "FAIL" << std::endl;
+						AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << std::endl;
 
-						AnsiColorized(std::cout, formatted, {BOLD, CYAN}) << "  Contract:" << std::endl;
-						m_test->printSource(std::cout, "    ", formatted);
-						m_test->printSettings(std::cout, "    ", formatted);
+						AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << std::endl;
+						m_test->printSource(_stream, "    ", formatted);
+						m_test->printSettings(_stream, "    ", formatted);
 
-						std::cout << std::endl << outputMessages.str() << std::endl;
+						_stream << std::endl << outputMessages.str() << std::endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			}
 			else
 			{
-				AnsiColorized(std::cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << std::endl;
+				AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << std::endl;
 				return Result::Skipped;
 			}
 		}
@@ -193,7 +207,7 @@ TestTool::Result TestTool::process()
 	}
 	catch (...)
 	{
-		AnsiColorized(std::cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unhandled exception during test: " << boost::current_exception_diagnostic_information() << std::endl;
 		return Result::Exception;
 	}
@@ -262,6 +276,7 @@ TestStats TestTool::processPath(
 {
 	std::queue<fs::path> paths;
 	paths.push(_path);
+	std::vector<fs::path> testPaths;
 	int successCount = 0;
 	int testCount = 0;
 	int skippedCount = 0;
@@ -269,11 +284,11 @@ TestStats TestTool::processPath(
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -282,52 +297,97 @@ TestStats TestTool::processPath(
 					paths.push(currentPath / entry.path().filename());
 		}
 		else if (m_exitRequested)
-		{
 			++testCount;
-			paths.pop();
-		}
 		else if (!_batcher.checkAndAdvance())
-		{
-			paths.pop();
 			++skippedCount;
-		}
 		else
+			testPaths.push_back(currentPath);
+	}
+
+	auto createTestTool = [&](fs::path const& _testPath) {
+		return std::make_unique<TestTool>(
+			_testCaseCreator,
+			_options,
+			_basepath / _testPath,
+			_testPath.generic_path().string()
+		);
+	};
+
+	// With multiple threads, all test cases are run up front and their results are reported
+	// in order as they become available. Failures are then handled on this thread as usual,
+	// re-running a test case after its update on this thread as well.
+	std::atomic<bool> cancelled{false};
+	std::vector<std::future<std::unique_ptr<TestTool>>> concurrentlyRunTests;
+	std::optional<util::ThreadPool> threadPool;
+	if (_options.threads > 1 && testPaths.size() > 1)
+	{
+		threadPool.emplace(_options.threads);
+		for (fs::path const& testPath: testPaths)
+			concurrentlyRunTests.emplace_back(threadPool->submit([&, testPath]() {
+				std::unique_ptr<TestTool> testTool = createTestTool(testPath);
+				// Compiler stacks on different threads need TypeProviders of their own.
+				testTool->m_typeProvider = std::make_unique<TypeProvider>();
+				TypeProvider::Activation typeProviderActivation(testTool->m_typeProvider.get());
+				if (!cancelled)
+					testTool->m_result = testTool->process(testTool->m_output);
+				return testTool;
+			}));
+	}
+
+	for (size_t i = 0; i < testPaths.size(); ++i)
+	{
+		std::unique_ptr<TestTool> concurrentlyRunTest;
+		if (!concurrentlyRunTests.empty())
+			concurrentlyRunTest = concurrentlyRunTests[i].get();
+
+		bool done = false;
+		while (!done)
 		{
 			++testCount;
-			TestTool testTool(
-				_testCaseCreator,
-				_options,
-				fullpath,
-				currentPath.generic_path().string()
-			);
-			auto result = testTool.process();
+			if (m_exitRequested)
+				break;
+
+			std::unique_ptr<TestTool> testTool;
+			Result result;
+			if (concurrentlyRunTest)
+			{
+				testTool = std::move(concurrentlyRunTest);
+				std::cout << testTool->m_output.str();
+				result = testTool->m_result;
+			}
+			else
+			{
+				testTool = createTestTool(testPaths[i]);
+				result = testTool->process(std::cout);
+			}
 
+			done = true;
+			// Handling a test case run on a worker thread uses its TypeProvider, otherwise the global one is used.
+			TypeProvider::Activation typeProviderActivation(testTool->m_typeProvider.get());
 			switch(result)
 			{
 			case Result::Failure:
 			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
+				switch(testTool->handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
 					m_exitRequested = true;
+					cancelled = true;
 					break;
 				case Request::Rerun:
 					std::cout << "Re-running test case..." << std::endl;
 					--testCount;
+					done = false;
 					break;
 				case Request::Skip:
-					paths.pop();
 					++skippedCount;
 					break;
 				}
 				break;
 			case Result::Success:
-				paths.pop();
 				++successCount;
 				break;
 			case Result::Skipped:
-				paths.pop();
 				++skippedCount;
 				break;
 			}
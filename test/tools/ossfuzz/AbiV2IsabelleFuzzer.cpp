@@ -57,7 +57,9 @@ DEFINE_PROTO_FUZZER(Contract const& _contract)
 
 		// We target the default EVM which is the latest
 		langutil::EVMVersion version;
-		EVMHost hostContext(version, evmone);
+		// The host is kept across inputs, resetting it is cheaper than setting up a new one.
+		static EVMHost hostContext(version, evmone);
+		hostContext.reset();
 		std::string contractName = "C";
 		StringMap source({{"test.sol", contractSource}});
 		CompilerInput cInput(version, source, contractName, OptimiserSettings::minimal(), {});
@@ -31,14 +31,15 @@ using namespace solidity::util;
 
 std::optional<CompilerOutput> SolidityCompilationFramework::compileContract()
 {
-	m_compiler.setSources(m_compilerInput.sourceCode);
-	m_compiler.setLibraries(m_compilerInput.libraryAddresses);
-	m_compiler.setEVMVersion(m_compilerInput.evmVersion);
-	m_compiler.setOptimiserSettings(m_compilerInput.optimiserSettings);
-	m_compiler.setViaIR(m_compilerInput.viaIR);
-	if (!m_compiler.compile())
+	// The sources are only compiled once, all contracts are then taken from the same compilation
+	// and linked against the library addresses known at that point.
+	if (m_compiler.state() == CompilerStack::Empty)
 	{
-		if (m_compilerInput.debugFailure)
+		m_compiler.setSources(m_compilerInput.sourceCode);
+		m_compiler.setEVMVersion(m_compilerInput.evmVersion);
+		m_compiler.setOptimiserSettings(m_compilerInput.optimiserSettings);
+		m_compiler.setViaIR(m_compilerInput.viaIR);
+		if (!m_compiler.compile() && m_compilerInput.debugFailure)
 		{
 			std::cerr << "Compiling contract failed" << std::endl;
 			std::cerr << SourceReferenceFormatter::formatErrorInformation(
@@ -46,19 +47,19 @@ std::optional<CompilerOutput> SolidityCompilationFramework::compileContract()
 				m_compiler
 			);
 		}
-		return {};
 	}
+	if (!m_compiler.compilationSuccessful())
+		return {};
+
+	std::string contractName;
+	if (m_compilerInput.contractName.empty())
+		contractName = m_compiler.lastContractName();
 	else
-	{
-		std::string contractName;
-		if (m_compilerInput.contractName.empty())
-			contractName = m_compiler.lastContractName();
-		else
-			contractName = m_compilerInput.contractName;
-		evmasm::LinkerObject obj = m_compiler.object(contractName);
-		Json methodIdentifiers = m_compiler.interfaceSymbols(contractName)["methods"];
-		return CompilerOutput{obj.bytecode, methodIdentifiers};
-	}
+		contractName = m_compilerInput.contractName;
+	evmasm::LinkerObject obj = m_compiler.object(contractName);
+	obj.link(m_compilerInput.libraryAddresses);
+	Json methodIdentifiers = m_compiler.interfaceSymbols(contractName)["methods"];
+	return CompilerOutput{obj.bytecode, methodIdentifiers};
 }
 
 bool EvmoneUtility::zeroWord(uint8_t const* _result, size_t _length)
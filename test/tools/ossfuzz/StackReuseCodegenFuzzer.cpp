@@ -83,7 +83,8 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	// Do not fuzz the EVM Version field.
 	// See https://github.com/ethereum/solidity/issues/12590
 	langutil::EVMVersion version;
-	EVMHost hostContext(version, evmone);
+	// The host is kept across inputs, resetting it is cheaper than setting up a new one.
+	static EVMHost hostContext(version, evmone);
 	hostContext.reset();
 
 	if (const char* dump_path = getenv("PROTO_FUZZER_DUMP_PATH"))
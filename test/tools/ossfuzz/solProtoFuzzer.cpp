@@ -64,7 +64,9 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 
 	// We target the default EVM which is the latest
 	langutil::EVMVersion version;
-	EVMHost hostContext(version, evmone);
+	// The host is kept across inputs, resetting it is cheaper than setting up a new one.
+	static EVMHost hostContext(version, evmone);
+	hostContext.reset();
 	std::string contractName = "C";
 	std::string libraryName = converter.libraryTest() ? converter.libraryName() : "";
 	std::string methodName = "test()";
@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <test/tools/yulInterpreter/CopyOnWrite.h>
+
+#include <algorithm>
+
+using namespace solidity;
+using namespace solidity::yul::test;
+
+uint8_t PagedMemory::get(u256 const& _address) const
+{
+	auto page = m_pages.find(_address / PageSize);
+	if (page == m_pages.end())
+		return 0;
+	return (*page->second)[static_cast<size_t>(_address % PageSize)];
+}
+
+void PagedMemory::set(u256 const& _address, uint8_t _value)
+{
+	writablePage(_address / PageSize)[static_cast<size_t>(_address % PageSize)] = _value;
+}
+
+bytes PagedMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	u256 address = _offset;
+	for (size_t position = 0; position < _size;)
+	{
+		size_t const offsetInPage = static_cast<size_t>(address % PageSize);
+		size_t const chunkSize = std::min(_size - position, PageSize - offsetInPage);
+		auto page = m_pages.find(address / PageSize);
+		if (page != m_pages.end())
+			std::copy_n(page->second->begin() + offsetInPage, chunkSize, data.begin() + position);
+		position += chunkSize;
+		// Wraps around at the end of the address space since PageSize divides 2**256.
+		address += chunkSize;
+	}
+	return data;
+}
+
+void PagedMemory::write(u256 const& _offset, bytesConstRef _data)
+{
+	u256 address = _offset;
+	for (size_t position = 0; position < _data.size();)
+	{
+		size_t const offsetInPage = static_cast<size_t>(address % PageSize);
+		size_t const chunkSize = std::min(_data.size() - position, PageSize - offsetInPage);
+		std::copy_n(_data.begin() + position, chunkSize, writablePage(address / PageSize).begin() + offsetInPage);
+		position += chunkSize;
+		address += chunkSize;
+	}
+}
+
+PagedMemory::Page& PagedMemory::writablePage(u256 const& _index)
+{
+	std::shared_ptr<Page>& page = m_pages[_index];
+	if (!page)
+		page = std::make_shared<Page>();
+	else if (page.use_count() > 1)
+		page = std::make_shared<Page>(*page);
+	return *page;
+}
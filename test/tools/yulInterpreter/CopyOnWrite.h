@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Containers for the Yul interpreter state that share their contents between copies
+ * until one of the copies is modified.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <map>
+#include <memory>
+
+namespace solidity::yul::test
+{
+
+/**
+ * Value of type @a T that is shared between copies of the container and only copied
+ * when it is modified while shared. Copying the container itself is cheap.
+ */
+template <typename T>
+class CopyOnWrite
+{
+public:
+	CopyOnWrite(): m_value(std::make_shared<T>()) {}
+
+	T const& operator*() const { return *m_value; }
+	T const* operator->() const { return m_value.get(); }
+
+	/// @returns a reference to the value that can be modified without affecting any copy.
+	T& write()
+	{
+		if (m_value.use_count() > 1)
+			m_value = std::make_shared<T>(*m_value);
+		return *m_value;
+	}
+
+private:
+	std::shared_ptr<T> m_value;
+};
+
+/**
+ * Byte addressable memory with the full 256 bit address space, initialised to zero.
+ * It is stored in pages of @a PageSize bytes, which are allocated on the first write and
+ * then shared between copies of the memory until one of the copies writes to them. This
+ * makes taking a snapshot of the memory cheap, e.g. to fork an execution.
+ *
+ * Accesses wrap around at the end of the address space.
+ */
+class PagedMemory
+{
+public:
+	/// Size of a single page, a multiple of the word size.
+	static constexpr size_t PageSize = 0x400;
+	using Page = std::array<uint8_t, PageSize>;
+
+	/// @returns the byte at @a _address.
+	uint8_t get(u256 const& _address) const;
+	/// Sets the byte at @a _address to @a _value.
+	void set(u256 const& _address, uint8_t _value);
+	/// @returns @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Writes @a _data to the memory starting at @a _offset.
+	void write(u256 const& _offset, bytesConstRef _data);
+
+	/// @returns the pages that have been written to, indexed by their address divided by @a PageSize.
+	/// The pages may be shared with other copies and must not be modified through this.
+	std::map<u256, std::shared_ptr<Page>> const& pages() const { return m_pages; }
+
+private:
+	/// @returns the page with the given index, ready to be modified.
+	Page& writablePage(u256 const& _index);
+
+	std::map<u256, std::shared_ptr<Page>> m_pages;
+};
+
+}
@@ -30,10 +30,12 @@
 #include <libevmasm/Instruction.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <libsolutil/FixedU256.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/picosha2.h>
 
+#include <algorithm>
 #include <limits>
 
 using namespace solidity;
@@ -41,6 +43,7 @@ using namespace solidity::evmasm;
 using namespace solidity::yul;
 using namespace solidity::yul::test;
 
+using solidity::util::FixedU256;
 using solidity::util::h160;
 using solidity::util::h256;
 using solidity::util::keccak256;
@@ -71,43 +74,51 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 	}
 }
 
+/// @returns the value of @a _slot in @a _storage, which is zero for slots that were never written.
+h256 storageValue(std::map<h256, h256> const& _storage, h256 const& _slot)
+{
+	auto value = _storage.find(_slot);
+	return value == _storage.end() ? h256{} : value->second;
+}
+
 }
 
 namespace solidity::yul::test
 {
 
 void copyZeroExtended(
-	std::map<u256, uint8_t>& _target,
+	PagedMemory& _target,
 	bytes const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
 	size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = (_sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0);
+	bytes data(_size, 0);
+	if (_sourceOffset < _source.size())
+		std::copy_n(
+			_source.begin() + static_cast<ptrdiff_t>(_sourceOffset),
+			std::min(_size, _source.size() - _sourceOffset),
+			data.begin()
+		);
+	_target.write(_targetOffset, bytesConstRef(&data));
 }
 
 void copyZeroExtendedWithOverlap(
-	std::map<u256, uint8_t>& _target,
-	std::map<u256, uint8_t> const& _source,
+	PagedMemory& _target,
+	PagedMemory const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
 	size_t _size
 )
 {
-	if (_targetOffset >= _sourceOffset)
-		for (size_t i = _size; i > 0; --i)
-			_target[_targetOffset + i - 1] = (_source.count(_sourceOffset + i - 1) != 0 ? _source.at(_sourceOffset + i - 1) : 0);
-	else
-		for (size_t i = 0; i < _size; ++i)
-			_target[_targetOffset + i] = (_source.count(_sourceOffset + i) != 0 ? _source.at(_sourceOffset + i) : 0);
+	// Reading everything before writing anything takes care of overlapping areas.
+	bytes data = _source.read(_sourceOffset, _size);
+	_target.write(_targetOffset, bytesConstRef(&data));
 }
 
 }
 
-using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
-
 u256 EVMInstructionInterpreter::eval(
 	evmasm::Instruction _instruction,
 	std::vector<u256> const& _arguments
@@ -135,13 +146,13 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::DIV:
 		return arg[1] == 0 ? 0 : arg[0] / arg[1];
 	case Instruction::SDIV:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) / u2s(arg[1]));
+		return arg[1] == 0 ? 0 : FixedU256::signedDiv(FixedU256(arg[0]), FixedU256(arg[1])).toU256();
 	case Instruction::MOD:
 		return arg[1] == 0 ? 0 : arg[0] % arg[1];
 	case Instruction::SMOD:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) % u2s(arg[1]));
+		return arg[1] == 0 ? 0 : FixedU256::signedMod(FixedU256(arg[0]), FixedU256(arg[1])).toU256();
 	case Instruction::EXP:
-		return exp256(arg[0], arg[1]);
+		return FixedU256::exp(FixedU256(arg[0]), FixedU256(arg[1])).toU256();
 	case Instruction::NOT:
 		return ~arg[0];
 	case Instruction::LT:
@@ -183,9 +194,9 @@ u256 EVMInstructionInterpreter::eval(
 		}
 	}
 	case Instruction::ADDMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) + u512(arg[1])) % arg[2]);
+		return arg[2] == 0 ? 0 : FixedU256::addMod(FixedU256(arg[0]), FixedU256(arg[1]), FixedU256(arg[2])).toU256();
 	case Instruction::MULMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) * u512(arg[1])) % arg[2]);
+		return arg[2] == 0 ? 0 : FixedU256::mulMod(FixedU256(arg[0]), FixedU256(arg[1]), FixedU256(arg[2])).toU256();
 	case Instruction::SIGNEXTEND:
 		if (arg[0] >= 31)
 			return arg[1];
@@ -315,12 +326,12 @@ u256 EVMInstructionInterpreter::eval(
 		return 0;
 	case Instruction::MSTORE8:
 		accessMemory(arg[0], 1);
-		m_state.memory[arg[0]] = uint8_t(arg[1] & 0xff);
+		m_state.memory.set(arg[0], uint8_t(arg[1] & 0xff));
 		return 0;
 	case Instruction::SLOAD:
-		return m_state.storage[h256(arg[0])];
+		return storageValue(*m_state.storage, h256(arg[0]));
 	case Instruction::SSTORE:
-		m_state.storage[h256(arg[0])] = h256(arg[1]);
+		m_state.storage.write()[h256(arg[0])] = h256(arg[1]);
 		return 0;
 	case Instruction::PC:
 		return 0x77;
@@ -349,9 +360,9 @@ u256 EVMInstructionInterpreter::eval(
 		logTrace(_instruction, arg);
 		return 0;
 	case Instruction::TLOAD:
-		return m_state.transientStorage[h256(arg[0])];
+		return storageValue(*m_state.transientStorage, h256(arg[0]));
 	case Instruction::TSTORE:
-		m_state.transientStorage[h256(arg[0])] = h256(arg[1]);
+		m_state.transientStorage.write()[h256(arg[0])] = h256(arg[1]);
 		return 0;
 	// --------------- calls ---------------
 	case Instruction::CREATE:
@@ -401,19 +412,19 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::REVERT:
 		accessMemory(arg[0], arg[1]);
 		logTrace(_instruction, arg);
-		m_state.storage.clear();
-		m_state.transientStorage.clear();
+		m_state.storage = {};
+		m_state.transientStorage = {};
 		BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
 	case Instruction::INVALID:
 		logTrace(_instruction);
-		m_state.storage.clear();
-		m_state.transientStorage.clear();
+		m_state.storage = {};
+		m_state.transientStorage = {};
 		m_state.trace.clear();
 		BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
 	case Instruction::SELFDESTRUCT:
 		logTrace(_instruction, arg);
-		m_state.storage.clear();
-		m_state.transientStorage.clear();
+		m_state.storage = {};
+		m_state.transientStorage = {};
 		m_state.trace.clear();
 		BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
 	case Instruction::POP:
@@ -567,10 +578,7 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= s_maxRangeSize, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
@@ -580,8 +588,8 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	h256 const word(_value);
+	m_state.memory.write(_offset, word.ref());
 }
 
 
@@ -45,14 +45,14 @@ using solidity::util::h256;
 
 void InterpreterState::dumpStorage(std::ostream& _out) const
 {
-	for (auto const& [slot, value]: storage)
+	for (auto const& [slot, value]: *storage)
 		if (value != h256{})
 			_out << "  " << slot.hex() << ": " << value.hex() << std::endl;
 }
 
 void InterpreterState::dumpTransientStorage(std::ostream& _out) const
 {
-	for (auto const& [slot, value]: transientStorage)
+	for (auto const& [slot, value]: *transientStorage)
 		if (value != h256{})
 			_out << "  " << slot.hex() << ": " << value.hex() << std::endl;
 }
@@ -65,12 +65,16 @@ void InterpreterState::dumpTraceAndState(std::ostream& _out, bool _disableMemory
 	if (!_disableMemoryTrace)
 	{
 		_out << "Memory dump:\n";
-		std::map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-		for (auto const& [offset, value]: words)
-			if (value != 0)
-				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << std::endl;
+		for (auto const& [index, page]: memory.pages())
+			for (size_t offsetInPage = 0; offsetInPage < PagedMemory::PageSize; offsetInPage += 0x20)
+			{
+				h256 const word(bytesConstRef(page->data() + offsetInPage, 0x20));
+				if (word != h256{})
+				{
+					u256 const offset = index * PagedMemory::PageSize + offsetInPage;
+					_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << word.hex() << std::endl;
+				}
+			}
 	}
 	_out << "Storage dump:" << std::endl;
 	dumpStorage(_out);
@@ -131,9 +135,9 @@ void Interpreter::operator()(Assignment const& _assignment)
 	solAssert(values.size() == _assignment.variableNames.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
 	{
-		YulName varName = _assignment.variableNames.at(i).name;
-		solAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
+		auto variable = m_variables.find(_assignment.variableNames.at(i).name);
+		solAssert(variable != m_variables.end(), "");
+		variable->second = values.at(i);
 	}
 }
 
@@ -147,8 +151,8 @@ void Interpreter::operator()(VariableDeclaration const& _declaration)
 	for (size_t i = 0; i < values.size(); ++i)
 	{
 		YulName varName = _declaration.variables.at(i).name;
-		solAssert(!m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
+		bool inserted = m_variables.emplace(varName, values.at(i)).second;
+		solAssert(inserted, "");
 		m_scope->names.emplace(varName, nullptr);
 	}
 }
@@ -265,13 +269,14 @@ std::vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
 
 void Interpreter::enterScope(Block const& _block)
 {
-	if (!m_scope->subScopes.count(&_block))
-		m_scope->subScopes[&_block] = std::make_unique<Scope>(Scope{
+	std::unique_ptr<Scope>& subScope = m_scope->subScopes[&_block];
+	if (!subScope)
+		subScope = std::make_unique<Scope>(Scope{
 			{},
 			{},
 			m_scope
 		});
-	m_scope = m_scope->subScopes[&_block].get();
+	m_scope = subScope.get();
 }
 
 void Interpreter::leaveScope()
@@ -301,53 +306,53 @@ void ExpressionEvaluator::operator()(Literal const& _literal)
 
 void ExpressionEvaluator::operator()(Identifier const& _identifier)
 {
-	solAssert(m_variables.count(_identifier.name), "");
+	auto variable = m_variables.find(_identifier.name);
+	solAssert(variable != m_variables.end(), "");
 	incrementStep();
-	setValue(m_variables.at(_identifier.name));
+	setValue(variable->second);
 }
 
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 {
+	// Look the builtin up only once, it is needed both for the arguments and for the evaluation.
+	BuiltinFunctionForEVM const* evmBuiltin = m_evmDialect ? m_evmDialect->builtin(_funCall.functionName.name) : nullptr;
+	BuiltinFunction const* builtin = m_evmDialect ? evmBuiltin : m_dialect.builtin(_funCall.functionName.name);
 	std::vector<std::optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
+	if (builtin && !builtin->literalArguments.empty())
+		literalArguments = &builtin->literalArguments;
 	evaluateArgs(_funCall.arguments, literalArguments);
 
-	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+	if (evmBuiltin)
 	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
-		{
-			EVMInstructionInterpreter interpreter(dialect->evmVersion(), m_state, m_disableMemoryTrace);
+		EVMInstructionInterpreter interpreter(m_evmDialect->evmVersion(), m_state, m_disableMemoryTrace);
 
-			u256 const value = interpreter.evalBuiltin(*fun, _funCall.arguments, values());
+		u256 const value = interpreter.evalBuiltin(*evmBuiltin, _funCall.arguments, values());
 
-			if (
-				!m_disableExternalCalls &&
-				fun->instruction &&
-				evmasm::isCallInstruction(*fun->instruction)
-			)
-				runExternalCall(*fun->instruction);
+		if (
+			!m_disableExternalCalls &&
+			evmBuiltin->instruction &&
+			evmasm::isCallInstruction(*evmBuiltin->instruction)
+		)
+			runExternalCall(*evmBuiltin->instruction);
 
-			setValue(value);
-			return;
-		}
+		setValue(value);
+		return;
 	}
 
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
+	FunctionDefinition const* fun = nullptr;
+	for (Scope* scope = &m_scope; scope; scope = scope->parent)
+		if (auto name = scope->names.find(_funCall.functionName.name); name != scope->names.end())
+		{
+			fun = name->second;
 			break;
-	yulAssert(scope, "");
-
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
+		}
 	yulAssert(fun, "Function not found.");
 	yulAssert(m_values.size() == fun->parameters.size(), "");
 	std::map<YulName, u256> variables;
 	for (size_t i = 0; i < fun->parameters.size(); ++i)
-		variables[fun->parameters.at(i).name] = m_values.at(i);
+		variables.emplace_hint(variables.end(), fun->parameters.at(i).name, std::move(m_values.at(i)));
 	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
-		variables[fun->returnVariables.at(i).name] = 0;
+		variables.emplace(fun->returnVariables.at(i).name, 0);
 
 	m_state.controlFlowState = ControlFlowState::Default;
 	std::unique_ptr<Interpreter> interpreter = makeInterpreterCopy(std::move(variables));
@@ -378,6 +383,7 @@ void ExpressionEvaluator::evaluateArgs(
 {
 	incrementStep();
 	std::vector<u256> values;
+	values.reserve(_expr.size());
 	size_t i = 0;
 	/// Function arguments are evaluated in reverse.
 	for (auto const& expr: _expr | ranges::views::reverse)
@@ -395,7 +401,8 @@ void ExpressionEvaluator::evaluateArgs(
 				m_values = {std::get<Literal>(expr).value.value()};
 		}
 
-		values.push_back(value());
+		solAssert(m_values.size() == 1, "");
+		values.push_back(std::move(m_values.front()));
 		++i;
 	}
 	m_values = std::move(values);
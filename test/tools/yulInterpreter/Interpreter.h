@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/CopyOnWrite.h>
+
 #include <libyul/ASTForward.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/optimiser/ASTWalker.h>
 
 #include <libevmasm/Instruction.h>
@@ -77,11 +80,12 @@ struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	PagedMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
-	std::map<util::h256, util::h256> transientStorage;
+	/// Storage and transient storage are copied on the first write after the state was copied.
+	CopyOnWrite<std::map<util::h256, util::h256>> storage;
+	CopyOnWrite<std::map<util::h256, util::h256>> transientStorage;
 	util::h160 address = util::h160("0x0000000000000000000000000000000011111111");
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;
@@ -132,10 +136,7 @@ struct InterpreterState
 	bytes readMemory(u256 const& _offset, u256 const& _size)
 	{
 		yulAssert(_size <= 0xffff, "Too large read.");
-		bytes data(size_t(_size), uint8_t(0));
-		for (size_t i = 0; i < data.size(); ++i)
-			data[i] = memory[_offset + i];
-		return data;
+		return memory.read(_offset, size_t(_size));
 	}
 };
 
@@ -242,6 +243,7 @@ public:
 	):
 		m_state(_state),
 		m_dialect(_dialect),
+		m_evmDialect(dynamic_cast<EVMDialect const*>(&_dialect)),
 		m_variables(_variables),
 		m_scope(_scope),
 		m_disableExternalCalls(_disableExternalCalls),
@@ -297,6 +299,8 @@ protected:
 
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
+	/// @a m_dialect if it is an EVM dialect, nullptr otherwise.
+	EVMDialect const* m_evmDialect;
 	/// Values of variables.
 	std::map<YulName, u256> const& m_variables;
 	Scope& m_scope;
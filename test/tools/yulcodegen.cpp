@@ -0,0 +1,328 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of the optimized EVM code generation of libyul.
+ * Measures time and heap allocations of control flow graph construction, stack layout generation,
+ * code transform and assembly separately for each object of the given Yul sources.
+ */
+
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
+#include <libyul/YulStack.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EthAssemblyAdapter.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+#include <libyul/optimiser/ASTCopier.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/program_options.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+std::atomic<size_t> allocationCount{0};
+}
+
+void* operator new(std::size_t _size)
+{
+	++allocationCount;
+	if (void* memory = std::malloc(_size ? _size : 1))
+		return memory;
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* _memory) noexcept
+{
+	std::free(_memory);
+}
+
+void operator delete(void* _memory, std::size_t) noexcept
+{
+	std::free(_memory);
+}
+
+namespace
+{
+
+/// Accumulated time and allocations of a code generation phase.
+struct PhaseStatistics
+{
+	std::chrono::nanoseconds time{0};
+	size_t allocations = 0;
+};
+
+/// Measures the time and number of allocations of running @a _function and adds them to @a _statistics.
+template<typename Function>
+decltype(auto) measure(PhaseStatistics& _statistics, Function&& _function)
+{
+	size_t const allocationsBefore = allocationCount;
+	auto const start = std::chrono::steady_clock::now();
+	struct Finally
+	{
+		PhaseStatistics& statistics;
+		size_t allocationsBefore;
+		std::chrono::steady_clock::time_point start;
+		~Finally()
+		{
+			statistics.time += std::chrono::steady_clock::now() - start;
+			statistics.allocations += allocationCount - allocationsBefore;
+		}
+	} finally{_statistics, allocationsBefore, start};
+	return _function();
+}
+
+/// Registers the sub objects and data of @a _object with @a _assembly the same way the EVMObjectCompiler does,
+/// but without generating code for the sub objects.
+void registerSubObjects(Object const& _object, AbstractAssembly& _assembly, BuiltinContext& _context)
+{
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+		{
+			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
+			_context.subIDs[subObject->name] = _assembly.createSubAssembly(isCreation, subObject->name).second;
+		}
+		else
+		{
+			Data const& data = dynamic_cast<Data const&>(*subNode);
+			if (data.name == Object::metadataName())
+				_assembly.appendToAuxiliaryData(data.data);
+			else
+				_context.subIDs[data.name] = _assembly.appendData(data.data);
+		}
+}
+
+/// @returns a block containing @a _scale copies of the code of @a _object, each in its own nested block.
+Block scaledCode(Object const& _object, size_t _scale)
+{
+	Block const& code = _object.code()->root();
+	Block result{code.debugData, {}};
+	for (size_t i = 0; i < _scale; ++i)
+		result.statements.emplace_back(std::get<Block>(ASTCopier{}(code)));
+	return result;
+}
+
+void benchmarkObject(
+	std::string const& _path,
+	Object const& _object,
+	EVMDialect const& _dialect,
+	std::vector<size_t> const& _scales,
+	size_t _repetitions
+)
+{
+	if (_object.hasCode())
+		for (size_t scale: _scales)
+		{
+			Block const code = scaledCode(_object, scale);
+			AsmAnalysisInfo analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(
+				_dialect,
+				code,
+				_object.qualifiedDataNames()
+			);
+
+			PhaseStatistics cfgStatistics;
+			PhaseStatistics stackLayoutStatistics;
+			PhaseStatistics codeTransformStatistics;
+			PhaseStatistics assemblyStatistics;
+			size_t bytecodeSize = 0;
+			for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+			{
+				std::unique_ptr<CFG> cfg = measure(cfgStatistics, [&]() {
+					return ControlFlowGraphBuilder::build(analysisInfo, _dialect, code);
+				});
+				StackLayout stackLayout = measure(stackLayoutStatistics, [&]() {
+					return StackLayoutGenerator::run(*cfg);
+				});
+
+				evmasm::Assembly assembly{_dialect.evmVersion(), true, std::nullopt, {}};
+				EthAssemblyAdapter adapter(assembly);
+				BuiltinContext context;
+				context.currentObject = &_object;
+				registerSubObjects(_object, adapter, context);
+				auto const stackErrors = measure(codeTransformStatistics, [&]() {
+					return OptimizedEVMCodeTransform::run(
+						adapter,
+						*cfg,
+						stackLayout,
+						context,
+						OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+					);
+				});
+				if (!stackErrors.empty())
+				{
+					std::cerr << _path << ": " << _object.name << ": stack too deep, skipping." << std::endl;
+					return;
+				}
+				bytecodeSize = measure(assemblyStatistics, [&]() {
+					return assembly.assemble().bytecode.size();
+				});
+			}
+
+			auto printPhase = [&](std::string const& _phase, PhaseStatistics const& _statistics) {
+				std::cout <<
+					_path << "\t" <<
+					_object.name << "\t" <<
+					scale << "\t" <<
+					_phase << "\t" <<
+					std::fixed << std::setprecision(1) <<
+					static_cast<double>(_statistics.time.count()) / 1000.0 / static_cast<double>(_repetitions) << "\t" <<
+					_statistics.allocations / _repetitions << "\t" <<
+					bytecodeSize << std::endl;
+			};
+			printPhase("cfg", cfgStatistics);
+			printPhase("stacklayout", stackLayoutStatistics);
+			printPhase("codetransform", codeTransformStatistics);
+			printPhase("assemble", assemblyStatistics);
+		}
+
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			benchmarkObject(_path, *subObject, _dialect, _scales, _repetitions);
+}
+
+bool benchmarkFile(
+	std::string const& _path,
+	bool _optimize,
+	std::vector<size_t> const& _scales,
+	size_t _repetitions
+)
+{
+	EVMVersion const evmVersion{};
+	YulStack stack(
+		evmVersion,
+		std::nullopt,
+		YulStack::Language::StrictAssembly,
+		_optimize ? frontend::OptimiserSettings::full() : frontend::OptimiserSettings::none(),
+		DebugInfoSelection::Default()
+	);
+	if (!stack.parseAndAnalyze(_path, readFileAsString(_path)))
+	{
+		SourceReferenceFormatter(std::cerr, stack, true, false).printErrorInformation(stack.errors());
+		return false;
+	}
+	if (_optimize)
+		stack.optimize();
+
+	benchmarkObject(
+		_path,
+		*stack.parserResult(),
+		EVMDialect::strictAssemblyForEVMObjects(evmVersion, std::nullopt),
+		_scales,
+		_repetitions
+	);
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulcodegen, a benchmark of the optimized EVM code generation of libyul.
+Usage: yulcodegen [Options] <file>...
+Optimizes each Yul object of the given files and measures control flow graph construction,
+stack layout generation, code transform and assembly separately. The code of each object is
+replicated for each of the given scales to measure the effect of the input size.
+Prints one tab-separated line per file, object, scale and phase with the average time in
+microseconds, the average number of heap allocations and the size of the resulting bytecode.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("no-optimize", "Do not optimize the input before benchmarking code generation.")
+		("repeat", po::value<size_t>()->default_value(5), "Number of repetitions of each measurement.")
+		("scale", po::value<std::vector<size_t>>()->multitoken(), "Number of copies of the code of each object (default: 1 2 4 8).")
+		("input-file", po::value<std::vector<std::string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		std::cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	std::vector<size_t> scales{1, 2, 4, 8};
+	if (arguments.count("scale"))
+		scales = arguments["scale"].as<std::vector<size_t>>();
+	size_t const repetitions = std::max<size_t>(arguments["repeat"].as<size_t>(), 1);
+
+	std::cout << "file\tobject\tscale\tphase\ttime_us\tallocations\tbytecode_size" << std::endl;
+	for (std::string const& path: arguments["input-file"].as<std::vector<std::string>>())
+	{
+		try
+		{
+			if (!benchmarkFile(path, !arguments.count("no-optimize"), scales, repetitions))
+				return 1;
+		}
+		catch (FileNotFound const&)
+		{
+			std::cerr << "File not found: " << path << std::endl;
+			return 1;
+		}
+		catch (NotAFile const&)
+		{
+			std::cerr << "Not a regular file: " << path << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -170,17 +170,23 @@ public:
 
 	void disambiguate()
 	{
-		*m_astRoot = std::get<yul::Block>(Disambiguator(m_dialect, *m_analysisInfo)(*m_astRoot));
+		Disambiguator(m_dialect, *m_analysisInfo).disambiguateInPlace(*m_astRoot);
 		m_analysisInfo.reset();
 		m_nameDispenser.reset(*m_astRoot);
 	}
 
-	void runSteps(std::string _source, std::string _steps)
+	void runSteps(std::string _source, std::string _steps, bool _printStatistics)
 	{
 		parse(_source);
 		disambiguate();
-		OptimiserSuite{m_context}.runSequence(_steps, *m_astRoot);
+		OptimiserSuite suite{
+			m_context,
+			_printStatistics ? OptimiserSuite::Debug::Statistics : OptimiserSuite::Debug::None
+		};
+		suite.runSequence(_steps, *m_astRoot);
 		std::cout << AsmPrinter{}(*m_astRoot) << std::endl;
+		if (_printStatistics)
+			suite.printStatistics(std::cout);
 	}
 
 	void runInteractive(std::string _source, bool _disambiguated = false)
@@ -259,6 +265,7 @@ int main(int argc, char** argv)
 	try
 	{
 		bool nonInteractive = false;
+		bool printStatistics = false;
 		po::options_description options(
 			R"(yulopti, yul optimizer exploration tool.
 	Usage: yulopti [Options] <file>
@@ -286,6 +293,11 @@ int main(int argc, char** argv)
 				po::bool_switch(&nonInteractive)->default_value(false),
 				"stop after executing the provided steps"
 			)
+			(
+				"statistics",
+				po::bool_switch(&printStatistics)->default_value(false),
+				"print the time spent in, and the effect of each of the provided steps"
+			)
 			("help,h", "Show this help screen.");
 
 		// All positional options should be interpreted as input files
@@ -337,7 +349,7 @@ int main(int argc, char** argv)
 			std::string sequence = arguments["steps"].as<std::string>();
 			if (!nonInteractive)
 				std::cout << "----------------------" << std::endl;
-			yulOpti.runSteps(input, sequence);
+			yulOpti.runSteps(input, sequence, printStatistics);
 			disambiguated = true;
 		}
 		if (!nonInteractive)
@@ -0,0 +1,311 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of the individual Yul optimiser steps.
+ * Measures time and heap allocations of each step run in isolation on each object of the given Yul sources.
+ */
+
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
+#include <libyul/YulStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+std::atomic<size_t> allocationCount{0};
+}
+
+void* operator new(std::size_t _size)
+{
+	++allocationCount;
+	if (void* memory = std::malloc(_size ? _size : 1))
+		return memory;
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* _memory) noexcept
+{
+	std::free(_memory);
+}
+
+void operator delete(void* _memory, std::size_t) noexcept
+{
+	std::free(_memory);
+}
+
+namespace
+{
+
+/// @returns a block containing @a _scale copies of the code of @a _object, each in its own nested block.
+Block scaledCode(Object const& _object, size_t _scale)
+{
+	Block const& code = _object.code()->root();
+	Block result{code.debugData, {}};
+	for (size_t i = 0; i < _scale; ++i)
+		result.statements.emplace_back(std::get<Block>(ASTCopier{}(code)));
+	return result;
+}
+
+/// @returns the disambiguated @a _code in the form the optimiser suite establishes before running
+/// a user-supplied sequence, so that every step can be run on it.
+Block prepareCode(Object const& _object, Block const& _code, Dialect const& _dialect, std::set<YulName> const& _reservedIdentifiers)
+{
+	AsmAnalysisInfo analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(
+		_dialect,
+		_code,
+		_object.qualifiedDataNames()
+	);
+	Block prepared = std::get<Block>(Disambiguator(_dialect, analysisInfo, _reservedIdentifiers)(_code));
+
+	NameDispenser dispenser{_dialect, prepared, _reservedIdentifiers};
+	OptimiserStepContext context{
+		_dialect,
+		dispenser,
+		_reservedIdentifiers,
+		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+	};
+	OptimiserSuite{context}.runSequence("hgfol", prepared);
+	return prepared;
+}
+
+void benchmarkObject(
+	std::string const& _path,
+	Object const& _object,
+	Dialect const& _dialect,
+	std::vector<OptimiserStep const*> const& _steps,
+	std::vector<size_t> const& _scales,
+	size_t _repetitions
+)
+{
+	std::set<YulName> const reservedIdentifiers = _dialect.fixedFunctionNames();
+	if (_object.hasCode())
+		for (size_t scale: _scales)
+		{
+			Block const code = prepareCode(_object, scaledCode(_object, scale), _dialect, reservedIdentifiers);
+			size_t const codeSize = CodeSize::codeSizeIncludingFunctions(code);
+
+			for (OptimiserStep const* step: _steps)
+			{
+				std::chrono::nanoseconds time{0};
+				size_t allocations = 0;
+				for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+				{
+					Block input = std::get<Block>(ASTCopier{}(code));
+					NameDispenser dispenser{_dialect, input, reservedIdentifiers};
+					OptimiserStepContext context{
+						_dialect,
+						dispenser,
+						reservedIdentifiers,
+						frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+					};
+
+					size_t const allocationsBefore = allocationCount;
+					auto const start = std::chrono::steady_clock::now();
+					step->run(context, input);
+					time += std::chrono::steady_clock::now() - start;
+					allocations += allocationCount - allocationsBefore;
+				}
+
+				std::cout <<
+					_path << "\t" <<
+					_object.name << "\t" <<
+					scale << "\t" <<
+					codeSize << "\t" <<
+					step->name << "\t" <<
+					std::fixed << std::setprecision(1) <<
+					static_cast<double>(time.count()) / 1000.0 / static_cast<double>(_repetitions) << "\t" <<
+					allocations / _repetitions << std::endl;
+			}
+		}
+
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			benchmarkObject(_path, *subObject, _dialect, _steps, _scales, _repetitions);
+}
+
+bool benchmarkFile(
+	std::string const& _path,
+	bool _optimize,
+	std::vector<OptimiserStep const*> const& _steps,
+	std::vector<size_t> const& _scales,
+	size_t _repetitions
+)
+{
+	EVMVersion const evmVersion{};
+	YulStack stack(
+		evmVersion,
+		std::nullopt,
+		YulStack::Language::StrictAssembly,
+		_optimize ? frontend::OptimiserSettings::full() : frontend::OptimiserSettings::none(),
+		DebugInfoSelection::Default()
+	);
+	if (!stack.parseAndAnalyze(_path, readFileAsString(_path)))
+	{
+		SourceReferenceFormatter(std::cerr, stack, true, false).printErrorInformation(stack.errors());
+		return false;
+	}
+	if (_optimize)
+		stack.optimize();
+
+	benchmarkObject(
+		_path,
+		*stack.parserResult(),
+		EVMDialect::strictAssemblyForEVMObjects(evmVersion, std::nullopt),
+		_steps,
+		_scales,
+		_repetitions
+	);
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulsteps, a benchmark of the individual Yul optimiser steps.
+Usage: yulsteps [Options] <file>...
+Runs each of the selected optimiser steps in isolation on each Yul object of the given files,
+e.g. the output of solc --ir or --ir-optimized. Before that, the code is disambiguated and
+brought into the form the optimiser suite establishes before running a sequence. The code of
+each object is replicated for each of the given scales to measure the effect of the input size.
+Prints one tab-separated line per file, object, scale and step with the code size of the input,
+the average time in microseconds and the average number of heap allocations of the step.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("optimize", "Optimize the input with the default sequence before benchmarking the steps.")
+		("steps", po::value<std::string>(), "Abbreviations of the steps to benchmark (default: all steps).")
+		("repeat", po::value<size_t>()->default_value(5), "Number of repetitions of each measurement.")
+		("scale", po::value<std::vector<size_t>>()->multitoken(), "Number of copies of the code of each object (default: 1 2 4 8).")
+		("input-file", po::value<std::vector<std::string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		std::cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	std::vector<OptimiserStep const*> steps;
+	if (arguments.count("steps"))
+		for (char abbreviation: arguments["steps"].as<std::string>())
+		{
+			auto const& stepNames = OptimiserSuite::stepAbbreviationToNameMap();
+			if (!stepNames.count(abbreviation))
+			{
+				std::cerr << "Unknown optimiser step abbreviation: " << abbreviation << std::endl;
+				return 1;
+			}
+			steps.push_back(OptimiserSuite::allSteps().at(stepNames.at(abbreviation)).get());
+		}
+	else
+		for (auto const& [name, step]: OptimiserSuite::allSteps())
+			steps.push_back(step.get());
+
+	for (OptimiserStep const*& step: steps)
+		if (std::optional<std::string> reason = step->invalidInCurrentEnvironment())
+		{
+			std::cerr << "Skipping " << step->name << ": " << *reason << std::endl;
+			step = nullptr;
+		}
+	steps.erase(std::remove(steps.begin(), steps.end(), nullptr), steps.end());
+
+	std::vector<size_t> scales{1, 2, 4, 8};
+	if (arguments.count("scale"))
+		scales = arguments["scale"].as<std::vector<size_t>>();
+	size_t const repetitions = std::max<size_t>(arguments["repeat"].as<size_t>(), 1);
+
+	std::cout << "file\tobject\tscale\tcode_size\tstep\ttime_us\tallocations" << std::endl;
+	for (std::string const& path: arguments["input-file"].as<std::vector<std::string>>())
+	{
+		try
+		{
+			if (!benchmarkFile(path, arguments.count("optimize"), steps, scales, repetitions))
+				return 1;
+		}
+		catch (FileNotFound const&)
+		{
+			std::cerr << "File not found: " << path << std::endl;
+			return 1;
+		}
+		catch (NotAFile const&)
+		{
+			std::cerr << "Not a regular file: " << path << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -237,6 +237,34 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_multiply_the_result_by_scaling_factor, P
 	BOOST_TEST(RelativeProgramSize(m_program, nullptr, 4, m_weights).evaluate(m_chromosome) == round(10000.0 * sizeRatio));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(GasCostTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_prefer_programs_with_lower_gas_costs, ProgramBasedMetricFixture)
+{
+	GasCost metric(m_program, nullptr, 200);
+
+	size_t unoptimisedCost = metric.evaluate(Chromosome(""));
+	size_t optimisedCost = metric.evaluate(m_chromosome);
+
+	BOOST_TEST(unoptimisedCost > 0);
+	BOOST_TEST(optimisedCost < unoptimisedCost);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_weigh_execution_costs_by_expected_executions, ProgramBasedMetricFixture)
+{
+	BOOST_TEST(GasCost(m_program, nullptr, 1).evaluate(m_chromosome) < GasCost(m_program, nullptr, 1000).evaluate(m_chromosome));
+	BOOST_TEST(GasCost(m_program, nullptr, 1000).expectedExecutionsPerDeployment() == 1000);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_be_able_to_use_program_cache_if_available, ProgramBasedMetricFixture)
+{
+	size_t expectedCost = GasCost(m_program, nullptr, 200).evaluate(m_chromosome);
+
+	BOOST_TEST(GasCost(std::nullopt, m_programCache, 200).evaluate(m_chromosome) == expectedCost);
+	BOOST_TEST(m_programCache->size() == m_chromosome.length());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(FitnessMetricCombinationTest)
 
@@ -276,6 +304,42 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricMinimum_evaluate_should_compute_minimum_of_
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(EvaluateAllTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_values_in_order_of_chromosomes, ProgramBasedMetricFixture)
+{
+	std::vector<Chromosome> chromosomes = {m_chromosome, Chromosome("a"), Chromosome(""), Chromosome("fcu"), m_chromosome};
+	ProgramSize metric(m_program, nullptr, m_weights);
+
+	std::vector<size_t> expectedValues;
+	for (Chromosome const& chromosome: chromosomes)
+		expectedValues.push_back(metric.evaluate(chromosome));
+
+	BOOST_TEST(metric.threadPool() == nullptr);
+	BOOST_TEST(metric.evaluateAll(chromosomes) == expectedValues);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_give_the_same_results_when_evaluating_in_parallel, ProgramBasedMetricFixture)
+{
+	std::vector<Chromosome> chromosomes;
+	for (size_t i = 0; i < 20; ++i)
+		chromosomes.push_back(Chromosome::makeRandom(i));
+
+	FitnessMetricAverage sequentialMetric({
+		std::make_shared<ProgramSize>(m_program, nullptr, m_weights),
+		std::make_shared<RelativeProgramSize>(m_program, nullptr, 3, m_weights),
+	});
+	FitnessMetricAverage parallelMetric({
+		std::make_shared<ProgramSize>(std::nullopt, m_programCache, m_weights),
+		std::make_shared<RelativeProgramSize>(std::nullopt, m_programCache, 3, m_weights),
+	});
+	parallelMetric.setThreadPool(std::make_shared<ThreadPool>(4));
+
+	BOOST_TEST(parallelMetric.evaluateAll(chromosomes) == sequentialMetric.evaluateAll(chromosomes));
+	BOOST_TEST(m_programCache->size() > 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
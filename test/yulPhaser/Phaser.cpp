@@ -88,6 +88,8 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* expectedExecutionsPerDeployment = */ 200,
+		/* threads = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -236,6 +238,19 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_set_thread_pool_only_if_more_than_one_thread_requested, FitnessMetricFactoryFixture)
+{
+	std::unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+	BOOST_TEST(metric->threadPool() == nullptr);
+
+	m_options.threads = 3;
+	metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+	BOOST_REQUIRE(metric->threadPool() != nullptr);
+	BOOST_TEST(metric->threadPool()->numThreads() == 3);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	std::unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
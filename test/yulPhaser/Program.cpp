@@ -25,6 +25,8 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 
+#include <libevmasm/Assembly.h>
+
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
 #include <liblangutil/CharStream.h>
@@ -403,6 +405,25 @@ BOOST_AUTO_TEST_CASE(codeSize)
 	BOOST_TEST(program.codeSize(CodeWeights{}) == CodeSize::codeSizeIncludingFunctions(program.ast()));
 }
 
+BOOST_AUTO_TEST_CASE(compile)
+{
+	std::string sourceCode(
+		"{\n"
+		"    function foo(x) -> result\n"
+		"    {\n"
+		"        result := add(x, sload(0))\n"
+		"    }\n"
+		"    sstore(1, foo(calldataload(0)))\n"
+		"}\n"
+	);
+	CharStream sourceStream(sourceCode, current_test_case().p_name);
+	Program program = get<Program>(Program::load(sourceStream));
+
+	std::unique_ptr<evmasm::Assembly> assembly = program.compile();
+	BOOST_REQUIRE(assembly != nullptr);
+	BOOST_TEST(!assembly->assemble().bytecode.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
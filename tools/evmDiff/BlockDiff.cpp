@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <tools/evmDiff/BlockDiff.h>
+
+#include <unordered_map>
+
+using namespace solidity;
+using namespace solidity::evmdiff;
+
+namespace
+{
+
+std::vector<DiffRegion> unmatchedRegions(std::vector<bool> const& _matched)
+{
+	std::vector<DiffRegion> regions;
+	for (size_t i = 0; i < _matched.size(); ++i)
+		if (!_matched[i])
+		{
+			if (!regions.empty() && regions.back().firstBlock + regions.back().blockCount == i)
+				++regions.back().blockCount;
+			else
+				regions.push_back({i, 1});
+		}
+	return regions;
+}
+
+}
+
+BlockDiff solidity::evmdiff::diffBlocks(ControlFlowGraph const& _before, ControlFlowGraph const& _after)
+{
+	// Occurrences of each hash in the second graph that are not matched yet, in reverse order.
+	std::unordered_map<size_t, std::vector<size_t>> unmatchedAfter;
+	for (size_t i = _after.blocks.size(); i > 0; --i)
+		unmatchedAfter[_after.blocks[i - 1].hash].push_back(i - 1);
+
+	BlockDiff diff;
+	std::vector<bool> matchedBefore(_before.blocks.size(), false);
+	std::vector<bool> matchedAfter(_after.blocks.size(), false);
+	for (size_t i = 0; i < _before.blocks.size(); ++i)
+	{
+		auto it = unmatchedAfter.find(_before.blocks[i].hash);
+		if (it == unmatchedAfter.end() || it->second.empty())
+			continue;
+		size_t counterpart = it->second.back();
+		it->second.pop_back();
+		diff.matched.emplace_back(i, counterpart);
+		matchedBefore[i] = true;
+		matchedAfter[counterpart] = true;
+	}
+
+	diff.removed = unmatchedRegions(matchedBefore);
+	diff.added = unmatchedRegions(matchedAfter);
+	return diff;
+}
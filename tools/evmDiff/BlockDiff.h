@@ -0,0 +1,56 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Comparison of two builds of the same bytecode by the hashes of their basic blocks.
+ */
+
+#pragma once
+
+#include <tools/evmDiff/ControlFlowGraph.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace solidity::evmdiff
+{
+
+/// Maximal run of consecutive blocks of one of the compared graphs that have no counterpart in the other one.
+struct DiffRegion
+{
+	size_t firstBlock = 0;
+	size_t blockCount = 0;
+};
+
+struct BlockDiff
+{
+	/// Pairs of indices of equal blocks in the first and the second graph.
+	std::vector<std::pair<size_t, size_t>> matched;
+	/// Runs of blocks only present in the first graph.
+	std::vector<DiffRegion> removed;
+	/// Runs of blocks only present in the second graph.
+	std::vector<DiffRegion> added;
+
+	bool identical() const { return removed.empty() && added.empty(); }
+};
+
+/// Matches the blocks of @a _before and @a _after by their hashes. Blocks with equal hashes are matched in the
+/// order in which they appear, so the diff takes time linear in the number of blocks.
+BlockDiff diffBlocks(ControlFlowGraph const& _before, ControlFlowGraph const& _after);
+
+}
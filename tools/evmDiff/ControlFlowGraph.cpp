@@ -0,0 +1,205 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <tools/evmDiff/ControlFlowGraph.h>
+#include <tools/evmDiff/Exceptions.h>
+
+#include <libevmasm/Instruction.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/container_hash/hash.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::evmdiff;
+
+namespace
+{
+
+/// Marker hashed instead of pushes of jump targets. Larger than any opcode.
+size_t constexpr jumpTargetMarker = 0x100;
+
+}
+
+OpcodeTable::OpcodeTable(langutil::EVMVersion _evmVersion)
+{
+	for (size_t opcode = 0; opcode < 256; ++opcode)
+	{
+		Instruction instruction = static_cast<Instruction>(opcode);
+		valid[opcode] = isValidInstruction(instruction) && _evmVersion.hasOpcode(instruction, std::nullopt);
+		if (valid[opcode])
+		{
+			InstructionInfo info = instructionInfo(instruction, _evmVersion);
+			immediateSize[opcode] = static_cast<uint8_t>(info.additional);
+			terminates[opcode] = SemanticInformation::terminatesControlFlow(instruction);
+			names[opcode] = info.name;
+		}
+		else
+		{
+			terminates[opcode] = true;
+			std::stringstream name;
+			name << "0x" << std::hex << std::uppercase << opcode;
+			names[opcode] = name.str();
+		}
+	}
+}
+
+std::optional<size_t> ControlFlowGraph::blockAt(size_t _offset) const
+{
+	auto it = std::lower_bound(blocks.begin(), blocks.end(), _offset, [](BasicBlock const& _block, size_t _offset) {
+		return _block.begin < _offset;
+	});
+	if (it == blocks.end() || it->begin != _offset)
+		return std::nullopt;
+	return static_cast<size_t>(it - blocks.begin());
+}
+
+std::string ControlFlowGraph::disassemble(size_t _block, OpcodeTable const& _opcodes) const
+{
+	BasicBlock const& block = blocks.at(_block);
+	std::stringstream out;
+	for (size_t pos = block.begin; pos < block.end;)
+	{
+		uint8_t opcode = bytecode[pos];
+		size_t immediateSize = std::min<size_t>(_opcodes.immediateSize[opcode], block.end - pos - 1);
+		out << "0x" << std::hex << pos << ": " << _opcodes.names[opcode];
+		if (immediateSize > 0)
+			out << " 0x" << util::toHex(bytes(bytecode.begin() + static_cast<ptrdiff_t>(pos + 1), bytecode.begin() + static_cast<ptrdiff_t>(pos + 1 + immediateSize)));
+		out << "\n";
+		pos += 1 + immediateSize;
+	}
+	return out.str();
+}
+
+ControlFlowGraph solidity::evmdiff::buildControlFlowGraph(bytes _bytecode, OpcodeTable const& _opcodes)
+{
+	ControlFlowGraph cfg;
+	cfg.bytecode = std::move(_bytecode);
+	bytes const& code = cfg.bytecode;
+	size_t const size = code.size();
+
+	// Immediates are skipped, so that data that happens to look like a JUMPDEST is not mistaken for one.
+	std::vector<bool> isJumpdest(size, false);
+	for (size_t pos = 0; pos < size; pos += 1u + _opcodes.immediateSize[code[pos]])
+		if (code[pos] == static_cast<uint8_t>(Instruction::JUMPDEST))
+			isJumpdest[pos] = true;
+
+	// Successors are collected as offsets first and translated to block indices once all blocks are known.
+	std::vector<std::vector<size_t>> successorOffsets;
+	std::optional<size_t> pushedJumpTarget;
+	for (size_t pos = 0; pos < size;)
+	{
+		if (cfg.blocks.empty() || cfg.blocks.back().end != 0)
+		{
+			cfg.blocks.emplace_back().begin = pos;
+			successorOffsets.emplace_back();
+		}
+		BasicBlock& block = cfg.blocks.back();
+
+		uint8_t opcode = code[pos];
+		size_t immediateSize = std::min<size_t>(_opcodes.immediateSize[opcode], size - pos - 1);
+		size_t next = pos + 1 + immediateSize;
+
+		std::optional<size_t> jumpTarget;
+		if (immediateSize > 0 && immediateSize <= sizeof(uint64_t))
+		{
+			uint64_t value = 0;
+			for (size_t i = 1; i <= immediateSize; ++i)
+				value = (value << 8) | code[pos + i];
+			if (value < size && isJumpdest[static_cast<size_t>(value)])
+				jumpTarget = static_cast<size_t>(value);
+		}
+		if (jumpTarget)
+			boost::hash_combine(block.hash, jumpTargetMarker);
+		else
+		{
+			boost::hash_combine(block.hash, size_t(opcode));
+			boost::hash_range(block.hash, code.begin() + static_cast<ptrdiff_t>(pos + 1), code.begin() + static_cast<ptrdiff_t>(next));
+		}
+		++block.instructionCount;
+
+		bool const isJump = opcode == static_cast<uint8_t>(Instruction::JUMP);
+		bool const isConditionalJump = opcode == static_cast<uint8_t>(Instruction::JUMPI);
+		if ((isJump || isConditionalJump) && pushedJumpTarget)
+			successorOffsets.back().push_back(*pushedJumpTarget);
+		pushedJumpTarget = jumpTarget;
+
+		bool const endsBlock = isJump || _opcodes.terminates[opcode] || next >= size;
+		if (endsBlock || isConditionalJump || isJumpdest[next])
+		{
+			if (!endsBlock)
+				successorOffsets.back().push_back(next);
+			block.end = next;
+			pushedJumpTarget.reset();
+		}
+		pos = next;
+	}
+
+	for (size_t i = 0; i < cfg.blocks.size(); ++i)
+		for (size_t offset: successorOffsets[i])
+			if (std::optional<size_t> successor = cfg.blockAt(offset))
+				cfg.blocks[i].successors.push_back(*successor);
+	return cfg;
+}
+
+bytes solidity::evmdiff::stripMetadata(bytes const& _bytecode)
+{
+	// The compiler appends a CBOR encoded map followed by its length as a two byte big endian integer.
+	size_t const size = _bytecode.size();
+	if (size < 2)
+		return _bytecode;
+	size_t metadataSize = (size_t(_bytecode[size - 2]) << 8) | _bytecode[size - 1];
+	if (metadataSize == 0 || metadataSize + 2 > size)
+		return _bytecode;
+	// Major type 5 (map).
+	if ((_bytecode[size - 2 - metadataSize] & 0xe0) != 0xa0)
+		return _bytecode;
+	return bytes(_bytecode.begin(), _bytecode.end() - static_cast<ptrdiff_t>(metadataSize + 2));
+}
+
+bytes solidity::evmdiff::bytecodeFromHex(std::string const& _hex)
+{
+	std::string hex = boost::algorithm::trim_copy(_hex);
+	if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X'))
+		hex = hex.substr(2);
+
+	// Library placeholders are of the form __$<34 hex characters>$__ and take the place of a 20 byte address.
+	size_t constexpr placeholderLength = 40;
+	for (size_t pos = hex.find("__"); pos != std::string::npos; pos = hex.find("__", pos))
+	{
+		if (pos + placeholderLength > hex.size())
+			BOOST_THROW_EXCEPTION(InvalidBytecode() << util::errinfo_comment("Truncated library placeholder."));
+		std::fill_n(hex.begin() + static_cast<ptrdiff_t>(pos), placeholderLength, '0');
+		pos += placeholderLength;
+	}
+
+	try
+	{
+		return util::fromHex(hex, util::WhenError::Throw);
+	}
+	catch (util::BadHexCharacter const&)
+	{
+		BOOST_THROW_EXCEPTION(InvalidBytecode() << util::errinfo_comment("Invalid hex character in bytecode."));
+	}
+}
@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Splitting of deployed EVM bytecode into basic blocks that can be compared across builds.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::evmdiff
+{
+
+/**
+ * Properties of all 256 opcodes for one EVM version, looked up once so that disassembly does not have to
+ * query the instruction table for every byte.
+ */
+struct OpcodeTable
+{
+	explicit OpcodeTable(langutil::EVMVersion _evmVersion);
+
+	/// Number of immediate bytes following each opcode.
+	std::array<uint8_t, 256> immediateSize{};
+	/// True for opcodes after which control never continues with the next instruction.
+	/// Undefined opcodes are treated like INVALID.
+	std::array<bool, 256> terminates{};
+	/// True for defined opcodes.
+	std::array<bool, 256> valid{};
+	std::array<std::string, 256> names;
+};
+
+/**
+ * Maximal sequence of instructions that is only entered at its first instruction and only left after its last one.
+ * Blocks start at the beginning of the code, at JUMPDESTs and after instructions that end a block.
+ */
+struct BasicBlock
+{
+	/// Offset of the first byte of the block in the bytecode.
+	size_t begin = 0;
+	/// Offset one past the last byte of the block.
+	size_t end = 0;
+	/// Number of instructions in the block.
+	size_t instructionCount = 0;
+	/// Hash of the instructions in the block. Pushes of offsets of JUMPDESTs are hashed as generic
+	/// jump targets, s.t. blocks that only moved or only refer to moved blocks compare equal.
+	size_t hash = 0;
+	/// Blocks control can flow to, as far as they can be determined from the block itself,
+	/// i.e. the next block and the targets of jumps directly preceded by a push of their target.
+	std::vector<size_t> successors;
+};
+
+/**
+ * Basic blocks of some legacy (non-EOF) bytecode ordered by their offsets.
+ * Data appended to the code, e.g. of sub-assemblies, is split into blocks as if it was code.
+ */
+struct ControlFlowGraph
+{
+	bytes bytecode;
+	std::vector<BasicBlock> blocks;
+
+	/// @returns the index of the block starting at @a _offset, if any.
+	std::optional<size_t> blockAt(size_t _offset) const;
+	/// @returns the disassembly of block @a _block, one instruction per line.
+	std::string disassemble(size_t _block, OpcodeTable const& _opcodes) const;
+};
+
+/// Splits @a _bytecode into basic blocks and determines their static successors.
+ControlFlowGraph buildControlFlowGraph(bytes _bytecode, OpcodeTable const& _opcodes);
+
+/// @returns @a _bytecode without the CBOR encoded metadata appended by the compiler, if present.
+bytes stripMetadata(bytes const& _bytecode);
+
+/// Decodes hex encoded bytecode as emitted by the compiler, optionally prefixed by "0x" and surrounded by whitespace.
+/// Placeholders of unlinked libraries are decoded as zero addresses.
+/// Throws InvalidBytecode if @a _hex is not valid.
+bytes bytecodeFromHex(std::string const& _hex);
+
+}
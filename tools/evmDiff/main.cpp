@@ -0,0 +1,250 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * evm-diff: Compares builds of deployed EVM bytecode by their basic blocks.
+ */
+
+#include <tools/evmDiff/BlockDiff.h>
+#include <tools/evmDiff/ControlFlowGraph.h>
+#include <tools/evmDiff/Exceptions.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <string>
+
+using namespace solidity;
+using namespace solidity::evmdiff;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Options
+{
+	bool keepMetadata = false;
+	bool showBlocks = false;
+};
+
+ControlFlowGraph load(fs::path const& _file, OpcodeTable const& _opcodes, Options const& _options)
+{
+	bytes bytecode = bytecodeFromHex(util::readFileAsString(_file));
+	if (!_options.keepMetadata)
+		bytecode = stripMetadata(bytecode);
+	return buildControlFlowGraph(std::move(bytecode), _opcodes);
+}
+
+size_t blockCount(std::vector<DiffRegion> const& _regions)
+{
+	size_t count = 0;
+	for (DiffRegion const& region: _regions)
+		count += region.blockCount;
+	return count;
+}
+
+void printRegions(
+	std::string const& _prefix,
+	std::vector<DiffRegion> const& _regions,
+	ControlFlowGraph const& _cfg,
+	OpcodeTable const& _opcodes
+)
+{
+	for (DiffRegion const& region: _regions)
+	{
+		BasicBlock const& first = _cfg.blocks[region.firstBlock];
+		BasicBlock const& last = _cfg.blocks[region.firstBlock + region.blockCount - 1];
+		std::cout << _prefix << " bytes 0x" << std::hex << first.begin << "-0x" << last.end << std::dec << ":" << std::endl;
+		for (size_t block = region.firstBlock; block < region.firstBlock + region.blockCount; ++block)
+			std::cout << _cfg.disassemble(block, _opcodes);
+	}
+}
+
+/// @returns true if the files are equal up to moved blocks.
+bool compareFiles(
+	std::string const& _name,
+	fs::path const& _before,
+	fs::path const& _after,
+	OpcodeTable const& _opcodes,
+	Options const& _options
+)
+{
+	ControlFlowGraph before = load(_before, _opcodes, _options);
+	ControlFlowGraph after = load(_after, _opcodes, _options);
+	BlockDiff diff = diffBlocks(before, after);
+	if (diff.identical())
+	{
+		std::cout << _name << ": identical (" << before.blocks.size() << " blocks)" << std::endl;
+		return true;
+	}
+	std::cout <<
+		_name << ": " <<
+		blockCount(diff.removed) << " of " << before.blocks.size() << " blocks removed in " <<
+		diff.removed.size() << " regions, " <<
+		blockCount(diff.added) << " of " << after.blocks.size() << " blocks added in " <<
+		diff.added.size() << " regions" <<
+		std::endl;
+	if (_options.showBlocks)
+	{
+		printRegions("-", diff.removed, before, _opcodes);
+		printRegions("+", diff.added, after, _opcodes);
+	}
+	return false;
+}
+
+/// Compares all files with the same relative path in both directories.
+/// @returns true if all files are present in both and equal up to moved blocks.
+bool compareDirectories(fs::path const& _before, fs::path const& _after, OpcodeTable const& _opcodes, Options const& _options)
+{
+	bool identical = true;
+	for (fs::directory_entry const& entry: fs::recursive_directory_iterator(_before))
+	{
+		if (!fs::is_regular_file(entry.path()))
+			continue;
+		fs::path relativePath = fs::relative(entry.path(), _before);
+		if (!fs::is_regular_file(_after / relativePath))
+		{
+			std::cout << relativePath.string() << ": only in " << _before.string() << std::endl;
+			identical = false;
+		}
+		else if (!compareFiles(relativePath.string(), entry.path(), _after / relativePath, _opcodes, _options))
+			identical = false;
+	}
+	for (fs::directory_entry const& entry: fs::recursive_directory_iterator(_after))
+		if (fs::is_regular_file(entry.path()))
+		{
+			fs::path relativePath = fs::relative(entry.path(), _after);
+			if (!fs::is_regular_file(_before / relativePath))
+			{
+				std::cout << relativePath.string() << ": only in " << _after.string() << std::endl;
+				identical = false;
+			}
+		}
+	return identical;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		po::options_description description(
+			"evm-diff, compares builds of deployed EVM bytecode.\n"
+			"\n"
+			"Usage: evm-diff [options] <before> <after>\n"
+			"       evm-diff [options] --disassemble <file>\n"
+			"\n"
+			"Both inputs are files containing hex encoded bytecode or directories, in which case all\n"
+			"files with the same relative path are compared. Bytecode is split into basic blocks that\n"
+			"are matched by their contents, ignoring the values of jump targets, so that blocks that\n"
+			"only moved are not reported. Exits with 0 if all inputs match, 1 if they differ and 2 on errors.\n"
+			"\n"
+			"Allowed options",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23
+		);
+		description.add_options()
+			("help", "Show help message and exit.")
+			("evm-version", po::value<std::string>()->value_name("version"), "EVM version the bytecode was compiled for.")
+			("keep-metadata", po::bool_switch(), "Do not strip the CBOR encoded metadata at the end of the bytecode.")
+			("show-blocks", po::bool_switch(), "Print the disassembly of all blocks that differ.")
+			("disassemble", po::bool_switch(), "Print the basic blocks of a single file instead of comparing files.")
+		;
+		po::options_description hidden;
+		hidden.add_options()("input", po::value<std::vector<std::string>>(), "Input files.");
+		po::options_description all;
+		all.add(description).add(hidden);
+		po::positional_options_description positional;
+		positional.add("input", -1);
+
+		po::variables_map arguments;
+		po::store(po::command_line_parser(argc, argv).options(all).positional(positional).run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help"))
+		{
+			std::cout << description << std::endl;
+			return 0;
+		}
+
+		langutil::EVMVersion evmVersion;
+		if (arguments.count("evm-version"))
+		{
+			std::optional<langutil::EVMVersion> version = langutil::EVMVersion::fromString(arguments["evm-version"].as<std::string>());
+			if (!version)
+				BOOST_THROW_EXCEPTION(BadInput() << util::errinfo_comment("Invalid EVM version."));
+			evmVersion = *version;
+		}
+		OpcodeTable const opcodes{evmVersion};
+		Options options{arguments["keep-metadata"].as<bool>(), arguments["show-blocks"].as<bool>()};
+
+		std::vector<std::string> inputs;
+		if (arguments.count("input"))
+			inputs = arguments["input"].as<std::vector<std::string>>();
+
+		if (arguments["disassemble"].as<bool>())
+		{
+			if (inputs.size() != 1)
+				BOOST_THROW_EXCEPTION(BadInput() << util::errinfo_comment("Expected exactly one input file."));
+			ControlFlowGraph cfg = load(inputs.front(), opcodes, options);
+			for (size_t block = 0; block < cfg.blocks.size(); ++block)
+			{
+				std::cout << "block " << block << " ->";
+				for (size_t successor: cfg.blocks[block].successors)
+					std::cout << " " << successor;
+				std::cout << std::endl << cfg.disassemble(block, opcodes);
+			}
+			return 0;
+		}
+
+		if (inputs.size() != 2)
+			BOOST_THROW_EXCEPTION(BadInput() << util::errinfo_comment("Expected exactly two inputs."));
+		fs::path before = inputs[0];
+		fs::path after = inputs[1];
+		bool identical = false;
+		if (fs::is_directory(before) && fs::is_directory(after))
+			identical = compareDirectories(before, after, opcodes, options);
+		else if (fs::is_directory(before) || fs::is_directory(after))
+			BOOST_THROW_EXCEPTION(BadInput() << util::errinfo_comment("Cannot compare a file to a directory."));
+		else
+			identical = compareFiles(after.string(), before, after, opcodes, options);
+		return identical ? 0 : 1;
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << "ERROR: " << _exception.what() << std::endl;
+		return 2;
+	}
+	catch (util::Exception const& _exception)
+	{
+		std::cerr << "ERROR: " << _exception.what() << std::endl;
+		return 2;
+	}
+	catch (...)
+	{
+		std::cerr << "Uncaught exception:" << std::endl;
+		std::cerr << boost::current_exception_diagnostic_information() << std::endl;
+		return 2;
+	}
+}
@@ -18,14 +18,46 @@
 
 #include <tools/yulPhaser/FitnessMetrics.h>
 
+#include <libevmasm/Assembly.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+
 #include <libsolutil/CommonIO.h>
 
 #include <cmath>
+#include <limits>
 
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+std::vector<size_t> FitnessMetric::evaluateAll(std::vector<Chromosome> const& _chromosomes)
+{
+	std::vector<size_t> values;
+	values.reserve(_chromosomes.size());
+
+	if (!m_threadPool || m_threadPool->numThreads() < 2 || _chromosomes.size() < 2)
+	{
+		for (Chromosome const& chromosome: _chromosomes)
+			values.push_back(evaluate(chromosome));
+		return values;
+	}
+
+	std::vector<std::future<size_t>> futures;
+	futures.reserve(_chromosomes.size());
+	for (Chromosome const& chromosome: _chromosomes)
+		futures.push_back(m_threadPool->submit([this, &chromosome]() { return evaluate(chromosome); }));
+
+	// Wait for all tasks before retrieving the results so that none of them is still running
+	// when an exception from another one propagates.
+	for (auto& future: futures)
+		future.wait();
+	for (auto& future: futures)
+		values.push_back(future.get());
+
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -74,6 +106,61 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
+size_t GasCost::evaluate(Chromosome const& _chromosome)
+{
+	Program program = optimisedProgram(_chromosome);
+	std::string code = toString(program);
+
+	{
+		std::lock_guard lock(m_gasCostCacheMutex);
+		if (auto it = m_gasCostCache.find(code); it != m_gasCostCache.end())
+			return it->second;
+	}
+
+	size_t gasCost = computeGasCost(program);
+
+	std::lock_guard lock(m_gasCostCacheMutex);
+	m_gasCostCache.emplace(std::move(code), gasCost);
+	return gasCost;
+}
+
+size_t GasCost::computeGasCost(Program const& _program) const
+{
+	std::unique_ptr<evmasm::Assembly> assembly = _program.compile();
+	if (!assembly)
+		return std::numeric_limits<size_t>::max();
+
+	langutil::EVMVersion evmVersion = assembly->evmVersion();
+	bigint executionGas = 0;
+	for (auto const& codeSection: assembly->codeSections())
+	{
+		auto meter = std::make_unique<evmasm::GasMeter>(std::make_shared<evmasm::KnownState>(), evmVersion);
+		for (evmasm::AssemblyItem const& item: codeSection.items)
+		{
+			// Jump destinations can be reached from anywhere so nothing is known about the state.
+			if (item.type() == evmasm::Tag)
+				meter = std::make_unique<evmasm::GasMeter>(std::make_shared<evmasm::KnownState>(), evmVersion);
+
+			evmasm::GasMeter::GasConsumption gas = meter->estimateMax(item, false /* _includeExternalCosts */);
+			if (!gas.isInfinite)
+				executionGas += gas.value;
+			else if (
+				item.type() == evmasm::Operation &&
+				evmasm::instructionInfo(item.instruction(), evmVersion).gasPriceTier != evmasm::Tier::Special &&
+				evmasm::instructionInfo(item.instruction(), evmVersion).gasPriceTier != evmasm::Tier::Invalid
+			)
+				executionGas += evmasm::GasMeter::runGas(item.instruction(), evmVersion);
+		}
+	}
+
+	bigint deploymentGas = evmasm::GasMeter::dataGas(assembly->assemble().bytecode, false, evmVersion);
+	bigint totalGas = deploymentGas + executionGas * m_expectedExecutionsPerDeployment;
+
+	if (totalGas >= std::numeric_limits<size_t>::max())
+		return std::numeric_limits<size_t>::max();
+	return static_cast<size_t>(totalGas);
+}
+
 size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
@@ -27,8 +27,15 @@
 
 #include <libyul/optimiser/Metrics.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +46,10 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * @a evaluateAll() can evaluate multiple chromosomes concurrently if the metric has been given
+ * a thread pool. This requires @a evaluate() to be safe to call from multiple threads. All the
+ * metrics defined in this file satisfy this requirement.
  */
 class FitnessMetric
 {
@@ -49,6 +60,16 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// Evaluates all the chromosomes and returns the values in the same order. The result does
+	/// not depend on whether the work is distributed over the threads of the pool.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	util::ThreadPool* threadPool() const { return m_threadPool.get(); }
+	void setThreadPool(std::shared_ptr<util::ThreadPool> _threadPool) { m_threadPool = std::move(_threadPool); }
+
+private:
+	std::shared_ptr<util::ThreadPool> m_threadPool;
 };
 
 /**
@@ -132,6 +153,44 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric based on the gas costs of a specific program after applying the optimisations
+ * from the chromosome to it and compiling it to EVM bytecode.
+ *
+ * The value is a static estimate: the costs of storing the bytecode on deployment plus the costs
+ * of executing each instruction once, multiplied by the expected number of executions per
+ * deployment. This is the trade-off the optimiser itself uses to weigh code size against runtime
+ * costs. Instructions whose costs cannot be determined statically are counted with their base
+ * costs if they have any.
+ * Chromosomes resulting in programs the code generator cannot compile get the worst possible value.
+ *
+ * Since different chromosomes often produce the same program, the values are cached by the text
+ * of the optimised program.
+ */
+class GasCost: public ProgramBasedMetric
+{
+public:
+	explicit GasCost(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		size_t _expectedExecutionsPerDeployment,
+		size_t _repetitionCount = 1
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), yul::CodeWeights{}, _repetitionCount),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment) {}
+
+	size_t expectedExecutionsPerDeployment() const { return m_expectedExecutionsPerDeployment; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	size_t computeGasCost(Program const& _program) const;
+
+	size_t m_expectedExecutionsPerDeployment;
+	std::map<std::string, size_t> m_gasCostCache;
+	std::mutex m_gasCostCacheMutex;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
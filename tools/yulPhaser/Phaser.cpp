@@ -31,6 +31,8 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <liblangutil/Scanner.h>
 
+#include <libsolidity/interface/OptimiserSettings.h>
+
 #include <libsolutil/Assertions.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
@@ -68,6 +70,7 @@ std::map<MetricChoice, std::string> MetricChoiceToStringMap =
 {
 	{MetricChoice::CodeSize, "code-size"},
 	{MetricChoice::RelativeCodeSize, "relative-code-size"},
+	{MetricChoice::GasCost, "gas-cost"},
 };
 std::map<std::string, MetricChoice> const StringToMetricChoiceMap = invertMap(MetricChoiceToStringMap);
 
@@ -218,6 +221,8 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["expected-executions-per-deployment"].as<size_t>(),
+		_arguments["threads"].as<size_t>(),
 	};
 }
 
@@ -258,26 +263,45 @@ std::unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 				));
 			break;
 		}
+		case MetricChoice::GasCost:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(std::make_unique<GasCost>(
+					_programCaches[i] != nullptr ? std::optional<Program>{} : std::move(_programs[i]),
+					std::move(_programCaches[i]),
+					_options.expectedExecutionsPerDeployment,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	std::unique_ptr<FitnessMetric> metric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return std::make_unique<FitnessMetricAverage>(std::move(metrics));
+			metric = std::make_unique<FitnessMetricAverage>(std::move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return std::make_unique<FitnessMetricSum>(std::move(metrics));
+			metric = std::make_unique<FitnessMetricSum>(std::move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return std::make_unique<FitnessMetricMaximum>(std::move(metrics));
+			metric = std::make_unique<FitnessMetricMaximum>(std::move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return std::make_unique<FitnessMetricMinimum>(std::move(metrics));
+			metric = std::make_unique<FitnessMetricMinimum>(std::move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
 
-	// FIXME: Workaround for spurious GCC 12.1 warning (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105794)
-	util::unreachable();
+	size_t threads = (_options.threads == 0 ? util::ThreadPool::hardwareConcurrency() : _options.threads);
+	if (threads > 1)
+		metric->setThreadPool(std::make_shared<util::ThreadPool>(threads));
+
+	return metric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -647,7 +671,8 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"\n"
 				"AVAILABLE METRICS:\n"
 				"* " + toString(MetricChoice::CodeSize) + "\n" +
-				"* " + toString(MetricChoice::RelativeCodeSize)
+				"* " + toString(MetricChoice::RelativeCodeSize) + "\n" +
+				"* " + toString(MetricChoice::GasCost)
 			).c_str()
 		)
 		(
@@ -681,6 +706,23 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"expected-executions-per-deployment",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(
+				frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+			),
+			(
+				"Used by the " + toString(MetricChoice::GasCost) + " metric to weigh the costs of executing "
+				"the code against the costs of deploying it. Has the same meaning as --optimize-runs in solc."
+			).c_str()
+		)
+		(
+			"threads",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
+			"Number of threads used to evaluate the fitness of chromosomes. "
+			"0 means one thread per hardware thread. "
+			"The results do not depend on the number of threads but the cache statistics may."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
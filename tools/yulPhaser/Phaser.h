@@ -76,6 +76,7 @@ enum class MetricChoice
 {
 	CodeSize,
 	RelativeCodeSize,
+	GasCost,
 };
 
 enum class MetricAggregatorChoice
@@ -158,6 +159,8 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		size_t expectedExecutionsPerDeployment;
+		size_t threads;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -27,9 +27,13 @@
 #include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/YulName.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMObjectCompiler.h>
+#include <libyul/backends/evm/EthAssemblyAdapter.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
@@ -38,6 +42,8 @@
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <libevmasm/Assembly.h>
+
 #include <libsolutil/JSON.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -104,6 +110,31 @@ void Program::optimise(std::vector<std::string> const& _optimisationSteps)
 	m_ast = applyOptimisationSteps(m_dialect, m_nameDispenser, std::move(m_ast), _optimisationSteps);
 }
 
+std::unique_ptr<evmasm::Assembly> Program::compile() const
+{
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	assert(evmDialect != nullptr);
+
+	Object object;
+	object.setCode(std::make_shared<AST>(std::get<Block>(ASTCopier{}(m_ast->root()))));
+	object.analysisInfo = std::make_shared<AsmAnalysisInfo>(
+		AsmAnalyzer::analyzeStrictAssertCorrect(*evmDialect, object)
+	);
+
+	auto assembly = std::make_unique<evmasm::Assembly>(evmDialect->evmVersion(), false, std::nullopt, "");
+	EthAssemblyAdapter adapter(*assembly);
+	try
+	{
+		EVMObjectCompiler::compile(object, adapter, *evmDialect, true /* optimize */, std::nullopt);
+	}
+	catch (yul::StackTooDeepError const&)
+	{
+		return nullptr;
+	}
+
+	return assembly;
+}
+
 std::ostream& phaser::operator<<(std::ostream& _stream, Program const& _program)
 {
 	return _stream << AsmPrinter()(_program.m_ast->root());
@@ -39,6 +39,13 @@ class Scanner;
 
 }
 
+namespace solidity::evmasm
+{
+
+class Assembly;
+
+}
+
 namespace solidity::yul
 {
 
@@ -78,6 +85,11 @@ public:
 	size_t codeSize(yul::CodeWeights const& _weights) const { return computeCodeSize(m_ast->root(), _weights); }
 	yul::Block const& ast() const { return m_ast->root(); }
 
+	/// Compiles the program to EVM assembly using the optimising code generator.
+	/// @returns nullptr if the code generator cannot handle the program, e.g. because some
+	/// variables cannot be reached in the stack.
+	std::unique_ptr<evmasm::Assembly> compile() const;
+
 	friend std::ostream& operator<<(std::ostream& _stream, Program const& _program);
 	std::string toJson() const;
 
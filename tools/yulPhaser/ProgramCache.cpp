@@ -59,23 +59,29 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	std::size_t prefixSize = 0;
-	for (std::size_t i = 1; i <= targetOptimisations.size(); ++i)
+	Program const* longestCachedPrefix = nullptr;
 	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+		std::lock_guard lock(m_mutex);
+		for (std::size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				longestCachedPrefix = &pair->second.program;
+				++prefixSize;
+				++m_hits;
+			}
+			else
+				break;
 		}
-		else
-			break;
 	}
 
+	// Entries are only removed between rounds so it is safe to copy the program without the lock.
 	Program intermediateProgram = (
-		prefixSize == 0 ?
+		longestCachedPrefix == nullptr ?
 		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
+		*longestCachedPrefix
 	);
 
 	for (std::size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
@@ -83,7 +89,9 @@ Program ProgramCache::optimiseProgram(
 		std::string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		CacheEntry entry{intermediateProgram, m_currentRound};
+		std::lock_guard lock(m_mutex);
+		m_entries.emplace(targetOptimisations.substr(0, i), std::move(entry));
 		++m_misses;
 	}
 
@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace solidity::phaser
@@ -99,6 +100,11 @@ struct CacheStats
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
+ * @a optimiseProgram() can be called from multiple threads at the same time. The steps are applied
+ * outside of the lock, which means that two threads may compute the same missing entry. This
+ * affects only the hit/miss statistics, not the results. The remaining functions must not be
+ * called while any thread is still optimising, which in practice means between rounds.
+ *
  * There is currently no way to purge entries without starting a new round. Since the programs
  * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
  * long and programs large. A limiter based on entry count or total program size would be useful.
@@ -139,6 +145,8 @@ private:
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+	/// Protects @a m_entries and the statistics in @a optimiseProgram().
+	std::mutex m_mutex;
 };
 
 }